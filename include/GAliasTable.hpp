@@ -0,0 +1,117 @@
+/***************************************************************************
+ *              GAliasTable.hpp - Alias table sampling class               *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GAliasTable.hpp
+ * @brief Alias table sampling class definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GALIASTABLE_HPP
+#define GALIASTABLE_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <vector>
+#include <string>
+#include "GBase.hpp"
+#include "GRan.hpp"
+
+
+/***********************************************************************//**
+ * @class GAliasTable
+ *
+ * @brief Alias table sampling class
+ *
+ * This class implements the alias method of Walker (1977), in the variant
+ * of Vose (1991), for drawing indices from a discrete probability
+ * distribution that is given by a set of non-negative weights. Building
+ * the table takes a time proportional to the number of weights, and each
+ * draw then takes a constant time, independent of the number of weights.
+ * This makes the class suited for Monte Carlo sampling of sky map pixels
+ * or spectral segments.
+ *
+ * Each table column i holds a probability and an alias index. A draw
+ * selects a column from the integer part of a uniform random number
+ * scaled by the number of columns, and returns either the column index or
+ * its alias, depending on whether the fractional part is below the column
+ * probability. Only one random number is consumed per draw. As draw() does
+ * not modify the table, a table can be shared between threads.
+ ***************************************************************************/
+class GAliasTable : public GBase {
+
+public:
+    // Constructors and destructors
+    GAliasTable(void);
+    explicit GAliasTable(const std::vector<double>& weights);
+    GAliasTable(const GAliasTable& table);
+    virtual ~GAliasTable(void);
+
+    // Operators
+    GAliasTable& operator=(const GAliasTable& table);
+
+    // Methods
+    void         clear(void);
+    GAliasTable* clone(void) const;
+    int          size(void) const { return m_prob.size(); }
+    bool         isempty(void) const { return m_prob.empty(); }
+    void         set(const std::vector<double>& weights);
+    void         set(const double* weights, const int& number);
+    int          draw(GRan& ran) const;
+    std::string  print(const GChatter& chatter = NORMAL) const;
+
+protected:
+    // Protected methods
+    void init_members(void);
+    void copy_members(const GAliasTable& table);
+    void free_members(void);
+
+    // Protected data members
+    std::vector<double> m_prob;   //!< Column probabilities
+    std::vector<int>    m_alias;  //!< Column aliases
+};
+
+
+/***********************************************************************//**
+ * @brief Draw index from alias table
+ *
+ * @param[in,out] ran Random number generator.
+ * @return Index (-1 if the table is empty).
+ ***************************************************************************/
+inline
+int GAliasTable::draw(GRan& ran) const
+{
+    // Initialise index
+    int index = -1;
+
+    // Draw index if table is not empty
+    if (!m_prob.empty()) {
+        double x = ran.uniform() * double(m_prob.size());
+        int    i = int(x);
+        if (i >= int(m_prob.size())) {
+            i = m_prob.size() - 1;
+        }
+        index = ((x - double(i)) < m_prob[i]) ? i : m_alias[i];
+    }
+
+    // Return index
+    return index;
+}
+
+#endif /* GALIASTABLE_HPP */
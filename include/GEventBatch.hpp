@@ -0,0 +1,145 @@
+/***************************************************************************
+ *              GEventBatch.hpp - Event list batch view class              *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GEventBatch.hpp
+ * @brief Event list batch view class interface definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GEVENTBATCH_HPP
+#define GEVENTBATCH_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <string>
+#include <vector>
+#include "GBase.hpp"
+#include "GEventList.hpp"
+#include "GEventAtom.hpp"
+
+
+/***********************************************************************//**
+ * @class GEventBatch
+ *
+ * @brief Event list batch view class
+ *
+ * This class provides a structure-of-arrays view on a contiguous range
+ * [begin,end[ of events of an event list. The event energies and times
+ * of all events in the range are extracted once into contiguous arrays so
+ * that model kernels can loop over the events without virtual method calls
+ * and without accessing the event objects. The following arrays are
+ * provided:
+ *
+ *     energies()     - Event energies in MeV
+ *     log_energies() - Natural logarithm of event energies in MeV
+ *     times()        - Event times in seconds
+ *
+ * The events themselves are accessed using the operator[], where the index
+ * runs from 0 to size()-1. The class does not own the events, hence the
+ * event list needs to exist as long as the batch is used.
+ *
+ * Arrays of per-event quantities that are associated with a batch, such
+ * as model values and gradients, have size() elements per quantity, and
+ * quantities are stored one after the other (i.e. element @p i of
+ * quantity @p k is at position @p k*size()+i).
+ ***************************************************************************/
+class GEventBatch : public GBase {
+
+public:
+    // Constructors and destructors
+    GEventBatch(void);
+    explicit GEventBatch(const GEventList& events,
+                         const int&        begin,
+                         const int&        end);
+    GEventBatch(const GEventBatch& batch);
+    virtual ~GEventBatch(void);
+
+    // Operators
+    GEventBatch&      operator=(const GEventBatch& batch);
+    const GEventAtom* operator[](const int& index) const;
+
+    // Methods
+    void          clear(void);
+    GEventBatch*  clone(void) const;
+    void          set(const GEventList& events,
+                      const int&        begin,
+                      const int&        end);
+    int           size(void) const { return m_events.size(); }
+    bool          isempty(void) const { return m_events.empty(); }
+    const int&    begin(void) const { return m_begin; }
+    const int&    end(void) const { return m_end; }
+    const double* energies(void) const;
+    const double* log_energies(void) const;
+    const double* times(void) const;
+    std::string   print(const GChatter& chatter = NORMAL) const;
+
+protected:
+    // Protected methods
+    void init_members(void);
+    void copy_members(const GEventBatch& batch);
+    void free_members(void);
+
+    // Protected members
+    int                            m_begin;        //!< Index of first event
+    int                            m_end;          //!< Index after last event
+    std::vector<const GEventAtom*> m_events;       //!< Event pointers
+    std::vector<double>            m_energies;     //!< Energies (MeV)
+    std::vector<double>            m_log_energies; //!< ln of energies (MeV)
+    std::vector<double>            m_times;        //!< Times (seconds)
+};
+
+
+/***********************************************************************//**
+ * @brief Return pointer to event energies
+ *
+ * @return Pointer to event energies (MeV), or NULL if batch is empty.
+ ***************************************************************************/
+inline
+const double* GEventBatch::energies(void) const
+{
+    return (m_energies.empty() ? NULL : &(m_energies[0]));
+}
+
+
+/***********************************************************************//**
+ * @brief Return pointer to natural logarithm of event energies
+ *
+ * @return Pointer to natural logarithm of event energies (MeV), or NULL if
+ *         batch is empty.
+ ***************************************************************************/
+inline
+const double* GEventBatch::log_energies(void) const
+{
+    return (m_log_energies.empty() ? NULL : &(m_log_energies[0]));
+}
+
+
+/***********************************************************************//**
+ * @brief Return pointer to event times
+ *
+ * @return Pointer to event times (seconds), or NULL if batch is empty.
+ ***************************************************************************/
+inline
+const double* GEventBatch::times(void) const
+{
+    return (m_times.empty() ? NULL : &(m_times[0]));
+}
+
+#endif /* GEVENTBATCH_HPP */
@@ -0,0 +1,124 @@
+/***************************************************************************
+ *                 GFft.hpp - Fast Fourier transform class                 *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFft.hpp
+ * @brief Fast Fourier transform class definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GFFT_HPP
+#define GFFT_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <string>
+#include <vector>
+#include <complex>
+#include "GBase.hpp"
+
+
+/***********************************************************************//**
+ * @class GFft
+ *
+ * @brief Fast Fourier transform class
+ *
+ * This class holds a two-dimensional array of complex numbers and
+ * implements its forward and backward discrete Fourier transforms using the
+ * radix-2 Cooley-Tukey algorithm. Both array dimensions need to be powers
+ * of two; a one-dimensional transform is obtained by setting the second
+ * dimension to one. The backward transform includes the normalisation, so
+ * that a forward transform followed by a backward transform recovers the
+ * original array.
+ *
+ * The multiplication operator multiplies two transforms element-wise,
+ * which allows to compute cyclic convolutions. The method size2() returns
+ * the smallest power of two that is not smaller than a given number, and
+ * is useful to size zero-padded arrays for linear convolutions.
+ ***************************************************************************/
+class GFft : public GBase {
+
+public:
+    // Constructors and destructors
+    GFft(void);
+    GFft(const int& nx, const int& ny = 1);
+    GFft(const GFft& fft);
+    virtual ~GFft(void);
+
+    // Operators
+    GFft&                       operator=(const GFft& fft);
+    GFft&                       operator*=(const GFft& fft);
+    std::complex<double>&       operator()(const int& ix, const int& iy = 0);
+    const std::complex<double>& operator()(const int& ix, const int& iy = 0) const;
+
+    // Methods
+    void        clear(void);
+    GFft*       clone(void) const;
+    int         size(void) const { return m_data.size(); }
+    const int&  nx(void) const { return m_nx; }
+    const int&  ny(void) const { return m_ny; }
+    void        forward(void);
+    void        backward(void);
+    static int  size2(const int& n);
+    std::string print(const GChatter& chatter = NORMAL) const;
+
+protected:
+    // Protected methods
+    void init_members(void);
+    void copy_members(const GFft& fft);
+    void free_members(void);
+    void transform(const double& sign);
+    void transform(std::complex<double>* data, const int& n,
+                   const int& stride, const double& sign) const;
+
+    // Protected members
+    int                               m_nx;    //!< Number of elements in x
+    int                               m_ny;    //!< Number of elements in y
+    std::vector<std::complex<double> > m_data; //!< Array elements
+};
+
+
+/***********************************************************************//**
+ * @brief Return reference to array element
+ *
+ * @param[in] ix Index in x [0,...,nx()-1].
+ * @param[in] iy Index in y [0,...,ny()-1].
+ * @return Reference to array element.
+ ***************************************************************************/
+inline
+std::complex<double>& GFft::operator()(const int& ix, const int& iy)
+{
+    return (m_data[ix + iy * m_nx]);
+}
+
+
+/***********************************************************************//**
+ * @brief Return reference to array element (const version)
+ *
+ * @param[in] ix Index in x [0,...,nx()-1].
+ * @param[in] iy Index in y [0,...,ny()-1].
+ * @return Reference to array element.
+ ***************************************************************************/
+inline
+const std::complex<double>& GFft::operator()(const int& ix, const int& iy) const
+{
+    return (m_data[ix + iy * m_nx]);
+}
+
+#endif /* GFFT_HPP */
@@ -79,6 +79,8 @@ public:
     int              number(void) const;
     int              length(void) const;
     int              anynul(void) const;
+    void             read_rows(const int& row, const int& nrows,
+                               double* values) const;
     std::string      print(const GChatter& chatter = NORMAL) const;
 
 protected:
@@ -40,6 +40,10 @@
  * of derivatives. This class has no members. The only pure virtual method
  * that needs to be implemented by the derived class is the eval() method
  * that provides function evaluation at a given value x, e.g. y=eval(x).
+ *
+ * The eval(const double*, double*, const int&) method evaluates the
+ * function for an array of values. It is used by the integration methods
+ * that know all abscissae of an integration step in advance.
  ***************************************************************************/
 class GFunction {
 
@@ -55,6 +59,7 @@ public:
 
     // Methods
     virtual double eval(double x) = 0;
+    virtual void   eval(const double* x, double* y, const int& n);
 
 protected:
     // Protected methods
@@ -0,0 +1,72 @@
+/***************************************************************************
+ *   GFunctions.hpp - Multi-valued single parameter function base class    *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFunctions.hpp
+ * @brief GFunctions abstract virtual base class interface definition.
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GFUNCTIONS_HPP
+#define GFUNCTIONS_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include "GVector.hpp"
+
+
+/***********************************************************************//**
+ * @class GFunctions
+ *
+ * @brief Multi-valued single parameter function abstract base class
+ *
+ * This class implements the abstract interface for a set of functions that
+ * depend on a single parameter. The functions are evaluated together at a
+ * given value x, and the eval() method returns a vector holding the values
+ * of all functions, e.g. y=eval(x). The size() method returns the number
+ * of functions.
+ *
+ * This class is for example used for the simultaneous integration of a
+ * function and its parameter gradients, which allows to share the expensive
+ * parts of the kernel evaluation.
+ ***************************************************************************/
+class GFunctions {
+
+public:
+
+    // Constructors and destructors
+    GFunctions(void);
+    GFunctions(const GFunctions& functions);
+    virtual ~GFunctions(void);
+
+    // Operators
+    GFunctions& operator=(const GFunctions& functions);
+
+    // Methods
+    virtual int     size(void) const = 0;
+    virtual GVector eval(const double& x) = 0;
+
+protected:
+    // Protected methods
+    void init_members(void);
+    void copy_members(const GFunctions& functions);
+    void free_members(void);
+};
+
+#endif /* GFUNCTIONS_HPP */
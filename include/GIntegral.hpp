@@ -29,6 +29,7 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
 #include "GBase.hpp"
 #include "GFunction.hpp"
 
@@ -39,7 +40,17 @@
  * @brief GIntegral class interface defintion.
  *
  * This class allows to perform integration using various methods. The
- * integrand is implemented by a derived class of GIntegrand.
+ * integrand is implemented by a derived class of GFunction.
+ *
+ * The following integration methods are available: romb() implements
+ * Romberg's method, gkq() an adaptive 15-point Gauss-Kronrod rule that
+ * needs far fewer kernel evaluations for smooth integrands, and tanhsinh()
+ * the tanh-sinh quadrature that copes with integrable singularities at the
+ * integration boundaries. All methods pass the abscissae in batches to the
+ * kernel.
+ *
+ * The static method gk_nodes() returns the abscissae and weights of a fixed
+ * Gauss-Kronrod rule, for integrands that should be tabulated once.
  ***************************************************************************/
 class GIntegral : public GBase {
 
@@ -68,6 +79,10 @@ public:
     const GFunction* kernel(void) const { return m_kernel; }
     double           romb(double a, double b, int k = 5);
     double           trapzd(double a, double b, int n = 1, double result = 0.0);
+    double           gkq(double a, double b);
+    double           tanhsinh(double a, double b);
+    static void      gk_nodes(const double& a, const double& b, const int& n,
+                              std::vector<double>* x, std::vector<double>* w);
     std::string      print(const GChatter& chatter = NORMAL) const;
 
 protected:
@@ -76,6 +91,11 @@ protected:
     void   copy_members(const GIntegral& integral);
     void   free_members(void);
     double polint(double* xa, double* ya, int n, double x, double *dy);
+    double kronrod(const double& a, const double& b, double* err);
+    double gkq_adapt(const double& a, const double& b, const double& value,
+                     const double& err, const double& tol, const int& depth,
+                     bool* converged);
+    double weighted_sum(const double* x, const double* w, const int& n);
 
     // Protected data area
     GFunction* m_kernel;       //!< Pointer to function kernel
@@ -0,0 +1,103 @@
+/***************************************************************************
+ *          GIntegrals.hpp - Integration class for set of functions        *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GIntegrals.hpp
+ * @brief Integration class for set of functions interface definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GINTEGRALS_HPP
+#define GINTEGRALS_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <string>
+#include <vector>
+#include "GBase.hpp"
+#include "GVector.hpp"
+#include "GFunctions.hpp"
+
+
+/***********************************************************************//**
+ * @class GIntegrals
+ *
+ * @brief Integration class for set of functions
+ *
+ * This class allows to integrate simultaneously a set of functions that
+ * is implemented by a derived class of GFunctions. All functions are
+ * evaluated at the same abscissa, hence any computation that is shared
+ * between the functions needs only to be done once per abscissa. The
+ * integration is considered as converged if the first function of the set
+ * has reached the requested fractional accuracy. The romb() method uses
+ * Romberg's method, the gkq() method an adaptive 15-point Gauss-Kronrod
+ * rule that is identical to GIntegral::gkq().
+ ***************************************************************************/
+class GIntegrals : public GBase {
+
+public:
+
+    // Constructors and destructors
+    GIntegrals(void);
+    explicit GIntegrals(GFunctions* kernels);
+    GIntegrals(const GIntegrals& integrals);
+    virtual ~GIntegrals(void);
+
+    // Operators
+    GIntegrals& operator=(const GIntegrals& integrals);
+
+    // Methods
+    void              clear(void);
+    GIntegrals*       clone(void) const;
+    void              max_iter(const int& max_iter) { m_max_iter=max_iter; }
+    void              eps(const double& eps) { m_eps=eps; }
+    void              silent(const bool& silent) { m_silent=silent; }
+    const int&        iter(void) const { return m_iter; }
+    const int&        max_iter(void) const { return m_max_iter; }
+    const double&     eps(void) const { return m_eps; }
+    const bool&       silent(void) const { return m_silent; }
+    void              kernels(GFunctions* kernels) { m_kernels=kernels; }
+    const GFunctions* kernels(void) const { return m_kernels; }
+    GVector           romb(const double& a, const double& b, const int& k = 5);
+    GVector           gkq(const double& a, const double& b);
+    GVector           trapzd(const double& a, const double& b, const int& n = 1,
+                             GVector result = GVector());
+    std::string       print(const GChatter& chatter = NORMAL) const;
+
+protected:
+    // Protected methods
+    void    init_members(void);
+    void    copy_members(const GIntegrals& integrals);
+    void    free_members(void);
+    GVector polint(const double* xa, const GVector* ya, const int& n,
+                   const double& x, GVector* dy);
+    GVector kronrod(const double& a, const double& b, double* err);
+    GVector gkq_adapt(const double& a, const double& b, const GVector& value,
+                      const double& err, const double& tol, const int& depth,
+                      bool* converged);
+
+    // Protected data area
+    GFunctions* m_kernels;      //!< Pointer to function kernels
+    double      m_eps;          //!< Integration precision
+    int         m_max_iter;     //!< Maximum number of iterations
+    int         m_iter;         //!< Number of iterations used
+    bool        m_silent;       //!< Suppress integration warnings
+};
+
+#endif /* GINTEGRALS_HPP */
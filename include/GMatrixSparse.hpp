@@ -258,6 +258,7 @@ public:
     GMatrixSparse abs(void) const;
     GMatrixSparse cholesky_decompose(bool compress = true) const;
     GVector       cholesky_solver(const GVector& vector, bool compress = true) const;
+    GMatrix       cholesky_solver(const GMatrix& matrix, bool compress = true) const;
     GMatrixSparse cholesky_invert(bool compress = true) const;
     void          set_mem_block(const int& block);
     void          stack_init(const int& size = 0, const int& entries = 0);
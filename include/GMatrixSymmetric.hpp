@@ -123,6 +123,10 @@ public:
     GMatrixSymmetric cholesky_decompose(bool compress = true) const;
     GVector          cholesky_solver(const GVector& vector, bool compress = true) const;
     GMatrixSymmetric cholesky_invert(bool compress = true) const;
+    void             add_outer_product(const double& weight,
+                                       const double* values,
+                                       const int*    inx,
+                                       const int&    number);
 
 private:
     // Private methods
@@ -38,6 +38,7 @@
 
 /* __ Forward declarations _______________________________________________ */
 class GEvent;
+class GEventBatch;
 class GObservation;
 
 
@@ -50,7 +51,8 @@ class GObservation;
  * model evaluation: eval() and eval_gradients().
  * The eval() method evaluates the model for a given event and observation.
  * In addition, eval_gradients() also sets the parameter gradients of the
- * model.
+ * model. The eval_batch() method evaluates the model and optionally the
+ * parameter gradients for a batch of events of an event list.
  *
  * A model has the following attributes:
  * - @p name
@@ -125,6 +127,12 @@ public:
     virtual void        write(GXmlElement& xml) const = 0;
     virtual std::string print(const GChatter& chatter = NORMAL) const = 0;
 
+    // Virtual methods
+    virtual void        eval_batch(const GEventBatch&  batch,
+                                   const GObservation& obs,
+                                   double*             values,
+                                   double*             gradients = NULL) const;
+
     // Implemented methods
     int                 size(void) const;
     GModelPar&          at(const int& index);
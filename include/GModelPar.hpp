@@ -83,6 +83,11 @@
  * The @p factor and @p scale terms can be set and retrieved using the
  * factor_value(), factor_error(), factor_gradient(), factor_min(),
  * factor_max() and scale() methods.
+ *
+ * Each parameter carries a version number that changes whenever the
+ * parameter value or the free/fixed property is modified. The version
+ * number is retrieved using the version() method and allows clients to
+ * detect whether a parameter has changed since it was last inspected.
  ***************************************************************************/
 class GModelPar : public GBase {
 
@@ -149,6 +154,7 @@ public:
     void               name(const std::string& name);
     void               unit(const std::string& unit);
     void               autoscale(void);
+    const unsigned long& version(void) const;
     void               read(const GXmlElement& xml);
     void               write(GXmlElement& xml) const;
     std::string        print(const GChatter& chatter = NORMAL) const;
@@ -158,6 +164,7 @@ protected:
     void init_members(void);
     void copy_members(const GModelPar& par);
     void free_members(void);
+    void touch(void);
 
     // Proteced data members
     std::string m_name;            //!< Parameter name
@@ -172,6 +179,7 @@ protected:
     bool        m_hasmin;          //!< Parameter has minimum boundary
     bool        m_hasmax;          //!< Parameter has maximum boundary
     bool        m_hasgrad;         //!< Parameter has analytic gradient
+    unsigned long m_version;       //!< Parameter version number
 };
 
 
@@ -503,7 +511,10 @@ bool GModelPar::hasgrad(void) const
 inline
 void GModelPar::free(void)
 {
-    m_free = true;
+    if (!m_free) {
+        m_free = true;
+        touch();
+    }
     return;
 }
 
@@ -517,7 +528,10 @@ void GModelPar::free(void)
 inline
 void GModelPar::fix(void)
 {
-    m_free = false;
+    if (m_free) {
+        m_free = false;
+        touch();
+    }
     return;
 }
 
@@ -597,4 +611,19 @@ void GModelPar::unit(const std::string& unit)
     return;
 }
 
+
+/***********************************************************************//**
+ * @brief Return parameter version number
+ *
+ * @return Parameter version number.
+ *
+ * Returns the version number of the parameter. The version number changes
+ * each time the parameter value or the free/fixed property is modified.
+ ***************************************************************************/
+inline
+const unsigned long& GModelPar::version(void) const
+{
+    return m_version;
+}
+
 #endif /* GMODELPAR_HPP */
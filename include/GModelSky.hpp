@@ -93,7 +93,8 @@ class GObservation;
  * The class has two methods for model evaluation that evaluate the model
  * for a specific event, given an observation. The eval() method returns
  * the model value, the eval_gradients() returns the model value and sets
- * the analytical gradients for all model parameters.
+ * the analytical gradients for all model parameters. The eval_batch()
+ * method evaluates the model for a batch of events of an event list.
  * Note that the eval() and eval_gradients() methods call protected
  * methods that handle time dispersion, energy dispersion and the point
  * spread function (spatial dispersion). Dispersion is handled by
@@ -157,6 +158,12 @@ public:
     virtual void        write(GXmlElement& xml) const;
     virtual std::string print(const GChatter& chatter = NORMAL) const;
 
+    // Overloaded virtual base class methods
+    virtual void        eval_batch(const GEventBatch&  batch,
+                                   const GObservation& obs,
+                                   double*             values,
+                                   double*             gradients = NULL) const;
+
     // Other methods
     GModelSpatial*      spatial(void) const;
     GModelSpectral*     spectral(void) const;
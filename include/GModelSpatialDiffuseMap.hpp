@@ -34,6 +34,7 @@
 #include "GModelPar.hpp"
 #include "GSkyDir.hpp"
 #include "GSkymap.hpp"
+#include "GAliasTable.hpp"
 #include "GXmlElement.hpp"
 
 
@@ -93,7 +94,7 @@ protected:
     GModelPar           m_value;        //!< Value
     GSkymap             m_map;          //!< Skymap
     std::string         m_filename;     //!< Name of skymap
-    std::vector<double> m_mc_cache;     //!< Monte Carlo cache
+    GAliasTable         m_mc_table;     //!< Monte Carlo alias table
 };
 
 /***********************************************************************//**
@@ -37,6 +37,9 @@
 #include "GRan.hpp"
 #include "GXmlElement.hpp"
 
+/* __ Forward declarations _______________________________________________ */
+class GEventBatch;
+
 
 /***********************************************************************//**
  * @class GModelSpectral
@@ -96,6 +99,11 @@ public:
     virtual void            write(GXmlElement& xml) const = 0;
     virtual std::string     print(const GChatter& chatter = NORMAL) const = 0;
 
+    // Virtual methods
+    virtual void            eval_batch(const GEventBatch& batch,
+                                       double*            values,
+                                       double*            gradients = NULL);
+
     // Methods
     int  size(void) const;
     void autoscale(void);
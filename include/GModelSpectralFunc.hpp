@@ -35,6 +35,7 @@
 #include "GEnergy.hpp"
 #include "GXmlElement.hpp"
 #include "GNodeArray.hpp"
+#include "GAliasTable.hpp"
 
 
 /***********************************************************************//**
@@ -103,8 +104,8 @@ protected:
 
     // Protected members
     GModelPar           m_norm;       //!< Normalization factor
-    mutable GNodeArray  m_lin_nodes;  //!< Energy nodes of function
-    mutable GNodeArray  m_log_nodes;  //!< lof10(Energy) nodes of function
+    GNodeArray          m_lin_nodes;  //!< Energy nodes of function
+    GNodeArray          m_log_nodes;  //!< lof10(Energy) nodes of function
     std::vector<double> m_lin_values; //!< Function values at nodes
     std::vector<double> m_log_values; //!< log10(Function) values at nodes
     std::string         m_filename;   //!< Name of file function
@@ -119,7 +120,7 @@ protected:
     // Cached members for MC
     mutable GEnergy             m_mc_emin;   //!< Minimum energy
     mutable GEnergy             m_mc_emax;   //!< Maximum energy
-    mutable std::vector<double> m_mc_cum;    //!< Cumulative distribution
+    mutable GAliasTable         m_mc_table;  //!< Segment alias table
     mutable std::vector<double> m_mc_min;    //!< Lower boundary for MC
     mutable std::vector<double> m_mc_max;    //!< Upper boundary for MC
     mutable std::vector<double> m_mc_exp;    //!< Exponent for MC
@@ -35,6 +35,7 @@
 #include "GEnergy.hpp"
 #include "GXmlElement.hpp"
 #include "GNodeArray.hpp"
+#include "GAliasTable.hpp"
 
 
 /***********************************************************************//**
@@ -157,7 +158,7 @@ protected:
     // Cached members for MC
     mutable GEnergy             m_mc_emin;      //!< Minimum energy
     mutable GEnergy             m_mc_emax;      //!< Maximum energy
-    mutable std::vector<double> m_mc_cum;       //!< Cumulative distribution
+    mutable GAliasTable         m_mc_table;     //!< Segment alias table
     mutable std::vector<double> m_mc_min;       //!< Lower boundary for MC
     mutable std::vector<double> m_mc_max;       //!< Upper boundary for MC
     mutable std::vector<double> m_mc_exp;       //!< Exponent for MC
@@ -87,6 +87,11 @@ public:
     virtual void                write(GXmlElement& xml) const;
     virtual std::string         print(const GChatter& chatter = NORMAL) const;
 
+    // Overloaded virtual base class methods
+    virtual void                eval_batch(const GEventBatch& batch,
+                                           double*            values,
+                                           double*            gradients = NULL);
+
     // Other methods
     double  prefactor(void) const;
     double  index(void) const;
@@ -32,6 +32,7 @@
 #include "GOptimizerPars.hpp"
 #include "GModel.hpp"
 #include "GXml.hpp"
+#include "GMatrixSymmetric.hpp"
 
 /* __ Forward declarations _______________________________________________ */
 class GEvent;
@@ -138,9 +139,24 @@ class GObservation;
  * The eval_gradients() method sets the parameter gradients for all free
  * model parameters that have an analytical parameter gradient.
  *
- * The only member of GModels is a list of model pointers. The class handles
+ * The main member of GModels is a list of model pointers. The class handles
  * the proper allocation and deallocation of the model memory.
  *
+ * The container also holds an optional covariance matrix of the model
+ * parameters, set using the covariance() method (for example by
+ * GObservations::optimize() after a fit). The matrix is indexed like the
+ * flat parameter array and is given in parameter units (i.e. scale factors
+ * are applied). The write() method writes the parameter correlations that
+ * follow from this matrix as @p correlation elements into the source
+ * library:
+ *
+ *     <correlation source1="Crab" parameter1="Prefactor"
+ *                  source2="Crab" parameter2="Index" value="-0.35"/>
+ *
+ * and the read() method rebuilds the covariance matrix from these elements
+ * and the parameter errors. Any change of the list of models drops the
+ * covariance matrix.
+ *
  * GModels derives from GOptimizerPars which contains a flat array of
  * model parameters. This flat array is set using the protected
  * set_pointers() method. This method is called after each manipulation of
@@ -189,6 +205,8 @@ public:
     void          write(GXml& xml) const;
     double        eval(const GEvent& event, const GObservation& obs) const;
     double        eval_gradients(const GEvent& event, const GObservation& obs) const;
+    void          covariance(const GMatrixSymmetric& covariance);
+    const GMatrixSymmetric& covariance(void) const;
     std::string   print(const GChatter& chatter = NORMAL) const;
 
 protected:
@@ -198,9 +216,14 @@ protected:
     void          free_members(void);
     void          set_pointers(void);
     int           get_index(const std::string& name) const;
+    int           par_index(const std::string& source,
+                            const std::string& parameter) const;
+    void          read_correlations(const GXmlElement& lib);
+    void          write_correlations(GXmlElement& lib) const;
 
     // Proteced members
-    std::vector<GModel*> m_models;  //!< List of models
+    std::vector<GModel*> m_models;      //!< List of models
+    GMatrixSymmetric     m_covariance;  //!< Parameter covariance matrix
 };
 
 
@@ -274,4 +297,19 @@ void GModels::reserve(const int& num)
     return;
 }
 
+
+/***********************************************************************//**
+ * @brief Return parameter covariance matrix
+ *
+ * @return Parameter covariance matrix.
+ *
+ * Returns the covariance matrix of the model parameters. The matrix is
+ * empty if no covariance information is available.
+ ***************************************************************************/
+inline
+const GMatrixSymmetric& GModels::covariance(void) const
+{
+    return m_covariance;
+}
+
 #endif /* GMODELS_HPP */
@@ -50,11 +50,34 @@
  * or using the set_value(). In the latter case, the node indices and
  * weighting factors can be recovered using inx_left(), inx_right(),
  * wgt_left() and wgt_right().
+ * As set_value() stores the node indices and weighting factors in the
+ * node array, it should not be used when a node array is shared between
+ * several threads. In that case the locate() method should be used, which
+ * returns the node indices and weighting factors in an interpolation
+ * handle without modifying the node array. The interpolate() method is
+ * also thread safe.
  * If the nodes are equally spaced, interpolation is more rapid.
  ***************************************************************************/
 class GNodeArray : public GBase {
 
 public:
+    // Interpolation handle
+    class handle {
+    friend class GNodeArray;
+    public:
+        handle(void) : m_inx_left(0), m_inx_right(0),
+                       m_wgt_left(0.0), m_wgt_right(0.0) {}
+        const int&    inx_left(void) const { return m_inx_left; }
+        const int&    inx_right(void) const { return m_inx_right; }
+        const double& wgt_left(void) const { return m_wgt_left; }
+        const double& wgt_right(void) const { return m_wgt_right; }
+    protected:
+        int    m_inx_left;  //!< Index of left node
+        int    m_inx_right; //!< Index of right node
+        double m_wgt_left;  //!< Weight for left node
+        double m_wgt_right; //!< Weight for right node
+    };
+
     // Constructors and destructors
     GNodeArray(void);
     GNodeArray(const GNodeArray& array);
@@ -79,6 +102,7 @@ public:
     double        interpolate(const double& value,
                               const std::vector<double>& vector) const;
     void          set_value(const double& value) const;
+    handle        locate(const double& value) const;
     const int&    inx_left(void) const { return m_inx_left; }
     const int&    inx_right(void) const { return m_inx_right; }
     const double& wgt_left(void) const { return m_wgt_left; }
@@ -29,6 +29,7 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
 #include "GBase.hpp"
 #include "GEvents.hpp"
 #include "GResponse.hpp"
@@ -38,6 +39,9 @@
 #include "GEnergy.hpp"
 #include "GFunction.hpp"
 
+/* __ Forward declarations _______________________________________________ */
+class GEventBatch;
+
 
 /***********************************************************************//**
  * @class GObservation
@@ -49,13 +53,29 @@
  * events, and provides information about the analysis definiton.
  * The method model() returns the probability for an event to be measured
  * with a given instrument direction, a given energy and at a given time,
- * given a source model and an instrument pointing direction.
+ * given a source model and an instrument pointing direction. Another
+ * version of the model() method returns this probability for a batch of
+ * events of an event list.
  * The method npred() returns the total number of expected events within the
  * analysis region for a given source model and a given instrument pointing
  * direction.
  * The methods a defined as virtual and can be overloaded by derived classes
  * that implement instrument specific observations in order to optimize the
  * execution speed for data analysis.
+ *
+ * If npred_kernel() is set, the spectrally integrated Npred of sky models
+ * with fixed spatial parameters is computed from a kernel that holds the
+ * spatially integrated response on fixed energy nodes. The kernel is
+ * computed once per model and observation, hence Npred and its spectral
+ * parameter gradients reduce to sums over the spectral model values at
+ * the energy nodes.
+ *
+ * If model_cache() is set, the model values, Npred values and parameter
+ * gradients of each model are cached per event or bin. Before each
+ * likelihood evaluation, model_cache_update() compares the parameter
+ * version numbers of all models with the cached ones, hence only the
+ * models for which a parameter changed are re-evaluated. The summed model
+ * of each event is updated incrementally by the change of these models.
  ***************************************************************************/
 class GObservation : public GBase {
 
@@ -85,17 +105,28 @@ public:
     // Virtual methods
     virtual double        model(const GModels& models, const GEvent& event,
                                 GVector* gradient = NULL) const;
+    virtual void          model(const GModels& models, const GEventBatch& batch,
+                                double* values, double* gradients = NULL) const;
     virtual double        npred(const GModels& models, GVector* gradient = NULL) const;
+    virtual bool          threadsafe(void) const;
+    virtual void          thread_setup(const GModels& models) const;
 
     // Implemented methods
     void                  name(const std::string& name);
     void                  id(const std::string& id);
     void                  events(const GEvents* events);
     void                  statistics(const std::string& statistics);
+    void                  npred_kernel(const bool& kernel);
+    void                  model_cache(const bool& cache);
     const std::string&    name(void) const { return m_name; }
     const std::string&    id(void) const { return m_id; }
     const GEvents*        events(void) const;
     const std::string&    statistics(void) const { return m_statistics; }
+    const bool&           npred_kernel(void) const { return m_npred_kernel; }
+    const bool&           model_cache(void) const { return m_model_cache; }
+    void                  model_cache_update(const GModels& models) const;
+    double                model(const GModels& models, const GEvent& event,
+                                const int& index, GVector* gradient) const;
 
     // Other methods
     virtual double model_grad(const GModel& model, const GEvent& event, int ipar) const;
@@ -106,6 +137,10 @@ protected:
     void init_members(void);
     void copy_members(const GObservation& obs);
     void free_members(void);
+    void model_batch(const GModel& model, const GEventBatch& batch,
+                     double* values, double* gradients) const;
+    bool model_cache_valid(const GModels& models) const;
+    void model_cache_clear(void) const;
 
 
     // Model gradient kernel classes
@@ -130,6 +165,8 @@ protected:
     // Npred methods
     virtual double npred_temp(const GModel& model) const;
     virtual double npred_spec(const GModel& model, const GTime& obsTime) const;
+    const std::vector<double>* npred_kernel_values(const GModel& model,
+                                                   const GTime&  obsTime) const;
 
     // Npred kernel classes
     class npred_temp_kern : public GFunction {
@@ -180,6 +217,32 @@ protected:
     std::string m_id;           //!< Observation identifier
     std::string m_statistics;   //!< Optimizer statistics (default=poisson)
     GEvents*    m_events;       //!< Pointer to event container
+
+    // Tabulated Npred kernels
+    bool                                      m_npred_kernel;          //!< Use tabulated kernels
+    mutable double                            m_npred_kernel_emin;     //!< Minimum node range energy (MeV)
+    mutable double                            m_npred_kernel_emax;     //!< Maximum node range energy (MeV)
+    mutable std::vector<double>               m_npred_kernel_energies; //!< Node energies (MeV)
+    mutable std::vector<double>               m_npred_kernel_weights;  //!< Node weights (MeV)
+    mutable std::vector<std::string>          m_npred_kernel_names;    //!< Model names
+    mutable std::vector<std::vector<double> > m_npred_kernel_pars;     //!< Spatial parameter values
+    mutable std::vector<std::vector<double> > m_npred_kernel_values;   //!< Weighted kernel values
+
+    // Per-model cache of model values and gradients
+    bool                                             m_model_cache;         //!< Use model cache
+    mutable int                                      m_cache_nevents;       //!< Number of cached events
+    mutable unsigned long                            m_cache_counter;       //!< Last assigned state
+    mutable std::vector<std::string>                 m_cache_names;         //!< Model names
+    mutable std::vector<std::vector<unsigned long> > m_cache_versions;      //!< Parameter versions
+    mutable std::vector<unsigned long>               m_cache_states;        //!< Model states
+    mutable std::vector<int>                         m_cache_offsets;       //!< Gradient offsets
+    mutable std::vector<unsigned long>               m_cache_event_states;  //!< Event states (model*nevents+event)
+    mutable std::vector<double>                      m_cache_values;        //!< Model values (model*nevents+event)
+    mutable std::vector<double>                      m_cache_gradients;     //!< Gradients (par*nevents+event)
+    mutable std::vector<double>                      m_cache_sum;           //!< Summed model values
+    mutable std::vector<unsigned long>               m_cache_npred_states;  //!< Npred states
+    mutable std::vector<double>                      m_cache_npred;         //!< Npred values
+    mutable std::vector<double>                      m_cache_npred_grad;    //!< Npred gradients
 };
 
 #endif /* GOBSERVATION_HPP */
@@ -148,38 +148,70 @@ public:
         // Other methods
         void set(GObservations* obs);
         void eval(const GOptimizerPars& pars);
+        double eval_value(const GOptimizerPars& pars);
         void poisson_unbinned(const GObservation&   obs,
                               const GOptimizerPars& pars);
         void poisson_unbinned(const GObservation&   obs,
                               const GOptimizerPars& pars,
-                              GMatrixSparse&        covar,
+                              GMatrixBase&          covar,
                               GVector&              mgrad,
                               double&               value,
-                              GVector&              gradient);
+                              GVector&              gradient,
+                              const int&            begin,
+                              const int&            end);
         void poisson_binned(const GObservation&   obs,
                             const GOptimizerPars& pars);
         void poisson_binned(const GObservation&   obs,
                             const GOptimizerPars& pars,
-                            GMatrixSparse&        covar,
+                            GMatrixBase&          covar,
                             GVector&              mgrad,
                             double&               value,
                             double&               npred,
-                            GVector&              gradient);
+                            GVector&              gradient,
+                            const int&            begin,
+                            const int&            end);
         void gaussian_binned(const GObservation&   obs,
                              const GOptimizerPars& pars);
         void gaussian_binned(const GObservation&   obs,
                              const GOptimizerPars& pars,
-                             GMatrixSparse&        covar,
+                             GMatrixBase&          covar,
                              GVector&              mgrad,
                              double&               value,
                              double&               npred,
-                             GVector&              gradient);
+                             GVector&              gradient,
+                             const int&            begin,
+                             const int&            end);
 
     protected:
         // Protected methods
         void           init_members(void);
         void           copy_members(const optimizer& fct);
         void           free_members(void);
+        void           work_items(const int&        nthreads,
+                                  std::vector<int>& item_obs,
+                                  std::vector<int>& item_begin,
+                                  std::vector<int>& item_end) const;
+        void           poisson_unbinned_value(const GObservation&   obs,
+                                              const GOptimizerPars& pars,
+                                              double&               value,
+                                              const int&            begin,
+                                              const int&            end) const;
+        void           poisson_binned_value(const GObservation&   obs,
+                                            const GOptimizerPars& pars,
+                                            double&               value,
+                                            const int&            begin,
+                                            const int&            end) const;
+        void           gaussian_binned_value(const GObservation&   obs,
+                                             const GOptimizerPars& pars,
+                                             double&               value,
+                                             const int&            begin,
+                                             const int&            end) const;
+        void           update_curvature(GMatrixBase&   covar,
+                                        const double&  weight,
+                                        const GVector& wrk_grad,
+                                        const int*     inx,
+                                        const int&     ndev,
+                                        double*        values) const;
 
         // Protected data members
         double         m_value;       //!< Function value
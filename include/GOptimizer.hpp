@@ -32,6 +32,7 @@
 #include "GBase.hpp"
 #include "GOptimizerPars.hpp"
 #include "GOptimizerFunction.hpp"
+#include "GMatrixSymmetric.hpp"
 
 
 /***********************************************************************//**
@@ -49,7 +50,8 @@
  * the parameters using a function. The function value can be accessed
  * using the value() method, the status() method provides an integer with
  * status information, the iter() method gives the number of iterations for
- * iterative optimization algorithms.
+ * iterative optimization algorithms. The covariance() method returns the
+ * covariance matrix of the parameter value factors at the optimum.
  ***************************************************************************/
 class GOptimizer : public GBase {
 
@@ -69,6 +71,7 @@ public:
     virtual double      value(void) const = 0;
     virtual int         status(void) const = 0;
     virtual int         iter(void) const = 0;
+    virtual const GMatrixSymmetric& covariance(void) const = 0;
     virtual std::string print(const GChatter& chatter = NORMAL) const = 0;
 
 protected:
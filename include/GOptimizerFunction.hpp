@@ -46,6 +46,17 @@
  * GOptimizerPars. The value() method returns the actual function value at
  * these parameters, and the gradient() and covar() methods return pointers
  * on the gradient vector and the covariance matrix at the parameter values.
+ *
+ * The eval_value() method returns the function value at a given set of
+ * parameters without computing the gradient vector and the covariance
+ * matrix. Derived classes should overload the method if the function value
+ * can be computed at lower cost than the full evaluation.
+ *
+ * The curvature() methods control whether eval() needs to compute the
+ * covariance matrix. Optimizers that use only the function value and the
+ * gradient vector may switch the computation off. Derived classes should
+ * then skip the computation, in which case covar() returns a matrix of
+ * zeros. By default the covariance matrix is computed.
  ***************************************************************************/
 class GOptimizerFunction {
 
@@ -63,12 +74,45 @@ public:
     virtual double         value(void) = 0;
     virtual GVector*       gradient(void) = 0;
     virtual GMatrixSparse* covar(void) = 0;
+
+    // Other methods
+    virtual double         eval_value(const GOptimizerPars& pars);
+    void                   curvature(const bool& curvature);
+    const bool&            curvature(void) const;
  
 protected:
     // Protected methods
     void init_members(void);
     void copy_members(const GOptimizerFunction& fct);
     void free_members(void);
+
+    // Protected members
+    bool m_curvature;  //!< Compute covariance matrix in eval()
 };
 
+
+/***********************************************************************//**
+ * @brief Set covariance matrix computation flag
+ *
+ * @param[in] curvature Compute covariance matrix in eval()?
+ ***************************************************************************/
+inline
+void GOptimizerFunction::curvature(const bool& curvature)
+{
+    m_curvature = curvature;
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return covariance matrix computation flag
+ *
+ * @return True if eval() computes the covariance matrix.
+ ***************************************************************************/
+inline
+const bool& GOptimizerFunction::curvature(void) const
+{
+    return m_curvature;
+}
+
 #endif /* GOPTIMIZERFUNCTION_HPP */
@@ -0,0 +1,131 @@
+/***************************************************************************
+ *        GOptimizerLBFGSB.hpp - Bound constrained L-BFGS optimizer        *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GOptimizerLBFGSB.hpp
+ * @brief Bound constrained L-BFGS optimizer class interface definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GOPTIMIZERLBFGSB_HPP
+#define GOPTIMIZERLBFGSB_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <vector>
+#include "GOptimizer.hpp"
+#include "GOptimizerFunction.hpp"
+#include "GVector.hpp"
+#include "GLog.hpp"
+
+/* __ Definitions ________________________________________________________ */
+#define G_LBFGSB_CONVERGED        0
+#define G_LBFGSB_STALLED          1
+#define G_LBFGSB_MAX_ITER         2
+#define G_LBFGSB_BAD_ERRORS       3
+
+
+/***********************************************************************//**
+ * @class GOptimizerLBFGSB
+ *
+ * @brief Bound constrained L-BFGS optimizer class
+ *
+ * This class implements a limited memory BFGS optimizer that respects the
+ * minimum and maximum boundaries of the parameters. Contrary to the
+ * Levenberg Marquardt optimizer GOptimizerLM, the optimizer uses only the
+ * function value and the gradient vector, and switches the computation of
+ * the curvature matrix off during the iterations (see
+ * GOptimizerFunction::curvature()). The inverse curvature is approximated
+ * from the last memory() parameter and gradient changes.
+ *
+ * Each iteration determines the set of parameters that sit on a boundary
+ * with a gradient pointing outwards. These parameters are kept fixed
+ * during the iteration, and a search direction is computed for the other
+ * parameters. The step is found by a backtracking line search along the
+ * projection of the search direction onto the parameter boundaries.
+ * Convergence is reached when the function decrease drops below eps().
+ *
+ * After convergence, the curvature matrix is computed once to derive the
+ * parameter errors and the covariance matrix of the parameter value
+ * factors, which is returned by the covariance() method. As for
+ * GOptimizerLM, parameters that sit on a boundary are kept fixed for the
+ * error computation and obtain zero errors.
+ ***************************************************************************/
+class GOptimizerLBFGSB : public GOptimizer {
+
+public:
+
+    // Constructors and destructors
+    GOptimizerLBFGSB(void);
+    explicit GOptimizerLBFGSB(GLog& log);
+    GOptimizerLBFGSB(const GOptimizerLBFGSB& opt);
+    virtual ~GOptimizerLBFGSB(void);
+
+    // Operators
+    GOptimizerLBFGSB& operator=(const GOptimizerLBFGSB& opt);
+
+    // Implemented pure virtual base class methods
+    virtual void              clear(void);
+    virtual GOptimizerLBFGSB* clone(void) const;
+    virtual void              optimize(GOptimizerFunction& fct, GOptimizerPars& pars);
+    virtual double            value(void) const { return m_value; }   //!< @brief Return function value
+    virtual int               status(void) const { return m_status; } //!< @brief Return optimization status
+    virtual int               iter(void) const { return m_iter; }     //!< @brief Return number of iterations
+    virtual const GMatrixSymmetric& covariance(void) const { return m_covariance; } //!< @brief Return covariance matrix
+    virtual std::string       print(const GChatter& chatter = NORMAL) const;
+
+    // Methods
+    void          max_iter(const int& n) { m_max_iter=n; }               //!< @brief Set maximum number of iterations
+    void          max_linesearch(const int& n) { m_max_linesearch=n; }   //!< @brief Set maximum number of line search steps
+    void          memory(const int& n) { m_memory=n; }                   //!< @brief Set number of stored corrections
+    void          eps(const double& eps) { m_eps=eps; }                  //!< @brief Set convergence precision
+    int           max_iter(void) const { return m_max_iter; }            //!< @brief Return maximum number of iterations
+    int           max_linesearch(void) const { return m_max_linesearch; } //!< @brief Return maximum number of line search steps
+    int           memory(void) const { return m_memory; }                //!< @brief Return number of stored corrections
+    const double& eps(void) const { return m_eps; }                      //!< @brief Return convergence precision
+
+protected:
+    // Protected methods
+    void    init_members(void);
+    void    copy_members(const GOptimizerLBFGSB& opt);
+    void    free_members(void);
+    GVector direction(const GVector& grad, const std::vector<bool>& active) const;
+    bool    line_search(GOptimizerFunction& fct, GOptimizerPars& pars,
+                        const GVector& dir, const GVector& grad);
+    void    errors(GOptimizerFunction& fct, GOptimizerPars& pars);
+
+    // Protected members
+    int                  m_npars;           //!< Number of parameters
+    int                  m_nfree;           //!< Number of free parameters
+    double               m_eps;             //!< Absolute precision
+    int                  m_max_iter;        //!< Maximum number of iterations
+    int                  m_max_linesearch;  //!< Maximum number of line search steps
+    int                  m_memory;          //!< Number of stored corrections
+    std::vector<GVector> m_s;               //!< Stored parameter changes
+    std::vector<GVector> m_y;               //!< Stored gradient changes
+    std::vector<double>  m_rho;             //!< Stored 1/(y*s) values
+    double               m_value;           //!< Actual function value
+    int                  m_status;          //!< Fit status
+    int                  m_iter;            //!< Iteration
+    GLog*                m_logger;          //!< Pointer to optional logger
+    GMatrixSymmetric     m_covariance;      //!< Covariance matrix of value factors
+
+};
+
+#endif /* GOPTIMIZERLBFGSB_HPP */
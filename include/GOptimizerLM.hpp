@@ -47,6 +47,10 @@
  * @brief Levenberg Marquardt optimizer class
  *
  * This method implements an Levenberg Marquardt optimizer.
+ *
+ * After convergence, the covariance matrix of the parameter value factors
+ * is computed by inverting the curvature matrix, and it is returned by
+ * the covariance() method. Rows and columns of fixed parameters are zero.
  ***************************************************************************/
 class GOptimizerLM : public GOptimizer {
 
@@ -68,6 +72,7 @@ public:
     virtual double        value(void) const { return m_value; }   //!< @brief Return function value
     virtual int           status(void) const { return m_status; } //!< @brief Return optimization status
     virtual int           iter(void) const { return m_iter; }     //!< @brief Return number of iterations
+    virtual const GMatrixSymmetric& covariance(void) const { return m_covariance; } //!< @brief Return covariance matrix
     virtual std::string   print(const GChatter& chatter = NORMAL) const;
     
     // Methods
@@ -117,6 +122,7 @@ protected:
     int               m_status;          //!< Fit status
     int               m_iter;            //!< Iteration
     GLog*             m_logger;          //!< Pointer to optional logger
+    GMatrixSymmetric  m_covariance;      //!< Covariance matrix of value factors
 
 };
 
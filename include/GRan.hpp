@@ -38,6 +38,13 @@
  * @brief Random number generator class
  *
  * This class implements a random number generator.
+ *
+ * Independent and reproducible random number streams can be derived from
+ * a generator using the stream() method. Each stream is keyed by an
+ * identifier (e.g. an observation, an energy bin or a pixel index), and
+ * the random numbers of a stream only depend on the generator seed and the
+ * identifier. Streams are hence suited for parallel simulations that need
+ * to provide identical results regardless of the number of threads.
  ***************************************************************************/
 class GRan : public GBase {
 
@@ -56,11 +63,15 @@ public:
     GRan*                  clone(void) const;
     void                   seed(unsigned long long int seed);
     unsigned long long int seed(void) const { return m_seed; }
+    GRan                   stream(const unsigned long long int& id) const;
     unsigned long int      int32(void);
     unsigned long long int int64(void);
     double                 uniform(void);
+    void                   uniform(double* values, const int& number);
     double                 exp(const double& lambda);
     double                 poisson(const double& lambda);
+    void                   poisson(const double* lambda, double* values,
+                                   const int& number);
     double                 chisq2(void);
     std::string            print(const GChatter& chatter = NORMAL) const;
   
@@ -39,6 +39,7 @@
 #include "GModelSpatialElliptical.hpp"
 #include "GFunction.hpp"
 #include "GMatrix.hpp"
+#include "GModelPar.hpp"
 
 /* __ Forward declarations _______________________________________________ */
 class GObservation;
@@ -57,6 +58,8 @@ class GObservation;
  * and the true photon arrival time.
  * The npred method returns the integral of the instrument response function
  * over the dataspace. This method is only required for unbinned analysis.
+ * The irf_gradients method returns in addition the partial derivatives of
+ * the instrument response with respect to the spatial model parameters.
  ***************************************************************************/
 class GResponse : public GBase {
 
@@ -97,6 +100,9 @@ public:
     virtual double irf_diffuse(const GEvent&       event,
                                const GSource&      source,
                                const GObservation& obs) const;
+    virtual double irf_gradients(const GEvent&       event,
+                                 const GSource&      source,
+                                 const GObservation& obs) const;
     virtual double npred(const GSource&      source,
                          const GObservation& obs) const;
     virtual double npred_ptsrc(const GSource&      source,
@@ -113,6 +119,32 @@ protected:
     void init_members(void);
     void copy_members(const GResponse& rsp);
     void free_members(void);
+    double irf_gradient(const GEvent&       event,
+                        const GSource&      source,
+                        const GObservation& obs,
+                        const int&          ipar) const;
+
+    // IRF function for numerical spatial parameter derivatives
+    class irf_func : public GFunction {
+    public:
+        irf_func(const GResponse&    rsp,
+                 const GEvent&       event,
+                 const GSource&      source,
+                 const GObservation& obs,
+                 GModelPar&          par) :
+                 m_rsp(rsp),
+                 m_event(event),
+                 m_source(source),
+                 m_obs(obs),
+                 m_par(par) { }
+        double eval(double x);
+    protected:
+        const GResponse&    m_rsp;     //!< Response
+        const GEvent&       m_event;   //!< Event
+        const GSource&      m_source;  //!< Source
+        const GObservation& m_obs;     //!< Observation
+        GModelPar&          m_par;     //!< Spatial model parameter
+    };
 
     // Npred theta integration kernel for radial model
     class npred_radial_kern_theta : public GFunction {
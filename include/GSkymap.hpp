@@ -84,6 +84,10 @@ public:
     const double& operator()(const int& pixel, const int& map = 0) const;
     GSkyDir       pix2dir(const int& pix) const;
     int           dir2pix(const GSkyDir& dir) const;
+    void          pix2dir(const int* pix, const int& n, double* ra,
+                          double* dec) const;
+    void          dir2pix(const double* ra, const double* dec, const int& n,
+                          int* pix) const;
     double        omega(const int& pix) const;
 
     // 2D pixel methods
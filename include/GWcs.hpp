@@ -73,6 +73,12 @@ public:
     // Virtual methods
     virtual std::string coordsys(void) const;
     virtual void        coordsys(const std::string& coordsys);
+    virtual void        world2xy(const int& n, const double* lng,
+                                 const double* lat, double* x,
+                                 double* y) const;
+    virtual void        xy2world(const int& n, const double* x,
+                                 const double* y, double* lng,
+                                 double* lat) const;
 
 protected:
     // Protected methods
@@ -75,6 +75,12 @@ public:
     virtual int         dir2pix(const GSkyDir& dir) const;
     virtual GSkyDir     xy2dir(const GSkyPixel& pix) const;
     virtual GSkyPixel   dir2xy(const GSkyDir& dir) const;
+    virtual void        world2xy(const int& n, const double* lng,
+                                 const double* lat, double* x,
+                                 double* y) const;
+    virtual void        xy2world(const int& n, const double* x,
+                                 const double* y, double* lng,
+                                 double* lat) const;
 
     // Other methods
     void   set(const std::string& coords,
@@ -43,6 +43,7 @@
 /* __ Common tools _______________________________________________________ */
 #include "GException.hpp"
 #include "GNodeArray.hpp"
+#include "GAliasTable.hpp"
 #include "GCsv.hpp"
 #include "GRan.hpp"
 #include "GUrl.hpp"
@@ -58,8 +59,11 @@
 
 /* __ Numerics module ____________________________________________________ */
 #include "GIntegral.hpp"
+#include "GIntegrals.hpp"
+#include "GFft.hpp"
 #include "GDerivative.hpp"
 #include "GFunction.hpp"
+#include "GFunctions.hpp"
 #include "GMath.hpp"
 
 /* __ FITS module ________________________________________________________ */
@@ -116,6 +120,7 @@
 /* __ Optimizer module ___________________________________________________ */
 #include "GOptimizer.hpp"
 #include "GOptimizerLM.hpp"
+#include "GOptimizerLBFGSB.hpp"
 #include "GOptimizerPars.hpp"
 #include "GOptimizerFunction.hpp"
 
@@ -153,6 +158,7 @@
 #include "GObservationRegistry.hpp"
 #include "GEvents.hpp"
 #include "GEventList.hpp"
+#include "GEventBatch.hpp"
 #include "GEventCube.hpp"
 #include "GEvent.hpp"
 #include "GEventAtom.hpp"
@@ -704,11 +704,23 @@ void GCOMEventCube::set_scatter_directions(void)
     m_dirs.reserve(npix());
     m_omega.reserve(npix());
 
+    // Compute sky directions of all pixels at once
+    int                 num = npix();
+    std::vector<int>    pixels(num);
+    std::vector<double> ra(num);
+    std::vector<double> dec(num);
+    for (int i = 0; i < num; ++i) {
+        pixels[i] = i;
+    }
+    m_map.pix2dir(&(pixels[0]), num, &(ra[0]), &(dec[0]));
+
     // Set pixel directions and solid angles
-    for (int iy = 0; iy < npsi(); ++iy) {
-        for (int ix = 0; ix < nchi(); ++ix) {
+    for (int iy = 0, i = 0; iy < npsi(); ++iy) {
+        for (int ix = 0; ix < nchi(); ++ix, ++i) {
             GSkyPixel pixel = GSkyPixel(double(ix), double(iy));
-            m_dirs.push_back(m_map.xy2dir(pixel));
+            GSkyDir   dir;
+            dir.radec_deg(ra[i], dec[i]);
+            m_dirs.push_back(dir);
             m_omega.push_back(m_map.omega(pixel));
         }
     }
@@ -0,0 +1,135 @@
+/***************************************************************************
+ *       GCTADiffuseGrid.hpp - Tabulated CTA diffuse source IRF class      *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTADiffuseGrid.hpp
+ * @brief Tabulated CTA diffuse source IRF class definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GCTADIFFUSEGRID_HPP
+#define GCTADIFFUSEGRID_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <vector>
+#include <string>
+#include "GBase.hpp"
+#include "GSkyDir.hpp"
+#include "GSkymap.hpp"
+#include "GTime.hpp"
+#include "GNodeArray.hpp"
+#include "GModelSpatial.hpp"
+
+/* __ Forward declarations _______________________________________________ */
+class GCTAResponse;
+class GCTAObservation;
+
+
+/***********************************************************************//**
+ * @class GCTADiffuseGrid
+ *
+ * @brief Tabulated CTA diffuse source IRF class
+ *
+ * This class holds the IRF of a diffuse source model, i.e. the diffuse
+ * model intensity multiplied by the effective area and convolved with the
+ * point spread function, for one observation. The IRF is tabulated on a
+ * tangential (TAN) sky map that is centred on the pointing direction and
+ * that covers the events of the observation plus the maximum PSF radius.
+ *
+ * The convolution is done by fast Fourier transforms. As the PSF depends
+ * on the offset angle from the pointing direction, the convolved map is
+ * computed for a set of offset angle nodes, and the IRF of an event is
+ * interpolated linearly in the offset angle of the measured photon
+ * direction, as done by GCTAResponse::irf_diffuse(). The convolved maps
+ * are furthermore computed for a set of energy nodes (the log mean
+ * energies of an event cube, or nodes spaced by 0.1 decades for an event
+ * list), and the IRF is interpolated linearly in log energy and bilinearly
+ * in the sky map pixels.
+ *
+ * The convolved maps of an energy node are only computed by compute() once
+ * an IRF at an adjacent energy is requested. Once computed, a layer is not
+ * altered until the grid is cleared, hence eval() can be called
+ * concurrently for layers that exist.
+ *
+ * The grid keeps the product of the model parameter values for which it was
+ * computed, and eval() scales the tabulated IRF by the ratio of the actual
+ * to that product. This assumes that the diffuse model is linear in its
+ * parameters, which holds for all diffuse models that have a single
+ * normalisation parameter. The grid also keeps an identifier of the model
+ * type and map, so that it is not applied to a different diffuse model.
+ * Energy dispersion is not taken into account.
+ ***************************************************************************/
+class GCTADiffuseGrid : public GBase {
+
+public:
+    // Constructors and destructors
+    GCTADiffuseGrid(void);
+    GCTADiffuseGrid(const GCTADiffuseGrid& grid);
+    virtual ~GCTADiffuseGrid(void);
+
+    // Operators
+    GCTADiffuseGrid& operator=(const GCTADiffuseGrid& grid);
+
+    // Methods
+    void             clear(void);
+    GCTADiffuseGrid* clone(void) const;
+    bool             isempty(void) const { return m_layers.empty(); }
+    bool             isvalid(const GModelSpatial& model) const;
+    const GSkymap&   map(void) const { return m_map; }
+    void             set(const GCTAResponse&    rsp,
+                         const GModelSpatial&   model,
+                         const GCTAObservation& obs);
+    bool             compute(const GCTAResponse&  rsp,
+                             const GModelSpatial& model,
+                             const GTime&         srcTime,
+                             const double&        logE);
+    bool             eval(const GSkyDir&       dir,
+                          const double&        eta,
+                          const double&        logE,
+                          const GModelSpatial& model,
+                          double&              irf) const;
+    std::string      print(const GChatter& chatter = NORMAL) const;
+
+protected:
+    // Protected methods
+    void               init_members(void);
+    void               copy_members(const GCTADiffuseGrid& grid);
+    void               free_members(void);
+    void               compute_layer(const GCTAResponse&  rsp,
+                                     const GModelSpatial& model,
+                                     const GTime&         srcTime,
+                                     const int&           ie);
+    double             norm(const GModelSpatial& model) const;
+    unsigned long long identifier(const GModelSpatial& model) const;
+
+    // Protected members
+    unsigned long long                m_model;    //!< Model identifier of grid
+    double                            m_norm;     //!< Parameter product of grid
+    double                            m_zenith;   //!< Pointing zenith angle
+    double                            m_azimuth;  //!< Pointing azimuth angle
+    GSkyDir                           m_pnt;      //!< Pointing direction
+    GSkymap                           m_map;      //!< Grid geometry
+    double                            m_binsz;    //!< Pixel size (radians)
+    GNodeArray                        m_logE;     //!< log10(E/TeV) nodes
+    GNodeArray                        m_theta;    //!< Offset angle nodes (radians)
+    std::vector<std::vector<double> > m_layers;   //!< Convolved maps per energy
+};
+
+#endif /* GCTADIFFUSEGRID_HPP */
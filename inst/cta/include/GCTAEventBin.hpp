@@ -76,6 +76,7 @@ public:
     virtual std::string        print(const GChatter& chatter = NORMAL) const;
 
     // Other methods
+    const int&     index(void) const { return m_index; }
     const double&  omega(void) const;
     const GEnergy& ewidth(void) const;
     const double&  ontime(void) const;
@@ -87,6 +88,7 @@ protected:
     void free_members(void);
 
     // Protected members
+    int          m_index;       //!< Bin index in event cube
     GEnergy*     m_energy;      //!< Pointer to bin energy
     GCTAInstDir* m_dir;         //!< Pointer to bin direction
     GTime*       m_time;        //!< Pointer to bin time
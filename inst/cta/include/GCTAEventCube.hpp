@@ -30,6 +30,7 @@
 /* __ Includes ___________________________________________________________ */
 #include <string>
 #include <vector>
+#include <map>
 #include "GEventCube.hpp"
 #include "GCTAEventBin.hpp"
 #include "GSkymap.hpp"
@@ -41,6 +42,9 @@
 #include "GFitsTable.hpp"
 #include "GFitsImage.hpp"
 
+/* __ Forward declarations _______________________________________________ */
+class GModelSpatial;
+
 
 /***********************************************************************//**
  * @class GCTAEventCube
@@ -48,6 +52,18 @@
  * @brief CTA event bin container class
  *
  * This class is a container class for CTA event bins.
+ *
+ * The event cube may also hold source maps, i.e. the instrument response
+ * to a source (the spatial model convolved with the effective area and the
+ * point spread function, multiplied by the deadtime correction) for each
+ * bin of the cube. A source map is identified by the name of the source,
+ * and is used by GCTAResponse in place of the IRF computation as long as
+ * the spatial model parameters of the source are fixed and have the values
+ * for which the map was computed (see srcmap_isvalid()). Source maps are
+ * written as image extensions named after the source into the event cube
+ * FITS file. The extensions carry the source name in the SRCMAP keyword
+ * and the spatial parameter values in the SRCPARn keywords, and only image
+ * extensions with a SRCMAP keyword are read back as source maps by read().
  ***************************************************************************/
 class GCTAEventCube : public GEventCube {
 
@@ -83,6 +99,17 @@ public:
     int                    ny(void) const { return m_map.ny(); }
     int                    npix(void) const { return m_map.npix(); }
     int                    ebins(void) const { return m_map.nmaps(); }
+    void                   set_bin(const int& index, GCTAEventBin& bin) const;
+    int                    nsrcmaps(void) const { return m_srcmap.size(); }
+    int                    srcmap_index(const std::string& name) const;
+    const std::string&     srcmap_name(const int& index) const;
+    const GSkymap&         srcmap(const int& index) const;
+    void                   srcmap(const std::string& name, const GSkymap& map,
+                                  const GModelSpatial& model);
+    bool                   srcmap_isvalid(const int& index,
+                                          const GModelSpatial& model) const;
+    void                   remove_srcmaps(void);
+    double                 srcmap_value(const int& index, const int& bin) const;
 
 protected:
     // Protected methods
@@ -92,20 +119,43 @@ protected:
     void         read_cntmap(const GFitsImage* hdu);
     void         read_ebds(const GFitsTable* hdu);
     void         read_gti(const GFitsTable* hdu);
+    void         read_srcmap(const GFitsImage* hdu);
+    void         set_srcmap(const std::string&         name,
+                            const GSkymap&             map,
+                            const std::vector<double>& pars,
+                            const std::string&         origin);
     void         set_directions(void);
     virtual void set_energies(void);
     virtual void set_times(void);
     void         set_bin(const int& index);
 
     // Protected members
-    GSkymap                  m_map;        //!< Counts map stored as sky map
-    GCTAEventBin             m_bin;        //!< Actual event bin
-    GTime                    m_time;       //!< Event cube mean time
-    std::vector<GCTAInstDir> m_dirs;       //!< Array of event directions
-    std::vector<double>      m_omega;      //!< Array of solid angles (sr)
-    std::vector<GEnergy>     m_energies;   //!< Array of log mean energies
-    std::vector<GEnergy>     m_ewidth;     //!< Array of energy bin widths
-    double                   m_ontime;     //!< Event cube ontime (sec)
+    GSkymap                   m_map;           //!< Counts map stored as sky map
+    GCTAEventBin              m_bin;           //!< Actual event bin
+    GTime                     m_time;          //!< Event cube mean time
+    std::vector<GCTAInstDir>  m_dirs;          //!< Array of event directions
+    std::vector<double>       m_omega;         //!< Array of solid angles (sr)
+    std::vector<GEnergy>      m_energies;      //!< Array of log mean energies
+    std::vector<GEnergy>      m_ewidth;        //!< Array of energy bin widths
+    double                    m_ontime;        //!< Event cube ontime (sec)
+    std::vector<GSkymap>      m_srcmap;        //!< Source maps
+    std::vector<std::string>  m_srcmap_names;  //!< Source map names
+    std::map<std::string,int> m_srcmap_index;  //!< Source map index by name
+    std::vector<std::vector<double> > m_srcmap_pars; //!< Spatial parameters of source maps
 };
 
+
+/***********************************************************************//**
+ * @brief Return source map value of an event bin
+ *
+ * @param[in] index Source map index [0,...,nsrcmaps()-1].
+ * @param[in] bin Event bin index [0,...,size()-1].
+ * @return Source map value.
+ ***************************************************************************/
+inline
+double GCTAEventCube::srcmap_value(const int& index, const int& bin) const
+{
+    return (m_srcmap[index].pixels()[bin]);
+}
+
 #endif /* GCTAEVENTCUBE_HPP */
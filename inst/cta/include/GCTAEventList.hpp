@@ -30,9 +30,12 @@
 /* __ Includes ___________________________________________________________ */
 #include <string>
 #include <vector>
+#include <map>
 #include "GEventList.hpp"
 #include "GCTAEventAtom.hpp"
 #include "GCTARoi.hpp"
+#include "GCTAIrfCache.hpp"
+#include "GModelSpatial.hpp"
 #include "GFitsHDU.hpp"
 #include "GFitsTable.hpp"
 #include "GFitsBinTable.hpp"
@@ -44,6 +47,36 @@
  * @brief CTA event atom container class
  *
  * This class is a container class for CTA event atoms.
+ *
+ * The class holds a response cache that stores for each event and source
+ * the instrument response values that have been computed for extended and
+ * diffuse models. The cache is accessed by source name, or by an integer
+ * handle returned by irf_cache_handle(). Before the model is evaluated for
+ * the events, the cache slots of the models are bound to the actual model
+ * parameters using irf_cache_bind(). The handle of a bound slot is then
+ * retrieved for each event using irf_cache_bound(), which neither computes
+ * a signature nor serialises threads. The cache is written into an "IRFCACHE" extension by the
+ * write() method and read back by the read() method, so that response
+ * values need not be recomputed when an event list is fitted again.
+ *
+ * Events are read from FITS files in blocks of rows, so that the memory
+ * needed in addition to the event list is bounded. If skip_columns() is
+ * set before reading, only the columns needed for a likelihood analysis
+ * are read.
+ *
+ * For large data sets the event list can be switched into a compact storage
+ * mode using compact(). In compact mode only the event attributes that are
+ * needed for a likelihood analysis (time, Right Ascension, Declination,
+ * log10 of energy, DETX and DETY) are stored in contiguous arrays, taking
+ * 28 Bytes per event instead of a full GCTAEventAtom. The events of a
+ * compact event list are read-only: the const operator[] returns a view,
+ * which is an event atom that is filled on demand from the arrays, while
+ * the non-const operator[], and hence the event iterator, throw an
+ * exception. Each thread holds a private ring of 4096 views that is shared
+ * by all compact event lists, hence a pointer returned by the operator[]
+ * remains valid until the same thread accessed 4096 further events of any
+ * compact event list. Callers that need an event for longer have to copy
+ * it. Reading an event list in compact mode implies skip_columns().
  ***************************************************************************/
 class GCTAEventList : public GEventList {
 
@@ -61,13 +94,13 @@ public:
     // Implemented pure virtual base class methods
     virtual void           clear(void);
     virtual GCTAEventList* clone(void) const;
-    virtual int            size(void) const { return m_events.size(); }
+    virtual int            size(void) const;
     virtual void           load(const std::string& filename);
     virtual void           save(const std::string& filename,
                                 bool clobber = false) const;
     virtual void           read(const GFits& file);
     virtual void           write(GFits& file) const;
-    virtual int            number(void) const { return m_events.size(); }
+    virtual int            number(void) const { return size(); }
     virtual void           roi(const GRoi& roi);
     virtual const GCTARoi& roi(void) const { return m_roi; }
     std::string            print(const GChatter& chatter = NORMAL) const;
@@ -75,9 +108,26 @@ public:
     // Implement other methods
     void   append(const GCTAEventAtom& event);
     void   reserve(const int& number);
+    void   skip_columns(const bool& skip) { m_skip_columns=skip; }
+    bool   skip_columns(void) const { return m_skip_columns; }
+    void   compact(const bool& compact);
+    bool   compact(void) const { return m_compact; }
     double irf_cache(const std::string& name, const int& index) const;
     void   irf_cache(const std::string& name, const int& index,
                      const double& irf) const;
+    int    irf_cache_handle(const std::string& name,
+                            const std::string& signature = "") const;
+    int    irf_cache_bind(const std::string&   name,
+                          const std::string&   signature,
+                          const GModelSpatial& model) const;
+    void   irf_cache_unbind(void) const;
+    int    irf_cache_bound(const std::string&   name,
+                           const GModelSpatial& model) const;
+    double irf_cache(const int& handle, const int& index) const;
+    void   irf_cache(const int& handle, const int& index,
+                     const double& irf) const;
+    const GCTAIrfCache& irf_cache(void) const { return m_irf_cache; }
+    void                irf_cache(const GCTAIrfCache& cache);
 
 protected:
     // Protected methods
@@ -89,21 +139,44 @@ protected:
     void         read_events(const GFitsTable* hdu);
     void         read_events_v0(const GFitsTable* hdu);
     void         read_events_v1(const GFitsTable* hdu);
+    void         read_events_rows(const GFitsTable* hdu, const bool& v1);
     void         read_events_hillas(const GFitsTable* hdu);
     void         read_ds_ebounds(const GFitsHDU* hdu);
     void         read_ds_roi(const GFitsHDU* hdu);
     void         write_events(GFitsBinTable* hdu) const;
     void         write_ds_keys(GFitsHDU* hdu) const;
-    int          irf_cache_init(const std::string& name) const;
-    int          irf_cache_index(const std::string& name) const;
+    GCTAEventAtom* view(const int& index) const;
 
     // Protected members
-    GCTARoi                    m_roi;     //!< Region of interest
-    std::vector<GCTAEventAtom> m_events;  //!< Events
+    GCTARoi                    m_roi;          //!< Region of interest
+    std::vector<GCTAEventAtom> m_events;       //!< Events
+    bool                       m_skip_columns; //!< Skip unused columns
+
+    // Compact event storage
+    bool                       m_compact;      //!< Use compact storage
+    std::vector<double>        m_col_time;     //!< Event times (secs)
+    std::vector<float>         m_col_ra;       //!< Right Ascension (deg)
+    std::vector<float>         m_col_dec;      //!< Declination (deg)
+    std::vector<float>         m_col_logE;     //!< log10 of energy (TeV)
+    std::vector<float>         m_col_detx;     //!< DETX
+    std::vector<float>         m_col_dety;     //!< DETY
 
-    // IRF cache for diffuse models
-    mutable std::vector<std::string>          m_irf_names;  //!< Model names
-    mutable std::vector<std::vector<double> > m_irf_values; //!< IRF values
+    // IRF cache for extended and diffuse models
+    mutable GCTAIrfCache       m_irf_cache;    //!< Event response cache
+    mutable std::map<std::string,int> m_irf_bound;    //!< Bound cache handles
+    mutable std::vector<std::vector<unsigned long> > m_irf_versions; //!< Bound parameter versions
 };
 
+
+/***********************************************************************//**
+ * @brief Return number of events in list
+ *
+ * @return Number of events.
+ ***************************************************************************/
+inline
+int GCTAEventList::size(void) const
+{
+    return (m_compact ? int(m_col_time.size()) : int(m_events.size()));
+}
+
 #endif /* GCTAEVENTLIST_HPP */
@@ -0,0 +1,122 @@
+/***************************************************************************
+ *              GCTAIrfCache.hpp - CTA event response cache class          *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTAIrfCache.hpp
+ * @brief CTA event response cache class interface definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GCTAIRFCACHE_HPP
+#define GCTAIRFCACHE_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <string>
+#include <vector>
+#include <map>
+#include "GBase.hpp"
+#include "GFits.hpp"
+#include "GFitsTable.hpp"
+
+
+/***********************************************************************//**
+ * @class GCTAIrfCache
+ *
+ * @brief CTA event response cache class
+ *
+ * This class stores pre-computed instrument response function values for
+ * the events of an event list. The cache is organised in slots, where each
+ * slot holds the response values of all events for one source. A slot is
+ * created using the handle() method, which returns an integer handle that
+ * is used to access the slot values using the value() methods. Handles
+ * remain valid as long as the cache is not cleared. Values that have not
+ * been computed are signalled by a value of -1.
+ *
+ * The source name to slot mapping is kept in a search tree, and the values
+ * of each slot are stored in a contiguous array, either in double or in
+ * single precision. Single precision storage halves the memory that is
+ * needed for the cache.
+ *
+ * Each slot carries a signature that identifies the model and response
+ * for which the values were computed. If a slot is requested using the
+ * handle() method with a signature that differs from the one of the slot,
+ * all values of the slot are reset to -1.
+ *
+ * The cache can be written into and read from a FITS binary table with the
+ * extension name "IRFCACHE". The table has one row per event and one
+ * column per slot, where the column name is the source name. The signature
+ * of column n is stored in the header keyword CSIGn. Columns without a
+ * signature are dropped on reading.
+ ***************************************************************************/
+class GCTAIrfCache : public GBase {
+
+public:
+    // Constructors and destructors
+    GCTAIrfCache(void);
+    explicit GCTAIrfCache(const int& nevents, const bool& single = false);
+    GCTAIrfCache(const GCTAIrfCache& cache);
+    virtual ~GCTAIrfCache(void);
+
+    // Operators
+    GCTAIrfCache& operator=(const GCTAIrfCache& cache);
+
+    // Methods
+    void               clear(void);
+    GCTAIrfCache*      clone(void) const;
+    int                size(void) const { return m_names.size(); }
+    bool               isempty(void) const { return m_names.empty(); }
+    const int&         nevents(void) const { return m_nevents; }
+    void               nevents(const int& nevents);
+    const bool&        single(void) const { return m_single; }
+    void               single(const bool& single);
+    int                handle(const std::string& name,
+                              const std::string& signature = "");
+    int                index(const std::string& name) const;
+    const std::string& name(const int& handle) const;
+    const std::string& signature(const int& handle) const;
+    double             value(const int& handle, const int& index) const;
+    void               value(const int& handle, const int& index,
+                             const double& value);
+    int                number(const int& handle) const;
+    void               load(const std::string& filename);
+    void               save(const std::string& filename,
+                            bool clobber = false) const;
+    void               read(const GFits& file);
+    void               read(const GFitsTable* table);
+    void               write(GFits& file) const;
+    std::string        print(const GChatter& chatter = NORMAL) const;
+
+protected:
+    // Protected methods
+    void init_members(void);
+    void copy_members(const GCTAIrfCache& cache);
+    void free_members(void);
+
+    // Protected members
+    int                               m_nevents;    //!< Number of events
+    bool                              m_single;     //!< Single precision storage
+    std::map<std::string,int>         m_slots;      //!< Name to slot map
+    std::vector<std::string>          m_names;      //!< Slot names
+    std::vector<std::string>          m_signatures; //!< Slot signatures
+    std::vector<std::vector<double> > m_values;     //!< Double precision values
+    std::vector<std::vector<float> >  m_fvalues;    //!< Single precision values
+};
+
+#endif /* GCTAIRFCACHE_HPP */
@@ -34,6 +34,7 @@
 #include "GCTAException.hpp"
 #include "GCTAObservation.hpp"
 #include "GCTAEventList.hpp"
+#include "GCTAIrfCache.hpp"
 #include "GCTAEventAtom.hpp"
 #include "GCTAEventCube.hpp"
 #include "GCTAEventBin.hpp"
@@ -42,12 +43,15 @@
 #include "GCTAPointing.hpp"
 #include "GCTAResponse.hpp"
 #include "GCTAResponseTable.hpp"
+#include "GCTARadialGrid.hpp"
+#include "GCTADiffuseGrid.hpp"
 #include "GCTAModelRadial.hpp"
 #include "GCTAModelRadialRegistry.hpp"
 #include "GCTAModelRadialGauss.hpp"
 #include "GCTAModelRadialPolynom.hpp"
 #include "GCTAModelRadialProfile.hpp"
 #include "GCTAModelRadialAcceptance.hpp"
+#include "GCTASimulator.hpp"
 #include "GCTADir.hpp"
 
 /* __ CTA specific definitions ___________________________________________ */
@@ -33,6 +33,7 @@
 #include "GCTAResponse.hpp"
 #include "GTime.hpp"
 #include "GModel.hpp"
+#include "GModels.hpp"
 #include "GFitsTable.hpp"
 
 
@@ -69,10 +70,15 @@ public:
     virtual void             write(GXmlElement& xml) const;
     virtual std::string      print(const GChatter& chatter = NORMAL) const;
 
+    // Overloaded virtual base class methods
+    virtual bool             threadsafe(void) const;
+    virtual void             thread_setup(const GModels& models) const;
+
     // Other methods
     void        load_unbinned(const std::string& filename);
     void        load_binned(const std::string& filename);
     void        save(const std::string& filename, bool clobber) const;
+    void        srcmaps(const GModels& models);
     void        response(const std::string& irfname, std::string caldb = "");
     void        pointing(const GCTAPointing& pointing);
     void        obs_id(const int& id) { m_obs_id=id; }
@@ -41,6 +41,11 @@
  *
  * This class implements the abstract base class for the CTA point spread
  * function.
+ *
+ * Each point spread function carries an identifier that changes whenever
+ * the response parameters are modified (see touch()). Derived classes use
+ * the identifier to decide whether the thread private cache of
+ * interpolated parameters applies to the actual instance.
  ***************************************************************************/
 class GCTAPsf : public GBase {
 
@@ -87,6 +92,10 @@ protected:
     void init_members(void);
     void copy_members(const GCTAPsf& psf);
     void free_members(void);
+    void touch(void);
+
+    // Members
+    unsigned long m_id;  //!< Identifier of response parameters
 };
 
 #endif /* GCTAPSF_HPP */
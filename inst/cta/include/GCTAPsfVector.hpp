@@ -86,11 +86,20 @@ public:
     void read(const GFitsTable* hdu);
 
 private:
+    // PSF parameter cache
+    struct parcache {
+        unsigned long id;    //!< PSF for which precomputation is done
+        double        logE;  //!< Energy for which precomputation is done
+        double        scale; //!< Gaussian normalization
+        double        sigma; //!< Gaussian sigma (radians)
+        double        width; //!< Gaussian width parameter
+    };
+
     // Methods
-    void init_members(void);
-    void copy_members(const GCTAPsfVector& psf);
-    void free_members(void);
-    void update(const double& logE) const;
+    void            init_members(void);
+    void            copy_members(const GCTAPsfVector& psf);
+    void            free_members(void);
+    const parcache& update(const double& logE) const;
 
     // Members
     std::string         m_filename;  //!< Name of Aeff response file
@@ -99,10 +108,10 @@ private:
     std::vector<double> m_sigma;     //!< Sigma value of PSF in radians
 
     // Precomputation cache
-    mutable double      m_par_logE;  //!< Energy for which precomputation is done
-    mutable double      m_par_scale; //!< Gaussian normalization
-    mutable double      m_par_sigma; //!< Gaussian sigma (radians)
-    mutable double      m_par_width; //!< Gaussian width parameter
+    static parcache m_cache; //!< Thread private parameter cache
+    #ifdef _OPENMP
+    #pragma omp threadprivate(m_cache)
+    #endif
 };
 
 #endif /* GCTAPSFVECTOR_HPP */
@@ -0,0 +1,116 @@
+/***************************************************************************
+ *         GCTARadialGrid.hpp - Tabulated CTA radial source IRF class      *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTARadialGrid.hpp
+ * @brief Tabulated CTA radial source IRF class definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GCTARADIALGRID_HPP
+#define GCTARADIALGRID_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <vector>
+#include <string>
+#include "GBase.hpp"
+#include "GVector.hpp"
+#include "GTime.hpp"
+#include "GNodeArray.hpp"
+#include "GModelSpatialRadial.hpp"
+
+/* __ Forward declarations _______________________________________________ */
+class GCTAResponse;
+class GCTAObservation;
+
+
+/***********************************************************************//**
+ * @class GCTARadialGrid
+ *
+ * @brief Tabulated CTA radial source IRF class
+ *
+ * This class holds the IRF of a radial source model, i.e. the radial model
+ * convolved with the effective area and the point spread function, for one
+ * observation on a grid of
+ *
+ * - the distance \f$\zeta\f$ between model centre and measured photon
+ *   direction,
+ * - the azimuth angle \f$\omega_0 \in [0,\pi]\f$ of the pointing direction
+ *   in the model system, measured from the measured photon direction, and
+ * - the logarithm of the photon energy.
+ *
+ * For fixed model parameters these quantities fully determine the IRF, as
+ * the distance between model centre and pointing is constant for a given
+ * observation. Each grid node holds the IRF value, the IRF derivatives for
+ * a displacement of the model centre towards (component 1) and
+ * perpendicular to (component 2) the measured photon direction, and the
+ * derivatives with respect to the parameters following the model position
+ * (components 3 and following). The nodes are computed using
+ * GCTAResponse::irf_radial_components(), hence the class only supports
+ * radial models with analytic parameter gradients (Gaussian and disk).
+ *
+ * The grid keeps the parameter values of the model for which it was
+ * computed, and isvalid() signals whether it applies to a model. The grid
+ * covers the energy range of the events of the observation. Energy
+ * dispersion is not taken into account.
+ ***************************************************************************/
+class GCTARadialGrid : public GBase {
+
+public:
+    // Constructors and destructors
+    GCTARadialGrid(void);
+    GCTARadialGrid(const GCTARadialGrid& grid);
+    virtual ~GCTARadialGrid(void);
+
+    // Operators
+    GCTARadialGrid& operator=(const GCTARadialGrid& grid);
+
+    // Methods
+    void            clear(void);
+    GCTARadialGrid* clone(void) const;
+    int             size(void) const { return m_ncomp; }
+    int             nodes(void) const { return m_values.size() / m_ncomp; }
+    bool            isempty(void) const { return m_values.empty(); }
+    bool            isvalid(const GModelSpatialRadial& model) const;
+    void            set(const GCTAResponse&    rsp,
+                        GModelSpatialRadial&   model,
+                        const GCTAObservation& obs,
+                        const GTime&           srcTime);
+    bool            eval(const double& zeta, const double& omega0,
+                         const double& logE, GVector& values) const;
+    std::string     print(const GChatter& chatter = NORMAL) const;
+
+protected:
+    // Protected methods
+    void init_members(void);
+    void copy_members(const GCTARadialGrid& grid);
+    void free_members(void);
+
+    // Protected members
+    std::vector<double> m_pars;      //!< Model parameter values of grid
+    int                 m_ncomp;     //!< Number of components per node
+    double              m_zeta_max;  //!< Maximum zeta of grid (radians)
+    GNodeArray          m_logE;      //!< log10(E/TeV) nodes
+    GNodeArray          m_zeta;      //!< Zeta nodes (radians)
+    GNodeArray          m_omega;     //!< Omega0 nodes (radians)
+    std::vector<double> m_values;    //!< Node values
+};
+
+#endif /* GCTARADIALGRID_HPP */
@@ -31,6 +31,7 @@
 #include <cmath>
 #include <vector>
 #include <string>
+#include <map>
 #include "GMatrix.hpp"
 #include "GEvent.hpp"
 #include "GModelSky.hpp"
@@ -55,11 +56,14 @@
 #include "GCTAAeff.hpp"
 #include "GCTAPsf.hpp"
 #include "GCTAEdisp.hpp"
+#include "GCTARadialGrid.hpp"
+#include "GCTADiffuseGrid.hpp"
 
 /* __ Type definitions ___________________________________________________ */
 
 /* __ Forward declaration ________________________________________________ */
 class GCTAObservation;
+class GModels;
 
 
 /***********************************************************************//**
@@ -69,6 +73,9 @@ class GCTAObservation;
  ***************************************************************************/
 class GCTAResponse : public GResponse {
 
+    // Friend classes
+    friend class GCTARadialGrid;
+
 public:
     // Constructors and destructors
     GCTAResponse(void);
@@ -93,6 +100,9 @@ public:
     virtual std::string   print(const GChatter& chatter = NORMAL) const;
 
     // Overload virtual base class methods
+    virtual double irf(const GEvent&       event,
+                       const GSource&      source,
+                       const GObservation& obs) const;
     virtual double irf_radial(const GEvent&       event,
                               const GSource&      source,
                               const GObservation& obs) const;
@@ -102,6 +112,9 @@ public:
     virtual double irf_diffuse(const GEvent&       event,
                                const GSource&      source,
                                const GObservation& obs) const;
+    virtual double irf_gradients(const GEvent&       event,
+                                 const GSource&      source,
+                                 const GObservation& obs) const;
     virtual double npred_radial(const GSource&      source,
                                 const GObservation& obs) const;
     virtual double npred_elliptical(const GSource&      source,
@@ -112,6 +125,9 @@ public:
     // Other Methods
     GCTAEventAtom*  mc(const double& area, const GPhoton& photon,
                        const GObservation& obs, GRan& ran) const;
+    bool            mc(const double& area, const GPhoton& photon,
+                       const GObservation& obs, GRan& ran,
+                       GCTAEventAtom& event) const;
     void            caldb(const std::string& caldb);
     std::string     caldb(void) const { return m_caldb; }
     void            load(const std::string& rspname);
@@ -127,6 +143,12 @@ public:
     void            aeff(GCTAAeff* aeff) { m_aeff=aeff; }
     const GCTAPsf*  psf(void) const { return m_psf; }
     void            psf(GCTAPsf* psf) { m_psf=psf; }
+    void            radial_grid(const bool& grid);
+    const bool&     radial_grid(void) const { return m_radial_grid; }
+    void            diffuse_grid(const bool& grid);
+    const bool&     diffuse_grid(void) const { return m_diffuse_grid; }
+    void            irf_cache_init(const GObservation& obs,
+                                   const GModels&      models) const;
 
     // Low-level response methods
     double aeff(const double& theta,
@@ -167,6 +189,43 @@ private:
     void init_members(void);
     void copy_members(const GCTAResponse& rsp);
     void free_members(void);
+    double irf_ptsrc_gradients(const GEvent&       event,
+                               const GSource&      source,
+                               const GObservation& obs) const;
+    double irf_radial_gradients(const GEvent&       event,
+                                const GSource&      source,
+                                const GObservation& obs) const;
+    double irf_elliptical_gradients(const GEvent&       event,
+                                    const GSource&      source,
+                                    const GObservation& obs) const;
+    GVector irf_radial_components(GModelSpatialRadial& model,
+                                  const double&        zenith,
+                                  const double&        azimuth,
+                                  const GEnergy&       srcEng,
+                                  const GTime&         srcTime,
+                                  const double&        obsLogEng,
+                                  const double&        zeta,
+                                  const double&        lambda,
+                                  const double&        eta,
+                                  const double&        obsOmega,
+                                  const double&        omega0) const;
+    bool    radial_analytic(const GModelSpatialRadial& model) const;
+    const GCTARadialGrid* radial_grid(const std::string&     name,
+                                      GModelSpatialRadial&   model,
+                                      const GCTAObservation& obs,
+                                      const GTime&           srcTime) const;
+    void    reset_radial_grids(void) const;
+    const GCTADiffuseGrid* diffuse_grid(const std::string&     name,
+                                        const GModelSpatial&   model,
+                                        const GCTAObservation& obs,
+                                        const GTime&           srcTime,
+                                        const double&          srcLogEng) const;
+    bool    srcmap_irf(const GEvent&       event,
+                       const GSource&      source,
+                       const GObservation& obs,
+                       double&             irf) const;
+    std::string irf_cache_signature(const GModelSpatial& model) const;
+    double      irf_cache_norm(const GModelSpatial& model) const;
 
     // Private data members
     std::string         m_caldb;    //!< Name of or path to the calibration database
@@ -182,6 +241,15 @@ private:
     mutable std::vector<GEnergy>     m_npred_energies; //!< Model energy
     mutable std::vector<GTime>       m_npred_times;    //!< Model time
     mutable std::vector<double>      m_npred_values;   //!< Model values
+
+    // Tabulated radial source IRFs (one map per thread)
+    bool                                             m_radial_grid;  //!< Use grids
+    mutable unsigned long                            m_radial_id;    //!< Grids identifier
+    mutable std::map<const void*,std::map<std::string,GCTARadialGrid> > m_radial_grids; //!< Grids
+
+    // Tabulated diffuse source IRFs (shared by all threads)
+    bool                                           m_diffuse_grid;  //!< Use grids
+    mutable std::map<std::string,GCTADiffuseGrid>  m_diffuse_grids; //!< Grids
 };
 
 #endif /* GCTARESPONSE_HPP */
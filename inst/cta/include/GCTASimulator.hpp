@@ -0,0 +1,105 @@
+/***************************************************************************
+ *              GCTASimulator.hpp - CTA observation simulator class        *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTASimulator.hpp
+ * @brief CTA observation simulator class definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GCTASIMULATOR_HPP
+#define GCTASIMULATOR_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <string>
+#include "GBase.hpp"
+#include "GModels.hpp"
+#include "GObservations.hpp"
+
+
+/***********************************************************************//**
+ * @class GCTASimulator
+ *
+ * @brief CTA observation simulator class
+ *
+ * This class simulates the events of CTA observations for a set of models.
+ * The events container of each observation defines the data space of the
+ * simulation: for an event list, events are simulated within the region
+ * of interest, the energy boundaries and the good time intervals of the
+ * list; for an event cube, events are simulated within the counts cube
+ * and are directly binned into the cube without creating an event list.
+ * The simulated events replace the events of the observation.
+ *
+ * The simulation is split into independent work units, where each unit
+ * comprises one observation, one model and, for sky models, one time slice
+ * of a good time interval. The units are processed in parallel, and each
+ * unit draws its random numbers from its own stream of the random number
+ * generator (see GRan::stream()). The events of all units are merged in a
+ * fixed order, hence the simulation results do not depend on the number
+ * of threads.
+ *
+ * Sky models (GModelSky) are simulated using GModelSky::mc() and
+ * GCTAResponse::mc(), background models (GCTAModelRadialAcceptance) using
+ * GCTAModelRadialAcceptance::mc(). Other models are ignored.
+ ***************************************************************************/
+class GCTASimulator : public GBase {
+
+public:
+    // Constructors and destructors
+    GCTASimulator(void);
+    explicit GCTASimulator(const GModels& models,
+                           const unsigned long long int& seed = 41);
+    GCTASimulator(const GCTASimulator& sim);
+    virtual ~GCTASimulator(void);
+
+    // Operators
+    GCTASimulator& operator=(const GCTASimulator& sim);
+
+    // Methods
+    void                          clear(void);
+    GCTASimulator*                clone(void) const;
+    const GModels&                models(void) const { return m_models; }
+    void                          models(const GModels& models);
+    const unsigned long long int& seed(void) const { return m_seed; }
+    void                          seed(const unsigned long long int& seed);
+    const double&                 area(void) const { return m_area; }
+    void                          area(const double& area);
+    const double&                 margin(void) const { return m_margin; }
+    void                          margin(const double& margin);
+    const double&                 tslice(void) const { return m_tslice; }
+    void                          tslice(const double& tslice);
+    void                          simulate(GObservations& obs) const;
+    std::string                   print(const GChatter& chatter = NORMAL) const;
+
+protected:
+    // Protected methods
+    void init_members(void);
+    void copy_members(const GCTASimulator& sim);
+    void free_members(void);
+
+    // Protected members
+    GModels                m_models;   //!< Models to simulate
+    unsigned long long int m_seed;     //!< Random number generator seed
+    double                 m_area;     //!< Simulation surface area (cm2)
+    double                 m_margin;   //!< Simulation cone margin (deg)
+    double                 m_tslice;   //!< Time slice length (sec)
+};
+
+#endif /* GCTASIMULATOR_HPP */
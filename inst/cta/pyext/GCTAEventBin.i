@@ -57,6 +57,7 @@ public:
     virtual void               counts(const double& counts);
 
     // Other methods
+    const int&     index(void) const;
     const double&  omega(void) const;
     const GEnergy& ewidth(void) const;
     const double&  ontime(void) const;
@@ -61,6 +61,17 @@ public:
     int                    ny(void) const;
     int                    npix(void) const;
     int                    ebins(void) const;
+    void                   set_bin(const int& index, GCTAEventBin& bin) const;
+    int                    nsrcmaps(void) const;
+    int                    srcmap_index(const std::string& name) const;
+    const std::string&     srcmap_name(const int& index) const;
+    const GSkymap&         srcmap(const int& index) const;
+    void                   srcmap(const std::string& name, const GSkymap& map,
+                                  const GModelSpatial& model);
+    bool                   srcmap_isvalid(const int& index,
+                                          const GModelSpatial& model) const;
+    void                   remove_srcmaps(void);
+    double                 srcmap_value(const int& index, const int& bin) const;
 };
 
 
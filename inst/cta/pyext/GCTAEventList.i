@@ -57,6 +57,20 @@ public:
     // Implement other methods
     void                   append(const GCTAEventAtom& event);
     void                   reserve(const int& number);
+    void                   skip_columns(const bool& skip);
+    bool                   skip_columns(void) const;
+    void                   compact(const bool& compact);
+    bool                   compact(void) const;
+    int                    irf_cache_handle(const std::string& name,
+                                            const std::string& signature = "") const;
+    int                    irf_cache_bind(const std::string&   name,
+                                          const std::string&   signature,
+                                          const GModelSpatial& model) const;
+    void                   irf_cache_unbind(void) const;
+    int                    irf_cache_bound(const std::string&   name,
+                                           const GModelSpatial& model) const;
+    const GCTAIrfCache&    irf_cache(void) const;
+    void                   irf_cache(const GCTAIrfCache& cache);
 };
 
 
@@ -0,0 +1,80 @@
+/***************************************************************************
+ *               GCTAIrfCache.i - CTA event response cache class           *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTAIrfCache.i
+ * @brief CTA event response cache class interface definition
+ * @author Juergen Knoedlseder
+ */
+%{
+/* Put headers and other declarations here that are needed for compilation */
+#include "GCTAIrfCache.hpp"
+#include "GTools.hpp"
+%}
+
+
+/***********************************************************************//**
+ * @class GCTAIrfCache
+ *
+ * @brief CTA event response cache class
+ ***************************************************************************/
+class GCTAIrfCache : public GBase {
+
+public:
+    // Constructors and destructors
+    GCTAIrfCache(void);
+    explicit GCTAIrfCache(const int& nevents, const bool& single = false);
+    GCTAIrfCache(const GCTAIrfCache& cache);
+    virtual ~GCTAIrfCache(void);
+
+    // Methods
+    void               clear(void);
+    GCTAIrfCache*      clone(void) const;
+    int                size(void) const;
+    bool               isempty(void) const;
+    const int&         nevents(void) const;
+    void               nevents(const int& nevents);
+    const bool&        single(void) const;
+    void               single(const bool& single);
+    int                handle(const std::string& name,
+                              const std::string& signature = "");
+    int                index(const std::string& name) const;
+    const std::string& name(const int& handle) const;
+    const std::string& signature(const int& handle) const;
+    double             value(const int& handle, const int& index) const;
+    void               value(const int& handle, const int& index,
+                             const double& value);
+    int                number(const int& handle) const;
+    void               load(const std::string& filename);
+    void               save(const std::string& filename,
+                            bool clobber = false) const;
+    void               read(const GFits& file);
+    void               write(GFits& file) const;
+};
+
+
+/***********************************************************************//**
+ * @brief GCTAIrfCache class extension
+ ***************************************************************************/
+%extend GCTAIrfCache {
+    GCTAIrfCache copy() {
+        return (*self);
+    }
+};
@@ -54,10 +54,15 @@ public:
     virtual void             read(const GXmlElement& xml);
     virtual void             write(GXmlElement& xml) const;
 
+    // Overloaded virtual base class methods
+    virtual bool             threadsafe(void) const;
+    virtual void             thread_setup(const GModels& models) const;
+
     // Other methods
     void        load_unbinned(const std::string& filename);
     void        load_binned(const std::string& filename);
     void        save(const std::string& filename, bool clobber) const;
+    void        srcmaps(const GModels& models);
     void        response(const std::string& irfname, std::string caldb = "");
     void        pointing(const GCTAPointing& pointing);
     void        obs_id(const int& id);
@@ -61,6 +61,9 @@ public:
     virtual double irf_diffuse(const GEvent&       event,
                                const GSource&      source,
                                const GObservation& obs) const;
+    virtual double irf_gradients(const GEvent&       event,
+                                 const GSource&      source,
+                                 const GObservation& obs) const;
     virtual double npred_radial(const GSource&      source,
                                 const GObservation& obs) const;
     virtual double npred_diffuse(const GSource&      source,
@@ -69,6 +72,9 @@ public:
     // Other Methods
     GCTAEventAtom*  mc(const double& area, const GPhoton& photon,
                        const GObservation& obs, GRan& ran) const;
+    bool            mc(const double& area, const GPhoton& photon,
+                       const GObservation& obs, GRan& ran,
+                       GCTAEventAtom& event) const;
     void            caldb(const std::string& caldb);
     std::string     caldb(void) const;
     void            load(const std::string& rspname);
@@ -84,6 +90,12 @@ public:
     void            aeff(GCTAAeff* aeff);
     const GCTAPsf*  psf(void) const;
     void            psf(GCTAPsf* psf);
+    void            radial_grid(const bool& grid);
+    const bool&     radial_grid(void) const;
+    void            diffuse_grid(const bool& grid);
+    const bool&     diffuse_grid(void) const;
+    void            irf_cache_init(const GObservation& obs,
+                                   const GModels&      models) const;
 
     // Low-level response methods
     double aeff(const double& theta,
@@ -0,0 +1,72 @@
+/***************************************************************************
+ *               GCTASimulator.i - CTA observation simulator class         *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTASimulator.i
+ * @brief CTA observation simulator class interface definition
+ * @author Juergen Knoedlseder
+ */
+%{
+/* Put headers and other declarations here that are needed for compilation */
+#include "GCTASimulator.hpp"
+#include "GTools.hpp"
+%}
+
+
+/***********************************************************************//**
+ * @class GCTASimulator
+ *
+ * @brief CTA observation simulator class
+ ***************************************************************************/
+class GCTASimulator : public GBase {
+
+public:
+    // Constructors and destructors
+    GCTASimulator(void);
+    explicit GCTASimulator(const GModels& models,
+                           const unsigned long long int& seed = 41);
+    GCTASimulator(const GCTASimulator& sim);
+    virtual ~GCTASimulator(void);
+
+    // Methods
+    void                          clear(void);
+    GCTASimulator*                clone(void) const;
+    const GModels&                models(void) const;
+    void                          models(const GModels& models);
+    const unsigned long long int& seed(void) const;
+    void                          seed(const unsigned long long int& seed);
+    const double&                 area(void) const;
+    void                          area(const double& area);
+    const double&                 margin(void) const;
+    void                          margin(const double& margin);
+    const double&                 tslice(void) const;
+    void                          tslice(const double& tslice);
+    void                          simulate(GObservations& obs) const;
+};
+
+
+/***********************************************************************//**
+ * @brief GCTASimulator class extension
+ ***************************************************************************/
+%extend GCTASimulator {
+    GCTASimulator copy() {
+        return (*self);
+    }
+};
@@ -60,11 +60,14 @@
 %import(module="gammalib.obs") "GRoi.i";
 %import(module="gammalib.model") "GModel.i";
 %import(module="gammalib.model") "GModelData.i";
+%import(module="gammalib.model") "GModels.i";
+%import(module="gammalib.obs") "GObservations.i";
 
 /* __ CTA ________________________________________________________________ */
 %include "GCTAObservation.i"
 %include "GCTAEventCube.i"
 %include "GCTAEventList.i"
+%include "GCTAIrfCache.i"
 %include "GCTAEventBin.i"
 %include "GCTAEventAtom.i"
 %include "GCTAPointing.i"
@@ -87,6 +90,7 @@
 %include "GCTAModelRadialPolynom.i"
 %include "GCTAModelRadialProfile.i"
 %include "GCTAModelRadialAcceptance.i"
+%include "GCTASimulator.i"
 %include "GCTADir.i"
 
 
@@ -0,0 +1,776 @@
+/***************************************************************************
+ *       GCTADiffuseGrid.cpp - Tabulated CTA diffuse source IRF class      *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTADiffuseGrid.cpp
+ * @brief Tabulated CTA diffuse source IRF class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <cmath>
+#include "GTools.hpp"
+#include "GMath.hpp"
+#include "GEnergy.hpp"
+#include "GPhoton.hpp"
+#include "GSkyPixel.hpp"
+#include "GFft.hpp"
+#include "GModelSpatialDiffuseMap.hpp"
+#include "GModelSpatialDiffuseCube.hpp"
+#include "GCTADiffuseGrid.hpp"
+#include "GCTAResponse.hpp"
+#include "GCTAObservation.hpp"
+#include "GCTAEventList.hpp"
+#include "GCTAEventCube.hpp"
+#include "GCTAPointing.hpp"
+#include "GCTAException.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+#define G_SET           "GCTADiffuseGrid::set(GCTAResponse&, GModelSpatial&,"\
+                                                         " GCTAObservation&)"
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+#define G_DLOGE         0.1         //!< Energy node spacing (decades)
+#define G_DTHETA        1.0         //!< Maximum offset node spacing (deg)
+#define G_PSF_STEPS    15.0         //!< Pixels per minimum PSF radius
+#define G_MAX_PIXELS    511         //!< Maximum number of pixels per axis
+#define G_ID_SAMPLES     64         //!< Pixels sampled for model identifier
+
+/* __ Debug definitions __________________________________________________ */
+
+
+/*==========================================================================
+ =                                                                         =
+ =                        Constructors/destructors                         =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GCTADiffuseGrid::GCTADiffuseGrid(void)
+{
+    // Initialise members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] grid Tabulated diffuse source IRF.
+ ***************************************************************************/
+GCTADiffuseGrid::GCTADiffuseGrid(const GCTADiffuseGrid& grid)
+{
+    // Initialise members
+    init_members();
+
+    // Copy members
+    copy_members(grid);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GCTADiffuseGrid::~GCTADiffuseGrid(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                               Operators                                 =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] grid Tabulated diffuse source IRF.
+ * @return Tabulated diffuse source IRF.
+ ***************************************************************************/
+GCTADiffuseGrid& GCTADiffuseGrid::operator=(const GCTADiffuseGrid& grid)
+{
+    // Execute only if object is not identical
+    if (this != &grid) {
+
+        // Free members
+        free_members();
+
+        // Initialise private members for clean destruction
+        init_members();
+
+        // Copy members
+        copy_members(grid);
+
+    } // endif: object was not identical
+
+    // Return this object
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear tabulated diffuse source IRF
+ ***************************************************************************/
+void GCTADiffuseGrid::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise private members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone tabulated diffuse source IRF
+ *
+ * @return Pointer to deep copy of tabulated diffuse source IRF.
+ ***************************************************************************/
+GCTADiffuseGrid* GCTADiffuseGrid::clone(void) const
+{
+    return new GCTADiffuseGrid(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Check if tabulated IRF applies to a diffuse model
+ *
+ * @param[in] model Diffuse model.
+ * @return True if the grid has been set up for the diffuse model and for a
+ *         non-zero model normalisation.
+ *
+ * The grid applies to a model if the model type, the name of the map file,
+ * the size of the map and a sample of its pixel values are the same as for
+ * the model for which the grid was set up (see identifier()). As the tabulated IRF is scaled to the
+ * actual model normalisation by eval(), the grid remains valid when the
+ * model parameters change.
+ ***************************************************************************/
+bool GCTADiffuseGrid::isvalid(const GModelSpatial& model) const
+{
+    // Return flag
+    return (!m_layers.empty() && m_norm != 0.0 &&
+            m_model == identifier(model));
+}
+
+
+/***********************************************************************//**
+ * @brief Set up tabulated diffuse source IRF
+ *
+ * @param[in] rsp CTA response.
+ * @param[in] model Diffuse model.
+ * @param[in] obs CTA observation.
+ *
+ * @exception GCTAException::no_pointing
+ *            No valid CTA pointing found.
+ *
+ * Sets up the geometry of the grid, without computing any convolved map.
+ * The sky map is centred on the pointing direction and covers the region
+ * of interest of an event list, or all pixels of an event cube, plus the
+ * maximum PSF radius. The pixel size is 1/15 of the minimum PSF radius, but
+ * the map has at most 511 x 511 pixels. The offset angle nodes are spaced
+ * by at most 1 deg and cover the region that holds events. If the
+ * observation has no events, no energy range or no region of interest, the
+ * grid is left empty.
+ ***************************************************************************/
+void GCTADiffuseGrid::set(const GCTAResponse&    rsp,
+                          const GModelSpatial&   model,
+                          const GCTAObservation& obs)
+{
+    // Clear grid
+    clear();
+
+    // Get pointing
+    const GCTAPointing *pnt = obs.pointing();
+    if (pnt == NULL) {
+        throw GCTAException::no_pointing(G_SET);
+    }
+
+    // Continue only if an energy range exists
+    if (obs.events() != NULL && obs.events()->ebounds().size() > 0) {
+
+        // Store pointing
+        m_zenith  = pnt->zenith();
+        m_azimuth = pnt->azimuth();
+        m_pnt     = pnt->dir();
+
+        // Get event list or cube
+        const GCTAEventList* list = dynamic_cast<const GCTAEventList*>(obs.events());
+        const GCTAEventCube* cube = dynamic_cast<const GCTAEventCube*>(obs.events());
+
+        // Set energy nodes. For an event cube the nodes are put on the log
+        // mean energies of the cube, otherwise they are spaced by 0.1
+        // decades over the energy range of the events.
+        if (cube != NULL && cube->ebins() > 1) {
+            for (int i = 0; i < cube->ebins(); ++i) {
+                m_logE.append(cube->ebounds().elogmean(i).log10TeV());
+            }
+        }
+        else {
+            double logE_min = obs.events()->emin().log10TeV();
+            double logE_max = obs.events()->emax().log10TeV();
+            int    nlogE    = int((logE_max - logE_min) / G_DLOGE + 0.5) + 1;
+            if (nlogE < 2) {
+                nlogE = 2;
+            }
+            for (int i = 0; i < nlogE; ++i) {
+                m_logE.append(logE_min + (logE_max - logE_min) * double(i) /
+                              double(nlogE-1));
+            }
+        }
+
+        // Determine maximum offset angle of events (radians)
+        double radius = 0.0;
+        if (list != NULL) {
+            radius = list->roi().radius() * gammalib::deg2rad;
+        }
+        else if (cube != NULL) {
+            for (int i = 0; i < cube->map().npix(); ++i) {
+                double offset = m_pnt.dist(cube->map().pix2dir(i));
+                if (offset > radius) {
+                    radius = offset;
+                }
+            }
+        }
+
+        // Determine minimum and maximum PSF radius
+        double delta_min = 0.0;
+        double delta_max = 0.0;
+        for (int i = 0; i < m_logE.size(); ++i) {
+            for (int k = 0; k < 2; ++k) {
+                double delta = rsp.psf_delta_max(k * radius, 0.0,
+                                                 m_zenith, m_azimuth,
+                                                 m_logE[i]);
+                if ((i == 0 && k == 0) || delta < delta_min) {
+                    delta_min = delta;
+                }
+                if ((i == 0 && k == 0) || delta > delta_max) {
+                    delta_max = delta;
+                }
+            }
+        }
+
+        // Continue only if the region and the PSF are valid
+        if (radius > 0.0 && delta_min > 0.0) {
+
+            // Store model identifier and normalisation
+            m_model = identifier(model);
+            m_norm  = norm(model);
+
+            // Set offset angle nodes
+            int ntheta = int(radius * gammalib::rad2deg / G_DTHETA) + 2;
+            for (int i = 0; i < ntheta; ++i) {
+                m_theta.append(radius * double(i) / double(ntheta-1));
+            }
+
+            // Set pixel size and number of pixels
+            double extent = radius + delta_max;
+            m_binsz       = delta_min / G_PSF_STEPS;
+            int    nhalf  = int(extent / m_binsz) + 1;
+            if (2 * nhalf + 1 > G_MAX_PIXELS) {
+                nhalf   = (G_MAX_PIXELS - 1) / 2;
+                m_binsz = extent / double(nhalf);
+            }
+            int npix = 2 * nhalf + 1;
+
+            // Set sky map
+            double binsz = m_binsz * gammalib::rad2deg;
+            m_map = GSkymap("TAN", "CEL", m_pnt.ra_deg(), m_pnt.dec_deg(),
+                            -binsz, binsz, npix, npix, 1);
+
+            // Allocate (empty) layers
+            m_layers.assign(m_logE.size(), std::vector<double>());
+
+        } // endif: region and PSF were valid
+
+    } // endif: energy range existed
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Compute convolved maps for an energy
+ *
+ * @param[in] rsp CTA response.
+ * @param[in] model Diffuse model.
+ * @param[in] srcTime True photon arrival time used for model evaluation.
+ * @param[in] logE log10 of photon energy (E/TeV).
+ * @return True if the energy is within the energy range of the grid.
+ *
+ * Computes the convolved maps of the energy nodes that bracket @p logE if
+ * they do not yet exist. Calls of this method need to be serialised.
+ ***************************************************************************/
+bool GCTADiffuseGrid::compute(const GCTAResponse&  rsp,
+                              const GModelSpatial& model,
+                              const GTime&         srcTime,
+                              const double&        logE)
+{
+    // Return false if grid is empty or energy is outside grid
+    if (m_layers.empty() || logE < m_logE[0] ||
+        logE > m_logE[m_logE.size()-1]) {
+        return false;
+    }
+
+    // Compute bracketing layers if they do not exist
+    GNodeArray::handle he = m_logE.locate(logE);
+    if (m_layers[he.inx_left()].empty()) {
+        compute_layer(rsp, model, srcTime, he.inx_left());
+    }
+    if (m_layers[he.inx_right()].empty()) {
+        compute_layer(rsp, model, srcTime, he.inx_right());
+    }
+
+    // Return
+    return true;
+}
+
+
+/***********************************************************************//**
+ * @brief Interpolate tabulated diffuse source IRF
+ *
+ * @param[in] dir Measured photon direction.
+ * @param[in] eta Angular distance between pointing and measured photon
+ *                direction (radians).
+ * @param[in] logE log10 of photon energy (E/TeV).
+ * @param[in] model Diffuse model.
+ * @param[out] irf Diffuse source IRF.
+ * @return True if the IRF could be interpolated, false if the grid is
+ *         empty, if the energy is outside the energy range of the grid,
+ *         if the convolved maps have not been computed, or if the photon
+ *         direction is outside the sky map.
+ *
+ * Interpolates the IRF linearly in log energy and offset angle and
+ * bilinearly in the sky map pixels, and scales the result to the actual
+ * normalisation of the model.
+ ***************************************************************************/
+bool GCTADiffuseGrid::eval(const GSkyDir&       dir,
+                           const double&        eta,
+                           const double&        logE,
+                           const GModelSpatial& model,
+                           double&              irf) const
+{
+    // Return false if grid is empty or energy is outside grid
+    if (m_layers.empty() || logE < m_logE[0] ||
+        logE > m_logE[m_logE.size()-1]) {
+        return false;
+    }
+
+    // Return false if layers do not exist
+    GNodeArray::handle he = m_logE.locate(logE);
+    if (m_layers[he.inx_left()].empty() || m_layers[he.inx_right()].empty()) {
+        return false;
+    }
+
+    // Return false if direction is outside sky map
+    int       nx  = m_map.nx();
+    int       ny  = m_map.ny();
+    GSkyPixel pix = m_map.dir2xy(dir);
+    if (pix.x() < 0.0 || pix.x() > double(nx-1) ||
+        pix.y() < 0.0 || pix.y() > double(ny-1)) {
+        return false;
+    }
+
+    // Get pixel indices and weights
+    int ix = int(pix.x());
+    int iy = int(pix.y());
+    if (ix > nx-2) {
+        ix = nx-2;
+    }
+    if (iy > ny-2) {
+        iy = ny-2;
+    }
+    double wx = pix.x() - double(ix);
+    double wy = pix.y() - double(iy);
+
+    // Get offset angle node indices and weights
+    double theta = (eta < 0.0) ? 0.0
+                   : ((eta > m_theta[m_theta.size()-1])
+                      ? m_theta[m_theta.size()-1] : eta);
+    GNodeArray::handle ht = m_theta.locate(theta);
+
+    // Set node indices and weights
+    int    ie[2]   = {he.inx_left(), he.inx_right()};
+    int    it[2]   = {ht.inx_left(), ht.inx_right()};
+    double we[2]   = {he.wgt_left(), he.wgt_right()};
+    double wt[2]   = {ht.wgt_left(), ht.wgt_right()};
+    double wpix[4] = {(1.0-wx)*(1.0-wy), wx*(1.0-wy), (1.0-wx)*wy, wx*wy};
+    int    opix[4] = {ix+iy*nx, ix+1+iy*nx, ix+(iy+1)*nx, ix+1+(iy+1)*nx};
+
+    // Sum weighted nodes
+    irf = 0.0;
+    for (int a = 0; a < 2; ++a) {
+        const std::vector<double>& layer = m_layers[ie[a]];
+        for (int b = 0; b < 2; ++b) {
+            double weight = we[a] * wt[b];
+            if (weight != 0.0) {
+                int offset = it[b] * nx * ny;
+                for (int k = 0; k < 4; ++k) {
+                    irf += weight * wpix[k] * layer[offset+opix[k]];
+                }
+            }
+        }
+    }
+
+    // Scale to actual model normalisation
+    irf *= norm(model) / m_norm;
+
+    // Return
+    return true;
+}
+
+
+/***********************************************************************//**
+ * @brief Print tabulated diffuse source IRF information
+ *
+ * @param[in] chatter Chattiness (defaults to NORMAL).
+ * @return String containing tabulated diffuse source IRF information.
+ ***************************************************************************/
+std::string GCTADiffuseGrid::print(const GChatter& chatter) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Continue only if chatter is not silent
+    if (chatter != SILENT) {
+
+        // Determine number of computed layers
+        int ncomputed = 0;
+        for (int i = 0; i < m_layers.size(); ++i) {
+            if (!m_layers[i].empty()) {
+                ncomputed++;
+            }
+        }
+
+        // Append header
+        result.append("=== GCTADiffuseGrid ===");
+
+        // Append information
+        result.append("\n"+gammalib::parformat("Number of energy nodes"));
+        result.append(gammalib::str(m_logE.size()));
+        result.append(" ("+gammalib::str(ncomputed)+" computed)");
+        result.append("\n"+gammalib::parformat("Number of offset nodes"));
+        result.append(gammalib::str(m_theta.size()));
+        result.append("\n"+gammalib::parformat("Number of pixels"));
+        result.append(gammalib::str(m_map.nx())+" x "+gammalib::str(m_map.ny()));
+        result.append("\n"+gammalib::parformat("Pixel size"));
+        result.append(gammalib::str(m_binsz*gammalib::rad2deg)+" deg");
+
+    } // endif: chatter was not silent
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Private methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GCTADiffuseGrid::init_members(void)
+{
+    // Initialise members
+    m_model   = 0;
+    m_norm    = 0.0;
+    m_zenith  = 0.0;
+    m_azimuth = 0.0;
+    m_pnt.clear();
+    m_map.clear();
+    m_binsz   = 0.0;
+    m_logE.clear();
+    m_theta.clear();
+    m_layers.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] grid Tabulated diffuse source IRF.
+ ***************************************************************************/
+void GCTADiffuseGrid::copy_members(const GCTADiffuseGrid& grid)
+{
+    // Copy members
+    m_model   = grid.m_model;
+    m_norm    = grid.m_norm;
+    m_zenith  = grid.m_zenith;
+    m_azimuth = grid.m_azimuth;
+    m_pnt     = grid.m_pnt;
+    m_map     = grid.m_map;
+    m_binsz   = grid.m_binsz;
+    m_logE    = grid.m_logE;
+    m_theta   = grid.m_theta;
+    m_layers  = grid.m_layers;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GCTADiffuseGrid::free_members(void)
+{
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Compute convolved maps of an energy node
+ *
+ * @param[in] rsp CTA response.
+ * @param[in] model Diffuse model.
+ * @param[in] srcTime True photon arrival time used for model evaluation.
+ * @param[in] ie Energy node index.
+ *
+ * Computes the model intensity times the effective area for all pixels of
+ * the sky map and convolves it for each offset angle node with the PSF.
+ * The PSF kernel is normalised to unit sum, hence the convolution
+ * approximates the integral of intensity times effective area times PSF
+ * over solid angle. The arrays are zero padded to the next powers of two.
+ * As the sky map extends by the maximum PSF radius beyond the region that
+ * holds events, the cyclic wrap-around of the convolution does not affect
+ * the IRF within that region.
+ ***************************************************************************/
+void GCTADiffuseGrid::compute_layer(const GCTAResponse&  rsp,
+                                    const GModelSpatial& model,
+                                    const GTime&         srcTime,
+                                    const int&           ie)
+{
+    // Get dimensions
+    int nx     = m_map.nx();
+    int ny     = m_map.ny();
+    int nfft_x = GFft::size2(nx);
+    int nfft_y = GFft::size2(ny);
+    int ntheta = m_theta.size();
+
+    // Set energy
+    double  logE = m_logE[ie];
+    GEnergy srcEng;
+    srcEng.log10TeV(logE);
+
+    // Compute intensity times effective area
+    GFft data(nfft_x, nfft_y);
+    for (int iy = 0; iy < ny; ++iy) {
+        for (int ix = 0; ix < nx; ++ix) {
+            GSkyDir srcDir    = m_map.xy2dir(GSkyPixel(ix, iy));
+            double  intensity = model.eval(GPhoton(srcDir, srcEng, srcTime));
+            if (intensity > 0.0) {
+                double offset = m_pnt.dist(srcDir);
+                data(ix, iy)  = intensity * rsp.aeff(offset, 0.0,
+                                                     m_zenith, m_azimuth,
+                                                     logE);
+            }
+        }
+    }
+
+    // Transform map
+    data.forward();
+
+    // Allocate layer
+    std::vector<double> layer(ntheta * nx * ny, 0.0);
+
+    // Loop over offset angle nodes
+    for (int it = 0; it < ntheta; ++it) {
+
+        // Get PSF radius and kernel half width (at most half the array)
+        double theta     = m_theta[it];
+        double delta_max = rsp.psf_delta_max(theta, 0.0, m_zenith, m_azimuth,
+                                             logE);
+        int    nhalf     = int(delta_max / m_binsz) + 1;
+        if (nhalf > nfft_x/2 - 1) {
+            nhalf = nfft_x/2 - 1;
+        }
+        if (nhalf > nfft_y/2 - 1) {
+            nhalf = nfft_y/2 - 1;
+        }
+
+        // Set PSF kernel centred on the origin of the array
+        GFft   kernel(nfft_x, nfft_y);
+        double sum = 0.0;
+        for (int dy = -nhalf; dy <= nhalf; ++dy) {
+            for (int dx = -nhalf; dx <= nhalf; ++dx) {
+                double delta = m_binsz * std::sqrt(double(dx*dx + dy*dy));
+                if (delta <= delta_max) {
+                    double psf = rsp.psf(delta, theta, 0.0, m_zenith,
+                                         m_azimuth, logE);
+                    kernel((dx + nfft_x) % nfft_x, (dy + nfft_y) % nfft_y) = psf;
+                    sum += psf;
+                }
+            }
+        }
+
+        // Skip node if kernel is empty
+        if (sum <= 0.0) {
+            continue;
+        }
+
+        // Convolve
+        kernel.forward();
+        kernel *= data;
+        kernel.backward();
+
+        // Store normalised convolved map. Negative values arise from
+        // rounding errors only and are set to zero.
+        int offset = it * nx * ny;
+        for (int iy = 0; iy < ny; ++iy) {
+            for (int ix = 0; ix < nx; ++ix) {
+                double value = kernel(ix, iy).real() / sum;
+                layer[offset + ix + iy * nx] = (value > 0.0) ? value : 0.0;
+            }
+        }
+
+    } // endfor: looped over offset angle nodes
+
+    // Store layer
+    m_layers[ie] = layer;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return model normalisation
+ *
+ * @param[in] model Diffuse model.
+ * @return Product of model parameter values.
+ ***************************************************************************/
+double GCTADiffuseGrid::norm(const GModelSpatial& model) const
+{
+    // Compute product of parameter values
+    double norm = 1.0;
+    for (int i = 0; i < model.size(); ++i) {
+        norm *= model[i].value();
+    }
+
+    // Return
+    return norm;
+}
+
+
+/***********************************************************************//**
+ * @brief Return identifier of diffuse model
+ *
+ * @param[in] model Diffuse model.
+ * @return Model identifier.
+ *
+ * Returns a 64-bit FNV-1a hash of the model type, and for map and map
+ * cube models of the name of the map file, of the number of pixels and
+ * maps, and of up to G_ID_SAMPLES pixel values that are evenly spread over
+ * the map. Sampling the pixels distinguishes maps without file name while
+ * keeping the identifier cheap enough to be checked for every IRF value.
+ * Models with the same identifier are assumed to have the same intensity
+ * distribution up to the normalisation.
+ ***************************************************************************/
+unsigned long long GCTADiffuseGrid::identifier(const GModelSpatial& model) const
+{
+    // Get map of map and map cube models
+    const GSkymap*                  map      = NULL;
+    const std::string*              filename = NULL;
+    const GModelSpatialDiffuseMap*  diffmap  =
+          dynamic_cast<const GModelSpatialDiffuseMap*>(&model);
+    const GModelSpatialDiffuseCube* diffcube =
+          dynamic_cast<const GModelSpatialDiffuseCube*>(&model);
+    if (diffmap != NULL) {
+        map      = &(diffmap->map());
+        filename = &(diffmap->filename());
+    }
+    else if (diffcube != NULL) {
+        map      = &(diffcube->cube());
+        filename = &(diffcube->filename());
+    }
+
+    // Hash model type and map file name
+    std::string descriptor = model.type();
+    if (filename != NULL) {
+        descriptor += "|" + *filename;
+    }
+    unsigned long long hash = 14695981039346656037ULL;
+    for (int i = 0; i < descriptor.length(); ++i) {
+        hash ^= (unsigned char)descriptor[i];
+        hash *= 1099511628211ULL;
+    }
+
+    // Hash map size and sampled pixel values
+    if (map != NULL) {
+        int    npix    = map->npix();
+        int    nmaps   = map->nmaps();
+        int    nvalues = npix * nmaps;
+        int    step    = (nvalues > G_ID_SAMPLES) ? nvalues / G_ID_SAMPLES : 1;
+        double values[2] = {double(npix), double(nmaps)};
+        for (int k = 0; k < 2; ++k) {
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&values[k]);
+            for (int i = 0; i < sizeof(double); ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+        }
+        for (int index = 0; index < nvalues; index += step) {
+            double               value = (*map)(index % npix, index / npix);
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+            for (int i = 0; i < sizeof(double); ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+        }
+    }
+
+    // Return identifier
+    return hash;
+}
@@ -439,6 +439,7 @@ std::string GCTAEventBin::print(const GChatter& chatter) const
 void GCTAEventBin::init_members(void)
 {
     // Initialise members
+    m_index  = -1;
     m_energy = NULL;
     m_dir    = NULL;
     m_time   = NULL;
@@ -460,6 +461,7 @@ void GCTAEventBin::init_members(void)
 void GCTAEventBin::copy_members(const GCTAEventBin& bin)
 {
     // Copy members
+    m_index  = bin.m_index;
     m_energy = bin.m_energy;
     m_dir    = bin.m_dir;
     m_time   = bin.m_time;
@@ -28,8 +28,11 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <cmath>
+#include <algorithm>
 #include "GTools.hpp"
 #include "GFits.hpp"
+#include "GModelSpatial.hpp"
 #include "GCTAException.hpp"
 #include "GCTAEventCube.hpp"
 
@@ -38,11 +41,18 @@
 #define G_SET_DIRECTIONS                    "GCTAEventCube::set_directions()"
 #define G_SET_ENERGIES                        "GCTAEventCube::set_energies()"
 #define G_SET_TIME                                "GCTAEventCube::set_time()"
-#define G_SET_BIN                              "GCTAEventCube::set_bin(int&)"
+#define G_SET_BIN               "GCTAEventCube::set_bin(int&, GCTAEventBin&)"
+#define G_SRCMAP_NAME                     "GCTAEventCube::srcmap_name(int&)"
+#define G_SRCMAP1                              "GCTAEventCube::srcmap(int&)"
+#define G_SRCMAP2        "GCTAEventCube::srcmap(std::string&, GSkymap&,"\
+                                                           " GModelSpatial&)"
+#define G_SRCMAP_ISVALID "GCTAEventCube::srcmap_isvalid(int&, GModelSpatial&)"
+#define G_READ_SRCMAP               "GCTAEventCube::read_srcmap(GFitsImage*)"
 
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
+#define G_SRCMAP_PAR_EPS 1.0e-9  //!< Relative precision of source map parameters
 
 /* __ Debug definitions __________________________________________________ */
 
@@ -360,9 +370,10 @@ void GCTAEventCube::save(const std::string& filename, bool clobber) const
  *
  * It is assumed that the counts map resides in the primary extension of the
  * FITS file, the energy boundaries reside in the EBOUNDS extension and the
- * Good Time Intervals reside in the GTI extension.  The method clears the
- * object before loading, thus any events residing in the object before
- * loading will be lost.
+ * Good Time Intervals reside in the GTI extension.  Image extensions with a
+ * SRCMAP keyword are read as source maps, any other image extension is
+ * ignored. The method clears the object before loading, thus any events
+ * residing in the object before loading will be lost.
  ***************************************************************************/
 void GCTAEventCube::read(const GFits& file)
 {
@@ -383,6 +394,14 @@ void GCTAEventCube::read(const GFits& file)
     // Load GTIs
     read_gti(hdu_gti);
 
+    // Load source maps
+    for (int i = 1; i < file.size(); ++i) {
+        if (file.hdu(i)->exttype() == GFitsHDU::HT_IMAGE &&
+            file.hdu(i)->hascard("SRCMAP")) {
+            read_srcmap(file.image(i));
+        }
+    }
+
     // Return
     return;
 }
@@ -392,6 +411,12 @@ void GCTAEventCube::read(const GFits& file)
  * @brief Write CTA event cube into FITS file.
  *
  * @param[in] file FITS file.
+ *
+ * Writes the counts map, the energy boundaries and the Good Time Intervals
+ * into the FITS file, followed by one image extension per source map. The
+ * source map extensions are named after the source, and carry the source
+ * name in the SRCMAP keyword and the spatial parameter values for which the
+ * map was computed in the NSRCPAR and SRCPARn keywords.
  ***************************************************************************/
 void GCTAEventCube::write(GFits& file) const
 {
@@ -404,6 +429,20 @@ void GCTAEventCube::write(GFits& file) const
     // Write Good Time intervals
     gti().write(&file);
 
+    // Write source maps
+    for (int i = 0; i < m_srcmap.size(); ++i) {
+        m_srcmap[i].write(&file);
+        GFitsHDU* hdu = file.hdu(file.size()-1);
+        hdu->extname(m_srcmap_names[i]);
+        hdu->card("SRCMAP", m_srcmap_names[i], "Source name");
+        hdu->card("NSRCPAR", (int)m_srcmap_pars[i].size(),
+                  "Number of spatial parameters");
+        for (int k = 0; k < m_srcmap_pars[i].size(); ++k) {
+            hdu->card("SRCPAR"+gammalib::str(k+1), m_srcmap_pars[i][k],
+                      "Spatial parameter value");
+        }
+    }
+
     // Return
     return;
 }
@@ -447,6 +486,214 @@ void GCTAEventCube::map(const GSkymap& map)
 }
 
 
+/***********************************************************************//**
+ * @brief Set event bin
+ *
+ * @param[in] index Event index [0,...,size()-1].
+ * @param[out] bin Event bin.
+ *
+ * @exception GException::out_of_range
+ *            Event index is outside valid range.
+ * @exception GCTAException::no_energies
+ *            Energy vectors have not been set up.
+ * @exception GCTAException::no_dirs
+ *            Sky directions and solid angles vectors have not been set up.
+ *
+ * Sets up the pointers of an event bin that is allocated by the client.
+ * Contrary to the access operators, which all return the same event bin,
+ * this allows accessing several bins at the same time, for example from
+ * different threads.
+ ***************************************************************************/
+void GCTAEventCube::set_bin(const int& index, GCTAEventBin& bin) const
+{
+    // Optionally check if the index is valid
+    #if defined(G_RANGE_CHECK)
+    if (index < 0 || index >= size())
+        throw GException::out_of_range(G_SET_BIN, index, 0, size()-1);
+    #endif
+
+    // Check for the existence of energies and energy widths
+    if (m_energies.size() != ebins() || m_ewidth.size() != ebins())
+        throw GCTAException::no_energies(G_SET_BIN);
+
+    // Check for the existence of sky directions and solid angles
+    if (m_dirs.size() != npix() || m_omega.size() != npix())
+        throw GCTAException::no_dirs(G_SET_BIN);
+
+    // Get pixel and energy bin indices.
+    int ipix = index % npix();
+    int ieng = index / npix();
+
+    // Set index and pointers (circumvent const correctness)
+    GCTAEventCube* ptr = const_cast<GCTAEventCube*>(this);
+    bin.m_index  = index;
+    bin.m_counts = &(m_map.pixels()[index]);
+    bin.m_energy = &(ptr->m_energies[ieng]);
+    bin.m_time   = &(ptr->m_time);
+    bin.m_dir    = &(ptr->m_dirs[ipix]);
+    bin.m_omega  = &(ptr->m_omega[ipix]);
+    bin.m_ewidth = &(ptr->m_ewidth[ieng]);
+    bin.m_ontime = &(ptr->m_ontime);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return source map index
+ *
+ * @param[in] name Source name.
+ * @return Source map index (-1 if no source map exists for the source).
+ ***************************************************************************/
+int GCTAEventCube::srcmap_index(const std::string& name) const
+{
+    // Search source map
+    std::map<std::string,int>::const_iterator it = m_srcmap_index.find(name);
+
+    // Return index
+    return ((it != m_srcmap_index.end()) ? it->second : -1);
+}
+
+
+/***********************************************************************//**
+ * @brief Return source map name
+ *
+ * @param[in] index Source map index [0,...,nsrcmaps()-1].
+ * @return Source name.
+ *
+ * @exception GException::out_of_range
+ *            Source map index is out of valid range.
+ ***************************************************************************/
+const std::string& GCTAEventCube::srcmap_name(const int& index) const
+{
+    // Optionally check if the index is valid
+    #if defined(G_RANGE_CHECK)
+    if (index < 0 || index >= nsrcmaps()) {
+        throw GException::out_of_range(G_SRCMAP_NAME, index, 0, nsrcmaps()-1);
+    }
+    #endif
+
+    // Return name
+    return (m_srcmap_names[index]);
+}
+
+
+/***********************************************************************//**
+ * @brief Return source map
+ *
+ * @param[in] index Source map index [0,...,nsrcmaps()-1].
+ * @return Source map.
+ *
+ * @exception GException::out_of_range
+ *            Source map index is out of valid range.
+ ***************************************************************************/
+const GSkymap& GCTAEventCube::srcmap(const int& index) const
+{
+    // Optionally check if the index is valid
+    #if defined(G_RANGE_CHECK)
+    if (index < 0 || index >= nsrcmaps()) {
+        throw GException::out_of_range(G_SRCMAP1, index, 0, nsrcmaps()-1);
+    }
+    #endif
+
+    // Return source map
+    return (m_srcmap[index]);
+}
+
+
+/***********************************************************************//**
+ * @brief Set source map
+ *
+ * @param[in] name Source name.
+ * @param[in] map Source map.
+ * @param[in] model Spatial model for which the source map was computed.
+ *
+ * @exception GException::skymap_bad_size
+ *            Source map size differs from event cube size.
+ *
+ * Sets the source map for the named source. An existing source map of the
+ * source is replaced. The source map needs to have the same number of
+ * pixels and maps as the counts map, and holds the instrument response
+ * to the source for each bin, including the deadtime correction. The
+ * spatial parameter values of the model are stored with the source map,
+ * and the map is only used for a model with the same parameter values
+ * (see srcmap_isvalid()).
+ ***************************************************************************/
+void GCTAEventCube::srcmap(const std::string& name, const GSkymap& map,
+                           const GModelSpatial& model)
+{
+    // Get spatial parameter values
+    std::vector<double> pars;
+    for (int i = 0; i < model.size(); ++i) {
+        pars.push_back(model[i].value());
+    }
+
+    // Set source map
+    set_srcmap(name, map, pars, G_SRCMAP2);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Signal if source map applies to spatial model
+ *
+ * @param[in] index Source map index [0,...,nsrcmaps()-1].
+ * @param[in] model Spatial model.
+ * @return True if the source map was computed for the parameter values of
+ *         the model.
+ *
+ * @exception GException::out_of_range
+ *            Source map index is out of range.
+ *
+ * The parameter values are compared with a relative precision of
+ * G_SRCMAP_PAR_EPS, which covers the rounding of the values that are
+ * stored in the FITS header of a saved source map.
+ ***************************************************************************/
+bool GCTAEventCube::srcmap_isvalid(const int& index,
+                                   const GModelSpatial& model) const
+{
+    // Optionally check if the index is valid
+    #if defined(G_RANGE_CHECK)
+    if (index < 0 || index >= nsrcmaps()) {
+        throw GException::out_of_range(G_SRCMAP_ISVALID, index, 0, nsrcmaps()-1);
+    }
+    #endif
+
+    // Get parameter values of source map
+    const std::vector<double>& pars = m_srcmap_pars[index];
+
+    // Compare parameter values
+    bool valid = (pars.size() == model.size());
+    for (int i = 0; valid && i < pars.size(); ++i) {
+        double value = model[i].value();
+        valid = (std::abs(pars[i] - value) <=
+                 G_SRCMAP_PAR_EPS * std::max(std::abs(pars[i]), std::abs(value)));
+    }
+
+    // Return flag
+    return valid;
+}
+
+
+/***********************************************************************//**
+ * @brief Remove all source maps
+ ***************************************************************************/
+void GCTAEventCube::remove_srcmaps(void)
+{
+    // Remove source maps
+    m_srcmap.clear();
+    m_srcmap_names.clear();
+    m_srcmap_index.clear();
+    m_srcmap_pars.clear();
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Print event cube information
  *
@@ -471,6 +718,8 @@ std::string GCTAEventCube::print(const GChatter& chatter) const
                       gammalib::str(npix()));
         result.append("\n"+gammalib::parformat("Number of energy bins") +
                       gammalib::str(ebins()));
+        result.append("\n"+gammalib::parformat("Number of source maps") +
+                      gammalib::str(nsrcmaps()));
 
         // Append GTI intervals
         result.append("\n"+gammalib::parformat("Time interval"));
@@ -522,6 +771,10 @@ void GCTAEventCube::init_members(void)
     m_energies.clear();
     m_ewidth.clear();
     m_ontime = 0.0;
+    m_srcmap.clear();
+    m_srcmap_names.clear();
+    m_srcmap_index.clear();
+    m_srcmap_pars.clear();
 
     // Return
     return;
@@ -536,14 +789,18 @@ void GCTAEventCube::init_members(void)
 void GCTAEventCube::copy_members(const GCTAEventCube& cube)
 {
     // Copy members
-    m_map      = cube.m_map;
-    m_bin      = cube.m_bin;
-    m_time     = cube.m_time;
-    m_dirs     = cube.m_dirs;
-    m_omega    = cube.m_omega;
-    m_energies = cube.m_energies;
-    m_ewidth   = cube.m_ewidth;
-    m_ontime   = cube.m_ontime;
+    m_map          = cube.m_map;
+    m_bin          = cube.m_bin;
+    m_time         = cube.m_time;
+    m_dirs         = cube.m_dirs;
+    m_omega        = cube.m_omega;
+    m_energies     = cube.m_energies;
+    m_ewidth       = cube.m_ewidth;
+    m_ontime       = cube.m_ontime;
+    m_srcmap       = cube.m_srcmap;
+    m_srcmap_names = cube.m_srcmap_names;
+    m_srcmap_index = cube.m_srcmap_index;
+    m_srcmap_pars  = cube.m_srcmap_pars;
 
     // Return
     return;
@@ -640,6 +897,103 @@ void GCTAEventCube::read_gti(const GFitsTable* hdu)
 }
 
 
+/***********************************************************************//**
+ * @brief Read source map from HDU.
+ *
+ * @param[in] hdu Pointer to image HDU.
+ *
+ * @exception GException::skymap
+ *            Source map projection differs from counts map projection.
+ * @exception GException::skymap_bad_size
+ *            Source map size differs from event cube size.
+ *
+ * Reads a source map from a FITS image. The source map is named after the
+ * SRCMAP keyword of the HDU, and the spatial parameter values for which
+ * the map was computed are read from the NSRCPAR and SRCPARn keywords. A
+ * source map without parameter values does not apply to any model.
+ ***************************************************************************/
+void GCTAEventCube::read_srcmap(const GFitsImage* hdu)
+{
+    // Continue only if HDU is valid
+    if (hdu != NULL) {
+
+        // Get source name
+        std::string name = hdu->string("SRCMAP");
+
+        // Read source map
+        GSkymap map;
+        map.read(hdu);
+
+        // Check that source map WCS is consistent with counts map WCS
+        if (m_map.wcs() == NULL || map.wcs() == NULL ||
+            *(m_map.wcs()) != *(map.wcs())) {
+            throw GException::skymap(G_READ_SRCMAP, "Projection of source"
+                                     " map \""+name+"\" differs"
+                                     " from counts map projection.");
+        }
+
+        // Get spatial parameter values
+        std::vector<double> pars;
+        int npars = (hdu->hascard("NSRCPAR")) ? hdu->integer("NSRCPAR") : 0;
+        for (int i = 0; i < npars; ++i) {
+            pars.push_back(hdu->real("SRCPAR"+gammalib::str(i+1)));
+        }
+
+        // Set source map
+        set_srcmap(name, map, pars, G_READ_SRCMAP);
+
+    } // endif: HDU was valid
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set source map and its spatial parameter values
+ *
+ * @param[in] name Source name.
+ * @param[in] map Source map.
+ * @param[in] pars Spatial parameter values for which the map was computed.
+ * @param[in] origin Name of the calling method.
+ *
+ * @exception GException::skymap_bad_size
+ *            Source map size differs from event cube size.
+ *
+ * Sets the source map for the named source. An existing source map of the
+ * source is replaced.
+ ***************************************************************************/
+void GCTAEventCube::set_srcmap(const std::string&         name,
+                               const GSkymap&             map,
+                               const std::vector<double>& pars,
+                               const std::string&         origin)
+{
+    // Check source map size
+    if (map.npix() != npix() || map.nmaps() != ebins()) {
+        throw GException::skymap_bad_size(origin,
+                                          map.npix()*map.nmaps(), size(),
+                                          "Source map \""+name+"\" does"
+                                          " not match the event cube.");
+    }
+
+    // Replace or append source map
+    int index = srcmap_index(name);
+    if (index >= 0) {
+        m_srcmap[index]      = map;
+        m_srcmap_pars[index] = pars;
+    }
+    else {
+        m_srcmap_index[name] = m_srcmap.size();
+        m_srcmap.push_back(map);
+        m_srcmap_names.push_back(name);
+        m_srcmap_pars.push_back(pars);
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Set sky directions and solid angles of events cube.
  *
@@ -666,11 +1020,23 @@ void GCTAEventCube::set_directions(void)
     m_dirs.reserve(npix());
     m_omega.reserve(npix());
 
+    // Compute sky directions of all pixels at once
+    int                 num = npix();
+    std::vector<int>    pixels(num);
+    std::vector<double> ra(num);
+    std::vector<double> dec(num);
+    for (int i = 0; i < num; ++i) {
+        pixels[i] = i;
+    }
+    m_map.pix2dir(&(pixels[0]), num, &(ra[0]), &(dec[0]));
+
     // Set pixel directions and solid angles
-    for (int iy = 0; iy < ny(); ++iy) {
-        for (int ix = 0; ix < nx(); ++ix) {
+    for (int iy = 0, i = 0; iy < ny(); ++iy) {
+        for (int ix = 0; ix < nx(); ++ix, ++i) {
             GSkyPixel pixel = GSkyPixel(double(ix), double(iy));
-            m_dirs.push_back(GCTAInstDir(m_map.xy2dir(pixel)));
+            GSkyDir   dir;
+            dir.radec_deg(ra[i], dec[i]);
+            m_dirs.push_back(GCTAInstDir(dir));
             m_omega.push_back(m_map.omega(pixel));
         }
     }
@@ -768,32 +1134,8 @@ void GCTAEventCube::set_times(void)
  ***************************************************************************/
 void GCTAEventCube::set_bin(const int& index)
 {
-    // Optionally check if the index is valid
-    #if defined(G_RANGE_CHECK)
-    if (index < 0 || index >= size())
-        throw GException::out_of_range(G_SET_BIN, index, 0, size()-1);
-    #endif
-
-    // Check for the existence of energies and energy widths
-    if (m_energies.size() != ebins() || m_ewidth.size() != ebins())
-        throw GCTAException::no_energies(G_SET_BIN);
-
-    // Check for the existence of sky directions and solid angles
-    if (m_dirs.size() != npix() || m_omega.size() != npix())
-        throw GCTAException::no_dirs(G_SET_BIN);
-
-    // Get pixel and energy bin indices.
-    int ipix = index % npix();
-    int ieng = index / npix();
-
-    // Set pointers
-    m_bin.m_counts = &(m_map.pixels()[index]);
-    m_bin.m_energy = &(m_energies[ieng]);
-    m_bin.m_time   = &m_time;
-    m_bin.m_dir    = &(m_dirs[ipix]);
-    m_bin.m_omega  = &(m_omega[ipix]);
-    m_bin.m_ewidth = &(m_ewidth[ieng]);
-    m_bin.m_ontime = &m_ontime;
+    // Set event bin
+    set_bin(index, m_bin);
 
     // Return
     return;
@@ -28,10 +28,16 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <cmath>
 #include "GCTAEventList.hpp"
 #include "GCTAException.hpp"
+#include "GException.hpp"
 #include "GTools.hpp"
 #include "GFits.hpp"
+#include "GFitsTableCol.hpp"
 #include "GFitsTableBitCol.hpp"
 #include "GFitsTableFloatCol.hpp"
 #include "GFitsTableDoubleCol.hpp"
@@ -46,10 +52,43 @@
 #define G_ROI                                     "GCTAEventList::roi(GRoi&)"
 #define G_READ_DS_EBOUNDS         "GCTAEventList::read_ds_ebounds(GFitsHDU*)"
 #define G_READ_DS_ROI                 "GCTAEventList::read_ds_roi(GFitsHDU*)"
+#define G_IRF_CACHE                 "GCTAEventList::irf_cache(GCTAIrfCache&)"
 
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
+#define G_READ_BLOCK_SIZE 100000   //!< Number of rows read in one block
+#define G_VIEW_RING_SIZE      4096   //!< Number of event views per thread
+
+/* __ Static members _____________________________________________________ */
+static GCTAEventAtom* g_view_ring = NULL;  //!< Ring of event views
+static int            g_view_next = 0;     //!< Next view in ring
+#ifdef _OPENMP
+#pragma omp threadprivate(g_view_ring, g_view_next)
+#endif
+
+/***********************************************************************//**
+ * @class GCTAEventViewRings
+ *
+ * @brief Registry of the event view rings of all threads
+ *
+ * Keeps the event view rings that were allocated by the threads and
+ * deletes them when the program ends.
+ ***************************************************************************/
+class GCTAEventViewRings {
+public:
+    ~GCTAEventViewRings(void) {
+        for (int i = 0; i < m_rings.size(); ++i) {
+            delete [] m_rings[i];
+        }
+    }
+    void append(GCTAEventAtom* ring) {
+        #pragma omp critical(GCTAEventViewRings_append)
+        m_rings.push_back(ring);
+    }
+private:
+    std::vector<GCTAEventAtom*> m_rings;  //!< Event view rings
+};
 
 /* __ Debug definitions __________________________________________________ */
 
@@ -147,8 +186,13 @@ GCTAEventList& GCTAEventList::operator=(const GCTAEventList& list)
  *
  * @exception GException::out_of_range
  *            Event index outside valid range.
+ * @exception GException::invalid_value
+ *            Event list is in compact storage mode.
  *
- * Returns pointer to an event atom.
+ * Returns pointer to an event atom. In compact storage mode the events are
+ * read-only, as modifications of an event view would not be stored in the
+ * event list, hence an exception is thrown. Use the const operator to
+ * access the events of a compact event list.
  ***************************************************************************/
 GCTAEventAtom* GCTAEventList::operator[](const int& index)
 {
@@ -159,6 +203,14 @@ GCTAEventAtom* GCTAEventList::operator[](const int& index)
     }
     #endif
 
+    // Throw an exception in compact storage mode
+    if (m_compact) {
+        std::string msg = "Events of an event list in compact storage mode"
+                          " are read-only. Use the const operator[] or"
+                          " switch to full storage using compact(false).";
+        throw GException::invalid_value(G_OPERATOR, msg);
+    }
+
     // Return pointer
     return (&(m_events[index]));
 }
@@ -172,7 +224,8 @@ GCTAEventAtom* GCTAEventList::operator[](const int& index)
  * @exception GException::out_of_range
  *            Event index outside valid range.
  *
- * Returns pointer to an event atom.
+ * Returns pointer to an event atom. In compact storage mode a pointer to
+ * an event view is returned.
  ***************************************************************************/
 const GCTAEventAtom* GCTAEventList::operator[](const int& index) const
 {
@@ -183,6 +236,11 @@ const GCTAEventAtom* GCTAEventList::operator[](const int& index) const
     }
     #endif
 
+    // Return pointer to view in compact storage mode
+    if (m_compact) {
+        return (view(index));
+    }
+
     // Return pointer
     return (&(m_events[index]));
 }
@@ -238,12 +296,17 @@ GCTAEventList* GCTAEventList::clone(void) const
  * and read the Good Time Intervals from the GTI extension.
  *
  * The method clears the object before loading, thus any events residing in
- * the object before loading will be lost.
+ * the object before loading will be lost. The column selection set by
+ * skip_columns() and the storage mode set by compact() are kept.
  ***************************************************************************/
 void GCTAEventList::load(const std::string& filename)
 {
-    // Clear object
+    // Clear object, but keep column selection and storage mode
+    bool skip_columns = m_skip_columns;
+    bool compact      = m_compact;
     clear();
+    m_skip_columns = skip_columns;
+    m_compact      = compact;
 
     // Open FITS file
     GFits file(filename);
@@ -297,16 +360,24 @@ void GCTAEventList::save(const std::string& filename, bool clobber) const
  * "GTI". If no "GTI" extension is present, a single Good Time Interval will
  * be assumed based on the TSTART and TSTOP keywords.
  *
+ * If present, pre-computed IRF values will be read into the IRF cache from
+ * an extension named "IRFCACHE".
+ *
  * The method clears the object before reading, thus any information residing
- * in the event list prior to reading will be lost.
+ * in the event list prior to reading will be lost. The column selection set
+ * by skip_columns() and the storage mode set by compact() are kept.
  *
  * @todo Ultimately, any events file should have a GTI extension, hence the
  *       extraction of GTIs from TSTART and TSTOP should not be necessary.
  ***************************************************************************/
 void GCTAEventList::read(const GFits& file)
 {
-    // Clear object
+    // Clear object, but keep column selection and storage mode
+    bool skip_columns = m_skip_columns;
+    bool compact      = m_compact;
     clear();
+    m_skip_columns = skip_columns;
+    m_compact      = compact;
 
     // Get event list HDU
     GFitsTable* events = file.table("EVENTS");
@@ -349,6 +420,16 @@ void GCTAEventList::read(const GFits& file)
     // Read energy boundaries from data selection keyword
     read_ds_ebounds(events);
 
+    // If we have an IRF cache extension, then read the IRF cache from that
+    // extension. The cache is dropped if it does not match the events
+    if (file.hashdu("IRFCACHE")) {
+        irf_cache_unbind();
+        m_irf_cache.read(file.table("IRFCACHE"));
+        if (m_irf_cache.nevents() != size()) {
+            m_irf_cache.clear();
+        }
+    }
+
     // Return
     return;
 }
@@ -359,7 +440,8 @@ void GCTAEventList::read(const GFits& file)
  *
  * @param[in] file FITS file.
  *
- * Write the CTA event list into FITS file.
+ * Write the CTA event list into FITS file. If the IRF cache is not empty,
+ * it is written into an extension named "IRFCACHE".
  *
  * @todo The TELMASK column is allocated with a dummy length of 100.
  * @todo Implement agreed column format
@@ -384,6 +466,11 @@ void GCTAEventList::write(GFits& file) const
     // Append GTI to FITS file
     gti().write(&file);
 
+    // Append IRF cache to FITS file
+    if (m_irf_cache.nevents() == size()) {
+        m_irf_cache.write(file);
+    }
+
     // Return
     return;
 }
@@ -467,17 +554,11 @@ std::string GCTAEventList::print(const GChatter& chatter) const
 
         // EXPLICIT: Append IRF cache
         if (chatter >= EXPLICIT) {
-            for (int i = 0; i < m_irf_names.size(); ++i) {
+            for (int i = 0; i < m_irf_cache.size(); ++i) {
                 result.append("\n"+gammalib::parformat("IRF cache " +
                               gammalib::str(i)));
-                result.append(m_irf_names[i]+" = ");
-                int num   = 0;
-                for (int k = 0; k < size(); ++k) {
-                    if ((m_irf_values[i])[k] != -1.0) {
-                        num++;
-                    }
-                }
-                result.append(gammalib::str(num)+" values");
+                result.append(m_irf_cache.name(i)+" = ");
+                result.append(gammalib::str(m_irf_cache.number(i))+" values");
             }
         } // endif: chatter was explicit
 
@@ -493,16 +574,28 @@ std::string GCTAEventList::print(const GChatter& chatter) const
  *
  * @param[in] event Event.
  *
- * Appends an event atom to the event list.
+ * Appends an event atom to the event list. In compact storage mode only
+ * the event attributes that are needed for a likelihood analysis are
+ * appended.
  ***************************************************************************/
 void GCTAEventList::append(const GCTAEventAtom& event)
 {
-    // Append event
-    m_events.push_back(event);
+    // Compact storage: append event attributes
+    if (m_compact) {
+        m_col_time.push_back(event.m_time.secs());
+        m_col_ra.push_back(float(event.m_dir.ra_deg()));
+        m_col_dec.push_back(float(event.m_dir.dec_deg()));
+        m_col_logE.push_back(float(event.m_energy.log10TeV()));
+        m_col_detx.push_back(event.m_detx);
+        m_col_dety.push_back(event.m_dety);
+    }
 
-    // Set event index
-    int index = m_events.size()-1;
-    m_events[index].m_index = index;
+    // ... otherwise append event and set event index
+    else {
+        m_events.push_back(event);
+        int index = m_events.size()-1;
+        m_events[index].m_index = index;
+    }
 
     // Return
     return;
@@ -519,7 +612,82 @@ void GCTAEventList::append(const GCTAEventAtom& event)
 void GCTAEventList::reserve(const int& number)
 {
     // Reserve space
-    m_events.reserve(number);
+    if (m_compact) {
+        m_col_time.reserve(number);
+        m_col_ra.reserve(number);
+        m_col_dec.reserve(number);
+        m_col_logE.reserve(number);
+        m_col_detx.reserve(number);
+        m_col_dety.reserve(number);
+    }
+    else {
+        m_events.reserve(number);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set storage mode
+ *
+ * @param[in] compact Use compact storage?
+ *
+ * Switches the event list between full and compact storage. The events in
+ * the list are converted into the new storage mode. When switching into
+ * compact storage, all event attributes that are not needed for a
+ * likelihood analysis are lost, and the event directions and energies are
+ * reduced to single precision.
+ ***************************************************************************/
+void GCTAEventList::compact(const bool& compact)
+{
+    // Continue only if storage mode changes
+    if (compact != m_compact) {
+
+        // Get number of events
+        int num = size();
+
+        // Convert into compact storage
+        if (compact) {
+            m_col_time.resize(num);
+            m_col_ra.resize(num);
+            m_col_dec.resize(num);
+            m_col_logE.resize(num);
+            m_col_detx.resize(num);
+            m_col_dety.resize(num);
+            for (int i = 0; i < num; ++i) {
+                const GCTAEventAtom& event = m_events[i];
+                m_col_time[i] = event.m_time.secs();
+                m_col_ra[i]   = float(event.m_dir.ra_deg());
+                m_col_dec[i]  = float(event.m_dir.dec_deg());
+                m_col_logE[i] = float(event.m_energy.log10TeV());
+                m_col_detx[i] = event.m_detx;
+                m_col_dety[i] = event.m_dety;
+            }
+            std::vector<GCTAEventAtom>().swap(m_events);
+        }
+
+        // ... otherwise convert into full storage
+        else {
+            std::vector<GCTAEventAtom> events(num);
+            for (int i = 0; i < num; ++i) {
+                events[i]         = *(view(i));
+                events[i].m_index = i;
+            }
+            m_events.swap(events);
+            std::vector<double>().swap(m_col_time);
+            std::vector<float>().swap(m_col_ra);
+            std::vector<float>().swap(m_col_dec);
+            std::vector<float>().swap(m_col_logE);
+            std::vector<float>().swap(m_col_detx);
+            std::vector<float>().swap(m_col_dety);
+        }
+
+        // Set storage mode
+        m_compact = compact;
+
+    } // endif: storage mode changed
 
     // Return
     return;
@@ -540,10 +708,21 @@ void GCTAEventList::init_members(void)
     // Initialise members
     m_roi.clear();
     m_events.clear();
+    m_skip_columns = false;
+
+    // Initialise compact event storage
+    m_compact = false;
+    m_col_time.clear();
+    m_col_ra.clear();
+    m_col_dec.clear();
+    m_col_logE.clear();
+    m_col_detx.clear();
+    m_col_dety.clear();
 
     // Initialise cache
-    m_irf_names.clear();
-    m_irf_values.clear();
+    m_irf_cache.clear();
+    m_irf_bound.clear();
+    m_irf_versions.clear();
 
     // Return
     return;
@@ -558,12 +737,23 @@ void GCTAEventList::init_members(void)
 void GCTAEventList::copy_members(const GCTAEventList& list)
 {
     // Copy members
-    m_roi    = list.m_roi;
-    m_events = list.m_events;
+    m_roi          = list.m_roi;
+    m_events       = list.m_events;
+    m_skip_columns = list.m_skip_columns;
+
+    // Copy compact event storage
+    m_compact  = list.m_compact;
+    m_col_time = list.m_col_time;
+    m_col_ra   = list.m_col_ra;
+    m_col_dec  = list.m_col_dec;
+    m_col_logE = list.m_col_logE;
+    m_col_detx = list.m_col_detx;
+    m_col_dety = list.m_col_dety;
 
     // Copy cache
-    m_irf_names  = list.m_irf_names;
-    m_irf_values = list.m_irf_values;
+    m_irf_cache    = list.m_irf_cache;
+    m_irf_bound    = list.m_irf_bound;
+    m_irf_versions = list.m_irf_versions;
 
     // Return
     return;
@@ -593,6 +783,12 @@ void GCTAEventList::read_events(const GFitsTable* table)
 {
     // Clear existing events
     m_events.clear();
+    m_col_time.clear();
+    m_col_ra.clear();
+    m_col_dec.clear();
+    m_col_logE.clear();
+    m_col_detx.clear();
+    m_col_dety.clear();
 
     // Continue only if HDU is valid
     if (table != NULL) {
@@ -637,70 +833,25 @@ void GCTAEventList::read_events(const GFitsTable* table)
  ***************************************************************************/
 void GCTAEventList::read_events_v0(const GFitsTable* table)
 {
-    // Clear existing events
-    m_events.clear();
+    // Read events without OBS_ID, SHWIDTH and SHLENGTH columns
+    read_events_rows(table, false);
 
-    // Continue only if HDU is valid
-    if (table != NULL) {
-
-        // Extract number of events in FITS file
-        int num = table->integer("NAXIS2");
-
-        // If there are events then load them
-        if (num > 0) {
-
-            // Reserve data
-            m_events.reserve(num);
-
-            // Get column pointers
-            GFitsTableULongCol*  ptr_eid         = (GFitsTableULongCol*)&(*table)["EVENT_ID"];
-            GFitsTableDoubleCol* ptr_time        = (GFitsTableDoubleCol*)&(*table)["TIME"];
-            GFitsTableShortCol*  ptr_multip      = (GFitsTableShortCol*)&(*table)["MULTIP"];
-            GFitsTableFloatCol*  ptr_ra          = (GFitsTableFloatCol*)&(*table)["RA"];
-            GFitsTableFloatCol*  ptr_dec         = (GFitsTableFloatCol*)&(*table)["DEC"];
-            GFitsTableFloatCol*  ptr_dir_err     = (GFitsTableFloatCol*)&(*table)["DIR_ERR"];
-            GFitsTableFloatCol*  ptr_detx        = (GFitsTableFloatCol*)&(*table)["DETX"];
-            GFitsTableFloatCol*  ptr_dety        = (GFitsTableFloatCol*)&(*table)["DETY"];
-            GFitsTableFloatCol*  ptr_alt         = (GFitsTableFloatCol*)&(*table)["ALT"];
-            GFitsTableFloatCol*  ptr_az          = (GFitsTableFloatCol*)&(*table)["AZ"];
-            GFitsTableFloatCol*  ptr_corex       = (GFitsTableFloatCol*)&(*table)["COREX"];
-            GFitsTableFloatCol*  ptr_corey       = (GFitsTableFloatCol*)&(*table)["COREY"];
-            GFitsTableFloatCol*  ptr_core_err    = (GFitsTableFloatCol*)&(*table)["CORE_ERR"];
-            GFitsTableFloatCol*  ptr_xmax        = (GFitsTableFloatCol*)&(*table)["XMAX"];
-            GFitsTableFloatCol*  ptr_xmax_err    = (GFitsTableFloatCol*)&(*table)["XMAX_ERR"];
-            GFitsTableFloatCol*  ptr_energy      = (GFitsTableFloatCol*)&(*table)["ENERGY"];
-            GFitsTableFloatCol*  ptr_energy_err  = (GFitsTableFloatCol*)&(*table)["ENERGY_ERR"];
-
-            // Copy data from columns into GCTAEventAtom objects
-            GCTAEventAtom event;
-            for (int i = 0; i < num; ++i) {
-                event.m_index     = i;
-                event.m_time.set((*ptr_time)(i), m_gti.reference());
-                event.m_dir.radec_deg((*ptr_ra)(i), (*ptr_dec)(i));
-                event.m_energy.TeV((*ptr_energy)(i));
-                event.m_event_id    = (*ptr_eid)(i);
-                event.m_obs_id      = 0;
-                event.m_multip      = (*ptr_multip)(i);
-                event.m_telmask     = 0;
-                event.m_dir_err     = (*ptr_dir_err)(i);
-                event.m_detx        = (*ptr_detx)(i);
-                event.m_dety        = (*ptr_dety)(i);
-                event.m_alt         = (*ptr_alt)(i);
-                event.m_az          = (*ptr_az)(i);
-                event.m_corex       = (*ptr_corex)(i);
-                event.m_corey       = (*ptr_corey)(i);
-                event.m_core_err    = (*ptr_core_err)(i);
-                event.m_xmax        = (*ptr_xmax)(i);
-                event.m_xmax_err    = (*ptr_xmax_err)(i);
-                event.m_shwidth     = 0.0;
-                event.m_shlength    = 0.0;
-                event.m_energy_err  = (*ptr_energy_err)(i);
-                m_events.push_back(event);
-            }
+    // Return
+    return;
+}
 
-        } // endif: there were events
 
-    } // endif: HDU was valid
+/***********************************************************************//**
+ * @brief Read CTA events from FITS table (version 1)
+ *
+ * @param[in] table FITS table pointer.
+ *
+ * This method reads the CTA event list from a FITS table HDU into memory.
+ ***************************************************************************/
+void GCTAEventList::read_events_v1(const GFitsTable* table)
+{
+    // Read events including OBS_ID, SHWIDTH and SHLENGTH columns
+    read_events_rows(table, true);
 
     // Return
     return;
@@ -708,18 +859,33 @@ void GCTAEventList::read_events_v0(const GFitsTable* table)
 
 
 /***********************************************************************//**
- * @brief Read CTA events from FITS table (version 1)
+ * @brief Read CTA events from FITS table in blocks of rows
  *
  * @param[in] table FITS table pointer.
+ * @param[in] v1 Read version 1 columns (OBS_ID, SHWIDTH and SHLENGTH).
  *
  * This method reads the CTA event list from a FITS table HDU into memory.
+ * The table is read in blocks of G_READ_BLOCK_SIZE rows, which are streamed from
+ * the FITS file without loading the full table columns, hence the memory
+ * needed in addition to the event list is bounded by the block size. The
+ * events of each block are then set up in parallel.
  *
- * @todo Implement agreed column format
+ * If skip_columns() is set, only the columns needed for a likelihood
+ * analysis (EVENT_ID, OBS_ID, TIME, RA, DEC, DETX, DETY and ENERGY) are
+ * read, and all other event attributes are set to 0. In compact storage
+ * mode, only the TIME, RA, DEC, DETX, DETY and ENERGY columns are read
+ * into the compact event arrays.
  ***************************************************************************/
-void GCTAEventList::read_events_v1(const GFitsTable* table)
+void GCTAEventList::read_events_rows(const GFitsTable* table, const bool& v1)
 {
     // Clear existing events
     m_events.clear();
+    m_col_time.clear();
+    m_col_ra.clear();
+    m_col_dec.clear();
+    m_col_logE.clear();
+    m_col_detx.clear();
+    m_col_dety.clear();
 
     // Continue only if HDU is valid
     if (table != NULL) {
@@ -730,58 +896,138 @@ void GCTAEventList::read_events_v1(const GFitsTable* table)
         // If there are events then load them
         if (num > 0) {
 
-            // Reserve data
-            m_events.reserve(num);
-
-            // Get column pointers
-            GFitsTableULongCol*  ptr_eid         = (GFitsTableULongCol*)&(*table)["EVENT_ID"];
-            GFitsTableULongCol*  ptr_oid         = (GFitsTableULongCol*)&(*table)["OBS_ID"];
-            GFitsTableDoubleCol* ptr_time        = (GFitsTableDoubleCol*)&(*table)["TIME"];
-            GFitsTableShortCol*  ptr_multip      = (GFitsTableShortCol*)&(*table)["MULTIP"];
-            GFitsTableFloatCol*  ptr_ra          = (GFitsTableFloatCol*)&(*table)["RA"];
-            GFitsTableFloatCol*  ptr_dec         = (GFitsTableFloatCol*)&(*table)["DEC"];
-            GFitsTableFloatCol*  ptr_dir_err     = (GFitsTableFloatCol*)&(*table)["DIR_ERR"];
-            GFitsTableFloatCol*  ptr_detx        = (GFitsTableFloatCol*)&(*table)["DETX"];
-            GFitsTableFloatCol*  ptr_dety        = (GFitsTableFloatCol*)&(*table)["DETY"];
-            GFitsTableFloatCol*  ptr_alt         = (GFitsTableFloatCol*)&(*table)["ALT"];
-            GFitsTableFloatCol*  ptr_az          = (GFitsTableFloatCol*)&(*table)["AZ"];
-            GFitsTableFloatCol*  ptr_corex       = (GFitsTableFloatCol*)&(*table)["COREX"];
-            GFitsTableFloatCol*  ptr_corey       = (GFitsTableFloatCol*)&(*table)["COREY"];
-            GFitsTableFloatCol*  ptr_core_err    = (GFitsTableFloatCol*)&(*table)["CORE_ERR"];
-            GFitsTableFloatCol*  ptr_xmax        = (GFitsTableFloatCol*)&(*table)["XMAX"];
-            GFitsTableFloatCol*  ptr_xmax_err    = (GFitsTableFloatCol*)&(*table)["XMAX_ERR"];
-            GFitsTableFloatCol*  ptr_shw         = (GFitsTableFloatCol*)&(*table)["SHWIDTH"];
-            GFitsTableFloatCol*  ptr_shl         = (GFitsTableFloatCol*)&(*table)["SHLENGTH"];
-            GFitsTableFloatCol*  ptr_energy      = (GFitsTableFloatCol*)&(*table)["ENERGY"];
-            GFitsTableFloatCol*  ptr_energy_err  = (GFitsTableFloatCol*)&(*table)["ENERGY_ERR"];
-
-            // Copy data from columns into GCTAEventAtom objects
-            GCTAEventAtom event;
-            for (int i = 0; i < num; ++i) {
-                event.m_index     = i;
-                event.m_time.set((*ptr_time)(i), m_gti.reference());
-                event.m_dir.radec_deg((*ptr_ra)(i), (*ptr_dec)(i));
-                event.m_energy.TeV((*ptr_energy)(i));
-                event.m_event_id   = (*ptr_eid)(i);
-                event.m_obs_id     = (*ptr_oid)(i);
-                event.m_multip     = (*ptr_multip)(i);
-                event.m_telmask    = 0;
-                event.m_dir_err    = (*ptr_dir_err)(i);
-                event.m_detx       = (*ptr_detx)(i);
-                event.m_dety       = (*ptr_dety)(i);
-                event.m_alt        = (*ptr_alt)(i);
-                event.m_az         = (*ptr_az)(i);
-                event.m_corex      = (*ptr_corex)(i);
-                event.m_corey      = (*ptr_corey)(i);
-                event.m_core_err   = (*ptr_core_err)(i);
-                event.m_xmax       = (*ptr_xmax)(i);
-                event.m_xmax_err   = (*ptr_xmax_err)(i);
-                event.m_shwidth    = (*ptr_shw)(i);
-                event.m_shlength   = (*ptr_shl)(i);
-                event.m_energy_err = (*ptr_energy_err)(i);
-                m_events.push_back(event);
+            // Set column names and flag the columns that are read. The
+            // order of the columns defines the buffer layout.
+            const int   ncols        = 20;
+            const char* names[ncols] = {"EVENT_ID", "OBS_ID", "TIME",
+                                        "MULTIP", "RA", "DEC", "DIR_ERR",
+                                        "DETX", "DETY", "ALT", "AZ",
+                                        "COREX", "COREY", "CORE_ERR",
+                                        "XMAX", "XMAX_ERR", "SHWIDTH",
+                                        "SHLENGTH", "ENERGY", "ENERGY_ERR"};
+            const bool  needed[ncols] = {true, true, true, false, true, true,
+                                         false, true, true, false, false,
+                                         false, false, false, false, false,
+                                         false, false, true, false};
+            const bool  in_compact[ncols] = {false, false, true, false, true,
+                                             true, false, true, true, false,
+                                             false, false, false, false,
+                                             false, false, false, false,
+                                             true, false};
+            const bool  in_v1[ncols]  = {false, true, false, false, false,
+                                         false, false, false, false, false,
+                                         false, false, false, false, false,
+                                         false, true, true, false, false};
+
+            // Get column pointers. Columns that are not read are NULL.
+            std::vector<const GFitsTableCol*> columns(ncols, NULL);
+            for (int k = 0; k < ncols; ++k) {
+                bool read = (m_compact) ? in_compact[k]
+                                        : (needed[k] || !m_skip_columns);
+                if ((v1 || !in_v1[k]) && read) {
+                    columns[k] = &((*table)[std::string(names[k])]);
+                }
             }
 
+            // Allocate events and block buffer. Buffers of columns that are
+            // not read are initialised to 0.
+            if (m_compact) {
+                m_col_time.resize(num);
+                m_col_ra.resize(num);
+                m_col_dec.resize(num);
+                m_col_logE.resize(num);
+                m_col_detx.resize(num);
+                m_col_dety.resize(num);
+            }
+            else {
+                m_events.resize(num);
+            }
+            int                 nblock = (num < G_READ_BLOCK_SIZE) ? num : G_READ_BLOCK_SIZE;
+            std::vector<double> buffer(ncols*nblock, 0.0);
+
+            // Get buffer pointers
+            const double* eid        = &(buffer[ 0*nblock]);
+            const double* oid        = &(buffer[ 1*nblock]);
+            const double* time       = &(buffer[ 2*nblock]);
+            const double* multip     = &(buffer[ 3*nblock]);
+            const double* ra         = &(buffer[ 4*nblock]);
+            const double* dec        = &(buffer[ 5*nblock]);
+            const double* dir_err    = &(buffer[ 6*nblock]);
+            const double* detx       = &(buffer[ 7*nblock]);
+            const double* dety       = &(buffer[ 8*nblock]);
+            const double* alt        = &(buffer[ 9*nblock]);
+            const double* az         = &(buffer[10*nblock]);
+            const double* corex      = &(buffer[11*nblock]);
+            const double* corey      = &(buffer[12*nblock]);
+            const double* core_err   = &(buffer[13*nblock]);
+            const double* xmax       = &(buffer[14*nblock]);
+            const double* xmax_err   = &(buffer[15*nblock]);
+            const double* shwidth    = &(buffer[16*nblock]);
+            const double* shlength   = &(buffer[17*nblock]);
+            const double* energy     = &(buffer[18*nblock]);
+            const double* energy_err = &(buffer[19*nblock]);
+
+            // Get time reference
+            const GTimeReference& timeref = m_gti.reference();
+
+            // Loop over blocks of rows
+            for (int row = 0; row < num; row += nblock) {
+
+                // Determine number of rows in block
+                int nrows = (row+nblock <= num) ? nblock : num-row;
+
+                // Read block of rows for all columns
+                for (int k = 0; k < ncols; ++k) {
+                    if (columns[k] != NULL) {
+                        columns[k]->read_rows(row, nrows, &(buffer[k*nblock]));
+                    }
+                }
+
+                // Copy data from block into compact event arrays
+                if (m_compact) {
+                    #pragma omp parallel for
+                    for (int i = 0; i < nrows; ++i) {
+                        GTime evtime;
+                        evtime.set(time[i], timeref);
+                        m_col_time[row+i] = evtime.secs();
+                        m_col_ra[row+i]   = float(ra[i]);
+                        m_col_dec[row+i]  = float(dec[i]);
+                        m_col_logE[row+i] = float(std::log10(energy[i]));
+                        m_col_detx[row+i] = float(detx[i]);
+                        m_col_dety[row+i] = float(dety[i]);
+                    }
+                    continue;
+                }
+
+                // Copy data from block into GCTAEventAtom objects
+                #pragma omp parallel for
+                for (int i = 0; i < nrows; ++i) {
+                    GCTAEventAtom& event = m_events[row+i];
+                    event.m_index      = row+i;
+                    event.m_time.set(time[i], timeref);
+                    event.m_dir.radec_deg(ra[i], dec[i]);
+                    event.m_energy.TeV(energy[i]);
+                    event.m_event_id   = (unsigned long)(eid[i]);
+                    event.m_obs_id     = (unsigned long)(oid[i]);
+                    event.m_multip     = int(multip[i]);
+                    event.m_telmask    = 0;
+                    event.m_dir_err    = dir_err[i];
+                    event.m_detx       = detx[i];
+                    event.m_dety       = dety[i];
+                    event.m_alt        = alt[i];
+                    event.m_az         = az[i];
+                    event.m_corex      = corex[i];
+                    event.m_corey      = corey[i];
+                    event.m_core_err   = core_err[i];
+                    event.m_xmax       = xmax[i];
+                    event.m_xmax_err   = xmax_err[i];
+                    event.m_shwidth    = shwidth[i];
+                    event.m_shlength   = shlength[i];
+                    event.m_energy_err = energy_err[i];
+                }
+
+            } // endfor: looped over blocks
+
         } // endif: there were events
 
     } // endif: HDU was valid
@@ -800,14 +1046,15 @@ void GCTAEventList::read_events_v1(const GFitsTable* table)
  * from an EVENTS file. It searches for the columns HIL_MSW, HIL_MSW_ERR,
  * HIL_MSL, and HIL_MSL_ERR in the FITS table and extracts the relevant
  * columns from the FITS file. If a column is not found, no action is
- * performed.
+ * performed. The columns are read in blocks of G_READ_BLOCK_SIZE rows. No
+ * Hillas information is read if skip_columns() or compact() is set.
  *
  * @todo Verify consistency of event list size
  ***************************************************************************/
 void GCTAEventList::read_events_hillas(const GFitsTable* table)
 {
-    // Continue only if HDU is valid
-    if (table != NULL) {
+    // Continue only if HDU is valid and columns should be read
+    if (table != NULL && !m_skip_columns && !m_compact) {
 
         // Extract number of events in FITS file
         int num = table->integer("NAXIS2");
@@ -818,41 +1065,52 @@ void GCTAEventList::read_events_hillas(const GFitsTable* table)
         // Continue only if there are events
         if (num > 0) {
 
-            // HIL_MSW
-            if (table->hascolumn("HIL_MSW")) {
-                GFitsTableFloatCol* ptr =
-                     (GFitsTableFloatCol*)&(*table)["HIL_MSW"];
-                for (int i = 0; i < num; ++i) {
-                    m_events[i].m_hil_msw = (*ptr)(i);
+            // Get column pointers and event members. Columns that do not
+            // exist are NULL.
+            const int   ncols        = 4;
+            const char* names[ncols] = {"HIL_MSW", "HIL_MSW_ERR",
+                                        "HIL_MSL", "HIL_MSL_ERR"};
+            float GCTAEventAtom::* members[ncols] =
+                                       {&GCTAEventAtom::m_hil_msw,
+                                        &GCTAEventAtom::m_hil_msw_err,
+                                        &GCTAEventAtom::m_hil_msl,
+                                        &GCTAEventAtom::m_hil_msl_err};
+            std::vector<const GFitsTableCol*> columns(ncols, NULL);
+            for (int k = 0; k < ncols; ++k) {
+                if (table->hascolumn(names[k])) {
+                    columns[k] = &((*table)[std::string(names[k])]);
                 }
             }
 
-            // HIL_MSW_ERR
-            if (table->hascolumn("HIL_MSW_ERR")) {
-                GFitsTableFloatCol* ptr =
-                     (GFitsTableFloatCol*)&(*table)["HIL_MSW_ERR"];
-                for (int i = 0; i < num; ++i) {
-                    m_events[i].m_hil_msw_err = (*ptr)(i);
-                }
-            }
+            // Allocate block buffer
+            int                 nblock = (num < G_READ_BLOCK_SIZE) ? num : G_READ_BLOCK_SIZE;
+            std::vector<double> buffer(nblock);
 
-            // HIL_MSL
-            if (table->hascolumn("HIL_MSL")) {
-                GFitsTableFloatCol* ptr =
-                     (GFitsTableFloatCol*)&(*table)["HIL_MSL"];
-                for (int i = 0; i < num; ++i) {
-                    m_events[i].m_hil_msl = (*ptr)(i);
-                }
-            }
+            // Loop over columns
+            for (int k = 0; k < ncols; ++k) {
 
-            // HIL_MSL_ERR
-            if (table->hascolumn("HIL_MSL_ERR")) {
-                GFitsTableFloatCol* ptr =
-                     (GFitsTableFloatCol*)&(*table)["HIL_MSL_ERR"];
-                for (int i = 0; i < num; ++i) {
-                    m_events[i].m_hil_msl_err = (*ptr)(i);
+                // Skip column if it does not exist
+                if (columns[k] == NULL) {
+                    continue;
                 }
-            }
+
+                // Loop over blocks of rows
+                for (int row = 0; row < num; row += nblock) {
+
+                    // Determine number of rows in block
+                    int nrows = (row+nblock <= num) ? nblock : num-row;
+
+                    // Read block of rows
+                    columns[k]->read_rows(row, nrows, &(buffer[0]));
+
+                    // Copy data into events
+                    for (int i = 0; i < nrows; ++i) {
+                        m_events[row+i].*(members[k]) = buffer[i];
+                    }
+
+                } // endfor: looped over blocks
+
+            } // endfor: looped over columns
 
         } // endif: there were events
 
@@ -1037,7 +1295,8 @@ void GCTAEventList::read_ds_roi(const GFitsHDU* hdu)
  *
  * @param[in] hdu FITS table HDU.
  *
- * Write the CTA event list into FITS table.
+ * Write the CTA event list into FITS table. In compact storage mode, all
+ * event attributes that are not stored are written as 0.
  *
  * @todo The TELMASK column is allocated with a dummy length of 100.
  * @todo Implement agreed column format
@@ -1083,32 +1342,33 @@ void GCTAEventList::write_events(GFitsBinTable* hdu) const
 
             // Fill columns
             for (int i = 0; i < size(); ++i) {
-                col_eid(i)         = m_events[i].m_event_id;
-                col_oid(i)         = m_events[i].m_obs_id;
-                col_time(i)        = m_events[i].time().convert(m_gti.reference());
+                const GCTAEventAtom* event = (*this)[i];
+                col_eid(i)         = event->m_event_id;
+                col_oid(i)         = event->m_obs_id;
+                col_time(i)        = event->time().convert(m_gti.reference());
                 col_live(i)        = 0.0;
                 col_multip(i)      = 0;
                 //col_telmask
-                col_ra(i)          = m_events[i].dir().ra_deg();
-                col_dec(i)         = m_events[i].dir().dec_deg();
-                col_direrr(i)      = m_events[i].m_dir_err;
-                col_detx(i)        = m_events[i].m_detx;
-                col_dety(i)        = m_events[i].m_dety;
-                col_alt(i)         = m_events[i].m_alt;
-                col_az(i)          = m_events[i].m_az;
-                col_corex(i)       = m_events[i].m_corex;
-                col_corey(i)       = m_events[i].m_corey;
-                col_core_err(i)    = m_events[i].m_core_err;
-                col_xmax(i)        = m_events[i].m_xmax;
-                col_xmax_err(i)    = m_events[i].m_xmax_err;
-                col_shw(i)         = m_events[i].m_shwidth;
-                col_shl(i)         = m_events[i].m_shlength;
-                col_energy(i)      = m_events[i].energy().TeV();
-                col_energy_err(i)  = m_events[i].m_energy_err;
-                col_hil_msw(i)     = m_events[i].m_hil_msw;
-                col_hil_msw_err(i) = m_events[i].m_hil_msw_err;
-                col_hil_msl(i)     = m_events[i].m_hil_msl;
-                col_hil_msl_err(i) = m_events[i].m_hil_msl_err;
+                col_ra(i)          = event->dir().ra_deg();
+                col_dec(i)         = event->dir().dec_deg();
+                col_direrr(i)      = event->m_dir_err;
+                col_detx(i)        = event->m_detx;
+                col_dety(i)        = event->m_dety;
+                col_alt(i)         = event->m_alt;
+                col_az(i)          = event->m_az;
+                col_corex(i)       = event->m_corex;
+                col_corey(i)       = event->m_corey;
+                col_core_err(i)    = event->m_core_err;
+                col_xmax(i)        = event->m_xmax;
+                col_xmax_err(i)    = event->m_xmax_err;
+                col_shw(i)         = event->m_shwidth;
+                col_shl(i)         = event->m_shlength;
+                col_energy(i)      = event->energy().TeV();
+                col_energy_err(i)  = event->m_energy_err;
+                col_hil_msw(i)     = event->m_hil_msw;
+                col_hil_msw_err(i) = event->m_hil_msw_err;
+                col_hil_msl(i)     = event->m_hil_msl;
+                col_hil_msl_err(i) = event->m_hil_msl_err;
             } // endfor: looped over rows
 
             // Append columns to table
@@ -1211,102 +1471,298 @@ void GCTAEventList::write_ds_keys(GFitsHDU* hdu) const
 
 
 /***********************************************************************//**
- * @brief Initialize IRF cache for a given model
+ * @brief Return event view for compact storage
  *
- * @param[in] name Model name.
- * @return Cache index (-1 if invalid).
+ * @param[in] index Event index [0,...,size()-1].
+ * @return Pointer to event view.
+ *
+ * Fills the next event view of the ring of the calling thread with the
+ * event attributes from the compact event arrays and returns a pointer to
+ * the view. Event attributes that are not stored in compact mode keep
+ * their initial value of 0.
+ *
+ * The ring is thread private storage that is allocated on first use by a
+ * thread and shared by all compact event lists, hence any number of
+ * threads, including threads of nested parallel regions, can access the
+ * views concurrently. The returned pointer remains valid until the same
+ * thread has requested G_VIEW_RING_SIZE further views. The rings are
+ * registered in a function-local static registry that deletes them when
+ * the program ends.
  ***************************************************************************/
-int GCTAEventList::irf_cache_init(const std::string& name) const
+GCTAEventAtom* GCTAEventList::view(const int& index) const
 {
-    // Initialise cache index
-    int index = irf_cache_index(name);
+    // Registry of the rings of all threads
+    static GCTAEventViewRings rings;
+
+    // Allocate and register ring of views for the calling thread if needed
+    if (g_view_ring == NULL) {
+        g_view_ring = new GCTAEventAtom[G_VIEW_RING_SIZE];
+        g_view_next = 0;
+        rings.append(g_view_ring);
+    }
+
+    // Get next view in ring
+    GCTAEventAtom* event = &(g_view_ring[g_view_next]);
+    g_view_next = (g_view_next+1) % G_VIEW_RING_SIZE;
 
-    // Continue only if model does not yet exist
-    if (index == -1) {
+    // Fill view from compact event arrays
+    event->m_index = index;
+    event->m_time.secs(m_col_time[index]);
+    event->m_dir.radec_deg(m_col_ra[index], m_col_dec[index]);
+    event->m_energy.log10TeV(m_col_logE[index]);
+    event->m_detx  = m_col_detx[index];
+    event->m_dety  = m_col_dety[index];
+
+    // Return view
+    return event;
+}
 
-        // Add model name and vector to cache. The vector is initialized
-        // to -1, which signals that no cache values exist
-        m_irf_names.push_back(name);
-        m_irf_values.push_back(std::vector<double>(size(), -1.0));
 
-        // Set index
-        index = m_irf_names.size()-1;
+/***********************************************************************//**
+ * @brief Get cache IRF value
+ *
+ * @param[in] name Model name.
+ * @param[in] index Event index [0,...,size()-1].
+ * @return IRF value (-1 if no cache value found).
+ ***************************************************************************/
+double GCTAEventList::irf_cache(const std::string& name, const int& index) const
+{
+    // Initialise IRF value to invalid value
+    double irf = -1.0;
 
-    } // endif: model cache did not yet exist
+    // Get cache handle. Continue only if handle is valid
+    int handle = m_irf_cache.index(name);
+    if (handle != -1) {
+        irf = irf_cache(handle, index);
+    }
 
-    // Return index
-    return index;
+    // Return IRF value
+    return irf;
 }
 
 
 /***********************************************************************//**
- * @brief Determines the cache index for a given model name
+ * @brief Set cache IRF value
  *
  * @param[in] name Model name.
- * @return Cache index (-1 if model has not been found).
+ * @param[in] index Event index [0,...,size()-1].
+ * @param[in] irf IRF value.
  ***************************************************************************/
-int GCTAEventList::irf_cache_index(const std::string& name) const
+void GCTAEventList::irf_cache(const std::string& name, const int& index,
+                              const double& irf) const
 {
-    // Initialise index
-    int index = -1;
+    // Set cache value
+    irf_cache(irf_cache_handle(name), index, irf);
 
-    // Continue only if there are models in cache
-    if (!m_irf_names.empty()) {
+    // Return
+    return;
+}
 
-         // Search for model name
-         for (int i = 0; i < m_irf_names.size(); ++i) {
-             if (m_irf_names[i] == name) {
-                 index = i;
-                 break;
-             }
-         }
 
-    } // endif: there were models in cache
+/***********************************************************************//**
+ * @brief Return IRF cache handle for a given model
+ *
+ * @param[in] name Model name.
+ * @param[in] signature Model and response signature (default: "").
+ * @return Cache handle.
+ *
+ * Returns the handle of the IRF cache slot of a model. If no slot exists
+ * for the model, a slot is created. If the slot was filled for a different
+ * signature, its values are dropped (see GCTAIrfCache::handle()). If the
+ * number of events in the list has changed since the cache was set up, all
+ * cache values are dropped.
+ *
+ * The method may be called concurrently by several threads, as the cache
+ * set up is serialised. Slots should however be created or reset before
+ * other threads access the values of the cache.
+ ***************************************************************************/
+int GCTAEventList::irf_cache_handle(const std::string& name,
+                                    const std::string& signature) const
+{
+    // Initialise handle
+    int handle = -1;
+
+    // Get handle, and make sure that the cache covers all events
+    #pragma omp critical(GCTAEventList_irf_cache_handle)
+    {
+        if (m_irf_cache.nevents() != size()) {
+            m_irf_cache.nevents(size());
+            irf_cache_unbind();
+        }
+        handle = m_irf_cache.handle(name, signature);
+    }
 
-    // Return index
-    return index;
+    // Return handle
+    return handle;
 }
 
 
 /***********************************************************************//**
- * @brief Get cache IRF value
+ * @brief Bind IRF cache slot to a model
  *
  * @param[in] name Model name.
- * @param[in] index Event index [0,...,size()-1].
- * @return IRF value (-1 if no cache value found).
+ * @param[in] signature Model and response signature.
+ * @param[in] model Spatial model.
+ * @return Cache handle.
+ *
+ * Creates or resets the IRF cache slot of a model (see irf_cache_handle())
+ * and records the handle of the slot together with the version numbers of
+ * the spatial model parameters. The handle is then returned by
+ * irf_cache_bound() as long as the model parameters are not modified.
+ *
+ * The method modifies the IRF cache, hence it should be called before the
+ * IRF is evaluated concurrently for different events.
  ***************************************************************************/
-double GCTAEventList::irf_cache(const std::string& name, const int& index) const
+int GCTAEventList::irf_cache_bind(const std::string&   name,
+                                  const std::string&   signature,
+                                  const GModelSpatial& model) const
 {
-    // Initialise IRF value to invalid value
-    double irf = -1.0;
+    // Get handle. All bound handles are dropped if the slots are removed
+    // because the number of events has changed
+    int handle = irf_cache_handle(name, signature);
+
+    // Record parameter versions
+    std::vector<unsigned long> versions(model.size());
+    for (int i = 0; i < model.size(); ++i) {
+        versions[i] = model[i].version();
+    }
 
-    // Get cache index. Continue only if index is valid
-    int icache = irf_cache_index(name);
-    if (icache != -1) {
-        irf = (m_irf_values[icache])[index];
+    // Bind handle
+    if (handle >= m_irf_versions.size()) {
+        m_irf_versions.resize(handle+1);
     }
+    m_irf_versions[handle] = versions;
+    m_irf_bound[name]      = handle;
 
+    // Return handle
+    return handle;
+}
+
+
+/***********************************************************************//**
+ * @brief Unbind all IRF cache slots
+ *
+ * Removes all bindings of IRF cache slots that were established using
+ * irf_cache_bind(). The cache values are kept.
+ ***************************************************************************/
+void GCTAEventList::irf_cache_unbind(void) const
+{
+    // Remove bindings
+    m_irf_bound.clear();
+    m_irf_versions.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return handle of bound IRF cache slot
+ *
+ * @param[in] name Model name.
+ * @param[in] model Spatial model.
+ * @return Cache handle (-1 if no slot is bound to the model).
+ *
+ * Returns the handle of the IRF cache slot that was bound to the model
+ * using irf_cache_bind(). If no slot was bound, if any spatial model
+ * parameter was modified since the binding, or if events were added to
+ * the list, -1 is returned and the IRF should be computed without cache.
+ *
+ * The method does not modify the event list, hence it may be called
+ * concurrently by several threads.
+ ***************************************************************************/
+int GCTAEventList::irf_cache_bound(const std::string&   name,
+                                   const GModelSpatial& model) const
+{
+    // Initialise handle
+    int handle = -1;
+
+    // Continue only if the cache covers all events
+    if (m_irf_cache.nevents() == size()) {
+
+        // Search bound handle
+        std::map<std::string,int>::const_iterator it = m_irf_bound.find(name);
+        if (it != m_irf_bound.end()) {
+
+            // Accept handle only if the parameters were not modified
+            const std::vector<unsigned long>& versions = m_irf_versions[it->second];
+            if (versions.size() == model.size()) {
+                handle = it->second;
+                for (int i = 0; i < model.size(); ++i) {
+                    if (model[i].version() != versions[i]) {
+                        handle = -1;
+                        break;
+                    }
+                }
+            }
+
+        } // endif: handle was bound
+
+    } // endif: cache covered all events
+
+    // Return handle
+    return handle;
+}
+
+
+/***********************************************************************//**
+ * @brief Get cache IRF value
+ *
+ * @param[in] handle Cache handle.
+ * @param[in] index Event index [0,...,size()-1].
+ * @return IRF value (-1 if no cache value found).
+ ***************************************************************************/
+double GCTAEventList::irf_cache(const int& handle, const int& index) const
+{
     // Return IRF value
-    return irf;
+    return (m_irf_cache.value(handle, index));
 }
 
 
 /***********************************************************************//**
  * @brief Set cache IRF value
  *
- * @param[in] name Model name.
+ * @param[in] handle Cache handle.
  * @param[in] index Event index [0,...,size()-1].
  * @param[in] irf IRF value.
  ***************************************************************************/
-void GCTAEventList::irf_cache(const std::string& name, const int& index,
+void GCTAEventList::irf_cache(const int& handle, const int& index,
                               const double& irf) const
 {
-    // Initialize cache index. Continue only if index is valid
-    int icache = irf_cache_init(name);
-    if (icache != -1) {
-        (m_irf_values[icache])[index] = irf;
+    // Set IRF value
+    m_irf_cache.value(handle, index, irf);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set IRF cache
+ *
+ * @param[in] cache IRF cache.
+ *
+ * @exception GException::invalid_argument
+ *            Number of events in cache differs from number of events in
+ *            list.
+ *
+ * Sets the IRF cache, for example from a cache that has been loaded from
+ * a FITS file.
+ ***************************************************************************/
+void GCTAEventList::irf_cache(const GCTAIrfCache& cache)
+{
+    // Throw an exception if the number of events differs
+    if (cache.nevents() != size()) {
+        std::string msg = "IRF cache for "+gammalib::str(cache.nevents())+
+                          " events does not match event list with "+
+                          gammalib::str(size())+" events.";
+        throw GException::invalid_argument(G_IRF_CACHE, msg);
     }
 
+    // Set cache
+    m_irf_cache = cache;
+    irf_cache_unbind();
+
     // Return
     return;
 }
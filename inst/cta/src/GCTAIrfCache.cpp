@@ -0,0 +1,750 @@
+/***************************************************************************
+ *              GCTAIrfCache.cpp - CTA event response cache class          *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTAIrfCache.cpp
+ * @brief CTA event response cache class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include "GCTAIrfCache.hpp"
+#include "GException.hpp"
+#include "GTools.hpp"
+#include "GFitsBinTable.hpp"
+#include "GFitsTableCol.hpp"
+#include "GFitsTableFloatCol.hpp"
+#include "GFitsTableDoubleCol.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+#define G_NEVENTS                             "GCTAIrfCache::nevents(int&)"
+#define G_NAME                                   "GCTAIrfCache::name(int&)"
+#define G_SIGNATURE                         "GCTAIrfCache::signature(int&)"
+#define G_VALUE_GET                       "GCTAIrfCache::value(int&, int&)"
+#define G_VALUE_SET              "GCTAIrfCache::value(int&, int&, double&)"
+#define G_NUMBER                               "GCTAIrfCache::number(int&)"
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+
+/*==========================================================================
+ =                                                                         =
+ =                        Constructors/destructors                         =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GCTAIrfCache::GCTAIrfCache(void)
+{
+    // Initialise class members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Event number constructor
+ *
+ * @param[in] nevents Number of events.
+ * @param[in] single Use single precision storage (default: false).
+ ***************************************************************************/
+GCTAIrfCache::GCTAIrfCache(const int& nevents, const bool& single)
+{
+    // Initialise class members
+    init_members();
+
+    // Set attributes
+    this->single(single);
+    this->nevents(nevents);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] cache Response cache.
+ ***************************************************************************/
+GCTAIrfCache::GCTAIrfCache(const GCTAIrfCache& cache)
+{
+    // Initialise class members
+    init_members();
+
+    // Copy members
+    copy_members(cache);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GCTAIrfCache::~GCTAIrfCache(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                               Operators                                 =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] cache Response cache.
+ * @return Response cache.
+ ***************************************************************************/
+GCTAIrfCache& GCTAIrfCache::operator=(const GCTAIrfCache& cache)
+{
+    // Execute only if object is not identical
+    if (this != &cache) {
+
+        // Free members
+        free_members();
+
+        // Initialise private members
+        init_members();
+
+        // Copy members
+        copy_members(cache);
+
+    } // endif: object was not identical
+
+    // Return this object
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear response cache
+ ***************************************************************************/
+void GCTAIrfCache::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise private members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone response cache
+ *
+ * @return Pointer to deep copy of response cache.
+ ***************************************************************************/
+GCTAIrfCache* GCTAIrfCache::clone(void) const
+{
+    return new GCTAIrfCache(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Set number of events
+ *
+ * @param[in] nevents Number of events.
+ *
+ * @exception GException::invalid_argument
+ *            Negative number of events specified.
+ *
+ * Sets the number of events in the cache. If the number of events differs
+ * from the actual number, all slots are removed from the cache.
+ ***************************************************************************/
+void GCTAIrfCache::nevents(const int& nevents)
+{
+    // Throw an exception if the number of events is negative
+    if (nevents < 0) {
+        throw GException::invalid_argument(G_NEVENTS,
+              "Number of events cannot be negative.");
+    }
+
+    // Continue only if the number of events changes
+    if (nevents != m_nevents) {
+
+        // Remove all slots
+        m_slots.clear();
+        m_names.clear();
+        m_signatures.clear();
+        m_values.clear();
+        m_fvalues.clear();
+
+        // Set number of events
+        m_nevents = nevents;
+
+    } // endif: number of events changed
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set storage precision
+ *
+ * @param[in] single Use single precision storage.
+ *
+ * Sets the storage precision of the cache. Values that already exist in the
+ * cache are converted into the new precision.
+ ***************************************************************************/
+void GCTAIrfCache::single(const bool& single)
+{
+    // Continue only if precision changes
+    if (single != m_single) {
+
+        // Convert double into single precision values
+        if (single) {
+            m_fvalues.assign(m_values.size(), std::vector<float>());
+            for (int i = 0; i < m_values.size(); ++i) {
+                m_fvalues[i].assign(m_values[i].begin(), m_values[i].end());
+            }
+            m_values.clear();
+        }
+
+        // ... otherwise convert single into double precision values
+        else {
+            m_values.assign(m_fvalues.size(), std::vector<double>());
+            for (int i = 0; i < m_fvalues.size(); ++i) {
+                m_values[i].assign(m_fvalues[i].begin(), m_fvalues[i].end());
+            }
+            m_fvalues.clear();
+        }
+
+        // Set precision
+        m_single = single;
+
+    } // endif: precision changed
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return slot handle for source
+ *
+ * @param[in] name Source name.
+ * @param[in] signature Model and response signature (default: "").
+ * @return Slot handle.
+ *
+ * Returns the handle of the slot for the specified source. If no slot
+ * exists for the source, a new slot is created with all values set to -1.
+ * If the slot exists but has a different signature, all values of the
+ * slot are reset to -1 and the signature of the slot is replaced.
+ *
+ * Slot creation and reset are serialised, yet slots should not be created
+ * or reset while values of existing slots are accessed by other threads.
+ ***************************************************************************/
+int GCTAIrfCache::handle(const std::string& name, const std::string& signature)
+{
+    // Initialise handle
+    int handle = -1;
+
+    // Search slot, and create slot if it does not yet exist
+    #pragma omp critical(GCTAIrfCache_slots)
+    {
+        std::map<std::string,int>::const_iterator slot = m_slots.find(name);
+        if (slot != m_slots.end()) {
+            handle = slot->second;
+            if (m_signatures[handle] != signature) {
+                if (m_single) {
+                    m_fvalues[handle].assign(m_nevents, -1.0);
+                }
+                else {
+                    m_values[handle].assign(m_nevents, -1.0);
+                }
+                m_signatures[handle] = signature;
+            }
+        }
+        else {
+            handle = m_names.size();
+            if (m_single) {
+                m_fvalues.push_back(std::vector<float>(m_nevents, -1.0));
+            }
+            else {
+                m_values.push_back(std::vector<double>(m_nevents, -1.0));
+            }
+            m_names.push_back(name);
+            m_signatures.push_back(signature);
+            m_slots[name] = handle;
+        }
+    }
+
+    // Return handle
+    return handle;
+}
+
+
+/***********************************************************************//**
+ * @brief Return slot handle for source without creating a slot
+ *
+ * @param[in] name Source name.
+ * @return Slot handle (-1 if no slot exists for the source).
+ ***************************************************************************/
+int GCTAIrfCache::index(const std::string& name) const
+{
+    // Initialise handle
+    int handle = -1;
+
+    // Search slot
+    #pragma omp critical(GCTAIrfCache_slots)
+    {
+        std::map<std::string,int>::const_iterator slot = m_slots.find(name);
+        if (slot != m_slots.end()) {
+            handle = slot->second;
+        }
+    }
+
+    // Return handle
+    return handle;
+}
+
+
+/***********************************************************************//**
+ * @brief Return source name of slot
+ *
+ * @param[in] handle Slot handle [0,...,size()-1].
+ * @return Source name.
+ *
+ * @exception GException::out_of_range
+ *            Slot handle is out of range.
+ ***************************************************************************/
+const std::string& GCTAIrfCache::name(const int& handle) const
+{
+    // Throw an exception if handle is out of range
+    if (handle < 0 || handle >= size()) {
+        throw GException::out_of_range(G_NAME, handle, 0, size()-1);
+    }
+
+    // Return name
+    return (m_names[handle]);
+}
+
+
+/***********************************************************************//**
+ * @brief Return signature of slot
+ *
+ * @param[in] handle Slot handle [0,...,size()-1].
+ * @return Model and response signature.
+ *
+ * @exception GException::out_of_range
+ *            Slot handle is out of range.
+ ***************************************************************************/
+const std::string& GCTAIrfCache::signature(const int& handle) const
+{
+    // Throw an exception if handle is out of range
+    if (handle < 0 || handle >= size()) {
+        throw GException::out_of_range(G_SIGNATURE, handle, 0, size()-1);
+    }
+
+    // Return signature
+    return (m_signatures[handle]);
+}
+
+
+/***********************************************************************//**
+ * @brief Return cached response value
+ *
+ * @param[in] handle Slot handle [0,...,size()-1].
+ * @param[in] index Event index [0,...,nevents()-1].
+ * @return Response value (-1 if no value has been cached).
+ *
+ * @exception GException::out_of_range
+ *            Slot handle or event index is out of range.
+ ***************************************************************************/
+double GCTAIrfCache::value(const int& handle, const int& index) const
+{
+    // Optionally check handle and index
+    #if defined(G_RANGE_CHECK)
+    if (handle < 0 || handle >= size()) {
+        throw GException::out_of_range(G_VALUE_GET, handle, 0, size()-1);
+    }
+    if (index < 0 || index >= m_nevents) {
+        throw GException::out_of_range(G_VALUE_GET, index, 0, m_nevents-1);
+    }
+    #endif
+
+    // Return value
+    return (m_single ? double(m_fvalues[handle][index])
+                     : m_values[handle][index]);
+}
+
+
+/***********************************************************************//**
+ * @brief Set cached response value
+ *
+ * @param[in] handle Slot handle [0,...,size()-1].
+ * @param[in] index Event index [0,...,nevents()-1].
+ * @param[in] value Response value.
+ *
+ * @exception GException::out_of_range
+ *            Slot handle or event index is out of range.
+ ***************************************************************************/
+void GCTAIrfCache::value(const int& handle, const int& index,
+                         const double& value)
+{
+    // Optionally check handle and index
+    #if defined(G_RANGE_CHECK)
+    if (handle < 0 || handle >= size()) {
+        throw GException::out_of_range(G_VALUE_SET, handle, 0, size()-1);
+    }
+    if (index < 0 || index >= m_nevents) {
+        throw GException::out_of_range(G_VALUE_SET, index, 0, m_nevents-1);
+    }
+    #endif
+
+    // Set value
+    if (m_single) {
+        m_fvalues[handle][index] = float(value);
+    }
+    else {
+        m_values[handle][index] = value;
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return number of cached values in slot
+ *
+ * @param[in] handle Slot handle [0,...,size()-1].
+ * @return Number of cached values.
+ *
+ * @exception GException::out_of_range
+ *            Slot handle is out of range.
+ ***************************************************************************/
+int GCTAIrfCache::number(const int& handle) const
+{
+    // Throw an exception if handle is out of range
+    if (handle < 0 || handle >= size()) {
+        throw GException::out_of_range(G_NUMBER, handle, 0, size()-1);
+    }
+
+    // Count values
+    int number = 0;
+    for (int i = 0; i < m_nevents; ++i) {
+        if (value(handle, i) >= 0.0) {
+            number++;
+        }
+    }
+
+    // Return number
+    return number;
+}
+
+
+/***********************************************************************//**
+ * @brief Load response cache from FITS file
+ *
+ * @param[in] filename FITS filename.
+ *
+ * Loads the response cache from the "IRFCACHE" extension of a FITS file.
+ ***************************************************************************/
+void GCTAIrfCache::load(const std::string& filename)
+{
+    // Open FITS file
+    GFits file(filename);
+
+    // Read response cache
+    read(file);
+
+    // Close FITS file
+    file.close();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Save response cache into FITS file
+ *
+ * @param[in] filename FITS filename.
+ * @param[in] clobber Overwrite existing FITS file (default=false).
+ ***************************************************************************/
+void GCTAIrfCache::save(const std::string& filename, bool clobber) const
+{
+    // Create empty FITS file
+    GFits fits;
+
+    // Write response cache
+    write(fits);
+
+    // Save FITS file
+    fits.saveto(filename, clobber);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Read response cache from FITS file
+ *
+ * @param[in] file FITS file.
+ *
+ * Reads the response cache from the "IRFCACHE" extension of a FITS file.
+ ***************************************************************************/
+void GCTAIrfCache::read(const GFits& file)
+{
+    // Read response cache from table
+    read(file.table("IRFCACHE"));
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Read response cache from FITS table
+ *
+ * @param[in] table FITS table pointer.
+ *
+ * Reads the response cache from a FITS table. Each column of the table
+ * that has a signature keyword is read into one slot, and the number of
+ * events is set to the number of table rows. Columns without a signature
+ * are dropped as it is not known for which model and response they were
+ * computed. Any slots residing in the cache prior to reading are lost.
+ * The storage precision of the cache is kept.
+ ***************************************************************************/
+void GCTAIrfCache::read(const GFitsTable* table)
+{
+    // Remove all slots
+    m_slots.clear();
+    m_names.clear();
+    m_signatures.clear();
+    m_values.clear();
+    m_fvalues.clear();
+    m_nevents = 0;
+
+    // Continue only if table is valid
+    if (table != NULL) {
+
+        // Set number of events
+        m_nevents = table->nrows();
+
+        // Read one slot per column
+        for (int icol = 0; icol < table->ncols(); ++icol) {
+
+            // Skip column if it has no signature
+            std::string keyname = "CSIG"+gammalib::str(icol+1);
+            if (!table->hascard(keyname)) {
+                continue;
+            }
+
+            // Get column
+            const GFitsTableCol& column = (*table)[icol];
+
+            // Create slot
+            int slot = handle(column.name(), table->string(keyname));
+
+            // Read values
+            for (int i = 0; i < m_nevents; ++i) {
+                value(slot, i, column.real(i));
+            }
+
+        } // endfor: looped over columns
+
+    } // endif: table was valid
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Write response cache into FITS file
+ *
+ * @param[in] file FITS file.
+ *
+ * Appends the response cache as binary table with extension name
+ * "IRFCACHE" to a FITS file. Nothing is written if the cache is empty.
+ ***************************************************************************/
+void GCTAIrfCache::write(GFits& file) const
+{
+    // Continue only if there are slots and events
+    if (size() > 0 && m_nevents > 0) {
+
+        // Allocate binary table
+        GFitsBinTable table(m_nevents);
+        table.extname("IRFCACHE");
+
+        // Append one column per slot
+        for (int slot = 0; slot < size(); ++slot) {
+            if (m_single) {
+                GFitsTableFloatCol column(m_names[slot], m_nevents);
+                for (int i = 0; i < m_nevents; ++i) {
+                    column(i) = m_fvalues[slot][i];
+                }
+                table.append_column(column);
+            }
+            else {
+                GFitsTableDoubleCol column(m_names[slot], m_nevents);
+                for (int i = 0; i < m_nevents; ++i) {
+                    column(i) = m_values[slot][i];
+                }
+                table.append_column(column);
+            }
+        } // endfor: looped over slots
+
+        // Write column signatures
+        for (int slot = 0; slot < size(); ++slot) {
+            table.card("CSIG"+gammalib::str(slot+1), m_signatures[slot],
+                       "Signature of column "+gammalib::str(slot+1));
+        }
+
+        // Append table to FITS file
+        file.append(table);
+
+    } // endif: cache was not empty
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Print response cache information
+ *
+ * @param[in] chatter Chattiness (defaults to NORMAL).
+ * @return String containing response cache information.
+ ***************************************************************************/
+std::string GCTAIrfCache::print(const GChatter& chatter) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Continue only if chatter is not silent
+    if (chatter != SILENT) {
+
+        // Append header
+        result.append("=== GCTAIrfCache ===");
+
+        // Append information
+        result.append("\n"+gammalib::parformat("Number of events"));
+        result.append(gammalib::str(m_nevents));
+        result.append("\n"+gammalib::parformat("Number of slots"));
+        result.append(gammalib::str(size()));
+        result.append("\n"+gammalib::parformat("Storage precision"));
+        result.append(m_single ? "single" : "double");
+
+        // EXPLICIT: Append slots
+        if (chatter >= EXPLICIT) {
+            for (int slot = 0; slot < size(); ++slot) {
+                result.append("\n"+gammalib::parformat("Slot " +
+                              gammalib::str(slot)));
+                result.append(m_names[slot]+" = ");
+                result.append(gammalib::str(number(slot))+" values");
+            }
+        }
+
+    } // endif: chatter was not silent
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Private methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GCTAIrfCache::init_members(void)
+{
+    // Initialise members
+    m_nevents = 0;
+    m_single  = false;
+    m_slots.clear();
+    m_names.clear();
+    m_signatures.clear();
+    m_values.clear();
+    m_fvalues.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] cache Response cache.
+ ***************************************************************************/
+void GCTAIrfCache::copy_members(const GCTAIrfCache& cache)
+{
+    // Copy members
+    m_nevents    = cache.m_nevents;
+    m_single     = cache.m_single;
+    m_slots      = cache.m_slots;
+    m_names      = cache.m_names;
+    m_signatures = cache.m_signatures;
+    m_values     = cache.m_values;
+    m_fvalues    = cache.m_fvalues;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GCTAIrfCache::free_members(void)
+{
+    // Return
+    return;
+}
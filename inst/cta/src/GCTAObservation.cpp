@@ -28,11 +28,17 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "GObservationRegistry.hpp"
 #include "GException.hpp"
 #include "GFits.hpp"
 #include "GTools.hpp"
 #include "GIntegral.hpp"
+#include "GModels.hpp"
+#include "GModelSky.hpp"
+#include "GSource.hpp"
 #include "GCTAException.hpp"
 #include "GCTAObservation.hpp"
 #include "GCTAEventList.hpp"
@@ -59,6 +65,7 @@ const GObservationRegistry g_obs_veritas_registry(&g_obs_veritas_seed);
 #define G_WRITE                        "GCTAObservation::write(GXmlElement&)"
 #define G_READ_DS_EBOUNDS       "GCTAObservation::read_ds_ebounds(GFitsHDU*)"
 #define G_READ_DS_ROI               "GCTAObservation::read_ds_roi(GFitsHDU*)"
+#define G_SRCMAPS                      "GCTAObservation::srcmaps(GModels&)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -290,6 +297,61 @@ GCTAPointing* GCTAObservation::pointing(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Signal if model evaluation is thread safe
+ *
+ * @return True if the observation holds a CTA event list.
+ *
+ * The model evaluation of unbinned observations is thread safe, hence the
+ * likelihood optimizer may distribute the events of an unbinned observation
+ * over several threads. The response keeps its PSF parameter caches and
+ * tabulated radial source IRFs per thread, serialises the computation of
+ * tabulated diffuse source IRFs, and writes IRF cache values only for the
+ * event that a thread is processing. The shared IRF cache slots and the
+ * coordinate caches of the pointing are set up before the parallel
+ * evaluation by thread_setup().
+ *
+ * Event cubes hold a single event bin that is updated when a bin is
+ * accessed, hence the model evaluation of binned observations is not
+ * thread safe.
+ ***************************************************************************/
+bool GCTAObservation::threadsafe(void) const
+{
+    // Return
+    return (dynamic_cast<const GCTAEventList*>(events()) != NULL);
+}
+
+
+/***********************************************************************//**
+ * @brief Prepare observation for concurrent model evaluation
+ *
+ * @param[in] models Models.
+ *
+ * Fills the rotation matrix and the trigonometric caches of the pointing
+ * direction, which are otherwise computed on first use, and creates or
+ * resets the IRF cache slots of the event list for the @p models (see
+ * GCTAResponse::irf_cache_init()). After this call, the model evaluation
+ * does not modify any state that is shared between events.
+ ***************************************************************************/
+void GCTAObservation::thread_setup(const GModels& models) const
+{
+    // Fill coordinate caches of pointing direction
+    if (m_pointing != NULL) {
+        m_pointing->rot();
+        m_pointing->dir().celvector();
+        m_pointing->dir().dist(m_pointing->dir());
+    }
+
+    // Set up IRF cache slots
+    if (m_response != NULL) {
+        m_response->irf_cache_init(*this, models);
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Set CTA pointing direction
  *
@@ -871,6 +933,100 @@ void GCTAObservation::save(const std::string& filename, bool clobber) const
 }
 
 
+/***********************************************************************//**
+ * @brief Compute source maps for binned observation
+ *
+ * @param[in] models Models.
+ *
+ * @exception GCTAException::bad_event_type
+ *            Observation does not contain an event cube.
+ * @exception GCTAException::no_response
+ *            Observation has no response.
+ *
+ * Computes the source maps of all sky models that apply to the observation
+ * and that have no free spatial parameters, and stores them in the event
+ * cube (see GCTAEventCube). Each source map holds the instrument response
+ * to the source for all bins of the event cube, including the deadtime
+ * correction. As long as the spatial parameters of a source stay fixed,
+ * the model evaluation for a bin is then reduced to a spectral and temporal
+ * weighting of the source map value. Source maps are ignored once the
+ * spatial parameter values differ from those for which they were computed,
+ * and need to be recomputed if the response or the deadtime correction
+ * change.
+ *
+ * Source maps are saved together with the event cube by save(), and are
+ * read back by load_binned().
+ ***************************************************************************/
+void GCTAObservation::srcmaps(const GModels& models)
+{
+    // Get pointer on event cube
+    GCTAEventCube* cube = dynamic_cast<GCTAEventCube*>(m_events);
+    if (cube == NULL) {
+        throw GCTAException::bad_event_type(G_SRCMAPS,
+              "Source maps require a binned observation.");
+    }
+
+    // Make sure that we have a response
+    if (m_response == NULL) {
+        throw GCTAException::no_response(G_SRCMAPS);
+    }
+
+    // Loop over models
+    for (int i = 0; i < models.size(); ++i) {
+
+        // Continue only if model is a sky model that applies to the
+        // observation
+        const GModelSky* sky = dynamic_cast<const GModelSky*>(models[i]);
+        if (sky == NULL || sky->spatial() == NULL ||
+            !sky->isvalid(instrument(), id())) {
+            continue;
+        }
+
+        // Continue only if spatial model has no free parameters
+        bool fixed = true;
+        for (int k = 0; k < sky->spatial()->size(); ++k) {
+            if ((*(sky->spatial()))[k].isfree()) {
+                fixed = false;
+                break;
+            }
+        }
+        if (!fixed) {
+            continue;
+        }
+
+        // Initialise source map
+        GSkymap map    = cube->map();
+        double* pixels = map.pixels();
+        int     nbins  = cube->size();
+
+        // Compute source map. Each thread works on its own event bin and
+        // spatial model copy. The base class method is called to bypass any
+        // existing source map of the model.
+        #pragma omp parallel
+        {
+            GCTAEventBin   bin;
+            GModelSpatial* spatial = sky->spatial()->clone();
+
+            #pragma omp for schedule(dynamic)
+            for (int k = 0; k < nbins; ++k) {
+                cube->set_bin(k, bin);
+                GSource source(sky->name(), spatial, bin.energy(), bin.time());
+                pixels[k] = m_response->GResponse::irf(bin, source, *this);
+            }
+
+            delete spatial;
+        }
+
+        // Store source map
+        cube->srcmap(sky->name(), map, *(sky->spatial()));
+
+    } // endfor: looped over models
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                            Private methods                              =
@@ -40,6 +40,9 @@
 
 /* __ Constants __________________________________________________________ */
 
+/* __ Static members _____________________________________________________ */
+static unsigned long g_id = 0;
+
 
 /*==========================================================================
  =                                                                         =
@@ -141,6 +144,9 @@ GCTAPsf& GCTAPsf::operator= (const GCTAPsf& psf)
  ***************************************************************************/
 void GCTAPsf::init_members(void)
 {
+    // Initialise members
+    touch();
+
     // Return
     return;
 }
@@ -153,6 +159,9 @@ void GCTAPsf::init_members(void)
  ***************************************************************************/
 void GCTAPsf::copy_members(const GCTAPsf& psf)
 {
+    // Copy members
+    m_id = psf.m_id;
+
     // Return
     return;
 }
@@ -166,3 +175,31 @@ void GCTAPsf::free_members(void)
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Assign new identifier to point spread function
+ *
+ * Assigns an identifier that has never been used before by any point
+ * spread function. The method is called whenever the response parameters
+ * are set, hence two point spread functions with the same identifier have
+ * the same response parameters.
+ ***************************************************************************/
+void GCTAPsf::touch(void)
+{
+    // Draw new identifier
+    unsigned long id;
+    #if defined(_OPENMP) && _OPENMP >= 201107
+    #pragma omp atomic capture
+    id = ++g_id;
+    #else
+    #pragma omp critical(GCTAPsf_touch)
+    id = ++g_id;
+    #endif
+
+    // Set identifier
+    m_id = id;
+
+    // Return
+    return;
+}
@@ -43,6 +43,9 @@
 
 /* __ Debug definitions __________________________________________________ */
 
+/* __ Static members _____________________________________________________ */
+GCTAPsf2D::parcache GCTAPsf2D::m_cache;
+
 /* __ Constants __________________________________________________________ */
 
 
@@ -180,23 +183,23 @@ double GCTAPsf2D::operator()(const double& delta,
     double psf = 0.0;
 
     // Update the parameter cache
-    update(logE, theta);
+    const parcache& par = update(logE, theta);
 
     // Continue only if normalization is positive
-    if (m_norm > 0.0) {
+    if (par.norm > 0.0) {
 
         // Compute distance squared
         double delta2 = delta * delta;
 
         // Compute Psf value
-        psf = std::exp(m_width1 * delta2);
-        if (m_norm2 > 0.0) {
-            psf += std::exp(m_width2 * delta2) * m_norm2;
+        psf = std::exp(par.width1 * delta2);
+        if (par.norm2 > 0.0) {
+            psf += std::exp(par.width2 * delta2) * par.norm2;
         }
-        if (m_norm3 > 0.0) {
-            psf += std::exp(m_width3 * delta2) * m_norm3;
+        if (par.norm3 > 0.0) {
+            psf += std::exp(par.width3 * delta2) * par.norm3;
         }
-        psf *= m_norm;
+        psf *= par.norm;
 
     } // endif: normalization was positive
     
@@ -281,6 +284,9 @@ void GCTAPsf2D::load(const std::string& filename)
     // Store filename
     m_filename = filename;
 
+    // Signal that the response parameters have changed
+    touch();
+
     // Return
     return;
 }
@@ -320,20 +326,20 @@ double GCTAPsf2D::mc(GRan&         ran,
                      const bool&   etrue) const
 {
     // Update the parameter cache
-    update(logE, theta);
+    const parcache& par = update(logE, theta);
 
     // Select in which Gaussian we are
-    double sigma = m_sigma1;
-    double sum1  = m_sigma1;
-    double sum2  = m_sigma2 * m_norm2;
-    double sum3  = m_sigma3 * m_norm3;
+    double sigma = par.sigma1;
+    double sum1  = par.sigma1;
+    double sum2  = par.sigma2 * par.norm2;
+    double sum3  = par.sigma3 * par.norm3;
     double sum   = sum1 + sum2 + sum3;
     double u     = ran.uniform() * sum;
     if (u >= sum2) {
-        sigma = m_sigma3;
+        sigma = par.sigma3;
     }
     else if (u >= sum1) {
-        sigma = m_sigma2;
+        sigma = par.sigma2;
     }
 
     // Now draw from the selected Gaussian
@@ -366,12 +372,12 @@ double GCTAPsf2D::delta_max(const double& logE,
                             const bool&   etrue) const
 {
     // Update the parameter cache
-    update(logE, theta);
+    const parcache& par = update(logE, theta);
 
     // Compute maximum sigma
-    double sigma = m_sigma1;
-    if (m_sigma2 > sigma) sigma = m_sigma2;
-    if (m_sigma3 > sigma) sigma = m_sigma3;
+    double sigma = par.sigma1;
+    if (par.sigma2 > sigma) sigma = par.sigma2;
+    if (par.sigma3 > sigma) sigma = par.sigma3;
 
     // Compute maximum PSF radius
     double radius = 5.0 * sigma;
@@ -423,17 +429,6 @@ void GCTAPsf2D::init_members(void)
     // Initialise members
     m_filename.clear();
     m_psf.clear();
-    m_par_logE  = -1.0e30;
-    m_par_theta = -1.0;
-    m_norm      = 1.0;
-    m_norm2     = 0.0;
-    m_norm3     = 0.0;
-    m_sigma1    = 0.0;
-    m_sigma2    = 0.0;
-    m_sigma3    = 0.0;
-    m_width1    = 0.0;
-    m_width2    = 0.0;
-    m_width3    = 0.0;
 
     // Return
     return;
@@ -450,17 +445,6 @@ void GCTAPsf2D::copy_members(const GCTAPsf2D& psf)
     // Copy members
     m_filename  = psf.m_filename;
     m_psf       = psf.m_psf;
-    m_par_logE  = psf.m_par_logE;
-    m_par_theta = psf.m_par_theta;
-    m_norm      = psf.m_norm;
-    m_norm2     = psf.m_norm2;
-    m_norm3     = psf.m_norm3;
-    m_sigma1    = psf.m_sigma1;
-    m_sigma2    = psf.m_sigma2;
-    m_sigma3    = psf.m_sigma3;
-    m_width1    = psf.m_width1;
-    m_width2    = psf.m_width2;
-    m_width3    = psf.m_width3;
 
     // Return
     return;
@@ -482,65 +466,75 @@ void GCTAPsf2D::free_members(void)
  *
  * @param[in] logE Log10 of the true photon energy (TeV).
  * @param[in] theta Offset angle in camera system (rad).
+ * @return Reference to the updated parameter cache.
  *
- * This method updates the PSF parameter cache.
+ * This method updates the PSF parameter cache of the calling thread. The
+ * cache is thread private storage that is shared by all instances, hence
+ * any number of threads, including threads of nested parallel regions,
+ * may evaluate the PSF concurrently without locking. The cache keeps the
+ * identifier of the PSF for which it was computed (see GCTAPsf::touch()).
  ***************************************************************************/
-void GCTAPsf2D::update(const double& logE, const double& theta) const
+const GCTAPsf2D::parcache& GCTAPsf2D::update(const double& logE,
+                                             const double& theta) const
 {
-    // Only compute PSF parameters if arguments have changed
-    if (logE != m_par_logE || theta != m_par_theta) {
+    // Get parameter cache of the thread
+    parcache& cache = m_cache;
+
+    // Only compute PSF parameters if the PSF or the arguments have changed
+    if (m_id != cache.id || logE != cache.logE || theta != cache.theta) {
 
         // Save parameters
-        m_par_logE  = logE;
-        m_par_theta = theta;
+        cache.id    = m_id;
+        cache.logE  = logE;
+        cache.theta = theta;
 
         // Interpolate response parameters
         std::vector<double> pars = m_psf(logE, theta);
 
         // Set Gaussian sigmas
-        m_sigma1 = pars[1];
-        m_sigma2 = pars[3];
-        m_sigma3 = pars[5];
+        cache.sigma1 = pars[1];
+        cache.sigma2 = pars[3];
+        cache.sigma3 = pars[5];
 
         // Set width parameters
-        double sigma1 = m_sigma1 * m_sigma1;
-        double sigma2 = m_sigma2 * m_sigma2;
-        double sigma3 = m_sigma3 * m_sigma3;
+        double sigma1 = cache.sigma1 * cache.sigma1;
+        double sigma2 = cache.sigma2 * cache.sigma2;
+        double sigma3 = cache.sigma3 * cache.sigma3;
 
         // Compute Gaussian 1
         if (sigma1 > 0.0) {
-            m_width1 = -0.5 / sigma1;
+            cache.width1 = -0.5 / sigma1;
         }
         else {
-            m_width1 = 0.0;
+            cache.width1 = 0.0;
         }
 
         // Compute Gaussian 2
         if (sigma2 > 0.0) {
-            m_width2 = -0.5 / sigma2;
-            m_norm2  = pars[2];
+            cache.width2 = -0.5 / sigma2;
+            cache.norm2  = pars[2];
         }
         else {
-            m_width2 = 0.0;
-            m_norm2  = 0.0;
+            cache.width2 = 0.0;
+            cache.norm2  = 0.0;
         }
 
         // Compute Gaussian 3
         if (sigma3 > 0.0) {
-            m_width3 = -0.5 / sigma3;
-            m_norm3  = pars[4];
+            cache.width3 = -0.5 / sigma3;
+            cache.norm3  = pars[4];
         }
         else {
-            m_width3 = 0.0;
-            m_norm3  = 0.0;
+            cache.width3 = 0.0;
+            cache.norm3  = 0.0;
         }
 
         // Compute global normalization parameter
-        double integral = gammalib::twopi * (sigma1 + sigma2*m_norm2 + sigma3*m_norm3);
-        m_norm = (integral > 0.0) ? 1.0 / integral : 0.0;
+        double integral = gammalib::twopi * (sigma1 + sigma2*cache.norm2 + sigma3*cache.norm3);
+        cache.norm = (integral > 0.0) ? 1.0 / integral : 0.0;
 
     }
 
-    // Return
-    return;
+    // Return parameter cache
+    return cache;
 }
@@ -44,6 +44,9 @@
 
 /* __ Debug definitions __________________________________________________ */
 
+/* __ Static members _____________________________________________________ */
+GCTAPsfPerfTable::parcache GCTAPsfPerfTable::m_cache;
+
 /* __ Constants __________________________________________________________ */
 
 
@@ -178,10 +181,10 @@ double GCTAPsfPerfTable::operator()(const double& delta,
                                     const bool&   etrue) const
 {
     // Update the parameter cache
-    update(logE);
+    const parcache& par = update(logE);
 
     // Compute PSF value
-    double psf = m_par_scale * std::exp(m_par_width * delta * delta);
+    double psf = par.scale * std::exp(par.width * delta * delta);
     
     // Return PSF
     return psf;
@@ -295,6 +298,9 @@ void GCTAPsfPerfTable::load(const std::string& filename)
     // Store filename
     m_filename = filename;
 
+    // Signal that the response parameters have changed
+    touch();
+
     // Return
     return;
 }
@@ -332,10 +338,10 @@ double GCTAPsfPerfTable::mc(GRan&         ran,
                             const bool&   etrue) const
 {
     // Update the parameter cache
-    update(logE);
+    const parcache& par = update(logE);
 
     // Draw offset
-    double delta = m_par_sigma * ran.chisq2();
+    double delta = par.sigma * ran.chisq2();
     
     // Return PSF offset
     return delta;
@@ -364,10 +370,10 @@ double GCTAPsfPerfTable::delta_max(const double& logE,
                                    const bool&   etrue) const
 {
     // Update the parameter cache
-    update(logE);
+    const parcache& par = update(logE);
 
     // Compute maximum PSF radius
-    double radius = 5.0 * m_par_sigma;
+    double radius = 5.0 * par.sigma;
     
     // Return maximum PSF radius
     return radius;
@@ -427,10 +433,6 @@ void GCTAPsfPerfTable::init_members(void)
     m_r68.clear();
     m_r80.clear();
     m_sigma.clear();
-    m_par_logE  = -1.0e30;
-    m_par_scale = 1.0;
-    m_par_sigma = 0.0;
-    m_par_width = 0.0;
 
     // Return
     return;
@@ -450,10 +452,6 @@ void GCTAPsfPerfTable::copy_members(const GCTAPsfPerfTable& psf)
     m_r68       = psf.m_r68;
     m_r80       = psf.m_r80;
     m_sigma     = psf.m_sigma;
-    m_par_logE  = psf.m_par_logE;
-    m_par_scale = psf.m_par_scale;
-    m_par_sigma = psf.m_par_sigma;
-    m_par_width = psf.m_par_width;
 
     // Return
     return;
@@ -474,29 +472,40 @@ void GCTAPsfPerfTable::free_members(void)
  * @brief Update PSF parameter cache
  *
  * @param[in] logE Log10 of the true photon energy (TeV).
+ * @return Reference to the updated parameter cache.
+ *
+ * This method updates the PSF parameter cache of the calling thread. As
+ * the performance table PSF only depends on energy, the only parameter on
+ * which the cache values depend is the energy.
  *
- * This method updates the PSF parameter cache. As the performance table PSF
- * only depends on energy, the only parameter on which the cache values
- * depend is the energy.
+ * The cache is thread private storage that is shared by all instances,
+ * hence any number of threads, including threads of nested parallel
+ * regions, may evaluate the PSF concurrently without locking. The cache
+ * keeps the identifier of the PSF for which it was computed (see
+ * GCTAPsf::touch()).
  ***************************************************************************/
-void GCTAPsfPerfTable::update(const double& logE) const
+const GCTAPsfPerfTable::parcache& GCTAPsfPerfTable::update(const double& logE) const
 {
-    // Only compute PSF parameters if arguments have changed
-    if (logE != m_par_logE) {
+    // Get parameter cache of the thread
+    parcache& cache = m_cache;
 
-        // Save energy
-        m_par_logE = logE;
+    // Only compute PSF parameters if the PSF or the arguments have changed
+    if (m_id != cache.id || logE != cache.logE) {
+
+        // Save PSF and energy
+        cache.id   = m_id;
+        cache.logE = logE;
     
         // Determine Gaussian sigma in radians
-        m_par_sigma = m_logE.interpolate(logE, m_sigma);
+        cache.sigma = m_logE.interpolate(logE, m_sigma);
 
         // Derive width=-0.5/(sigma*sigma) and scale=1/(twopi*sigma*sigma)
-        double sigma2 = m_par_sigma * m_par_sigma;
-        m_par_scale   =  1.0 / (gammalib::twopi * sigma2);
-        m_par_width   = -0.5 / sigma2;
+        double sigma2 = cache.sigma * cache.sigma;
+        cache.scale   =  1.0 / (gammalib::twopi * sigma2);
+        cache.width   = -0.5 / sigma2;
 
     }
 
-    // Return
-    return;
+    // Return parameter cache
+    return cache;
 }
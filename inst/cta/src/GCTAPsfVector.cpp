@@ -45,6 +45,9 @@
 
 /* __ Debug definitions __________________________________________________ */
 
+/* __ Static members _____________________________________________________ */
+GCTAPsfVector::parcache GCTAPsfVector::m_cache;
+
 /* __ Constants __________________________________________________________ */
 
 
@@ -179,10 +182,10 @@ double GCTAPsfVector::operator()(const double& delta,
                                  const bool&   etrue) const
 {
     // Update the parameter cache
-    update(logE);
+    const parcache& par = update(logE);
 
     // Compute PSF value
-    double psf = m_par_scale * std::exp(m_par_width * delta * delta);
+    double psf = par.scale * std::exp(par.width * delta * delta);
     
     // Return PSF
     return psf;
@@ -344,6 +347,9 @@ void GCTAPsfVector::read(const GFitsTable* hdu)
         m_sigma.push_back(r68_value*conv);
 
     } // endfor: looped over nodes
+
+    // Signal that the response parameters have changed
+    touch();
     
     // Return
     return;
@@ -382,10 +388,10 @@ double GCTAPsfVector::mc(GRan&         ran,
                          const bool&   etrue) const
 {
     // Update the parameter cache
-    update(logE);
+    const parcache& par = update(logE);
 
     // Draw offset
-    double delta = m_par_sigma * ran.chisq2();
+    double delta = par.sigma * ran.chisq2();
     
     // Return PSF offset
     return delta;
@@ -414,10 +420,10 @@ double GCTAPsfVector::delta_max(const double& logE,
                                    const bool&   etrue) const
 {
     // Update the parameter cache
-    update(logE);
+    const parcache& par = update(logE);
 
     // Compute maximum PSF radius
-    double radius = 5.0 * m_par_sigma;
+    double radius = 5.0 * par.sigma;
     
     // Return maximum PSF radius
     return radius;
@@ -476,10 +482,6 @@ void GCTAPsfVector::init_members(void)
     m_logE.clear();
     m_r68.clear();
     m_sigma.clear();
-    m_par_logE  = -1.0e30;
-    m_par_scale = 1.0;
-    m_par_sigma = 0.0;
-    m_par_width = 0.0;
 
     // Return
     return;
@@ -498,10 +500,6 @@ void GCTAPsfVector::copy_members(const GCTAPsfVector& psf)
     m_logE      = psf.m_logE;
     m_r68       = psf.m_r68;
     m_sigma     = psf.m_sigma;
-    m_par_logE  = psf.m_par_logE;
-    m_par_scale = psf.m_par_scale;
-    m_par_sigma = psf.m_par_sigma;
-    m_par_width = psf.m_par_width;
 
     // Return
     return;
@@ -522,29 +520,40 @@ void GCTAPsfVector::free_members(void)
  * @brief Update PSF parameter cache
  *
  * @param[in] logE Log10 of the true photon energy (TeV).
+ * @return Reference to the updated parameter cache.
+ *
+ * This method updates the PSF parameter cache of the calling thread. As
+ * the performance table PSF only depends on energy, the only parameter on
+ * which the cache values depend is the energy.
  *
- * This method updates the PSF parameter cache. As the performance table PSF
- * only depends on energy, the only parameter on which the cache values
- * depend is the energy.
+ * The cache is thread private storage that is shared by all instances,
+ * hence any number of threads, including threads of nested parallel
+ * regions, may evaluate the PSF concurrently without locking. The cache
+ * keeps the identifier of the PSF for which it was computed (see
+ * GCTAPsf::touch()).
  ***************************************************************************/
-void GCTAPsfVector::update(const double& logE) const
+const GCTAPsfVector::parcache& GCTAPsfVector::update(const double& logE) const
 {
-    // Only compute PSF parameters if arguments have changed
-    if (logE != m_par_logE) {
+    // Get parameter cache of the thread
+    parcache& cache = m_cache;
 
-        // Save energy
-        m_par_logE = logE;
+    // Only compute PSF parameters if the PSF or the arguments have changed
+    if (m_id != cache.id || logE != cache.logE) {
+
+        // Save PSF and energy
+        cache.id   = m_id;
+        cache.logE = logE;
     
         // Determine Gaussian sigma in radians
-        m_par_sigma = m_logE.interpolate(logE, m_sigma);
+        cache.sigma = m_logE.interpolate(logE, m_sigma);
 
         // Derive width=-0.5/(sigma*sigma) and scale=1/(twopi*sigma*sigma)
-        double sigma2 = m_par_sigma * m_par_sigma;
-        m_par_scale   =  1.0 / (gammalib::twopi * sigma2);
-        m_par_width   = -0.5 / sigma2;
+        double sigma2 = cache.sigma * cache.sigma;
+        cache.scale   =  1.0 / (gammalib::twopi * sigma2);
+        cache.width   = -0.5 / sigma2;
 
     }
 
-    // Return
-    return;
+    // Return parameter cache
+    return cache;
 }
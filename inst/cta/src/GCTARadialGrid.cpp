@@ -0,0 +1,491 @@
+/***************************************************************************
+ *         GCTARadialGrid.cpp - Tabulated CTA radial source IRF class      *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTARadialGrid.cpp
+ * @brief Tabulated CTA radial source IRF class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <cmath>
+#include "GTools.hpp"
+#include "GMath.hpp"
+#include "GEnergy.hpp"
+#include "GCTARadialGrid.hpp"
+#include "GCTAResponse.hpp"
+#include "GCTAObservation.hpp"
+#include "GCTAPointing.hpp"
+#include "GCTAException.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+#define G_SET     "GCTARadialGrid::set(GCTAResponse&, GModelSpatialRadial&,"\
+                                               " GCTAObservation&, GTime&)"
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+#define G_DLOGE         0.1         //!< Energy node spacing (decades)
+#define G_NOMEGA         13         //!< Number of omega0 nodes
+#define G_ZETA_STEPS   20.0         //!< Zeta nodes per minimum PSF radius
+#define G_MAX_ZETA      400         //!< Maximum number of zeta nodes
+
+/* __ Debug definitions __________________________________________________ */
+
+
+/*==========================================================================
+ =                                                                         =
+ =                        Constructors/destructors                         =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GCTARadialGrid::GCTARadialGrid(void)
+{
+    // Initialise members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] grid Tabulated radial source IRF.
+ ***************************************************************************/
+GCTARadialGrid::GCTARadialGrid(const GCTARadialGrid& grid)
+{
+    // Initialise members
+    init_members();
+
+    // Copy members
+    copy_members(grid);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GCTARadialGrid::~GCTARadialGrid(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                               Operators                                 =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] grid Tabulated radial source IRF.
+ * @return Tabulated radial source IRF.
+ ***************************************************************************/
+GCTARadialGrid& GCTARadialGrid::operator=(const GCTARadialGrid& grid)
+{
+    // Execute only if object is not identical
+    if (this != &grid) {
+
+        // Free members
+        free_members();
+
+        // Initialise private members for clean destruction
+        init_members();
+
+        // Copy members
+        copy_members(grid);
+
+    } // endif: object was not identical
+
+    // Return this object
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear tabulated radial source IRF
+ ***************************************************************************/
+void GCTARadialGrid::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise private members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone tabulated radial source IRF
+ *
+ * @return Pointer to deep copy of tabulated radial source IRF.
+ ***************************************************************************/
+GCTARadialGrid* GCTARadialGrid::clone(void) const
+{
+    return new GCTARadialGrid(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Check if tabulated IRF applies to a radial model
+ *
+ * @param[in] model Radial model.
+ * @return True if the grid has been computed for the parameter values of
+ *         the model.
+ ***************************************************************************/
+bool GCTARadialGrid::isvalid(const GModelSpatialRadial& model) const
+{
+    // Initialise flag
+    bool valid = (!m_values.empty() && m_pars.size() == model.size());
+
+    // Compare parameter values
+    for (int i = 0; valid && i < m_pars.size(); ++i) {
+        if (model[i].value() != m_pars[i]) {
+            valid = false;
+        }
+    }
+
+    // Return flag
+    return valid;
+}
+
+
+/***********************************************************************//**
+ * @brief Compute tabulated radial source IRF
+ *
+ * @param[in] rsp CTA response.
+ * @param[in] model Radial model.
+ * @param[in] obs CTA observation.
+ * @param[in] srcTime True photon arrival time used for model evaluation.
+ *
+ * @exception GCTAException::no_pointing
+ *            No valid CTA pointing found.
+ *
+ * Computes the IRF nodes for the radial model. The energy nodes are spaced
+ * by 0.1 decades and cover the energy range of the events of the
+ * observation. The zeta nodes range from zero to the maximum model radius
+ * plus the maximum PSF radius, with a spacing of 1/20 of the minimum PSF
+ * radius (at most 400 nodes). The IRF vanishes beyond the zeta range. The
+ * omega0 nodes cover [0,pi] with 13 nodes. If the observation has no events
+ * or no energy range the grid is left empty.
+ ***************************************************************************/
+void GCTARadialGrid::set(const GCTAResponse&    rsp,
+                         GModelSpatialRadial&   model,
+                         const GCTAObservation& obs,
+                         const GTime&           srcTime)
+{
+    // Clear grid
+    clear();
+
+    // Get pointing
+    const GCTAPointing *pnt = obs.pointing();
+    if (pnt == NULL) {
+        throw GCTAException::no_pointing(G_SET);
+    }
+
+    // Continue only if an energy range exists
+    if (obs.events() != NULL && obs.events()->ebounds().size() > 0) {
+
+        // Store model parameter values
+        for (int i = 0; i < model.size(); ++i) {
+            m_pars.push_back(model[i].value());
+        }
+
+        // Set number of components
+        m_ncomp = 3 + model.size() - 2;
+
+        // Get pointing zenith angle, azimuth and distance to model centre
+        double zenith     = pnt->zenith();
+        double azimuth    = pnt->azimuth();
+        double lambda     = model.dir().dist(pnt->dir());
+        double cos_lambda = std::cos(lambda);
+        double sin_lambda = std::sin(lambda);
+
+        // Set energy nodes
+        double logE_min = obs.events()->emin().log10TeV();
+        double logE_max = obs.events()->emax().log10TeV();
+        int    nlogE    = int((logE_max - logE_min) / G_DLOGE + 0.5) + 1;
+        if (nlogE < 2) {
+            nlogE = 2;
+        }
+        for (int i = 0; i < nlogE; ++i) {
+            m_logE.append(logE_min + (logE_max - logE_min) * double(i) /
+                          double(nlogE-1));
+        }
+
+        // Determine minimum and maximum PSF radius at the model centre
+        double delta_min = 0.0;
+        double delta_max = 0.0;
+        for (int i = 0; i < nlogE; ++i) {
+            double delta = rsp.psf_delta_max(lambda, 0.0, zenith, azimuth,
+                                             m_logE[i]);
+            if (i == 0 || delta < delta_min) {
+                delta_min = delta;
+            }
+            if (i == 0 || delta > delta_max) {
+                delta_max = delta;
+            }
+        }
+
+        // Set zeta nodes
+        m_zeta_max = model.theta_max() + delta_max;
+        int nzeta  = (delta_min > 0.0)
+                     ? int(m_zeta_max / delta_min * G_ZETA_STEPS) + 2
+                     : G_MAX_ZETA;
+        if (nzeta > G_MAX_ZETA) {
+            nzeta = G_MAX_ZETA;
+        }
+        for (int i = 0; i < nzeta; ++i) {
+            m_zeta.append(m_zeta_max * double(i) / double(nzeta-1));
+        }
+
+        // Set omega0 nodes
+        for (int i = 0; i < G_NOMEGA; ++i) {
+            m_omega.append(gammalib::pi * double(i) / double(G_NOMEGA-1));
+        }
+
+        // Allocate node values
+        m_values.assign(nlogE * nzeta * G_NOMEGA * m_ncomp, 0.0);
+
+        // Compute node values. The measured photon direction is put at
+        // position angle zero, so that the displacement derivatives are
+        // towards and perpendicular to the measured photon direction.
+        int index = 0;
+        for (int ie = 0; ie < nlogE; ++ie) {
+            GEnergy srcEng;
+            srcEng.log10TeV(m_logE[ie]);
+            for (int iz = 0; iz < nzeta; ++iz) {
+                double zeta     = m_zeta[iz];
+                double cos_zeta = std::cos(zeta);
+                double sin_zeta = std::sin(zeta);
+                for (int io = 0; io < G_NOMEGA; ++io) {
+                    double omega0 = m_omega[io];
+                    double eta    = gammalib::acos(cos_lambda * cos_zeta +
+                                                   sin_lambda * sin_zeta *
+                                                   std::cos(omega0));
+                    GVector irf = rsp.irf_radial_components(model,
+                                                            zenith,
+                                                            azimuth,
+                                                            srcEng,
+                                                            srcTime,
+                                                            m_logE[ie],
+                                                            zeta,
+                                                            lambda,
+                                                            eta,
+                                                            0.0,
+                                                            omega0);
+                    for (int k = 0; k < m_ncomp; ++k, ++index) {
+                        m_values[index] = irf[k];
+                    }
+                }
+            }
+        }
+
+    } // endif: energy range existed
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Interpolate tabulated radial source IRF
+ *
+ * @param[in] zeta Distance model centre - measured photon (radians).
+ * @param[in] omega0 Azimuth of pointing in model system [0,pi] (radians).
+ * @param[in] logE log10 of photon energy (E/TeV).
+ * @param[out] values IRF value and gradients (size() components).
+ * @return True if the IRF could be interpolated, false if the grid is
+ *         empty or the energy is outside the energy range of the grid.
+ *
+ * Interpolates the IRF value and gradients trilinearly in logE, zeta and
+ * omega0. All components are zero beyond the zeta range of the grid.
+ ***************************************************************************/
+bool GCTARadialGrid::eval(const double& zeta, const double& omega0,
+                          const double& logE, GVector& values) const
+{
+    // Return false if grid is empty or energy is outside grid
+    if (m_values.empty() || logE < m_logE[0] ||
+        logE > m_logE[m_logE.size()-1]) {
+        return false;
+    }
+
+    // Initialise values
+    values = 0.0;
+
+    // Interpolate only if zeta is within grid
+    if (zeta < m_zeta_max) {
+
+        // Get node indices and weights
+        double o = (omega0 < 0.0) ? 0.0
+                   : ((omega0 > gammalib::pi) ? gammalib::pi : omega0);
+        GNodeArray::handle he = m_logE.locate(logE);
+        GNodeArray::handle hz = m_zeta.locate(zeta);
+        GNodeArray::handle ho = m_omega.locate(o);
+
+        // Set node indices and weights of the 8 corners
+        int    nzeta   = m_zeta.size();
+        int    nomega  = m_omega.size();
+        int    ie[2]   = {he.inx_left(), he.inx_right()};
+        int    iz[2]   = {hz.inx_left(), hz.inx_right()};
+        int    io[2]   = {ho.inx_left(), ho.inx_right()};
+        double we[2]   = {he.wgt_left(), he.wgt_right()};
+        double wz[2]   = {hz.wgt_left(), hz.wgt_right()};
+        double wo[2]   = {ho.wgt_left(), ho.wgt_right()};
+
+        // Sum weighted corners
+        for (int a = 0; a < 2; ++a) {
+            for (int b = 0; b < 2; ++b) {
+                for (int c = 0; c < 2; ++c) {
+                    double weight = we[a] * wz[b] * wo[c];
+                    if (weight != 0.0) {
+                        int offset = ((ie[a] * nzeta + iz[b]) * nomega + io[c]) *
+                                     m_ncomp;
+                        for (int k = 0; k < m_ncomp; ++k) {
+                            values[k] += weight * m_values[offset+k];
+                        }
+                    }
+                }
+            }
+        }
+
+    } // endif: zeta was within grid
+
+    // Return
+    return true;
+}
+
+
+/***********************************************************************//**
+ * @brief Print tabulated radial source IRF information
+ *
+ * @param[in] chatter Chattiness (defaults to NORMAL).
+ * @return String containing tabulated radial source IRF information.
+ ***************************************************************************/
+std::string GCTARadialGrid::print(const GChatter& chatter) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Continue only if chatter is not silent
+    if (chatter != SILENT) {
+
+        // Append header
+        result.append("=== GCTARadialGrid ===");
+
+        // Append information
+        result.append("\n"+gammalib::parformat("Number of energy nodes"));
+        result.append(gammalib::str(m_logE.size()));
+        result.append("\n"+gammalib::parformat("Number of zeta nodes"));
+        result.append(gammalib::str(m_zeta.size()));
+        result.append("\n"+gammalib::parformat("Number of omega0 nodes"));
+        result.append(gammalib::str(m_omega.size()));
+        result.append("\n"+gammalib::parformat("Components per node"));
+        result.append(gammalib::str(m_ncomp));
+        result.append("\n"+gammalib::parformat("Maximum zeta"));
+        result.append(gammalib::str(m_zeta_max*gammalib::rad2deg)+" deg");
+
+    } // endif: chatter was not silent
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Private methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GCTARadialGrid::init_members(void)
+{
+    // Initialise members
+    m_pars.clear();
+    m_ncomp    = 1;
+    m_zeta_max = 0.0;
+    m_logE.clear();
+    m_zeta.clear();
+    m_omega.clear();
+    m_values.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] grid Tabulated radial source IRF.
+ ***************************************************************************/
+void GCTARadialGrid::copy_members(const GCTARadialGrid& grid)
+{
+    // Copy members
+    m_pars     = grid.m_pars;
+    m_ncomp    = grid.m_ncomp;
+    m_zeta_max = grid.m_zeta_max;
+    m_logE     = grid.m_logE;
+    m_zeta     = grid.m_zeta;
+    m_omega    = grid.m_omega;
+    m_values   = grid.m_values;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GCTARadialGrid::free_members(void)
+{
+    // Return
+    return;
+}
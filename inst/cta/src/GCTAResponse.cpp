@@ -29,20 +29,31 @@
 #include <config.h>
 #endif
 #include <cmath>
+#include <cstdio>           // For std::sprintf()
 #include <vector>
 #include <string>
 #include "GFits.hpp"
 #include "GTools.hpp"
 #include "GMath.hpp"
 #include "GIntegral.hpp"
+#include "GIntegrals.hpp"
 #include "GCaldb.hpp"
+#include "GModelSpatialPointSource.hpp"
 #include "GModelSpatialRadial.hpp"
+#include "GModelSpatialRadialGauss.hpp"
+#include "GModelSpatialRadialDisk.hpp"
 #include "GModelSpatialElliptical.hpp"
+#include "GModelSpatialDiffuseMap.hpp"
+#include "GModels.hpp"
+#include "GModelSky.hpp"
 #include "GCTAObservation.hpp"
 #include "GCTAResponse.hpp"
 #include "GCTAResponse_helpers.hpp"
+#include "GCTARadialGrid.hpp"
+#include "GCTADiffuseGrid.hpp"
 #include "GCTAPointing.hpp"
 #include "GCTAEventList.hpp"
+#include "GCTAEventCube.hpp"
 #include "GCTARoi.hpp"
 #include "GCTAException.hpp"
 #include "GCTASupport.hpp"
@@ -54,13 +65,22 @@
 #include "GCTAPsfVector.hpp"
 #include "GCTAPsfPerfTable.hpp"
 
+/* __ Static members _____________________________________________________ */
+static unsigned long g_radial_id = 0;  //!< Last assigned grids identifier
+
+/* __ Thread private members _____________________________________________ */
+static unsigned long                          g_radial_owner = 0;
+static std::map<std::string,GCTARadialGrid>*  g_radial_grids = NULL;
+#pragma omp threadprivate(g_radial_owner, g_radial_grids)
+
 /* __ Method name definitions ____________________________________________ */
 #define G_CALDB                           "GCTAResponse::caldb(std::string&)"
 #define G_IRF      "GCTAResponse::irf(GInstDir&, GEnergy&, GTime&, GSkyDir&,"\
                                           " GEnergy&, GTime&, GObservation&)"
 #define G_NPRED             "GCTAResponse::npred(GSkyDir&, GEnergy&, GTime&,"\
                                                             " GObservation&)"
-#define G_MC            "GCTAResponse::mc(double&,GPhoton&,GPointing&,GRan&)"
+#define G_MC        "GCTAResponse::mc(double&,GPhoton&,GObservation&,GRan&,"\
+                                                             "GCTAEventAtom&)"
 
 #define G_IRF_RADIAL            "GCTAResponse::irf_radial(GEvent&, GSource&,"\
                                                             " GObservation&)"
@@ -68,6 +88,12 @@
                                                             " GObservation&)"
 #define G_IRF_DIFFUSE          "GCTAResponse::irf_diffuse(GEvent&, GSource&,"\
                                                             " GObservation&)"
+#define G_IRF_PTSRC_GRADIENTS                    "GCTAResponse::irf_ptsrc_"\
+                               "gradients(GEvent&, GSource&, GObservation&)"
+#define G_IRF_RADIAL_GRADIENTS                  "GCTAResponse::irf_radial_"\
+                               "gradients(GEvent&, GSource&, GObservation&)"
+#define G_IRF_ELLIPTICAL_GRADIENTS          "GCTAResponse::irf_elliptical_"\
+                               "gradients(GEvent&, GSource&, GObservation&)"
 #define G_NPRED_RADIAL  "GCTAResponse::npred_radial(GSource&, GObservation&)"
 #define G_NPRED_ELLIPTICAL         "GCTAResponse::npred_elliptical(GSource&,"\
                                                             " GObservation&)"
@@ -78,7 +104,7 @@
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
-#define G_USE_IRF_CACHE            //!< Use IRF cache in irf_diffuse method
+#define G_USE_IRF_CACHE   //!< Use IRF cache for diffuse and fixed extended models
 #define G_USE_NPRED_CACHE      //!< Use Npred cache in npred_diffuse method
 
 /* __ Debug definitions __________________________________________________ */
@@ -481,9 +507,6 @@ double GCTAResponse::npred(const GPhoton&      photon,
  * The method also applies a deadtime correction using a Monte Carlo process,
  * taking into account temporal deadtime variations. For this purpose, the
  * method makes use of the time dependent GObservation::deadc method.
- *
- * @todo Set polar angle phi of photon in camera system
- * @todo Implement energy dispersion
  ***************************************************************************/
 GCTAEventAtom* GCTAResponse::mc(const double& area, const GPhoton& photon,
                                 const GObservation& obs, GRan& ran) const
@@ -491,6 +514,51 @@ GCTAEventAtom* GCTAResponse::mc(const double& area, const GPhoton& photon,
     // Initialise event
     GCTAEventAtom* event = NULL;
 
+    // Simulate event and allocate it if it was detected
+    GCTAEventAtom atom;
+    if (mc(area, photon, obs, ran, atom)) {
+        event = new GCTAEventAtom(atom);
+    }
+
+    // Return event
+    return event;
+}
+
+
+/***********************************************************************//**
+ * @brief Simulate event from photon into existing event
+ *
+ * @param[in] area Simulation surface area.
+ * @param[in] photon Photon.
+ * @param[in] obs Observation.
+ * @param[in] ran Random number generator.
+ * @param[out] event Simulated event.
+ * @return True if the photon was detected.
+ *
+ * @exception GCTAException::no_pointing
+ *            No CTA pointing found in observation.
+ *
+ * Simulates a CTA event using the response function from an incident photon.
+ * If the photon is detected, the attributes of the simulated event are
+ * stored in @p event and the method returns true. Otherwise the method
+ * returns false and @p event is left unchanged. Contrary to the method that
+ * returns a pointer, no memory is allocated, which makes this method
+ * suited for simulating large numbers of events.
+ *
+ * The method also applies a deadtime correction using a Monte Carlo process,
+ * taking into account temporal deadtime variations. For this purpose, the
+ * method makes use of the time dependent GObservation::deadc method.
+ *
+ * @todo Set polar angle phi of photon in camera system
+ * @todo Implement energy dispersion
+ ***************************************************************************/
+bool GCTAResponse::mc(const double& area, const GPhoton& photon,
+                      const GObservation& obs, GRan& ran,
+                      GCTAEventAtom& event) const
+{
+    // Initialise detection flag
+    bool detected = false;
+
     // Get pointer on CTA pointing
     GCTAPointing* pnt = dynamic_cast<GCTAPointing*>(obs.pointing());
     if (pnt == NULL) {
@@ -532,20 +600,20 @@ GCTAEventAtom* GCTAResponse::mc(const double& area, const GPhoton& photon,
             GCTAInstDir inst_dir;
             inst_dir.dir(sky_dir);
 
-            // Allocate event
-            event = new GCTAEventAtom;
-
             // Set event attributes
-            event->dir(inst_dir);
-            event->energy(photon.energy());
-            event->time(photon.time());
+            event.dir(inst_dir);
+            event.energy(photon.energy());
+            event.time(photon.time());
+
+            // Signal detection
+            detected = true;
 
         } // endif: detector was alive
 
     } // endif: event was detected
 
-    // Return event
-    return event;
+    // Return detection flag
+    return detected;
 }
 
 
@@ -668,6 +736,10 @@ void GCTAResponse::load_aeff(const std::string& filename)
         m_aeff = new GCTAAeffPerfTable(filename);
     }
 
+    // Discard tabulated radial and diffuse source IRFs
+    reset_radial_grids();
+    m_diffuse_grids.clear();
+
     // Return
     return;
 }
@@ -731,6 +803,10 @@ void GCTAResponse::load_psf(const std::string& filename)
         m_psf = new GCTAPsfPerfTable(filename);
     }
 
+    // Discard tabulated radial and diffuse source IRFs
+    reset_radial_grids();
+    m_diffuse_grids.clear();
+
     // Return
     return;
 }
@@ -797,6 +873,137 @@ double GCTAResponse::offset_sigma(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Set usage of tabulated radial source IRFs
+ *
+ * @param[in] grid Use tabulated radial source IRFs?
+ *
+ * If set, the IRFs of Gaussian and disk models are interpolated from a grid
+ * that is computed once per observation and model, and recomputed when the
+ * model parameters change (see GCTARadialGrid). This speeds up the IRF
+ * computation considerably for large event numbers, at the expense of the
+ * interpolation precision. Any existing tabulated IRFs are discarded.
+ ***************************************************************************/
+void GCTAResponse::radial_grid(const bool& grid)
+{
+    // Set flag
+    m_radial_grid = grid;
+
+    // Discard tabulated IRFs
+    reset_radial_grids();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set usage of tabulated diffuse source IRFs
+ *
+ * @param[in] grid Use tabulated diffuse source IRFs?
+ *
+ * If set, the IRFs of diffuse models are interpolated from sky maps of the
+ * model intensity times the effective area that are convolved with the PSF
+ * using fast Fourier transforms (see GCTADiffuseGrid). The convolved maps
+ * are computed once per observation and model, and per energy when the
+ * first IRF at that energy is requested. This replaces the numerical PSF
+ * integration for every event, at the expense of the interpolation
+ * precision. The tabulated IRFs are not used if the response has energy
+ * dispersion. Any existing tabulated IRFs are discarded.
+ ***************************************************************************/
+void GCTAResponse::diffuse_grid(const bool& grid)
+{
+    // Set flag
+    m_diffuse_grid = grid;
+
+    // Discard tabulated IRFs
+    m_diffuse_grids.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set up IRF cache slots for models
+ *
+ * @param[in] obs Observation.
+ * @param[in] models Models.
+ *
+ * Creates the IRF cache slots of the event list of the observation for all
+ * sky models that take their IRF values from the cache, i.e. diffuse
+ * models, and radial and elliptical models without free parameters, and
+ * binds the slots to the actual model parameters (see
+ * GCTAEventList::irf_cache_bind()). Slots whose signature does not match
+ * the actual model are reset (see irf_cache_signature()). The IRF methods
+ * only use slots that were bound by this method.
+ *
+ * Creating or resetting a slot modifies the IRF cache, hence the method
+ * should be called before the IRF is evaluated concurrently for different
+ * events. The cache values of existing slots are then only modified for
+ * the event that a thread is processing. The method does nothing if the
+ * observation does not hold a CTA event list.
+ ***************************************************************************/
+void GCTAResponse::irf_cache_init(const GObservation& obs,
+                                  const GModels&      models) const
+{
+    // Continue only if the IRF cache is used
+    #if defined(G_USE_IRF_CACHE)
+
+    // Get event list
+    const GCTAEventList* list = dynamic_cast<const GCTAEventList*>(obs.events());
+
+    // Continue only if we have an event list
+    if (list != NULL) {
+
+        // Drop bindings of previous models
+        list->irf_cache_unbind();
+
+        // Loop over models
+        for (int i = 0; i < models.size(); ++i) {
+
+            // Get spatial component of sky models that apply to the
+            // observation. Skip all other models.
+            const GModelSky* sky = dynamic_cast<const GModelSky*>(models[i]);
+            if (sky == NULL || sky->spatial() == NULL ||
+                !sky->isvalid(obs.instrument(), obs.id())) {
+                continue;
+            }
+            const GModelSpatial* model = sky->spatial();
+
+            // Determine whether the model uses the IRF cache
+            bool cached = false;
+            if (dynamic_cast<const GModelSpatialDiffuse*>(model) != NULL) {
+                cached = true;
+            }
+            else if (dynamic_cast<const GModelSpatialRadial*>(model)     != NULL ||
+                     dynamic_cast<const GModelSpatialElliptical*>(model) != NULL) {
+                cached = true;
+                for (int k = 0; k < model->size(); ++k) {
+                    if ((*model)[k].isfree()) {
+                        cached = false;
+                        break;
+                    }
+                }
+            }
+
+            // Create or reset the IRF cache slot and bind it to the model
+            if (cached) {
+                list->irf_cache_bind(sky->name(), irf_cache_signature(*model),
+                                     *model);
+            }
+
+        } // endfor: looped over models
+
+    } // endif: we had an event list
+
+    #endif
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Print CTA response information
  *
@@ -818,6 +1025,10 @@ std::string GCTAResponse::print(const GChatter& chatter) const
         result.append("\n"+gammalib::parformat("Calibration database")+m_caldb);
         result.append("\n"+gammalib::parformat("Response name")+m_rspname);
         result.append("\n"+gammalib::parformat("RMF file name")+m_rmffile);
+        result.append("\n"+gammalib::parformat("Tabulated radial IRFs"));
+        result.append((m_radial_grid) ? "yes" : "no");
+        result.append("\n"+gammalib::parformat("Tabulated diffuse IRFs"));
+        result.append((m_diffuse_grid) ? "yes" : "no");
 
         // Append effective area information
         if (m_aeff != NULL) {
@@ -856,6 +1067,38 @@ std::string GCTAResponse::print(const GChatter& chatter) const
  =                                                                         =
  ==========================================================================*/
 
+/***********************************************************************//**
+ * @brief Return value of instrument response function for a source
+ *
+ * @param[in] event Observed event.
+ * @param[in] source Source.
+ * @param[in] obs Observation.
+ * @return Instrument response function value.
+ *
+ * Returns the instrument response function value for an event and a
+ * source. For event bins of an event cube that holds a source map of the
+ * source (see GCTAObservation::srcmaps()), the value is taken from the
+ * source map as long as the spatial model parameters are fixed and have
+ * the values for which the source map was computed. Otherwise the value
+ * is computed by GResponse::irf().
+ ***************************************************************************/
+double GCTAResponse::irf(const GEvent&       event,
+                         const GSource&      source,
+                         const GObservation& obs) const
+{
+    // Initialise IRF value
+    double irf = 0.0;
+
+    // Get IRF value from source map if available, otherwise compute it
+    if (!srcmap_irf(event, source, obs, irf)) {
+        irf = GResponse::irf(event, source, obs);
+    }
+
+    // Return IRF value
+    return irf;
+}
+
+
 /***********************************************************************//**
  * @brief Return IRF value for radial source model
  *
@@ -975,6 +1218,20 @@ double GCTAResponse::irf_radial(const GEvent&       event,
     double srcLogEng = srcEng.log10TeV();
     double obsLogEng = obsEng.log10TeV();
 
+    // Return IRF from tabulated IRF if requested and available
+    if (m_radial_grid && radial_analytic(*model)) {
+        const GCTARadialGrid* grid =
+              radial_grid(source.name(),
+                          const_cast<GModelSpatialRadial&>(*model),
+                          *ctaobs, srcTime);
+        if (grid != NULL) {
+            GVector values(grid->size());
+            if (grid->eval(zeta, omega0, srcLogEng, values)) {
+                return values[0];
+            }
+        }
+    }
+
     // Assign the observed theta angle (eta) as the true theta angle
     // between the source and the pointing directions. This is a (not
     // too bad) approximation which helps to speed up computations.
@@ -1019,7 +1276,7 @@ double GCTAResponse::irf_radial(const GEvent&       event,
         // Integrate over zenith angle
         GIntegral integral(&integrand);
         integral.eps(m_eps);
-        irf = integral.romb(rho_min, rho_max);
+        irf = integral.gkq(rho_min, rho_max);
 
         // Compile option: Check for NaN/Inf
         #if defined(G_NAN_CHECK)
@@ -1146,14 +1403,13 @@ double GCTAResponse::irf_elliptical(const GEvent&       event,
     double lambda = centre.dist(pnt->dir());
 
     // Compute azimuth angle of pointing in model coordinate system [radians]
-    // This azimuth angle is comprised in the interval [0,pi], and defines
-    // the zero point of the model coordinate system.
-    double omega0 = 0.0;
-    double denom  = std::sin(lambda) * std::sin(zeta);
-    if (denom != 0.0) {
-        double arg = (std::cos(eta) - std::cos(lambda) * std::cos(zeta))/denom;
-        omega0     = gammalib::acos(arg);
-    }
+    // The azimuth angle is counted in the same sense as the position angle
+    // of the model, with the zero point defined by the observed photon
+    // direction. Using the signed angle (instead of an angle comprised in
+    // [0,pi]) is required as elliptical models are not symmetric with
+    // respect to the line connecting model centre and observed photon
+    // direction.
+    double omega0 = centre.posang(pnt->dir()) - obsOmega;
 
     // Get log10(E/TeV) of true and measured photon energies
     double srcLogEng = srcEng.log10TeV();
@@ -1201,7 +1457,7 @@ double GCTAResponse::irf_elliptical(const GEvent&       event,
         // Integrate over zenith angle
         GIntegral integral(&integrand);
         integral.eps(m_eps);
-        irf = integral.romb(rho_min, rho_max);
+        irf = integral.gkq(rho_min, rho_max);
 
         // Compile option: Check for NaN/Inf
         #if defined(G_NAN_CHECK)
@@ -1282,17 +1538,27 @@ double GCTAResponse::irf_diffuse(const GEvent&       event,
     #if defined(G_USE_IRF_CACHE)
     const GCTAEventList* list = dynamic_cast<const GCTAEventList*>(obs.events());
     const GCTAEventAtom* atom = dynamic_cast<const GCTAEventAtom*>(&event);
+    int                  handle = -1;
+    double               norm   = 0.0;
     if (list != NULL && atom != NULL) {
-        irf = list->irf_cache(source.name(), atom->index());
-        if (irf >= 0.0) {
-            has_irf = true;
-            #if defined(G_DEBUG_IRF_DIFFUSE)
-            std::cout << "GCTAResponse::irf_diffuse:";
-            std::cout << " cached irf=" << irf << std::endl;
-            #endif
+        handle = list->irf_cache_bound(source.name(), *source.model());
+        norm   = irf_cache_norm(*source.model());
+        if (handle != -1 && norm != 0.0) {
+            irf = list->irf_cache(handle, atom->index());
+            if (irf >= 0.0) {
+                irf    *= norm;
+                has_irf = true;
+                #if defined(G_DEBUG_IRF_DIFFUSE)
+                std::cout << "GCTAResponse::irf_diffuse:";
+                std::cout << " cached irf=" << irf << std::endl;
+                #endif
+            }
+            else {
+                irf = 0.0;
+            }
         }
         else {
-            irf = 0.0;
+            handle = -1;
         }
     }
     #endif
@@ -1349,8 +1615,22 @@ double GCTAResponse::irf_diffuse(const GEvent&       event,
         double theta = eta;
         double phi   = 0.0; //TODO: Implement Phi dependence
 
+        // Optionally interpolate IRF from tabulated diffuse source IRF
+        bool tabulated = false;
+        if (m_diffuse_grid && !hasedisp()) {
+            const GCTADiffuseGrid* grid = diffuse_grid(source.name(), *model,
+                                                       *ctaobs, srcTime,
+                                                       srcLogEng);
+            if (grid != NULL) {
+                tabulated = grid->eval(dir->dir(), eta, srcLogEng, *model, irf);
+            }
+        }
+
         // Get maximum PSF radius in radians
-        double delta_max = psf_delta_max(theta, phi, zenith, azimuth, srcLogEng);
+        double delta_max = (tabulated)
+                           ? 0.0
+                           : psf_delta_max(theta, phi, zenith, azimuth,
+                                           srcLogEng);
 
         // Perform zenith angle integration if interval is valid
         if (delta_max > 0.0) {
@@ -1381,7 +1661,7 @@ double GCTAResponse::irf_diffuse(const GEvent&       event,
             // Integrate over zenith angle
             GIntegral integral(&integrand);
             integral.eps(1.0e-4);
-            irf = integral.romb(0.0, delta_max);
+            irf = integral.gkq(0.0, delta_max);
 
             // Compile option: Check for NaN/Inf
             #if defined(G_NAN_CHECK)
@@ -1395,10 +1675,10 @@ double GCTAResponse::irf_diffuse(const GEvent&       event,
             #endif
         }
 
-        // Put IRF value in cache
+        // Put IRF value per unit normalisation in cache
         #if defined(G_USE_IRF_CACHE)
-        if (list != NULL && atom != NULL) {
-            list->irf_cache(source.name(), atom->index(), irf);
+        if (handle != -1) {
+            list->irf_cache(handle, atom->index(), irf / norm);
         }
         #endif
 
@@ -1419,6 +1699,123 @@ double GCTAResponse::irf_diffuse(const GEvent&       event,
 }
 
 
+/***********************************************************************//**
+ * @brief Return IRF value and spatial model parameter gradients
+ *
+ * @param[in] event Observed event.
+ * @param[in] source Source.
+ * @param[in] obs Observation.
+ * @return IRF value.
+ *
+ * Returns the IRF value for a given event and source and sets the gradients
+ * of the spatial model parameters. For point sources, radial and elliptical
+ * models, the gradients are computed in the same pass as the IRF value by
+ * the irf_ptsrc_gradients(), irf_radial_gradients() and
+ * irf_elliptical_gradients() methods. For diffuse models the
+ * GResponse::irf_gradients() method is used.
+ *
+ * For radial and elliptical models without free parameters the IRF value
+ * is taken from the IRF cache of the event list, and only computed by the
+ * irf_radial() or irf_elliptical() methods if it is not yet in the cache.
+ * For event cubes, the IRF value of models without free spatial parameters
+ * is taken from the source map of the model if it exists.
+ ***************************************************************************/
+double GCTAResponse::irf_gradients(const GEvent&       event,
+                                   const GSource&      source,
+                                   const GObservation& obs) const
+{
+    // Initialise IRF value
+    double irf = 0.0;
+
+    // Signal radial and elliptical models
+    bool radial     = (dynamic_cast<const GModelSpatialRadial*>(source.model()) != NULL);
+    bool elliptical = (dynamic_cast<const GModelSpatialElliptical*>(source.model()) != NULL);
+
+    // Signal if spatial model has no free parameters
+    bool fixed = true;
+    if (radial || elliptical) {
+        for (int i = 0; i < source.model()->size(); ++i) {
+            if ((*(source.model()))[i].isfree()) {
+                fixed = false;
+                break;
+            }
+        }
+    }
+
+    // Get event list and event atom for IRF cache lookup
+    #if defined(G_USE_IRF_CACHE)
+    const GCTAEventList* list = dynamic_cast<const GCTAEventList*>(obs.events());
+    const GCTAEventAtom* atom = dynamic_cast<const GCTAEventAtom*>(&event);
+    #else
+    const GCTAEventList* list = NULL;
+    const GCTAEventAtom* atom = NULL;
+    #endif
+
+    // Use the source map of the event cube for models without free
+    // spatial parameters. Since the parameters are fixed, all gradients
+    // are zero
+    if (srcmap_irf(event, source, obs, irf)) {
+
+        // Set gradients (circumvent const correctness)
+        GModelSpatial* model = const_cast<GModelSpatial*>(source.model());
+        for (int i = 0; i < model->size(); ++i) {
+            (*model)[i].factor_gradient(0.0);
+        }
+
+    }
+
+    // Use the IRF cache for radial and elliptical models without free
+    // parameters. Since the parameters are fixed, all gradients are zero
+    else if ((radial || elliptical) && fixed && list != NULL && atom != NULL) {
+
+        // Get IRF value from cache, and compute it if it is not yet in the
+        // cache
+        int handle = list->irf_cache_bound(source.name(), *source.model());
+        irf        = (handle != -1) ? list->irf_cache(handle, atom->index()) : -1.0;
+        if (irf < 0.0) {
+            irf = (radial) ? irf_radial(event, source, obs)
+                           : irf_elliptical(event, source, obs);
+            if (handle != -1) {
+                list->irf_cache(handle, atom->index(), irf);
+            }
+        }
+
+        // Apply deadtime correction
+        irf *= obs.deadc(source.time());
+
+        // Set gradients (circumvent const correctness)
+        GModelSpatial* model = const_cast<GModelSpatial*>(source.model());
+        for (int i = 0; i < model->size(); ++i) {
+            (*model)[i].factor_gradient(0.0);
+        }
+
+    }
+
+    // Is spatial model a point source?
+    else if (dynamic_cast<const GModelSpatialPointSource*>(source.model()) != NULL) {
+        irf = irf_ptsrc_gradients(event, source, obs);
+    }
+
+    // Is spatial model a radial source?
+    else if (radial) {
+        irf = irf_radial_gradients(event, source, obs);
+    }
+
+    // Is spatial model an elliptical source?
+    else if (elliptical) {
+        irf = irf_elliptical_gradients(event, source, obs);
+    }
+
+    // ... otherwise use generic method
+    else {
+        irf = GResponse::irf_gradients(event, source, obs);
+    }
+
+    // Return IRF value
+    return irf;
+}
+
+
 /***********************************************************************//**
  * @brief Return spatial integral of radial source model over ROI
  *
@@ -1567,7 +1964,7 @@ double GCTAResponse::npred_radial(const GSource& source,
 
         // Integrate over theta
         GIntegral integral(&integrand);
-        npred = integral.romb(rho_min, rho_max);
+        npred = integral.gkq(rho_min, rho_max);
 
         // Compile option: Show integration results
         #if defined(G_DEBUG_NPRED_RADIAL)
@@ -1745,7 +2142,7 @@ double GCTAResponse::npred_elliptical(const GSource& source,
 
         // Integrate over theta
         GIntegral integral(&integrand);
-        npred = integral.romb(rho_min, rho_max);
+        npred = integral.gkq(rho_min, rho_max);
 
         // Compile option: Show integration results
         #if defined(G_DEBUG_NPRED_ELLIPTICAL)
@@ -1932,7 +2329,7 @@ double GCTAResponse::npred_diffuse(const GSource& source,
             // Integrate over theta
             GIntegral integral(&integrand);
             integral.eps(1.0e-4);
-            npred = integral.romb(0.0, roi_psf_radius);
+            npred = integral.gkq(0.0, roi_psf_radius);
 
             // Compile option: Show integration results
             #if defined(G_DEBUG_NPRED_DIFFUSE)
@@ -2269,7 +2666,7 @@ void GCTAResponse::init_members(void)
     m_caldb.clear();
     m_rspname.clear();
     m_rmffile.clear();
-    m_eps   = 1.0e-5; // Precision for Romberg integration
+    m_eps   = 1.0e-5; // Precision for IRF integration
     m_aeff  = NULL;
     m_psf   = NULL;
     m_edisp = NULL;
@@ -2280,6 +2677,12 @@ void GCTAResponse::init_members(void)
     m_npred_times.clear();
     m_npred_values.clear();
 
+    // Initialise tabulated radial source IRFs
+    m_radial_grid = false;
+    reset_radial_grids();
+    m_diffuse_grid = false;
+    m_diffuse_grids.clear();
+
     // Return
     return;
 }
@@ -2304,6 +2707,13 @@ void GCTAResponse::copy_members(const GCTAResponse& rsp)
     m_npred_times    = rsp.m_npred_times;
     m_npred_values   = rsp.m_npred_values;
 
+    // Copy tabulated radial source IRF flag. The tabulated IRFs are not
+    // copied as they are recomputed on demand.
+    m_radial_grid = rsp.m_radial_grid;
+    reset_radial_grids();
+    m_diffuse_grid = rsp.m_diffuse_grid;
+    m_diffuse_grids.clear();
+
     // Clone members
     m_aeff  = (rsp.m_aeff  != NULL) ? rsp.m_aeff->clone()  : NULL;
     m_psf   = (rsp.m_psf   != NULL) ? rsp.m_psf->clone()   : NULL;
@@ -2332,3 +2742,867 @@ void GCTAResponse::free_members(void)
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Return point source IRF value and position gradients
+ *
+ * @param[in] event Observed event.
+ * @param[in] source Source.
+ * @param[in] obs Observation.
+ * @return IRF value.
+ *
+ * @exception GCTAException::bad_observation_type
+ *            Specified observation is not a CTA observations.
+ * @exception GCTAException::no_pointing
+ *            No valid CTA pointing found.
+ * @exception GCTAException::bad_instdir_type
+ *            Instrument direction is not a valid CTA instrument direction.
+ * @exception GCTAException::bad_model_type
+ *            Model is not a point source model.
+ *
+ * Computes the point source IRF and the gradients of the source position
+ * using the chain rule
+ *
+ * \f[
+ *    \frac{\partial IRF}{\partial \alpha_0} =
+ *    \frac{\partial IRF}{\partial \delta}
+ *    \frac{\partial \delta}{\partial \alpha_0} +
+ *    \frac{\partial IRF}{\partial \theta}
+ *    \frac{\partial \theta}{\partial \alpha_0}
+ * \f]
+ *
+ * (and similarly for \f$\delta_0\f$), where \f$\delta\f$ is the angular
+ * distance between source and measured photon direction, and \f$\theta\f$
+ * is the angular distance between source and pointing direction.
+ ***************************************************************************/
+double GCTAResponse::irf_ptsrc_gradients(const GEvent&       event,
+                                         const GSource&      source,
+                                         const GObservation& obs) const
+{
+    // Get pointer on CTA observation
+    const GCTAObservation* ctaobs = dynamic_cast<const GCTAObservation*>(&obs);
+    if (ctaobs == NULL) {
+        throw GCTAException::bad_observation_type(G_IRF_PTSRC_GRADIENTS);
+    }
+
+    // Get pointer on CTA pointing
+    const GCTAPointing *pnt = ctaobs->pointing();
+    if (pnt == NULL) {
+        throw GCTAException::no_pointing(G_IRF_PTSRC_GRADIENTS);
+    }
+
+    // Get pointer on CTA instrument direction
+    const GCTAInstDir* dir = dynamic_cast<const GCTAInstDir*>(&(event.dir()));
+    if (dir == NULL) {
+        throw GCTAException::bad_instdir_type(G_IRF_PTSRC_GRADIENTS);
+    }
+
+    // Get non-const pointer on point source model (circumvent const
+    // correctness)
+    GModelSpatialPointSource* model =
+        dynamic_cast<GModelSpatialPointSource*>(const_cast<GModelSpatial*>(source.model()));
+    if (model == NULL) {
+        throw GCTAException::bad_model_type(G_IRF_PTSRC_GRADIENTS);
+    }
+
+    // Get event and source attributes
+    const GSkyDir& obsDir    = dir->dir();
+    const GSkyDir& pntDir    = pnt->dir();
+    GSkyDir        srcDir    = model->dir();
+    double         obsLogEng = event.energy().log10TeV();
+    double         srcLogEng = source.energy().log10TeV();
+
+    // Get pointing direction zenith angle and azimuth [radians]
+    double zenith  = pnt->zenith();
+    double azimuth = pnt->azimuth();
+
+    // Get offset angle of source, PSF offset angle and maximum PSF offset
+    // angle [radians]
+    double theta     = pntDir.dist(srcDir);
+    double phi       = 0.0; //TODO: Implement Phi dependence
+    double delta     = obsDir.dist(srcDir);
+    double delta_max = psf_delta_max(theta, phi, zenith, azimuth, srcLogEng);
+
+    // Initialise IRF value and partial derivatives
+    double irf     = 0.0;
+    double d_delta = 0.0;
+    double d_theta = 0.0;
+
+    // Compute only if we're sufficiently close to PSF
+    if (delta <= delta_max) {
+        irf = gammalib::cta_irf_partials(*this, delta, theta, phi,
+                                         zenith, azimuth,
+                                         srcLogEng, obsLogEng,
+                                         &d_delta, &d_theta);
+    }
+
+    // Compute derivatives of delta and theta with respect to the source
+    // position (radians per radians)
+    double cos_dec0   = std::cos(srcDir.dec());
+    double sin_dec0   = std::sin(srcDir.dec());
+    double cos_obs    = std::cos(obsDir.dec());
+    double sin_obs    = std::sin(obsDir.dec());
+    double cos_pnt    = std::cos(pntDir.dec());
+    double sin_pnt    = std::sin(pntDir.dec());
+    double dra_obs    = srcDir.ra() - obsDir.ra();
+    double dra_pnt    = srcDir.ra() - pntDir.ra();
+    double sin_delta  = std::sin(delta);
+    double sin_theta  = std::sin(theta);
+    double ddelta_ra  = 0.0;
+    double ddelta_dec = 0.0;
+    double dtheta_ra  = 0.0;
+    double dtheta_dec = 0.0;
+    if (sin_delta > 0.0) {
+        ddelta_ra  = cos_dec0 * cos_obs * std::sin(dra_obs) / sin_delta;
+        ddelta_dec = (sin_dec0 * cos_obs * std::cos(dra_obs) -
+                      cos_dec0 * sin_obs) / sin_delta;
+    }
+    if (sin_theta > 0.0) {
+        dtheta_ra  = cos_dec0 * cos_pnt * std::sin(dra_pnt) / sin_theta;
+        dtheta_dec = (sin_dec0 * cos_pnt * std::cos(dra_pnt) -
+                      cos_dec0 * sin_pnt) / sin_theta;
+    }
+
+    // Apply deadtime correction
+    double deadc = obs.deadc(source.time());
+    irf     *= deadc;
+    d_delta *= deadc;
+    d_theta *= deadc;
+
+    // Set gradients
+    GModelPar& ra  = (*model)[0];
+    GModelPar& dec = (*model)[1];
+    double g_ra  = (ra.isfree())
+                   ? (d_delta * ddelta_ra + d_theta * dtheta_ra) *
+                     gammalib::deg2rad * ra.scale() : 0.0;
+    double g_dec = (dec.isfree())
+                   ? (d_delta * ddelta_dec + d_theta * dtheta_dec) *
+                     gammalib::deg2rad * dec.scale() : 0.0;
+    ra.factor_gradient(g_ra);
+    dec.factor_gradient(g_dec);
+
+    // Return IRF value
+    return irf;
+}
+
+
+/***********************************************************************//**
+ * @brief Return radial source IRF value and parameter gradients
+ *
+ * @param[in] event Observed event.
+ * @param[in] source Source.
+ * @param[in] obs Observation.
+ * @return IRF value.
+ *
+ * @exception GCTAException::bad_observation_type
+ *            Specified observation is not a CTA observations.
+ * @exception GCTAException::no_pointing
+ *            No valid CTA pointing found.
+ * @exception GCTAException::bad_instdir_type
+ *            Instrument direction is not a valid CTA instrument direction.
+ * @exception GCTAException::bad_model_type
+ *            Model is not a radial model.
+ *
+ * Computes the radial source IRF in the same way as irf_radial(), and
+ * integrates in the same pass the derivatives of the IRF with respect to a
+ * displacement of the model centre (see cta_irf_radial_grad_kern_omega) and
+ * the derivatives of the radial profile with respect to the model
+ * parameters. The latter are used for Gaussian and disk models, where for
+ * the disk the contribution of the disk edge is added explicitly. For all
+ * other radial models, the gradients of the model parameters are computed
+ * numerically using GResponse::irf_gradient().
+ *
+ * The gradients with respect to Right Ascension and Declination follow
+ * from the displacement derivatives using
+ *
+ * \f[
+ *    \frac{\partial IRF}{\partial \alpha_0} = \cos \delta_0
+ *    \frac{\partial IRF}{\partial \epsilon_{\rm E}}
+ *    \quad {\rm and} \quad
+ *    \frac{\partial IRF}{\partial \delta_0} =
+ *    \frac{\partial IRF}{\partial \epsilon_{\rm N}}
+ * \f]
+ ***************************************************************************/
+double GCTAResponse::irf_radial_gradients(const GEvent&       event,
+                                          const GSource&      source,
+                                          const GObservation& obs) const
+{
+    // Get pointer on CTA observation
+    const GCTAObservation* ctaobs = dynamic_cast<const GCTAObservation*>(&obs);
+    if (ctaobs == NULL) {
+        throw GCTAException::bad_observation_type(G_IRF_RADIAL_GRADIENTS);
+    }
+
+    // Get pointer on CTA pointing
+    const GCTAPointing *pnt = ctaobs->pointing();
+    if (pnt == NULL) {
+        throw GCTAException::no_pointing(G_IRF_RADIAL_GRADIENTS);
+    }
+
+    // Get pointer on CTA instrument direction
+    const GCTAInstDir* dir = dynamic_cast<const GCTAInstDir*>(&(event.dir()));
+    if (dir == NULL) {
+        throw GCTAException::bad_instdir_type(G_IRF_RADIAL_GRADIENTS);
+    }
+
+    // Get non-const pointer on radial model (circumvent const correctness)
+    GModelSpatialRadial* model =
+        dynamic_cast<GModelSpatialRadial*>(const_cast<GModelSpatial*>(source.model()));
+    if (model == NULL) {
+        throw GCTAException::bad_model_type(G_IRF_RADIAL_GRADIENTS);
+    }
+
+    // Get event attributes
+    const GSkyDir& obsDir = dir->dir();
+    const GEnergy& obsEng = event.energy();
+
+    // Get source attributes
+    GSkyDir        centre  = model->dir();
+    const GEnergy& srcEng  = source.energy();
+    const GTime&   srcTime = source.time();
+
+    // Get pointing direction zenith angle and azimuth [radians]
+    double zenith  = pnt->zenith();
+    double azimuth = pnt->azimuth();
+
+    // Determine angular distances between model centre and measured photon
+    // direction, between model centre and pointing direction, and between
+    // measured photon direction and pointing direction [radians]
+    double zeta   = centre.dist(obsDir);
+    double lambda = centre.dist(pnt->dir());
+    double eta    = pnt->dir().dist(obsDir);
+
+    // Determine position angle of measured photon direction and azimuth
+    // angle of pointing in model system [radians]
+    double obsOmega = centre.posang(obsDir);
+    double omega0   = centre.posang(pnt->dir()) - obsOmega;
+
+    // Signal whether model parameter gradients are computed analytically
+    bool analytic = radial_analytic(*model);
+
+    // Initialise IRF value and gradients
+    GVector irf;
+
+    // Get IRF value and gradients from the tabulated IRF if requested and
+    // available. The tabulated IRF holds the derivatives for a displacement
+    // towards and perpendicular to the measured photon direction, which are
+    // rotated into North and East derivatives.
+    bool tabulated = false;
+    if (m_radial_grid && analytic) {
+        const GCTARadialGrid* grid = radial_grid(source.name(), *model,
+                                                 *ctaobs, srcTime);
+        if (grid != NULL) {
+            double wrap = gammalib::modulo(omega0, gammalib::twopi);
+            double sign = (wrap > gammalib::pi) ? -1.0 : 1.0;
+            if (wrap > gammalib::pi) {
+                wrap = gammalib::twopi - wrap;
+            }
+            irf = GVector(grid->size());
+            if (grid->eval(zeta, wrap, srcEng.log10TeV(), irf)) {
+                double d_par     = irf[1];
+                double d_perp    = sign * irf[2];
+                double cos_omega = std::cos(obsOmega);
+                double sin_omega = std::sin(obsOmega);
+                irf[1]    = d_par * cos_omega - d_perp * sin_omega;
+                irf[2]    = d_par * sin_omega + d_perp * cos_omega;
+                tabulated = true;
+            }
+        }
+    }
+
+    // Compute IRF value and gradients if they were not tabulated
+    if (!tabulated) {
+        irf = irf_radial_components(*model, zenith, azimuth, srcEng, srcTime,
+                                    obsEng.log10TeV(), zeta, lambda, eta,
+                                    obsOmega, omega0);
+    }
+
+    // Apply deadtime correction
+    irf *= obs.deadc(srcTime);
+
+    // Set position gradients
+    GModelPar& ra  = (*model)[0];
+    GModelPar& dec = (*model)[1];
+    ra.factor_gradient((ra.isfree())
+                       ? irf[2] * std::cos(centre.dec()) *
+                         gammalib::deg2rad * ra.scale() : 0.0);
+    dec.factor_gradient((dec.isfree())
+                        ? irf[1] * gammalib::deg2rad * dec.scale() : 0.0);
+
+    // Set gradients of remaining model parameters
+    for (int i = 2; i < model->size(); ++i) {
+        GModelPar& par  = (*model)[i];
+        double     grad = 0.0;
+        if (par.isfree()) {
+            grad = (analytic) ? irf[i+1] : irf_gradient(event, source, obs, i);
+        }
+        par.factor_gradient(grad);
+    }
+
+    // Return IRF value
+    return irf[0];
+}
+
+
+/***********************************************************************//**
+ * @brief Compute radial source IRF value and gradients
+ *
+ * @param[in] model Radial model.
+ * @param[in] zenith Zenith angle of pointing (radians).
+ * @param[in] azimuth Azimuth angle of pointing (radians).
+ * @param[in] srcEng True photon energy.
+ * @param[in] srcTime True photon arrival time.
+ * @param[in] obsLogEng Log10 of measured photon energy (E/TeV).
+ * @param[in] zeta Distance model centre - measured photon (radians).
+ * @param[in] lambda Distance model centre - pointing (radians).
+ * @param[in] eta Distance pointing - measured photon (radians).
+ * @param[in] obsOmega Position angle of measured photon (radians).
+ * @param[in] omega0 Azimuth of pointing in model system (radians).
+ * @return Vector of IRF value, IRF derivatives for a displacement of the
+ *         model centre towards North and East, and (for Gaussian and disk
+ *         models) derivatives with respect to the parameters following the
+ *         position parameters.
+ *
+ * Performs the integrations of irf_radial_gradients() without deadtime
+ * correction. The method is also used to compute the nodes of the
+ * tabulated radial source IRF (see GCTARadialGrid).
+ ***************************************************************************/
+GVector GCTAResponse::irf_radial_components(GModelSpatialRadial& model,
+                                            const double&        zenith,
+                                            const double&        azimuth,
+                                            const GEnergy&       srcEng,
+                                            const GTime&         srcTime,
+                                            const double&        obsLogEng,
+                                            const double&        zeta,
+                                            const double&        lambda,
+                                            const double&        eta,
+                                            const double&        obsOmega,
+                                            const double&        omega0) const
+{
+    // Get log10(E/TeV) of true photon energy
+    double srcLogEng = srcEng.log10TeV();
+
+    // Get maximum PSF and source radius in radians (see irf_radial)
+    double theta     = eta;
+    double phi       = 0.0; //TODO: Implement IRF Phi dependence
+    double delta_max = psf_delta_max(theta, phi, zenith, azimuth, srcLogEng);
+    double src_max   = model.theta_max();
+
+    // Set radial model zenith angle range
+    double rho_min = (zeta > delta_max) ? zeta - delta_max : 0.0;
+    double rho_max = zeta + delta_max;
+    if (rho_max > src_max) {
+        rho_max = src_max;
+    }
+
+    // Determine model parameters for which model gradients are used
+    const GModelSpatialRadialDisk* disk =
+          dynamic_cast<const GModelSpatialRadialDisk*>(&model);
+    std::vector<int> pars;
+    if (radial_analytic(model)) {
+        for (int i = 2; i < model.size(); ++i) {
+            pars.push_back(i);
+        }
+    }
+
+    // Initialise IRF value and gradients
+    GVector irf(3 + int(pars.size()));
+
+    // Perform zenith angle integration if interval is valid
+    if (rho_max > rho_min) {
+
+        // Setup integration kernel
+        cta_irf_radial_grad_kern_rho integrand(*this,
+                                               model,
+                                               pars,
+                                               zenith,
+                                               azimuth,
+                                               srcEng,
+                                               srcTime,
+                                               srcLogEng,
+                                               obsLogEng,
+                                               zeta,
+                                               lambda,
+                                               obsOmega,
+                                               omega0,
+                                               delta_max);
+
+        // Integrate over zenith angle
+        GIntegrals integral(&integrand);
+        integral.eps(m_eps);
+        irf = integral.gkq(rho_min, rho_max);
+
+        // Add disk edge contribution to disk radius gradient. The disk edge
+        // contributes only if it lies within the integration range.
+        if (disk != NULL && rho_max == src_max) {
+            double cos_zeta   = std::cos(zeta);
+            double sin_zeta   = std::sin(zeta);
+            double cos_lambda = std::cos(lambda);
+            double sin_lambda = std::sin(lambda);
+            double domega     = 0.5 * gammalib::cta_roi_arclength(src_max,
+                                                                  zeta,
+                                                                  cos_zeta,
+                                                                  sin_zeta,
+                                                                  delta_max,
+                                                                  std::cos(delta_max));
+            if (domega > 0.0) {
+                cta_irf_radial_grad_kern_omega edge(*this,
+                                                    zenith,
+                                                    azimuth,
+                                                    srcLogEng,
+                                                    obsLogEng,
+                                                    obsOmega,
+                                                    omega0,
+                                                    src_max,
+                                                    cos_zeta,
+                                                    sin_zeta,
+                                                    cos_lambda,
+                                                    sin_lambda);
+                GIntegrals integral_edge(&edge);
+                integral_edge.eps(m_eps);
+                double edge_irf = integral_edge.gkq(-domega, domega)[0];
+                double norm     = disk->eval(0.0, srcEng, srcTime);
+                irf[3]         += norm * std::sin(src_max) * edge_irf *
+                                  gammalib::deg2rad * model[2].scale();
+            }
+        }
+
+    } // endif: zenith angle interval was valid
+
+    // Return IRF value and gradients
+    return irf;
+}
+
+
+/***********************************************************************//**
+ * @brief Signal if radial model has analytic parameter gradients
+ *
+ * @param[in] model Radial model.
+ * @return True if the parameter gradients of the model are integrated
+ *         analytically.
+ *
+ * The parameters following the position of Gaussian and disk models have
+ * analytic gradients.
+ ***************************************************************************/
+bool GCTAResponse::radial_analytic(const GModelSpatialRadial& model) const
+{
+    // Return
+    return (dynamic_cast<const GModelSpatialRadialDisk*>(&model)  != NULL ||
+            dynamic_cast<const GModelSpatialRadialGauss*>(&model) != NULL);
+}
+
+
+/***********************************************************************//**
+ * @brief Return tabulated radial source IRF
+ *
+ * @param[in] name Source name.
+ * @param[in] model Radial model.
+ * @param[in] obs CTA observation.
+ * @param[in] srcTime True photon arrival time.
+ * @return Pointer to tabulated radial source IRF (NULL if no grid exists).
+ *
+ * Returns the tabulated IRF of the named source for the calling thread.
+ * The IRF is (re)computed if it does not exist or if the model parameters
+ * have changed since it was computed. As the response is shared among
+ * the threads of the likelihood computation, the tabulated IRFs are kept
+ * per thread, which avoids any locking when the IRFs are used.
+ *
+ * The tabulated IRFs of a thread are stored in the response under the
+ * address of a thread private variable, which differs for all threads
+ * that run at the same time, including threads of nested parallel regions.
+ * The location of the tabulated IRFs is memorised in thread private
+ * storage together with the identifier of the tabulated IRFs of the
+ * response, hence the IRFs are only looked up in a critical section the
+ * first time a thread accesses them after reset_radial_grids().
+ ***************************************************************************/
+const GCTARadialGrid* GCTAResponse::radial_grid(const std::string&     name,
+                                                GModelSpatialRadial&   model,
+                                                const GCTAObservation& obs,
+                                                const GTime&           srcTime) const
+{
+    // Look up the tabulated IRFs of the calling thread if the thread has
+    // not yet accessed the tabulated IRFs of this response
+    if (g_radial_owner != m_radial_id) {
+        #pragma omp critical(GCTAResponse_radial_grid)
+        g_radial_grids = &(m_radial_grids[&g_radial_grids]);
+        g_radial_owner = m_radial_id;
+    }
+
+    // Get grid, and (re)compute it if necessary
+    GCTARadialGrid& grid = (*g_radial_grids)[name];
+    if (!grid.isvalid(model)) {
+        grid.set(*this, model, obs, srcTime);
+    }
+
+    // Return pointer to grid (NULL if it is empty)
+    return (grid.isempty() ? NULL : &grid);
+}
+
+
+/***********************************************************************//**
+ * @brief Reset tabulated radial source IRFs
+ *
+ * Discards the tabulated radial source IRFs of all threads and assigns a
+ * new identifier to the tabulated IRFs of the response, which has never
+ * been used before by any response. The method must not be called from
+ * within a parallel region.
+ ***************************************************************************/
+void GCTAResponse::reset_radial_grids(void) const
+{
+    // Clear tabulated IRFs
+    m_radial_grids.clear();
+
+    // Draw new identifier
+    #pragma omp critical(GCTAResponse_radial_grid)
+    m_radial_id = ++g_radial_id;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return tabulated diffuse source IRF
+ *
+ * @param[in] name Source name.
+ * @param[in] model Diffuse model.
+ * @param[in] obs CTA observation.
+ * @param[in] srcTime True photon arrival time.
+ * @param[in] srcLogEng log10 of true photon energy (E/TeV).
+ * @return Pointer to tabulated diffuse source IRF (NULL if no grid exists
+ *         for the energy).
+ *
+ * Returns the tabulated IRF of the named source, with the convolved maps
+ * that are needed for the energy computed. The grid is set up if it does
+ * not exist. As the convolved maps are large, a single set of tabulated
+ * IRFs is shared by all threads, and grid set up and map computation are
+ * serialised. Once computed, the maps are not altered, hence the returned
+ * grid can be evaluated concurrently.
+ ***************************************************************************/
+const GCTADiffuseGrid* GCTAResponse::diffuse_grid(const std::string&     name,
+                                                  const GModelSpatial&   model,
+                                                  const GCTAObservation& obs,
+                                                  const GTime&           srcTime,
+                                                  const double&          srcLogEng) const
+{
+    // Initialise pointer
+    const GCTADiffuseGrid* ptr = NULL;
+
+    // Get grid, set it up and compute the maps if necessary
+    #pragma omp critical(GCTAResponse_diffuse_grid)
+    {
+        GCTADiffuseGrid& grid = m_diffuse_grids[name];
+        if (!grid.isvalid(model)) {
+            grid.set(*this, model, obs);
+        }
+        if (grid.compute(*this, model, srcTime, srcLogEng)) {
+            ptr = &grid;
+        }
+    }
+
+    // Return pointer to grid
+    return ptr;
+}
+
+
+/***********************************************************************//**
+ * @brief Get IRF value from source map
+ *
+ * @param[in] event Observed event.
+ * @param[in] source Source.
+ * @param[in] obs Observation.
+ * @param[out] irf IRF value (including deadtime correction).
+ * @return True if the IRF value was taken from a source map.
+ *
+ * Takes the IRF value from the source map of the event cube if the event
+ * is an event cube bin, if a source map exists for the source, if the
+ * spatial model has no free parameters, and if the spatial parameter values
+ * are those for which the source map was computed.
+ ***************************************************************************/
+bool GCTAResponse::srcmap_irf(const GEvent&       event,
+                              const GSource&      source,
+                              const GObservation& obs,
+                              double&             irf) const
+{
+    // Initialise flag
+    bool found = false;
+
+    // Continue only if the event is a bin of an event cube with source maps
+    const GCTAEventCube* cube = dynamic_cast<const GCTAEventCube*>(obs.events());
+    if (cube != NULL && cube->nsrcmaps() > 0) {
+        const GCTAEventBin* bin = dynamic_cast<const GCTAEventBin*>(&event);
+        int                 index = cube->srcmap_index(source.name());
+        if (bin != NULL && index >= 0 && source.model() != NULL) {
+
+            // Signal if spatial model has no free parameters
+            bool fixed = true;
+            for (int i = 0; i < source.model()->size(); ++i) {
+                if ((*(source.model()))[i].isfree()) {
+                    fixed = false;
+                    break;
+                }
+            }
+
+            // Get IRF value from source map if it was computed for the
+            // actual spatial parameter values
+            if (fixed && cube->srcmap_isvalid(index, *source.model())) {
+                irf   = cube->srcmap_value(index, bin->index());
+                found = true;
+            }
+
+        } // endif: source map existed
+    } // endif: event cube had source maps
+
+    // Return flag
+    return found;
+}
+
+
+/***********************************************************************//**
+ * @brief Return IRF cache signature of a spatial model
+ *
+ * @param[in] model Spatial model.
+ * @return Signature (16 hexadecimal digits).
+ *
+ * Returns a signature that identifies the spatial model and the response
+ * for which IRF values are stored in the IRF cache of an event list. The
+ * signature is a 64-bit FNV-1a hash of the calibration database and
+ * response names, the model type, the map file name of diffuse map models
+ * and the bit patterns of all spatial parameter values. Cached IRF values
+ * are hence dropped if any of these attributes has changed.
+ *
+ * The parameters of diffuse models are normalisations, and the IRF cache
+ * holds the IRF values of diffuse models per unit normalisation (see
+ * irf_cache_norm()). The parameter values of diffuse models therefore do
+ * not enter the signature, so that the cached values are kept when the
+ * normalisation is fitted.
+ ***************************************************************************/
+std::string GCTAResponse::irf_cache_signature(const GModelSpatial& model) const
+{
+    // Set descriptor
+    std::string descriptor = m_caldb + "|" + m_rspname + "|" + model.type();
+    const GModelSpatialDiffuseMap* map =
+          dynamic_cast<const GModelSpatialDiffuseMap*>(&model);
+    if (map != NULL) {
+        descriptor += "|" + map->filename();
+    }
+
+    // Hash descriptor
+    unsigned long long hash = 14695981039346656037ULL;
+    for (int i = 0; i < descriptor.length(); ++i) {
+        hash ^= (unsigned char)descriptor[i];
+        hash *= 1099511628211ULL;
+    }
+
+    // Hash parameter values of all but diffuse models
+    int npars = (dynamic_cast<const GModelSpatialDiffuse*>(&model) != NULL)
+                ? 0 : model.size();
+    for (int k = 0; k < npars; ++k) {
+        double               value = model[k].value();
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+        for (int i = 0; i < sizeof(double); ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    // Convert hash into hexadecimal string
+    char buffer[17];
+    std::sprintf(buffer, "%016llx", hash);
+
+    // Return signature
+    return (std::string(buffer));
+}
+
+
+/***********************************************************************//**
+ * @brief Return IRF cache normalisation of a diffuse model
+ *
+ * @param[in] model Diffuse model.
+ * @return Product of model parameter values.
+ *
+ * Returns the normalisation by which the IRF value of a diffuse model is
+ * divided before it is stored in the IRF cache, and by which the cached
+ * value is multiplied on lookup. As the parameters of diffuse models are
+ * normalisations, the IRF value is proportional to the product of the
+ * parameter values.
+ ***************************************************************************/
+double GCTAResponse::irf_cache_norm(const GModelSpatial& model) const
+{
+    // Compute product of parameter values
+    double norm = 1.0;
+    for (int i = 0; i < model.size(); ++i) {
+        norm *= model[i].value();
+    }
+
+    // Return normalisation
+    return norm;
+}
+
+
+/***********************************************************************//**
+ * @brief Return elliptical source IRF value and parameter gradients
+ *
+ * @param[in] event Observed event.
+ * @param[in] source Source.
+ * @param[in] obs Observation.
+ * @return IRF value.
+ *
+ * @exception GCTAException::bad_observation_type
+ *            Specified observation is not a CTA observations.
+ * @exception GCTAException::no_pointing
+ *            No valid CTA pointing found.
+ * @exception GCTAException::bad_instdir_type
+ *            Instrument direction is not a valid CTA instrument direction.
+ * @exception GCTAException::bad_model_type
+ *            Model is not an elliptical model.
+ *
+ * Computes the elliptical source IRF in the same way as irf_elliptical(),
+ * and integrates in the same pass the derivatives of the IRF with respect
+ * to a displacement of the model centre and to a rotation of the model
+ * around its centre (see cta_irf_elliptical_grad_kern_omega). The
+ * gradients of the remaining model parameters are computed numerically
+ * using GResponse::irf_gradient().
+ *
+ * As the position angle of the model is measured with respect to the
+ * local North direction, a displacement of the model centre towards East
+ * by \f$\epsilon\f$ at fixed position angle corresponds to a rigid
+ * displacement combined with a rotation by \f$-\epsilon \tan \delta_0\f$,
+ * hence
+ *
+ * \f[
+ *    \frac{\partial IRF}{\partial \alpha_0} = \cos \delta_0 \left(
+ *    \frac{\partial IRF}{\partial \epsilon_{\rm E}} - \tan \delta_0
+ *    \frac{\partial IRF}{\partial \alpha} \right)
+ * \f]
+ ***************************************************************************/
+double GCTAResponse::irf_elliptical_gradients(const GEvent&       event,
+                                              const GSource&      source,
+                                              const GObservation& obs) const
+{
+    // Get pointer on CTA observation
+    const GCTAObservation* ctaobs = dynamic_cast<const GCTAObservation*>(&obs);
+    if (ctaobs == NULL) {
+        throw GCTAException::bad_observation_type(G_IRF_ELLIPTICAL_GRADIENTS);
+    }
+
+    // Get pointer on CTA pointing
+    const GCTAPointing *pnt = ctaobs->pointing();
+    if (pnt == NULL) {
+        throw GCTAException::no_pointing(G_IRF_ELLIPTICAL_GRADIENTS);
+    }
+
+    // Get pointer on CTA instrument direction
+    const GCTAInstDir* dir = dynamic_cast<const GCTAInstDir*>(&(event.dir()));
+    if (dir == NULL) {
+        throw GCTAException::bad_instdir_type(G_IRF_ELLIPTICAL_GRADIENTS);
+    }
+
+    // Get non-const pointer on elliptical model (circumvent const
+    // correctness)
+    GModelSpatialElliptical* model =
+        dynamic_cast<GModelSpatialElliptical*>(const_cast<GModelSpatial*>(source.model()));
+    if (model == NULL) {
+        throw GCTAException::bad_model_type(G_IRF_ELLIPTICAL_GRADIENTS);
+    }
+
+    // Get event attributes
+    const GSkyDir& obsDir = dir->dir();
+    const GEnergy& obsEng = event.energy();
+
+    // Get source attributes
+    GSkyDir        centre  = model->dir();
+    const GEnergy& srcEng  = source.energy();
+    const GTime&   srcTime = source.time();
+
+    // Get pointing direction zenith angle and azimuth [radians]
+    double zenith  = pnt->zenith();
+    double azimuth = pnt->azimuth();
+
+    // Determine angular distances between model centre and measured photon
+    // direction, between model centre and pointing direction, and between
+    // measured photon direction and pointing direction [radians]
+    double zeta   = centre.dist(obsDir);
+    double lambda = centre.dist(pnt->dir());
+    double eta    = pnt->dir().dist(obsDir);
+
+    // Determine position angle of measured photon direction and azimuth
+    // angle of pointing in model system [radians]
+    double obsOmega = centre.posang(obsDir);
+    double omega0   = centre.posang(pnt->dir()) - obsOmega;
+
+    // Get log10(E/TeV) of true and measured photon energies
+    double srcLogEng = srcEng.log10TeV();
+    double obsLogEng = obsEng.log10TeV();
+
+    // Get maximum PSF and source radius in radians (see irf_elliptical)
+    double theta     = eta;
+    double phi       = 0.0; //TODO: Implement IRF Phi dependence
+    double delta_max = psf_delta_max(theta, phi, zenith, azimuth, srcLogEng);
+    double src_max   = model->theta_max();
+
+    // Set elliptical model zenith angle range
+    double rho_min = (zeta > delta_max) ? zeta - delta_max : 0.0;
+    double rho_max = zeta + delta_max;
+    if (rho_max > src_max) {
+        rho_max = src_max;
+    }
+
+    // Initialise IRF value and gradients
+    GVector irf(4);
+
+    // Perform zenith angle integration if interval is valid
+    if (rho_max > rho_min) {
+
+        // Setup integration kernel
+        cta_irf_elliptical_grad_kern_rho integrand(*this,
+                                                   *model,
+                                                   zenith,
+                                                   azimuth,
+                                                   srcEng,
+                                                   srcTime,
+                                                   srcLogEng,
+                                                   obsLogEng,
+                                                   zeta,
+                                                   lambda,
+                                                   obsOmega,
+                                                   omega0,
+                                                   delta_max);
+
+        // Integrate over zenith angle
+        GIntegrals integral(&integrand);
+        integral.eps(m_eps);
+        irf = integral.gkq(rho_min, rho_max);
+
+    } // endif: zenith angle interval was valid
+
+    // Apply deadtime correction
+    irf *= obs.deadc(srcTime);
+
+    // Set position and position angle gradients
+    double     cos_dec0 = std::cos(centre.dec());
+    double     tan_dec0 = std::tan(centre.dec());
+    GModelPar& ra       = (*model)[0];
+    GModelPar& dec      = (*model)[1];
+    GModelPar& posangle = (*model)[2];
+    ra.factor_gradient((ra.isfree())
+                       ? (irf[2] - tan_dec0 * irf[3]) * cos_dec0 *
+                         gammalib::deg2rad * ra.scale() : 0.0);
+    dec.factor_gradient((dec.isfree())
+                        ? irf[1] * gammalib::deg2rad * dec.scale() : 0.0);
+    posangle.factor_gradient((posangle.isfree())
+                             ? irf[3] * gammalib::deg2rad * posangle.scale()
+                             : 0.0);
+
+    // Set gradients of remaining model parameters
+    for (int i = 3; i < model->size(); ++i) {
+        GModelPar& par  = (*model)[i];
+        double     grad = (par.isfree()) ? irf_gradient(event, source, obs, i)
+                                         : 0.0;
+        par.factor_gradient(grad);
+    }
+
+    // Return IRF value
+    return irf[0];
+}
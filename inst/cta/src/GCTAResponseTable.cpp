@@ -216,13 +216,13 @@ std::vector<double> GCTAResponseTable::operator()(const double& arg) const
     // Initialise result vector
     std::vector<double> result(num);
     
-    // Set indices and weighting factors for interpolation
-    update(arg);
+    // Get indices and weighting factors for interpolation
+    GNodeArray::handle h = m_axis_nodes[0].locate(arg);
 
     // Perform 1D interpolation
     for (int i = 0; i < num; ++i) {
-        result[i] = m_wgt_left  * m_pars[i][m_inx_left] +
-                    m_wgt_right * m_pars[i][m_inx_right];
+        result[i] = h.wgt_left()  * m_pars[i][h.inx_left()] +
+                    h.wgt_right() * m_pars[i][h.inx_right()];
     }
     
     // Return result vector
@@ -264,15 +264,17 @@ std::vector<double> GCTAResponseTable::operator()(const double& arg1,
     // Initialise result vector
     std::vector<double> result(num);
 
-    // Set indices and weighting factors for interpolation
-    update(arg1, arg2);
+    // Get indices and weighting factors for interpolation
+    int    inx[4];
+    double wgt[4];
+    weights(arg1, arg2, inx, wgt);
 
     // Perform 2D interpolation
     for (int i = 0; i < num; ++i) {
-        result[i] = m_wgt1 * m_pars[i][m_inx1] +
-                    m_wgt2 * m_pars[i][m_inx2] +
-                    m_wgt3 * m_pars[i][m_inx3] +
-                    m_wgt4 * m_pars[i][m_inx4];
+        result[i] = wgt[0] * m_pars[i][inx[0]] +
+                    wgt[1] * m_pars[i][inx[1]] +
+                    wgt[2] * m_pars[i][inx[2]] +
+                    wgt[3] * m_pars[i][inx[3]];
     }
     
     // Return result vector
@@ -307,12 +309,12 @@ double GCTAResponseTable::operator()(const int& index, const double& arg) const
     }
     #endif
     
-    // Set indices and weighting factors for interpolation
-    update(arg);
+    // Get indices and weighting factors for interpolation
+    GNodeArray::handle h = m_axis_nodes[0].locate(arg);
 
     // Perform 1D interpolation
-    double result = m_wgt_left  * m_pars[index][m_inx_left] +
-                    m_wgt_right * m_pars[index][m_inx_right];
+    double result = h.wgt_left()  * m_pars[index][h.inx_left()] +
+                    h.wgt_right() * m_pars[index][h.inx_right()];
     
     // Return result
     return result;
@@ -348,14 +350,16 @@ double GCTAResponseTable::operator()(const int& index, const double& arg1,
     }
     #endif
 
-    // Set indices and weighting factors for interpolation
-    update(arg1, arg2);
+    // Get indices and weighting factors for interpolation
+    int    inx[4];
+    double wgt[4];
+    weights(arg1, arg2, inx, wgt);
 
     // Perform 2D interpolation
-    double result = m_wgt1 * m_pars[index][m_inx1] +
-                    m_wgt2 * m_pars[index][m_inx2] +
-                    m_wgt3 * m_pars[index][m_inx3] +
-                    m_wgt4 * m_pars[index][m_inx4];
+    double result = wgt[0] * m_pars[index][inx[0]] +
+                    wgt[1] * m_pars[index][inx[1]] +
+                    wgt[2] * m_pars[index][inx[2]] +
+                    wgt[3] * m_pars[index][inx[3]];
     
     // Return result
     return result;
@@ -849,20 +853,6 @@ void GCTAResponseTable::init_members(void)
     m_axis_nodes.clear();
     m_pars.clear();
 
-    // Initialise cache
-    m_inx_left  = 0;
-    m_inx_right = 0;
-    m_wgt_left  = 0.0;
-    m_wgt_right = 0.0;
-    m_inx1      = 0;
-    m_inx2      = 0;
-    m_inx3      = 0;
-    m_inx4      = 0;
-    m_wgt1      = 0.0;
-    m_wgt2      = 0.0;
-    m_wgt3      = 0.0;
-    m_wgt4      = 0.0;
-
     // Return
     return;
 }
@@ -889,20 +879,6 @@ void GCTAResponseTable::copy_members(const GCTAResponseTable& table)
     m_axis_nodes  = table.m_axis_nodes;
     m_pars        = table.m_pars;
 
-    // Copy cache
-    m_inx_left  = table.m_inx_left;
-    m_inx_right = table.m_inx_right;
-    m_wgt_left  = table.m_wgt_left;
-    m_wgt_right = table.m_wgt_right;
-    m_inx1      = table.m_inx1;
-    m_inx2      = table.m_inx2;
-    m_inx3      = table.m_inx3;
-    m_inx4      = table.m_inx4;
-    m_wgt1      = table.m_wgt1;
-    m_wgt2      = table.m_wgt2;
-    m_wgt3      = table.m_wgt3;
-    m_wgt4      = table.m_wgt4;
-
     // Return
     return;
 }
@@ -1224,78 +1200,43 @@ void GCTAResponseTable::read_pars(const GFitsTable* hdu)
 
 
 /***********************************************************************//**
- * @brief Update 1D cache
- *
- * @param[in] arg Argument.
- *
- * Updates the 1D interpolation cache. The interpolation cache is composed
- * of two indices and weights that define 2 data values of the 2D table
- * that are used for linear interpolation.
- *
- * @todo Write down formula
- *
- * @todo Makes GNodeArray::set_value method const and use mutable members
- ***************************************************************************/
-void GCTAResponseTable::update(const double& arg) const
-{
-    // Get pointer to node array (circumvent const correctness)
-    GNodeArray* nodes = const_cast<GNodeArray*>(&(m_axis_nodes[0]));
-
-    // Set value for node array
-    nodes->set_value(arg);
-
-    // Set indices and weighting factors for interpolation
-    m_inx_left  = nodes->inx_left();
-    m_inx_right = nodes->inx_right();
-    m_wgt_left  = nodes->wgt_left();
-    m_wgt_right = nodes->wgt_right();
-    
-    // Return
-    return;
-}
-
-
-/***********************************************************************//**
- * @brief Update 2D cache
+ * @brief Compute indices and weights for bilinear interpolation
  *
  * @param[in] arg1 Argument for first axis.
  * @param[in] arg2 Argument for second axis.
- *
- * Updates the 2D interpolation cache. The interpolation cache is composed
- * of four indices and weights that define 4 data values of the 2D table
- * that are used for bilinear interpolation.
- *
- * @todo Write down formula
- *
- * @todo Makes GNodeArray::set_value method const and use mutable members
+ * @param[out] inx Indices of the 4 data values (array of 4 elements).
+ * @param[out] wgt Weights of the 4 data values (array of 4 elements).
+ *
+ * Computes the four indices and weights that define the 4 data values of
+ * the 2D table that are used for bilinear interpolation. The indices are
+ * ordered upper left, lower left, upper right and lower right. The method
+ * does not modify the response table and may therefore be called
+ * concurrently by several threads.
  ***************************************************************************/
-void GCTAResponseTable::update(const double& arg1, const double& arg2) const
+void GCTAResponseTable::weights(const double& arg1, const double& arg2,
+                                int* inx, double* wgt) const
 {
-    // Get pointers to node arrays (circumvent const correctness)
-    GNodeArray* nodes1 = const_cast<GNodeArray*>(&(m_axis_nodes[0]));
-    GNodeArray* nodes2 = const_cast<GNodeArray*>(&(m_axis_nodes[1]));
-
-    // Set values for node arrays
-    nodes1->set_value(arg1);
-    nodes2->set_value(arg2);
+    // Get interpolation handles for both axes
+    GNodeArray::handle h1 = m_axis_nodes[0].locate(arg1);
+    GNodeArray::handle h2 = m_axis_nodes[1].locate(arg2);
 
     // Compute offsets
     int size1        = axis(0);
-    int offset_left  = nodes2->inx_left()  * size1;
-    int offset_right = nodes2->inx_right() * size1;
+    int offset_left  = h2.inx_left()  * size1;
+    int offset_right = h2.inx_right() * size1;
 
     // Set indices for bi-linear interpolation
-    m_inx1 = nodes1->inx_left()  + offset_left;
-    m_inx2 = nodes1->inx_left()  + offset_right;
-    m_inx3 = nodes1->inx_right() + offset_left;
-    m_inx4 = nodes1->inx_right() + offset_right;
+    inx[0] = h1.inx_left()  + offset_left;
+    inx[1] = h1.inx_left()  + offset_right;
+    inx[2] = h1.inx_right() + offset_left;
+    inx[3] = h1.inx_right() + offset_right;
 
     // Set weighting factors for bi-linear interpolation
-    m_wgt1 = nodes1->wgt_left()  * nodes2->wgt_left();
-    m_wgt2 = nodes1->wgt_left()  * nodes2->wgt_right();
-    m_wgt3 = nodes1->wgt_right() * nodes2->wgt_left();
-    m_wgt4 = nodes1->wgt_right() * nodes2->wgt_right();
-    
+    wgt[0] = h1.wgt_left()  * h2.wgt_left();
+    wgt[1] = h1.wgt_left()  * h2.wgt_right();
+    wgt[2] = h1.wgt_right() * h2.wgt_left();
+    wgt[3] = h1.wgt_right() * h2.wgt_right();
+
     // Return
     return;
 }
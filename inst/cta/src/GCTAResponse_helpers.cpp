@@ -34,6 +34,7 @@
 #include "GTools.hpp"
 #include "GMath.hpp"
 #include "GIntegral.hpp"
+#include "GIntegrals.hpp"
 #include "GVector.hpp"
 
 /* __ Method name definitions ____________________________________________ */
@@ -182,7 +183,7 @@ double cta_irf_radial_kern_rho::eval(double rho)
         // Integrate over phi
         GIntegral integral(&integrand);
         integral.eps(m_rsp.eps());
-        irf = integral.romb(omega_min, omega_max) * model * sin_rho;
+        irf = integral.gkq(omega_min, omega_max) * model * sin_rho;
 
         // Compile option: Check for NaN/Inf
         #if defined(G_NAN_CHECK)
@@ -339,7 +340,7 @@ double cta_npred_radial_kern_rho::eval(double rho)
 
         // Integrate over phi
         GIntegral integral(&integrand);
-        npred = integral.romb(omega_min, omega_max) * sin_rho * model;
+        npred = integral.gkq(omega_min, omega_max) * sin_rho * model;
 
         // Debug: Check for NaN
         #if defined(G_NAN_CHECK)
@@ -478,7 +479,7 @@ double cta_irf_elliptical_kern_rho::eval(double rho)
         // Integrate over phi
         GIntegral integral(&integrand);
         integral.eps(m_rsp.eps());
-        irf = integral.romb(omega_min, omega_max) * sin_rho;
+        irf = integral.gkq(omega_min, omega_max) * sin_rho;
 
         // Compile option: Check for NaN/Inf
         #if defined(G_NAN_CHECK)
@@ -643,7 +644,7 @@ double cta_npred_elliptical_kern_rho::eval(double rho)
 
         // Integrate over phi
         GIntegral integral(&integrand);
-        npred = integral.romb(omega_min, omega_max) * sin_rho;
+        npred = integral.gkq(omega_min, omega_max) * sin_rho;
 
         // Debug: Check for NaN
         #if defined(G_NAN_CHECK)
@@ -798,7 +799,7 @@ double cta_irf_diffuse_kern_theta::eval(double theta)
             // Integrate over phi
             GIntegral integral(&integrand);
             integral.eps(1.0e-2);
-            irf = integral.romb(0.0, gammalib::twopi) * psf * sin_theta;
+            irf = integral.gkq(0.0, gammalib::twopi) * psf * sin_theta;
 
             // Compile option: Check for NaN/Inf
             #if defined(G_NAN_CHECK)
@@ -936,8 +937,9 @@ double cta_irf_diffuse_kern_phi::eval(double phi)
  * integration is only performed for positive offset angles, otherwise 0 is
  * returned.
  *
- * Integration is done using the Romberg algorithm. The integration kernel
- * is defined by the helper class cta_npred_diffuse_kern_phi.
+ * Integration is done using adaptive Gauss-Kronrod quadrature. The
+ * integration kernel is defined by the helper class
+ * cta_npred_diffuse_kern_phi.
  *
  * Note that the integration precision was adjusted trading-off between
  * computation time and computation precision. A value of 1e-4 was judged
@@ -967,7 +969,7 @@ double cta_npred_diffuse_kern_theta::eval(double theta)
         // Integrate over phi
         GIntegral integral(&integrand);
         integral.eps(1.0e-4);
-        npred = integral.romb(0.0, gammalib::twopi) * sin_theta;
+        npred = integral.gkq(0.0, gammalib::twopi) * sin_theta;
 
         // Debug: Check for NaN
         #if defined(G_NAN_CHECK)
@@ -1051,3 +1053,318 @@ double cta_npred_diffuse_kern_phi::eval(double phi)
     // Return Npred
     return npred;
 }
+
+
+/***********************************************************************//**
+ * @brief Kernel for radial model zenith angle integration of IRF gradients
+ *
+ * @param[in] rho Zenith angle with respect to model centre [radians].
+ * @return Kernel values.
+ *
+ * Computes the kernels for the zenith angle integration of the IRF value
+ * and of the IRF gradients of radial models. The azimuthal integration of
+ * all kernels is performed in a single pass over the azimuth angle.
+ ***************************************************************************/
+GVector cta_irf_radial_grad_kern_rho::eval(const double& rho)
+{
+    // Initialise result
+    GVector result(size());
+
+    // Compute half length of arc that lies within PSF validity circle
+    // (in radians)
+    double domega = 0.5 * gammalib::cta_roi_arclength(rho,
+                                                      m_zeta,
+                                                      m_cos_zeta,
+                                                      m_sin_zeta,
+                                                      m_delta_max,
+                                                      m_cos_delta_max);
+
+    // Continue only if arc length is positive
+    if (domega > 0.0) {
+
+        // Evaluate sky model and set model gradients
+        double model = m_model.eval_gradients(rho, m_srcEng, m_srcTime);
+
+        // Setup integration kernel
+        cta_irf_radial_grad_kern_omega integrand(m_rsp,
+                                                 m_zenith,
+                                                 m_azimuth,
+                                                 m_srcLogEng,
+                                                 m_obsLogEng,
+                                                 m_obsOmega,
+                                                 m_omega0,
+                                                 rho,
+                                                 m_cos_zeta,
+                                                 m_sin_zeta,
+                                                 m_cos_lambda,
+                                                 m_sin_lambda);
+
+        // Integrate over omega
+        GIntegrals integral(&integrand);
+        integral.eps(m_rsp.eps());
+        GVector irf = integral.gkq(-domega, domega) * std::sin(rho);
+
+        // Set IRF value and position gradient kernels
+        result[0] = irf[0] * model;
+        result[1] = irf[1] * model;
+        result[2] = irf[2] * model;
+
+        // Set model parameter gradient kernels
+        for (int i = 0; i < m_pars.size(); ++i) {
+            result[3+i] = irf[0] * m_model[m_pars[i]].factor_gradient();
+        }
+
+        // Compile option: Check for NaN/Inf
+        #if defined(G_NAN_CHECK)
+        if (gammalib::isnotanumber(result[0]) || gammalib::isinfinite(result[0])) {
+            std::cout << "*** ERROR: cta_irf_radial_grad_kern_rho";
+            std::cout << "(rho=" << rho << "):";
+            std::cout << " NaN/Inf encountered";
+            std::cout << " (irf=" << result[0];
+            std::cout << ", domega=" << domega;
+            std::cout << ", model=" << model << ")";
+            std::cout << std::endl;
+        }
+        #endif
+
+    } // endif: arc length was positive
+
+    // Return result
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Kernel for radial model azimuth angle integration of IRF gradients
+ *
+ * @param[in] omega Azimuth angle (radians).
+ * @return IRF value and IRF derivatives for a displacement of the model
+ *         centre towards North and East.
+ ***************************************************************************/
+GVector cta_irf_radial_grad_kern_omega::eval(const double& omega)
+{
+    // Initialise result
+    GVector result(size());
+
+    // Compute IRF value and derivatives
+    result[0] = irf(omega, &result[1], &result[2], NULL);
+
+    // Return result
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Initialise precomputed terms for azimuth angle integration
+ *
+ * @param[in] rho Zenith angle with respect to model centre [radians].
+ * @param[in] cos_zeta Cosine of distance model centre - measured photon.
+ * @param[in] sin_zeta Sine of distance model centre - measured photon.
+ * @param[in] cos_lambda Cosine of distance model centre - pointing.
+ * @param[in] sin_lambda Sine of distance model centre - pointing.
+ ***************************************************************************/
+void cta_irf_radial_grad_kern_omega::init(const double& rho,
+                                          const double& cos_zeta,
+                                          const double& sin_zeta,
+                                          const double& cos_lambda,
+                                          const double& sin_lambda)
+{
+    // Compute position angle of pointing seen from model centre
+    double phi_pnt = m_obsOmega + m_omega0;
+
+    // Precompute cosine and sine terms for azimuthal integration
+    double cos_rho = std::cos(rho);
+    double sin_rho = std::sin(rho);
+    m_cos_psf      = cos_rho * cos_zeta;
+    m_sin_psf      = sin_rho * sin_zeta;
+    m_cos_ph       = cos_rho * cos_lambda;
+    m_sin_ph       = sin_rho * sin_lambda;
+
+    // Precompute terms for offset angle derivatives
+    m_psf_a = sin_rho  * cos_zeta;
+    m_psf_n = cos_rho  * sin_zeta * std::cos(m_obsOmega);
+    m_psf_e = cos_rho  * sin_zeta * std::sin(m_obsOmega);
+    m_ph_a  = sin_rho  * cos_lambda;
+    m_ph_n  = cos_rho  * sin_lambda * std::cos(phi_pnt);
+    m_ph_e  = cos_rho  * sin_lambda * std::sin(phi_pnt);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return IRF value and its derivatives in model system
+ *
+ * @param[in] omega Azimuth angle (radians).
+ * @param[out] d_north Derivative for a displacement towards North.
+ * @param[out] d_east Derivative for a displacement towards East.
+ * @param[out] d_rot Derivative for a rotation around model centre (or NULL).
+ * @return IRF value.
+ *
+ * Computes the IRF for a true photon direction at a distance \f$\rho\f$
+ * and position angle \f$\phi = \phi_{\rm e} + \omega\f$ from the model
+ * centre, where \f$\phi_{\rm e}\f$ is the position angle of the measured
+ * photon direction. Displacing the model centre by an angle \f$\epsilon\f$
+ * towards the position angle \f$\beta\f$ displaces the true photon
+ * direction rigidly, which changes the PSF offset angle \f$\delta\f$ by
+ *
+ * \f[
+ *    \frac{\partial \delta}{\partial \epsilon} =
+ *    \frac{\cos \zeta \sin \rho \cos(\phi - \beta) -
+ *          \sin \zeta \cos \rho \cos(\phi_{\rm e} - \beta)}{\sin \delta}
+ * \f]
+ *
+ * and the offset angle \f$\theta\f$ by the same expression with
+ * \f$\zeta\f$ and \f$\phi_{\rm e}\f$ replaced by the distance and position
+ * angle of the pointing. North and East correspond to \f$\beta=0\f$ and
+ * \f$\beta=\pi/2\f$, respectively. A rotation by \f$\alpha\f$ around the
+ * model centre changes \f$\delta\f$ by
+ * \f$\partial \delta / \partial \alpha =
+ *    \sin \rho \sin \zeta \sin \omega / \sin \delta\f$.
+ ***************************************************************************/
+double cta_irf_radial_grad_kern_omega::irf(const double& omega,
+                                           double*       d_north,
+                                           double*       d_east,
+                                           double*       d_rot) const
+{
+    // Compute PSF offset angle [radians]
+    double delta = gammalib::acos(m_cos_psf + m_sin_psf * std::cos(omega));
+
+    // Compute true photon offset angle in camera system [radians]
+    double theta = gammalib::acos(m_cos_ph + m_sin_ph * std::cos(m_omega0 - omega));
+
+    //TODO: Compute true photon azimuth angle in camera system [radians]
+    double phi = 0.0;
+
+    // Evaluate IRF and its partial derivatives
+    double d_delta = 0.0;
+    double d_theta = 0.0;
+    double irf     = gammalib::cta_irf_partials(m_rsp, delta, theta, phi,
+                                                m_zenith, m_azimuth,
+                                                m_srcLogEng, m_obsLogEng,
+                                                &d_delta, &d_theta);
+
+    // Compute position angle of true photon direction
+    double cos_phi = std::cos(m_obsOmega + omega);
+    double sin_phi = std::sin(m_obsOmega + omega);
+
+    // Initialise derivatives
+    *d_north = 0.0;
+    *d_east  = 0.0;
+    if (d_rot != NULL) {
+        *d_rot = 0.0;
+    }
+
+    // Add PSF offset angle derivatives
+    double sin_delta = std::sin(delta);
+    if (sin_delta > 0.0) {
+        double norm = d_delta / sin_delta;
+        *d_north   += norm * (m_psf_a * cos_phi - m_psf_n);
+        *d_east    += norm * (m_psf_a * sin_phi - m_psf_e);
+        if (d_rot != NULL) {
+            *d_rot += norm * m_sin_psf * std::sin(omega);
+        }
+    }
+
+    // Add offset angle derivatives
+    double sin_theta = std::sin(theta);
+    if (sin_theta > 0.0) {
+        double norm = d_theta / sin_theta;
+        *d_north   += norm * (m_ph_a * cos_phi - m_ph_n);
+        *d_east    += norm * (m_ph_a * sin_phi - m_ph_e);
+        if (d_rot != NULL) {
+            *d_rot += norm * m_sin_ph * std::sin(omega - m_omega0);
+        }
+    }
+
+    // Return IRF value
+    return irf;
+}
+
+
+/***********************************************************************//**
+ * @brief Kernel for elliptical model zenith angle integration of IRF
+ *        gradients
+ *
+ * @param[in] rho Zenith angle with respect to model centre [radians].
+ * @return Kernel values.
+ ***************************************************************************/
+GVector cta_irf_elliptical_grad_kern_rho::eval(const double& rho)
+{
+    // Initialise result
+    GVector result(size());
+
+    // Compute half length of arc that lies within PSF validity circle
+    // (in radians)
+    double domega = 0.5 * gammalib::cta_roi_arclength(rho,
+                                                      m_zeta,
+                                                      m_cos_zeta,
+                                                      m_sin_zeta,
+                                                      m_delta_max,
+                                                      m_cos_delta_max);
+
+    // Continue only if arc length is positive
+    if (domega > 0.0) {
+
+        // Setup integration kernel
+        cta_irf_elliptical_grad_kern_omega integrand(m_rsp,
+                                                     m_model,
+                                                     m_zenith,
+                                                     m_azimuth,
+                                                     m_srcEng,
+                                                     m_srcTime,
+                                                     m_srcLogEng,
+                                                     m_obsLogEng,
+                                                     m_obsOmega,
+                                                     m_omega0,
+                                                     rho,
+                                                     m_cos_zeta,
+                                                     m_sin_zeta,
+                                                     m_cos_lambda,
+                                                     m_sin_lambda);
+
+        // Integrate over omega
+        GIntegrals integral(&integrand);
+        integral.eps(m_rsp.eps());
+        result = integral.gkq(-domega, domega) * std::sin(rho);
+
+    } // endif: arc length was positive
+
+    // Return result
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Kernel for elliptical model azimuth angle integration of IRF
+ *        gradients
+ *
+ * @param[in] omega Azimuth angle (radians).
+ * @return Model times IRF value and its derivatives for a displacement of
+ *         the model centre towards North and East, and for a rotation
+ *         around the model centre.
+ ***************************************************************************/
+GVector cta_irf_elliptical_grad_kern_omega::eval(const double& omega)
+{
+    // Initialise result
+    GVector result(size());
+
+    // Evaluate sky model
+    double model = m_model.eval(m_rho, omega + m_obsOmega, m_srcEng, m_srcTime);
+
+    // Continue only if model is positive
+    if (model > 0.0) {
+
+        // Compute IRF value and derivatives
+        result[0] = irf(omega, &result[1], &result[2], &result[3]);
+
+        // Multiply by model
+        result *= model;
+
+    } // endif: model was positive
+
+    // Return result
+    return result;
+}
+
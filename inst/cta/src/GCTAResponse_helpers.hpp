@@ -29,6 +29,7 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <cmath>
+#include <vector>
 #include "GCTAResponse.hpp"
 #include "GCTAObservation.hpp"
 #include "GMatrix.hpp"
@@ -37,6 +38,8 @@
 #include "GModelSpatialRadial.hpp"
 #include "GModelSpatialElliptical.hpp"
 #include "GFunction.hpp"
+#include "GFunctions.hpp"
+#include "GVector.hpp"
 
 /* __ Type definitions ___________________________________________________ */
 
@@ -889,4 +892,305 @@ protected:
     const double&          m_sin_theta;  //!< Sine of offset angle
 };
 
+
+/***********************************************************************//**
+ * @class cta_irf_radial_grad_kern_rho
+ *
+ * @brief Kernel for radial model zenith angle integration of IRF gradients
+ *
+ * This class implements the integration kernels for the simultaneous
+ * computation of the IRF of a radial model and of its partial derivatives
+ * with respect to the model parameters. The eval() method computes
+ *
+ * \f[
+ *    K_0(\rho | E, t) = \sin \rho \times S_{\rm p}(\rho | E, t) \times
+ *                       \int_{\omega_{\rm min}}^{\omega_{\rm max}}
+ *                       IRF(\rho, \omega) d\omega
+ * \f]
+ *
+ * as first kernel, followed by the kernels for the derivatives with respect
+ * to a displacement of the model centre towards North and East (see
+ * cta_irf_radial_grad_kern_omega), followed by the kernels
+ *
+ * \f[
+ *    K_i(\rho | E, t) = \sin \rho \times
+ *                       \frac{\partial S_{\rm p}(\rho | E, t)}{\partial p_i}
+ *                       \times
+ *                       \int_{\omega_{\rm min}}^{\omega_{\rm max}}
+ *                       IRF(\rho, \omega) d\omega
+ * \f]
+ *
+ * for all model parameters \f$p_i\f$ specified by the parameter index
+ * vector.
+ ***************************************************************************/
+class cta_irf_radial_grad_kern_rho : public GFunctions {
+public:
+    cta_irf_radial_grad_kern_rho(const GCTAResponse&        rsp,
+                                 const GModelSpatialRadial& model,
+                                 const std::vector<int>&    pars,
+                                 const double&              zenith,
+                                 const double&              azimuth,
+                                 const GEnergy&             srcEng,
+                                 const GTime&               srcTime,
+                                 const double&              srcLogEng,
+                                 const double&              obsLogEng,
+                                 const double&              zeta,
+                                 const double&              lambda,
+                                 const double&              obsOmega,
+                                 const double&              omega0,
+                                 const double&              delta_max) :
+                                 m_rsp(rsp),
+                                 m_model(model),
+                                 m_pars(pars),
+                                 m_zenith(zenith),
+                                 m_azimuth(azimuth),
+                                 m_srcEng(srcEng),
+                                 m_srcTime(srcTime),
+                                 m_srcLogEng(srcLogEng),
+                                 m_obsLogEng(obsLogEng),
+                                 m_zeta(zeta),
+                                 m_cos_zeta(std::cos(zeta)),
+                                 m_sin_zeta(std::sin(zeta)),
+                                 m_lambda(lambda),
+                                 m_cos_lambda(std::cos(lambda)),
+                                 m_sin_lambda(std::sin(lambda)),
+                                 m_obsOmega(obsOmega),
+                                 m_omega0(omega0),
+                                 m_delta_max(delta_max),
+                                 m_cos_delta_max(std::cos(delta_max)) { }
+    int     size(void) const { return 3+int(m_pars.size()); }
+    GVector eval(const double& rho);
+protected:
+    const GCTAResponse&        m_rsp;           //!< CTA response
+    const GModelSpatialRadial& m_model;         //!< Radial spatial model
+    const std::vector<int>&    m_pars;          //!< Indices of parameters with model gradients
+    const double&              m_zenith;        //!< Zenith angle
+    const double&              m_azimuth;       //!< Azimuth angle
+    const GEnergy&             m_srcEng;        //!< True photon energy
+    const GTime&               m_srcTime;       //!< True photon time
+    const double&              m_srcLogEng;     //!< True photon log10 energy
+    const double&              m_obsLogEng;     //!< Measured photon energy
+    const double&              m_zeta;          //!< Distance model centre - measured photon
+    double                     m_cos_zeta;      //!< Cosine of zeta
+    double                     m_sin_zeta;      //!< Sine of zeta
+    const double&              m_lambda;        //!< Distance model centre - pointing
+    double                     m_cos_lambda;    //!< Cosine of lambda
+    double                     m_sin_lambda;    //!< Sine of lambda
+    const double&              m_obsOmega;      //!< Position angle of measured photon
+    const double&              m_omega0;        //!< Azimuth of pointing in model system
+    const double&              m_delta_max;     //!< Maximum PSF radius
+    double                     m_cos_delta_max; //!< Cosine of maximum PSF radius
+};
+
+
+/***********************************************************************//**
+ * @class cta_irf_radial_grad_kern_omega
+ *
+ * @brief Kernel for radial model azimuth angle integration of IRF gradients
+ *
+ * This class implements the computation of the IRF in the reference frame
+ * of the radial source model, and of its partial derivatives with respect
+ * to a displacement of the model centre by an angle \f$\epsilon\f$ towards
+ * North and East. The eval() method computes
+ *
+ * \f[
+ *    IRF(\rho, \omega), \quad
+ *    \frac{\partial IRF}{\partial \delta}
+ *    \frac{\partial \delta}{\partial \epsilon_{\rm N}} +
+ *    \frac{\partial IRF}{\partial \theta}
+ *    \frac{\partial \theta}{\partial \epsilon_{\rm N}}, \quad
+ *    \frac{\partial IRF}{\partial \delta}
+ *    \frac{\partial \delta}{\partial \epsilon_{\rm E}} +
+ *    \frac{\partial IRF}{\partial \theta}
+ *    \frac{\partial \theta}{\partial \epsilon_{\rm E}}
+ * \f]
+ *
+ * where the true photon direction \f$(\rho, \omega)\f$ is displaced
+ * together with the model centre.
+ ***************************************************************************/
+class cta_irf_radial_grad_kern_omega : public GFunctions {
+public:
+    cta_irf_radial_grad_kern_omega(const GCTAResponse& rsp,
+                                   const double&       zenith,
+                                   const double&       azimuth,
+                                   const double&       srcLogEng,
+                                   const double&       obsLogEng,
+                                   const double&       obsOmega,
+                                   const double&       omega0,
+                                   const double&       rho,
+                                   const double&       cos_zeta,
+                                   const double&       sin_zeta,
+                                   const double&       cos_lambda,
+                                   const double&       sin_lambda) :
+                                   m_rsp(rsp),
+                                   m_zenith(zenith),
+                                   m_azimuth(azimuth),
+                                   m_srcLogEng(srcLogEng),
+                                   m_obsLogEng(obsLogEng),
+                                   m_obsOmega(obsOmega),
+                                   m_omega0(omega0) {
+        init(rho, cos_zeta, sin_zeta, cos_lambda, sin_lambda);
+    }
+    int     size(void) const { return 3; }
+    GVector eval(const double& omega);
+protected:
+    void    init(const double& rho,
+                 const double& cos_zeta,   const double& sin_zeta,
+                 const double& cos_lambda, const double& sin_lambda);
+    double  irf(const double& omega, double* d_north, double* d_east,
+                double* d_rot) const;
+    const GCTAResponse& m_rsp;         //!< CTA response
+    const double&       m_zenith;      //!< Zenith angle
+    const double&       m_azimuth;     //!< Azimuth angle
+    const double&       m_srcLogEng;   //!< True photon energy
+    const double&       m_obsLogEng;   //!< Measured photon energy
+    const double&       m_obsOmega;    //!< Position angle of measured photon
+    const double&       m_omega0;      //!< Azimuth of pointing in model system
+    double              m_cos_psf;     //!< Cosine term for PSF offset angle computation
+    double              m_sin_psf;     //!< Sine term for PSF offset angle computation
+    double              m_cos_ph;      //!< Cosine term for photon offset angle computation
+    double              m_sin_ph;      //!< Sine term for photon offset angle computation
+    double              m_psf_a;       //!< Photon term of PSF offset angle derivative
+    double              m_psf_n;       //!< Northern event term of PSF offset angle derivative
+    double              m_psf_e;       //!< Eastern event term of PSF offset angle derivative
+    double              m_ph_a;        //!< Photon term of offset angle derivative
+    double              m_ph_n;        //!< Northern pointing term of offset angle derivative
+    double              m_ph_e;        //!< Eastern pointing term of offset angle derivative
+};
+
+
+/***********************************************************************//**
+ * @class cta_irf_elliptical_grad_kern_rho
+ *
+ * @brief Kernel for elliptical model zenith angle integration of IRF
+ *        gradients
+ *
+ * This class implements the integration kernels for the simultaneous
+ * computation of the IRF of an elliptical model and of its partial
+ * derivatives with respect to a displacement of the model centre towards
+ * North and East and with respect to a rotation of the model around its
+ * centre. The eval() method computes
+ *
+ * \f[
+ *    K_i(\rho | E, t) = \sin \rho \times
+ *                       \int_{\omega_{\rm min}}^{\omega_{\rm max}}
+ *                       k_i(\rho, \omega | E, t) d\omega
+ * \f]
+ *
+ * where \f$k_i(\rho, \omega | E, t)\f$ are the kernels computed by
+ * cta_irf_elliptical_grad_kern_omega.
+ ***************************************************************************/
+class cta_irf_elliptical_grad_kern_rho : public GFunctions {
+public:
+    cta_irf_elliptical_grad_kern_rho(const GCTAResponse&            rsp,
+                                     const GModelSpatialElliptical& model,
+                                     const double&                  zenith,
+                                     const double&                  azimuth,
+                                     const GEnergy&                 srcEng,
+                                     const GTime&                   srcTime,
+                                     const double&                  srcLogEng,
+                                     const double&                  obsLogEng,
+                                     const double&                  zeta,
+                                     const double&                  lambda,
+                                     const double&                  obsOmega,
+                                     const double&                  omega0,
+                                     const double&                  delta_max) :
+                                     m_rsp(rsp),
+                                     m_model(model),
+                                     m_zenith(zenith),
+                                     m_azimuth(azimuth),
+                                     m_srcEng(srcEng),
+                                     m_srcTime(srcTime),
+                                     m_srcLogEng(srcLogEng),
+                                     m_obsLogEng(obsLogEng),
+                                     m_zeta(zeta),
+                                     m_cos_zeta(std::cos(zeta)),
+                                     m_sin_zeta(std::sin(zeta)),
+                                     m_lambda(lambda),
+                                     m_cos_lambda(std::cos(lambda)),
+                                     m_sin_lambda(std::sin(lambda)),
+                                     m_obsOmega(obsOmega),
+                                     m_omega0(omega0),
+                                     m_delta_max(delta_max),
+                                     m_cos_delta_max(std::cos(delta_max)) { }
+    int     size(void) const { return 4; }
+    GVector eval(const double& rho);
+protected:
+    const GCTAResponse&            m_rsp;           //!< CTA response
+    const GModelSpatialElliptical& m_model;         //!< Elliptical spatial model
+    const double&                  m_zenith;        //!< Zenith angle
+    const double&                  m_azimuth;       //!< Azimuth angle
+    const GEnergy&                 m_srcEng;        //!< True photon energy
+    const GTime&                   m_srcTime;       //!< True photon time
+    const double&                  m_srcLogEng;     //!< True photon log10 energy
+    const double&                  m_obsLogEng;     //!< Measured photon energy
+    const double&                  m_zeta;          //!< Distance model centre - measured photon
+    double                         m_cos_zeta;      //!< Cosine of zeta
+    double                         m_sin_zeta;      //!< Sine of zeta
+    const double&                  m_lambda;        //!< Distance model centre - pointing
+    double                         m_cos_lambda;    //!< Cosine of lambda
+    double                         m_sin_lambda;    //!< Sine of lambda
+    const double&                  m_obsOmega;      //!< Position angle of measured photon
+    const double&                  m_omega0;        //!< Azimuth of pointing in model system
+    const double&                  m_delta_max;     //!< Maximum PSF radius
+    double                         m_cos_delta_max; //!< Cosine of maximum PSF radius
+};
+
+
+/***********************************************************************//**
+ * @class cta_irf_elliptical_grad_kern_omega
+ *
+ * @brief Kernel for elliptical model azimuth angle integration of IRF
+ *        gradients
+ *
+ * This class implements the computation of the product of elliptical model
+ * and IRF in the reference frame of the model, and of its partial
+ * derivatives with respect to a displacement of the model centre by an
+ * angle \f$\epsilon\f$ towards North and East, and with respect to a
+ * rotation of the model by an angle \f$\alpha\f$ around its centre. The
+ * true photon direction \f$(\rho, \omega)\f$ is displaced (or rotated)
+ * together with the model, hence only the IRF needs to be differentiated.
+ ***************************************************************************/
+class cta_irf_elliptical_grad_kern_omega : public cta_irf_radial_grad_kern_omega {
+public:
+    cta_irf_elliptical_grad_kern_omega(const GCTAResponse&            rsp,
+                                       const GModelSpatialElliptical& model,
+                                       const double&                  zenith,
+                                       const double&                  azimuth,
+                                       const GEnergy&                 srcEng,
+                                       const GTime&                   srcTime,
+                                       const double&                  srcLogEng,
+                                       const double&                  obsLogEng,
+                                       const double&                  obsOmega,
+                                       const double&                  omega0,
+                                       const double&                  rho,
+                                       const double&                  cos_zeta,
+                                       const double&                  sin_zeta,
+                                       const double&                  cos_lambda,
+                                       const double&                  sin_lambda) :
+                                       cta_irf_radial_grad_kern_omega(rsp,
+                                                                      zenith,
+                                                                      azimuth,
+                                                                      srcLogEng,
+                                                                      obsLogEng,
+                                                                      obsOmega,
+                                                                      omega0,
+                                                                      rho,
+                                                                      cos_zeta,
+                                                                      sin_zeta,
+                                                                      cos_lambda,
+                                                                      sin_lambda),
+                                       m_model(model),
+                                       m_srcEng(srcEng),
+                                       m_srcTime(srcTime),
+                                       m_rho(rho) { }
+    int     size(void) const { return 4; }
+    GVector eval(const double& omega);
+protected:
+    const GModelSpatialElliptical& m_model;   //!< Elliptical spatial model
+    const GEnergy&                 m_srcEng;  //!< True photon energy
+    const GTime&                   m_srcTime; //!< True photon time
+    const double&                  m_rho;     //!< Distance from model centre
+};
+
 #endif /* GCTARESPONSE_HELPERS_HPP */
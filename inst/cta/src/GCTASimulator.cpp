@@ -0,0 +1,761 @@
+/***************************************************************************
+ *             GCTASimulator.cpp - CTA observation simulator class         *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTASimulator.cpp
+ * @brief CTA observation simulator class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <cmath>
+#include <vector>
+#include "GTools.hpp"
+#include "GException.hpp"
+#include "GRan.hpp"
+#include "GPhotons.hpp"
+#include "GModelSky.hpp"
+#include "GCTASimulator.hpp"
+#include "GCTAObservation.hpp"
+#include "GCTAResponse.hpp"
+#include "GCTAPointing.hpp"
+#include "GCTAEventList.hpp"
+#include "GCTAEventCube.hpp"
+#include "GCTAEventAtom.hpp"
+#include "GCTAModelRadialAcceptance.hpp"
+#include "GCTAException.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+#define G_AREA                                "GCTASimulator::area(double&)"
+#define G_MARGIN                            "GCTASimulator::margin(double&)"
+#define G_TSLICE                            "GCTASimulator::tslice(double&)"
+#define G_SIMULATE                   "GCTASimulator::simulate(GObservations&)"
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+
+/*==========================================================================
+ =                                                                         =
+ =                         Constructors/destructors                        =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GCTASimulator::GCTASimulator(void)
+{
+    // Initialise class members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Model constructor
+ *
+ * @param[in] models Models to simulate.
+ * @param[in] seed Random number generator seed (defaults to 41).
+ ***************************************************************************/
+GCTASimulator::GCTASimulator(const GModels& models,
+                             const unsigned long long int& seed)
+{
+    // Initialise class members
+    init_members();
+
+    // Set members
+    m_models = models;
+    m_seed   = seed;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] sim CTA observation simulator.
+ ***************************************************************************/
+GCTASimulator::GCTASimulator(const GCTASimulator& sim)
+{
+    // Initialise class members
+    init_members();
+
+    // Copy members
+    copy_members(sim);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GCTASimulator::~GCTASimulator(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                                Operators                                =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] sim CTA observation simulator.
+ * @return CTA observation simulator.
+ ***************************************************************************/
+GCTASimulator& GCTASimulator::operator=(const GCTASimulator& sim)
+{
+    // Execute only if object is not identical
+    if (this != &sim) {
+
+        // Free members
+        free_members();
+
+        // Initialise private members
+        init_members();
+
+        // Copy members
+        copy_members(sim);
+
+    } // endif: object was not identical
+
+    // Return this object
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear CTA observation simulator
+ ***************************************************************************/
+void GCTASimulator::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise private members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone CTA observation simulator
+ *
+ * @return Pointer to deep copy of CTA observation simulator.
+ ***************************************************************************/
+GCTASimulator* GCTASimulator::clone(void) const
+{
+    return new GCTASimulator(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Set models to simulate
+ *
+ * @param[in] models Models.
+ ***************************************************************************/
+void GCTASimulator::models(const GModels& models)
+{
+    // Set models
+    m_models = models;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set random number generator seed
+ *
+ * @param[in] seed Random number generator seed.
+ ***************************************************************************/
+void GCTASimulator::seed(const unsigned long long int& seed)
+{
+    // Set seed
+    m_seed = seed;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set simulation surface area
+ *
+ * @param[in] area Simulation surface area (cm2).
+ *
+ * @exception GException::invalid_argument
+ *            Simulation surface area is not positive.
+ *
+ * Sets the surface area on which photons are simulated. The area needs to
+ * be at least as large as the maximum effective area of the instrument.
+ ***************************************************************************/
+void GCTASimulator::area(const double& area)
+{
+    // Throw an exception if area is not positive
+    if (area <= 0.0) {
+        std::string msg = "Simulation surface area "+gammalib::str(area)+
+                          " cm2 is not positive.";
+        throw GException::invalid_argument(G_AREA, msg);
+    }
+
+    // Set area
+    m_area = area;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set simulation cone margin
+ *
+ * @param[in] margin Simulation cone margin (deg).
+ *
+ * @exception GException::invalid_argument
+ *            Simulation cone margin is negative.
+ *
+ * Sets the margin that is added to the radius of the simulation cone so
+ * that photons that are scattered into the data space by the point spread
+ * function are simulated.
+ ***************************************************************************/
+void GCTASimulator::margin(const double& margin)
+{
+    // Throw an exception if margin is negative
+    if (margin < 0.0) {
+        std::string msg = "Simulation cone margin "+gammalib::str(margin)+
+                          " deg is negative.";
+        throw GException::invalid_argument(G_MARGIN, msg);
+    }
+
+    // Set margin
+    m_margin = margin;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set time slice length
+ *
+ * @param[in] tslice Time slice length (sec).
+ *
+ * @exception GException::invalid_argument
+ *            Time slice length is negative.
+ *
+ * Sets the length of the time slices into which the good time intervals
+ * are split for the simulation of sky models. Each time slice is simulated
+ * as an independent work unit. A length of zero disables the splitting.
+ *
+ * Note that the simulated events depend on the time slice length, but not
+ * on the number of threads that are used for the simulation.
+ ***************************************************************************/
+void GCTASimulator::tslice(const double& tslice)
+{
+    // Throw an exception if time slice length is negative
+    if (tslice < 0.0) {
+        std::string msg = "Time slice length "+gammalib::str(tslice)+
+                          " sec is negative.";
+        throw GException::invalid_argument(G_TSLICE, msg);
+    }
+
+    // Set time slice length
+    m_tslice = tslice;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Simulate events for observations
+ *
+ * @param[in,out] obs Observations.
+ *
+ * @exception GException::invalid_value
+ *            Event list has no region of interest.
+ * @exception GCTAException::no_pointing
+ *            Observation has no pointing.
+ * @exception GCTAException::no_response
+ *            Observation has no response.
+ * @exception GCTAException::bad_event_type
+ *            Observation has an unsupported event type.
+ *
+ * Simulates the events of all CTA observations in the container and
+ * replaces the events of the observations by the simulated events. Non CTA
+ * observations are skipped.
+ *
+ * The simulation proceeds in three steps. First, the simulation cone is
+ * determined for each observation. The cone is centred on the pointing
+ * direction and encloses the region of interest of an event list, or all
+ * pixels of an event cube, plus the margin. Second, the work units are
+ * simulated in parallel. Each unit stores its events in a buffer of its
+ * own, events outside the data space are dropped. For an event cube only
+ * the sky direction and the energy bin of each event are kept. Third, the
+ * buffers are merged in the order of the work units into pre-sized event
+ * lists, or are binned into the counts cubes.
+ *
+ * Since the Monte Carlo methods of models and responses use internal
+ * caches, each thread works on its own copy of the models and responses.
+ ***************************************************************************/
+void GCTASimulator::simulate(GObservations& obs) const
+{
+    // Get number of observations and models
+    int nobs    = obs.size();
+    int nmodels = m_models.size();
+
+    // Allocate observation information
+    std::vector<const GCTAObservation*> cta(nobs, (const GCTAObservation*)NULL);
+    std::vector<const GCTAEventList*>   lists(nobs, (const GCTAEventList*)NULL);
+    std::vector<const GCTAEventCube*>   cubes(nobs, (const GCTAEventCube*)NULL);
+    std::vector<double>                 radii(nobs, 0.0);
+
+    // Determine simulation cones of all CTA observations
+    for (int i = 0; i < nobs; ++i) {
+
+        // Skip non CTA observations
+        const GCTAObservation* run = dynamic_cast<const GCTAObservation*>(obs[i]);
+        if (run == NULL) {
+            continue;
+        }
+
+        // Throw an exception if pointing or response are missing
+        if (run->pointing() == NULL) {
+            throw GCTAException::no_pointing(G_SIMULATE);
+        }
+        if (run->response() == NULL) {
+            throw GCTAException::no_response(G_SIMULATE);
+        }
+
+        // Get pointing direction
+        GSkyDir pnt = run->pointing()->dir();
+
+        // Case A: event list. The simulation cone encloses the ROI.
+        const GCTAEventList* list = dynamic_cast<const GCTAEventList*>(run->events());
+        const GCTAEventCube* cube = dynamic_cast<const GCTAEventCube*>(run->events());
+        if (list != NULL) {
+            if (list->roi().radius() <= 0.0) {
+                std::string msg = "Event list of observation "+
+                                  gammalib::str(i)+" has no region of"
+                                  " interest. Please specify a region of"
+                                  " interest for the simulation.";
+                throw GException::invalid_value(G_SIMULATE, msg);
+            }
+            radii[i] = list->roi().centre().dist_deg(pnt) +
+                       list->roi().radius() + m_margin;
+        }
+
+        // Case B: event cube. The simulation cone encloses all pixels.
+        else if (cube != NULL) {
+            int                 npix = cube->npix();
+            std::vector<int>    pixels(npix);
+            std::vector<double> ra(npix);
+            std::vector<double> dec(npix);
+            for (int k = 0; k < npix; ++k) {
+                pixels[k] = k;
+            }
+            double radius = 0.0;
+            if (npix > 0) {
+                cube->map().pix2dir(&(pixels[0]), npix, &(ra[0]), &(dec[0]));
+            }
+            for (int k = 0; k < npix; ++k) {
+                GSkyDir dir;
+                dir.radec_deg(ra[k], dec[k]);
+                double dist = pnt.dist_deg(dir);
+                if (dist > radius) {
+                    radius = dist;
+                }
+            }
+            radii[i] = radius + m_margin;
+        }
+
+        // ... otherwise throw an exception
+        else {
+            throw GCTAException::bad_event_type(G_SIMULATE,
+                  "Observation "+gammalib::str(i)+" contains neither a CTA"
+                  " event list nor a CTA event cube.");
+        }
+
+        // Store observation information
+        cta[i]   = run;
+        lists[i] = list;
+        cubes[i] = cube;
+
+    } // endfor: looped over observations
+
+    // Set up work units. Sky models are split into time slices, background
+    // models are simulated in a single unit per observation.
+    std::vector<int>   unit_obs;
+    std::vector<int>   unit_model;
+    std::vector<int>   unit_slice;
+    std::vector<GTime> unit_tmin;
+    std::vector<GTime> unit_tmax;
+    for (int i = 0; i < nobs; ++i) {
+        if (cta[i] == NULL) {
+            continue;
+        }
+        const GGti& gti = cta[i]->events()->gti();
+        for (int k = 0; k < nmodels; ++k) {
+            const GModel* model = m_models[k];
+            if (!model->isvalid(cta[i]->instrument(), cta[i]->id())) {
+                continue;
+            }
+            if (dynamic_cast<const GModelSky*>(model) != NULL) {
+                int slice = 0;
+                for (int igti = 0; igti < gti.size(); ++igti) {
+                    double tstart = gti.tstart(igti).secs();
+                    double tstop  = gti.tstop(igti).secs();
+                    int    nslice = 1;
+                    if (m_tslice > 0.0 && tstop > tstart) {
+                        nslice = int(std::ceil((tstop - tstart) / m_tslice));
+                    }
+                    double length = (tstop - tstart) / double(nslice);
+                    for (int islice = 0; islice < nslice; ++islice, ++slice) {
+                        GTime tmin = gti.tstart(igti);
+                        GTime tmax = gti.tstart(igti);
+                        tmin.secs(tstart + islice * length);
+                        tmax.secs((islice == nslice-1) ? tstop :
+                                  tstart + (islice+1) * length);
+                        unit_obs.push_back(i);
+                        unit_model.push_back(k);
+                        unit_slice.push_back(slice);
+                        unit_tmin.push_back(tmin);
+                        unit_tmax.push_back(tmax);
+                    }
+                }
+            }
+            else if (dynamic_cast<const GCTAModelRadialAcceptance*>(model) != NULL) {
+                unit_obs.push_back(i);
+                unit_model.push_back(k);
+                unit_slice.push_back(0);
+                unit_tmin.push_back(gti.tstart());
+                unit_tmax.push_back(gti.tstop());
+            }
+        } // endfor: looped over models
+    } // endfor: looped over observations
+
+    // Allocate event buffers for all work units
+    int                                     nunits = unit_obs.size();
+    std::vector<std::vector<GCTAEventAtom> > unit_events(nunits);
+    std::vector<std::vector<double> >       unit_ra(nunits);
+    std::vector<std::vector<double> >       unit_dec(nunits);
+    std::vector<std::vector<int> >          unit_ebin(nunits);
+
+    // Simulate work units in parallel
+    #pragma omp parallel
+    {
+        // Allocate thread copies of models and responses
+        GModels                    models(m_models);
+        std::vector<GCTAResponse*> responses(nobs, (GCTAResponse*)NULL);
+
+        // Dynamic scheduling balances the load since the number of events
+        // varies strongly between the work units
+        #pragma omp for schedule(dynamic)
+        for (int unit = 0; unit < nunits; ++unit) {
+
+            // Get work unit information
+            int                    i     = unit_obs[unit];
+            const GCTAObservation* run   = cta[i];
+            const GModel*          model = models[unit_model[unit]];
+            const GEbounds&        ebds  = run->events()->ebounds();
+            bool                   binned = (cubes[i] != NULL);
+
+            // Get random number stream of work unit
+            GRan ran = GRan(m_seed).stream(i).stream(unit_model[unit]).
+                                    stream(unit_slice[unit]);
+
+            // Get events of work unit
+            std::vector<GCTAEventAtom> events;
+            const GModelSky* sky = dynamic_cast<const GModelSky*>(model);
+            if (sky != NULL) {
+
+                // Get thread copy of response
+                if (responses[i] == NULL) {
+                    responses[i] = run->response()->clone();
+                }
+
+                // Simulate photons
+                GPhotons photons = sky->mc(m_area, run->pointing()->dir(),
+                                           radii[i],
+                                           ebds.emin(), ebds.emax(),
+                                           unit_tmin[unit], unit_tmax[unit],
+                                           ran);
+
+                // Detect photons
+                events.reserve(photons.size());
+                GCTAEventAtom event;
+                for (int k = 0; k < photons.size(); ++k) {
+                    if (responses[i]->mc(m_area, photons[k], *run, ran, event)) {
+                        events.push_back(event);
+                    }
+                }
+
+            } // endif: sky model
+            else {
+
+                // Simulate background events
+                const GCTAModelRadialAcceptance* bgd =
+                      static_cast<const GCTAModelRadialAcceptance*>(model);
+                GCTAEventList* list = bgd->mc(*run, ran);
+                events.reserve(list->size());
+                for (int k = 0; k < list->size(); ++k) {
+                    events.push_back(*((*list)[k]));
+                }
+                delete list;
+
+            } // endelse: background model
+
+            // Store events within data space. For an event cube, only the
+            // direction and energy bin are stored.
+            if (binned) {
+                unit_ra[unit].reserve(events.size());
+                unit_dec[unit].reserve(events.size());
+                unit_ebin[unit].reserve(events.size());
+                for (int k = 0; k < events.size(); ++k) {
+                    int ebin = ebds.index(events[k].energy());
+                    if (ebin >= 0) {
+                        GSkyDir dir = events[k].dir().dir();
+                        unit_ra[unit].push_back(dir.ra_deg());
+                        unit_dec[unit].push_back(dir.dec_deg());
+                        unit_ebin[unit].push_back(ebin);
+                    }
+                }
+            }
+            else {
+                const GCTARoi& roi = lists[i]->roi();
+                unit_events[unit].reserve(events.size());
+                for (int k = 0; k < events.size(); ++k) {
+                    if (ebds.contains(events[k].energy()) &&
+                        roi.centre().dist_deg(events[k].dir()) <= roi.radius()) {
+                        unit_events[unit].push_back(events[k]);
+                    }
+                }
+            }
+
+        } // endfor: looped over work units
+
+        // Free thread copies of responses
+        for (int i = 0; i < nobs; ++i) {
+            if (responses[i] != NULL) {
+                delete responses[i];
+            }
+        }
+
+    } // end pragma omp parallel
+
+    // Merge events of work units into observations
+    for (int i = 0; i < nobs; ++i) {
+
+        // Skip non CTA observations
+        if (cta[i] == NULL) {
+            continue;
+        }
+
+        // Case A: event list
+        if (lists[i] != NULL) {
+
+            // Setup event list with data space of observation
+            GCTAEventList list;
+            list.compact(lists[i]->compact());
+            list.roi(lists[i]->roi());
+            list.ebounds(lists[i]->ebounds());
+            list.gti(lists[i]->gti());
+
+            // Reserve space for all events
+            int number = 0;
+            for (int unit = 0; unit < nunits; ++unit) {
+                if (unit_obs[unit] == i) {
+                    number += unit_events[unit].size();
+                }
+            }
+            list.reserve(number);
+
+            // Append events
+            for (int unit = 0; unit < nunits; ++unit) {
+                if (unit_obs[unit] == i) {
+                    for (int k = 0; k < unit_events[unit].size(); ++k) {
+                        list.append(unit_events[unit][k]);
+                    }
+                    std::vector<GCTAEventAtom>().swap(unit_events[unit]);
+                }
+            }
+
+            // Set events
+            obs[i]->events(&list);
+
+        } // endif: event list
+
+        // Case B: event cube
+        else {
+
+            // Get empty counts map
+            GSkymap map   = cubes[i]->map();
+            int     npix  = map.npix();
+            int     nbins = npix * map.nmaps();
+            double* data  = map.pixels();
+            for (int k = 0; k < nbins; ++k) {
+                data[k] = 0.0;
+            }
+
+            // Bin events
+            for (int unit = 0; unit < nunits; ++unit) {
+                int number = unit_ra[unit].size();
+                if (unit_obs[unit] == i && number > 0) {
+                    std::vector<int> pixels(number);
+                    map.dir2pix(&(unit_ra[unit][0]), &(unit_dec[unit][0]),
+                                number, &(pixels[0]));
+                    for (int k = 0; k < number; ++k) {
+                        if (pixels[k] >= 0) {
+                            map(pixels[k], unit_ebin[unit][k]) += 1.0;
+                        }
+                    }
+                }
+            }
+
+            // Set events
+            GCTAEventCube cube(*(cubes[i]));
+            cube.map(map);
+            obs[i]->events(&cube);
+
+        } // endelse: event cube
+
+    } // endfor: looped over observations
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Print CTA observation simulator information
+ *
+ * @param[in] chatter Chattiness (defaults to NORMAL).
+ * @return String containing CTA observation simulator information.
+ ***************************************************************************/
+std::string GCTASimulator::print(const GChatter& chatter) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Continue only if chatter is not silent
+    if (chatter != SILENT) {
+
+        // Append header
+        result.append("=== GCTASimulator ===");
+
+        // Append information
+        result.append("\n"+gammalib::parformat("Number of models"));
+        result.append(gammalib::str(m_models.size()));
+        result.append("\n"+gammalib::parformat("Seed"));
+        result.append(gammalib::str(m_seed));
+        result.append("\n"+gammalib::parformat("Simulation area"));
+        result.append(gammalib::str(m_area)+" cm2");
+        result.append("\n"+gammalib::parformat("Simulation cone margin"));
+        result.append(gammalib::str(m_margin)+" deg");
+        result.append("\n"+gammalib::parformat("Time slice length"));
+        result.append(gammalib::str(m_tslice)+" sec");
+
+    } // endif: chatter was not silent
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Private methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GCTASimulator::init_members(void)
+{
+    // Initialise members
+    m_models.clear();
+    m_seed   = 41;
+    m_area   = 3.2e10;
+    m_margin = 1.0;
+    m_tslice = 1800.0;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] sim CTA observation simulator.
+ ***************************************************************************/
+void GCTASimulator::copy_members(const GCTASimulator& sim)
+{
+    // Copy members
+    m_models = sim.m_models;
+    m_seed   = sim.m_seed;
+    m_area   = sim.m_area;
+    m_margin = sim.m_margin;
+    m_tslice = sim.m_tslice;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GCTASimulator::free_members(void)
+{
+    // Return
+    return;
+}
@@ -31,6 +31,7 @@
 #include <cmath>
 #include <iostream>
 #include "GCTASupport.hpp"
+#include "GCTAResponse.hpp"
 #include "GTools.hpp"
 #include "GMath.hpp"
 
@@ -116,3 +117,80 @@ double gammalib::cta_roi_arclength(const double& rad,     const double& dist,
     // Return arclength
     return arclength;
 }
+
+
+/***********************************************************************//**
+ * @brief Returns IRF value and its partial derivatives
+ *
+ * @param[in] rsp CTA response.
+ * @param[in] delta Angular distance between true and measured photon
+ *                  direction (radians).
+ * @param[in] theta Offset angle of true photon direction (radians).
+ * @param[in] phi Azimuth angle of true photon direction (radians).
+ * @param[in] zenith Zenith angle of pointing (radians).
+ * @param[in] azimuth Azimuth angle of pointing (radians).
+ * @param[in] srcLogEng Log10 of true photon energy (E/TeV).
+ * @param[in] obsLogEng Log10 of measured photon energy (E/TeV).
+ * @param[out] d_delta Partial derivative of IRF with respect to delta.
+ * @param[out] d_theta Partial derivative of IRF with respect to theta.
+ * @return IRF value.
+ *
+ * Returns the product of effective area, point spread function and, if
+ * available, energy dispersion, together with its partial derivatives
+ * with respect to the PSF offset angle @p delta and the offset angle
+ * @p theta. As the response components are generally tabulated, the
+ * derivatives are computed using central differences. Negative offset
+ * angles are reflected at zero, which assures that the derivatives vanish
+ * at the centre of the PSF and the camera.
+ ***************************************************************************/
+double gammalib::cta_irf_partials(const GCTAResponse& rsp,
+                                  const double&       delta,
+                                  const double&       theta,
+                                  const double&       phi,
+                                  const double&       zenith,
+                                  const double&       azimuth,
+                                  const double&       srcLogEng,
+                                  const double&       obsLogEng,
+                                  double*             d_delta,
+                                  double*             d_theta)
+{
+    // Set step size for numerical derivatives (radians)
+    const double h = 1.0e-6;
+
+    // Set offset angles for numerical derivatives
+    double delta_plus  = delta + h;
+    double delta_minus = std::abs(delta - h);
+    double theta_plus  = theta + h;
+    double theta_minus = std::abs(theta - h);
+
+    // Compute IRF components
+    double aeff  = rsp.aeff(theta, phi, zenith, azimuth, srcLogEng);
+    double psf   = rsp.psf(delta, theta, phi, zenith, azimuth, srcLogEng);
+    double edisp = (rsp.hasedisp())
+                   ? rsp.edisp(obsLogEng, theta, phi, zenith, azimuth, srcLogEng)
+                   : 1.0;
+
+    // Compute IRF value
+    double irf = aeff * psf * edisp;
+
+    // Compute derivative with respect to PSF offset angle
+    double psf_plus  = rsp.psf(delta_plus,  theta, phi, zenith, azimuth, srcLogEng);
+    double psf_minus = rsp.psf(delta_minus, theta, phi, zenith, azimuth, srcLogEng);
+    *d_delta = aeff * edisp * (psf_plus - psf_minus) / (2.0 * h);
+
+    // Compute derivative with respect to offset angle
+    double irf_plus  = rsp.aeff(theta_plus, phi, zenith, azimuth, srcLogEng) *
+                       rsp.psf(delta, theta_plus, phi, zenith, azimuth, srcLogEng);
+    double irf_minus = rsp.aeff(theta_minus, phi, zenith, azimuth, srcLogEng) *
+                       rsp.psf(delta, theta_minus, phi, zenith, azimuth, srcLogEng);
+    if (rsp.hasedisp()) {
+        irf_plus  *= rsp.edisp(obsLogEng, theta_plus, phi, zenith, azimuth,
+                               srcLogEng);
+        irf_minus *= rsp.edisp(obsLogEng, theta_minus, phi, zenith, azimuth,
+                               srcLogEng);
+    }
+    *d_theta = (irf_plus - irf_minus) / (2.0 * h);
+
+    // Return IRF value
+    return irf;
+}
@@ -31,6 +31,9 @@
 
 /* __ Namespaces _________________________________________________________ */
 
+/* __ Forward declarations _______________________________________________ */
+class GCTAResponse;
+
 /* __ Constants __________________________________________________________ */
 
 /* __ Prototypes _________________________________________________________ */
@@ -38,6 +41,16 @@ namespace gammalib {
     double cta_roi_arclength(const double& rad,     const double& dist,
                              const double& cosdist, const double& sindist,
                              const double& roi,     const double& cosroi);
+    double cta_irf_partials(const GCTAResponse& rsp,
+                            const double&       delta,
+                            const double&       theta,
+                            const double&       phi,
+                            const double&       zenith,
+                            const double&       azimuth,
+                            const double&       srcLogEng,
+                            const double&       obsLogEng,
+                            double*             d_delta,
+                            double*             d_theta);
 }
 
 #endif /* GCTASUPPORT_HPP */
@@ -30,7 +30,11 @@
 #endif
 #include <stdlib.h>
 #include <iostream>
+#include <cmath>
 #include <unistd.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "GCTALib.hpp"
 #include "GTools.hpp"
 #include "test_CTA.hpp"
@@ -66,6 +70,10 @@ void TestGCTAResponse::set(void)
     append(static_cast<pfunction>(&TestGCTAResponse::test_response_npsf), "Test integrated PSF");
     append(static_cast<pfunction>(&TestGCTAResponse::test_response_irf_diffuse), "Test diffuse IRF");
     append(static_cast<pfunction>(&TestGCTAResponse::test_response_npred_diffuse), "Test diffuse IRF integration");
+    append(static_cast<pfunction>(&TestGCTAResponse::test_response_irf_radial_grid), "Test tabulated radial IRF");
+    append(static_cast<pfunction>(&TestGCTAResponse::test_response_irf_diffuse_grid), "Test tabulated diffuse IRF");
+    append(static_cast<pfunction>(&TestGCTAResponse::test_response_irf_gradients), "Test IRF gradients");
+    append(static_cast<pfunction>(&TestGCTAResponse::test_response_npred_kernel), "Test tabulated Npred kernel");
 
     // Return
     return;
@@ -83,6 +91,11 @@ void TestGCTAObservation::set(void)
     // Append tests to test suite
     append(static_cast<pfunction>(&TestGCTAObservation::test_unbinned_obs), "Test unbinned observations");
     append(static_cast<pfunction>(&TestGCTAObservation::test_binned_obs), "Test binned observation");
+    append(static_cast<pfunction>(&TestGCTAObservation::test_batch_model), "Test batched model evaluation");
+    append(static_cast<pfunction>(&TestGCTAObservation::test_model_cache), "Test model cache");
+    append(static_cast<pfunction>(&TestGCTAObservation::test_irf_cache), "Test IRF cache");
+    append(static_cast<pfunction>(&TestGCTAObservation::test_srcmaps), "Test source maps");
+    append(static_cast<pfunction>(&TestGCTAObservation::test_simulator), "Test observation simulator");
 
     // Return
     return;
@@ -100,6 +113,8 @@ void TestGCTAOptimize::set(void)
     // Append tests to test suite
     append(static_cast<pfunction>(&TestGCTAOptimize::test_unbinned_optimizer), "Test unbinned optimizer");
     append(static_cast<pfunction>(&TestGCTAOptimize::test_binned_optimizer), "Test binned optimizer");
+    append(static_cast<pfunction>(&TestGCTAOptimize::test_eval_value), "Test value-only function evaluation");
+    append(static_cast<pfunction>(&TestGCTAOptimize::test_unbinned_threads), "Test multi-threaded unbinned evaluation");
 
     // Return
     return;
@@ -165,6 +180,52 @@ void TestGCTAResponse::test_response_psf(void)
         test_value(sum, 1.0, 0.001, "PSF integration for "+eng.print());
     }
 
+    // Evaluate two PSFs alternately from more threads than the default
+    // number of threads, including nested parallel regions
+    test_try("Evaluate PSFs from threads");
+    try {
+        GCTAResponse rsp1("kb_E_50h_v3", cta_caldb);
+        GCTAResponse rsp2("kb_A_50h_v3", cta_caldb);
+        const int    n = 64;
+        std::vector<double> ref1(n);
+        std::vector<double> ref2(n);
+        for (int i = 0; i < n; ++i) {
+            double logE = -1.0 + 0.05 * i;
+            ref1[i]     = rsp1.psf(0.001, 0.0, 0.0, 0.0, 0.0, logE);
+            ref2[i]     = rsp2.psf(0.001, 0.0, 0.0, 0.0, 0.0, logE);
+        }
+        int nerrors = 0;
+        #ifdef _OPENMP
+        int nthreads = 2 * omp_get_max_threads() + 1;
+        int nlevels  = omp_get_max_active_levels();
+        omp_set_max_active_levels(2);
+        #pragma omp parallel for num_threads(nthreads) reduction(+:nerrors)
+        for (int i = 0; i < n; ++i) {
+            int nested = 0;
+            #pragma omp parallel num_threads(2) reduction(+:nested)
+            {
+                double logE = -1.0 + 0.05 * i;
+                for (int k = 0; k < 10; ++k) {
+                    if (rsp1.psf(0.001, 0.0, 0.0, 0.0, 0.0, logE) != ref1[i] ||
+                        rsp2.psf(0.001, 0.0, 0.0, 0.0, 0.0, logE) != ref2[i]) {
+                        nested++;
+                    }
+                }
+            }
+            nerrors += nested;
+        }
+        omp_set_max_active_levels(nlevels);
+        #endif
+        test_value(nerrors, 0, "Check PSF values of threads");
+        rsp1.load("kb_A_50h_v3");
+        test_value(rsp1.psf(0.001, 0.0, 0.0, 0.0, 0.0, -1.0+0.05*(n-1)),
+                   ref2[n-1], "Check PSF value after loading new response");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Return
     return;
 }
@@ -294,6 +355,267 @@ void TestGCTAResponse::test_response_irf_diffuse(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test tabulated radial source IRF
+ *
+ * Compares the IRF of a Gaussian source model summed over a small counts
+ * map when computed by numerical integration and when interpolated from
+ * the tabulated IRF.
+ ***************************************************************************/
+void TestGCTAResponse::test_response_irf_radial_grid(void)
+{
+    // Set parameters
+    double src_ra  = 201.3651;
+    double src_dec = -43.0191;
+    int    nebins  = 5;
+
+    // Setup pointing on Cen A
+    GSkyDir skyDir;
+    skyDir.radec_deg(src_ra, src_dec);
+    GCTAPointing pnt;
+    pnt.dir(skyDir);
+
+    // Setup event cube centered on Cen A
+    GSkymap  map("CAR", "CEL", src_ra, src_dec, 0.1, 0.1, 10, 10, nebins);
+    GGti     gti;
+    gti.append(GTime(0.0), GTime(1800.0));
+    GEbounds ebounds(nebins, GEnergy(0.1, "TeV"), GEnergy(100.0, "TeV"));
+    GCTAEventCube cube(map, ebounds, gti);
+
+    // Setup dummy CTA observation
+    GCTAObservation obs;
+    obs.ontime(1800.0);
+    obs.livetime(1600.0);
+    obs.deadc(1600.0/1800.0);
+    obs.events(&cube);
+    obs.pointing(pnt);
+
+    // Setup Gaussian model offset from the pointing
+    GSkyDir centre;
+    centre.radec_deg(src_ra+0.2, src_dec+0.1);
+    GModelSpatialRadialGauss model(centre, 0.2);
+
+    // Setup responses without and with tabulated IRF
+    GCTAResponse rsp(cta_irf, cta_caldb);
+    GCTAResponse rsp_grid(cta_irf, cta_caldb);
+    rsp_grid.radial_grid(true);
+    test_assert(rsp_grid.radial_grid(), "Check tabulated IRF flag");
+
+    // Sum IRFs over all bins in event cube
+    double sum      = 0.0;
+    double sum_grid = 0.0;
+    for (int i = 0; i < cube.size(); ++i) {
+        const GEventBin* bin = cube[i];
+        GSource source("Gauss", &model, bin->energy(), bin->time());
+        sum      += rsp.irf_radial(*bin, source, obs);
+        sum_grid += rsp_grid.irf_radial(*bin, source, obs);
+    }
+
+    // Test sums
+    test_value(sum_grid, sum, 0.01 * sum, "Tabulated radial IRF");
+
+    // Evaluate the tabulated IRF from more threads than the default number
+    // of threads, including nested parallel regions, using copies of the
+    // event bins as the event cube holds a single bin, and copies of the
+    // model as the IRF computation sets the model gradients
+    std::vector<GCTAEventBin> bins;
+    std::vector<double>       irfs;
+    for (int i = 0; i < cube.size(); ++i) {
+        bins.push_back(*(cube[i]));
+        GSource source("Gauss", &model, bins[i].energy(), bins[i].time());
+        irfs.push_back(rsp_grid.irf_radial(bins[i], source, obs));
+    }
+    int nerrors = 0;
+    #ifdef _OPENMP
+    int nthreads = 2 * omp_get_max_threads() + 1;
+    int nlevels  = omp_get_max_active_levels();
+    omp_set_max_active_levels(2);
+    #pragma omp parallel for num_threads(nthreads) reduction(+:nerrors)
+    for (int i = 0; i < bins.size(); ++i) {
+        int nested = 0;
+        #pragma omp parallel num_threads(2) reduction(+:nested)
+        {
+            GModelSpatialRadialGauss copy(model);
+            GSource source("Gauss", &copy, bins[i].energy(), bins[i].time());
+            if (rsp_grid.irf_radial(bins[i], source, obs) != irfs[i]) {
+                nested++;
+            }
+        }
+        nerrors += nested;
+    }
+    omp_set_max_active_levels(nlevels);
+    #endif
+    test_value(nerrors, 0, "Check tabulated radial IRF of threads");
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test tabulated CTA diffuse source IRF
+ *
+ * Compares the diffuse source IRFs summed over an event cube that are
+ * obtained by numerical integration to those that are interpolated from
+ * PSF convolved sky maps.
+ ***************************************************************************/
+void TestGCTAResponse::test_response_irf_diffuse_grid(void)
+{
+    // Set parameters
+    double src_ra  = 201.3651;
+    double src_dec = -43.0191;
+    int    nebins  = 5;
+
+    // Setup pointing on Cen A
+    GSkyDir skyDir;
+    skyDir.radec_deg(src_ra, src_dec);
+    GCTAPointing pnt;
+    pnt.dir(skyDir);
+
+    // Setup event cube centered on Cen A
+    GSkymap  map("CAR", "CEL", src_ra, src_dec, 0.1, 0.1, 10, 10, nebins);
+    GGti     gti;
+    gti.append(GTime(0.0), GTime(1800.0));
+    GEbounds ebounds(nebins, GEnergy(0.1, "TeV"), GEnergy(100.0, "TeV"));
+    GCTAEventCube cube(map, ebounds, gti);
+
+    // Setup dummy CTA observation
+    GCTAObservation obs;
+    obs.ontime(1800.0);
+    obs.livetime(1600.0);
+    obs.deadc(1600.0/1800.0);
+    obs.events(&cube);
+    obs.pointing(pnt);
+
+    // Setup diffuse model
+    GModelSpatialDiffuseMap model(datadir+"/cena_lobes_parkes.fits");
+
+    // Setup responses without and with tabulated IRF
+    GCTAResponse rsp(cta_irf, cta_caldb);
+    GCTAResponse rsp_grid(cta_irf, cta_caldb);
+    rsp_grid.diffuse_grid(true);
+    test_assert(rsp_grid.diffuse_grid(), "Check tabulated IRF flag");
+
+    // Sum IRFs over all bins in event cube
+    double sum      = 0.0;
+    double sum_grid = 0.0;
+    for (int i = 0; i < cube.size(); ++i) {
+        const GEventBin* bin = cube[i];
+        GSource source("Lobes", &model, bin->energy(), bin->time());
+        sum      += rsp.irf_diffuse(*bin, source, obs);
+        sum_grid += rsp_grid.irf_diffuse(*bin, source, obs);
+    }
+
+    // Test sums
+    test_value(sum_grid, sum, 0.02 * sum, "Tabulated diffuse IRF");
+
+    // Setup a different diffuse model from the western half of the map
+    GSkymap lobes = model.map();
+    for (int i = 0; i < lobes.npix(); ++i) {
+        if (lobes.pix2dir(i).ra_deg() > src_ra) {
+            for (int k = 0; k < lobes.nmaps(); ++k) {
+                lobes(i,k) = 0.0;
+            }
+        }
+    }
+    GModelSpatialDiffuseMap west(lobes);
+
+    // Sum IRFs of the different model under the same source name, which
+    // requires that the tabulated IRF is set up again
+    sum      = 0.0;
+    sum_grid = 0.0;
+    for (int i = 0; i < cube.size(); ++i) {
+        const GEventBin* bin = cube[i];
+        GSource source("Lobes", &west, bin->energy(), bin->time());
+        sum      += rsp.irf_diffuse(*bin, source, obs);
+        sum_grid += rsp_grid.irf_diffuse(*bin, source, obs);
+    }
+
+    // Test sums
+    test_value(sum_grid, sum, 0.02 * sum, "Tabulated diffuse IRF of new model");
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test radial and elliptical IRF gradients
+ *
+ * Checks that the IRF values returned by irf_gradients() are identical to
+ * those returned by irf() for a Gaussian and an elliptical disk model with
+ * free spatial parameters, summed over a small counts map.
+ ***************************************************************************/
+void TestGCTAResponse::test_response_irf_gradients(void)
+{
+    // Set parameters
+    double src_ra  = 201.3651;
+    double src_dec = -43.0191;
+    int    nebins  = 5;
+
+    // Setup pointing on Cen A
+    GSkyDir skyDir;
+    skyDir.radec_deg(src_ra, src_dec);
+    GCTAPointing pnt;
+    pnt.dir(skyDir);
+
+    // Setup event cube centered on Cen A
+    GSkymap  map("CAR", "CEL", src_ra, src_dec, 0.1, 0.1, 10, 10, nebins);
+    GGti     gti;
+    gti.append(GTime(0.0), GTime(1800.0));
+    GEbounds ebounds(nebins, GEnergy(0.1, "TeV"), GEnergy(100.0, "TeV"));
+    GCTAEventCube cube(map, ebounds, gti);
+
+    // Setup dummy CTA observation
+    GCTAObservation obs;
+    obs.ontime(1800.0);
+    obs.livetime(1600.0);
+    obs.deadc(1600.0/1800.0);
+    obs.events(&cube);
+    obs.pointing(pnt);
+
+    // Setup Gaussian and elliptical disk models offset from the pointing,
+    // with all spatial parameters free
+    GSkyDir centre;
+    centre.radec_deg(src_ra+0.2, src_dec+0.1);
+    GModelSpatialRadialGauss    gauss(centre, 0.2);
+    GModelSpatialEllipticalDisk disk(centre, 0.3, 0.1, 45.0);
+    for (int i = 0; i < gauss.size(); ++i) {
+        gauss[i].free();
+    }
+    for (int i = 0; i < disk.size(); ++i) {
+        disk[i].free();
+    }
+
+    // Setup response
+    GCTAResponse rsp(cta_irf, cta_caldb);
+
+    // Sum IRFs over all bins in event cube
+    double sum_gauss      = 0.0;
+    double sum_gauss_grad = 0.0;
+    double sum_disk       = 0.0;
+    double sum_disk_grad  = 0.0;
+    for (int i = 0; i < cube.size(); ++i) {
+        const GEventBin* bin = cube[i];
+        GSource src_gauss("Gauss", &gauss, bin->energy(), bin->time());
+        GSource src_disk("Disk", &disk, bin->energy(), bin->time());
+        sum_gauss      += rsp.irf(*bin, src_gauss, obs);
+        sum_gauss_grad += rsp.irf_gradients(*bin, src_gauss, obs);
+        sum_disk       += rsp.irf(*bin, src_disk, obs);
+        sum_disk_grad  += rsp.irf_gradients(*bin, src_disk, obs);
+    }
+
+    // Test sums
+    test_value(sum_gauss_grad, sum_gauss, 1.0e-10 * sum_gauss,
+               "Radial IRF gradients");
+    test_value(sum_disk_grad, sum_disk, 1.0e-10 * sum_disk,
+               "Elliptical IRF gradients");
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test CTA Npred computation
  *
@@ -363,6 +685,81 @@ void TestGCTAResponse::test_response_npred_diffuse(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test tabulated Npred kernel
+ *
+ * Compares Npred and its gradients computed by spectral integration to
+ * those obtained from the tabulated Npred kernels.
+ ***************************************************************************/
+void TestGCTAResponse::test_response_npred_kernel(void)
+{
+    // Set parameters
+    double src_ra  = 83.6331;
+    double src_dec = 22.0145;
+
+    // Setup ROI centred on Crab with a radius of 3 deg
+    GCTARoi     roi;
+    GCTAInstDir instDir;
+    instDir.radec_deg(src_ra, src_dec);
+    roi.centre(instDir);
+    roi.radius(3.0);
+
+    // Setup pointing on Crab
+    GSkyDir skyDir;
+    skyDir.radec_deg(src_ra, src_dec);
+    GCTAPointing pnt;
+    pnt.dir(skyDir);
+
+    // Setup dummy event list
+    GGti     gti;
+    GEbounds ebounds;
+    gti.append(GTime(0.0), GTime(1800.0));
+    ebounds.append(GEnergy(0.1, "TeV"), GEnergy(100.0, "TeV"));
+    GCTAEventList events;
+    events.roi(roi);
+    events.gti(gti);
+    events.ebounds(ebounds);
+
+    // Setup dummy CTA observation
+    GCTAObservation obs;
+    obs.ontime(1800.0);
+    obs.livetime(1600.0);
+    obs.deadc(1600.0/1800.0);
+    obs.response(cta_irf, cta_caldb);
+    obs.events(&events);
+    obs.pointing(pnt);
+
+    // Load models
+    GModels models(cta_model_xml);
+
+    // Compute Npred and gradients without and with kernels
+    GVector grad(models.npars());
+    GVector grad_kernel(models.npars());
+    double  npred = obs.npred(models, &grad);
+    obs.npred_kernel(true);
+    test_assert(obs.npred_kernel(), "Check Npred kernel flag");
+    double  npred_kernel = obs.npred(models, &grad_kernel);
+
+    // Test Npred and gradients
+    test_value(npred_kernel, npred, 1.0e-4 * npred, "Npred from kernel");
+    for (int i = 0; i < models.npars(); ++i) {
+        test_value(grad_kernel[i], grad[i], 1.0e-3 * std::abs(grad[i]) + 1.0e-10,
+                   "Npred gradient "+gammalib::str(i)+" from kernel");
+    }
+
+    // Test that a change of a spectral parameter is followed
+    (*models[0])["Index"].value(2.2);
+    obs.npred_kernel(false);
+    npred = obs.npred(models, NULL);
+    obs.npred_kernel(true);
+    npred_kernel = obs.npred(models, NULL);
+    test_value(npred_kernel, npred, 1.0e-4 * npred, "Npred from kernel after change");
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test CTA response handling
  ***************************************************************************/
@@ -430,6 +827,119 @@ void TestGCTAObservation::test_unbinned_obs(void)
     }
     test_value(num, 4397, 1.0e-20, "Test event iterator");
 
+    // Load events without columns that are not needed for likelihood
+    test_try("Load events without unused columns");
+    try {
+        GCTAEventList list;
+        list.skip_columns(true);
+        list.load(cta_events);
+        test_value(list.size(), ptr->size(), "Check number of events");
+        test_assert(list.skip_columns(), "Check that column selection is kept");
+        for (int i = 0; i < list.size(); i += 97) {
+            test_value(list[i]->energy().TeV(), (*ptr)[i]->energy().TeV());
+            test_value(list[i]->time().secs(), (*ptr)[i]->time().secs());
+            test_value(list[i]->dir().dist_deg((*ptr)[i]->dir()), 0.0);
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Load events into compact storage
+    test_try("Load events into compact storage");
+    try {
+        GCTAEventList list;
+        list.compact(true);
+        list.load(cta_events);
+        test_value(list.size(), ptr->size(), "Check number of events");
+        test_assert(list.compact(), "Check that storage mode is kept");
+        const GCTAEventList& events = list;
+        for (int i = 0; i < events.size(); i += 97) {
+            test_value(events[i]->index(), i, "Check event index");
+            test_value(events[i]->energy().TeV(), (*ptr)[i]->energy().TeV(), 1.0e-4);
+            test_value(events[i]->time().secs(), (*ptr)[i]->time().secs());
+            test_value(events[i]->dir().dist_deg((*ptr)[i]->dir()), 0.0, 1.0e-4);
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Convert events into compact storage and back
+    test_try("Convert events into compact storage");
+    try {
+        GCTAEventList list(*ptr);
+        list.compact(true);
+        test_value(list.size(), ptr->size(), "Check number of events");
+        const GCTAEventList& events = list;
+        const GCTAEventAtom* first  = events[0];
+        for (int i = 1; i < 4096; ++i) {
+            events[i % events.size()];
+        }
+        test_value(first->index(), 0, "Check that view is still valid");
+        list.compact(false);
+        test_assert(!list.compact(), "Check that storage mode is full");
+        for (int i = 0; i < list.size(); i += 97) {
+            test_value(list[i]->index(), i, "Check event index");
+            test_value(list[i]->energy().TeV(), (*ptr)[i]->energy().TeV(), 1.0e-4);
+            test_value(list[i]->time().secs(), (*ptr)[i]->time().secs());
+            test_value(list[i]->dir().dist_deg((*ptr)[i]->dir()), 0.0, 1.0e-4);
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Check that events of a compact event list are read-only
+    test_try("Modify compact events");
+    try {
+        GCTAEventList list(*ptr);
+        list.compact(true);
+        list[0];
+        test_try_failure("Expected GException::invalid_value exception.");
+    }
+    catch (GException::invalid_value &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Access compact events from more threads than the default number
+    // of threads, including nested parallel regions
+    test_try("Access compact events from threads");
+    try {
+        GCTAEventList list(*ptr);
+        list.compact(true);
+        const GCTAEventList& events = list;
+        int nerrors = 0;
+        #ifdef _OPENMP
+        int nthreads = 2 * omp_get_max_threads() + 1;
+        int nlevels  = omp_get_max_active_levels();
+        omp_set_max_active_levels(2);
+        #pragma omp parallel for num_threads(nthreads) reduction(+:nerrors)
+        for (int i = 0; i < events.size(); i += 17) {
+            int nested = 0;
+            #pragma omp parallel num_threads(2) reduction(+:nested)
+            {
+                if (events[i]->index() != i) {
+                    nested++;
+                }
+            }
+            nerrors += nested;
+        }
+        omp_set_max_active_levels(nlevels);
+        #endif
+        test_value(nerrors, 0, "Check event views of threads");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Test XML loading
     test_try("Test XML loading");
     try {
@@ -447,6 +957,253 @@ void TestGCTAObservation::test_unbinned_obs(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test IRF cache
+ *
+ * Tests the IRF cache in double and single precision, the slot signatures,
+ * the saving and loading of the cache, and the persistence of the cache in
+ * an event list file.
+ ***************************************************************************/
+void TestGCTAObservation::test_irf_cache(void)
+{
+    // Set filenames
+    const std::string file1 = "test_cta_irfcache.fits";
+    const std::string file2 = "test_cta_irfcache_events.fits";
+
+    // Set up cache
+    GCTAIrfCache cache(10);
+    int          h1 = cache.handle("Source 1");
+    int          h2 = cache.handle("Source 2");
+    test_value(cache.size(), 2, "Check number of slots");
+    test_value(cache.handle("Source 1"), h1, "Check handle of existing slot");
+    test_value(cache.index("Source 3"), -1, "Check index of unknown slot");
+    test_value(cache.value(h1, 3), -1.0, 1.0e-10, "Check unset value");
+
+    // Set and get values
+    cache.value(h1, 3, 0.125);
+    cache.value(h2, 9, 3.0e-7);
+    test_value(cache.value(h1, 3), 0.125, 1.0e-10, "Check value");
+    test_value(cache.value(h2, 9), 3.0e-7, 1.0e-20, "Check value");
+    test_value(cache.number(h1), 1, "Check number of values");
+
+    // Test out of range access
+    test_try("Test out of range access");
+    try {
+        cache.value(2, 0);
+        test_try_failure("Expected GException::out_of_range exception.");
+    }
+    catch (GException::out_of_range &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Test conversion to single precision
+    cache.single(true);
+    test_value(cache.value(h1, 3), 0.125, 1.0e-10, "Check single precision value");
+    test_value(cache.value(h2, 9), 3.0e-7, 1.0e-13, "Check single precision value");
+    test_value(cache.value(h2, 0), -1.0, 1.0e-10, "Check single precision unset value");
+    cache.single(false);
+
+    // Test signatures
+    GCTAIrfCache signed_cache(10);
+    int h3 = signed_cache.handle("Source 3", "A");
+    signed_cache.value(h3, 5, 0.25);
+    test_value(signed_cache.handle("Source 3", "A"), h3, "Check handle of signed slot");
+    test_value(signed_cache.value(h3, 5), 0.25, 1.0e-10, "Check value of signed slot");
+    test_value(signed_cache.handle("Source 3", "B"), h3, "Check handle of re-signed slot");
+    test_assert(signed_cache.signature(h3) == "B", "Check signature of re-signed slot");
+    test_value(signed_cache.value(h3, 5), -1.0, 1.0e-10, "Check value of re-signed slot");
+
+    // Save and load cache
+    test_try("Save and load IRF cache");
+    try {
+        cache.handle("Source 2", "signature");
+        cache.value(h2, 9, 3.0e-7);
+        cache.save(file1, true);
+        GCTAIrfCache loaded;
+        loaded.load(file1);
+        test_value(loaded.nevents(), 10, "Check number of loaded events");
+        test_value(loaded.size(), 2, "Check number of loaded slots");
+        test_value(loaded.value(loaded.index("Source 1"), 3), 0.125, 1.0e-10,
+                   "Check loaded value");
+        test_value(loaded.value(loaded.index("Source 2"), 9), 3.0e-7, 1.0e-20,
+                   "Check loaded value");
+        test_assert(loaded.signature(loaded.index("Source 2")) == "signature",
+                    "Check loaded signature");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Drop columns without signature
+    test_try("Drop IRF cache columns without signature");
+    try {
+        GFitsBinTable       table(10);
+        GFitsTableDoubleCol column("Source 4", 10);
+        column(3) = 0.5;
+        table.append_column(column);
+        GCTAIrfCache loaded;
+        loaded.read(&table);
+        test_value(loaded.size(), 0, "Check that unsigned column is dropped");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Persist cache with event list
+    test_try("Persist IRF cache with event list");
+    try {
+        GCTAEventList list;
+        list.load(cta_events);
+        int handle = list.irf_cache_handle("Source 1");
+        list.irf_cache(handle, 17, 0.5);
+        list.save(file2, true);
+        GCTAEventList loaded;
+        loaded.load(file2);
+        test_value(loaded.irf_cache("Source 1", 17), 0.5, 1.0e-10,
+                   "Check persisted value");
+        test_value(loaded.irf_cache("Source 1", 18), -1.0, 1.0e-10,
+                   "Check persisted unset value");
+        test_value(loaded.irf_cache("Source 2", 17), -1.0, 1.0e-10,
+                   "Check unknown source");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Bind cache slot to model
+    test_try("Bind IRF cache slot to model");
+    try {
+        GCTAEventList list;
+        list.load(cta_events);
+        GModelSpatialRadialDisk disk(GSkyDir(), 0.2);
+        int handle = list.irf_cache_bind("Source 1", "A", disk);
+        test_value(list.irf_cache_bound("Source 1", disk), handle,
+                   "Check bound handle");
+        test_value(list.irf_cache_bound("Source 2", disk), -1,
+                   "Check unbound source");
+        GModelSpatialRadialDisk copy = disk;
+        test_value(list.irf_cache_bound("Source 1", copy), handle,
+                   "Check bound handle of model copy");
+        copy.radius(0.3);
+        test_value(list.irf_cache_bound("Source 1", copy), -1,
+                   "Check that modified model is not bound");
+        list.irf_cache_unbind();
+        test_value(list.irf_cache_bound("Source 1", disk), -1,
+                   "Check unbound slot");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test source maps
+ *
+ * Verifies that the model of a binned observation is unchanged when the
+ * IRF is taken from source maps, that source maps are ignored once the
+ * spatial parameter values change, and that source maps are saved and
+ * loaded with the observation while other image extensions are skipped.
+ ***************************************************************************/
+void TestGCTAObservation::test_srcmaps(void)
+{
+    // Set filenames
+    const std::string file1 = "test_cta_srcmaps.fits";
+
+    // Test source maps
+    test_try("Test source maps");
+    try {
+        // Load binned CTA observation and models
+        GCTAObservation run;
+        run.load_binned(cta_cntmap);
+        run.response(cta_irf, cta_caldb);
+        GModels models(cta_model_xml);
+
+        // Sum model over all bins without source maps
+        const GCTAEventCube* cube = static_cast<const GCTAEventCube*>(run.events());
+        double sum = 0.0;
+        for (int i = 0; i < cube->size(); ++i) {
+            sum += run.model(models, *((*cube)[i]), NULL);
+        }
+
+        // Keep observation without source maps
+        GCTAObservation ref = run;
+
+        // Compute source maps and sum model over all bins
+        run.srcmaps(models);
+        cube = static_cast<const GCTAEventCube*>(run.events());
+        test_value(cube->nsrcmaps(), 1, "Check number of source maps");
+        double sum_srcmap = 0.0;
+        for (int i = 0; i < cube->size(); ++i) {
+            sum_srcmap += run.model(models, *((*cube)[i]), NULL);
+        }
+        test_value(sum_srcmap, sum, 1.0e-6 * sum, "Check model from source maps");
+
+        // Move the source without freeing its position. The source map
+        // no longer applies, and the model needs to be computed from the
+        // IRF
+        GModelSpatial* spatial = dynamic_cast<GModelSky*>(models[0])->spatial();
+        double         ra      = (*spatial)["RA"].value();
+        (*spatial)["RA"].value(ra + 0.2);
+        test_assert(!cube->srcmap_isvalid(0, *spatial),
+                    "Check that source map does not apply to moved source");
+        double sum_moved = 0.0;
+        double sum_ref   = 0.0;
+        for (int i = 0; i < cube->size(); ++i) {
+            sum_moved += run.model(models, *((*cube)[i]), NULL);
+            sum_ref   += ref.model(models, *((*(ref.events()))[i]), NULL);
+        }
+        test_value(sum_moved, sum_ref, 1.0e-6 * sum_ref,
+                   "Check model of moved source");
+        (*spatial)["RA"].value(ra);
+
+        // Save source maps and add an image extension that is not a
+        // source map
+        run.save(file1, true);
+        GFits            fits(file1);
+        GFitsImageDouble image(3, 3);
+        image.extname("EXPOSURE");
+        fits.append(image);
+        fits.save(true);
+
+        // Load source maps
+        GCTAObservation loaded;
+        loaded.load_binned(file1);
+        loaded.response(cta_irf, cta_caldb);
+        cube = static_cast<const GCTAEventCube*>(loaded.events());
+        test_value(cube->nsrcmaps(), 1, "Check number of loaded source maps");
+        test_value(cube->srcmap_index(models[0]->name()), 0,
+                   "Check loaded source map name");
+        test_assert(cube->srcmap_isvalid(0, *spatial),
+                    "Check that loaded source map applies to source");
+        double sum_loaded = 0.0;
+        for (int i = 0; i < cube->size(); ++i) {
+            sum_loaded += loaded.model(models, *((*cube)[i]), NULL);
+        }
+        test_value(sum_loaded, sum, 1.0e-6 * sum,
+                   "Check model from loaded source maps");
+
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test binned observation handling
  ***************************************************************************/
@@ -487,6 +1244,259 @@ void TestGCTAObservation::test_binned_obs(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test batched model evaluation
+ *
+ * Verifies that the model values and gradients computed for a batch of
+ * events are identical to those computed event by event.
+ ***************************************************************************/
+void TestGCTAObservation::test_batch_model(void)
+{
+    // Test batched model evaluation
+    test_try("Test batched model evaluation");
+    try {
+
+        // Load unbinned CTA observation
+        GCTAObservation run;
+        run.load_unbinned(cta_events);
+        run.response(cta_irf,cta_caldb);
+
+        // Load models and free all parameters
+        GModels models(cta_model_xml);
+        for (int i = 0; i < models.size(); ++i) {
+            for (int k = 0; k < models[i]->size(); ++k) {
+                (*models[i])[k].free();
+            }
+        }
+
+        // Set event batch
+        const GEventList* events = static_cast<const GEventList*>(run.events());
+        int               num    = (events->size() < 200) ? events->size() : 200;
+        GEventBatch       batch(*events, 0, num);
+        test_value(batch.size(), num, 0.0, "Check batch size");
+
+        // Evaluate model for batch
+        int                 npars = models.npars();
+        std::vector<double> values(num);
+        std::vector<double> gradients(num * npars);
+        run.model(models, batch, &(values[0]), &(gradients[0]));
+
+        // Compare to event by event evaluation
+        GVector gradient(npars);
+        for (int i = 0; i < num; ++i) {
+            double value = run.model(models, *((*events)[i]), &gradient);
+            test_value(values[i], value, 1.0e-10*std::abs(value),
+                       "Check model value");
+            for (int k = 0; k < npars; ++k) {
+                test_value(gradients[k*num+i], gradient[k],
+                           1.0e-10*std::abs(gradient[k]),
+                           "Check model gradient");
+            }
+        }
+
+        // Signal success
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test model cache
+ *
+ * Evaluates the models for a batch of events, for single events and Npred
+ * with and without model cache, before and after the change of a single
+ * parameter. The model values need to be identical with and without model
+ * cache.
+ ***************************************************************************/
+void TestGCTAObservation::test_model_cache(void)
+{
+    // Test model cache
+    test_try("Test model cache");
+    try {
+
+        // Load unbinned CTA observation
+        GCTAObservation run;
+        run.load_unbinned(cta_events);
+        run.response(cta_irf,cta_caldb);
+
+        // Set observation with model cache
+        GCTAObservation cached = run;
+        cached.model_cache(true);
+
+        // Load models
+        GModels models(cta_model_xml);
+
+        // Set event batch
+        const GEventList* events = static_cast<const GEventList*>(run.events());
+        int               num    = (events->size() < 200) ? events->size() : 200;
+        GEventBatch       batch(*events, 0, num);
+
+        // Allocate arrays
+        int                 npars = models.npars();
+        std::vector<double> values(num);
+        std::vector<double> gradients(num * npars);
+        std::vector<double> ref_values(num);
+        std::vector<double> ref_gradients(num * npars);
+        GVector             grad(npars);
+        GVector             ref_grad(npars);
+
+        // Evaluate models several times, changing the value of the last
+        // parameter of the last model for all but the first evaluation
+        for (int iter = 0; iter < 4; ++iter) {
+
+            // Change parameter
+            if (iter > 0) {
+                GModelPar& par = (*models[models.size()-1])[models[models.size()-1]->size()-1];
+                par.value(1.1 * par.value());
+            }
+
+            // Evaluate models with and without cache
+            cached.model_cache_update(models);
+            cached.model(models, batch, &(values[0]), &(gradients[0]));
+            run.model(models, batch, &(ref_values[0]), &(ref_gradients[0]));
+            double npred     = cached.npred(models, &grad);
+            double ref_npred = run.npred(models, &ref_grad);
+
+            // Compare results
+            for (int i = 0; i < num; ++i) {
+                test_assert(values[i] == ref_values[i], "Check model value",
+                            "Found "+gammalib::str(values[i])+" instead of "+
+                            gammalib::str(ref_values[i]));
+            }
+            for (int i = 0; i < num * npars; ++i) {
+                test_value(gradients[i], ref_gradients[i],
+                           1.0e-10*std::abs(ref_gradients[i]),
+                           "Check model gradient");
+            }
+            test_value(npred, ref_npred, 1.0e-10*std::abs(ref_npred),
+                       "Check Npred value");
+            for (int k = 0; k < npars; ++k) {
+                test_value(grad[k], ref_grad[k], 1.0e-10*std::abs(ref_grad[k]),
+                           "Check Npred gradient");
+            }
+
+            // Evaluate single events with and without gradients after
+            // changing the parameter again
+            GModelPar& par = (*models[models.size()-1])[models[models.size()-1]->size()-1];
+            par.value(1.1 * par.value());
+            cached.model_cache_update(models);
+            for (int i = num; i < events->size() && i < 2*num; ++i) {
+                const GEvent* event = (*events)[i];
+                double value     = (i % 2 == 0) ? cached.model(models, *event, i, &grad)
+                                                : cached.model(models, *event, i, NULL);
+                double ref_value = run.model(models, *event, &ref_grad);
+                test_assert(value == ref_value, "Check model value of event",
+                            "Found "+gammalib::str(value)+" instead of "+
+                            gammalib::str(ref_value));
+            }
+
+        } // endfor: looped over evaluations
+
+        // Signal success
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test observation simulator
+ *
+ * Simulates an unbinned and a binned observation and checks that the
+ * simulation results do not depend on the number of threads.
+ ***************************************************************************/
+void TestGCTAObservation::test_simulator(void)
+{
+    // Test simulation of unbinned and binned observations
+    test_try("Test observation simulator");
+    try {
+
+        // Setup observations
+        GObservations   obs;
+        GCTAObservation run;
+        run.load_unbinned(cta_events);
+        run.response(cta_irf,cta_caldb);
+        run.id("0001");
+        obs.append(run);
+        run.load_binned(cta_cntmap);
+        run.response(cta_irf,cta_caldb);
+        run.id("0002");
+        obs.append(run);
+
+        // Simulate observations using several threads
+        GCTASimulator sim(GModels(cta_model_xml), 17);
+        sim.tslice(600.0);
+        GObservations obs1 = obs;
+        sim.simulate(obs1);
+
+        // Simulate observations using a single thread
+        #ifdef _OPENMP
+        int nthreads = omp_get_max_threads();
+        omp_set_num_threads(1);
+        #endif
+        GObservations obs2 = obs;
+        sim.simulate(obs2);
+        #ifdef _OPENMP
+        omp_set_num_threads(nthreads);
+        #endif
+
+        // Check unbinned simulations
+        const GCTAEventList* list1 = static_cast<const GCTAEventList*>(obs1[0]->events());
+        const GCTAEventList* list2 = static_cast<const GCTAEventList*>(obs2[0]->events());
+        test_assert(list1->size() > 0, "Expected simulated events.");
+        test_value(list1->size(), list2->size(), "Check number of events");
+        for (int i = 0; i < list1->size() && i < list2->size(); ++i) {
+            const GCTAEventAtom* event1 = (*list1)[i];
+            const GCTAEventAtom* event2 = (*list2)[i];
+            if (event1->energy() != event2->energy() ||
+                event1->time()   != event2->time()   ||
+                event1->dir().dist_deg(event2->dir()) > 0.0) {
+                throw exception_failure("Simulated event "+gammalib::str(i)+
+                                        " depends on the number of threads.");
+            }
+            if (list1->roi().centre().dist_deg(event1->dir()) >
+                list1->roi().radius()) {
+                throw exception_failure("Simulated event "+gammalib::str(i)+
+                                        " is outside the ROI.");
+            }
+        }
+
+        // Check binned simulations
+        const GCTAEventCube* cube1 = static_cast<const GCTAEventCube*>(obs1[1]->events());
+        const GCTAEventCube* cube2 = static_cast<const GCTAEventCube*>(obs2[1]->events());
+        test_assert(cube1->number() > 0, "Expected simulated events.");
+        test_value(cube1->number(), cube2->number(), "Check number of events");
+        for (int i = 0; i < cube1->size(); ++i) {
+            if ((*cube1)[i]->counts() != (*cube2)[i]->counts()) {
+                throw exception_failure("Simulated counts in bin "+
+                                        gammalib::str(i)+" depend on the"
+                                        " number of threads.");
+            }
+        }
+
+        // Signal success
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test unbinned optimizer
  ***************************************************************************/
@@ -611,6 +1621,194 @@ void TestGCTAOptimize::test_binned_optimizer(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test value-only function evaluation
+ *
+ * Checks that the function value returned by eval_value() is identical to
+ * the one computed by eval() for an unbinned and a binned observation, with
+ * and without model cache. Besides the Crab point source and the background
+ * model, the model contains a Gaussian and an elliptical disk source with
+ * free spatial parameters.
+ ***************************************************************************/
+void TestGCTAOptimize::test_eval_value(void)
+{
+    // Test value-only function evaluation
+    test_try("Test value-only function evaluation");
+    try {
+
+        // Loop over unbinned and binned observations and model cache
+        for (int i = 0; i < 4; ++i) {
+
+            // Load CTA observation
+            GCTAObservation run;
+            if (i < 2) {
+                run.load_unbinned(cta_events);
+            }
+            else {
+                run.load_binned(cta_cntmap);
+            }
+            run.response(cta_irf,cta_caldb);
+            run.model_cache(i % 2 == 1);
+
+            // Set models, and add a Gaussian and an elliptical disk source
+            // with free spatial parameters close to the Crab. Their IRFs are
+            // computed by numerical integration, which checks that eval()
+            // and eval_value() use the same quadrature.
+            GModels models(cta_model_xml);
+            GSkyDir centre;
+            centre.radec_deg(83.8, 22.2);
+            GModelSpatialRadialGauss    gauss(centre, 0.2);
+            GModelSpatialEllipticalDisk disk(centre, 0.3, 0.1, 45.0);
+            for (int k = 0; k < gauss.size(); ++k) {
+                gauss[k].free();
+            }
+            for (int k = 0; k < disk.size(); ++k) {
+                disk[k].free();
+            }
+            GModelSpectralPlaw plaw(1.0e-17, -2.5, GEnergy(0.3, "TeV"));
+            GModelSky src_gauss(gauss, plaw);
+            GModelSky src_disk(disk, plaw);
+            src_gauss.name("Gauss");
+            src_disk.name("Disk");
+            models.append(src_gauss);
+            models.append(src_disk);
+
+            // Set observation container
+            GObservations obs;
+            obs.append(run);
+            obs.models(models);
+
+            // Evaluate function
+            GObservations::optimizer fct(&obs);
+            fct.eval(models);
+            double value = fct.eval_value(models);
+            test_value(value, fct.value(), 1.0e-10*std::abs(fct.value()),
+                       "Check function value");
+
+            // Change a parameter and compare again
+            GModelPar& par = (*models["Background"])["Index"];
+            par.value(1.1 * par.value());
+            value = fct.eval_value(models);
+            fct.eval(models);
+            test_value(value, fct.value(), 1.0e-10*std::abs(fct.value()),
+                       "Check function value after parameter change");
+
+            // Change the spatial parameters of the extended sources and
+            // compare again
+            (*models["Gauss"])["Sigma"].value(0.25);
+            (*models["Disk"])["PA"].value(30.0);
+            value = fct.eval_value(models);
+            fct.eval(models);
+            test_value(value, fct.value(), 1.0e-10*std::abs(fct.value()),
+                       "Check function value after spatial parameter change");
+
+        } // endfor: looped over observations
+
+        // Signal success
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test multi-threaded evaluation of unbinned observation
+ *
+ * Checks that the function value and gradient of an unbinned observation
+ * are the same if the events are processed by a single thread and if
+ * they are distributed over several threads. The models include a fixed
+ * Gaussian source, for which the IRF values are taken from the IRF cache,
+ * and a Gaussian source with free spatial parameters.
+ ***************************************************************************/
+void TestGCTAOptimize::test_unbinned_threads(void)
+{
+    // Test multi-threaded unbinned evaluation
+    test_try("Test multi-threaded unbinned evaluation");
+    try {
+
+        // Load unbinned CTA observation
+        GCTAObservation run;
+        run.load_unbinned(cta_events);
+        run.response(cta_irf,cta_caldb);
+        test_assert(run.threadsafe(), "Check that observation is thread safe");
+
+        // Set models, and add a fixed and a free Gaussian source close to
+        // the Crab
+        GModels models(cta_model_xml);
+        GSkyDir centre;
+        centre.radec_deg(83.8, 22.2);
+        GModelSpatialRadialGauss fixed(centre, 0.2);
+        GModelSpatialRadialGauss free(centre, 0.3);
+        for (int k = 0; k < fixed.size(); ++k) {
+            fixed[k].fix();
+        }
+        for (int k = 0; k < free.size(); ++k) {
+            free[k].free();
+        }
+        GModelSpectralPlaw plaw(1.0e-17, -2.5, GEnergy(0.3, "TeV"));
+        GModelSky src_fixed(fixed, plaw);
+        GModelSky src_free(free, plaw);
+        src_fixed.name("Fixed");
+        src_free.name("Free");
+        models.append(src_fixed);
+        models.append(src_free);
+
+        // Set observation container
+        GObservations obs;
+        obs.append(run);
+        obs.models(models);
+
+        // Evaluate function using a single thread
+        #ifdef _OPENMP
+        int nthreads = omp_get_max_threads();
+        omp_set_num_threads(1);
+        #endif
+        GObservations::optimizer fct1(&obs);
+        fct1.eval(models);
+        double value1 = fct1.eval_value(models);
+
+        // Evaluate function using several threads
+        #ifdef _OPENMP
+        omp_set_num_threads(4);
+        #endif
+        GObservations::optimizer fct4(&obs);
+        fct4.eval(models);
+        double value4 = fct4.eval_value(models);
+        #ifdef _OPENMP
+        omp_set_num_threads(nthreads);
+        #endif
+
+        // Compare function values and gradients
+        double eps = 1.0e-10 * std::abs(fct1.value());
+        test_value(fct4.value(), fct1.value(), eps, "Check function value");
+        test_value(value4, value1, eps, "Check value-only function value");
+        test_value(value1, fct1.value(), eps, "Check value-only consistency");
+        GVector* grad1 = fct1.gradient();
+        GVector* grad4 = fct4.gradient();
+        test_value(grad4->size(), grad1->size(), "Check gradient size");
+        for (int i = 0; i < grad1->size(); ++i) {
+            test_value((*grad4)[i], (*grad1)[i],
+                       1.0e-10 * std::abs((*grad1)[i]) + 1.0e-20,
+                       "Check gradient "+gammalib::str(i));
+        }
+
+        // Signal success
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
 /***************************************************************************
  * @brief Main entry point for test executable
  ***************************************************************************/
@@ -51,6 +51,10 @@ public:
     void         test_response_npsf(void);
     void         test_response_irf_diffuse(void);
     void         test_response_npred_diffuse(void);
+    void         test_response_npred_kernel(void);
+    void         test_response_irf_radial_grid(void);
+    void         test_response_irf_diffuse_grid(void);
+    void         test_response_irf_gradients(void);
     void         test_response(void);
 };
 
@@ -72,6 +76,11 @@ public:
     virtual void set(void);
     void         test_unbinned_obs(void);
     void         test_binned_obs(void);
+    void         test_batch_model(void);
+    void         test_model_cache(void);
+    void         test_irf_cache(void);
+    void         test_srcmaps(void);
+    void         test_simulator(void);
 };
 
 
@@ -93,6 +102,8 @@ public:
     virtual void set(void);
     void         test_unbinned_optimizer(void);
     void         test_binned_optimizer(void);
+    void         test_eval_value(void);
+    void         test_unbinned_threads(void);
 };
 
 #endif /* TEST_CTA_HPP */
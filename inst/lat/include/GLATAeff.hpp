@@ -76,6 +76,8 @@ public:
     int          size(void) const { return nenergies()*ncostheta(); }
     int          nenergies(void) const { return m_aeff_bins.nenergies(); }
     int          ncostheta(void) const { return m_aeff_bins.ncostheta(); }
+    double       energy(const int& ie) const { return m_aeff_bins.energy(ie); }
+    unsigned long long int id(void) const { return m_id; }
     double       costhetamin(void) const { return m_min_ctheta; }
     void         costhetamin(const double& ctheta);
     bool         hasphi(void) const { return false; }
@@ -102,6 +104,7 @@ private:
     bool                m_back;         //!< Response is for back section
     GLATEfficiency*     m_eff_func1;    //!< Efficiency functor 1
     GLATEfficiency*     m_eff_func2;    //!< Efficiency functor 2
+    unsigned long long int m_id;        //!< Content identifier
 };
 
 #endif /* GLATAEFF_HPP */
@@ -30,6 +30,7 @@
 /* __ Includes ___________________________________________________________ */
 #include <string>
 #include <vector>
+#include <map>
 #include "GEventCube.hpp"
 #include "GLATInstDir.hpp"
 #include "GLATEventBin.hpp"
@@ -76,11 +77,11 @@ public:
     // Other methods
     void              time(const GTime& time) { m_time=time; }
     void              map(const GSkymap& map);
-    void              enodes(const GNodeArray& enodes) { m_enodes=enodes; }
+    void              enodes(const GNodeArray& enodes);
     void              ontime(const double& ontime) { m_ontime=ontime; }
     const GTime&      time(void) const { return m_time; }
     const GSkymap&    map(void) const { return m_map; }
-    const GNodeArray& enodes(void) { return m_enodes; }
+    const GNodeArray& enodes(void) const { return m_enodes; }
     const double&     ontime(void) const { return m_ontime; }
     int               nx(void) const { return m_map.nx(); }
     int               ny(void) const { return m_map.ny(); }
@@ -89,6 +90,8 @@ public:
     int               ndiffrsp(void) const { return m_srcmap.size(); }
     std::string       diffname(const int& index) const;
     GSkymap*          diffrsp(const int& index) const;
+    int               diffindex(const std::string& name) const;
+    const GNodeArray::handle& ehandle(const int& ieng) const;
     double            maxrad(const GSkyDir& dir) const;
 
 protected:
@@ -103,20 +106,39 @@ protected:
     void         set_directions(void);
     virtual void set_energies(void);
     virtual void set_times(void);
+    void         set_ehandles(void);
     void         set_bin(const int& index);
 
     // Protected data area
-    GLATEventBin             m_bin;          //!< Actual energy bin
-    GSkymap                  m_map;          //!< Counts map stored as sky map
-    GTime                    m_time;         //!< Event cube mean time
-    double                   m_ontime;       //!< Event cube ontime (sec)
-    std::vector<GLATInstDir> m_dirs;         //!< Array of event directions
-    std::vector<double>      m_omega;        //!< Array of solid angles (sr)
-    std::vector<GEnergy>     m_energies;     //!< Array of log mean energies
-    std::vector<GEnergy>     m_ewidth;       //!< Array of energy bin widths
-    std::vector<GSkymap*>    m_srcmap;       //!< Pointers to source maps
-    std::vector<std::string> m_srcmap_names; //!< Source map names
-    GNodeArray               m_enodes;       //!< Energy nodes
+    GLATEventBin                    m_bin;          //!< Actual energy bin
+    GSkymap                         m_map;          //!< Counts map stored as sky map
+    GTime                           m_time;         //!< Event cube mean time
+    double                          m_ontime;       //!< Event cube ontime (sec)
+    std::vector<GLATInstDir>        m_dirs;         //!< Array of event directions
+    std::vector<double>             m_omega;        //!< Array of solid angles (sr)
+    std::vector<GEnergy>            m_energies;     //!< Array of log mean energies
+    std::vector<GEnergy>            m_ewidth;       //!< Array of energy bin widths
+    std::vector<GSkymap*>           m_srcmap;       //!< Pointers to source maps
+    std::vector<std::string>        m_srcmap_names; //!< Source map names
+    GNodeArray                      m_enodes;       //!< Energy nodes
+    std::map<std::string,int>       m_srcmap_index; //!< Source map index by name
+    std::vector<GNodeArray::handle> m_ehandles;     //!< Energy layer node handles
 };
 
+
+/***********************************************************************//**
+ * @brief Return energy node handle for energy layer
+ *
+ * @param[in] ieng Energy layer index [0,...,ebins()-1].
+ * @return Source map energy node handle for the log mean energy of layer.
+ *
+ * The handles are precomputed by set_energies() so that the source map
+ * interpolation weights of a bin need not be computed for every bin.
+ ***************************************************************************/
+inline
+const GNodeArray::handle& GLATEventCube::ehandle(const int& ieng) const
+{
+    return (m_ehandles[ieng]);
+}
+
 #endif /* GLATEVENTCUBE_HPP */
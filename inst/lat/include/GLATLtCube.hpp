@@ -72,6 +72,8 @@ public:
     GLATLtCube* clone(void) const;
     void        load(const std::string& filename);
     void        save(const std::string& filename, bool clobber=false) const;
+    void        precompute(const GLATAeff& aeff);
+    bool        hasexposure(const GLATAeff& aeff) const;
     std::string print(const GChatter& chatter = NORMAL) const;
 
 private:
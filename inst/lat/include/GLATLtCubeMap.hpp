@@ -29,10 +29,12 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
 #include "GBase.hpp"
 #include "GFitsTable.hpp"
 #include "GSkymap.hpp"
 #include "GSkyDir.hpp"
+#include "GNodeArray.hpp"
 #include "GLATAeff.hpp"
 #include "GLATPsf.hpp"
 
@@ -48,6 +50,16 @@ typedef double (*_ltcube_ctheta_phi)(const double& costheta, const double& phi);
  *
  * A livetime cube map holds a set of HEALPix skymaps that are a function
  * of the cosine of the zenith angle and (optionally) of the azimuth angle.
+ *
+ * For fast summation, the livetimes are also stored in a pixel-major
+ * array, where the livetimes of all zenith and azimuth angle bins of a
+ * given HEALPix pixel are contiguous in memory.
+ *
+ * Optionally, an exposure cube can be precomputed for an effective area
+ * using the precompute() method. The exposure cube holds the livetime
+ * weighted effective area for all pixels and for all energy nodes of the
+ * effective area, so that the exposure for a sky direction is obtained by
+ * a single linear interpolation in energy.
  ***************************************************************************/
 class GLATLtCubeMap : public GBase {
 
@@ -79,6 +91,8 @@ public:
     double         phi(const int& index) const;
     double         costhetamin(void) const { return m_min_ctheta; }
     std::string    costhetabin(void) const;
+    void           precompute(const GLATAeff& aeff);
+    bool           hasexposure(const GLATAeff& aeff) const;
     std::string    print(const GChatter& chatter = NORMAL) const;
 
 private:
@@ -86,6 +100,8 @@ private:
     void init_members(void);
     void copy_members(const GLATLtCubeMap& cube);
     void free_members(void);
+    void set_livetime(void);
+    int  exposure_index(const GLATAeff& aeff) const;
     
     // Protected members
     GSkymap m_map;          //!< Lifetime cube map
@@ -93,6 +109,17 @@ private:
     int     m_num_phi;      //!< Number of bins in phi
     double  m_min_ctheta;   //!< Minimum cos theta value
     bool    m_sqrt_bin;     //!< Square root binning?
+
+    // Pixel-major livetimes and bin values
+    std::vector<double> m_livetime;   //!< Livetimes (pixel-major)
+    std::vector<double> m_costheta;   //!< cos theta values of bins
+    std::vector<double> m_phi;        //!< phi values of bins
+
+    // Precomputed exposure cubes
+    std::vector<unsigned long long int> m_exp_id;     //!< Aeff identifiers
+    std::vector<double>                 m_exp_ctheta; //!< Aeff minimum cos theta
+    std::vector<GNodeArray>             m_exp_logE;   //!< log10 energy nodes
+    std::vector<std::vector<double> >   m_exp_cube;   //!< Exposures (pixel-major)
 };
 
 #endif /* GLATLTCUBEMAP_HPP */
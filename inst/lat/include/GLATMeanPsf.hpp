@@ -36,6 +36,8 @@
 
 /* __ Forward declarations _______________________________________________ */
 class GLATObservation;
+class GFits;
+class GFitsTable;
 
 
 /***********************************************************************//**
@@ -47,6 +49,12 @@ class GLATObservation;
  * been averaged over the zenith and azimuth angles of an observation. The
  * averaging is done using the livetime cube which holds the lifetime as
  * function and zenith and azimuth angles for an observation.
+ *
+ * As the computation of the mean PSF is time consuming, a mean PSF can be
+ * written into and read from a FITS binary table. The table holds the
+ * source direction and the name of the instrument response function, so
+ * that the isvalid() method can check whether a mean PSF that was read
+ * from a file can be used for a given source and observation.
  ***************************************************************************/
 class GLATMeanPsf : public GBase {
 
@@ -59,24 +67,28 @@ public:
 
     // Operators
     GLATMeanPsf& operator= (const GLATMeanPsf& cube);
-    double       operator() (const double& offset, const double& logE);
+    double       operator() (const double& offset, const double& logE) const;
 
     // Methods
     void         clear(void);
     GLATMeanPsf* clone(void) const;
     int          size(void) const;
     void         set(const GSkyDir& dir, const GLATObservation& obs);
+    bool         isvalid(const GSkyDir& dir, const GLATObservation& obs) const;
     int          noffsets(void) const { return m_offset.size(); }
     int          nenergies(void) const { return m_energy.size(); }
-    double       offset(const int& inx) { return m_offset[inx]; }
-    double       energy(const int& inx) { return m_energy[inx]; }
+    double       offset(const int& inx) const { return m_offset[inx]; }
+    double       energy(const int& inx) const { return m_energy[inx]; }
     GSkyDir      dir(void) const { return m_dir; }
     std::string  name(void) const { return m_name; }
     void         name(const std::string& name) { m_name=name; }
+    std::string  irf(void) const { return m_irf; }
     double       thetamax(void) const { return m_theta_max; }
     void         thetamax(const double& value) { m_theta_max=value; }
-    double       psf(const double& offset, const double& logE);
-    double       exposure(const double& logE);
+    double       psf(const double& offset, const double& logE) const;
+    double       exposure(const double& logE) const;
+    void         read(const GFitsTable& table);
+    void         write(GFits& file) const;
     std::string  print(const GChatter& chatter = NORMAL) const;
 
 private:
@@ -86,11 +98,12 @@ private:
     void   free_members(void);
     void   set_offsets(void);
     void   set_map_corrections(const GLATObservation& obs);
-    double integral(const double& radmax, const double& logE);
+    double integral(const double& radmax, const double& logE) const;
     
     // Protected members
     std::string          m_name;         //!< Source name for mean PSF
     GSkyDir              m_dir;          //!< Source direction for mean PSF
+    std::string          m_irf;          //!< Response name for mean PSF
     std::vector<double>  m_psf;          //!< Mean PSF values
     std::vector<double>  m_exposure;     //!< Mean exposure
     std::vector<double>  m_mapcorr;      //!< Map corrections
@@ -98,19 +111,6 @@ private:
     GNodeArray           m_energy;       //!< log10(energy) of mean PSF
     double               m_theta_max;    //!< Maximum inclination angle (default 70 deg)
 
-    // Bi-linear interpolation data
-    double               m_last_energy;  //!< Last requested logE value
-    double               m_last_offset;  //!< Last requested offset value
-    int                  m_inx1_exp;     //!< Exposure index 1
-    int                  m_inx2_exp;     //!< Exposure index 2
-    int                  m_inx1;         //!< Index 1
-    int                  m_inx2;         //!< Index 2
-    int                  m_inx3;         //!< Index 3
-    int                  m_inx4;         //!< Index 4
-    double               m_wgt1;         //!< Weighting factor 1
-    double               m_wgt2;         //!< Weighting factor 2
-    double               m_wgt3;         //!< Weighting factor 3
-    double               m_wgt4;         //!< Weighting factor 4
 };
 
 #endif /* GLATMEANPSF_HPP */
@@ -30,14 +30,17 @@
 /* __ Includes ___________________________________________________________ */
 #include <vector>
 #include <string>
+#include <map>
 #include "GLATEventAtom.hpp"
 #include "GLATEventBin.hpp"
 #include "GLATAeff.hpp"
 #include "GLATPsf.hpp"
 #include "GLATEdisp.hpp"
 #include "GLATMeanPsf.hpp"
+#include "GLATEventCube.hpp"
 #include "GEvent.hpp"
 #include "GModel.hpp"
+#include "GModels.hpp"
 #include "GObservation.hpp"
 #include "GResponse.hpp"
 
@@ -87,6 +90,11 @@ public:
     void        save(const std::string& rspname) const;
     bool        force_mean(void) { return m_force_mean; }
     void        force_mean(const bool& value) { m_force_mean=value; }
+    int         nmeanpsfs(void) const { return m_ptsrc.size(); }
+    void        meanpsfs(const GModels& models, const GObservation& obs);
+    void        load_meanpsfs(const std::string& filename);
+    void        save_meanpsfs(const std::string& filename,
+                              const bool& clobber = false) const;
 
     // Reponse methods
     double irf(const GLATEventAtom& event,
@@ -97,10 +105,29 @@ public:
                const GObservation& obs) const;
 
 private:
+    // Source handle
+    class srchandle {
+    public:
+        srchandle(void) : cube(NULL), idiff(-1), psf(NULL) {}
+        const GLATEventCube* cube;   //!< Event cube for which handle is valid
+        int                  idiff;  //!< Source map index (-1 if none)
+        const GLATMeanPsf*   psf;    //!< Mean PSF (NULL if none)
+    };
+    typedef std::map<std::string,srchandle> srchandles;
+
     // Private methods
     void init_members(void);
     void copy_members(const GLATResponse& rsp);
     void free_members(void);
+    const GLATMeanPsf* meanpsf(const std::string&     name,
+                               const GSkyDir&         dir,
+                               const GLATObservation& obs) const;
+    const GLATMeanPsf* search_meanpsf(const std::string& name,
+                                      const GSkyDir&     dir) const;
+    srchandle          source_handle(const GLATEventBin& event,
+                                     const GSource&      source,
+                                     const GObservation& obs) const;
+    void               reset_handles(void);
 
     // Private members
     std::string               m_caldb;      //!< Name of or path to the calibration database
@@ -112,6 +139,15 @@ private:
     std::vector<GLATPsf*>     m_psf;        //!< Point spread functions
     std::vector<GLATEdisp*>   m_edisp;      //!< Energy dispersions
     std::vector<GLATMeanPsf*> m_ptsrc;      //!< Mean PSFs for point sources
+    mutable unsigned long     m_handles_id; //!< Source handles identifier
+    mutable std::map<const void*,srchandles> m_handles; //!< Source handles per thread
+
+    // Thread private members
+    static unsigned long      m_handles_owner; //!< Identifier of thread handles
+    static srchandles*        m_handles_cache; //!< Thread handles
+    #ifdef _OPENMP
+    #pragma omp threadprivate(m_handles_owner, m_handles_cache)
+    #endif
 };
 
 #endif /* GLATRESPONSE_HPP */
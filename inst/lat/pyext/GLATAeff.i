@@ -61,6 +61,7 @@ public:
     int          size(void) const;
     int          nenergies(void) const;
     int          ncostheta(void) const;
+    double       energy(const int& ie) const;
     double       costhetamin(void) const;
     void         costhetamin(const double& ctheta);
     bool         hasphi(void) const;
@@ -61,7 +61,7 @@ public:
     void              ontime(const double& ontime);
     const GTime&      time(void) const;
     const GSkymap&    map(void) const;
-    const GNodeArray& enodes(void);
+    const GNodeArray& enodes(void) const;
     const double&     ontime(void) const;
     int               nx(void) const;
     int               ny(void) const;
@@ -70,6 +70,7 @@ public:
     int               ndiffrsp(void) const;
     std::string       diffname(const int& index) const;
     GSkymap*          diffrsp(const int& index) const;
+    int               diffindex(const std::string& name) const;
     double            maxrad(const GSkyDir& dir) const;
 };
 
@@ -50,24 +50,28 @@ public:
     virtual ~GLATMeanPsf(void);
 
     // Operators
-    double       operator()(const double& offset, const double& logE);
+    double       operator()(const double& offset, const double& logE) const;
 
     // Methods
     void         clear(void);
     GLATMeanPsf* clone(void) const;
     int          size(void) const;
     void         set(const GSkyDir& dir, const GLATObservation& obs);
+    bool         isvalid(const GSkyDir& dir, const GLATObservation& obs) const;
     int          noffsets(void) const;
     int          nenergies(void) const;
-    double       offset(const int& inx);
-    double       energy(const int& inx);
+    double       offset(const int& inx) const;
+    double       energy(const int& inx) const;
     GSkyDir      dir(void) const;
     std::string  name(void) const;
     void         name(const std::string& name);
+    std::string  irf(void) const;
     double       thetamax(void) const;
     void         thetamax(const double& value);
-    double       psf(const double& offset, const double& logE);
-    double       exposure(const double& logE);
+    double       psf(const double& offset, const double& logE) const;
+    double       exposure(const double& logE) const;
+    void         read(const GFitsTable& table);
+    void         write(GFits& file) const;
 };
 
 
@@ -70,6 +70,11 @@ public:
     void        save(const std::string& rspname) const;
     bool        force_mean(void);
     void        force_mean(const bool& value);
+    int         nmeanpsfs(void) const;
+    void        meanpsfs(const GModels& models, const GObservation& obs);
+    void        load_meanpsfs(const std::string& filename);
+    void        save_meanpsfs(const std::string& filename,
+                              const bool& clobber = false) const;
 
     // Reponse methods
     double irf(const GLATEventAtom& event,
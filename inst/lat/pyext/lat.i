@@ -57,6 +57,7 @@
 %import(module="gammalib.obs") "GPointing.i";
 %import(module="gammalib.obs") "GInstDir.i";
 %import(module="gammalib.obs") "GRoi.i";
+%import(module="gammalib.model") "GModels.i";
 
 /* __ LAT ________________________________________________________________ */
 %include "GLATAeff.i"
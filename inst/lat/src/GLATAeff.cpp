@@ -47,6 +47,9 @@
 
 /* __ Constants __________________________________________________________ */
 
+/* __ Globals ____________________________________________________________ */
+static unsigned long long int g_aeff_last_id = 0; //!< Last content identifier
+
 
 /*==========================================================================
  =                                                                         =
@@ -351,6 +354,12 @@ void GLATAeff::read(const GFits* fits)
         //
     }
 
+    // Set new content identifier
+    #pragma omp critical(GLATAeff_id)
+    {
+        m_id = ++g_aeff_last_id;
+    }
+
     // Return
     return;
 }
@@ -530,6 +539,7 @@ void GLATAeff::init_members(void)
     m_back       = false;
     m_eff_func1  = NULL;
     m_eff_func2  = NULL;
+    m_id         = 0;
 
     // Return
     return;
@@ -549,6 +559,7 @@ void GLATAeff::copy_members(const GLATAeff& aeff)
     m_min_ctheta = aeff.m_min_ctheta;
     m_front      = aeff.m_front;
     m_back       = aeff.m_back;
+    m_id         = aeff.m_id;
 
     // Clone functors
     m_eff_func1 = (aeff.m_eff_func1 != NULL) ? aeff.m_eff_func1->clone() : NULL;
@@ -541,6 +541,53 @@ GSkymap* GLATEventCube::diffrsp(const int& index) const
 }
 
 
+/***********************************************************************//**
+ * @brief Return index of diffuse model
+ *
+ * @param[in] name Name of diffuse model.
+ * @return Diffuse model index (-1 if no source map exists for the model).
+ *
+ * Returns the index of the source map of a diffuse model. The index is
+ * looked up in a map that is built when the source maps are read, which
+ * avoids a linear search over all source map names.
+ ***************************************************************************/
+int GLATEventCube::diffindex(const std::string& name) const
+{
+    // Initialise index
+    int index = -1;
+
+    // Search model name
+    std::map<std::string,int>::const_iterator it = m_srcmap_index.find(name);
+    if (it != m_srcmap_index.end()) {
+        index = it->second;
+    }
+
+    // Return index
+    return index;
+}
+
+
+/***********************************************************************//**
+ * @brief Set energy nodes
+ *
+ * @param[in] enodes Energy nodes (log10 of energy in MeV).
+ *
+ * Sets the energy nodes of the source maps and updates the energy layer
+ * node handles.
+ ***************************************************************************/
+void GLATEventCube::enodes(const GNodeArray& enodes)
+{
+    // Set energy nodes
+    m_enodes = enodes;
+
+    // Update energy layer node handles
+    set_ehandles();
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Computes the maximum radius (in degrees) around a given source
  *        direction that fits spatially into the event cube
@@ -620,6 +667,8 @@ void GLATEventCube::init_members(void)
     m_srcmap.clear();
     m_srcmap_names.clear();
     m_enodes.clear();
+    m_srcmap_index.clear();
+    m_ehandles.clear();
     m_dirs.clear();
     m_omega.clear();
     m_energies.clear(); 
@@ -646,6 +695,8 @@ void GLATEventCube::copy_members(const GLATEventCube& cube)
     m_srcmap       = cube.m_srcmap;
     m_srcmap_names = cube.m_srcmap_names;
     m_enodes       = cube.m_enodes;
+    m_srcmap_index = cube.m_srcmap_index;
+    m_ehandles     = cube.m_ehandles;
     m_dirs         = cube.m_dirs;
     m_omega        = cube.m_omega;
     m_energies     = cube.m_energies;
@@ -734,6 +785,7 @@ void GLATEventCube::read_srcmap(const GFitsImage* hdu)
         }
 
         // Append source map to list of maps
+        m_srcmap_index[hdu->extname()] = m_srcmap.size();
         m_srcmap.push_back(map);
         m_srcmap_names.push_back(hdu->extname());
 
@@ -823,11 +875,23 @@ void GLATEventCube::set_directions(void)
     m_dirs.reserve(npix());
     m_omega.reserve(npix());
 
+    // Compute sky directions of all pixels at once
+    int                 num = npix();
+    std::vector<int>    pixels(num);
+    std::vector<double> ra(num);
+    std::vector<double> dec(num);
+    for (int i = 0; i < num; ++i) {
+        pixels[i] = i;
+    }
+    m_map.pix2dir(&(pixels[0]), num, &(ra[0]), &(dec[0]));
+
     // Set pixel directions and solid angles
-    for (int iy = 0; iy < ny(); ++iy) {
-        for (int ix = 0; ix < nx(); ++ix) {
+    for (int iy = 0, i = 0; iy < ny(); ++iy) {
+        for (int ix = 0; ix < nx(); ++ix, ++i) {
             GSkyPixel pixel = GSkyPixel(double(ix), double(iy));
-            m_dirs.push_back(GLATInstDir(m_map.xy2dir(pixel)));
+            GSkyDir   dir;
+            dir.radec_deg(ra[i], dec[i]);
+            m_dirs.push_back(GLATInstDir(dir));
             m_omega.push_back(m_map.omega(pixel));
         }
     }
@@ -870,12 +934,40 @@ void GLATEventCube::set_energies(void)
         m_enodes.append(log10(ebounds().emin(i).MeV()));
     }
     m_enodes.append(log10(ebounds().emax(ebins()-1).MeV()));
+
+    // Setup energy layer node handles
+    set_ehandles();
     
     // Return
     return;
 }
 
 
+/***********************************************************************//**
+ * @brief Set energy layer node handles
+ *
+ * Computes for each energy layer of the event cube the source map node
+ * indices and weighting factors for the log mean energy of the layer. The
+ * handles are only set if energy nodes and bin energies exist.
+ ***************************************************************************/
+void GLATEventCube::set_ehandles(void)
+{
+    // Clear old handles
+    m_ehandles.clear();
+
+    // Compute handles if energy nodes and bin energies exist
+    if (m_enodes.size() > 1 && m_energies.size() > 0) {
+        m_ehandles.reserve(m_energies.size());
+        for (int i = 0; i < m_energies.size(); ++i) {
+            m_ehandles.push_back(m_enodes.locate(m_energies[i].log10MeV()));
+        }
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Set mean event time and ontime of event cube.
  *
@@ -432,6 +432,46 @@ void GLATLtCube::save(const std::string& filename, bool clobber) const
 }
 
 
+/***********************************************************************//**
+ * @brief Precompute exposure cubes for effective area
+ *
+ * @param[in] aeff Effective area.
+ *
+ * Precomputes the exposure cube for the effective area, and if the
+ * effective area has efficiency factors, also the efficiency corrected
+ * exposure cube. Subsequent exposure computations for the effective area
+ * then only require a linear interpolation in energy.
+ *
+ * @see GLATLtCubeMap::precompute
+ ***************************************************************************/
+void GLATLtCube::precompute(const GLATAeff& aeff)
+{
+    // Precompute exposure cube
+    m_exposure.precompute(aeff);
+
+    // Optionally precompute efficiency corrected exposure cube
+    if (aeff.hasefficiency()) {
+        m_weighted_exposure.precompute(aeff);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Signal if exposure cube exists for effective area
+ *
+ * @param[in] aeff Effective area.
+ * @return True if an exposure cube has been precomputed.
+ ***************************************************************************/
+bool GLATLtCube::hasexposure(const GLATAeff& aeff) const
+{
+    // Return
+    return (m_exposure.hasexposure(aeff));
+}
+
+
 /***********************************************************************//**
  * @brief Print livetime cube information
  *
@@ -28,6 +28,7 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <cmath>
 #include "GLATLtCubeMap.hpp"
 #include "GTools.hpp"
 #include "GMath.hpp"
@@ -145,15 +146,15 @@ GLATLtCubeMap& GLATLtCubeMap::operator= (const GLATLtCubeMap& map)
  ***************************************************************************/
 double GLATLtCubeMap::operator() (const GSkyDir& dir, _ltcube_ctheta fct)
 {
-    // Get map index
-    int pixel = m_map.dir2pix(dir);
+    // Get pointer to livetimes of pixel
+    const double* livetime = &(m_livetime[m_map.dir2pix(dir) * m_map.nmaps()]);
 
     // Initialise sum
     double sum = 0.0;
 
     // Loop over zenith angles
     for (int i = 0; i < m_num_ctheta; ++i)
-        sum += m_map(pixel, i) * (*fct)(costheta(i));
+        sum += livetime[i] * (*fct)(m_costheta[i]);
 
     // Return sum
     return sum;
@@ -182,8 +183,8 @@ double GLATLtCubeMap::operator() (const GSkyDir& dir, _ltcube_ctheta fct)
  ***************************************************************************/
 double GLATLtCubeMap::operator() (const GSkyDir& dir, _ltcube_ctheta_phi fct)
 {
-    // Get map index
-    int pixel = m_map.dir2pix(dir);
+    // Get pointer to livetimes of pixel
+    const double* livetime = &(m_livetime[m_map.dir2pix(dir) * m_map.nmaps()]);
 
     // Initialise sum
     double sum = 0.0;
@@ -192,9 +193,9 @@ double GLATLtCubeMap::operator() (const GSkyDir& dir, _ltcube_ctheta_phi fct)
     // with m_num_ctheta as the first m_num_ctheta maps correspond to an
     // evaluation without any phi-dependence.
     for (int iphi = 0, i = m_num_ctheta; iphi < m_num_phi; ++iphi) {
-        double p = phi(iphi);
+        double p = m_phi[iphi];
         for (int itheta = 0; itheta < m_num_ctheta; ++itheta, ++i) {
-            sum += m_map(pixel, i) * (*fct)(costheta(itheta), p);
+            sum += livetime[i] * (*fct)(m_costheta[itheta], p);
         }
     }
 
@@ -227,36 +228,65 @@ double GLATLtCubeMap::operator() (const GSkyDir& dir, _ltcube_ctheta_phi fct)
  * most rapidely varying parameter and with the first map starting at
  * index m_num_ctheta (the first m_num_ctheta maps are the livetime cube
  * maps without any \f$\phi\f$ dependence).
+ *
+ * If an exposure cube has been precomputed for the effective area using
+ * precompute() and if the energy lies within the energy nodes of the
+ * cube, the exposure is obtained by linear interpolation of the cube.
  ***************************************************************************/
 double GLATLtCubeMap::operator() (const GSkyDir& dir, const GEnergy& energy,
                                   const GLATAeff& aeff)
 {
-    // Get map index
+    // Get pixel index
     int pixel = m_map.dir2pix(dir);
 
+    // Get log10 of energy
+    double logE = energy.log10MeV();
+
     // Initialise sum
     double sum = 0.0;
 
-    // Circumvent const correctness
-    GLATAeff* fct = ((GLATAeff*)&aeff);
-
-    // If livetime cube and response have phi dependence then sum over
-    // zenith and azimuth. Note that the map index starts with m_num_ctheta
-    // as the first m_num_ctheta maps correspond to an evaluation without
-    // any phi-dependence.
-    if (hasphi() && aeff.hasphi()) {
-        for (int iphi = 0, i = m_num_ctheta; iphi < m_num_phi; ++iphi) {
-            double p = phi(iphi);
-            for (int itheta = 0; itheta < m_num_ctheta; ++itheta, ++i)
-                sum += m_map(pixel, i) * (*fct)(energy.log10MeV(), costheta(i), p);
-        }
+    // If an exposure cube exists for the effective area and if the energy
+    // is within the energy nodes of the cube then interpolate the
+    // exposure linearly in energy
+    int icube = exposure_index(aeff);
+    if (icube != -1 &&
+        logE >= m_exp_logE[icube][0] &&
+        logE <= m_exp_logE[icube][m_exp_logE[icube].size()-1]) {
+        const GNodeArray&  nodes    = m_exp_logE[icube];
+        GNodeArray::handle handle   = nodes.locate(logE);
+        const double*      exposure = &(m_exp_cube[icube][pixel * nodes.size()]);
+        sum = handle.wgt_left()  * exposure[handle.inx_left()] +
+              handle.wgt_right() * exposure[handle.inx_right()];
     }
 
-    // ... otherwise sum only over zenith angle
+    // ... otherwise sum over the livetime bins
     else {
-        for (int i = 0; i < m_num_ctheta; ++i)
-            sum += m_map(pixel, i) * (*fct)(energy.log10MeV(), costheta(i));
-    }
+
+        // Get pointer to livetimes of pixel
+        const double* livetime = &(m_livetime[pixel * m_map.nmaps()]);
+
+        // Circumvent const correctness
+        GLATAeff* fct = ((GLATAeff*)&aeff);
+
+        // If livetime cube and response have phi dependence then sum over
+        // zenith and azimuth. Note that the map index starts with
+        // m_num_ctheta as the first m_num_ctheta maps correspond to an
+        // evaluation without any phi-dependence.
+        if (hasphi() && aeff.hasphi()) {
+            for (int iphi = 0, i = m_num_ctheta; iphi < m_num_phi; ++iphi) {
+                double p = m_phi[iphi];
+                for (int itheta = 0; itheta < m_num_ctheta; ++itheta, ++i)
+                    sum += livetime[i] * (*fct)(logE, m_costheta[itheta], p);
+            }
+        }
+
+        // ... otherwise sum only over zenith angle
+        else {
+            for (int i = 0; i < m_num_ctheta; ++i)
+                sum += livetime[i] * (*fct)(logE, m_costheta[i]);
+        }
+
+    } // endelse: summed over livetime bins
 
     // Return sum
     return sum;
@@ -290,8 +320,8 @@ double GLATLtCubeMap::operator() (const GSkyDir& dir, const GEnergy& energy,
                                   const double& offset, const GLATPsf& psf,
                                   const GLATAeff& aeff)
 {
-    // Get map index
-    int pixel = m_map.dir2pix(dir);
+    // Get pointer to livetimes of pixel
+    const double* livetime = &(m_livetime[m_map.dir2pix(dir) * m_map.nmaps()]);
 
     // Initialise sum
     double sum = 0.0;
@@ -309,18 +339,22 @@ double GLATLtCubeMap::operator() (const GSkyDir& dir, const GEnergy& energy,
     // any phi-dependence.
     if (hasphi() && aeff.hasphi()) {
         for (int iphi = 0, i = m_num_ctheta; iphi < m_num_phi; ++iphi) {
-            double p = phi(iphi);
-            for (int itheta = 0; itheta < m_num_ctheta; ++itheta, ++i)
-                sum += m_map(pixel, i) * (*faeff)(logE, costheta(i), p) *
-                       (*fpsf)(offset, logE, costheta(i));
+            double p = m_phi[iphi];
+            for (int itheta = 0; itheta < m_num_ctheta; ++itheta, ++i) {
+                double ctheta = m_costheta[itheta];
+                sum += livetime[i] * (*faeff)(logE, ctheta, p) *
+                       (*fpsf)(offset, logE, ctheta);
+            }
         }
     }
 
     // ... otherwise sum only over zenith angle
     else {
-        for (int i = 0; i < m_num_ctheta; ++i)
-            sum += m_map(pixel, i) * (*faeff)(logE, costheta(i)) *
-                   (*fpsf)(offset, logE, costheta(i));
+        for (int i = 0; i < m_num_ctheta; ++i) {
+            double ctheta = m_costheta[i];
+            sum += livetime[i] * (*faeff)(logE, ctheta) *
+                   (*fpsf)(offset, logE, ctheta);
+        }
     }
 
     // Return sum
@@ -383,6 +417,9 @@ void GLATLtCubeMap::read(const GFitsTable* hdu)
     m_num_phi    = hdu->integer("PHIBINS");
     m_min_ctheta = hdu->real("COSMIN");
 
+    // Set pixel-major livetimes and bin values
+    set_livetime();
+
     // Return
     return;
 }
@@ -486,6 +523,116 @@ std::string GLATLtCubeMap::costhetabin(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Precompute exposure cube for effective area
+ *
+ * @param[in] aeff Effective area.
+ *
+ * Computes the livetime weighted effective area
+ * \f[\sum_{\cos \theta, \phi} T_{\rm live}(\cos \theta, \phi)
+ *    A_{\rm eff}(\log E_k, \cos \theta, \phi)\f]
+ * for all pixels of the livetime cube map and for all energy nodes
+ * \f$E_k\f$ of the effective area. As the effective area is linearly
+ * interpolated in \f$\log E\f$ between the energy nodes, the exposure for
+ * an energy within the node range follows from linear interpolation of the
+ * exposure cube.
+ *
+ * The exposure cube is attached to the content of the effective area and
+ * to its minimum cos theta value. An existing exposure cube for the same
+ * effective area is replaced. The method does nothing if the effective
+ * area has less than two energy nodes.
+ ***************************************************************************/
+void GLATLtCubeMap::precompute(const GLATAeff& aeff)
+{
+    // Continue only if effective area has been loaded and has at least two
+    // energy nodes
+    if (aeff.id() != 0 && aeff.nenergies() > 1) {
+
+        // Set energy nodes
+        int                 nenergy = aeff.nenergies();
+        std::vector<double> logE(nenergy);
+        for (int ie = 0; ie < nenergy; ++ie) {
+            logE[ie] = std::log10(aeff.energy(ie));
+        }
+
+        // Circumvent const correctness
+        GLATAeff* fct = ((GLATAeff*)&aeff);
+
+        // Tabulate effective area for all energy nodes and livetime bins.
+        // If the livetime cube and the response have phi dependence then
+        // the table spans the zenith and azimuth angle bins that start at
+        // map index m_num_ctheta, otherwise it spans the zenith angle bins.
+        bool usephi = (hasphi() && aeff.hasphi());
+        int  nbins  = (usephi) ? m_num_ctheta * m_num_phi : m_num_ctheta;
+        int  start  = (usephi) ? m_num_ctheta : 0;
+        std::vector<double> table(nenergy * nbins, 0.0);
+        for (int ie = 0; ie < nenergy; ++ie) {
+            double* row = &(table[ie * nbins]);
+            if (usephi) {
+                for (int iphi = 0, i = 0; iphi < m_num_phi; ++iphi) {
+                    for (int itheta = 0; itheta < m_num_ctheta; ++itheta, ++i) {
+                        row[i] = (*fct)(logE[ie], m_costheta[itheta], m_phi[iphi]);
+                    }
+                }
+            }
+            else {
+                for (int i = 0; i < m_num_ctheta; ++i) {
+                    row[i] = (*fct)(logE[ie], m_costheta[i]);
+                }
+            }
+        }
+
+        // Compute exposure cube
+        int                 npix  = m_map.npix();
+        int                 nmaps = m_map.nmaps();
+        std::vector<double> cube(npix * nenergy, 0.0);
+        #pragma omp parallel for schedule(static)
+        for (int pixel = 0; pixel < npix; ++pixel) {
+            const double* livetime = &(m_livetime[pixel * nmaps + start]);
+            double*       exposure = &(cube[pixel * nenergy]);
+            for (int ie = 0; ie < nenergy; ++ie) {
+                const double* row = &(table[ie * nbins]);
+                double        sum = 0.0;
+                for (int i = 0; i < nbins; ++i) {
+                    sum += livetime[i] * row[i];
+                }
+                exposure[ie] = sum;
+            }
+        }
+
+        // Store exposure cube, replacing any existing cube
+        int icube = exposure_index(aeff);
+        if (icube == -1) {
+            m_exp_id.push_back(aeff.id());
+            m_exp_ctheta.push_back(aeff.costhetamin());
+            m_exp_logE.push_back(GNodeArray(logE));
+            m_exp_cube.push_back(cube);
+        }
+        else {
+            m_exp_logE[icube] = GNodeArray(logE);
+            m_exp_cube[icube] = cube;
+        }
+
+    } // endif: effective area was valid
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Signal if exposure cube exists for effective area
+ *
+ * @param[in] aeff Effective area.
+ * @return True if an exposure cube has been precomputed.
+ ***************************************************************************/
+bool GLATLtCubeMap::hasexposure(const GLATAeff& aeff) const
+{
+    // Return
+    return (exposure_index(aeff) != -1);
+}
+
+
 /***********************************************************************//**
  * @brief Print lifetime cube map information
  *
@@ -517,6 +664,8 @@ std::string GLATLtCubeMap::print(const GChatter& chatter) const
         }
         result.append("\n"+gammalib::parformat("Minimum cos theta") +
                       gammalib::str(costhetamin()));
+        result.append("\n"+gammalib::parformat("Exposure cubes") +
+                      gammalib::str(int(m_exp_cube.size())));
         result.append("\n"+m_map.print(chatter));
 
     } // endif: chatter was not silent
@@ -543,6 +692,13 @@ void GLATLtCubeMap::init_members(void)
     m_num_phi    = 0;
     m_min_ctheta = 0.0;
     m_sqrt_bin   = true;
+    m_livetime.clear();
+    m_costheta.clear();
+    m_phi.clear();
+    m_exp_id.clear();
+    m_exp_ctheta.clear();
+    m_exp_logE.clear();
+    m_exp_cube.clear();
 
     // Return
     return;
@@ -562,6 +718,13 @@ void GLATLtCubeMap::copy_members(const GLATLtCubeMap& map)
     m_num_phi    = map.m_num_phi;
     m_min_ctheta = map.m_min_ctheta;
     m_sqrt_bin   = map.m_sqrt_bin;
+    m_livetime   = map.m_livetime;
+    m_costheta   = map.m_costheta;
+    m_phi        = map.m_phi;
+    m_exp_id     = map.m_exp_id;
+    m_exp_ctheta = map.m_exp_ctheta;
+    m_exp_logE   = map.m_exp_logE;
+    m_exp_cube   = map.m_exp_cube;
 
     // Return
     return;
@@ -576,3 +739,72 @@ void GLATLtCubeMap::free_members(void)
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Set pixel-major livetimes and bin values
+ *
+ * Copies the livetimes from the sky map into an array where the livetimes
+ * of all maps of a given pixel are contiguous, and precomputes the cos
+ * theta and phi values of the bins.
+ ***************************************************************************/
+void GLATLtCubeMap::set_livetime(void)
+{
+    // Get dimensions
+    int npix  = m_map.npix();
+    int nmaps = m_map.nmaps();
+
+    // Set pixel-major livetimes
+    m_livetime.assign(npix * nmaps, 0.0);
+    const double* pixels = m_map.pixels();
+    for (int map = 0; map < nmaps; ++map) {
+        const double* src = pixels + map * npix;
+        for (int pixel = 0; pixel < npix; ++pixel) {
+            m_livetime[pixel * nmaps + map] = src[pixel];
+        }
+    }
+
+    // Set cos theta values
+    m_costheta.clear();
+    m_costheta.reserve(m_num_ctheta);
+    for (int i = 0; i < m_num_ctheta; ++i) {
+        m_costheta.push_back(costheta(i));
+    }
+
+    // Set phi values
+    m_phi.clear();
+    m_phi.reserve(m_num_phi);
+    for (int i = 0; i < m_num_phi; ++i) {
+        m_phi.push_back(phi(i));
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return index of exposure cube for effective area
+ *
+ * @param[in] aeff Effective area.
+ * @return Index of exposure cube (-1 if not found).
+ ***************************************************************************/
+int GLATLtCubeMap::exposure_index(const GLATAeff& aeff) const
+{
+    // Initialise index
+    int index = -1;
+
+    // Search exposure cube
+    if (aeff.id() != 0) {
+        for (int i = 0; i < m_exp_id.size(); ++i) {
+            if (m_exp_id[i] == aeff.id() &&
+                m_exp_ctheta[i] == aeff.costhetamin()) {
+                index = i;
+                break;
+            }
+        }
+    }
+
+    // Return index
+    return index;
+}
@@ -32,6 +32,9 @@
 #include "GLATMeanPsf.hpp"
 #include "GTools.hpp"
 #include "GMath.hpp"
+#include "GFits.hpp"
+#include "GFitsBinTable.hpp"
+#include "GFitsTableDoubleCol.hpp"
 #include "GLATAeff.hpp"
 #include "GLATPsf.hpp"
 #include "GLATObservation.hpp"
@@ -41,6 +44,7 @@
 /* __ Method name definitions ____________________________________________ */
 #define G_SET                  "GLATMeanPsf::set(GSkyDir&, GLATObservation&)"
 #define G_EXPOSURE                              "GLATMeanPsf::exposure(int&)"
+#define G_READ                            "GLATMeanPsf::read(GFitsTable&)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -170,7 +174,7 @@ GLATMeanPsf& GLATMeanPsf::operator= (const GLATMeanPsf& psf)
  * A zero value is returned if the offset angle is equal or larger than
  * 70 degrees or if \f$\log E\f$ is not positive.
  ***************************************************************************/
-double GLATMeanPsf::operator() (const double& offset, const double& logE)
+double GLATMeanPsf::operator() (const double& offset, const double& logE) const
 {
     // Initialise response
     double value = 0.0;
@@ -178,58 +182,39 @@ double GLATMeanPsf::operator() (const double& offset, const double& logE)
     // Continue only if arguments are within valid range
     if (offset < 70.0 && logE > 0.0) {
 
-        // Flag no change of values
-        //bool change = false;
-
-        // Set offset interpolation
-        //if (offset != m_last_offset) {
-            m_offset.set_value(offset);
-        //    m_last_offset = offset;
-        //    change        = true;
-        //}
-
-        // Set energy interpolation
-        //if (logE != m_last_energy) {
-            m_energy.set_value(logE);
-        //    m_last_energy = logE;
-        //    change        = true;
-        //}
-
-        // If change occured then update interpolation indices and weighting
-        // factors
-        //if (change) {
-
-            // Set energy indices for exposure computation
-            m_inx1_exp = m_energy.inx_left();
-            m_inx2_exp = m_energy.inx_right();
-
-            // Set energy indices for PSF computation
-            int inx_energy_left  = m_inx1_exp  * noffsets();
-            int inx_energy_right = m_inx2_exp * noffsets();
-            
-            // Set array indices for bi-linear interpolation
-            m_inx1 = m_offset.inx_left()  + inx_energy_left;
-            m_inx2 = m_offset.inx_left()  + inx_energy_right;
-            m_inx3 = m_offset.inx_right() + inx_energy_left;
-            m_inx4 = m_offset.inx_right() + inx_energy_right;
-
-            // Set weighting factors for bi-linear interpolation
-            m_wgt1 = m_offset.wgt_left()  * m_energy.wgt_left();
-            m_wgt2 = m_offset.wgt_left()  * m_energy.wgt_right();
-            m_wgt3 = m_offset.wgt_right() * m_energy.wgt_left();
-            m_wgt4 = m_offset.wgt_right() * m_energy.wgt_right();
-
-        //} // endif: logE or ctheta changed
+        // Get interpolation handles for offset and energy
+        GNodeArray::handle h_offset = m_offset.locate(offset);
+        GNodeArray::handle h_energy = m_energy.locate(logE);
+
+        // Set energy indices for exposure computation
+        int inx1_exp = h_energy.inx_left();
+        int inx2_exp = h_energy.inx_right();
+
+        // Set energy indices for PSF computation
+        int inx_energy_left  = inx1_exp * noffsets();
+        int inx_energy_right = inx2_exp * noffsets();
+
+        // Set array indices for bi-linear interpolation
+        int inx1 = h_offset.inx_left()  + inx_energy_left;
+        int inx2 = h_offset.inx_left()  + inx_energy_right;
+        int inx3 = h_offset.inx_right() + inx_energy_left;
+        int inx4 = h_offset.inx_right() + inx_energy_right;
+
+        // Set weighting factors for bi-linear interpolation
+        double wgt1 = h_offset.wgt_left()  * h_energy.wgt_left();
+        double wgt2 = h_offset.wgt_left()  * h_energy.wgt_right();
+        double wgt3 = h_offset.wgt_right() * h_energy.wgt_left();
+        double wgt4 = h_offset.wgt_right() * h_energy.wgt_right();
 
         // Compute energy dependent exposure and map corrections
-        double fac_left  = m_exposure[m_inx1_exp] * m_mapcorr[m_inx1_exp];
-        double fac_right = m_exposure[m_inx2_exp] * m_mapcorr[m_inx2_exp];
+        double fac_left  = m_exposure[inx1_exp] * m_mapcorr[inx1_exp];
+        double fac_right = m_exposure[inx2_exp] * m_mapcorr[inx2_exp];
 
         // Perform bi-linear interpolation
-        value = m_wgt1 * m_psf[m_inx1] * fac_left  +
-                m_wgt2 * m_psf[m_inx2] * fac_right +
-                m_wgt3 * m_psf[m_inx3] * fac_left  +
-                m_wgt4 * m_psf[m_inx4] * fac_right;
+        value = wgt1 * m_psf[inx1] * fac_left  +
+                wgt2 * m_psf[inx2] * fac_right +
+                wgt3 * m_psf[inx3] * fac_left  +
+                wgt4 * m_psf[inx4] * fac_right;
 
         // Optionally check for negative values
         #if G_SIGNAL_NEGATIVE_MEAN_PSF
@@ -307,6 +292,13 @@ int GLATMeanPsf::size(void) const
  * a given sky location. The PSF is computed for all bin boundaries of the
  * observation, hence if there are N energy bins there will be N+1 energies
  * at which the mean PSF is computed.
+ *
+ * The energies are distributed over the available threads. As the
+ * interpolation of the effective area and the PSF is not thread safe, each
+ * thread works on its own copies of the effective areas and PSFs of the
+ * response. The computation is limited to zenith angles < m_theta_max on
+ * these copies, hence the response of the observation is not modified and
+ * several mean PSFs may be computed in parallel.
  ***************************************************************************/
 void GLATMeanPsf::set(const GSkyDir& dir, const GLATObservation& obs)
 {
@@ -328,22 +320,9 @@ void GLATMeanPsf::set(const GSkyDir& dir, const GLATObservation& obs)
     // Get energy boundaries
     GEbounds ebds = obs.events()->ebounds();
 
-    // Store source direction
+    // Store source direction and response name
     m_dir = dir;
-
-    // Limit computation to zenith angles < m_theta_max (typically 70
-    // degrees - this is the hardwired value in the ST). For this purpose
-    // set the costhetamin parameter of Aeff to m_theta_max. Store also the
-    // original values in a vector for later restoration.
-    std::vector<double> save_costhetamin;
-    for (int i = 0; i < rsp->size(); ++i) {
-        save_costhetamin.push_back(rsp->aeff(i)->costhetamin());
-        rsp->aeff(i)->costhetamin(cos(m_theta_max*gammalib::deg2rad));
-    }
-    
-    // Allocate room for arrays
-    m_psf.reserve(size());
-    m_exposure.reserve(m_energy.size());
+    m_irf = rsp->rspname();
 
     // Set energy nodes from the bin boundaries of the observations energy
     // boundaries. Store the energy nodes locally as GEnergy objects and
@@ -357,38 +336,68 @@ void GLATMeanPsf::set(const GSkyDir& dir, const GLATObservation& obs)
         energy.push_back(ebds.emax(i));
     }
 
-    // Loop over energies
-    for (int ieng = 0; ieng < energy.size(); ++ieng) {
+    // Allocate room for arrays
+    int nenergy = energy.size();
+    int noffset = m_offset.size();
+    m_psf.assign(nenergy*noffset, 0.0);
+    m_exposure.assign(nenergy, 0.0);
+
+    // Limit computation to zenith angles < m_theta_max (typically 70
+    // degrees - this is the hardwired value in the ST). For this purpose
+    // the costhetamin parameter of the Aeff copies is set to m_theta_max.
+    double costhetamin = std::cos(m_theta_max*gammalib::deg2rad);
+
+    // Compute mean PSF and exposure in parallel
+    #pragma omp parallel
+    {
+        // Allocate thread-private copies of effective areas and PSFs
+        std::vector<GLATAeff*> aeff;
+        std::vector<GLATPsf*>  psf;
+        for (int i = 0; i < rsp->size(); ++i) {
+            aeff.push_back(rsp->aeff(i)->clone());
+            psf.push_back(rsp->psf(i)->clone());
+            aeff[i]->costhetamin(costhetamin);
+        }
+
+        // Loop over energies
+        #pragma omp for schedule(dynamic)
+        for (int ieng = 0; ieng < nenergy; ++ieng) {
 
-        // Compute exposure by looping over the responses
-        double exposure = 0.0;
-        for (int i = 0; i < rsp->size(); ++i)
-            exposure += (*ltcube)(dir, energy[ieng], *rsp->aeff(i));
+            // Compute exposure by looping over the responses
+            double exposure = 0.0;
+            for (int i = 0; i < aeff.size(); ++i)
+                exposure += (*ltcube)(dir, energy[ieng], *aeff[i]);
 
-        // Set exposure
-        m_exposure.push_back(exposure);
+            // Set exposure
+            m_exposure[ieng] = exposure;
 
-        // Loop over all offset angles
-        for (int ioffset = 0; ioffset < m_offset.size(); ++ioffset) {
+            // Loop over all offset angles
+            for (int ioffset = 0; ioffset < noffset; ++ioffset) {
 
-            // Compute point spread function by looping over the responses
-            double psf = 0.0;
-            for (int i = 0; i < rsp->size(); ++i)
-                psf += (*ltcube)(dir, energy[ieng], m_offset[ioffset],
-                                 *rsp->psf(i), *rsp->aeff(i));
+                // Compute point spread function by looping over the
+                // responses
+                double value = 0.0;
+                for (int i = 0; i < aeff.size(); ++i)
+                    value += (*ltcube)(dir, energy[ieng], m_offset[ioffset],
+                                       *psf[i], *aeff[i]);
 
-            // Normalize PSF by exposure and clip when exposure drops to 0
-            psf = (exposure > 0.0) ? psf/exposure : 0.0;
+                // Normalize PSF by exposure and clip when exposure drops
+                // to 0
+                value = (exposure > 0.0) ? value/exposure : 0.0;
 
-            // Set PSF value
-            m_psf.push_back(psf);
+                // Set PSF value
+                m_psf[ieng*noffset+ioffset] = value;
 
-        } // endfor: looped over offsets
-    } // endfor: looped over energies
+            } // endfor: looped over offsets
+        } // endfor: looped over energies
 
-    // Restore initial Aeff zenith angle restriction
-    for (int i = 0; i < rsp->size(); ++i)
-        rsp->aeff(i)->costhetamin(save_costhetamin[i]);
+        // Free thread-private copies
+        for (int i = 0; i < aeff.size(); ++i) {
+            delete aeff[i];
+            delete psf[i];
+        }
+
+    } // end pragma omp parallel
 
     // Compute map corrections
     set_map_corrections(obs);
@@ -398,6 +407,46 @@ void GLATMeanPsf::set(const GSkyDir& dir, const GLATObservation& obs)
 }
 
 
+/***********************************************************************//**
+ * @brief Check whether mean PSF is valid for source and observation
+ *
+ * @param[in] dir Source location.
+ * @param[in] obs LAT observation.
+ * @return True if mean PSF can be used for source and observation.
+ *
+ * A mean PSF is valid if it has been computed for the specified source
+ * direction, for the instrument response function of the observation, and
+ * for the energy bin boundaries of the observation.
+ ***************************************************************************/
+bool GLATMeanPsf::isvalid(const GSkyDir& dir, const GLATObservation& obs) const
+{
+    // Check source direction and response
+    bool valid = (m_dir.dist_deg(dir) < 1.0e-6 && obs.response() != NULL &&
+                  obs.response()->rspname() == m_irf);
+
+    // Check energy nodes
+    if (valid && obs.events() != NULL) {
+        GEbounds ebds = obs.events()->ebounds();
+        if (m_energy.size() != ebds.size()+1 || m_psf.size() != size()) {
+            valid = false;
+        }
+        else {
+            for (int i = 0; i < m_energy.size(); ++i) {
+                double logE = (i == 0) ? ebds.emin(0).log10MeV()
+                                       : ebds.emax(i-1).log10MeV();
+                if (std::abs(m_energy[i] - logE) > 1.0e-6) {
+                    valid = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Return validity
+    return valid;
+}
+
+
 /***********************************************************************//**
  * @brief Return mean PSF value
  *
@@ -412,7 +461,7 @@ void GLATMeanPsf::set(const GSkyDir& dir, const GLATObservation& obs)
  * A zero value is returned if the offset angle is equal or larger than
  * 70 degrees or if \f$\log E\f$ is not positive.
  ***************************************************************************/
-double GLATMeanPsf::psf(const double& offset, const double& logE)
+double GLATMeanPsf::psf(const double& offset, const double& logE) const
 {
     // Initialise response
     double value = 0.0;
@@ -420,58 +469,39 @@ double GLATMeanPsf::psf(const double& offset, const double& logE)
     // Continue only if arguments are within valid range
     if (offset < 70.0 && logE > 0.0) {
 
-        // Flag no change of values
-        //bool change = false;
-
-        // Set offset interpolation
-        //if (offset != m_last_offset) {
-            m_offset.set_value(offset);
-        //    m_last_offset = offset;
-        //    change        = true;
-        //}
-
-        // Set energy interpolation
-        //if (logE != m_last_energy) {
-            m_energy.set_value(logE);
-        //    m_last_energy = logE;
-        //    change        = true;
-        //}
-
-        // If change occured then update interpolation indices and weighting
-        // factors
-        //if (change) {
-
-            // Set energy indices for exposure computation
-            m_inx1_exp = m_energy.inx_left();
-            m_inx2_exp = m_energy.inx_right();
-
-            // Set energy indices
-            int inx_energy_left  = m_energy.inx_left()  * noffsets();
-            int inx_energy_right = m_energy.inx_right() * noffsets();
-            
-            // Set array indices for bi-linear interpolation
-            m_inx1 = m_offset.inx_left()  + inx_energy_left;
-            m_inx2 = m_offset.inx_left()  + inx_energy_right;
-            m_inx3 = m_offset.inx_right() + inx_energy_left;
-            m_inx4 = m_offset.inx_right() + inx_energy_right;
-
-            // Set weighting factors for bi-linear interpolation
-            m_wgt1 = m_offset.wgt_left()  * m_energy.wgt_left();
-            m_wgt2 = m_offset.wgt_left()  * m_energy.wgt_right();
-            m_wgt3 = m_offset.wgt_right() * m_energy.wgt_left();
-            m_wgt4 = m_offset.wgt_right() * m_energy.wgt_right();
-
-        //} // endif: logE or ctheta changed
+        // Get interpolation handles for offset and energy
+        GNodeArray::handle h_offset = m_offset.locate(offset);
+        GNodeArray::handle h_energy = m_energy.locate(logE);
+
+        // Set energy indices for exposure computation
+        int inx1_exp = h_energy.inx_left();
+        int inx2_exp = h_energy.inx_right();
+
+        // Set energy indices for PSF computation
+        int inx_energy_left  = inx1_exp * noffsets();
+        int inx_energy_right = inx2_exp * noffsets();
+
+        // Set array indices for bi-linear interpolation
+        int inx1 = h_offset.inx_left()  + inx_energy_left;
+        int inx2 = h_offset.inx_left()  + inx_energy_right;
+        int inx3 = h_offset.inx_right() + inx_energy_left;
+        int inx4 = h_offset.inx_right() + inx_energy_right;
+
+        // Set weighting factors for bi-linear interpolation
+        double wgt1 = h_offset.wgt_left()  * h_energy.wgt_left();
+        double wgt2 = h_offset.wgt_left()  * h_energy.wgt_right();
+        double wgt3 = h_offset.wgt_right() * h_energy.wgt_left();
+        double wgt4 = h_offset.wgt_right() * h_energy.wgt_right();
 
         // Compute energy dependentmap corrections
-        double fac_left  = m_mapcorr[m_inx1_exp];
-        double fac_right = m_mapcorr[m_inx2_exp];
+        double fac_left  = m_mapcorr[inx1_exp];
+        double fac_right = m_mapcorr[inx2_exp];
 
         // Perform bi-linear interpolation
-        value = m_wgt1 * m_psf[m_inx1] * fac_left  +
-                m_wgt2 * m_psf[m_inx2] * fac_right +
-                m_wgt3 * m_psf[m_inx3] * fac_left  +
-                m_wgt4 * m_psf[m_inx4] * fac_right;
+        value = wgt1 * m_psf[inx1] * fac_left  +
+                wgt2 * m_psf[inx2] * fac_right +
+                wgt3 * m_psf[inx3] * fac_left  +
+                wgt4 * m_psf[inx4] * fac_right;
 
         // Optionally check for negative values
         #if G_SIGNAL_NEGATIVE_MEAN_PSF
@@ -499,7 +529,7 @@ double GLATMeanPsf::psf(const double& offset, const double& logE)
  * \f$\log E\f$ is the logarithm of base 10 of the energy in MeV.
  * A zero value is returned if \f$\log E\f$ is not positive.
  ***************************************************************************/
-double GLATMeanPsf::exposure(const double& logE)
+double GLATMeanPsf::exposure(const double& logE) const
 {
     // Initialise response
     double value = 0.0;
@@ -507,17 +537,12 @@ double GLATMeanPsf::exposure(const double& logE)
     // Continue only if arguments are within valid range
     if (logE > 0.0) {
 
-        // Set energy interpolation
-        //if (logE != m_last_energy) {
-            m_energy.set_value(logE);
-        //    m_last_energy = logE;
-            m_inx1_exp    = m_energy.inx_left();
-            m_inx2_exp    = m_energy.inx_right();
-        //}
+        // Get interpolation handle for energy
+        GNodeArray::handle h_energy = m_energy.locate(logE);
 
         // Perform linear interpolation
-        value = m_energy.wgt_left()  * m_exposure[m_inx1_exp] +
-                m_energy.wgt_right() * m_exposure[m_inx2_exp];
+        value = h_energy.wgt_left()  * m_exposure[h_energy.inx_left()] +
+                h_energy.wgt_right() * m_exposure[h_energy.inx_right()];
 
     } // endif: arguments were in valid range
 
@@ -526,6 +551,121 @@ double GLATMeanPsf::exposure(const double& logE)
 }
 
 
+/***********************************************************************//**
+ * @brief Read mean PSF from FITS table
+ *
+ * @param[in] table FITS table.
+ *
+ * @exception GException::invalid_value
+ *            Number of offset angles in table is incompatible.
+ *
+ * Reads the mean PSF from a FITS binary table that has been written using
+ * the write() method.
+ ***************************************************************************/
+void GLATMeanPsf::read(const GFitsTable& table)
+{
+    // Clear instance
+    clear();
+
+    // Read source name, direction and response name
+    m_name      = table.string("SRCNAME");
+    m_irf       = table.string("IRF");
+    m_theta_max = table.real("THETAMAX");
+    m_dir.radec_deg(table.real("RA"), table.real("DEC"));
+
+    // Get columns
+    const GFitsTableCol& col_energy   = table["ENERGY"];
+    const GFitsTableCol& col_exposure = table["EXPOSURE"];
+    const GFitsTableCol& col_mapcorr  = table["MAPCORR"];
+    const GFitsTableCol& col_psf      = table["PSF"];
+
+    // Check that the number of offset angles is compatible
+    if (col_psf.number() != noffsets()) {
+        std::string msg = "Table contains "+gammalib::str(col_psf.number())+
+                          " offset angles while "+gammalib::str(noffsets())+
+                          " are expected.";
+        throw GException::invalid_value(G_READ, msg);
+    }
+
+    // Read energies, exposure, map corrections and mean PSF
+    int nenergy = table.nrows();
+    m_exposure.reserve(nenergy);
+    m_mapcorr.reserve(nenergy);
+    m_psf.reserve(nenergy*noffsets());
+    for (int ieng = 0; ieng < nenergy; ++ieng) {
+        m_energy.append(col_energy.real(ieng));
+        m_exposure.push_back(col_exposure.real(ieng));
+        m_mapcorr.push_back(col_mapcorr.real(ieng));
+        for (int ioffset = 0; ioffset < noffsets(); ++ioffset) {
+            m_psf.push_back(col_psf.real(ieng, ioffset));
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Write mean PSF into FITS file
+ *
+ * @param[in] file FITS file.
+ *
+ * Appends the mean PSF as binary table to the FITS file. The table has one
+ * row per energy node, with columns for the log10 of the energy in MeV, the
+ * exposure, the map correction, and the mean PSF values for all offset
+ * angles. The source name, the source direction and the name of the
+ * instrument response function are written as header keywords.
+ ***************************************************************************/
+void GLATMeanPsf::write(GFits& file) const
+{
+    // Set number of energies and offset angles
+    int nenergy = nenergies();
+    int noffset = noffsets();
+
+    // Allocate columns
+    GFitsTableDoubleCol col_energy   = GFitsTableDoubleCol("ENERGY", nenergy);
+    GFitsTableDoubleCol col_exposure = GFitsTableDoubleCol("EXPOSURE", nenergy);
+    GFitsTableDoubleCol col_mapcorr  = GFitsTableDoubleCol("MAPCORR", nenergy);
+    GFitsTableDoubleCol col_psf      = GFitsTableDoubleCol("PSF", nenergy, noffset);
+
+    // Fill columns
+    for (int ieng = 0; ieng < nenergy; ++ieng) {
+        col_energy(ieng)   = m_energy[ieng];
+        col_exposure(ieng) = m_exposure[ieng];
+        col_mapcorr(ieng)  = (m_mapcorr.size() == nenergy) ? m_mapcorr[ieng] : 1.0;
+        for (int ioffset = 0; ioffset < noffset; ++ioffset) {
+            col_psf(ieng, ioffset) = m_psf[ieng*noffset+ioffset];
+        }
+    }
+    col_energy.unit("log10(MeV)");
+    col_exposure.unit("s cm2");
+
+    // Allocate binary table
+    GFitsBinTable table = GFitsBinTable(nenergy);
+
+    // Append columns
+    table.append_column(col_energy);
+    table.append_column(col_exposure);
+    table.append_column(col_mapcorr);
+    table.append_column(col_psf);
+
+    // Set header keywords
+    table.extname("MEANPSF");
+    table.card("SRCNAME", m_name, "Source name");
+    table.card("RA", m_dir.ra_deg(), "[deg] Source Right Ascension");
+    table.card("DEC", m_dir.dec_deg(), "[deg] Source Declination");
+    table.card("IRF", m_irf, "Instrument response function");
+    table.card("THETAMAX", m_theta_max, "[deg] Maximum zenith angle");
+
+    // Append table to FITS file
+    file.append(table);
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Print lifetime cube information
  *
@@ -563,6 +703,7 @@ std::string GLATMeanPsf::print(const GChatter& chatter) const
 
         // Append information
         result.append("\n"+gammalib::parformat("Source name")+name());
+        result.append("\n"+gammalib::parformat("Response")+irf());
         result.append("\n"+gammalib::parformat("Source direction"));
         result.append(gammalib::str(m_dir.ra_deg()));
         result.append(", ");
@@ -602,24 +743,13 @@ void GLATMeanPsf::init_members(void)
     // Initialise members
     m_name.clear();
     m_dir.clear();
+    m_irf.clear();
     m_psf.clear();
     m_exposure.clear();
     m_mapcorr.clear();
     m_energy.clear();
     m_offset.clear();
     m_theta_max   = 70.0;  //!< Maximum zenith angle
-    m_last_energy = -1.0;
-    m_last_offset = -1.0;
-    m_inx1_exp    = 0;
-    m_inx2_exp    = 0;
-    m_inx1        = 0;
-    m_inx2        = 0;
-    m_inx3        = 0;
-    m_inx4        = 0;
-    m_wgt1        = 0.0;
-    m_wgt2        = 0.0;
-    m_wgt3        = 0.0;
-    m_wgt4        = 0.0;
 
     // Set offset array
     set_offsets();
@@ -639,24 +769,13 @@ void GLATMeanPsf::copy_members(const GLATMeanPsf& psf)
     // Copy members
     m_name        = psf.m_name;
     m_dir         = psf.m_dir;
+    m_irf         = psf.m_irf;
     m_psf         = psf.m_psf;
     m_exposure    = psf.m_exposure;
     m_mapcorr     = psf.m_mapcorr;
     m_energy      = psf.m_energy;
     m_offset      = psf.m_offset;
     m_theta_max   = psf.m_theta_max;
-    m_last_energy = psf.m_last_energy;
-    m_last_offset = psf.m_last_offset;
-    m_inx1_exp    = psf.m_inx1_exp;
-    m_inx2_exp    = psf.m_inx2_exp;
-    m_inx1        = psf.m_inx1;
-    m_inx2        = psf.m_inx2;
-    m_inx3        = psf.m_inx3;
-    m_inx4        = psf.m_inx4;
-    m_wgt1        = psf.m_wgt1;
-    m_wgt2        = psf.m_wgt2;
-    m_wgt3        = psf.m_wgt3;
-    m_wgt4        = psf.m_wgt4;
 
     // Return
     return;
@@ -729,30 +848,40 @@ void GLATMeanPsf::set_map_corrections(const GLATObservation& obs)
         double radius = cube->maxrad(m_dir);
         if (radius > 0.0) {
 
-            // Initialise sum over pixels
-            std::vector<double> sum(m_energy.size(), 0.0);
-
-            // Loop over all event cube spatial pixels
+            // Collect offset angles and solid angles of all event cube
+            // spatial pixels within maximum PSF radius
+            std::vector<double> offsets;
+            std::vector<double> omegas;
             for (int iy = 0; iy < cube->ny(); ++iy) {
                 for (int ix = 0; ix < cube->nx(); ++ix) {
 
                     // Compute offset angle in degrees
                     GSkyPixel pixel  = GSkyPixel(double(ix), double(iy));
                     double    offset = cube->map().xy2dir(pixel).dist_deg(m_dir);
-                    double    omega  = cube->map().omega(pixel);
 
                     // Use only pixels within maximum PSF radius
                     if (offset <= radius) {
-
-                        // Accumulate energy dependent pixel sum
-                        for (int ieng = 0; ieng < m_energy.size(); ++ieng)
-                            sum[ieng] += psf(offset, m_energy[ieng]) * omega;
-                        
-                    } // endif: pixel was within maximum PSF radius
+                        offsets.push_back(offset);
+                        omegas.push_back(cube->map().omega(pixel));
+                    }
 
                 } // endfor: looped over latitude pixels
             } // endfor: looped over longitude pixels
 
+            // Compute energy dependent pixel sums. The energies are
+            // distributed over the available threads.
+            int                 nenergy = m_energy.size();
+            int                 npixels = offsets.size();
+            std::vector<double> sum(nenergy, 0.0);
+            #pragma omp parallel for schedule(dynamic)
+            for (int ieng = 0; ieng < nenergy; ++ieng) {
+                double value = 0.0;
+                for (int i = 0; i < npixels; ++i) {
+                    value += psf(offsets[i], m_energy[ieng]) * omegas[i];
+                }
+                sum[ieng] = value;
+            }
+
             // Compute map correction
             for (int ieng = 0; ieng < m_energy.size(); ++ieng) {
                 if (sum[ieng] > 0.0) {
@@ -774,15 +903,15 @@ void GLATMeanPsf::set_map_corrections(const GLATObservation& obs)
  * @param[in] offsetmax Maximum offset angle.
  * @param[in] logE log10 of energy in MeV.
  ***************************************************************************/
-double GLATMeanPsf::integral(const double& offsetmax, const double& logE)
+double GLATMeanPsf::integral(const double& offsetmax, const double& logE) const
 {
-    // Set energy and offset interpolation weigths
-    m_energy.set_value(logE);
-    m_offset.set_value(offsetmax);
+    // Get energy and offset interpolation handles
+    GNodeArray::handle h_energy = m_energy.locate(logE);
+    GNodeArray::handle h_offset = m_offset.locate(offsetmax);
 
     // Get PSF array offsets
-    int inx_energy_left  = m_energy.inx_left()  * noffsets();
-    int inx_energy_right = m_energy.inx_right() * noffsets();
+    int inx_energy_left  = h_energy.inx_left()  * noffsets();
+    int inx_energy_right = h_energy.inx_right() * noffsets();
 
     // Initialise integrals
     double int_left  = 0.0;
@@ -809,10 +938,10 @@ double GLATMeanPsf::integral(const double& offsetmax, const double& logE)
         else {
             double theta_min = m_offset[i] * gammalib::deg2rad;
             double theta_max = offsetmax   * gammalib::deg2rad;
-            double psf_left  = m_psf[inx_energy_left+i]    * m_offset.wgt_left() +
-                               m_psf[inx_energy_left+i+1]  * m_offset.wgt_right();
-            double psf_right = m_psf[inx_energy_right+i]   * m_offset.wgt_left() +
-                               m_psf[inx_energy_right+i+1] * m_offset.wgt_right();                               
+            double psf_left  = m_psf[inx_energy_left+i]    * h_offset.wgt_left() +
+                               m_psf[inx_energy_left+i+1]  * h_offset.wgt_right();
+            double psf_right = m_psf[inx_energy_right+i]   * h_offset.wgt_left() +
+                               m_psf[inx_energy_right+i+1] * h_offset.wgt_right();                               
             int_left  += 0.5 * (m_psf[inx_energy_left+i] * sin(theta_min) +
                                 psf_left                 * sin(theta_max)) *
                                (theta_max - theta_min);
@@ -823,8 +952,8 @@ double GLATMeanPsf::integral(const double& offsetmax, const double& logE)
             // Debug option: Dump integral computation results
             #if G_DEBUG_INTEGRAL
             std::cout << "offsetmax=" << offsetmax;
-            std::cout << " offset.left=" << m_offset.inx_left();
-            std::cout << " offset.right=" << m_offset.inx_right();
+            std::cout << " offset.left=" << h_offset.inx_left();
+            std::cout << " offset.right=" << h_offset.inx_right();
             std::cout << " i=" << i;
             std::cout << " psf_left=" << psf_left;
             std::cout << " psf_right=" << psf_right;
@@ -837,8 +966,8 @@ double GLATMeanPsf::integral(const double& offsetmax, const double& logE)
     } // endfor: looped over offset angles
 
     // Interpolate now in energy
-    double integral = gammalib::twopi * (m_energy.wgt_left()  * int_left +
-                                         m_energy.wgt_right() * int_right);
+    double integral = gammalib::twopi * (h_energy.wgt_left()  * int_left +
+                                         h_energy.wgt_right() * int_right);
 
     // Debug option: Dump integral computation results
     #if G_DEBUG_INTEGRAL
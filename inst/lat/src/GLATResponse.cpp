@@ -35,7 +35,9 @@
 #include "GFits.hpp"
 #include "GTools.hpp"
 #include "GCaldb.hpp"
+#include "GModelSky.hpp"
 #include "GModelSpatialPointSource.hpp"
+#include "GFitsTable.hpp"
 #include "GLATInstDir.hpp"
 #include "GLATResponse.hpp"
 #include "GLATObservation.hpp"
@@ -44,6 +46,11 @@
 #include "GLATEventCube.hpp"
 #include "GLATException.hpp"
 
+/* __ Static members _____________________________________________________ */
+static unsigned long g_handles_id = 0;  //!< Last assigned handles identifier
+unsigned long              GLATResponse::m_handles_owner = 0;
+GLATResponse::srchandles*  GLATResponse::m_handles_cache = NULL;
+
 /* __ Method name definitions ____________________________________________ */
 #define G_CALDB                           "GLATResponse::caldb(std::string&)"
 #define G_LOAD                             "GLATResponse::load(std::string&)"
@@ -52,6 +59,7 @@
 #define G_AEFF                                     "GLATResponse::aeff(int&)"
 #define G_PSF                                       "GLATResponse::psf(int&)"
 #define G_EDISP                                   "GLATResponse::edisp(int&)"
+#define G_MEANPSFS          "GLATResponse::meanpsfs(GModels&, GObservation&)"
 #define G_IRF_ATOM     "GLATResponse::irf(GLATEventAtom&, GModel&, GEnergy&,"\
                                                      "GTime&, GObservation&)"
 #define G_IRF_BIN       "GLATResponse::irf(GLATEventBin&, GModel&, GEnergy&,"\
@@ -241,44 +249,13 @@ double GLATResponse::irf(const GEvent&       event,
     const GSkyDir& srcDir = photon.dir();
     const GEnergy& srcEng = photon.energy();
 
-    // Search for mean PSF
-    int ipsf = -1;
-    for (int i = 0; i < m_ptsrc.size(); ++i) {
-        if (m_ptsrc[i]->dir() == srcDir) {
-            ipsf = i;
-            break;
-        }
-    }
-
-    // If mean PSF has not been found then create it now
-    if (ipsf == -1) {
-
-        // Allocate new mean PSF
-        GLATMeanPsf* psf = new GLATMeanPsf(srcDir, static_cast<const GLATObservation&>(obs));
-
-        // Set source name
-        std::string name = "SRC("+gammalib::str(srcDir.ra_deg()) +
-                                "," +
-                                gammalib::str(srcDir.dec_deg())+")";
-        psf->name(name);
-
-        // Push mean PSF on stack
-        const_cast<GLATResponse*>(this)->m_ptsrc.push_back(psf);
-
-        // Set index of mean PSF
-        ipsf = m_ptsrc.size()-1;
-
-        // Debug option: dump mean PSF
-        #if G_DUMP_MEAN_PSF
-        std::cout << "Added new mean PSF \""+name+"\"" << std::endl;
-        std::cout << *psf << std::endl;
-        #endif
-
-    } // endif: created new mean PSF
+    // Get mean PSF
+    const GLATMeanPsf* psf = meanpsf("", srcDir,
+                             static_cast<const GLATObservation&>(obs));
 
     // Get IRF value
     double offset = dir->dist_deg(srcDir);
-    double irf    = (*m_ptsrc[ipsf])(offset, srcEng.log10MeV());
+    double irf    = (*psf)(offset, srcEng.log10MeV());
 
     // Return IRF value
     return irf;
@@ -359,8 +336,11 @@ double GLATResponse::irf(const GLATEventAtom& event,
  *
  * @todo Extract event cube from observation. We do not need the cube
  *       pointer in the event anymore.
- * @todo Implement more efficient method for response search (name search is
- *       not very rapid).
+ * Source map and mean PSF are looked up using a source handle that is
+ * resolved once per source name (see source_handle()). The source map
+ * interpolation weights are taken from the energy layer handles of the
+ * event cube.
+ *
  * @todo Instead of calling "offset = event.dir().dist_deg(srcDir)" we can
  *       precompute and store for each PSF the offsets. This should save
  *       quite some time since the distance computation is time
@@ -383,21 +363,19 @@ double GLATResponse::irf(const GLATEventBin& event,
     // Get source energy
     GEnergy srcEng = source.energy();
 
-    // Search for diffuse response in event cube
-    int idiff = -1;
-    for (int i = 0; i < cube->ndiffrsp(); ++i) {
-        if (cube->diffname(i) == source.name()) {
-            idiff = i;
-            break;
-        }
-    }
+    // Get source handle
+    srchandle handle = source_handle(event, source, obs);
+    int       idiff  = handle.idiff;
 
     // If diffuse response has been found then get response from source map
     if (idiff != -1) {
 
-        // Get srcmap indices and weighting factors
-        GNodeArray nodes = cube->enodes();
-        nodes.set_value(srcEng.log10MeV());
+        // Get srcmap indices and weighting factors. If the source energy is
+        // the energy of the event bin then use the precomputed handle of
+        // the energy layer.
+        GNodeArray::handle nodes = (srcEng == event.energy())
+                                   ? cube->ehandle(event.ieng())
+                                   : cube->enodes().locate(srcEng.log10MeV());
 
         // Compute diffuse response
         GSkymap* map    = cube->diffrsp(idiff);
@@ -415,43 +393,13 @@ double GLATResponse::irf(const GLATEventBin& event,
     // then return response from mean PSF
     if ((idiff == -1 || m_force_mean) && ptsrc != NULL) {
 
-        // Search for mean PSF
-        int ipsf = -1;
-        for (int i = 0; i < m_ptsrc.size(); ++i) {
-            if (m_ptsrc[i]->name() == source.name()) {
-                ipsf = i;
-                break;
-            }
-        }
-
-        // If mean PSF has not been found then create it now
-        if (ipsf == -1) {
-
-            // Allocate new mean PSF
-            GLATMeanPsf* psf = 
-                new GLATMeanPsf(ptsrc->dir(), static_cast<const GLATObservation&>(obs));
-
-            // Set source name
-            psf->name(source.name());
-
-            // Push mean PSF on stack
-            const_cast<GLATResponse*>(this)->m_ptsrc.push_back(psf);
-
-            // Set index of mean PSF
-            ipsf = m_ptsrc.size()-1;
-
-            // Debug option: dump mean PSF
-            #if G_DUMP_MEAN_PSF 
-            std::cout << "Added new mean PSF \""+source.name() << "\"" << std::endl;
-            std::cout << *psf << std::endl;
-            #endif
-
-        } // endif: created new mean PSF
+        // Get mean PSF
+        const GLATMeanPsf* psf = handle.psf;
 
         // Get PSF value
-        GSkyDir srcDir   = m_ptsrc[ipsf]->dir();
+        GSkyDir srcDir   = psf->dir();
         double  offset   = event.dir().dist_deg(srcDir);
-        double  mean_psf = (*m_ptsrc[ipsf])(offset, srcEng.log10MeV()) / (event.ontime());
+        double  mean_psf = (*psf)(offset, srcEng.log10MeV()) / (event.ontime());
 
         // Debug option: compare mean PSF to diffuse response
         #if G_DEBUG_MEAN_PSF
@@ -686,6 +634,198 @@ GLATEdisp* GLATResponse::edisp(const int& index) const
 }
 
 
+/***********************************************************************//**
+ * @brief Compute mean PSFs for all point sources
+ *
+ * @param[in] models Models.
+ * @param[in] obs LAT observation.
+ *
+ * @exception GException::invalid_argument
+ *            Observation is not a LAT observation.
+ * @exception GException::no_response
+ *            Response has not been defined.
+ * @exception GLATException::no_ltcube
+ *            Livetime cube has not been defined.
+ *
+ * Computes the mean PSFs for all point sources in the model container that
+ * apply to the observation, so that they need not to be computed lazily
+ * during the first likelihood evaluation. Point sources for which a valid
+ * mean PSF exists already (for example because the mean PSFs were loaded
+ * using load_meanpsfs()) are skipped. The point sources are distributed
+ * over the available threads.
+ ***************************************************************************/
+void GLATResponse::meanpsfs(const GModels& models, const GObservation& obs)
+{
+    // Get LAT observation
+    const GLATObservation* lat = dynamic_cast<const GLATObservation*>(&obs);
+    if (lat == NULL) {
+        std::string msg = "Observation is not a LAT observation.";
+        throw GException::invalid_argument(G_MEANPSFS, msg);
+    }
+
+    // Check that response and livetime cube exist so that no exceptions
+    // will be thrown in the parallel section
+    if (lat->response() == NULL) {
+        throw GException::no_response(G_MEANPSFS);
+    }
+    if (lat->ltcube() == NULL) {
+        throw GLATException::no_ltcube(G_MEANPSFS);
+    }
+
+    // Collect all point sources that have no valid mean PSF
+    std::vector<std::string> names;
+    std::vector<GSkyDir>     dirs;
+    std::vector<int>         slots;
+    for (int i = 0; i < models.size(); ++i) {
+
+        // Continue only if model is a point source that applies to the
+        // observation
+        const GModelSky* sky = dynamic_cast<const GModelSky*>(models[i]);
+        if (sky == NULL || !sky->isvalid(obs.instrument(), obs.id())) {
+            continue;
+        }
+        const GModelSpatialPointSource* ptsrc =
+              dynamic_cast<const GModelSpatialPointSource*>(sky->spatial());
+        if (ptsrc == NULL) {
+            continue;
+        }
+
+        // Search for existing mean PSF
+        int ipsf = -1;
+        for (int k = 0; k < m_ptsrc.size(); ++k) {
+            if (m_ptsrc[k]->name() == sky->name()) {
+                ipsf = k;
+                break;
+            }
+        }
+
+        // Skip source if existing mean PSF is valid
+        if (ipsf != -1 && m_ptsrc[ipsf]->isvalid(ptsrc->dir(), *lat)) {
+            continue;
+        }
+
+        // Add source
+        names.push_back(sky->name());
+        dirs.push_back(ptsrc->dir());
+        slots.push_back(ipsf);
+
+    } // endfor: looped over models
+
+    // Compute mean PSFs
+    int                       nsources = names.size();
+    std::vector<GLATMeanPsf*> psfs(nsources, NULL);
+    #pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < nsources; ++i) {
+        psfs[i] = new GLATMeanPsf(dirs[i], *lat);
+        psfs[i]->name(names[i]);
+    }
+
+    // Store mean PSFs. Invalid mean PSFs are replaced by assignment as
+    // copies of the response share the mean PSF pointers.
+    for (int i = 0; i < nsources; ++i) {
+        if (slots[i] != -1) {
+            *(m_ptsrc[slots[i]]) = *(psfs[i]);
+            delete psfs[i];
+        }
+        else {
+            m_ptsrc.push_back(psfs[i]);
+        }
+    }
+
+    // Reset source handles
+    reset_handles();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Load mean PSFs from FITS file
+ *
+ * @param[in] filename FITS file name.
+ *
+ * Loads all mean PSFs from the "MEANPSF" extensions of a FITS file that
+ * has been created by save_meanpsfs(). A mean PSF replaces any existing
+ * mean PSF with the same source name. Use meanpsfs() to recompute the mean
+ * PSFs that do not apply to a given observation.
+ ***************************************************************************/
+void GLATResponse::load_meanpsfs(const std::string& filename)
+{
+    // Open FITS file
+    GFits file(filename);
+
+    // Loop over all extensions
+    for (int extno = 1; extno < file.size(); ++extno) {
+
+        // Skip extensions that are no mean PSFs
+        if (file.hdu(extno)->extname() != "MEANPSF") {
+            continue;
+        }
+
+        // Read mean PSF
+        GLATMeanPsf psf;
+        psf.read(*file.table(extno));
+
+        // Replace existing mean PSF with same name or append mean PSF
+        int ipsf = -1;
+        for (int i = 0; i < m_ptsrc.size(); ++i) {
+            if (m_ptsrc[i]->name() == psf.name()) {
+                ipsf = i;
+                break;
+            }
+        }
+        if (ipsf != -1) {
+            *(m_ptsrc[ipsf]) = psf;
+        }
+        else {
+            m_ptsrc.push_back(psf.clone());
+        }
+
+    } // endfor: looped over extensions
+
+    // Close FITS file
+    file.close();
+
+    // Reset source handles
+    reset_handles();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Save mean PSFs into FITS file
+ *
+ * @param[in] filename FITS file name.
+ * @param[in] clobber Overwrite existing file?
+ *
+ * Saves all mean PSFs into a FITS file, with one "MEANPSF" extension per
+ * mean PSF.
+ ***************************************************************************/
+void GLATResponse::save_meanpsfs(const std::string& filename,
+                                 const bool&        clobber) const
+{
+    // Allocate FITS file
+    GFits file;
+
+    // Write mean PSFs
+    for (int i = 0; i < m_ptsrc.size(); ++i) {
+        m_ptsrc[i]->write(file);
+    }
+
+    // Save FITS file
+    file.saveto(filename, clobber);
+
+    // Close FITS file
+    file.close();
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Print Fermi-LAT response information
  *
@@ -741,6 +881,216 @@ std::string GLATResponse::print(const GChatter& chatter) const
  =                                                                         =
  ==========================================================================*/
 
+/***********************************************************************//**
+ * @brief Return mean PSF for point source
+ *
+ * @param[in] name Source name.
+ * @param[in] dir Source direction.
+ * @param[in] obs LAT observation.
+ * @return Pointer to mean PSF.
+ *
+ * Returns the mean PSF for a point source. The mean PSF is searched by
+ * source name, or by source direction if the source name is empty. If no
+ * mean PSF is found, a new mean PSF is computed and added to the response.
+ * In that case a source name that is derived from the source direction is
+ * set if the source name is empty.
+ *
+ * As the method may be called from several threads, the access to the
+ * mean PSFs is protected by a critical section. The mean PSF is computed
+ * outside the critical section, and only added if no other thread has
+ * added a mean PSF for the same source in the meantime.
+ ***************************************************************************/
+const GLATMeanPsf* GLATResponse::meanpsf(const std::string&     name,
+                                         const GSkyDir&         dir,
+                                         const GLATObservation& obs) const
+{
+    // Initialise mean PSF pointer
+    const GLATMeanPsf* result = NULL;
+
+    // Search for mean PSF
+    #pragma omp critical(GLATResponse_meanpsf)
+    {
+        result = search_meanpsf(name, dir);
+    }
+
+    // If mean PSF has not been found then create it now
+    if (result == NULL) {
+
+        // Allocate new mean PSF
+        GLATMeanPsf* psf = new GLATMeanPsf(dir, obs);
+
+        // Set source name
+        if (name.empty()) {
+            psf->name("SRC("+gammalib::str(dir.ra_deg()) + "," +
+                      gammalib::str(dir.dec_deg())+")");
+        }
+        else {
+            psf->name(name);
+        }
+
+        // Push mean PSF on stack if it has not been added in the meantime
+        #pragma omp critical(GLATResponse_meanpsf)
+        {
+            result = search_meanpsf(name, dir);
+            if (result == NULL) {
+                const_cast<GLATResponse*>(this)->m_ptsrc.push_back(psf);
+                result = psf;
+                psf    = NULL;
+            }
+        }
+
+        // Debug option: dump mean PSF
+        #if G_DUMP_MEAN_PSF
+        if (psf == NULL) {
+            std::cout << "Added new mean PSF \"" << result->name();
+            std::cout << "\"" << std::endl;
+            std::cout << *result << std::endl;
+        }
+        #endif
+
+        // Delete mean PSF if it was not used
+        if (psf != NULL) {
+            delete psf;
+        }
+
+    } // endif: created new mean PSF
+
+    // Return mean PSF
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Search mean PSF for point source
+ *
+ * @param[in] name Source name.
+ * @param[in] dir Source direction.
+ * @return Pointer to mean PSF (NULL if not found).
+ *
+ * Searches the mean PSF by source name, or by source direction if the
+ * source name is empty.
+ ***************************************************************************/
+const GLATMeanPsf* GLATResponse::search_meanpsf(const std::string& name,
+                                                const GSkyDir&     dir) const
+{
+    // Initialise mean PSF pointer
+    const GLATMeanPsf* result = NULL;
+
+    // Search for mean PSF
+    for (int i = 0; i < m_ptsrc.size(); ++i) {
+        if ((name.empty() && m_ptsrc[i]->dir() == dir) ||
+            (!name.empty() && m_ptsrc[i]->name() == name)) {
+            result = m_ptsrc[i];
+            break;
+        }
+    }
+
+    // Return mean PSF
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Return source handle
+ *
+ * @param[in] event Event bin.
+ * @param[in] source Source.
+ * @param[in] obs Observation.
+ * @return Source handle.
+ *
+ * Returns the source map index and the mean PSF that apply to a source.
+ * The handle is resolved on the first call for a given source name and
+ * event cube, and is then kept in a cache, so that subsequent calls do not
+ * need to search source maps and mean PSFs by name. A mean PSF is only
+ * resolved for point sources without source map, or if the use of mean
+ * PSFs is forced.
+ *
+ * Each thread has its own cache, hence no locking is needed for cache
+ * access. The caches are stored in the response under the address of a
+ * thread private variable, which differs for all threads that run at the
+ * same time, including threads of nested parallel regions. The location
+ * of the cache is memorised in thread private storage together with the
+ * identifier of the source handles of the response, hence the cache is
+ * only looked up in a critical section the first time a thread accesses
+ * it after reset_handles().
+ ***************************************************************************/
+GLATResponse::srchandle GLATResponse::source_handle(const GLATEventBin& event,
+                                                    const GSource&      source,
+                                                    const GObservation& obs) const
+{
+    // Get event cube
+    const GLATEventCube* cube = event.cube();
+
+    // Look up the cache of the calling thread if the thread has not yet
+    // accessed the source handles of this response
+    if (m_handles_owner != m_handles_id) {
+        #pragma omp critical(GLATResponse_source_handle)
+        m_handles_cache = &(m_handles[&m_handles_cache]);
+        m_handles_owner = m_handles_id;
+    }
+
+    // Initialise handle
+    srchandle handle;
+    bool      found = false;
+
+    // Search handle in cache
+    srchandles::const_iterator it = m_handles_cache->find(source.name());
+    if (it != m_handles_cache->end() && it->second.cube == cube) {
+        handle = it->second;
+        found  = true;
+    }
+
+    // Get pointer on point source spatial model
+    const GModelSpatialPointSource* ptsrc =
+          dynamic_cast<const GModelSpatialPointSource*>(source.model());
+
+    // Resolve handle if it was not found or if a mean PSF is needed that
+    // has not yet been resolved
+    bool resolve = !found || (ptsrc != NULL && handle.psf == NULL &&
+                              (handle.idiff == -1 || m_force_mean));
+    if (resolve) {
+
+        // Resolve source map index
+        handle.cube  = cube;
+        handle.idiff = cube->diffindex(source.name());
+
+        // Resolve mean PSF
+        if ((handle.idiff == -1 || m_force_mean) && ptsrc != NULL) {
+            handle.psf = meanpsf(source.name(), ptsrc->dir(),
+                                 static_cast<const GLATObservation&>(obs));
+        }
+
+        // Store handle
+        (*m_handles_cache)[source.name()] = handle;
+
+    } // endif: resolved handle
+
+    // Return handle
+    return handle;
+}
+
+
+/***********************************************************************//**
+ * @brief Reset source handles
+ *
+ * Clears the source handle caches of all threads and assigns a new
+ * identifier to the source handles of the response, which has never been
+ * used before by any response.
+ ***************************************************************************/
+void GLATResponse::reset_handles(void)
+{
+    // Clear caches
+    m_handles.clear();
+
+    // Draw new identifier
+    #pragma omp critical(GLATResponse_source_handle)
+    m_handles_id = ++g_handles_id;
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Initialise class members
  *
@@ -758,6 +1108,7 @@ void GLATResponse::init_members(void)
     m_psf.clear();
     m_edisp.clear();
     m_ptsrc.clear();
+    reset_handles();
     
     // By default use HANDOFF response database.
     char* handoff = std::getenv("HANDOFF_IRF_DIR");
@@ -788,6 +1139,9 @@ void GLATResponse::copy_members(const GLATResponse& rsp)
     m_edisp      = rsp.m_edisp;
     m_ptsrc      = rsp.m_ptsrc;
 
+    // Reset source handles
+    reset_handles();
+
     // Return
     return;
 }
@@ -31,6 +31,9 @@
 #include <stdlib.h>
 #include <iostream>
 #include <unistd.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "GLATLib.hpp"
 #include "GTools.hpp"
 #include "test_LAT.hpp"
@@ -507,6 +510,24 @@ void TestGLATObservation::test_one_binned_obs(const std::string& datadir, const
         test_try_failure(e);
     }
 
+    // Check source map index and energy layer handles
+    const GLATEventCube* cube = static_cast<const GLATEventCube*>(run.events());
+    for (int i = 0; i < cube->ndiffrsp(); ++i) {
+        test_value(cube->diffindex(cube->diffname(i)), i,
+                   "Check source map index of \""+cube->diffname(i)+"\"");
+    }
+    test_value(cube->diffindex("unknown source"), -1,
+               "Check source map index of unknown source");
+    for (int i = 0; i < cube->ebins(); ++i) {
+        GNodeArray::handle layer = cube->ehandle(i);
+        GNodeArray::handle node  =
+            cube->enodes().locate(cube->ebounds().elogmean(i).log10MeV());
+        test_value(layer.inx_left(), node.inx_left(),
+                   "Check left node of energy layer "+gammalib::str(i));
+        test_value(layer.wgt_left(), node.wgt_left(), 1.0e-10,
+                   "Check left weight of energy layer "+gammalib::str(i));
+    }
+
     // Add observation (twice) to data
     test_try("Append observation twice");
     try {
@@ -544,6 +565,47 @@ void TestGLATObservation::test_one_binned_obs(const std::string& datadir, const
         test_try_failure(e);
     }
 
+    // Test mean PSF FITS I/O
+    test_try("Test mean PSF FITS I/O");
+    try {
+        GSkyDir dir;
+        GLATMeanPsf psf(dir, run);
+        psf.name("Test");
+        GFits fits;
+        psf.write(fits);
+        fits.saveto("test_lat_meanpsf.fits", true);
+        GFits       file("test_lat_meanpsf.fits");
+        GLATMeanPsf psf_read;
+        psf_read.read(*file.table("MEANPSF"));
+        test_assert(psf_read.name() == "Test", "Check mean PSF name");
+        test_assert(psf_read.isvalid(dir, run), "Check mean PSF validity");
+        test_value(psf_read(0.1, 3.0), psf(0.1, 3.0), 1.0e-10,
+                   "Check mean PSF value");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Test precomputed exposure cube
+    test_try("Test exposure cube");
+    try {
+        GSkyDir dir;
+        GEnergy energy;
+        energy.GeV(1.0);
+        GLATLtCube* ltcube = run.ltcube();
+        GLATAeff*   aeff   = run.response()->aeff(0);
+        double      ref    = (*ltcube)(dir, energy, *aeff);
+        ltcube->precompute(*aeff);
+        test_assert(ltcube->hasexposure(*aeff), "Check exposure cube");
+        double exposure = (*ltcube)(dir, energy, *aeff);
+        test_value(exposure, ref, 1.0e-6*ref, "Check exposure");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Test XML loading
     test_try("Test XML loading");
     try {
@@ -682,6 +744,39 @@ void TestGLATOptimize::test_one_binned_optimizer(const std::string& datadir,
         test_try_failure(e);
     }
 
+    // Evaluate the model for a subset of event bins from more threads than
+    // the default number of threads, including nested parallel regions,
+    // using copies of the event bins as the event cube holds a single bin,
+    // and copies of the models as the model evaluation sets the gradients
+    const GLATEventCube* cube = static_cast<const GLATEventCube*>(run.events());
+    int                       nstep = cube->size() / 100 + 1;
+    std::vector<GLATEventBin> bins;
+    std::vector<double>       values;
+    for (int i = 0; i < cube->size(); i += nstep) {
+        bins.push_back(*((*cube)[i]));
+        values.push_back(run.model(obs.models(), bins.back()));
+    }
+    int nerrors = 0;
+    #ifdef _OPENMP
+    int nthreads = 2 * omp_get_max_threads() + 1;
+    int nlevels  = omp_get_max_active_levels();
+    omp_set_max_active_levels(2);
+    #pragma omp parallel for num_threads(nthreads) reduction(+:nerrors)
+    for (int i = 0; i < bins.size(); ++i) {
+        int nested = 0;
+        #pragma omp parallel num_threads(2) reduction(+:nested)
+        {
+            GModels models(obs.models());
+            if (run.model(models, bins[i]) != values[i]) {
+                nested++;
+            }
+        }
+        nerrors += nested;
+    }
+    omp_set_max_active_levels(nlevels);
+    #endif
+    test_value(nerrors, 0, "Check model values of threads");
+
     // Exit test
     return;
 
@@ -0,0 +1,64 @@
+/***************************************************************************
+ *               GAliasTable.i - Alias table sampling class                *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GAliasTable.i
+ * @brief Alias table sampling class Python interface definition
+ * @author Juergen Knoedlseder
+ */
+%{
+/* Put headers and other declarations here that are needed for compilation */
+#include "GAliasTable.hpp"
+#include "GTools.hpp"
+%}
+
+
+/***********************************************************************//**
+ * @class GAliasTable
+ *
+ * @brief Python interface for the alias table sampling class
+ ***************************************************************************/
+class GAliasTable : public GBase {
+
+public:
+    // Constructors and destructors
+    GAliasTable(void);
+    explicit GAliasTable(const std::vector<double>& weights);
+    GAliasTable(const GAliasTable& table);
+    virtual ~GAliasTable(void);
+
+    // Methods
+    void         clear(void);
+    GAliasTable* clone(void) const;
+    int          size(void) const;
+    bool         isempty(void) const;
+    void         set(const std::vector<double>& weights);
+    int          draw(GRan& ran) const;
+};
+
+
+/***********************************************************************//**
+ * @brief GAliasTable class extension
+ ***************************************************************************/
+%extend GAliasTable {
+    GAliasTable copy() {
+        return (*self);
+    }
+};
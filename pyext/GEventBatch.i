@@ -0,0 +1,79 @@
+/***************************************************************************
+ *               GEventBatch.i - Event list batch view class               *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GEventBatch.i
+ * @brief Event list batch view class Python interface definition
+ * @author Juergen Knoedlseder
+ */
+%{
+/* Put headers and other declarations here that are needed for compilation */
+#include "GEventBatch.hpp"
+#include "GTools.hpp"
+%}
+
+
+/***********************************************************************//**
+ * @class GEventBatch
+ *
+ * @brief Event list batch view class
+ ***************************************************************************/
+class GEventBatch : public GBase {
+public:
+    // Constructors and destructors
+    GEventBatch(void);
+    explicit GEventBatch(const GEventList& events,
+                         const int&        begin,
+                         const int&        end);
+    GEventBatch(const GEventBatch& batch);
+    virtual ~GEventBatch(void);
+
+    // Methods
+    void         clear(void);
+    GEventBatch* clone(void) const;
+    void         set(const GEventList& events,
+                     const int&        begin,
+                     const int&        end);
+    int          size(void) const;
+    bool         isempty(void) const;
+    const int&   begin(void) const;
+    const int&   end(void) const;
+};
+
+
+/***********************************************************************//**
+ * @brief GEventBatch class extension
+ ***************************************************************************/
+%extend GEventBatch {
+    const GEventAtom* __getitem__(const int& index) {
+        if (index >= 0 && index < self->size()) {
+            return (*self)[index];
+        }
+        else {
+            throw GException::out_of_range("__getitem__(int)", index, self->size());
+        }
+    }
+    int __len__() {
+        return (self->size());
+    }
+    GEventBatch copy() {
+        return (*self);
+    }
+};
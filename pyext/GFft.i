@@ -0,0 +1,75 @@
+/***************************************************************************
+ *                  GFft.i - Fast Fourier transform class                  *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFft.i
+ * @brief Fast Fourier transform class Python interface definition
+ * @author Juergen Knoedlseder
+ */
+%{
+/* Put headers and other declarations here that are needed for compilation */
+#include "GFft.hpp"
+#include "GTools.hpp"
+%}
+
+
+/***********************************************************************//**
+ * @class GFft
+ *
+ * @brief Fast Fourier transform class Python interface
+ ***************************************************************************/
+class GFft : public GBase {
+public:
+    // Constructors and destructors
+    GFft(void);
+    GFft(const int& nx, const int& ny = 1);
+    GFft(const GFft& fft);
+    virtual ~GFft(void);
+
+    // Methods
+    void       clear(void);
+    GFft*      clone(void) const;
+    int        size(void) const;
+    const int& nx(void) const;
+    const int& ny(void) const;
+    void       forward(void);
+    void       backward(void);
+    static int size2(const int& n);
+};
+
+
+/***********************************************************************//**
+ * @brief GFft class extension
+ ***************************************************************************/
+%extend GFft {
+    double real(const int& ix, const int& iy = 0) const {
+        return (*self)(ix, iy).real();
+    }
+    double imag(const int& ix, const int& iy = 0) const {
+        return (*self)(ix, iy).imag();
+    }
+    void set(const int& ix, const int& iy, const double& real,
+             const double& imag = 0.0) {
+        (*self)(ix, iy) = std::complex<double>(real, imag);
+    }
+    GFft copy() {
+        return (*self);
+    }
+};
@@ -36,7 +36,7 @@
  * @brief Integration class Python interface defintion.
  *
  * This class allows to perform integration using various methods. The
- * integrand is implemented by a derived class of GIntegrand.
+ * integrand is implemented by a derived class of GFunction.
  ***************************************************************************/
 class GIntegral : public GBase {
 public:
@@ -61,6 +61,8 @@ public:
     const GFunction* kernel(void) const;
     double           romb(double a, double b, int k = 5);
     double           trapzd(double a, double b, int n = 1, double result = 0.0);
+    double           gkq(double a, double b);
+    double           tanhsinh(double a, double b);
 };
 
 
@@ -92,6 +92,7 @@ public:
     GMatrixSparse abs(void) const;
     GMatrixSparse cholesky_decompose(bool compress = true);
     GVector       cholesky_solver(const GVector& vector, bool compress = true);
+    GMatrix       cholesky_solver(const GMatrix& matrix, bool compress = true);
     GMatrixSparse cholesky_invert(bool compress = true);
     void          set_mem_block(const int& block);
     void          stack_init(const int& size = 0, const int& entries = 0);
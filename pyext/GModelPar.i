@@ -96,6 +96,7 @@ public:
     void               name(const std::string& name);
     void               unit(const std::string& unit);
     void               autoscale(void);
+    const unsigned long& version(void) const;
     void               read(const GXmlElement& xml);
     void               write(GXmlElement& xml) const;
 };
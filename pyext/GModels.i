@@ -80,6 +80,8 @@ public:
     void     write(GXml& xml) const;
     double   eval(const GEvent& event, const GObservation& obs) const;
     double   eval_gradients(const GEvent& event, const GObservation& obs) const;
+    void     covariance(const GMatrixSymmetric& covariance);
+    const GMatrixSymmetric& covariance(void) const;
 };
 
 
@@ -75,16 +75,23 @@ public:
     virtual double        model(const GModels& models, const GEvent& event,
                                 GVector* gradient = NULL) const;
     virtual double        npred(const GModels& models, GVector* gradient = NULL) const;
+    virtual bool          threadsafe(void) const;
+    virtual void          thread_setup(const GModels& models) const;
 
     // Implemented methods
     void                  name(const std::string& name);
     void                  id(const std::string& id);
     void                  events(const GEvents* events);
     void                  statistics(const std::string& statistics);
+    void                  npred_kernel(const bool& kernel);
+    void                  model_cache(const bool& cache);
     const std::string&    name(void) const;
     const std::string&    id(void) const;
     const GEvents*        events(void) const;
     const std::string&    statistics(void) const;
+    const bool&           npred_kernel(void) const;
+    const bool&           model_cache(void) const;
+    void                  model_cache_update(const GModels& models) const;
 
     // Other methods
     virtual double model_grad(const GModel& model, const GEvent& event, int ipar) const;
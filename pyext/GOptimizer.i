@@ -50,6 +50,7 @@ public:
     virtual double      value(void) const = 0;
     virtual int         status(void) const = 0;
     virtual int         iter(void) const = 0;
+    virtual const GMatrixSymmetric& covariance(void) const = 0;
 };
 
 
@@ -0,0 +1,75 @@
+/***************************************************************************
+ *         GOptimizerLBFGSB.i - Bound constrained L-BFGS optimizer         *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GOptimizerLBFGSB.i
+ * @brief Bound constrained L-BFGS optimizer class Python interface definition
+ * @author Juergen Knoedlseder
+ */
+%{
+/* Put headers and other declarations here that are needed for compilation */
+#include "GOptimizerLBFGSB.hpp"
+#include "GTools.hpp"
+%}
+
+
+/***********************************************************************//**
+ * @class GOptimizerLBFGSB
+ *
+ * @brief GOptimizerLBFGSB class SWIG interface defintion.
+ ***************************************************************************/
+class GOptimizerLBFGSB : public GOptimizer {
+public:
+
+    // Constructors and destructors
+    GOptimizerLBFGSB(void);
+    GOptimizerLBFGSB(GLog& log);
+    GOptimizerLBFGSB(const GOptimizerLBFGSB& opt);
+    virtual ~GOptimizerLBFGSB(void);
+
+    // Implemented pure virtual methods
+    virtual void              clear(void);
+    virtual GOptimizerLBFGSB* clone(void) const;
+    virtual void              optimize(GOptimizerFunction& fct, GOptimizerPars& pars);
+    virtual double            value(void) const;
+    virtual int               status(void) const;
+    virtual int               iter(void) const;
+    virtual const GMatrixSymmetric& covariance(void) const;
+
+    // Methods
+    void          max_iter(const int& n);
+    void          max_linesearch(const int& n);
+    void          memory(const int& n);
+    void          eps(const double& eps);
+    int           max_iter(void) const;
+    int           max_linesearch(void) const;
+    int           memory(void) const;
+    const double& eps(void) const;
+};
+
+
+/***********************************************************************//**
+ * @brief GOptimizerLBFGSB class extension
+ ***************************************************************************/
+%extend GOptimizerLBFGSB {
+    GOptimizerLBFGSB copy() {
+        return (*self);
+    }
+};
@@ -51,6 +51,7 @@ public:
     virtual double        value(void) const;
     virtual int           status(void) const;
     virtual int           iter(void) const;
+    virtual const GMatrixSymmetric& covariance(void) const;
     
     // Methods
     void          max_iter(const int& n);
@@ -51,6 +51,7 @@ public:
     GRan*                  clone(void) const;
     void                   seed(unsigned long long int seed);
     unsigned long long int seed(void) const;
+    GRan                   stream(const unsigned long long int& id) const;
     unsigned long int      int32(void);
     unsigned long long int int64(void);
     double                 uniform(void);
@@ -70,6 +70,9 @@ public:
     virtual double irf_diffuse(const GEvent&       event,
                                const GSource&      source,
                                const GObservation& obs) const;
+    virtual double irf_gradients(const GEvent&       event,
+                                 const GSource&      source,
+                                 const GObservation& obs) const;
     virtual double npred(const GSource&      source,
                          const GObservation& obs) const;
     virtual double npred_ptsrc(const GSource&      source,
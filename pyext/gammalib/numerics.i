@@ -48,5 +48,8 @@
 /* __ Numerics module ____________________________________________________ */
 %include "GDerivative.i"
 %include "GFunction.i"
+%include "GFunctions.i"
 %include "GIntegral.i"
+%include "GIntegrals.i"
+%include "GFft.i"
 %include "GMath.i"
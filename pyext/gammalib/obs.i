@@ -60,6 +60,7 @@
 %include "GObservationRegistry.i"
 %include "GEvents.i"
 %include "GEventList.i"
+%include "GEventBatch.i"
 %include "GEventCube.i"
 %include "GEvent.i"
 %include "GEventAtom.i"
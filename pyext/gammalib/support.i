@@ -47,6 +47,7 @@
 %include "GException.i"
 %include "GTools.i"
 %include "GNodeArray.i"
+%include "GAliasTable.i"
 %include "GCsv.i"
 %include "GRan.i"
 %include "GUrl.i"
@@ -56,10 +56,13 @@
 #define __ffdcol(A, B, C) ffdcol(A, B, C)
 #define __ffdelt(A, B) ffdelt(A, B)
 #define __ffdrow(A, B, C, D) ffdrow(A, B, C, D)
+#define __ffflnm(A, B, C) ffflnm(A, B, C)
+#define __ffflsh(A, B, C) ffflsh(A, B, C)
 #define __ffgcv(A, B, C, D, E, F, G, H, I, J) ffgcv(A, B, C, D, E, F, G, H, I, J)
 #define __ffgcvb(A, B, C, D, E, F, G, H, I) ffgcvb(A, B, C, D, E, F, G, H, I)
 #define __ffgcvs(A, B, C, D, E, F, G, H, I) ffgcvs(A, B, C, D, E, F, G, H, I)
 #define __ffgerr(A, B) ffgerr(A, B)
+#define __ffghadll(A, B, C, D, E) ffghadll(A, B, C, D, E)
 #define __ffghdt(A, B, C) ffghdt(A, B, C)
 #define __ffghsp(A, B, C, D) ffghsp(A, B, C, D)
 #define __ffgidm(A, B, C) ffgidm(A, B, C)
@@ -91,6 +94,7 @@
 #define __ffukyj(A, B, C, D, E) ffukyj(A, B, C, D, E)
 #define __ffukyl(A, B, C, D, E) ffukyl(A, B, C, D, E)
 #define __ffukys(A, B, C, D, E) ffukys(A, B, C, D, E)
+#define __ffurlt(A, B, C) ffurlt(A, B, C)
 #define __TBIT        TBIT
 #define __TBYTE       TBYTE
 #define __TSBYTE      TSBYTE
@@ -123,10 +127,13 @@ typedef fitsfile __fitsfile;
 #define __ffdcol(A, B, C) __dummy()
 #define __ffdelt(A, B) __dummy()
 #define __ffdrow(A, B, C, D) __dummy()
+#define __ffflnm(A, B, C) __dummy()
+#define __ffflsh(A, B, C) __dummy()
 #define __ffgcv(A, B, C, D, E, F, G, H, I, J) __dummy()
 #define __ffgcvb(A, B, C, D, E, F, G, H, I) __dummy()
 #define __ffgcvs(A, B, C, D, E, F, G, H, I) __dummy()
 #define __ffgerr(A, B) __error(A, B)
+#define __ffghadll(A, B, C, D, E) __dummy()
 #define __ffghdt(A, B, C) __dummy()
 #define __ffghsp(A, B, C, D) __dummy()
 #define __ffgidm(A, B, C) __dummy()
@@ -158,6 +165,7 @@ typedef fitsfile __fitsfile;
 #define __ffukyj(A, B, C, D, E) __dummy()
 #define __ffukyl(A, B, C, D, E) __dummy()
 #define __ffukys(A, B, C, D, E) __dummy()
+#define __ffurlt(A, B, C) __dummy()
 #define __TBIT          1
 #define __TBYTE        11
 #define __TSBYTE       12
@@ -31,6 +31,7 @@
 #include "GException.hpp"
 #include "GFitsCfitsio.hpp"
 #include "GFitsImage.hpp"
+#include "GFitsMmap.hpp"
 #include "GTools.hpp"
 
 /* __ Method name definitions ____________________________________________ */
@@ -653,6 +654,12 @@ void GFitsImage::open_image(void* vptr)
  *            FITS error.
  *
  * Load image pixels from FITS file.
+ *
+ * If the library was configured with --enable-fits-mmap, floating point
+ * images that reside uncompressed on disk, that have no scaling and for
+ * which no nul values need to be substituted are loaded through memory
+ * mapping (see gammalib::fits_mmap_read()), which avoids the buffering and
+ * type conversion of cfitsio. All other images are loaded using cfitsio.
  ***************************************************************************/
 void GFitsImage::load_image(int datatype, const void* pixels,
                             const void* nulval, int* anynul)
@@ -660,8 +667,29 @@ void GFitsImage::load_image(int datatype, const void* pixels,
     // Move to HDU
     move_to_hdu();
 
-    // Load the image pixels (if there are some ...)
-    if (m_naxis > 0) {
+    // Try loading floating point image pixels through memory mapping
+    bool mapped = false;
+    if (m_naxis > 0 && ((datatype == __TFLOAT  && m_bitpix == -32) ||
+                        (datatype == __TDOUBLE && m_bitpix == -64))) {
+        bool scaled = (hascard("BSCALE") && real("BSCALE") != 1.0) ||
+                      (hascard("BZERO")  && real("BZERO")  != 0.0);
+        bool nulchk = (nulval != NULL) &&
+                      ((datatype == __TFLOAT  && *((float*)nulval)  != 0.0) ||
+                       (datatype == __TDOUBLE && *((double*)nulval) != 0.0));
+        if (!scaled && !nulchk) {
+            int size = (datatype == __TFLOAT) ? 4 : 8;
+            mapped   = gammalib::fits_mmap_read(m_fitsfile, 0, 0, 1,
+                                                m_num_pixels, size,
+                                                (void*)pixels);
+            if (mapped) {
+                *anynul = 0;
+            }
+        }
+    }
+
+    // ... otherwise load the image pixels using cfitsio (if there are
+    // some ...)
+    if (!mapped && m_naxis > 0) {
         long* fpixel = new long[m_naxis];
         long* lpixel = new long[m_naxis];
         long* inc    = new long[m_naxis];
@@ -0,0 +1,304 @@
+/***************************************************************************
+ *          GFitsMmap.cpp - Memory mapped FITS data reading                *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFitsMmap.cpp
+ * @brief Memory mapped FITS data reading implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <cstring>
+#include "GFitsCfitsio.hpp"
+#include "GFitsMmap.hpp"
+#if defined(G_FITS_MMAP) && defined(HAVE_LIBCFITSIO)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/* __ Method name definitions ____________________________________________ */
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+/* __ Prototypes _________________________________________________________ */
+#if defined(G_FITS_MMAP) && defined(HAVE_LIBCFITSIO)
+static void copy_swapped(const unsigned char* src, unsigned char* dst,
+                         const int& nelements, const int& size);
+#endif
+
+
+/***********************************************************************//**
+ * @brief Read FITS data through memory mapping
+ *
+ * @param[in] fptr FITS file pointer, positioned on the relevant HDU.
+ * @param[in] offset Offset of first element with respect to the start of
+ *                   the HDU data (Bytes).
+ * @param[in] stride Distance between two records (Bytes).
+ * @param[in] nrecords Number of records.
+ * @param[in] nelements Number of elements per record.
+ * @param[in] size Size of one element (1, 2, 4 or 8 Bytes).
+ * @param[out] buffer Buffer of nrecords*nelements*size Bytes.
+ * @return True if the data have been read.
+ *
+ * Reads FITS data by mapping the relevant part of the FITS file read-only
+ * into memory. For images, a single record containing all pixels is read.
+ * For binary table columns, one record per table row is read, and the
+ * stride is the length of a table row. The elements of all records are
+ * converted from FITS (big endian) into the native byte order and are
+ * stored contiguously in the buffer. The mapping is released before the
+ * method returns. Memory mapping hence reduces the time needed to read the
+ * data, but not the memory that is used, as the data are held in the
+ * buffer.
+ *
+ * Data can only be read from files that reside uncompressed on disk. Any
+ * buffered data are flushed to the file before mapping. The method
+ * returns false, and the buffer is left untouched, if the data can not be
+ * read through memory mapping. In that case the data need to be read
+ * using cfitsio. The method accesses internal cfitsio file structures and
+ * is only available if the library was configured with the
+ * --enable-fits-mmap option. Otherwise it always returns false.
+ ***************************************************************************/
+bool gammalib::fits_mmap_read(void* fptr, const long long& offset,
+                              const long long& stride, const int& nrecords,
+                              const int& nelements, const int& size,
+                              void* buffer)
+{
+    // Initialise result
+    bool success = false;
+
+    #if defined(G_FITS_MMAP) && defined(HAVE_LIBCFITSIO)
+    // Continue only if there is something to read and the element size is
+    // supported
+    if (fptr != NULL && nrecords > 0 && nelements > 0 &&
+        (size == 1 || size == 2 || size == 4 || size == 8)) {
+
+        // Get FITS file pointer
+        __fitsfile* fits = FPTR(fptr);
+
+        // Continue only if the FITS file resides uncompressed on disk and
+        // does not hold tile compressed images
+        int  status = 0;
+        char urltype[FLEN_FILENAME];
+        status = __ffurlt(fits, urltype, &status);
+        if (status == 0 && std::strcmp(urltype, "file://") == 0 &&
+            fits->Fptr->compressimg == 0) {
+
+            // Flush buffers so that the file is up to date, and get the
+            // data location of the HDU and the file name
+            LONGLONG headstart = 0;
+            LONGLONG datastart = 0;
+            LONGLONG dataend   = 0;
+            char     filename[FLEN_FILENAME];
+            status = __ffflsh(fits, 0, &status);
+            status = __ffghadll(fits, &headstart, &datastart, &dataend,
+                                &status);
+            status = __ffflnm(fits, filename, &status);
+
+            // Determine the file range that needs to be mapped
+            long long first = datastart + offset;
+            long long last  = first + (long long)(nrecords-1) * stride +
+                              (long long)nelements * size;
+
+            // Continue only if range lies within the HDU data
+            if (status == 0 && offset >= 0 && last <= dataend) {
+
+                // Open file and check its size
+                int fd = open(filename, O_RDONLY);
+                if (fd >= 0) {
+                    struct stat info;
+                    if (fstat(fd, &info) == 0 && last <= info.st_size) {
+
+                        // Map range, starting at a page boundary
+                        long long page   = sysconf(_SC_PAGESIZE);
+                        long long start  = (first / page) * page;
+                        size_t    length = size_t(last - start);
+                        void*     map    = mmap(NULL, length, PROT_READ,
+                                                MAP_PRIVATE, fd, off_t(start));
+
+                        // If mapping was successful then copy records
+                        if (map != MAP_FAILED) {
+                            #if defined(MADV_SEQUENTIAL)
+                            madvise(map, length, MADV_SEQUENTIAL);
+                            #endif
+                            const unsigned char* src =
+                                (const unsigned char*)map + (first - start);
+                            unsigned char* dst = (unsigned char*)buffer;
+                            long long      len = (long long)nelements * size;
+                            for (int i = 0; i < nrecords; ++i) {
+                                copy_swapped(src, dst, nelements, size);
+                                src += stride;
+                                dst += len;
+                            }
+                            munmap(map, length);
+                            success = true;
+                        }
+
+                    } // endif: file was large enough
+                    close(fd);
+                } // endif: file was opened
+
+            } // endif: range was valid
+
+        } // endif: file was uncompressed on disk
+
+    } // endif: there was something to read
+    #endif
+
+    // Return success flag
+    return success;
+}
+
+
+/***********************************************************************//**
+ * @brief Read binary table column rows through memory mapping
+ *
+ * @param[in] fptr FITS file pointer, positioned on the table HDU.
+ * @param[in] colnum Column number (starting from 1).
+ * @param[in] type Column data type (__TFLOAT or __TDOUBLE).
+ * @param[in] row First row to read (starting from 0).
+ * @param[in] nrows Number of rows to read.
+ * @param[out] buffer Buffer for nrows times the column repeat elements.
+ * @return True if the column rows have been read.
+ *
+ * Reads rows of a binary table column through memory mapping using
+ * fits_mmap_read(). Only fixed size floating point columns that are stored
+ * with the requested data type and that have no scaling are read, as for
+ * these columns the values are stored as is in the file. The method
+ * returns false for all other columns, which need to be read using
+ * cfitsio.
+ ***************************************************************************/
+bool gammalib::fits_mmap_column(void* fptr, const int& colnum, const int& type,
+                                const int& row, const int& nrows, void* buffer)
+{
+    // Initialise result
+    bool success = false;
+
+    #if defined(G_FITS_MMAP) && defined(HAVE_LIBCFITSIO)
+    // Continue only for floating point columns of a binary table
+    __fitsfile* fits = FPTR(fptr);
+    if (fits != NULL && fits->Fptr != NULL &&
+        (type == __TFLOAT || type == __TDOUBLE) &&
+        fits->Fptr->curhdu == fits->HDUposition &&
+        fits->Fptr->hdutype == BINARY_TBL &&
+        colnum >= 1 && colnum <= fits->Fptr->tfield) {
+
+        // Get column information
+        const tcolumn* column = fits->Fptr->tableptr + (colnum-1);
+
+        // Read column if data type matches and column is not scaled
+        if (column->tdatatype == type &&
+            column->tscale == 1.0 && column->tzero == 0.0) {
+            long long stride = fits->Fptr->rowlength;
+            long long offset = column->tbcol + (long long)row * stride;
+            int       size   = (type == __TFLOAT) ? 4 : 8;
+            success = fits_mmap_read(fptr, offset, stride, nrows,
+                                     int(column->trepeat), size, buffer);
+        }
+
+    } // endif: column was a floating point binary table column
+    #endif
+
+    // Return success flag
+    return success;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Static functions                            =
+ =                                                                         =
+ ==========================================================================*/
+
+#if defined(G_FITS_MMAP) && defined(HAVE_LIBCFITSIO)
+/***********************************************************************//**
+ * @brief Copy big endian elements into native byte order
+ *
+ * @param[in] src Source elements (big endian).
+ * @param[out] dst Destination elements (native byte order).
+ * @param[in] nelements Number of elements.
+ * @param[in] size Size of one element (1, 2, 4 or 8 Bytes).
+ *
+ * Copies the elements and reverses their byte order on little endian
+ * machines. The loops are written so that the compiler can vectorise
+ * them.
+ ***************************************************************************/
+static void copy_swapped(const unsigned char* src, unsigned char* dst,
+                         const int& nelements, const int& size)
+{
+    // Determine byte order of machine
+    const unsigned short test   = 1;
+    const bool           little = (*((const unsigned char*)&test) == 1);
+
+    // If no byte swapping is needed then simply copy the elements
+    if (!little || size == 1) {
+        std::memcpy(dst, src, size_t(nelements) * size);
+    }
+
+    // ... otherwise reverse byte order of 2 Byte elements
+    else if (size == 2) {
+        for (int i = 0; i < nelements; ++i) {
+            unsigned short v;
+            std::memcpy(&v, src+2*i, 2);
+            v = (unsigned short)((v >> 8) | (v << 8));
+            std::memcpy(dst+2*i, &v, 2);
+        }
+    }
+
+    // ... otherwise reverse byte order of 4 Byte elements
+    else if (size == 4) {
+        for (int i = 0; i < nelements; ++i) {
+            unsigned int v;
+            std::memcpy(&v, src+4*i, 4);
+            v = (v >> 24) | ((v >> 8) & 0x0000ff00U) |
+                ((v << 8) & 0x00ff0000U) | (v << 24);
+            std::memcpy(dst+4*i, &v, 4);
+        }
+    }
+
+    // ... otherwise reverse byte order of 8 Byte elements
+    else {
+        for (int i = 0; i < nelements; ++i) {
+            unsigned long long v;
+            std::memcpy(&v, src+8*i, 8);
+            v = ((v >> 56) & 0x00000000000000ffULL) |
+                ((v >> 40) & 0x000000000000ff00ULL) |
+                ((v >> 24) & 0x0000000000ff0000ULL) |
+                ((v >>  8) & 0x00000000ff000000ULL) |
+                ((v <<  8) & 0x000000ff00000000ULL) |
+                ((v << 24) & 0x0000ff0000000000ULL) |
+                ((v << 40) & 0x00ff000000000000ULL) |
+                ((v << 56) & 0xff00000000000000ULL);
+            std::memcpy(dst+8*i, &v, 8);
+        }
+    }
+
+    // Return
+    return;
+}
+#endif
@@ -0,0 +1,43 @@
+/***************************************************************************
+ *           GFitsMmap.hpp - Memory mapped FITS data reading               *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFitsMmap.hpp
+ * @brief Memory mapped FITS data reading definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GFITSMMAP_HPP
+#define GFITSMMAP_HPP
+
+/* __ Includes ___________________________________________________________ */
+
+
+/* __ Prototypes _________________________________________________________ */
+namespace gammalib {
+    bool fits_mmap_read(void* fptr, const long long& offset,
+                        const long long& stride, const int& nrecords,
+                        const int& nelements, const int& size,
+                        void* buffer);
+    bool fits_mmap_column(void* fptr, const int& colnum, const int& type,
+                          const int& row, const int& nrows, void* buffer);
+}
+
+#endif /* GFITSMMAP_HPP */
@@ -28,8 +28,10 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <vector>
 #include "GException.hpp"
 #include "GFitsCfitsio.hpp"
+#include "GFitsMmap.hpp"
 #include "GFitsTableCol.hpp"
 #include "GTools.hpp"
 
@@ -37,6 +39,7 @@
 #define G_LOAD_COLUMN                          "GFitsTableCol::load_column()"
 #define G_SAVE_COLUMN                          "GFitsTableCol::save_column()"
 #define G_OFFSET                           "GFitsTableCol::offset(int&,int&)"
+#define G_READ_ROWS            "GFitsTableCol::read_rows(int&, int&, double*)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -333,6 +336,115 @@ int GFitsTableCol::anynul(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Read range of rows into double precision buffer
+ *
+ * @param[in] row First row [0,...,length()-1].
+ * @param[in] nrows Number of rows.
+ * @param[out] values Buffer for nrows*number() values.
+ *
+ * @exception GException::out_of_range
+ *            Row range is not contained in column.
+ * @exception GException::fits_hdu_not_found
+ *            Specified HDU not found in FITS file.
+ * @exception GException::fits_error
+ *            An error occured while reading rows from FITS file.
+ *
+ * Reads a range of rows, converted to double precision, into a buffer.
+ * The elements of a vector column are stored consecutively for each row.
+ *
+ * If the column data have not yet been loaded into memory, the rows are
+ * read directly from the FITS file without loading the full column. This
+ * allows reading large tables in blocks of rows with bounded memory.
+ * If the library was configured with --enable-fits-mmap, rows of floating
+ * point columns are read through memory mapping if possible (see
+ * gammalib::fits_mmap_column()).
+ ***************************************************************************/
+void GFitsTableCol::read_rows(const int& row, const int& nrows,
+                              double* values) const
+{
+    // Throw an exception if the row range is invalid
+    if (row < 0 || row >= m_length) {
+        throw GException::out_of_range(G_READ_ROWS, row, 0, m_length-1);
+    }
+    if (nrows < 0 || row+nrows > m_length) {
+        throw GException::out_of_range(G_READ_ROWS, row+nrows-1, 0, m_length-1);
+    }
+
+    // Determine number of elements
+    int nelements = nrows * m_number;
+
+    // Continue only if there are elements
+    if (nelements > 0) {
+
+        // Get non-const pointer on column (circumvent const correctness)
+        GFitsTableCol* column = const_cast<GFitsTableCol*>(this);
+
+        // If the column data are not in memory but a FITS file is attached
+        // then read the rows directly from the FITS file
+        if (column->ptr_data() == NULL && FPTR(m_fitsfile)->Fptr != NULL) {
+
+            // Move to the HDU
+            int status = 0;
+            status     = __ffmahd(FPTR(m_fitsfile),
+                                  (FPTR(m_fitsfile)->HDUposition)+1,
+                                  NULL, &status);
+            if (status != 0) {
+                throw GException::fits_hdu_not_found(G_READ_ROWS,
+                                  (FPTR(m_fitsfile)->HDUposition)+1,
+                                  status);
+            }
+
+            // Try reading rows through memory mapping
+            bool mapped = false;
+            if (m_type == __TDOUBLE) {
+                mapped = gammalib::fits_mmap_column(m_fitsfile, m_colnum,
+                                                    m_type, row, nrows,
+                                                    values);
+            }
+            else if (m_type == __TFLOAT) {
+                std::vector<float> buffer(nelements);
+                mapped = gammalib::fits_mmap_column(m_fitsfile, m_colnum,
+                                                    m_type, row, nrows,
+                                                    &(buffer[0]));
+                if (mapped) {
+                    for (int i = 0; i < nelements; ++i) {
+                        values[i] = buffer[i];
+                    }
+                }
+            }
+
+            // ... otherwise read rows using cfitsio
+            if (!mapped) {
+                double nulval = 0.0;
+                int    anynul = 0;
+                status = __ffgcv(FPTR(m_fitsfile), __TDOUBLE, m_colnum, row+1,
+                                 1, nelements, &nulval, values, &anynul,
+                                 &status);
+                if (status != 0) {
+                    throw GException::fits_error(G_READ_ROWS, status,
+                                      "for column \""+m_name+"\".");
+                }
+            }
+
+        } // endif: rows were read from FITS file
+
+        // ... otherwise copy rows from column
+        else {
+            for (int i = 0, k = 0; i < nrows; ++i) {
+                for (int inx = 0; inx < m_number; ++inx, ++k) {
+                    values[k] = real(row+i, inx);
+                }
+            }
+        }
+
+    } // endif: there were elements
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Print column information
  *
@@ -462,6 +574,12 @@ void GFitsTableCol::fetch_data(void) const
  * from the FITS file. If no FITS file is attached, memory is allocated
  * to hold the column data and all cells are set to 0.
  *
+ * If the library was configured with --enable-fits-mmap, floating point
+ * columns of binary tables that reside uncompressed on disk are loaded
+ * through memory mapping (see gammalib::fits_mmap_column()), which avoids
+ * the buffering and type conversion of cfitsio. All other columns are
+ * loaded using cfitsio.
+ *
  * The method makes use of the virtual methods 
  * GFitsTableCol::alloc_data,
  * GFitsTableCol::init_data,
@@ -508,12 +626,32 @@ void GFitsTableCol::load_column(void)
                                   status);
                 }
 
-                // Load data
-                status = __ffgcv(FPTR(m_fitsfile), m_type, m_colnum, 1, 1, m_size,
-                                 ptr_nulval(), ptr_data(), &m_anynul, &status);
-                if (status != 0) {
-                    throw GException::fits_error(G_LOAD_COLUMN, status,
-                                      "for column \""+m_name+"\".");
+                // Try loading data through memory mapping. This is only
+                // done if no nul values need to be substituted, which is
+                // the case if the nul value is not set or zero
+                void* nulval = ptr_nulval();
+                bool  nulchk = (nulval != NULL) &&
+                               ((m_type == __TFLOAT  && *((float*)nulval)  != 0.0) ||
+                                (m_type == __TDOUBLE && *((double*)nulval) != 0.0));
+                bool  mapped = false;
+                if (!nulchk) {
+                    mapped = gammalib::fits_mmap_column(m_fitsfile, m_colnum,
+                                                        m_type, 0, m_length,
+                                                        ptr_data());
+                    if (mapped) {
+                        m_anynul = 0;
+                    }
+                }
+
+                // ... otherwise load data using cfitsio
+                if (!mapped) {
+                    status = __ffgcv(FPTR(m_fitsfile), m_type, m_colnum, 1, 1,
+                                     m_size, ptr_nulval(), ptr_data(),
+                                     &m_anynul, &status);
+                    if (status != 0) {
+                        throw GException::fits_error(G_LOAD_COLUMN, status,
+                                          "for column \""+m_name+"\".");
+                    }
                 }
         
             } // endif: no primary HDU found
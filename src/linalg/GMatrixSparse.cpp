@@ -29,6 +29,7 @@
 #include <config.h>
 #endif
 #include <cmath>
+#include <vector>
 #include "GException.hpp"
 #include "GTools.hpp"
 #include "GVector.hpp"
@@ -56,6 +57,7 @@
                                                                 " int*, int)"
 #define G_CHOL_DECOMP               "GMatrixSparse::cholesky_decompose(bool)"
 #define G_CHOL_SOLVE         "GMatrixSparse::cholesky_solver(GVector&, bool)"
+#define G_CHOL_SOLVE_MAT     "GMatrixSparse::cholesky_solver(GMatrix&, bool)"
 #define G_STACK_INIT                  "GMatrixSparse::stack_init(int&, int&)"
 #define G_STACK_PUSH  "GMatrixSparse::stack_push_column(double*, int*, int&,"\
                                                                      " int&)"
@@ -73,6 +75,8 @@
 #define G_MAX(a,b) (((a) > (b)) ? (a) : (b))
 
 /* __ Coding definitions _________________________________________________ */
+#define G_CHOL_SOLVE_BLOCK   16   //!< Right-hand sides per block in solver
+#define G_CHOL_SOLVE_OMP_MIN 64   //!< Minimum right-hand sides for threads
 
 /* __ Debug definitions __________________________________________________ */
 //#define G_DEBUG_SPARSE_PENDING                    // Analyse pending values
@@ -1913,41 +1917,201 @@ GVector GMatrixSparse::cholesky_solver(const GVector& vector,
 
 
 /***********************************************************************//**
- * @brief Invert matrix using a Cholesky decomposition
+ * @brief Cholesky solver for multiple right-hand sides
  *
- * @param[in] compress Use zero-row/column compression (defaults to true).
- * @return Inverted matrix.
+ * @param[in] matrix Right-hand side matrix (one right-hand side per column).
+ * @param[in] compress Request matrix compression.
+ * @return Solution matrix (one solution per column).
  *
- * Inverts the matrix using a Cholesky decomposition.
+ * @exception GException::matrix_mismatch
+ *            Matrix and right-hand side matrix do not match.
+ * @exception GException::matrix_not_factorised
+ *            Matrix has not been factorised.
+ *
+ * Solves the linear equations A*X=B using a Cholesky decomposition of A,
+ * where each column of B is a right-hand side. This function is to be
+ * applied on a GMatrixSparse matrix for which a Choleksy factorization has
+ * been produced using 'cholesky_decompose'.
+ *
+ * The right-hand sides are processed in blocks of G_CHOL_SOLVE_BLOCK
+ * columns, and the triangular solves for all columns of a block are done
+ * in a single pass over the Cholesky factor. If there are at least
+ * G_CHOL_SOLVE_OMP_MIN right-hand sides, the blocks are distributed over
+ * several threads. The result for each column is identical to the result
+ * of the cholesky_solver() method for a single vector.
  ***************************************************************************/
-GMatrixSparse GMatrixSparse::cholesky_invert(bool compress) const
+GMatrix GMatrixSparse::cholesky_solver(const GMatrix& matrix,
+                                       bool           compress) const
 {
-    // Generate Cholesky decomposition of matrix
-    GMatrixSparse decomposition = cholesky_decompose(compress);
+    // Raise an exception if the matrix dimensions are incompatible
+    if (m_rows != matrix.rows()) {
+        throw GException::matrix_mismatch(G_CHOL_SOLVE_MAT,
+                                          m_rows, m_cols,
+                                          matrix.rows(), matrix.columns());
+    }
 
-    // Allocate result matrix and unit vector
-    GMatrixSparse matrix(m_rows, m_cols);
-    GVector       unit(m_rows);
+    // Raise an exception if there is no symbolic pointer or no permutation
+    if (!m_symbolic || !m_symbolic->m_pinv) {
+        throw GException::matrix_not_factorised(G_CHOL_SOLVE_MAT, 
+                                                "Cholesky decomposition");
+    }
 
-    // Column-wise solving of the problem
-    for (int col = 0; col < m_cols; ++col) {
+    // Flag row and column compression
+    bool row_compressed = (compress && m_rowsel != NULL && m_num_rowsel < m_rows);
+    bool col_compressed = (compress && m_colsel != NULL && m_num_colsel < m_cols);
 
-        // Set unit vector
-        unit[col] = 1.0;
+    // Setup row and column mapping arrays that map original matrix rows
+    // and columns into compressed matrix rows and columns. An entry of -1
+    // indicates that the row or column should be dropped. If no selection
+    // exists then setup an identity map.
+    std::vector<int> row_map(m_rows, -1);
+    std::vector<int> col_map(m_cols, -1);
+    if (row_compressed) {
+        for (int c_row = 0; c_row < m_num_rowsel; ++c_row) {
+            row_map[m_rowsel[c_row]] = c_row;
+        }
+    }
+    else {
+        for (int row = 0; row < m_rows; ++row) {
+            row_map[row] = row;
+        }
+    }
+    if (col_compressed) {
+        for (int c_col = 0; c_col < m_num_colsel; ++c_col) {
+            col_map[m_colsel[c_col]] = c_col;
+        }
+    }
+    else {
+        for (int col = 0; col < m_cols; ++col) {
+            col_map[col] = col;
+        }
+    }
+
+    // Get size of compressed system and number of right-hand sides
+    int nrows   = row_compressed ? m_num_rowsel : m_rows;
+    int ncols   = col_compressed ? m_num_colsel : m_cols;
+    int nrhs    = matrix.columns();
+    int nblocks = (nrhs + G_CHOL_SOLVE_BLOCK - 1) / G_CHOL_SOLVE_BLOCK;
 
-        // Solve for column
-        GVector x = decomposition.cholesky_solver(unit, compress);
+    // Allocate result matrix
+    GMatrix result(m_cols, nrhs);
+
+    // Setup pointers to L matrix and permutation
+    const int*    Lp   = m_colstart;
+    const int*    Li   = m_rowinx; 
+    const double* Lx   = m_data;
+    const int*    pinv = m_symbolic->m_pinv;
+
+    // Loop over blocks of right-hand sides
+    #pragma omp parallel for schedule(dynamic) if(nrhs >= G_CHOL_SOLVE_OMP_MIN)
+    for (int block = 0; block < nblocks; ++block) {
+
+        // Get range of right-hand sides of block
+        int first = block * G_CHOL_SOLVE_BLOCK;
+        int nb    = nrhs - first;
+        if (nb > G_CHOL_SOLVE_BLOCK) {
+            nb = G_CHOL_SOLVE_BLOCK;
+        }
 
-        // Insert column in matrix
-        matrix.column(col, x);
+        // Allocate working array, where element r of compressed row i is
+        // stored at position i*nb+r
+        std::vector<double> x(nrows * nb, 0.0);
 
-        // Clear unit vector for next round
-        unit[col] = 0.0;
+        // Compress right-hand sides and perform inverse permutation
+        for (int row = 0; row < m_rows; ++row) {
+            int c_row = row_map[row];
+            if (c_row >= 0) {
+                double* xp = &(x[pinv[c_row] * nb]);
+                for (int r = 0; r < nb; ++r) {
+                    xp[r] = matrix(row, first+r);
+                }
+            }
+        }
 
+        // Inplace solve L\x=x
+        for (int col = 0; col < m_cols; ++col) {
+            int c_col = col_map[col];
+            if (c_col >= 0) {
+                double* xc   = &(x[c_col * nb]);
+                double  diag = Lx[Lp[col]];
+                for (int r = 0; r < nb; ++r) {
+                    xc[r] /= diag;
+                }
+                for (int p = Lp[col]+1; p < Lp[col+1]; ++p) {
+                    int c_row = row_map[Li[p]];
+                    if (c_row >= 0) {
+                        double* xr = &(x[c_row * nb]);
+                        for (int r = 0; r < nb; ++r) {
+                            xr[r] -= Lx[p] * xc[r];
+                        }
+                    }
+                }
+            }
+        }
+
+        // Inplace solve L'\x=x
+        for (int col = m_cols-1; col >= 0; --col) {
+            int c_col = col_map[col];
+            if (c_col >= 0) {
+                double* xc = &(x[c_col * nb]);
+                for (int p = Lp[col]+1; p < Lp[col+1]; ++p) {
+                    int c_row = row_map[Li[p]];
+                    if (c_row >= 0) {
+                        const double* xr = &(x[c_row * nb]);
+                        for (int r = 0; r < nb; ++r) {
+                            xc[r] -= Lx[p] * xr[r];
+                        }
+                    }
+                }
+                double diag = Lx[Lp[col]];
+                for (int r = 0; r < nb; ++r) {
+                    xc[r] /= diag;
+                }
+            }
+        }
+
+        // Perform permutation and expand result
+        for (int c_col = 0; c_col < ncols; ++c_col) {
+            int           col = col_compressed ? m_colsel[c_col] : c_col;
+            const double* xp  = &(x[pinv[c_col] * nb]);
+            for (int r = 0; r < nb; ++r) {
+                result(col, first+r) = xp[r];
+            }
+        }
+
+    } // endfor: looped over blocks
+
+    // Return result matrix
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Invert matrix using a Cholesky decomposition
+ *
+ * @param[in] compress Use zero-row/column compression (defaults to true).
+ * @return Inverted matrix.
+ *
+ * Inverts the matrix using a Cholesky decomposition. All columns of the
+ * inverse are solved for in a single call of the multiple right-hand side
+ * Cholesky solver.
+ ***************************************************************************/
+GMatrixSparse GMatrixSparse::cholesky_invert(bool compress) const
+{
+    // Generate Cholesky decomposition of matrix
+    GMatrixSparse decomposition = cholesky_decompose(compress);
+
+    // Allocate unit matrix
+    GMatrix unit(m_rows, m_cols);
+    for (int i = 0; i < m_rows && i < m_cols; ++i) {
+        unit(i,i) = 1.0;
     }
 
+    // Solve for all columns at once
+    GMatrix matrix = decomposition.cholesky_solver(unit, compress);
+
     // Return matrix
-    return matrix;
+    return (GMatrixSparse(matrix));
 }
 
 
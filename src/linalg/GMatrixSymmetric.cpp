@@ -51,6 +51,8 @@
 #define G_SET_COLUMN               "GMatrixSymmetric::column(int&, GVector&)"
 #define G_ADD_TO_ROW           "GMatrixSymmetric::add_to_row(int&, GVector&)"
 #define G_ADD_TO_COLUMN     "GMatrixSymmetric::add_to_column(int&, GVector&)"
+#define G_ADD_OUTER_PRODUCT "GMatrixSymmetric::add_outer_product(double&,"\
+                                                         " double*, int*, int&)"
 #define G_CHOL_DECOMP            "GMatrixSymmetric::cholesky_decompose(int&)"
 #define G_CHOL_SOLVE      "GMatrixSymmetric::cholesky_solver(GVector&, int&)"
 #define G_CHOL_INVERT               "GMatrixSymmetric::cholesky_invert(int&)"
@@ -710,6 +712,73 @@ void GMatrixSymmetric::add_to_column(const int& column, const GVector& vector)
 }
 
 
+/***********************************************************************//**
+ * @brief Add weighted outer product of a sparse vector to matrix
+ *
+ * @param[in] weight Weight of outer product.
+ * @param[in] values Non-zero vector elements.
+ * @param[in] inx Row/column indices of non-zero vector elements.
+ * @param[in] number Number of non-zero vector elements.
+ *
+ * @exception GException::out_of_range
+ *            Invalid index specified.
+ *
+ * Adds the weighted outer product
+ *
+ * \f[M_{ij} = M_{ij} + w \, v_i \, v_j\f]
+ *
+ * of a sparse vector \f$v\f$ to the matrix. The vector is specified by
+ * the @p number non-zero elements @p values that are located at the
+ * indices @p inx. The indices need to be sorted in ascending order.
+ *
+ * As the matrix is symmetric, only the stored lower triangle is updated,
+ * which requires \f$n(n+1)/2\f$ multiply-add operations for \f$n\f$
+ * non-zero elements. Each column is updated in a contiguous memory
+ * segment, hence the method is well suited for the accumulation of
+ * curvature matrices.
+ ***************************************************************************/
+void GMatrixSymmetric::add_outer_product(const double& weight,
+                                         const double* values,
+                                         const int*    inx,
+                                         const int&    number)
+{
+    // Continue only if there are elements
+    if (number > 0) {
+
+        // Raise an exception if the indices are invalid
+        #if defined(G_RANGE_CHECK)
+        if (inx[0] < 0) {
+            throw GException::out_of_range(G_ADD_OUTER_PRODUCT, inx[0],
+                                           0, m_rows-1);
+        }
+        if (inx[number-1] >= m_rows) {
+            throw GException::out_of_range(G_ADD_OUTER_PRODUCT, inx[number-1],
+                                           0, m_rows-1);
+        }
+        #endif
+
+        // Loop over columns
+        for (int jdev = 0; jdev < number; ++jdev) {
+
+            // Get pointer to virtual row 0 of column and the column factor
+            int     col    = inx[jdev];
+            double* data   = m_data + m_colstart[col] - col;
+            double  factor = weight * values[jdev];
+
+            // Loop over rows of lower triangle
+            for (int idev = jdev; idev < number; ++idev) {
+                data[inx[idev]] += factor * values[idev];
+            }
+
+        } // endfor: looped over columns
+
+    } // endif: there were elements
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Return inverted matrix
  *
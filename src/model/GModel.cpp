@@ -31,6 +31,7 @@
 #include "GTools.hpp"
 #include "GException.hpp"
 #include "GModel.hpp"
+#include "GEventBatch.hpp"
 
 /* __ Method name definitions ____________________________________________ */
 #define G_ACCESS                           "GModel::operator[](std::string&)"
@@ -224,6 +225,57 @@ const GModelPar& GModel::operator[](const std::string& name) const
  =                                                                         =
  ==========================================================================*/
 
+/***********************************************************************//**
+ * @brief Evaluate model for a batch of events
+ *
+ * @param[in] batch Event batch.
+ * @param[in] obs Observation.
+ * @param[out] values Model values (batch.size() elements).
+ * @param[out] gradients Parameter gradients (size()*batch.size() elements).
+ *
+ * Evaluates the model for all events of a batch. The model values are
+ * written into the @p values array. If @p gradients is not NULL, the
+ * parameter gradients are written into the @p gradients array, where the
+ * gradient of parameter @p k for event @p i is stored at position
+ * @p k*batch.size()+i. The gradients are the factor gradients that are
+ * set by the eval_gradients() method, hence they are only meaningful for
+ * parameters that have analytical gradients.
+ *
+ * This generic implementation calls eval() or eval_gradients() for each
+ * event. Derived classes may overload the method to exploit the
+ * structure-of-arrays layout of the event batch.
+ ***************************************************************************/
+void GModel::eval_batch(const GEventBatch&  batch,
+                        const GObservation& obs,
+                        double*             values,
+                        double*             gradients) const
+{
+    // Get number of events and parameters
+    int nevents = batch.size();
+    int npars   = size();
+
+    // Case A: evaluate gradients
+    if (gradients != NULL) {
+        for (int i = 0; i < nevents; ++i) {
+            values[i] = eval_gradients(*batch[i], obs);
+            for (int k = 0, inx = i; k < npars; ++k, inx += nevents) {
+                gradients[inx] = m_pars[k]->factor_gradient();
+            }
+        }
+    }
+
+    // Case B: evaluate no gradients
+    else {
+        for (int i = 0; i < nevents; ++i) {
+            values[i] = eval(*batch[i], obs);
+        }
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns reference to model parameter by index
  *
@@ -44,6 +44,9 @@
 
 /* __ Coding definitions _________________________________________________ */
 
+/* __ Static members _____________________________________________________ */
+static unsigned long g_version = 0;
+
 /* __ Debug definitions __________________________________________________ */
 
 
@@ -392,6 +395,9 @@ void GModelPar::factor_value(const double& value)
 
     // Assign value
     m_factor_value = value;
+
+    // Signal parameter change
+    touch();
 	
     // Return
     return;
@@ -550,6 +556,9 @@ void GModelPar::scale(const double& scale)
             m_hasmax     = false;
         }
     }
+
+    // Signal parameter change
+    touch();
     
     // Return
     return;
@@ -615,6 +624,9 @@ void GModelPar::autoscale(void)
             }
         }
 
+        // Signal parameter change
+        touch();
+
     } // endif: value was non-zero
 
     // Return
@@ -654,6 +666,9 @@ void GModelPar::read(const GXmlElement& xml)
         m_factor_value = 0.0;
     }
 
+    // Signal parameter change
+    touch();
+
     // Get error
     arg = xml.attribute("error");
     if (arg != "") {
@@ -881,6 +896,9 @@ void GModelPar::init_members(void)
     m_hasmin          = false;
     m_hasmax          = false;
     m_hasgrad         = false;
+
+    // Assign a fresh version number
+    touch();
   
     // Return
     return;
@@ -907,6 +925,7 @@ void GModelPar::copy_members(const GModelPar& par)
     m_hasmin          = par.m_hasmin;
     m_hasmax          = par.m_hasmax;
     m_hasgrad         = par.m_hasgrad;
+    m_version         = par.m_version;
 
     // Return
     return;
@@ -921,3 +940,33 @@ void GModelPar::free_members(void)
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Assign new version number to parameter
+ *
+ * Assigns a version number that has never been used before by any model
+ * parameter. Version numbers are drawn from a global counter, hence two
+ * parameters with the same version number have necessarily the same
+ * value and the same free/fixed property, even if they belong to models
+ * that were loaded independently. The counter is incremented atomically,
+ * hence threads that modify parameters do not wait for each other.
+ ***************************************************************************/
+void GModelPar::touch(void)
+{
+    // Draw new version number
+    unsigned long version;
+    #if defined(_OPENMP) && _OPENMP >= 201107
+    #pragma omp atomic capture
+    version = ++g_version;
+    #else
+    #pragma omp critical(GModelPar_touch)
+    version = ++g_version;
+    #endif
+
+    // Set version number
+    m_version = version;
+
+    // Return
+    return;
+}
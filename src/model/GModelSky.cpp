@@ -40,6 +40,7 @@
 #include "GModelTemporalConst.hpp"
 #include "GSource.hpp"
 #include "GResponse.hpp"
+#include "GEventBatch.hpp"
 
 /* __ Globals ____________________________________________________________ */
 const GModelSky         g_pointsource_seed("PointSource");
@@ -54,6 +55,8 @@ const GModelRegistry    g_diffusesource_registry(&g_diffusesource_seed);
 #define G_XML_SPATIAL                  "GModelSky::xml_spatial(GXmlElement&)"
 #define G_XML_SPECTRAL                "GModelSky::xml_spectral(GXmlElement&)"
 #define G_XML_TEMPORAL                "GModelSky::xml_temporal(GXmlElement&)"
+#define G_EVAL_BATCH   "GModelSky::eval_batch(GEventBatch&, GObservation&,"\
+                                                        " double*, double*)"
 #define G_INTEGRATE_TIME  "GModelSky::integrate_time(GEvent&, GObservation&,"\
                                                                      " bool)"
 #define G_INTEGRATE_ENERGY     "GModelSky::integrate_energy(GEvent&, GTime&," \
@@ -509,6 +512,154 @@ double GModelSky::eval_gradients(const GEvent& event,
 }
 
 
+/***********************************************************************//**
+ * @brief Evaluate sky model for a batch of events
+ *
+ * @param[in] batch Event batch.
+ * @param[in] obs Observation.
+ * @param[out] values Model values (batch.size() elements).
+ * @param[out] gradients Parameter gradients (size()*batch.size() elements).
+ *
+ * @exception GException::no_response
+ *            Observation has no valid instrument response
+ *
+ * Evaluates the sky model for all events of a batch. If the response has
+ * neither energy nor time dispersion, the spectral component is evaluated
+ * in a single call for all events using GModelSpectral::eval_batch(), and
+ * the model values and gradients are then assembled in loops over the
+ * contiguous per-event arrays. The IRF and the temporal component are
+ * evaluated event by event. Otherwise the generic GModel::eval_batch()
+ * method is used.
+ *
+ * The gradient of parameter @p k for event @p i is stored at position
+ * @p k*batch.size()+i of the @p gradients array. The results are identical
+ * to those obtained by calling eval() or eval_gradients() for each event.
+ ***************************************************************************/
+void GModelSky::eval_batch(const GEventBatch&  batch,
+                           const GObservation& obs,
+                           double*             values,
+                           double*             gradients) const
+{
+    // Get response function
+    GResponse* rsp = obs.response();
+    if (rsp == NULL) {
+        throw GException::no_response(G_EVAL_BATCH);
+    }
+
+    // Use generic method if dispersion needs to be integrated or if there
+    // is no spatial component
+    if (rsp->hastdisp() || rsp->hasedisp() || m_spatial == NULL) {
+        GModel::eval_batch(batch, obs, values, gradients);
+        return;
+    }
+
+    // Get number of events. Return if batch is empty
+    int nevents = batch.size();
+    if (nevents < 1) {
+        return;
+    }
+
+    // Determine number of parameters of the model components
+    int n_spatial  = m_spatial->size();
+    int n_spectral = (m_spectral != NULL) ? m_spectral->size() : 0;
+    int n_temporal = (m_temporal != NULL) ? m_temporal->size() : 0;
+
+    // Set gradient pointers for model components
+    bool    grad       = (gradients != NULL);
+    double* g_spatial  = gradients;
+    double* g_spectral = (grad) ? g_spatial  + n_spatial  * nevents : NULL;
+    double* g_temporal = (grad) ? g_spectral + n_spectral * nevents : NULL;
+
+    // Get instrument specific model scaling
+    double scaling = (m_scales.empty()) ? 1.0
+                                        : scale(obs.instrument()).value();
+
+    // Allocate working arrays
+    std::vector<double> spec(nevents, 1.0);
+    std::vector<double> temp(nevents, 1.0);
+    std::vector<double> irf(nevents, 0.0);
+
+    // Evaluate spectral component for all events
+    if (m_spectral != NULL) {
+        m_spectral->eval_batch(batch, &(spec[0]), g_spectral);
+    }
+
+    // Set source
+    GSource source(this->name(), m_spatial, GEnergy(), GTime());
+
+    // Evaluate IRF and temporal component for all events
+    for (int i = 0; i < nevents; ++i) {
+
+        // Get event
+        const GEventAtom* event = batch[i];
+
+        // Set source energy and time (no dispersion)
+        source.energy(event->energy());
+        source.time(event->time());
+
+        // Case A: evaluate gradients
+        if (grad) {
+            irf[i] = rsp->irf_gradients(*event, source, obs) * scaling;
+            for (int k = 0, inx = i; k < n_spatial; ++k, inx += nevents) {
+                g_spatial[inx] = (*m_spatial)[k].factor_gradient();
+            }
+            if (m_temporal != NULL) {
+                temp[i] = m_temporal->eval_gradients(event->time());
+                for (int k = 0, inx = i; k < n_temporal; ++k, inx += nevents) {
+                    g_temporal[inx] = (*m_temporal)[k].factor_gradient();
+                }
+            }
+        }
+
+        // Case B: evaluate no gradients
+        else {
+            irf[i] = rsp->irf(*event, source, obs) * scaling;
+            if (m_temporal != NULL) {
+                temp[i] = m_temporal->eval(event->time());
+            }
+        }
+
+    } // endfor: looped over events
+
+    // Compute model values
+    for (int i = 0; i < nevents; ++i) {
+        values[i] = spec[i] * temp[i] * irf[i];
+    }
+
+    // Multiply factors to gradients
+    if (grad) {
+
+        // Multiply factors to spatial gradients
+        for (int k = 0; k < n_spatial; ++k) {
+            double* g = g_spatial + k * nevents;
+            for (int i = 0; i < nevents; ++i) {
+                g[i] *= spec[i] * temp[i] * scaling;
+            }
+        }
+
+        // Multiply factors to spectral gradients
+        for (int k = 0; k < n_spectral; ++k) {
+            double* g = g_spectral + k * nevents;
+            for (int i = 0; i < nevents; ++i) {
+                g[i] *= temp[i] * irf[i];
+            }
+        }
+
+        // Multiply factors to temporal gradients
+        for (int k = 0; k < n_temporal; ++k) {
+            double* g = g_temporal + k * nevents;
+            for (int i = 0; i < nevents; ++i) {
+                g[i] *= spec[i] * irf[i];
+            }
+        }
+
+    } // endif: gradients were requested
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Return spatially integrated sky model
  *
@@ -814,7 +965,7 @@ GPhotons GModelSky::mc(const double& area,
         // cone
         bool use_model = true;
         if (ptsrc != NULL) {
-            if (dir.dist(ptsrc->dir()) > radius) {
+            if (dir.dist_deg(ptsrc->dir()) > radius) {
                 use_model = false;
             }
         }
@@ -1374,6 +1525,10 @@ double GModelSky::integrate_energy(const GEvent& event,
  * scale factors will be applied to the IRF so that they are correctly
  * taken into account in the spectral and temporal model gradient
  * computations.
+ *
+ * If gradients are requested, the gradients of the spatial model parameters
+ * are obtained from GResponse::irf_gradients() in the same pass as the IRF
+ * value.
  ***************************************************************************/
 double GModelSky::integrate_dir(const GEvent&       event,
                                 const GEnergy&      srcEng,
@@ -1397,12 +1552,16 @@ double GModelSky::integrate_dir(const GEvent&       event,
         GSource source(this->name(), m_spatial, srcEng, srcTime);
         
         // Get IRF value. This method returns the spatial component of the
-        // source model.
-        double irf = rsp->irf(event, source, obs);
+        // source model. If gradients are requested, the gradients of the
+        // spatial model parameters are computed by the response.
+        double irf = (grad) ? rsp->irf_gradients(event, source, obs)
+                            : rsp->irf(event, source, obs);
 
         // If required, apply instrument specific model scaling
+        double scaling = 1.0;
         if (!m_scales.empty()) {
-            irf *= scale(obs.instrument()).value();
+            scaling = scale(obs.instrument()).value();
+            irf    *= scaling;
         }
 
         // Case A: evaluate gradients
@@ -1448,6 +1607,14 @@ double GModelSky::integrate_dir(const GEvent&       event,
                 }
             }
 
+            // Multiply factors to spatial gradients
+            double fact = spec * temp * scaling;
+            if (fact != 1.0) {
+                for (int i = 0; i < spatial()->size(); ++i) {
+                    (*spatial())[i].factor_gradient((*spatial())[i].factor_gradient() * fact);
+                }
+            }
+
         } // endif: gradient evaluation has been requested
 
         // Case B: evaluate no gradients
@@ -312,13 +312,13 @@ double GModelSpatialDiffuseMap::eval_gradients(const GPhoton& photon) const
  * @return Sky direction.
  *
  * Returns a random sky direction according to the intensity distribution of
- * the model sky map. It makes use of a cache array that contains the
- * normalized cumulative flux values of the skymap. Using a uniform random
- * number, this cache array is scanned using a bi-section method to determine
- * the skymap pixel for which the position should be returned. To avoid
- * binning problems, the exact position within the pixel is set by a uniform
- * random number generator (neglecting thus pixel distortions). The
- * fractional skymap pixel is then converted into a sky direction.
+ * the model sky map. It makes use of an alias table for the pixel fluxes
+ * of the skymap, which returns the skymap pixel for which the position
+ * should be returned in a constant time, independent of the number of
+ * pixels. To avoid binning problems, the exact position within the pixel
+ * is set by a uniform random number generator (neglecting thus pixel
+ * distortions). The fractional skymap pixel is then converted into a sky
+ * direction.
  ***************************************************************************/
 GSkyDir GModelSpatialDiffuseMap::mc(const GEnergy& energy,
                                     const GTime&   time,
@@ -327,31 +327,14 @@ GSkyDir GModelSpatialDiffuseMap::mc(const GEnergy& energy,
     // Allocate sky direction
     GSkyDir dir;
 
-    // Determine number of skymap pixels
-    int npix = m_map.npix();
+    // Continue only if there are skymap pixels with flux
+    if (!m_mc_table.isempty()) {
 
-    // Continue only if there are skymap pixels
-    if (npix > 0) {
-
-        // Get uniform random number
-        double u = ran.uniform();
-
-        // Get pixel index according to random number. We use a bi-section
-        // method to find the corresponding skymap pixel
-        int low  = 0;
-        int high = npix;
-        while ((high - low) > 1) {
-            int mid = (low+high) / 2;
-            if (u < m_mc_cache[mid]) {
-                high = mid;
-            }
-            else if (m_mc_cache[mid] <= u) {
-                low = mid;
-            }
-        }
+        // Draw pixel index from alias table
+        int index = m_mc_table.draw(ran);
 
         // Convert 1D pixel index to 2D pixel index
-        GSkyPixel pixel = m_map.pix2xy(low);
+        GSkyPixel pixel = m_map.pix2xy(index);
 
         // Randomize pixel
         pixel.x(pixel.x() + ran.uniform() - 0.5);
@@ -565,7 +548,7 @@ void GModelSpatialDiffuseMap::init_members(void)
     // Initialise other members
     m_map.clear();
     m_filename.clear();
-    m_mc_cache.clear();
+    m_mc_table.clear();
 
     // Return
     return;
@@ -583,7 +566,7 @@ void GModelSpatialDiffuseMap::copy_members(const GModelSpatialDiffuseMap& model)
     m_value    = model.m_value;
     m_map      = model.m_map;
     m_filename = model.m_filename;
-    m_mc_cache = model.m_mc_cache;
+    m_mc_table = model.m_mc_table;
 
     // Set parameter pointer(s)
     m_pars.clear();
@@ -611,17 +594,17 @@ void GModelSpatialDiffuseMap::free_members(void)
  * flux in the map amounts to 1 ph/cm2/s. Negative skymap pixels are set to
  * zero intensity.
  *
- * The method also initialises a cache for Monte Carlo sampling of the
- * skymap. This Monte Carlo cache consists of a linear array that maps a
- * value between 0 and 1 into the skymap pixel.
+ * The method also initialises an alias table for Monte Carlo sampling of
+ * the skymap pixels (see GAliasTable). The table remains empty if the
+ * skymap contains no flux.
  *
  * Note that if the GSkymap object contains multiple maps, only the first
  * map is used.
  ***************************************************************************/
 void GModelSpatialDiffuseMap::prepare_map(void)
 {
-    // Initialise cache
-    m_mc_cache.clear();
+    // Initialise alias table
+    m_mc_table.clear();
 
     // Determine number of skymap pixels
     int npix = m_map.npix();
@@ -629,37 +612,29 @@ void GModelSpatialDiffuseMap::prepare_map(void)
     // Continue only if there are skymap pixels
     if (npix > 0) {
 
-        // Reserve space for all pixels in cache
-        m_mc_cache.reserve(npix+1);
-
-        // Set first cache value to 0
-        m_mc_cache.push_back(0.0);
-
-        // Initialise cache with cumulative pixel fluxes and compute total
-        // flux in skymap for normalization. Negative pixels are set to
-        // zero intensity in the skymap.
-        double sum = 0.0;
+        // Compute pixel fluxes and total flux in skymap for normalization.
+        // Negative pixels are set to zero intensity in the skymap.
+        std::vector<double> fluxes(npix);
+        double              sum = 0.0;
         for (int i = 0; i < npix; ++i) {
             double flux = m_map(i) * m_map.omega(i);
             if (flux < 0.0) {
                 m_map(i) = 0.0;
                 flux     = 0.0;
             }
-            sum += flux;
-            m_mc_cache.push_back(sum);
+            fluxes[i] = flux;
+            sum      += flux;
         }
 
-        // Normalize skymap and pixel fluxes in the cache so that the values
-        // in the cache run from 0 to 1
+        // Normalize skymap
         if (sum > 0.0) {
             for (int i = 0; i < npix; ++i) {
-                m_map(i)      /= sum;
-                m_mc_cache[i] /= sum;
+                m_map(i) /= sum;
             }
         }
 
-        // Make sure that last pixel in the cache is >1
-        m_mc_cache[npix] = 1.0001;
+        // Set alias table for pixel fluxes
+        m_mc_table.set(fluxes);
 
         // Dump premaration results
         #if defined(G_DEBUG_PREPARE)
@@ -674,12 +649,9 @@ void GModelSpatialDiffuseMap::prepare_map(void)
         std::cout << "Total flux after normalization : " << sum_control << std::endl;
         #endif
 
-        // Dump cache values for debugging
+        // Dump alias table for debugging
         #if defined(G_DEBUG_CACHE)
-        for (int i = 0; i < npix+1; ++i) {
-            std::cout << "i=" << i;
-            std::cout << " c=" << m_mc_cache[i] << std::endl;
-        }
+        std::cout << m_mc_table.print(EXPLICIT) << std::endl;
         #endif
 
     } // endif: there were skymap pixels
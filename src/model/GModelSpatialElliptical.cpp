@@ -28,7 +28,9 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <cmath>
 #include "GException.hpp"
+#include "GMath.hpp"
 #include "GModelSpatialElliptical.hpp"
 
 /* __ Method name definitions ____________________________________________ */
@@ -187,18 +189,100 @@ double GModelSpatialElliptical::eval(const GPhoton& photon) const
  *
  * Evaluates the elliptical spatial model value and analytical model
  * parameter gradients for a specific incident @p photon.
+ *
+ * The gradients of the position parameters and of the position angle are
+ * computed using the chain rule, where the derivatives of the angular
+ * distance \f$\theta\f$ and the position angle \f$\phi\f$ of the photon
+ * with respect to the model centre \f$(\alpha_0,\delta_0)\f$ are computed
+ * analytically, while \f$\partial S / \partial \theta\f$ and
+ * \f$\partial S / \partial \phi\f$ are computed from the model using
+ * central differences. As the model depends on the difference between
+ * \f$\phi\f$ and the position angle of the ellipse, the position angle
+ * gradient is given by \f$-\partial S / \partial \phi\f$.
  ***************************************************************************/
 double GModelSpatialElliptical::eval_gradients(const GPhoton& photon) const
 {
+    // Set step size for model derivatives (radians)
+    const double h = 1.0e-6;
+
     // Compute distance from source and position angle (in radians)
     const GSkyDir& srcDir = photon.dir();
-    double theta          = dir().dist(srcDir);
-    double posang         = dir().posang(srcDir);
+    GSkyDir        centre = dir();
+    double         theta  = centre.dist(srcDir);
+    double         posang = centre.posang(srcDir);
 
     // Evaluate model and set gradients
     double value = eval_gradients(theta, posang, photon.energy(),
                                   photon.time());
 
+    // Initialise position and position angle gradients
+    double g_ra       = 0.0;
+    double g_dec      = 0.0;
+    double g_posangle = 0.0;
+
+    // Compute gradients if required
+    double sin_theta = std::sin(theta);
+    if ((m_ra.isfree() || m_dec.isfree() || m_posangle.isfree()) &&
+        sin_theta > 0.0) {
+
+        // Compute model derivatives with respect to distance and position
+        // angle
+        const GEnergy& eng = photon.energy();
+        const GTime&   t   = photon.time();
+        double ds_dtheta   = (eval(theta + h, posang, eng, t) -
+                              eval(std::abs(theta - h), posang, eng, t)) /
+                             (2.0 * h);
+        double ds_dphi     = (eval(theta, posang + h, eng, t) -
+                              eval(theta, posang - h, eng, t)) / (2.0 * h);
+
+        // Compute partial derivatives of distance and position angle with
+        // respect to the model centre (radians per radians)
+        double cos_dec0   = std::cos(centre.dec());
+        double sin_dec0   = std::sin(centre.dec());
+        double cos_dec    = std::cos(srcDir.dec());
+        double sin_dec    = std::sin(srcDir.dec());
+        double dra        = srcDir.ra() - centre.ra();
+        double cos_dra    = std::cos(dra);
+        double sin_dra    = std::sin(dra);
+        double dtheta_ra  = -cos_dec0 * cos_dec * sin_dra / sin_theta;
+        double dtheta_dec = (sin_dec0 * cos_dec * cos_dra -
+                             cos_dec0 * sin_dec) / sin_theta;
+        double a          = sin_dra;
+        double b          = cos_dec0 * std::tan(srcDir.dec()) -
+                            sin_dec0 * cos_dra;
+        double norm       = a*a + b*b;
+        double dphi_ra    = 0.0;
+        double dphi_dec   = 0.0;
+        if (norm > 0.0) {
+            double da_ra  = -cos_dra;
+            double db_ra  = -sin_dec0 * sin_dra;
+            double db_dec = -sin_dec0 * std::tan(srcDir.dec()) -
+                             cos_dec0 * cos_dra;
+            dphi_ra       = (b * da_ra - a * db_ra) / norm;
+            dphi_dec      = -a * db_dec / norm;
+        }
+
+        // Compute gradients
+        if (m_ra.isfree()) {
+            g_ra = (ds_dtheta * dtheta_ra + ds_dphi * dphi_ra) *
+                   gammalib::deg2rad * m_ra.scale();
+        }
+        if (m_dec.isfree()) {
+            g_dec = (ds_dtheta * dtheta_dec + ds_dphi * dphi_dec) *
+                    gammalib::deg2rad * m_dec.scale();
+        }
+        if (m_posangle.isfree()) {
+            g_posangle = -ds_dphi * gammalib::deg2rad * m_posangle.scale();
+        }
+
+    } // endif: gradients were required
+
+    // Set gradients (circumvent const correctness)
+    GModelSpatialElliptical* ptr = const_cast<GModelSpatialElliptical*>(this);
+    ptr->m_ra.factor_gradient(g_ra);
+    ptr->m_dec.factor_gradient(g_dec);
+    ptr->m_posangle.factor_gradient(g_posangle);
+
     // Return result
     return value;
 }
@@ -447,7 +531,7 @@ void GModelSpatialElliptical::init_members(void)
     m_ra.fix();
     m_ra.scale(1.0);
     m_ra.gradient(0.0);
-    m_ra.hasgrad(false);
+    m_ra.hasgrad(true);
 
     // Initialise Declination
     m_dec.clear();
@@ -456,7 +540,7 @@ void GModelSpatialElliptical::init_members(void)
     m_dec.fix();
     m_dec.scale(1.0);
     m_dec.gradient(0.0);
-    m_dec.hasgrad(false);
+    m_dec.hasgrad(true);
 
     // Initialise Position Angle
     m_posangle.clear();
@@ -465,7 +549,7 @@ void GModelSpatialElliptical::init_members(void)
     m_posangle.fix();
     m_posangle.scale(1.0);
     m_posangle.gradient(0.0);
-    m_posangle.hasgrad(false);
+    m_posangle.hasgrad(true);
 
     // Set parameter pointer(s)
     m_pars.clear();
@@ -337,9 +337,18 @@ double GModelSpatialEllipticalDisk::eval(const double&  theta,
  * @param[in] time Photon arrival time.
  * @return Model value.
  *
- * Evaluates the function value. No gradient computation is implemented as
- * Elliptical models will be convolved with the instrument response and thus
- * require the numerical computation of the derivatives.
+ * Evaluates the function value and the gradients of the semi-minor and
+ * semi-major axes within the disk, given by the derivatives of the
+ * normalization
+ *
+ * \f[
+ *    \frac{\partial S}{\partial a} = -\frac{S(\theta, \phi)}{2}
+ *    \frac{\sin a}{1 - \cos a}
+ * \f]
+ *
+ * (and similarly for the semi-major axis). The contribution of the disk
+ * edge is not included, as it only exists after convolution of the model
+ * with the instrument response (see GResponse::irf_gradients()).
  *
  * See the eval() method for more information.
  ***************************************************************************/
@@ -348,8 +357,37 @@ double GModelSpatialEllipticalDisk::eval_gradients(const double&  theta,
                                                    const GEnergy& energy,
                                                    const GTime&   time) const
 {
+    // Compute value
+    double value = eval(theta, posangle, energy, time);
+
+    // Initialise gradients
+    double g_semiminor = 0.0;
+    double g_semimajor = 0.0;
+
+    // Compute partial derivatives of the semi-axes
+    if (value > 0.0) {
+        double denom_minor = 1.0 - std::cos(m_semiminor_rad);
+        double denom_major = 1.0 - std::cos(m_semimajor_rad);
+        if (m_semiminor.isfree() && denom_minor > 0.0) {
+            g_semiminor = -0.5 * value * std::sin(m_semiminor_rad) /
+                          denom_minor * gammalib::deg2rad *
+                          m_semiminor.scale();
+        }
+        if (m_semimajor.isfree() && denom_major > 0.0) {
+            g_semimajor = -0.5 * value * std::sin(m_semimajor_rad) /
+                          denom_major * gammalib::deg2rad *
+                          m_semimajor.scale();
+        }
+    }
+
+    // Set gradients (circumvent const correctness)
+    GModelSpatialEllipticalDisk* ptr =
+        const_cast<GModelSpatialEllipticalDisk*>(this);
+    ptr->m_semiminor.factor_gradient(g_semiminor);
+    ptr->m_semimajor.factor_gradient(g_semimajor);
+
     // Return value
-    return (eval(theta, posangle, energy, time));
+    return value;
 }
 
 
@@ -643,7 +681,7 @@ void GModelSpatialEllipticalDisk::init_members(void)
     m_semiminor.free();
     m_semiminor.scale(1.0);
     m_semiminor.gradient(0.0);
-    m_semiminor.hasgrad(false);  // Elliptical components never have gradients
+    m_semiminor.hasgrad(true);
 
     // Initialise semi-major axis
     m_semimajor.clear();
@@ -654,7 +692,7 @@ void GModelSpatialEllipticalDisk::init_members(void)
     m_semimajor.free();
     m_semimajor.scale(1.0);
     m_semimajor.gradient(0.0);
-    m_semimajor.hasgrad(false);  // Elliptical components never have gradients
+    m_semimajor.hasgrad(true);
 
     // Set parameter pointer(s)
     m_pars.push_back(&m_semiminor);
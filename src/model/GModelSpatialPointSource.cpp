@@ -276,10 +276,17 @@ double GModelSpatialPointSource::eval(const GPhoton& photon) const
  * 0.1 arcsec, i.e. well below the angular resolution of gamma-ray
  * telescopes).
  *
- * This method does not provide valid parameter gradients.
+ * As the model is a delta function, the parameter gradients of the photon
+ * level model are set to zero. Gradients of the position parameters are
+ * only meaningful after convolution with the instrument response, and are
+ * computed by GResponse::irf_gradients().
  ***************************************************************************/
 double GModelSpatialPointSource::eval_gradients(const GPhoton& photon) const
 {
+    // Set gradients to zero (circumvent const correctness)
+    const_cast<GModelSpatialPointSource*>(this)->m_ra.factor_gradient(0.0);
+    const_cast<GModelSpatialPointSource*>(this)->m_dec.factor_gradient(0.0);
+
     // Return value
     return (eval(photon));
 }
@@ -545,7 +552,7 @@ void GModelSpatialPointSource::init_members(void)
     m_ra.fix();
     m_ra.scale(1.0);
     m_ra.gradient(0.0);
-    m_ra.hasgrad(false);
+    m_ra.hasgrad(true);
 
     // Initialise Declination
     m_dec.clear();
@@ -554,7 +561,7 @@ void GModelSpatialPointSource::init_members(void)
     m_dec.fix();
     m_dec.scale(1.0);
     m_dec.gradient(0.0);
-    m_dec.hasgrad(false);
+    m_dec.hasgrad(true);
 
     // Set parameter pointer(s)
     m_pars.clear();
@@ -28,7 +28,9 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <cmath>
 #include "GException.hpp"
+#include "GMath.hpp"
 #include "GModelSpatialRadial.hpp"
 
 /* __ Method name definitions ____________________________________________ */
@@ -186,15 +188,74 @@ double GModelSpatialRadial::eval(const GPhoton& photon) const
  *
  * Evaluates the radial spatial model value and analytical model parameter
  * gradients for a specific incident @p photon.
+ *
+ * The gradients of the position parameters are computed using the chain
+ * rule
+ *
+ * \f[
+ *    \frac{\partial S}{\partial \alpha_0} =
+ *    \frac{\partial S}{\partial \theta}
+ *    \frac{\partial \theta}{\partial \alpha_0}
+ * \f]
+ *
+ * (and similarly for \f$\delta_0\f$), where the derivatives of the
+ * angular distance \f$\theta\f$ with respect to the model centre
+ * \f$(\alpha_0,\delta_0)\f$ are computed analytically, while
+ * \f$\partial S / \partial \theta\f$ is computed from the radial
+ * profile using a central difference.
  ***************************************************************************/
 double GModelSpatialRadial::eval_gradients(const GPhoton& photon) const
 {
+    // Set step size for radial profile derivative (radians)
+    const double h = 1.0e-6;
+
+    // Get model centre
+    GSkyDir centre = dir();
+
     // Compute distance from source (in radians)
-    double theta = photon.dir().dist(dir());
+    double theta = photon.dir().dist(centre);
 
     // Evaluate model and set gradients
     double value = eval_gradients(theta, photon.energy(), photon.time());
 
+    // Initialise position gradients
+    double g_ra  = 0.0;
+    double g_dec = 0.0;
+
+    // Compute position gradients if required
+    double sin_theta = std::sin(theta);
+    if ((m_ra.isfree() || m_dec.isfree()) && sin_theta > 0.0) {
+
+        // Compute radial profile derivative
+        double s_plus  = eval(theta + h, photon.energy(), photon.time());
+        double s_minus = eval(std::abs(theta - h), photon.energy(), photon.time());
+        double ds      = (s_plus - s_minus) / (2.0 * h);
+
+        // Compute partial derivatives of distance with respect to the
+        // model centre (radians per radians)
+        double cos_dec0  = std::cos(centre.dec());
+        double sin_dec0  = std::sin(centre.dec());
+        double cos_dec   = std::cos(photon.dir().dec());
+        double sin_dec   = std::sin(photon.dir().dec());
+        double dra       = centre.ra() - photon.dir().ra();
+        double dtheta_ra = cos_dec0 * cos_dec * std::sin(dra) / sin_theta;
+        double dtheta_dec = (sin_dec0 * cos_dec * std::cos(dra) -
+                             cos_dec0 * sin_dec) / sin_theta;
+
+        // Compute gradients
+        if (m_ra.isfree()) {
+            g_ra = ds * dtheta_ra * gammalib::deg2rad * m_ra.scale();
+        }
+        if (m_dec.isfree()) {
+            g_dec = ds * dtheta_dec * gammalib::deg2rad * m_dec.scale();
+        }
+
+    } // endif: position gradients were required
+
+    // Set gradients (circumvent const correctness)
+    const_cast<GModelSpatialRadial*>(this)->m_ra.factor_gradient(g_ra);
+    const_cast<GModelSpatialRadial*>(this)->m_dec.factor_gradient(g_dec);
+
     // Return result
     return value;
 }
@@ -427,7 +488,7 @@ void GModelSpatialRadial::init_members(void)
     m_ra.fix();
     m_ra.scale(1.0);
     m_ra.gradient(0.0);
-    m_ra.hasgrad(false);
+    m_ra.hasgrad(true);
 
     // Initialise Declination
     m_dec.clear();
@@ -436,7 +497,7 @@ void GModelSpatialRadial::init_members(void)
     m_dec.fix();
     m_dec.scale(1.0);
     m_dec.gradient(0.0);
-    m_dec.hasgrad(false);
+    m_dec.hasgrad(true);
 
     // Set parameter pointer(s)
     m_pars.clear();
@@ -288,9 +288,17 @@ double GModelSpatialRadialDisk::eval(const double&  theta,
  * @param[in] time Photon arrival time.
  * @return Model value.
  *
- * Evaluates the function value. No gradient computation is implemented as
- * radial models will be convolved with the instrument response and thus
- * require the numerical computation of the derivatives.
+ * Evaluates the function value and the gradient of the disk radius
+ * \f$r\f$ within the disk, given by the derivative of the normalization
+ *
+ * \f[
+ *    \frac{\partial S}{\partial r} = -S(\theta)
+ *    \frac{\sin r}{1 - \cos r}
+ * \f]
+ *
+ * The contribution of the disk edge is not included, as it only exists
+ * after convolution of the model with the instrument response (see
+ * GResponse::irf_gradients()).
  *
  * See the eval() method for more information.
  ***************************************************************************/
@@ -298,8 +306,24 @@ double GModelSpatialRadialDisk::eval_gradients(const double&  theta,
                                                const GEnergy& energy,
                                                const GTime&   time) const
 {
+    // Compute value
+    double value = eval(theta, energy, time);
+
+    // Compute partial derivative of the disk radius
+    double g_radius = 0.0;
+    if (m_radius.isfree() && value > 0.0) {
+        double denom = 1.0 - std::cos(m_radius_rad);
+        if (denom > 0.0) {
+            g_radius = -value * std::sin(m_radius_rad) / denom *
+                       gammalib::deg2rad * m_radius.scale();
+        }
+    }
+
+    // Set gradient (circumvent const correctness)
+    const_cast<GModelSpatialRadialDisk*>(this)->m_radius.factor_gradient(g_radius);
+
     // Return value
-    return (eval(theta, energy, time));
+    return value;
 }
 
 
@@ -538,7 +562,7 @@ void GModelSpatialRadialDisk::init_members(void)
     m_radius.free();
     m_radius.scale(1.0);
     m_radius.gradient(0.0);
-    m_radius.hasgrad(false);  // Radial components never have gradients
+    m_radius.hasgrad(true);
 
     // Set parameter pointer(s)
     m_pars.push_back(&m_radius);
@@ -282,15 +282,39 @@ double GModelSpatialRadialGauss::eval(const double&  theta,
  * @param[in] time Photon arrival time.
  * @return Model value.
  *
- * This method simply calls the eval() method as no analytical gradients
- * will be computed. See the eval() method for more details.
+ * Evaluates the Gaussian model and sets the analytical gradient of the
+ * Gaussian width \f$\sigma\f$, given by
+ *
+ * \f[
+ *    \frac{\partial S}{\partial \sigma} = S(\theta)
+ *    \left( \frac{\theta^2}{\sigma^3} - \frac{2}{\sigma} \right)
+ * \f]
+ *
+ * See the eval() method for more details.
  ***************************************************************************/
 double GModelSpatialRadialGauss::eval_gradients(const double&  theta,
                                                 const GEnergy& energy,
                                                 const GTime&   time) const
 {
+    // Compute value
+    double value = eval(theta, energy, time);
+
+    // Compute partial derivative of the Gaussian width
+    double g_sigma = 0.0;
+    if (m_sigma.isfree()) {
+        double sigma_rad = sigma() * gammalib::deg2rad;
+        if (sigma_rad > 0.0) {
+            double sigma2 = sigma_rad * sigma_rad;
+            g_sigma       = value * (theta * theta / sigma2 - 2.0) / sigma_rad *
+                            gammalib::deg2rad * m_sigma.scale();
+        }
+    }
+
+    // Set gradient (circumvent const correctness)
+    const_cast<GModelSpatialRadialGauss*>(this)->m_sigma.factor_gradient(g_sigma);
+
     // Return value
-    return (eval(theta, energy, time));
+    return value;
 }
 
 
@@ -538,7 +562,7 @@ void GModelSpatialRadialGauss::init_members(void)
     m_sigma.free();
     m_sigma.scale(1.0);
     m_sigma.gradient(0.0);
-    m_sigma.hasgrad(false);  // Radial components never have gradients
+    m_sigma.hasgrad(true);
 
     // Set parameter pointer(s)
     m_pars.push_back(&m_sigma);
@@ -350,15 +350,101 @@ double GModelSpatialRadialShell::eval(const double&  theta,
  * @param[in] time Photon arrival time.
  * @return Model value.
  *
- * This method simply calls the eval() method as no analytical gradients will
- * be computed. See the eval() method for details.
+ * Evaluates the function value and the analytical gradients of the shell
+ * radius and width. Writing the model as
+ * \f$S(\theta) = N \, V(\theta | \theta_{\rm in}, \theta_{\rm out})\f$,
+ * where \f$\theta_{\rm in}\f$ is the radius and
+ * \f$\theta_{\rm out}\f$ is the sum of radius and width, the gradients
+ * are
+ *
+ * \f[
+ *    \frac{\partial S}{\partial r} =
+ *    \frac{\partial S}{\partial \theta_{\rm in}} +
+ *    \frac{\partial S}{\partial \theta_{\rm out}}
+ *    \quad {\rm and} \quad
+ *    \frac{\partial S}{\partial w} =
+ *    \frac{\partial S}{\partial \theta_{\rm out}}
+ * \f]
+ *
+ * The profile derivatives diverge at the shell boundaries, hence they are
+ * only computed strictly within the shell.
+ *
+ * See the eval() method for details.
  ***************************************************************************/
 double GModelSpatialRadialShell::eval_gradients(const double&  theta,
                                                 const GEnergy& energy,
                                                 const GTime&   time) const
 {
+    // Compute value (updates precomputation cache)
+    double value = eval(theta, energy, time);
+
+    // Initialise gradients
+    double g_radius = 0.0;
+    double g_width  = 0.0;
+
+    // Continue only if gradients are needed
+    if (m_radius.isfree() || m_width.isfree()) {
+
+        // Compute x and derivatives of x_in and x_out with respect to the
+        // inner and outer shell radius
+        double x;
+        double dx_in;
+        double dx_out;
+        double dnorm_in;
+        double dnorm_out;
+        double norm2 = gammalib::twopi * m_norm * m_norm;
+        if (m_small_angle) {
+            x         = theta * theta;
+            dx_in     = 2.0 * m_theta_in;
+            dx_out    = 2.0 * m_theta_out;
+            dnorm_in  =  norm2 * m_theta_in  * m_theta_in;
+            dnorm_out = -norm2 * m_theta_out * m_theta_out;
+        }
+        else {
+            x         = std::sin(theta);
+            x        *= x;
+            dx_in     = std::sin(2.0 * m_theta_in);
+            dx_out    = std::sin(2.0 * m_theta_out);
+            dnorm_in  =  norm2 * g1(m_theta_in);
+            dnorm_out = -norm2 * g1(m_theta_out);
+        }
+
+        // Compute shell profile and its derivatives
+        double profile    = 0.0;
+        double dprof_in   = 0.0;
+        double dprof_out  = 0.0;
+        if (x < m_x_out) {
+            double arg_out = std::sqrt(m_x_out - x);
+            profile        = arg_out;
+            dprof_out      = 0.5 * dx_out / arg_out;
+            if (x < m_x_in) {
+                double arg_in = std::sqrt(m_x_in - x);
+                profile      -= arg_in;
+                dprof_in      = -0.5 * dx_in / arg_in;
+            }
+        }
+
+        // Compute derivatives with respect to inner and outer shell radius
+        double d_in  = dnorm_in  * profile + m_norm * dprof_in;
+        double d_out = dnorm_out * profile + m_norm * dprof_out;
+
+        // Compute gradients
+        if (m_radius.isfree()) {
+            g_radius = (d_in + d_out) * gammalib::deg2rad * m_radius.scale();
+        }
+        if (m_width.isfree()) {
+            g_width = d_out * gammalib::deg2rad * m_width.scale();
+        }
+
+    } // endif: gradients were needed
+
+    // Set gradients (circumvent const correctness)
+    GModelSpatialRadialShell* ptr = const_cast<GModelSpatialRadialShell*>(this);
+    ptr->m_radius.factor_gradient(g_radius);
+    ptr->m_width.factor_gradient(g_width);
+
     // Return value
-    return (eval(theta, energy, time));
+    return value;
 }
 
 
@@ -647,7 +733,7 @@ void GModelSpatialRadialShell::init_members(void)
     m_radius.free();
     m_radius.scale(1.0);
     m_radius.gradient(0.0);
-    m_radius.hasgrad(false);  // Radial components never have gradients
+    m_radius.hasgrad(true);
 
     // Initialise Width
     m_width.clear();
@@ -658,7 +744,7 @@ void GModelSpatialRadialShell::init_members(void)
     m_width.free();
     m_width.scale(1.0);
     m_width.gradient(0.0);
-    m_width.hasgrad(false);  // Radial components never have gradients
+    m_width.hasgrad(true);
 
     // Set parameter pointer(s)
     m_pars.push_back(&m_radius);
@@ -844,3 +930,23 @@ double GModelSpatialRadialShell::f2(double x)
     // Return value
     return f2;
 }
+
+
+/***********************************************************************//**
+ * @brief Return derivative of normalization integral
+ *
+ * Computes
+ * \f[g1(x) = -\sin x \cos x
+ *    \ln \left( \frac{\cos x}{1 + \sin x} \right)\f],
+ * which is the derivative of \f$f1(x)/(2\sqrt{2}) + f2(x)\f$.
+ ***************************************************************************/
+double GModelSpatialRadialShell::g1(double x)
+{
+    // Compute value
+    double sin_x = std::sin(x);
+    double cos_x = std::cos(x);
+    double g1    = -sin_x * cos_x * std::log(cos_x / (1.0 + sin_x));
+
+    // Return value
+    return g1;
+}
@@ -30,6 +30,7 @@
 #endif
 #include "GException.hpp"
 #include "GModelSpectral.hpp"
+#include "GEventBatch.hpp"
 
 /* __ Method name definitions ____________________________________________ */
 #define G_ACCESS1                          "GModelSpectral::operator[](int&)"
@@ -224,6 +225,54 @@ const GModelPar& GModelSpectral::operator[](const std::string& name) const
  =                                                                         =
  ==========================================================================*/
 
+/***********************************************************************//**
+ * @brief Evaluate spectral model for a batch of events
+ *
+ * @param[in] batch Event batch.
+ * @param[out] values Model values (batch.size() elements).
+ * @param[out] gradients Parameter gradients (size()*batch.size() elements).
+ *
+ * Evaluates the spectral model at the energies and times of all events of
+ * a batch. If @p gradients is not NULL, the parameter gradients are
+ * written into the @p gradients array, where the gradient of parameter
+ * @p k for event @p i is stored at position @p k*batch.size()+i.
+ *
+ * This generic implementation calls eval() or eval_gradients() for each
+ * event. Derived classes may overload the method to compute the model
+ * directly from the energy arrays of the batch.
+ ***************************************************************************/
+void GModelSpectral::eval_batch(const GEventBatch& batch,
+                                double*            values,
+                                double*            gradients)
+{
+    // Get number of events and parameters
+    int nevents = batch.size();
+    int npars   = size();
+
+    // Case A: evaluate gradients
+    if (gradients != NULL) {
+        for (int i = 0; i < nevents; ++i) {
+            const GEventAtom* event = batch[i];
+            values[i] = eval_gradients(event->energy(), event->time());
+            for (int k = 0, inx = i; k < npars; ++k, inx += nevents) {
+                gradients[inx] = m_pars[k]->factor_gradient();
+            }
+        }
+    }
+
+    // Case B: evaluate no gradients
+    else {
+        for (int i = 0; i < nevents; ++i) {
+            const GEventAtom* event = batch[i];
+            values[i] = eval(event->energy(), event->time());
+        }
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Return number of parameters
  *
@@ -365,12 +365,10 @@ double GModelSpectralFunc::flux(const GEnergy& emin, const GEnergy& emax) const
         double e_max = emax.MeV();
     
         // Determine left node index for minimum energy
-        m_lin_nodes.set_value(e_min);
-        int inx_emin = m_lin_nodes.inx_left();
+        int inx_emin = m_lin_nodes.locate(e_min).inx_left();
 
         // Determine left node index for maximum energy
-        m_lin_nodes.set_value(e_max);
-        int inx_emax = m_lin_nodes.inx_left();
+        int inx_emax = m_lin_nodes.locate(e_max).inx_left();
     
         // If both energies are within the same nodes then simply
         // integrate over the energy interval using the appropriate power
@@ -453,12 +451,10 @@ double GModelSpectralFunc::eflux(const GEnergy& emin, const GEnergy& emax) const
         double e_max = emax.MeV();
     
         // Determine left node index for minimum energy
-        m_lin_nodes.set_value(e_min);
-        int inx_emin = m_lin_nodes.inx_left();
+        int inx_emin = m_lin_nodes.locate(e_min).inx_left();
 
         // Determine left node index for maximum energy
-        m_lin_nodes.set_value(e_max);
-        int inx_emax = m_lin_nodes.inx_left();
+        int inx_emax = m_lin_nodes.locate(e_max).inx_left();
     
         // If both energies are within the same nodes then simply
         // integrate over the energy interval using the appropriate power
@@ -548,13 +544,8 @@ GEnergy GModelSpectralFunc::mc(const GEnergy& emin,
 
     // Determine in which bin we reside
     int inx = 0;
-    if (m_mc_cum.size() > 1) {
-        double u = ran.uniform();
-        for (inx = m_mc_cum.size()-1; inx > 0; --inx) {
-            if (m_mc_cum[inx-1] <= u) {
-                break;
-            }
-        }
+    if (m_mc_table.size() > 1) {
+        inx = m_mc_table.draw(ran);
     }
 
     // Get random energy for specific bin
@@ -770,7 +761,7 @@ void GModelSpectralFunc::init_members(void)
     // Initialise cache
     m_mc_emin.clear();
     m_mc_emax.clear();
-    m_mc_cum.clear();
+    m_mc_table.clear();
     m_mc_min.clear();
     m_mc_max.clear();
     m_mc_exp.clear();
@@ -805,7 +796,7 @@ void GModelSpectralFunc::copy_members(const GModelSpectralFunc& model)
     // Copy MC cache
     m_mc_emin    = model.m_mc_emin;
     m_mc_emax    = model.m_mc_emax;
-    m_mc_cum     = model.m_mc_cum;
+    m_mc_table   = model.m_mc_table;
     m_mc_min     = model.m_mc_min;
     m_mc_max     = model.m_mc_max;
     m_mc_exp     = model.m_mc_exp;
@@ -985,8 +976,9 @@ void GModelSpectralFunc::set_cache(void) const
  * @param[in] emin Minimum energy.
  * @param[in] emax Maximum energy.
  *
- * This method sets up an array of indices and the cumulative distribution
- * function needed for MC simulations.
+ * This method sets up the power law segments needed for MC simulations,
+ * together with an alias table that allows drawing a segment with a
+ * probability proportional to its photon flux in constant time.
  ***************************************************************************/
 void GModelSpectralFunc::mc_update(const GEnergy& emin,
                                    const GEnergy& emax) const
@@ -999,7 +991,8 @@ void GModelSpectralFunc::mc_update(const GEnergy& emin,
         m_mc_emax = emax;
         
         // Initialise cache
-        m_mc_cum.clear();
+        std::vector<double> fluxes;
+        m_mc_table.clear();
         m_mc_min.clear();
         m_mc_max.clear();
         m_mc_exp.clear();
@@ -1015,12 +1008,10 @@ void GModelSpectralFunc::mc_update(const GEnergy& emin,
             double flux;
     
             // Determine left node index for minimum energy
-            m_lin_nodes.set_value(e_min);
-            int inx_emin = m_lin_nodes.inx_left();
+            int inx_emin = m_lin_nodes.locate(e_min).inx_left();
 
             // Determine left node index for maximum energy
-            m_lin_nodes.set_value(e_max);
-            int inx_emax = m_lin_nodes.inx_left();
+            int inx_emax = m_lin_nodes.locate(e_max).inx_left();
     
             // If both energies are within the same node then just
             // add this one node on the stack
@@ -1030,7 +1021,7 @@ void GModelSpectralFunc::mc_update(const GEnergy& emin,
                                                   e_max, 
                                                   m_epivot[inx_emin],
                                                   m_gamma[inx_emin]);
-                m_mc_cum.push_back(flux);
+                fluxes.push_back(flux);
                 m_mc_min.push_back(e_min);
                 m_mc_max.push_back(e_max);
                 m_mc_exp.push_back(m_gamma[inx_emin]);
@@ -1051,7 +1042,7 @@ void GModelSpectralFunc::mc_update(const GEnergy& emin,
                                                   m_lin_nodes[i_start],
                                                   m_epivot[inx_emin],
                                                   m_gamma[inx_emin]);
-                m_mc_cum.push_back(flux);
+                fluxes.push_back(flux);
                 m_mc_min.push_back(e_min);
                 m_mc_max.push_back(m_lin_nodes[i_start]);
                 m_mc_exp.push_back(m_gamma[inx_emin]);
@@ -1059,7 +1050,7 @@ void GModelSpectralFunc::mc_update(const GEnergy& emin,
                 // Add all nodes between
                 for (int i = i_start; i < inx_emax; ++i) {
                     flux = m_flux[i];
-                    m_mc_cum.push_back(flux);
+                    fluxes.push_back(flux);
                     m_mc_min.push_back(m_lin_nodes[i]);
                     m_mc_max.push_back(m_lin_nodes[i+1]);
                     m_mc_exp.push_back(m_gamma[i]);
@@ -1071,24 +1062,18 @@ void GModelSpectralFunc::mc_update(const GEnergy& emin,
                                                   e_max,
                                                   m_epivot[inx_emax],
                                                   m_gamma[inx_emax]);
-                m_mc_cum.push_back(flux);
+                fluxes.push_back(flux);
                 m_mc_min.push_back(m_lin_nodes[inx_emax]);
                 m_mc_max.push_back(e_max);
                 m_mc_exp.push_back(m_gamma[inx_emax]);
         
             } // endelse: emin and emax not between same nodes
 
-            // Build cumulative distribution
-            for (int i = 1; i < m_mc_cum.size(); ++i) {
-                m_mc_cum[i] += m_mc_cum[i-1];
-            }
-            double norm = m_mc_cum[m_mc_cum.size()-1];
-            for (int i = 0; i < m_mc_cum.size(); ++i) {
-                m_mc_cum[i] /= norm;
-            }
+            // Build alias table for segment selection
+            m_mc_table.set(fluxes);
 
             // Set MC values
-            for (int i = 0; i < m_mc_cum.size(); ++i) {
+            for (int i = 0; i < m_mc_exp.size(); ++i) {
 
                 // Compute exponent
                 double exponent = m_mc_exp[i] + 1.0;
@@ -305,14 +305,12 @@ double GModelSpectralNodes::eval_gradients(const GEnergy& srcEng,
     // Update evaluation cache
     update_eval_cache();
 
-    // Set interpolation value
-    m_log_energies.set_value(srcEng.log10MeV());
-
     // Get indices and weights for interpolation
-    int    inx_left  = m_log_energies.inx_left();
-    int    inx_right = m_log_energies.inx_right();
-    double wgt_left  = m_log_energies.wgt_left();
-    double wgt_right = m_log_energies.wgt_right();
+    GNodeArray::handle h = m_log_energies.locate(srcEng.log10MeV());
+    int    inx_left      = h.inx_left();
+    int    inx_right     = h.inx_right();
+    double wgt_left      = h.wgt_left();
+    double wgt_right     = h.wgt_right();
 
     // Interpolate function
     double exponent = m_log_values[inx_left]  * wgt_left +
@@ -389,12 +387,10 @@ double GModelSpectralNodes::flux(const GEnergy& emin, const GEnergy& emax) const
         double e_max = emax.MeV();
     
         // Determine left node index for minimum energy
-        m_lin_energies.set_value(e_min);
-        int inx_emin = m_lin_energies.inx_left();
+        int inx_emin = m_lin_energies.locate(e_min).inx_left();
 
         // Determine left node index for maximum energy
-        m_lin_energies.set_value(e_max);
-        int inx_emax = m_lin_energies.inx_left();
+        int inx_emax = m_lin_energies.locate(e_max).inx_left();
     
         // If both energies are within the same nodes then simply
         // integrate over the energy interval using the appropriate power
@@ -476,12 +472,10 @@ double GModelSpectralNodes::eflux(const GEnergy& emin, const GEnergy& emax) cons
         double e_max = emax.MeV();
     
         // Determine left node index for minimum energy
-        m_lin_energies.set_value(e_min);
-        int inx_emin = m_lin_energies.inx_left();
+        int inx_emin = m_lin_energies.locate(e_min).inx_left();
 
         // Determine left node index for maximum energy
-        m_lin_energies.set_value(e_max);
-        int inx_emax = m_lin_energies.inx_left();
+        int inx_emax = m_lin_energies.locate(e_max).inx_left();
     
         // If both energies are within the same nodes then simply
         // integrate over the energy interval using the appropriate power
@@ -567,12 +561,8 @@ GEnergy GModelSpectralNodes::mc(const GEnergy& emin,
 
     // Determine in which bin we reside
     int inx = 0;
-    if (m_mc_cum.size() > 1) {
-        double u = ran.uniform();
-        for (inx = m_mc_cum.size()-1; inx > 0; --inx) {
-            if (m_mc_cum[inx-1] <= u)
-                break;
-        }
+    if (m_mc_table.size() > 1) {
+        inx = m_mc_table.draw(ran);
     }
 
     // Get random energy for specific bin
@@ -1214,7 +1204,7 @@ void GModelSpectralNodes::init_members(void)
     // Initialise MC cache
     m_mc_emin.clear();
     m_mc_emax.clear();
-    m_mc_cum.clear();
+    m_mc_table.clear();
     m_mc_min.clear();
     m_mc_max.clear();
     m_mc_exp.clear();
@@ -1256,7 +1246,7 @@ void GModelSpectralNodes::copy_members(const GModelSpectralNodes& model)
     // Copy MC cache
     m_mc_emin      = model.m_mc_emin;
     m_mc_emax      = model.m_mc_emax;
-    m_mc_cum       = model.m_mc_cum;
+    m_mc_table     = model.m_mc_table;
     m_mc_min       = model.m_mc_min;
     m_mc_max       = model.m_mc_max;
     m_mc_exp       = model.m_mc_exp;
@@ -1544,8 +1534,9 @@ void GModelSpectralNodes::update_flux_cache(void) const
  * @param[in] emin Minimum energy.
  * @param[in] emax Maximum energy.
  *
- * This method sets up an array of indices and the cumulative distribution
- * function needed for MC simulations.
+ * This method sets up the power law segments needed for MC simulations,
+ * together with an alias table that allows drawing a segment with a
+ * probability proportional to its photon flux in constant time.
  ***************************************************************************/
 void GModelSpectralNodes::mc_update(const GEnergy& emin, const GEnergy& emax) const
 {
@@ -1557,7 +1548,8 @@ void GModelSpectralNodes::mc_update(const GEnergy& emin, const GEnergy& emax) co
         m_mc_emax = emax;
         
         // Initialise cache
-        m_mc_cum.clear();
+        std::vector<double> fluxes;
+        m_mc_table.clear();
         m_mc_min.clear();
         m_mc_max.clear();
         m_mc_exp.clear();
@@ -1573,12 +1565,10 @@ void GModelSpectralNodes::mc_update(const GEnergy& emin, const GEnergy& emax) co
             double flux;
     
             // Determine left node index for minimum energy
-            m_lin_energies.set_value(e_min);
-            int inx_emin = m_lin_energies.inx_left();
+            int inx_emin = m_lin_energies.locate(e_min).inx_left();
 
             // Determine left node index for maximum energy
-            m_lin_energies.set_value(e_max);
-            int inx_emax = m_lin_energies.inx_left();
+            int inx_emax = m_lin_energies.locate(e_max).inx_left();
     
             // If both energies are within the same node then just
             // add this one node on the stack
@@ -1588,7 +1578,7 @@ void GModelSpectralNodes::mc_update(const GEnergy& emin, const GEnergy& emax) co
                                                   e_max, 
                                                   m_epivot[inx_emin],
                                                   m_gamma[inx_emin]);
-                m_mc_cum.push_back(flux);
+                fluxes.push_back(flux);
                 m_mc_min.push_back(e_min);
                 m_mc_max.push_back(e_max);
                 m_mc_exp.push_back(m_gamma[inx_emin]);
@@ -1609,7 +1599,7 @@ void GModelSpectralNodes::mc_update(const GEnergy& emin, const GEnergy& emax) co
                                                   m_lin_energies[i_start],
                                                   m_epivot[inx_emin],
                                                   m_gamma[inx_emin]);
-                m_mc_cum.push_back(flux);
+                fluxes.push_back(flux);
                 m_mc_min.push_back(e_min);
                 m_mc_max.push_back(m_lin_energies[i_start]);
                 m_mc_exp.push_back(m_gamma[inx_emin]);
@@ -1617,7 +1607,7 @@ void GModelSpectralNodes::mc_update(const GEnergy& emin, const GEnergy& emax) co
                 // Add all nodes between
                 for (int i = i_start; i < inx_emax; ++i) {
                     flux = m_flux[i];
-                    m_mc_cum.push_back(flux);
+                    fluxes.push_back(flux);
                     m_mc_min.push_back(m_lin_energies[i]);
                     m_mc_max.push_back(m_lin_energies[i+1]);
                     m_mc_exp.push_back(m_gamma[i]);
@@ -1629,24 +1619,18 @@ void GModelSpectralNodes::mc_update(const GEnergy& emin, const GEnergy& emax) co
                                                   e_max,
                                                   m_epivot[inx_emax],
                                                   m_gamma[inx_emax]);
-                m_mc_cum.push_back(flux);
+                fluxes.push_back(flux);
                 m_mc_min.push_back(m_lin_energies[inx_emax]);
                 m_mc_max.push_back(e_max);
                 m_mc_exp.push_back(m_gamma[inx_emax]);
         
             } // endelse: emin and emax not between same nodes
 
-            // Build cumulative distribution
-            for (int i = 1; i < m_mc_cum.size(); ++i) {
-                m_mc_cum[i] += m_mc_cum[i-1];
-            }
-            double norm = m_mc_cum[m_mc_cum.size()-1];
-            for (int i = 0; i < m_mc_cum.size(); ++i) {
-                m_mc_cum[i] /= norm;
-            }
+            // Build alias table for segment selection
+            m_mc_table.set(fluxes);
 
             // Set MC values
-            for (int i = 0; i < m_mc_cum.size(); ++i) {
+            for (int i = 0; i < m_mc_exp.size(); ++i) {
 
                 // Compute exponent
                 double exponent = m_mc_exp[i] + 1.0;
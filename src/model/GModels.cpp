@@ -28,6 +28,8 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <cmath>
+#include <vector>
 #include "GTools.hpp"
 #include "GException.hpp"
 #include "GModels.hpp"
@@ -49,10 +51,13 @@
 #define G_REMOVE2                             "GModels::remove(std::string&)"
 #define G_EXTEND                                  "GModels::extend(GModels&)"
 #define G_READ                                         "GModels::read(GXml&)"
+#define G_COVARIANCE                "GModels::covariance(GMatrixSymmetric&)"
+#define G_READ_CORRELATIONS       "GModels::read_correlations(GXmlElement&)"
 
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
+#define G_CORRELATION_MIN  1.0e-6    //!< Minimum written correlation coefficient
 
 /* __ Debug definitions __________________________________________________ */
 
@@ -740,7 +745,9 @@ void GModels::save(const std::string& filename) const
  *       </source>
  *     </source_library>
  *
- * Each @p source tag will be interpreted as a model component.
+ * Each @p source tag will be interpreted as a model component. Optional
+ * @p correlation tags are used to rebuild the parameter covariance matrix
+ * (see read_correlations()).
  *
  * @todo Sources names are not verified so far for uniqueness. This would be
  *       required to achieve an unambiguous update of parameters in an already
@@ -783,6 +790,9 @@ void GModels::read(const GXml& xml)
 
     } // endfor: looped over all sources
 
+    // Read parameter correlations
+    read_correlations(*lib);
+
     // Return
     return;
 }
@@ -795,7 +805,8 @@ void GModels::read(const GXml& xml)
  *
  * Write models into the first source library that is found in the XML
  * document. In case that no source library exists, one is added to the
- * document.
+ * document. If a parameter covariance matrix is available, the parameter
+ * correlations are written as well (see write_correlations()).
  ***************************************************************************/
 void GModels::write(GXml& xml) const
 {
@@ -812,6 +823,9 @@ void GModels::write(GXml& xml) const
         m_models[i]->write(*lib);
     }
 
+    // Write parameter correlations
+    write_correlations(*lib);
+
     // Return
     return;
 }
@@ -865,6 +879,40 @@ double GModels::eval_gradients(const GEvent& event,
 }
 
 
+/***********************************************************************//**
+ * @brief Set parameter covariance matrix
+ *
+ * @param[in] covariance Parameter covariance matrix.
+ *
+ * @exception GException::invalid_argument
+ *            Covariance matrix dimension does not match number of
+ *            parameters.
+ *
+ * Sets the covariance matrix of the model parameters. The matrix needs to
+ * be indexed like the flat parameter array and given in parameter units.
+ * An empty matrix removes the covariance information.
+ ***************************************************************************/
+void GModels::covariance(const GMatrixSymmetric& covariance)
+{
+    // Check matrix dimension
+    if (covariance.rows() > 0 &&
+        (covariance.rows() != npars() || covariance.columns() != npars())) {
+        std::string msg = "Covariance matrix dimension "+
+                          gammalib::str(covariance.rows())+" x "+
+                          gammalib::str(covariance.columns())+
+                          " does not match the number of model parameters ("+
+                          gammalib::str(npars())+").";
+        throw GException::invalid_argument(G_COVARIANCE, msg);
+    }
+
+    // Set covariance matrix
+    m_covariance = covariance;
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Print models
  *
@@ -915,6 +963,7 @@ void GModels::init_members(void)
 {
     // Initialise members
     m_models.clear();
+    m_covariance = GMatrixSymmetric();
 
     // Return
     return;
@@ -941,6 +990,9 @@ void GModels::copy_members(const GModels& models)
     // Set parameter pointers
     set_pointers();
 
+    // Copy covariance matrix (after setting the pointers, which drops it)
+    m_covariance = models.m_covariance;
+
     // Return
     return;
 }
@@ -971,11 +1023,15 @@ void GModels::free_members(void)
  * Gathers all parameter pointers from the models into a linear array of
  * GModelPar pointers. This exposes all model parameters to the base class
  * GOptimizerPars in form of a linear array.
+ *
+ * As the parameter indices may change, any parameter covariance matrix is
+ * dropped.
  ***************************************************************************/
 void GModels::set_pointers(void)
 {
-    // Clear parameters
+    // Clear parameters and covariance matrix
     m_pars.clear();
+    m_covariance = GMatrixSymmetric();
 
     // Gather all pointers
     for (int i = 0; i < size(); ++i) {
@@ -1014,3 +1070,181 @@ int GModels::get_index(const std::string& name) const
     // Return index
     return index;
 }
+
+
+/***********************************************************************//**
+ * @brief Return flat parameter index
+ *
+ * @param[in] source Model name.
+ * @param[in] parameter Parameter name.
+ * @return Index in flat parameter array (-1 if not found)
+ *
+ * Returns the index of the parameter @p parameter of the model @p source
+ * in the flat parameter array. If no such parameter exists the method
+ * returns -1.
+ ***************************************************************************/
+int GModels::par_index(const std::string& source,
+                       const std::string& parameter) const
+{
+    // Initialise index
+    int index = -1;
+
+    // Search parameter
+    int offset = 0;
+    for (int i = 0; i < size(); ++i) {
+        if (m_models[i]->name() == source) {
+            for (int k = 0; k < m_models[i]->size(); ++k) {
+                if ((*m_models[i])[k].name() == parameter) {
+                    index = offset + k;
+                    break;
+                }
+            }
+            break;
+        }
+        offset += m_models[i]->size();
+    }
+
+    // Return index
+    return index;
+}
+
+
+/***********************************************************************//**
+ * @brief Read parameter correlations from source library
+ *
+ * @param[in] lib Source library.
+ *
+ * @exception GException::invalid_value
+ *            Correlation refers to unknown source or parameter.
+ *
+ * Rebuilds the parameter covariance matrix from the @p correlation elements
+ * of the source library. The diagonal elements are the squared parameter
+ * errors, the off-diagonal elements are the correlation coefficients
+ * multiplied by the respective parameter errors. Off-diagonal elements
+ * without @p correlation element are zero. Nothing is done if the source
+ * library contains no @p correlation element.
+ ***************************************************************************/
+void GModels::read_correlations(const GXmlElement& lib)
+{
+    // Get number of correlations. Continue only if there are some
+    int n = lib.elements("correlation");
+    if (n > 0) {
+
+        // Initialise covariance matrix with the squared parameter errors
+        int              npar = npars();
+        GMatrixSymmetric covariance(npar, npar);
+        for (int i = 0; i < npar; ++i) {
+            double error    = m_pars[i]->error();
+            covariance(i,i) = error * error;
+        }
+
+        // Loop over all correlations
+        for (int k = 0; k < n; ++k) {
+
+            // Get pointer on correlation
+            const GXmlElement* cor = lib.element("correlation", k);
+
+            // Get parameter indices
+            int i = par_index(cor->attribute("source1"), cor->attribute("parameter1"));
+            int j = par_index(cor->attribute("source2"), cor->attribute("parameter2"));
+            if (i == -1 || j == -1) {
+                std::string msg =
+                    "Correlation between parameter \""+
+                    cor->attribute("parameter1")+"\" of source \""+
+                    cor->attribute("source1")+"\" and parameter \""+
+                    cor->attribute("parameter2")+"\" of source \""+
+                    cor->attribute("source2")+"\" refers to an unknown"
+                    " parameter.";
+                throw GException::invalid_value(G_READ_CORRELATIONS, msg);
+            }
+
+            // Set covariance
+            if (i != j) {
+                double value = gammalib::todouble(cor->attribute("value"));
+                covariance(i,j) = value * m_pars[i]->error() *
+                                          m_pars[j]->error();
+            }
+
+        } // endfor: looped over correlations
+
+        // Store covariance matrix
+        m_covariance = covariance;
+
+    } // endif: there were correlations
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Write parameter correlations into source library
+ *
+ * @param[in] lib Source library.
+ *
+ * Removes all @p correlation elements from the source library and, if a
+ * covariance matrix is available, writes one @p correlation element for
+ * each pair of free parameters with non-zero variances whose correlation
+ * coefficient is at least G_CORRELATION_MIN in absolute value. Pairs of
+ * uncorrelated parameters are hence omitted, which keeps the source library
+ * small for large models; read_correlations() sets the covariance of pairs
+ * without @p correlation element to zero.
+ ***************************************************************************/
+void GModels::write_correlations(GXmlElement& lib) const
+{
+    // Remove existing correlations
+    for (int k = lib.size()-1; k >= 0; --k) {
+        const GXmlNode* node = lib[k];
+        if (node->type() == GXmlNode::NT_ELEMENT &&
+            static_cast<const GXmlElement*>(node)->name() == "correlation") {
+            lib.remove(k);
+        }
+    }
+
+    // Continue only if covariance matrix matches the parameters
+    int npar = npars();
+    if (npar > 0 && m_covariance.rows() == npar) {
+
+        // Gather source names for all parameters
+        std::vector<std::string> sources;
+        sources.reserve(npar);
+        for (int i = 0; i < size(); ++i) {
+            for (int k = 0; k < m_models[i]->size(); ++k) {
+                sources.push_back(m_models[i]->name());
+            }
+        }
+
+        // Loop over all pairs of free parameters
+        for (int i = 0; i < npar; ++i) {
+            double var_i = m_covariance(i,i);
+            if (!m_pars[i]->isfree() || var_i <= 0.0) {
+                continue;
+            }
+            for (int j = i+1; j < npar; ++j) {
+                double var_j = m_covariance(j,j);
+                if (!m_pars[j]->isfree() || var_j <= 0.0) {
+                    continue;
+                }
+
+                // Compute correlation coefficient. Skip uncorrelated pairs
+                double value = m_covariance(i,j) / std::sqrt(var_i * var_j);
+                if (std::abs(value) < G_CORRELATION_MIN) {
+                    continue;
+                }
+
+                // Append correlation
+                GXmlElement* cor = lib.append("correlation");
+                cor->attribute("source1",    sources[i]);
+                cor->attribute("parameter1", m_pars[i]->name());
+                cor->attribute("source2",    sources[j]);
+                cor->attribute("parameter2", m_pars[j]->name());
+                cor->attribute("value",      gammalib::str(value));
+
+            } // endfor: looped over second parameter
+        } // endfor: looped over first parameter
+
+    } // endif: covariance matrix was available
+
+    // Return
+    return;
+}
@@ -0,0 +1,462 @@
+/***************************************************************************
+ *                 GFft.cpp - Fast Fourier transform class                 *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFft.cpp
+ * @brief Fast Fourier transform class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <cmath>
+#include <algorithm>
+#include "GFft.hpp"
+#include "GTools.hpp"
+#include "GMath.hpp"
+#include "GException.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+#define G_CONSTRUCT                                  "GFft::GFft(int&, int&)"
+#define G_MULTIPLY                                  "GFft::operator*=(GFft&)"
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+
+/*==========================================================================
+ =                                                                         =
+ =                        Constructors/destructors                         =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GFft::GFft(void)
+{
+    // Initialise members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Array constructor
+ *
+ * @param[in] nx Number of elements in x (power of two).
+ * @param[in] ny Number of elements in y (power of two, defaults to 1).
+ *
+ * @exception GException::invalid_argument
+ *            Array dimension is not a power of two.
+ *
+ * Constructs an array of nx times ny complex elements set to zero.
+ ***************************************************************************/
+GFft::GFft(const int& nx, const int& ny)
+{
+    // Check dimensions
+    if (nx < 1 || size2(nx) != nx || ny < 1 || size2(ny) != ny) {
+        std::string msg = "Array dimensions "+gammalib::str(nx)+" x "+
+                          gammalib::str(ny)+" are not powers of two.";
+        throw GException::invalid_argument(G_CONSTRUCT, msg);
+    }
+
+    // Initialise members
+    init_members();
+
+    // Allocate array
+    m_nx = nx;
+    m_ny = ny;
+    m_data.assign(nx * ny, std::complex<double>(0.0, 0.0));
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] fft Fast Fourier transform.
+ ***************************************************************************/
+GFft::GFft(const GFft& fft)
+{
+    // Initialise members
+    init_members();
+
+    // Copy members
+    copy_members(fft);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GFft::~GFft(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                               Operators                                 =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] fft Fast Fourier transform.
+ * @return Fast Fourier transform.
+ ***************************************************************************/
+GFft& GFft::operator=(const GFft& fft)
+{
+    // Execute only if object is not identical
+    if (this != &fft) {
+
+        // Free members
+        free_members();
+
+        // Initialise private members for clean destruction
+        init_members();
+
+        // Copy members
+        copy_members(fft);
+
+    } // endif: object was not identical
+
+    // Return this object
+    return *this;
+}
+
+
+/***********************************************************************//**
+ * @brief Element-wise multiplication operator
+ *
+ * @param[in] fft Fast Fourier transform.
+ * @return Fast Fourier transform.
+ *
+ * @exception GException::invalid_argument
+ *            Array dimensions differ.
+ *
+ * Multiplies all array elements by the corresponding elements of @p fft.
+ * Applied to two forward transforms, a subsequent backward transform gives
+ * the cyclic convolution of the original arrays.
+ ***************************************************************************/
+GFft& GFft::operator*=(const GFft& fft)
+{
+    // Check dimensions
+    if (m_nx != fft.m_nx || m_ny != fft.m_ny) {
+        std::string msg = "Array dimensions "+gammalib::str(fft.m_nx)+" x "+
+                          gammalib::str(fft.m_ny)+" differ from "+
+                          gammalib::str(m_nx)+" x "+gammalib::str(m_ny)+".";
+        throw GException::invalid_argument(G_MULTIPLY, msg);
+    }
+
+    // Multiply elements
+    for (int i = 0; i < m_data.size(); ++i) {
+        m_data[i] *= fft.m_data[i];
+    }
+
+    // Return this object
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear fast Fourier transform
+ ***************************************************************************/
+void GFft::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise private members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone fast Fourier transform
+ *
+ * @return Pointer to deep copy of fast Fourier transform.
+ ***************************************************************************/
+GFft* GFft::clone(void) const
+{
+    return new GFft(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Forward transform
+ *
+ * Replaces the array by its discrete Fourier transform
+ *
+ * \f[
+ *    F(k_x,k_y) = \sum_{x,y} f(x,y)
+ *                 \exp(-2 \pi i (k_x x / n_x + k_y y / n_y))
+ * \f]
+ ***************************************************************************/
+void GFft::forward(void)
+{
+    // Transform
+    transform(-1.0);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Backward transform
+ *
+ * Replaces the array by its normalised inverse discrete Fourier transform
+ *
+ * \f[
+ *    f(x,y) = \frac{1}{n_x n_y} \sum_{k_x,k_y} F(k_x,k_y)
+ *             \exp(2 \pi i (k_x x / n_x + k_y y / n_y))
+ * \f]
+ ***************************************************************************/
+void GFft::backward(void)
+{
+    // Transform
+    transform(+1.0);
+
+    // Normalise
+    if (!m_data.empty()) {
+        double norm = 1.0 / double(m_data.size());
+        for (int i = 0; i < m_data.size(); ++i) {
+            m_data[i] *= norm;
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return smallest power of two not smaller than a number
+ *
+ * @param[in] n Number.
+ * @return Smallest power of two that is >= n (1 for n < 1).
+ ***************************************************************************/
+int GFft::size2(const int& n)
+{
+    // Find power of two
+    int size = 1;
+    while (size < n) {
+        size *= 2;
+    }
+
+    // Return
+    return size;
+}
+
+
+/***********************************************************************//**
+ * @brief Print fast Fourier transform information
+ *
+ * @param[in] chatter Chattiness (defaults to NORMAL).
+ * @return String containing fast Fourier transform information.
+ ***************************************************************************/
+std::string GFft::print(const GChatter& chatter) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Continue only if chatter is not silent
+    if (chatter != SILENT) {
+
+        // Append header
+        result.append("=== GFft ===");
+
+        // Append information
+        result.append("\n"+gammalib::parformat("Array dimensions"));
+        result.append(gammalib::str(m_nx)+" x "+gammalib::str(m_ny));
+
+    } // endif: chatter was not silent
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Private methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GFft::init_members(void)
+{
+    // Initialise members
+    m_nx = 0;
+    m_ny = 0;
+    m_data.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] fft Fast Fourier transform.
+ ***************************************************************************/
+void GFft::copy_members(const GFft& fft)
+{
+    // Copy members
+    m_nx   = fft.m_nx;
+    m_ny   = fft.m_ny;
+    m_data = fft.m_data;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GFft::free_members(void)
+{
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Transform array
+ *
+ * @param[in] sign Sign of exponent (-1 for forward, +1 for backward).
+ *
+ * Transforms all rows, then all columns of the array.
+ ***************************************************************************/
+void GFft::transform(const double& sign)
+{
+    // Transform rows
+    if (m_nx > 1) {
+        for (int iy = 0; iy < m_ny; ++iy) {
+            transform(&(m_data[iy * m_nx]), m_nx, 1, sign);
+        }
+    }
+
+    // Transform columns
+    if (m_ny > 1) {
+        for (int ix = 0; ix < m_nx; ++ix) {
+            transform(&(m_data[ix]), m_ny, m_nx, sign);
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Transform one-dimensional sequence
+ *
+ * @param[in,out] data Pointer to first sequence element.
+ * @param[in] n Number of sequence elements (power of two).
+ * @param[in] stride Distance between sequence elements in array.
+ * @param[in] sign Sign of exponent (-1 for forward, +1 for backward).
+ *
+ * Transforms the sequence in place using the iterative radix-2
+ * Cooley-Tukey algorithm. The elements are first put into bit-reversed
+ * order. The twiddle factors are then computed by a trigonometric
+ * recurrence that avoids the accumulation of rounding errors.
+ ***************************************************************************/
+void GFft::transform(std::complex<double>* data, const int& n,
+                     const int& stride, const double& sign) const
+{
+    // Bit-reversal permutation
+    for (int i = 0, j = 0; i < n; ++i) {
+        if (j > i) {
+            std::swap(data[i*stride], data[j*stride]);
+        }
+        int m = n >> 1;
+        while (m >= 1 && j >= m) {
+            j -= m;
+            m >>= 1;
+        }
+        j += m;
+    }
+
+    // Danielson-Lanczos butterflies
+    for (int len = 2; len <= n; len <<= 1) {
+
+        // Set twiddle factor recurrence
+        double theta = sign * gammalib::twopi / double(len);
+        double wtemp = std::sin(0.5 * theta);
+        double wpr   = -2.0 * wtemp * wtemp;
+        double wpi   = std::sin(theta);
+        double wr    = 1.0;
+        double wi    = 0.0;
+
+        // Loop over butterfly positions
+        int half = len >> 1;
+        for (int m = 0; m < half; ++m) {
+            std::complex<double> w(wr, wi);
+            for (int i = m; i < n; i += len) {
+                std::complex<double>& a = data[i*stride];
+                std::complex<double>& b = data[(i+half)*stride];
+                std::complex<double>  t = w * b;
+                b  = a - t;
+                a += t;
+            }
+            wtemp = wr;
+            wr   += wr * wpr - wi * wpi;
+            wi   += wi * wpr + wtemp * wpi;
+        }
+
+    } // endfor: looped over butterfly lengths
+
+    // Return
+    return;
+}
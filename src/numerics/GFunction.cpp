@@ -124,6 +124,30 @@ GFunction& GFunction::operator= (const GFunction& func)
  =                                                                         =
  ==========================================================================*/
 
+/***********************************************************************//**
+ * @brief Evaluate function for an array of values
+ *
+ * @param[in] x Array of function arguments.
+ * @param[out] y Array of function values.
+ * @param[in] n Number of function arguments.
+ *
+ * Evaluates the function for n arguments, i.e. y[i]=eval(x[i]). The default
+ * implementation calls eval(double) for each argument. Derived classes may
+ * overload this method to share computations between the arguments or to
+ * avoid one virtual function call per argument.
+ ***************************************************************************/
+void GFunction::eval(const double* x, double* y, const int& n)
+{
+    // Evaluate function
+    for (int i = 0; i < n; ++i) {
+        y[i] = eval(x[i]);
+    }
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                             Private methods                             =
@@ -29,15 +29,45 @@
 #include <vector>
 #include "GIntegral.hpp"
 #include "GTools.hpp"
+#include "GMath.hpp"
 
 /* __ Method name definitions ____________________________________________ */
 
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
+#define G_ROMB_STACK     64     //!< Max. iterations with stack scratch arrays
+#define G_BATCH          64     //!< Number of abscissae per kernel call
 
 /* __ Debug definitions __________________________________________________ */
 
+/* __ Constants __________________________________________________________ */
+
+/* Gauss-Kronrod abscissae and weights (7-point Gauss, 15-point Kronrod) */
+const double g_gk15_x[8] = {0.991455371120812639206854697526329,
+                            0.949107912342758524526189684047851,
+                            0.864864423359769072789712788640926,
+                            0.741531185599394439863864773280788,
+                            0.586087235467691130294144845693013,
+                            0.405845151377397166906606412076961,
+                            0.207784955007898467600689403773245,
+                            0.000000000000000000000000000000000};
+const double g_gk15_wk[8] = {0.022935322010529224963732008058970,
+                             0.063092092629978553290700663189204,
+                             0.104790010322250183839876322541518,
+                             0.140653259715525918745189590510238,
+                             0.169004726639267902826583426598550,
+                             0.190350578064785409913256402421014,
+                             0.204432940075298892414161999234649,
+                             0.209482141084727828012999174891714};
+const double g_gk15_wg[4] = {0.129484966168869693270611432679082,
+                             0.279705391489276667901467771423780,
+                             0.381830050505118944950369775488975,
+                             0.417959183673469387755102040816327};
+
+/* Tanh-sinh abscissa range */
+const double g_ts_tmax = 3.0;
+
 
 /*==========================================================================
  =                                                                         =
@@ -188,8 +218,10 @@ GIntegral* GIntegral::clone(void) const
  * The number of iterations is limited by m_max_iter. m_eps specifies the
  * requested fractional accuracy. By default it is set to 1e-6.
  *
+ * Scratch arrays are kept on the stack unless more than G_ROMB_STACK-2
+ * iterations are allowed.
+ *
  * @todo Check that k is smaller than m_max_iter
- * @todo Make use of std::vector class
  ***************************************************************************/
 double GIntegral::romb(double a, double b, int k)
 {
@@ -204,9 +236,20 @@ double GIntegral::romb(double a, double b, int k)
         double ss        = 0.0;
         double dss       = 0.0;
 
-        // Allocate temporal storage
-        double* s = new double[m_max_iter+2];
-        double* h = new double[m_max_iter+2];
+        // Set temporal storage. Storage is only allocated on the heap if
+        // it does not fit in the stack arrays
+        double              s_stack[G_ROMB_STACK];
+        double              h_stack[G_ROMB_STACK];
+        std::vector<double> s_heap;
+        std::vector<double> h_heap;
+        double*             s = s_stack;
+        double*             h = h_stack;
+        if (m_max_iter+2 > G_ROMB_STACK) {
+            s_heap.resize(m_max_iter+2);
+            h_heap.resize(m_max_iter+2);
+            s = &(s_heap[0]);
+            h = &(h_heap[0]);
+        }
 
         // Initialise step size
         h[1] = 1.0;
@@ -244,10 +287,6 @@ double GIntegral::romb(double a, double b, int k)
 
         } // endfor: iterative loop
 
-        // Free temporal storage
-        delete [] s;
-        delete [] h;
-
         // Dump warning
         if (!m_silent) {
             if (!converged) {
@@ -335,17 +374,27 @@ double GIntegral::trapzd(double a, double b, int n, double result)
                 std::cout << std::endl;
             }
 
-            // Sum up values
-            double x   = a + 0.5*del;
+            // Sum up values. The integrand is evaluated in batches of
+            // G_BATCH abscissae.
+            double x[G_BATCH];
+            double y[G_BATCH];
             double sum = 0.0;
-            for (int j = 0; j < it; ++j, x+=del) {
-                
+            for (int j = 0; j < it; j += G_BATCH) {
+
+                // Set abscissae of batch
+                int n = (it-j < G_BATCH) ? it-j : G_BATCH;
+                for (int i = 0; i < n; ++i) {
+                    x[i] = a + (double(j+i) + 0.5) * del;
+                }
+
                 // Evaluate integrand
-                double y = m_kernel->eval(x);
+                m_kernel->eval(x, y, n);
 
                 // Add integrand
-                sum += y;
-                
+                for (int i = 0; i < n; ++i) {
+                    sum += y[i];
+                }
+
             } // endfor: looped over steps
 
             // Set result
@@ -359,6 +408,249 @@ double GIntegral::trapzd(double a, double b, int n, double result)
 }
 
 
+/***********************************************************************//**
+ * @brief Perform adaptive Gauss-Kronrod integration
+ *
+ * @param[in] a Left integration boundary.
+ * @param[in] b Right integration boundary.
+ * @return Integral of kernel from a to b.
+ *
+ * Returns the integral of the integrand from a to b using the 15-point
+ * Gauss-Kronrod rule (G7K15). The difference between the 15-point Kronrod
+ * and the embedded 7-point Gauss result is used as error estimate. An
+ * interval for which the error estimate exceeds its share of the requested
+ * absolute accuracy is bisected, where the requested absolute accuracy is
+ * m_eps times the G7K15 result of the full interval. The bisection depth
+ * is limited by m_max_iter. On return, iter() gives the number of
+ * intervals for which the G7K15 rule was evaluated.
+ *
+ * The rule converges for smooth integrands in far fewer kernel evaluations
+ * than romb(), and as the abscissae are interior points, the integrand is
+ * never evaluated at the integration boundaries.
+ ***************************************************************************/
+double GIntegral::gkq(double a, double b)
+{
+    // Initialise result
+    double result = 0.0;
+
+    // Initialise iteration counter
+    m_iter = 0;
+
+    // Continue only if integration range is valid
+    if (b > a) {
+
+        // Integrate over full interval
+        double err   = 0.0;
+        double whole = kronrod(a, b, &err);
+
+        // Perform adaptive integration
+        bool   converged = true;
+        double tol       = m_eps * std::abs(whole);
+        result           = gkq_adapt(a, b, whole, err, tol, 1, &converged);
+
+        // Dump warning
+        if (!m_silent) {
+            if (!converged) {
+                std::cout << "*** WARNING: GIntegral::gkq: ";
+                std::cout << "Integration did not converge ";
+                std::cout << "(iter=" << m_iter;
+                std::cout << ", result=" << result << ")";
+                std::cout << std::endl;
+            }
+        }
+
+    } // endif: integration range was valid
+
+    // Return result
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Perform tanh-sinh integration
+ *
+ * @param[in] a Left integration boundary.
+ * @param[in] b Right integration boundary.
+ * @return Integral of kernel from a to b.
+ *
+ * Returns the integral of the integrand from a to b using the tanh-sinh
+ * (double exponential) quadrature of Takahasi & Mori (1974). The variable
+ * substitution x = c + d tanh(pi/2 sinh t), with c=(a+b)/2 and d=(b-a)/2,
+ * makes the transformed integrand decay double exponentially for large
+ * |t|, so that the trapezoidal rule in t converges rapidly even for
+ * integrands with integrable singularities at the integration boundaries.
+ * The integrand is never evaluated at the integration boundaries.
+ *
+ * The step size in t is halved in each iteration, starting from a step
+ * size of one, and the t range is truncated at |t|=3. The integration is
+ * considered as converged if the results of two successive iterations
+ * differ by not more than the fractional accuracy m_eps. The number of
+ * iterations is limited by m_max_iter.
+ ***************************************************************************/
+double GIntegral::tanhsinh(double a, double b)
+{
+    // Initialise result
+    double result = 0.0;
+
+    // Continue only if integration range is valid
+    if (b > a) {
+
+        // Set transformation parameters
+        double c = 0.5 * (a + b);
+        double d = 0.5 * (b - a);
+
+        // Initialise variables
+        bool   converged = false;
+        double sum       = 0.0;
+        double h         = 1.0;
+
+        // Loop over iterations
+        for (m_iter = 0; m_iter <= m_max_iter; ++m_iter) {
+
+            // Set step for the abscissae of this iteration. The first
+            // iteration uses all integer multiples of the step size, the
+            // following iterations add the odd multiples of the halved step
+            // size.
+            double step = (m_iter == 0) ? h : 2.0 * h;
+
+            // Add central abscissa in first iteration
+            double x[G_BATCH];
+            double w[G_BATCH];
+            int    n = 0;
+            if (m_iter == 0) {
+                x[n] = c;
+                w[n] = d * gammalib::pihalf;
+                n++;
+            }
+
+            // Add pairs of abscissae
+            for (double t = h; t <= g_ts_tmax; t += step) {
+
+                // Compute distance of abscissae to boundaries and weight
+                double u     = gammalib::pihalf * std::sinh(t);
+                double delta = d * 2.0 / (std::exp(2.0*u) + 1.0);
+                double cu    = std::cosh(u);
+                double wgt   = d * gammalib::pihalf * std::cosh(t) / (cu*cu);
+
+                // Skip abscissae that coincide with the boundaries
+                double x_left  = a + delta;
+                double x_right = b - delta;
+                if (x_left <= a || x_right >= b) {
+                    continue;
+                }
+
+                // Add abscissae
+                x[n] = x_left;
+                w[n] = wgt;
+                n++;
+                x[n] = x_right;
+                w[n] = wgt;
+                n++;
+
+                // Evaluate batch if it is full
+                if (n > G_BATCH-2) {
+                    sum += weighted_sum(x, w, n);
+                    n    = 0;
+                }
+
+            } // endfor: looped over abscissae
+
+            // Evaluate remaining abscissae
+            if (n > 0) {
+                sum += weighted_sum(x, w, n);
+            }
+
+            // Compute integral estimate
+            double estimate = h * sum;
+
+            // Check for convergence
+            if (m_iter > 0) {
+                if (std::abs(estimate - result) <= m_eps * std::abs(estimate)) {
+                    converged = true;
+                    result    = estimate;
+                    break;
+                }
+            }
+
+            // Store estimate and halve step size
+            result = estimate;
+            h     *= 0.5;
+
+        } // endfor: looped over iterations
+
+        // Dump warning
+        if (!m_silent) {
+            if (!converged) {
+                std::cout << "*** WARNING: GIntegral::tanhsinh: ";
+                std::cout << "Integration did not converge ";
+                std::cout << "(iter=" << m_iter;
+                std::cout << ", result=" << result << ")";
+                std::cout << std::endl;
+            }
+        }
+
+    } // endif: integration range was valid
+
+    // Return result
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Return abscissae and weights of a fixed Gauss-Kronrod rule
+ *
+ * @param[in] a Left integration boundary.
+ * @param[in] b Right integration boundary.
+ * @param[in] n Number of subintervals.
+ * @param[out] x Abscissae (15 per subinterval).
+ * @param[out] w Weights (15 per subinterval).
+ *
+ * Splits [a,b] into @p n subintervals of equal length and returns the
+ * abscissae and weights of the 15-point Kronrod rule on each of them. The
+ * integral of a function f over [a,b] is then approximated by the sum of
+ * w[i]*f(x[i]). This allows to tabulate a function once at fixed abscissae
+ * and to integrate its products with other functions without any further
+ * evaluation of it. For n < 1 a single subinterval is used.
+ ***************************************************************************/
+void GIntegral::gk_nodes(const double& a, const double& b, const int& n,
+                         std::vector<double>* x, std::vector<double>* w)
+{
+    // Clear vectors
+    x->clear();
+    w->clear();
+
+    // Set number of subintervals
+    int nsub = (n < 1) ? 1 : n;
+
+    // Reserve space
+    x->reserve(15 * nsub);
+    w->reserve(15 * nsub);
+
+    // Loop over subintervals
+    double length = (b - a) / double(nsub);
+    for (int k = 0; k < nsub; ++k) {
+
+        // Set centre and half length of subinterval
+        double hl = 0.5 * length;
+        double c  = a + (double(k) + 0.5) * length;
+
+        // Append abscissae and weights
+        for (int j = 0; j < 7; ++j) {
+            x->push_back(c - hl * g_gk15_x[j]);
+            w->push_back(hl * g_gk15_wk[j]);
+            x->push_back(c + hl * g_gk15_x[j]);
+            w->push_back(hl * g_gk15_wk[j]);
+        }
+        x->push_back(c);
+        w->push_back(hl * g_gk15_wk[7]);
+
+    } // endfor: looped over subintervals
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Print integral information
  *
@@ -402,6 +694,131 @@ std::string GIntegral::print(const GChatter& chatter) const
  =                                                                         =
  ==========================================================================*/
 
+/***********************************************************************//**
+ * @brief Compute 15-point Gauss-Kronrod integral
+ *
+ * @param[in] a Left integration boundary.
+ * @param[in] b Right integration boundary.
+ * @param[out] err Error estimate.
+ * @return 15-point Kronrod integral.
+ *
+ * Computes the integral over [a,b] using the 15-point Kronrod rule. The
+ * error estimate is the absolute difference to the embedded 7-point Gauss
+ * rule. All 15 abscissae are passed in a single call to the kernel.
+ ***************************************************************************/
+double GIntegral::kronrod(const double& a, const double& b, double* err)
+{
+    // Set centre and half length of interval
+    double c  = 0.5 * (a + b);
+    double hl = 0.5 * (b - a);
+
+    // Set abscissae
+    double x[15];
+    double y[15];
+    for (int j = 0; j < 7; ++j) {
+        x[2*j]   = c - hl * g_gk15_x[j];
+        x[2*j+1] = c + hl * g_gk15_x[j];
+    }
+    x[14] = c;
+
+    // Evaluate integrand
+    m_kernel->eval(x, y, 15);
+
+    // Compute Kronrod and Gauss sums
+    double resk = g_gk15_wk[7] * y[14];
+    double resg = g_gk15_wg[3] * y[14];
+    for (int j = 0; j < 7; ++j) {
+        double pair = y[2*j] + y[2*j+1];
+        resk       += g_gk15_wk[j] * pair;
+        if (j % 2 == 1) {
+            resg += g_gk15_wg[j/2] * pair;
+        }
+    }
+
+    // Increment number of rule evaluations
+    m_iter++;
+
+    // Set error estimate
+    *err = std::abs((resk - resg) * hl);
+
+    // Return Kronrod result
+    return (resk * hl);
+}
+
+
+/***********************************************************************//**
+ * @brief Adaptively refine Gauss-Kronrod integral
+ *
+ * @param[in] a Left integration boundary.
+ * @param[in] b Right integration boundary.
+ * @param[in] value G7K15 integral over [a,b].
+ * @param[in] err Error estimate of G7K15 integral.
+ * @param[in] tol Requested absolute accuracy for [a,b].
+ * @param[in] depth Bisection depth of interval.
+ * @param[out] converged Set to false if accuracy was not reached.
+ * @return Integral over [a,b].
+ *
+ * Bisects the interval if the error estimate exceeds the requested
+ * accuracy, where each half is given half of the requested accuracy.
+ ***************************************************************************/
+double GIntegral::gkq_adapt(const double& a, const double& b,
+                            const double& value, const double& err,
+                            const double& tol, const int& depth,
+                            bool* converged)
+{
+    // Initialise result
+    double result = value;
+
+    // Refine if accuracy is not reached
+    if (err > tol) {
+
+        // Bisect interval if maximum depth is not reached and if interval
+        // can be split
+        double m = 0.5 * (a + b);
+        if (depth < m_max_iter && m > a && m < b) {
+            double err_left  = 0.0;
+            double err_right = 0.0;
+            double left      = kronrod(a, m, &err_left);
+            double right     = kronrod(m, b, &err_right);
+            result = gkq_adapt(a, m, left,  err_left,  0.5*tol, depth+1, converged) +
+                     gkq_adapt(m, b, right, err_right, 0.5*tol, depth+1, converged);
+        }
+        else {
+            *converged = false;
+        }
+
+    } // endif: accuracy was not reached
+
+    // Return result
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Compute weighted sum of kernel values
+ *
+ * @param[in] x Array of abscissae.
+ * @param[in] w Array of weights.
+ * @param[in] n Number of abscissae (at most G_BATCH).
+ * @return Sum of w[i]*f(x[i]).
+ ***************************************************************************/
+double GIntegral::weighted_sum(const double* x, const double* w, const int& n)
+{
+    // Evaluate integrand
+    double y[G_BATCH];
+    m_kernel->eval(x, y, n);
+
+    // Compute weighted sum
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+        sum += w[i] * y[i];
+    }
+
+    // Return sum
+    return sum;
+}
+
+
 /***********************************************************************//**
  * @brief Initialise class members
  ***************************************************************************/
@@ -0,0 +1,693 @@
+/***************************************************************************
+ *          GIntegrals.cpp - Integration class for set of functions        *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GIntegrals.cpp
+ * @brief Integration class for set of functions implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#include <cmath>            // For std::abs()
+#include <vector>
+#include <iostream>
+#include "GIntegrals.hpp"
+#include "GTools.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+/* __ Constants __________________________________________________________ */
+
+/* Gauss-Kronrod abscissae and weights (7-point Gauss, 15-point Kronrod) */
+const double g_gk15_x[8] = {0.991455371120812639206854697526329,
+                            0.949107912342758524526189684047851,
+                            0.864864423359769072789712788640926,
+                            0.741531185599394439863864773280788,
+                            0.586087235467691130294144845693013,
+                            0.405845151377397166906606412076961,
+                            0.207784955007898467600689403773245,
+                            0.000000000000000000000000000000000};
+const double g_gk15_wk[8] = {0.022935322010529224963732008058970,
+                             0.063092092629978553290700663189204,
+                             0.104790010322250183839876322541518,
+                             0.140653259715525918745189590510238,
+                             0.169004726639267902826583426598550,
+                             0.190350578064785409913256402421014,
+                             0.204432940075298892414161999234649,
+                             0.209482141084727828012999174891714};
+const double g_gk15_wg[4] = {0.129484966168869693270611432679082,
+                             0.279705391489276667901467771423780,
+                             0.381830050505118944950369775488975,
+                             0.417959183673469387755102040816327};
+
+
+/*==========================================================================
+ =                                                                         =
+ =                        Constructors/destructors                         =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GIntegrals::GIntegrals(void)
+{
+    // Initialise members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Function kernels constructor
+ *
+ * @param[in] kernels Pointer to function kernels.
+ *
+ * The function kernels constructor assigns the function kernels pointer in
+ * constructing the object.
+ ***************************************************************************/
+GIntegrals::GIntegrals(GFunctions* kernels)
+{
+    // Initialise members
+    init_members();
+
+    // Set function kernels
+    m_kernels = kernels;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] integrals Integrals.
+ ***************************************************************************/
+GIntegrals::GIntegrals(const GIntegrals& integrals)
+{ 
+    // Initialise members
+    init_members();
+
+    // Copy members
+    copy_members(integrals);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GIntegrals::~GIntegrals(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                               Operators                                 =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] integrals Integrals.
+ * @return Integrals.
+ ***************************************************************************/
+GIntegrals& GIntegrals::operator=(const GIntegrals& integrals)
+{
+    // Execute only if object is not identical
+    if (this != &integrals) {
+
+        // Free members
+        free_members();
+
+        // Initialise integrals
+        init_members();
+
+        // Copy members
+        copy_members(integrals);
+
+    } // endif: object was not identical
+
+    // Return
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear instance
+ ***************************************************************************/
+void GIntegrals::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise private members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone instance
+ *
+ * @return Pointer to deep copy of integrals.
+ ***************************************************************************/
+GIntegrals* GIntegrals::clone(void) const
+{
+    return new GIntegrals(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Perform Romberg integration
+ *
+ * @param[in] a Left integration boundary.
+ * @param[in] b Right integration boundary.
+ * @param[in] k Integration order (default: k=5)
+ * @return Vector of integrals.
+ *
+ * Returns the integrals of all kernel functions from a to b. Integration is
+ * performed by Romberg's method of order 2K, where e.g. K=2 in Simpson's
+ * rule. The method is identical to GIntegral::romb(), with the first
+ * kernel function serving as reference function: the integration stops
+ * once the reference function has reached the requested fractional
+ * accuracy m_eps. All other functions are integrated on the same abscissa
+ * grid. This allows to integrate functions that vanish (such as gradients
+ * of symmetric problems) without iterating up to the maximum number of
+ * iterations.
+ *
+ * The number of iterations is limited by m_max_iter.
+ ***************************************************************************/
+GVector GIntegrals::romb(const double& a, const double& b, const int& k)
+{
+    // Initialise result
+    int     n = (m_kernels != NULL) ? m_kernels->size() : 0;
+    GVector result(n);
+
+    // Continue only if integration range is valid and if there are kernels
+    if (b > a && n > 0) {
+
+        // Initialise variables
+        bool    converged = false;
+        GVector ss(n);
+        GVector dss(n);
+
+        // Allocate temporal storage
+        std::vector<GVector> s(m_max_iter+2, GVector(n));
+        std::vector<double>  h(m_max_iter+2, 0.0);
+
+        // Initialise step size
+        h[1] = 1.0;
+
+        // Iterative loop
+        for (m_iter = 1; m_iter <= m_max_iter; ++m_iter) {
+
+            // Integration using Trapezoid rule
+            s[m_iter] = trapzd(a, b, m_iter, s[m_iter-1]);
+
+            // Starting from iteration k on, use polynomial interpolation
+            if (m_iter >= k) {
+
+                // Interpolate
+                ss = polint(&h[m_iter-k+1], &s[m_iter-k+1], k, 0.0, &dss);
+
+                // Store result
+                result = ss;
+
+                // Exit if reference function has converged
+                if (std::abs(dss[0]) <= m_eps * std::abs(ss[0])) {
+                    converged = true;
+                    break;
+                }
+
+            } // endif: polynomial interpolation was performed
+
+            // Reduce step size
+            h[m_iter+1]= 0.25 * h[m_iter];
+
+        } // endfor: iterative loop
+
+        // Dump warning
+        if (!m_silent) {
+            if (!converged) {
+                std::cout << "*** WARNING: GIntegrals::romb: ";
+                std::cout << "Integration did not converge ";
+                std::cout << "(iter=" << m_iter << ")";
+                std::cout << std::endl;
+            }
+        }
+    
+    } // endif: integration range was valid
+
+    // Return result
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Perform Trapezoidal integration
+ *
+ * @param[in] a Left integration boundary.
+ * @param[in] b Right integration boundary.
+ * @param[in] n Number of steps.
+ * @param[in] result Result from a previous trapezoidal integration step.
+ * @return Vector of integrals.
+ *
+ * Implements the n-th stage of refinement of the extended trapezoidal rule
+ * for all kernel functions. Result initialisation is done if n=1.
+ ***************************************************************************/
+GVector GIntegrals::trapzd(const double& a, const double& b, const int& n,
+                           GVector result)
+{
+    // Get number of kernel functions
+    int num = (m_kernels != NULL) ? m_kernels->size() : 0;
+
+    // Handle case of identical boundaries or no kernel functions
+    if (a == b || num == 0) {
+        result = GVector(num);
+    }
+    
+    // ... otherwise use trapeziodal rule
+    else {
+    
+        // Case A: Only a single step is requested
+        if (n == 1) {
+        
+            // Evaluate integrand at boundaries
+            result  = m_kernels->eval(a);
+            result += m_kernels->eval(b);
+            
+            // Compute result
+            result *= 0.5*(b-a);
+            
+        } // endif: only a single step was requested
+
+        // Case B: More than a single step is requested
+        else {
+
+            // Compute step level 2^(n-1)
+            int it = 1;
+            for (int j = 1; j < n-1; ++j) {
+                it <<= 1;
+            }
+
+            // Set step size
+            double tnm = double(it);
+            double del = (b-a)/tnm;
+
+            // Sum up values
+            double  x = a + 0.5*del;
+            GVector sum(num);
+            for (int j = 0; j < it; ++j, x+=del) {
+                sum += m_kernels->eval(x);
+            }
+
+            // Set result
+            sum    *= (b-a)/tnm;
+            result += sum;
+            result *= 0.5;
+        }
+        
+    } // endelse: trapeziodal rule was applied
+
+    // Return result
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Perform adaptive Gauss-Kronrod integration
+ *
+ * @param[in] a Left integration boundary.
+ * @param[in] b Right integration boundary.
+ * @return Vector of integrals.
+ *
+ * Returns the integrals of all kernel functions from a to b using the
+ * 15-point Gauss-Kronrod rule (G7K15). The method is identical to
+ * GIntegral::gkq(), with the first kernel function serving as reference
+ * function: an interval is bisected as long as the error estimate of the
+ * reference function exceeds its share of the requested absolute accuracy,
+ * which is m_eps times the G7K15 result of the full interval. All other
+ * functions are integrated on the same intervals, hence the first function
+ * integrates to the same value as with GIntegral::gkq(). The bisection
+ * depth is limited by m_max_iter. On return, iter() gives the number of
+ * intervals for which the G7K15 rule was evaluated.
+ ***************************************************************************/
+GVector GIntegrals::gkq(const double& a, const double& b)
+{
+    // Initialise result
+    int     n = (m_kernels != NULL) ? m_kernels->size() : 0;
+    GVector result(n);
+
+    // Initialise iteration counter
+    m_iter = 0;
+
+    // Continue only if integration range is valid and if there are kernels
+    if (b > a && n > 0) {
+
+        // Integrate over full interval
+        double  err   = 0.0;
+        GVector whole = kronrod(a, b, &err);
+
+        // Perform adaptive integration
+        bool   converged = true;
+        double tol       = m_eps * std::abs(whole[0]);
+        result           = gkq_adapt(a, b, whole, err, tol, 1, &converged);
+
+        // Dump warning
+        if (!m_silent) {
+            if (!converged) {
+                std::cout << "*** WARNING: GIntegrals::gkq: ";
+                std::cout << "Integration did not converge ";
+                std::cout << "(iter=" << m_iter << ")";
+                std::cout << std::endl;
+            }
+        }
+
+    } // endif: integration range was valid
+
+    // Return result
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Print integrals information
+ *
+ * @param[in] chatter Chattiness (defaults to NORMAL).
+ * @return String containing integrals information.
+ ***************************************************************************/
+std::string GIntegrals::print(const GChatter& chatter) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Continue only if chatter is not silent
+    if (chatter != SILENT) {
+
+        // Append header
+        result.append("=== GIntegrals ===");
+
+        // Append information
+        result.append("\n"+gammalib::parformat("Number of functions"));
+        result.append(gammalib::str((m_kernels != NULL) ? m_kernels->size() : 0));
+        result.append("\n"+gammalib::parformat("Relative precision"));
+        result.append(gammalib::str(eps()));
+        result.append("\n"+gammalib::parformat("Max. number of iterations"));
+        result.append(gammalib::str(max_iter()));
+        if (silent()) {
+            result.append("\n"+gammalib::parformat("Warnings")+"suppressed");
+        }
+        else {
+            result.append("\n"+gammalib::parformat("Warnings"));
+            result.append("in standard output");
+        }
+
+    } // endif: chatter was not silent
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                            Protected methods                            =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GIntegrals::init_members(void)
+{
+    // Initialise members
+    m_kernels   = NULL;
+    m_eps       = 1.0e-6;
+    m_max_iter  = 20;
+    m_iter      = 0;
+    m_silent    = false;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] integrals Integrals.
+ ***************************************************************************/
+void GIntegrals::copy_members(const GIntegrals& integrals)
+{
+    // Copy attributes
+    m_kernels  = integrals.m_kernels;
+    m_eps      = integrals.m_eps;
+    m_max_iter = integrals.m_max_iter;
+    m_iter     = integrals.m_iter;
+    m_silent   = integrals.m_silent;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GIntegrals::free_members(void)
+{
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Perform Polynomial interpolation
+ *
+ * @param[in] xa Pointer to array of X values.
+ * @param[in] ya Pointer to array of Y vectors.
+ * @param[in] n Number of elements in arrays.
+ * @param[in] x X value at which interpolations should be performed.
+ * @param[out] dy Error estimate for interpolated values.
+ * @return Interpolated values.
+ *
+ * Given arrays xa[0,..,n-1] and ya[0,..,n-1], and given a value x, this
+ * method returns for each vector element a value y, and an error estimate
+ * dy, where y=P(x) and P(x) is the polynomial of degree n-1 that passes
+ * through the points. See GIntegral::polint() for the scalar version.
+ ***************************************************************************/
+GVector GIntegrals::polint(const double* xa, const GVector* ya, const int& n,
+                           const double& x, GVector* dy)
+{
+    // Get vector dimension
+    int num = ya[0].size();
+
+    // Initialise result
+    GVector y(num);
+    *dy = GVector(num);
+
+    // Allocate temporary memory
+    std::vector<double> c(n, 0.0);
+    std::vector<double> d(n, 0.0);
+
+    // Find index ns of the closest table entry
+    int    ns  = 0;
+    double dif = std::abs(x-xa[0]);
+    for (int i = 1; i < n; ++i) {
+        double dift = std::abs(x-xa[i]);
+        if (dift < dif) {
+            ns  = i;
+            dif = dift;
+        }
+    }
+
+    // Loop over vector elements
+    for (int k = 0; k < num; ++k) {
+
+        // Initialise tableau
+        for (int i = 0; i < n; ++i) {
+            c[i] = ya[i][k];
+            d[i] = ya[i][k];
+        }
+
+        // Get initial approximation to y
+        int    ins = ns;
+        double yk  = ya[ins][k];
+        double dyk = 0.0;
+        ins--;
+
+        // Loop over each column of the tableau
+        for (int m = 1; m < n; ++m) {
+
+            // Update current c's and d's
+            for (int i = 0; i < n-m; ++i) {
+                double ho  = xa[i]   - x;
+                double hp  = xa[i+m] - x;
+                double w   = c[i+1] - d[i];
+                double den = ho - hp;
+                if (den == 0.0) {
+                    std::cout << "*** ERROR: GIntegrals::polint: ";
+                    std::cout << "This error can only occur if two input xa's are identical.";
+                    std::cout << std::endl;
+                }
+                den  = w/den;
+                d[i] = hp*den;
+                c[i] = ho*den;
+            }
+
+            // Compute y correction
+            dyk = (2*(ins+1) < (n-m)) ? c[ins+1] : d[ins--];
+
+            // Update y
+            yk += dyk;
+
+        } // endfor: looped over columns of tableau
+
+        // Store result
+        y[k]     = yk;
+        (*dy)[k] = dyk;
+
+    } // endfor: looped over vector elements
+
+    // Return
+    return y;
+}
+
+
+/***********************************************************************//**
+ * @brief Compute 15-point Gauss-Kronrod integrals
+ *
+ * @param[in] a Left integration boundary.
+ * @param[in] b Right integration boundary.
+ * @param[out] err Error estimate of reference function.
+ * @return 15-point Kronrod integrals.
+ *
+ * Computes the integrals over [a,b] using the 15-point Kronrod rule. The
+ * error estimate is the absolute difference between the Kronrod and the
+ * embedded 7-point Gauss result of the first kernel function. The sums are
+ * accumulated in the same order as in GIntegral::kronrod().
+ ***************************************************************************/
+GVector GIntegrals::kronrod(const double& a, const double& b, double* err)
+{
+    // Set centre and half length of interval
+    double c  = 0.5 * (a + b);
+    double hl = 0.5 * (b - a);
+
+    // Evaluate kernels at centre of interval
+    GVector centre = m_kernels->eval(c);
+
+    // Initialise Kronrod and Gauss sums
+    GVector resk = g_gk15_wk[7] * centre;
+    double  resg = g_gk15_wg[3] * centre[0];
+
+    // Add symmetric pairs of abscissae
+    for (int j = 0; j < 7; ++j) {
+        GVector pair = m_kernels->eval(c - hl * g_gk15_x[j]);
+        pair        += m_kernels->eval(c + hl * g_gk15_x[j]);
+        resk        += g_gk15_wk[j] * pair;
+        if (j % 2 == 1) {
+            resg += g_gk15_wg[j/2] * pair[0];
+        }
+    }
+
+    // Increment number of rule evaluations
+    m_iter++;
+
+    // Set error estimate
+    *err = std::abs((resk[0] - resg) * hl);
+
+    // Return Kronrod result
+    return (resk * hl);
+}
+
+
+/***********************************************************************//**
+ * @brief Adaptively refine Gauss-Kronrod integrals
+ *
+ * @param[in] a Left integration boundary.
+ * @param[in] b Right integration boundary.
+ * @param[in] value G7K15 integrals over [a,b].
+ * @param[in] err Error estimate of reference function.
+ * @param[in] tol Requested absolute accuracy for [a,b].
+ * @param[in] depth Bisection depth of interval.
+ * @param[out] converged Set to false if accuracy was not reached.
+ * @return Integrals over [a,b].
+ *
+ * Bisects the interval if the error estimate exceeds the requested
+ * accuracy, where each half is given half of the requested accuracy.
+ ***************************************************************************/
+GVector GIntegrals::gkq_adapt(const double& a, const double& b,
+                              const GVector& value, const double& err,
+                              const double& tol, const int& depth,
+                              bool* converged)
+{
+    // Initialise result
+    GVector result = value;
+
+    // Refine if accuracy is not reached
+    if (err > tol) {
+
+        // Bisect interval if maximum depth is not reached and if interval
+        // can be split
+        double m = 0.5 * (a + b);
+        if (depth < m_max_iter && m > a && m < b) {
+            double  err_left  = 0.0;
+            double  err_right = 0.0;
+            GVector left      = kronrod(a, m, &err_left);
+            GVector right     = kronrod(m, b, &err_right);
+            result = gkq_adapt(a, m, left,  err_left,  0.5*tol, depth+1, converged) +
+                     gkq_adapt(m, b, right, err_right, 0.5*tol, depth+1, converged);
+        }
+        else {
+            *converged = false;
+        }
+
+    } // endif: accuracy was not reached
+
+    // Return result
+    return result;
+}
@@ -0,0 +1,349 @@
+/***************************************************************************
+ *              GEventBatch.cpp - Event list batch view class              *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GEventBatch.cpp
+ * @brief Event list batch view class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <cmath>
+#include "GTools.hpp"
+#include "GException.hpp"
+#include "GEventBatch.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+#define G_OP_ACCESS                           "GEventBatch::operator[](int&)"
+#define G_SET                     "GEventBatch::set(GEventList&, int&, int&)"
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+
+/*==========================================================================
+ =                                                                         =
+ =                         Constructors/destructors                        =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GEventBatch::GEventBatch(void)
+{
+    // Initialise members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Event list range constructor
+ *
+ * @param[in] events Event list.
+ * @param[in] begin Index of first event.
+ * @param[in] end Index after last event.
+ *
+ * Constructs a batch view for the events [begin,end[ of an event list.
+ ***************************************************************************/
+GEventBatch::GEventBatch(const GEventList& events,
+                         const int&        begin,
+                         const int&        end)
+{
+    // Initialise members
+    init_members();
+
+    // Set batch
+    set(events, begin, end);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] batch Event batch.
+ ***************************************************************************/
+GEventBatch::GEventBatch(const GEventBatch& batch)
+{
+    // Initialise members
+    init_members();
+
+    // Copy members
+    copy_members(batch);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GEventBatch::~GEventBatch(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                               Operators                                 =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] batch Event batch.
+ * @return Event batch.
+ ***************************************************************************/
+GEventBatch& GEventBatch::operator=(const GEventBatch& batch)
+{
+    // Execute only if object is not identical
+    if (this != &batch) {
+
+        // Free members
+        free_members();
+
+        // Initialise members
+        init_members();
+
+        // Copy members
+        copy_members(batch);
+
+    } // endif: object was not identical
+
+    // Return this object
+    return *this;
+}
+
+
+/***********************************************************************//**
+ * @brief Return pointer to event
+ *
+ * @param[in] index Event index in batch [0,...,size()-1].
+ *
+ * @exception GException::out_of_range
+ *            Event index is out of range.
+ ***************************************************************************/
+const GEventAtom* GEventBatch::operator[](const int& index) const
+{
+    // If index is outside boundary then throw an error
+    #if defined(G_RANGE_CHECK)
+    if (index < 0 || index >= size()) {
+        throw GException::out_of_range(G_OP_ACCESS, index, 0, size()-1);
+    }
+    #endif
+
+    // Return pointer
+    return m_events[index];
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                              Public methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear event batch
+ ***************************************************************************/
+void GEventBatch::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone event batch
+ *
+ * @return Pointer to deep copy of event batch.
+ ***************************************************************************/
+GEventBatch* GEventBatch::clone(void) const
+{
+    // Clone event batch
+    return new GEventBatch(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Set event batch
+ *
+ * @param[in] events Event list.
+ * @param[in] begin Index of first event.
+ * @param[in] end Index after last event.
+ *
+ * @exception GException::out_of_range
+ *            Event range is not contained in event list.
+ *
+ * Sets the batch view for the events [begin,end[ of an event list. The
+ * event energies and times are extracted into contiguous arrays. The
+ * memory of the arrays is kept when a batch is set repeatedly, hence a
+ * single batch object can be reused for iterating over an event list.
+ ***************************************************************************/
+void GEventBatch::set(const GEventList& events,
+                      const int&        begin,
+                      const int&        end)
+{
+    // Throw an exception if the event range is invalid
+    if (begin < 0 || begin > events.size()) {
+        throw GException::out_of_range(G_SET, begin, 0, events.size());
+    }
+    if (end < begin || end > events.size()) {
+        throw GException::out_of_range(G_SET, end, begin, events.size());
+    }
+
+    // Set range
+    m_begin = begin;
+    m_end   = end;
+
+    // Determine number of events
+    int num = end - begin;
+
+    // Resize arrays
+    m_events.resize(num);
+    m_energies.resize(num);
+    m_log_energies.resize(num);
+    m_times.resize(num);
+
+    // Extract event attributes
+    for (int i = 0; i < num; ++i) {
+        const GEventAtom* event = events[begin+i];
+        m_events[i]             = event;
+        m_energies[i]           = event->energy().MeV();
+        m_times[i]              = event->time().secs();
+    }
+
+    // Compute logarithms of energies
+    for (int i = 0; i < num; ++i) {
+        m_log_energies[i] = std::log(m_energies[i]);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Print event batch information
+ *
+ * @param[in] chatter Chattiness (defaults to NORMAL).
+ * @return String containing event batch information.
+ ***************************************************************************/
+std::string GEventBatch::print(const GChatter& chatter) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Continue only if chatter is not silent
+    if (chatter != SILENT) {
+
+        // Append header
+        result.append("=== GEventBatch ===");
+
+        // Append batch information
+        result.append("\n"+gammalib::parformat("Number of events"));
+        result.append(gammalib::str(size()));
+        result.append("\n"+gammalib::parformat("Event range"));
+        result.append("["+gammalib::str(m_begin)+","+gammalib::str(m_end)+"[");
+
+    } // endif: chatter was not silent
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                              Private methods                            =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GEventBatch::init_members(void)
+{
+    // Initialise members
+    m_begin = 0;
+    m_end   = 0;
+    m_events.clear();
+    m_energies.clear();
+    m_log_energies.clear();
+    m_times.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] batch Event batch.
+ ***************************************************************************/
+void GEventBatch::copy_members(const GEventBatch& batch)
+{
+    // Copy members
+    m_begin        = batch.m_begin;
+    m_end          = batch.m_end;
+    m_events       = batch.m_events;
+    m_energies     = batch.m_energies;
+    m_log_energies = batch.m_log_energies;
+    m_times        = batch.m_times;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GEventBatch::free_members(void)
+{
+    // Return
+    return;
+}
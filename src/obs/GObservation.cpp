@@ -28,10 +28,13 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <cmath>
 #include "GException.hpp"
 #include "GObservation.hpp"
+#include "GEventBatch.hpp"
 #include "GModelSky.hpp"
 #include "GModelData.hpp"
+#include "GSource.hpp"
 #include "GIntegral.hpp"
 #include "GDerivative.hpp"
 #include "GTools.hpp"
@@ -58,6 +61,7 @@
 
 /* __ Coding definitions _________________________________________________ */
 #define G_LN_ENERGY_INT   //!< ln(E) variable substitution for integration
+#define G_NPRED_KERN_DLOGE 0.5  //!< Decades per Npred kernel Kronrod rule
 //#define G_GRAD_RIDDLER  //!< Use Riddler's method for computing derivatives
 
 /* __ Debug definitions __________________________________________________ */
@@ -233,6 +237,332 @@ double GObservation::model(const GModels& models, const GEvent& event,
 }
 
 
+/***********************************************************************//**
+ * @brief Return model values and (optionally) gradients for a batch of
+ *        events
+ *
+ * @param[in] models Model descriptor.
+ * @param[in] batch Event batch.
+ * @param[out] values Model values (batch.size() elements).
+ * @param[out] gradients Parameter gradients (models.npars()*batch.size()
+ *                       elements, optional).
+ *
+ * Implements the batched version of the model() method. The model values
+ * for all events of the batch are written into the @p values array. If
+ * @p gradients is not NULL, the parameter gradients are written into the
+ * @p gradients array, where the gradient of parameter @p k for event @p i
+ * is stored at position @p k*batch.size()+i.
+ *
+ * Each model is evaluated for the full batch using GModel::eval_batch().
+ * Gradients of free parameters that have no analytical gradient are
+ * computed numerically event by event using model_grad(). The gradients
+ * of fixed parameters are set to zero.
+ *
+ * If the model cache is enabled and up to date with the parameters of the
+ * @p models (see model_cache_update()), only the models for which a
+ * parameter changed since the last evaluation of the events are evaluated,
+ * and the gradients of all other models are taken from the cache. The
+ * model values are then summed in model order, so that they are identical
+ * to the values obtained without cache, otherwise the cached summed model
+ * values are returned. The cache is only updated if gradients are
+ * requested.
+ *
+ * The method will only operate on models for which the list of instruments
+ * and observation identifiers matches those of the observation. Models that
+ * do not match will be skipped.
+ ***************************************************************************/
+void GObservation::model(const GModels&     models,
+                         const GEventBatch& batch,
+                         double*            values,
+                         double*            gradients) const
+{
+    // Get number of events
+    int nevents = batch.size();
+
+    // Continue only if batch is not empty
+    if (nevents > 0) {
+
+        // Reset model values and gradients
+        for (int i = 0; i < nevents; ++i) {
+            values[i] = 0.0;
+        }
+        if (gradients != NULL) {
+            int num = models.npars() * nevents;
+            for (int i = 0; i < num; ++i) {
+                gradients[i] = 0.0;
+            }
+        }
+
+        // Determine whether the model cache can be used. If the cache is
+        // used, the model values are initialised with the cached summed
+        // model values.
+        bool cached = model_cache_valid(models);
+        if (cached) {
+            const double* sum = &(m_cache_sum[batch.begin()]);
+            for (int i = 0; i < nevents; ++i) {
+                values[i] = sum[i];
+            }
+        }
+
+        // Allocate working arrays for model values and for model values
+        // that are summed in model order
+        std::vector<double> mvalues(nevents, 0.0);
+        std::vector<double> total(nevents, 0.0);
+        bool                changed = false;
+
+        // Initialise parameter counter for gradients
+        int igrad = 0;
+
+        // Loop over models
+        for (int m = 0; m < models.size(); ++m) {
+
+            // Get model pointer. Continue only if pointer is valid
+            const GModel* mptr = models[m];
+            if (mptr != NULL) {
+
+                // Continue only if model applies to specific instrument and
+                // observation identifier
+                if (mptr->isvalid(instrument(), id())) {
+
+                    // Set pointer to gradients of model
+                    double* mgrad = (gradients != NULL)
+                                    ? gradients + igrad * nevents : NULL;
+
+                    // Case A: model cache is used
+                    if (cached) {
+
+                        // Get cache state of model and cache pointers
+                        unsigned long  state  = m_cache_states[m];
+                        unsigned long* states = &(m_cache_event_states[m*m_cache_nevents +
+                                                                       batch.begin()]);
+                        double*        cvalues = &(m_cache_values[m*m_cache_nevents +
+                                                                  batch.begin()]);
+
+                        // Check whether cached values are up to date for
+                        // all events of the batch
+                        bool valid = true;
+                        for (int i = 0; i < nevents; ++i) {
+                            if (states[i] != state) {
+                                valid = false;
+                                break;
+                            }
+                        }
+
+                        // If cached values are up to date then optionally
+                        // recover gradients from cache
+                        if (valid) {
+                            for (int k = 0; mgrad != NULL && k < mptr->size(); ++k) {
+                                const double* cgrad =
+                                    &(m_cache_gradients[(m_cache_offsets[m]+k) *
+                                                        m_cache_nevents +
+                                                        batch.begin()]);
+                                double*       g     = mgrad + k * nevents;
+                                for (int i = 0; i < nevents; ++i) {
+                                    g[i] = cgrad[i];
+                                }
+                            }
+                            for (int i = 0; i < nevents; ++i) {
+                                total[i] += cvalues[i];
+                            }
+                        }
+
+                        // ... otherwise, if gradients are requested, then
+                        // evaluate model and update cache
+                        else if (mgrad != NULL) {
+                            model_batch(*mptr, batch, &(mvalues[0]), mgrad);
+                            for (int i = 0; i < nevents; ++i) {
+                                total[i]   += mvalues[i];
+                                cvalues[i]  = mvalues[i];
+                                states[i]   = state;
+                            }
+                            changed = true;
+                            for (int k = 0; k < mptr->size(); ++k) {
+                                double*       cgrad =
+                                    &(m_cache_gradients[(m_cache_offsets[m]+k) *
+                                                        m_cache_nevents +
+                                                        batch.begin()]);
+                                const double* g     = mgrad + k * nevents;
+                                for (int i = 0; i < nevents; ++i) {
+                                    cgrad[i] = g[i];
+                                }
+                            }
+                        }
+
+                        // ... otherwise evaluate model without updating
+                        // the cache
+                        else {
+                            model_batch(*mptr, batch, &(mvalues[0]), NULL);
+                            for (int i = 0; i < nevents; ++i) {
+                                total[i] += mvalues[i];
+                            }
+                            changed = true;
+                        }
+
+                    } // endif: model cache was used
+
+                    // Case B: evaluate model and add model values
+                    else {
+                        model_batch(*mptr, batch, &(mvalues[0]), mgrad);
+                        for (int i = 0; i < nevents; ++i) {
+                            values[i] += mvalues[i];
+                        }
+                    }
+
+                } // endif: model component was valid for instrument
+
+                // Increment parameter counter for gradients
+                igrad += mptr->size();
+
+            } // endif: model was valid
+
+        } // endfor: Looped over models
+
+        // If models were re-evaluated then use the model values that were
+        // summed in model order, which are the values of an evaluation
+        // without cache. If the cache was updated then these values are
+        // the new summed model values.
+        if (cached && changed) {
+            double* sum = &(m_cache_sum[batch.begin()]);
+            for (int i = 0; i < nevents; ++i) {
+                values[i] = total[i];
+                if (gradients != NULL) {
+                    sum[i] = total[i];
+                }
+            }
+        }
+
+    } // endif: batch was not empty
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return model value and gradients for an event of the observation
+ *
+ * @param[in] models Model descriptor.
+ * @param[in] event Observed event.
+ * @param[in] index Index of event or bin in the event container.
+ * @param[out] gradient Pointer to gradient vector.
+ * @return Model value.
+ *
+ * Implements a version of the model() method for an event that is part
+ * of the event container of the observation. If the model cache is
+ * enabled and up to date with the parameters of the @p models (see
+ * model_cache_update()), only the models for which a parameter changed
+ * since the last evaluation of the event are evaluated. The model value
+ * and gradients of all other models are taken from the cache. The model
+ * values are then summed in model order, so that the result is identical
+ * to the value obtained without cache, otherwise the cached summed model
+ * value is returned. The cache is only updated if a gradient vector is
+ * passed.
+ *
+ * Otherwise the method returns the result of the generic model() method.
+ ***************************************************************************/
+double GObservation::model(const GModels& models, const GEvent& event,
+                           const int& index, GVector* gradient) const
+{
+    // If the model cache is not usable then return the model value
+    if (!model_cache_valid(models) || index < 0 || index >= m_cache_nevents) {
+        return (model(models, event, gradient));
+    }
+
+    // Verify that gradient vector and models have the same dimension
+    #if defined(G_RANGE_CHECK)
+    if (gradient != NULL) {
+        if (models.npars() != gradient->size()) {
+            throw GException::gradient_par_mismatch(G_MODEL, 
+                                                    gradient->size(),
+                                                    models.npars());
+        }
+    }
+    #endif
+
+    // Initialise
+    double model   = m_cache_sum[index]; // Cached summed model value
+    double total   = 0.0;                // Model value summed in model order
+    bool   changed = false;              // Signals re-evaluated models
+    int    igrad   = 0;                  // Reset gradient counter
+
+    // If gradient is available then reset gradient vector elements to 0
+    if (gradient != NULL) {
+        (*gradient) = 0.0;
+    }
+
+    // Loop over models
+    for (int m = 0; m < models.size(); ++m) {
+
+        // Get model pointer. Continue only if pointer is valid
+        const GModel* mptr = models[m];
+        if (mptr != NULL) {
+
+            // Continue only if model applies to specific instrument and
+            // observation identifier
+            if (mptr->isvalid(instrument(), id())) {
+
+                // Get cache indices of model
+                int ival = m * m_cache_nevents + index;
+                int igr  = m_cache_offsets[m] * m_cache_nevents + index;
+
+                // If cached value is up to date then optionally recover
+                // gradients from cache
+                if (m_cache_event_states[ival] == m_cache_states[m]) {
+                    for (int k = 0; gradient != NULL && k < mptr->size(); ++k) {
+                        (*gradient)[igrad+k] =
+                            m_cache_gradients[igr + k * m_cache_nevents];
+                    }
+                    total += m_cache_values[ival];
+                }
+
+                // ... otherwise, if gradients are requested, then evaluate
+                // model and update cache
+                else if (gradient != NULL) {
+                    double value = mptr->eval_gradients(event, *this);
+                    for (int k = 0; k < mptr->size(); ++k) {
+                        double grad = model_grad(*mptr, event, k);
+                        (*gradient)[igrad+k] = grad;
+                        m_cache_gradients[igr + k * m_cache_nevents] = grad;
+                    }
+                    m_cache_values[ival]       = value;
+                    m_cache_event_states[ival] = m_cache_states[m];
+                    total                     += value;
+                    changed                    = true;
+                }
+
+                // ... otherwise evaluate model without updating the cache.
+                // The model is evaluated with gradients as done by an
+                // evaluation without cache.
+                else {
+                    total   += mptr->eval_gradients(event, *this);
+                    changed  = true;
+                }
+
+            } // endif: model component was valid for instrument
+
+            // Increment parameter counter for gradients
+            igrad += mptr->size();
+
+        } // endif: model was valid
+
+    } // endfor: Looped over models
+
+    // If models were re-evaluated then use the model value that was summed
+    // in model order, which is the value of an evaluation without cache.
+    // If the cache was updated then this value is the new summed model
+    // value.
+    if (changed) {
+        model = total;
+        if (gradient != NULL) {
+            m_cache_sum[index] = total;
+        }
+    }
+
+    // Return
+    return model;
+}
+
+
 /***********************************************************************//**
  * @brief Return total number (and optionally gradient) of predicted counts
  *        for all models
@@ -247,6 +577,11 @@ double GObservation::model(const GModels& models, const GEvent& event,
  * If NULL is passed for the gradient vector then gradients will not be
  * computed.
  *
+ * If the model cache is enabled and up to date with the parameters of the
+ * @p models, the Npred value and gradients of models for which no
+ * parameter changed since the last call are taken from the cache. The
+ * cache is only updated if gradients are requested.
+ *
  * The method will only operate on models for which the list of instruments
  * and observation identifiers matches those of the observation. Models that
  * do not match will be skipped.
@@ -273,6 +608,9 @@ double GObservation::npred(const GModels& models, GVector* gradient) const
         (*gradient) = 0.0;
     }
 
+    // Determine whether the model cache can be used
+    bool cached = model_cache_valid(models);
+
     // Loop over models
     for (int i = 0; i < models.size(); ++i) {
 
@@ -284,14 +622,39 @@ double GObservation::npred(const GModels& models, GVector* gradient) const
             // observation identifier
             if (mptr->isvalid(instrument(), id())) {
 
-                // Determine Npred for model
-                npred += npred_temp(*mptr);
+                // If the cached Npred is up to date then recover Npred
+                // and gradients from cache
+                if (cached && m_cache_npred_states[i] == m_cache_states[i]) {
+                    npred += m_cache_npred[i];
+                    for (int k = 0; gradient != NULL && k < mptr->size(); ++k) {
+                        (*gradient)[igrad+k] = m_cache_npred_grad[igrad+k];
+                    }
+                }
 
-                // Optionally determine Npred gradients
-                if (gradient != NULL) {
-                    for (int k = 0; k < mptr->size(); ++k) {
-                        (*gradient)[igrad+k] = npred_grad(*mptr, k);
+                // ... otherwise determine Npred and optionally the Npred
+                // gradients for model
+                else {
+
+                    // Determine Npred for model
+                    double value = npred_temp(*mptr);
+                    npred += value;
+
+                    // Optionally determine Npred gradients
+                    if (gradient != NULL) {
+                        for (int k = 0; k < mptr->size(); ++k) {
+                            (*gradient)[igrad+k] = npred_grad(*mptr, k);
+                        }
                     }
+
+                    // Optionally update cache
+                    if (cached && gradient != NULL) {
+                        m_cache_npred[i] = value;
+                        for (int k = 0; k < mptr->size(); ++k) {
+                            m_cache_npred_grad[igrad+k] = (*gradient)[igrad+k];
+                        }
+                        m_cache_npred_states[i] = m_cache_states[i];
+                    }
+
                 }
 
             } // endif: model component was valid for instrument
@@ -308,6 +671,48 @@ double GObservation::npred(const GModels& models, GVector* gradient) const
 }
 
 
+/***********************************************************************//**
+ * @brief Signal if model evaluation is thread safe
+ *
+ * @return True if model() may be called concurrently for different events.
+ *
+ * Signals whether the model() methods may be called concurrently by
+ * several threads for different events or bins of the observation. In that
+ * case the likelihood optimizer distributes the events or bins of a single
+ * observation over several threads. This requires that neither the events
+ * nor the response use shared caches that are modified during the model
+ * evaluation.
+ *
+ * The base class implementation returns false. Derived classes should
+ * overload the method if their model evaluation is thread safe.
+ ***************************************************************************/
+bool GObservation::threadsafe(void) const
+{
+    // Return
+    return false;
+}
+
+
+/***********************************************************************//**
+ * @brief Prepare observation for concurrent model evaluation
+ *
+ * @param[in] models Models.
+ *
+ * This method is called by the likelihood optimizer for observations for
+ * which threadsafe() is true before the events or bins are distributed
+ * over the threads. It is called outside of any parallel region, and may
+ * be used to set up per-thread state or to fill shared caches that the
+ * model evaluation for the @p models would otherwise modify concurrently.
+ *
+ * The base class implementation does nothing.
+ ***************************************************************************/
+void GObservation::thread_setup(const GModels& models) const
+{
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Set observation name
  *
@@ -364,6 +769,14 @@ void GObservation::events(const GEvents* events)
         m_events = events->clone();
     }
 
+    // Discard tabulated Npred kernels
+    m_npred_kernel_names.clear();
+    m_npred_kernel_pars.clear();
+    m_npred_kernel_values.clear();
+
+    // Discard model cache
+    model_cache_clear();
+
     // Return
     return;
 }
@@ -386,6 +799,169 @@ void GObservation::statistics(const std::string& statistics)
 }
 
 
+/***********************************************************************//**
+ * @brief Set usage of tabulated Npred kernels
+ *
+ * @param[in] kernel Use tabulated Npred kernels?
+ *
+ * If set, the spectral integration of Npred for sky models with fixed
+ * spatial parameters uses the spatially integrated response that is
+ * tabulated on fixed energy nodes (see npred_kernel_values()). The kernels
+ * assume that the response does not depend on time. Any existing kernels
+ * are discarded, hence the method should also be called after the response
+ * of the observation has been changed.
+ ***************************************************************************/
+void GObservation::npred_kernel(const bool& kernel)
+{
+    // Set flag
+    m_npred_kernel = kernel;
+
+    // Discard kernels
+    m_npred_kernel_energies.clear();
+    m_npred_kernel_weights.clear();
+    m_npred_kernel_names.clear();
+    m_npred_kernel_pars.clear();
+    m_npred_kernel_values.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set usage of model cache
+ *
+ * @param[in] cache Use model cache?
+ *
+ * If set, the model values, Npred values and parameter gradients of all
+ * models are cached per event or bin, and only the models for which a
+ * parameter changed are re-evaluated in a likelihood evaluation (see
+ * model_cache_update()). The cache holds one value per model and one
+ * gradient per model parameter for each event or bin, hence it requires
+ * a substantial amount of memory for large observations. Any existing
+ * cache is discarded, hence the method should also be called after the
+ * response of the observation has been changed.
+ ***************************************************************************/
+void GObservation::model_cache(const bool& cache)
+{
+    // Set flag
+    m_model_cache = cache;
+
+    // Discard cache
+    model_cache_clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Update model cache for models
+ *
+ * @param[in] models Models.
+ *
+ * Prepares the model cache for an evaluation of the @p models. If the
+ * names or the number of parameters of the models, or the number of events
+ * differ from those of the cache, the cache is reset. For each model with
+ * a parameter version that differs from the cached one, a new model state
+ * is assigned, which invalidates all cached values of the model. Cached
+ * values of all other models remain valid. The summed model values are
+ * rebuilt from the cached model values, so that they never accumulate
+ * rounding errors over the iterations of an optimizer.
+ *
+ * The method needs to be called before the model() methods are called
+ * for the models, and it must not be called concurrently with them. The
+ * method does nothing if the model cache is disabled.
+ ***************************************************************************/
+void GObservation::model_cache_update(const GModels& models) const
+{
+    // Continue only if model cache is enabled and events exist
+    if (m_model_cache && m_events != NULL) {
+
+        // Get number of events and models
+        int nevents = m_events->size();
+        int nmodels = models.size();
+
+        // Check whether the cache layout matches the models and events
+        bool match = (nevents == m_cache_nevents &&
+                      nmodels == m_cache_names.size());
+        for (int m = 0; match && m < nmodels; ++m) {
+            const GModel* mptr = models[m];
+            if (mptr != NULL) {
+                if (mptr->name() != m_cache_names[m] ||
+                    mptr->size() != m_cache_versions[m].size()) {
+                    match = false;
+                }
+            }
+            else if (!m_cache_versions[m].empty()) {
+                match = false;
+            }
+        }
+
+        // If the layout does not match then reset the cache
+        if (!match) {
+
+            // Discard cache
+            model_cache_clear();
+
+            // Set model names, parameter versions and gradient offsets
+            int npars = 0;
+            for (int m = 0; m < nmodels; ++m) {
+                const GModel* mptr = models[m];
+                int           size = (mptr != NULL) ? mptr->size() : 0;
+                m_cache_names.push_back((mptr != NULL) ? mptr->name() : "");
+                m_cache_versions.push_back(std::vector<unsigned long>(size, 0));
+                m_cache_offsets.push_back(npars);
+                npars += size;
+            }
+
+            // Allocate cache
+            m_cache_nevents = nevents;
+            m_cache_states.assign(nmodels, 0);
+            m_cache_event_states.assign(nmodels * nevents, 0);
+            m_cache_values.assign(nmodels * nevents, 0.0);
+            m_cache_gradients.assign(npars * nevents, 0.0);
+            m_cache_sum.assign(nevents, 0.0);
+            m_cache_npred_states.assign(nmodels, 0);
+            m_cache_npred.assign(nmodels, 0.0);
+            m_cache_npred_grad.assign(npars, 0.0);
+
+        } // endif: cache was reset
+
+        // Assign new states to models with changed parameters
+        for (int m = 0; m < nmodels; ++m) {
+            const GModel* mptr = models[m];
+            if (mptr != NULL) {
+                bool changed = (m_cache_states[m] == 0);
+                for (int k = 0; k < mptr->size(); ++k) {
+                    if ((*mptr)[k].version() != m_cache_versions[m][k]) {
+                        m_cache_versions[m][k] = (*mptr)[k].version();
+                        changed                = true;
+                    }
+                }
+                if (changed) {
+                    m_cache_states[m] = ++m_cache_counter;
+                }
+            }
+        }
+
+        // Rebuild the summed model values from the cached model values,
+        // summing in model order as done in an evaluation without cache
+        for (int i = 0; i < nevents; ++i) {
+            double sum = 0.0;
+            for (int m = 0; m < nmodels; ++m) {
+                sum += m_cache_values[m*nevents + i];
+            }
+            m_cache_sum[i] = sum;
+        }
+
+    } // endif: model cache was enabled
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Return event container
  *
@@ -422,6 +998,17 @@ void GObservation::init_members(void)
     m_id.clear();
     m_statistics = "Poisson";
     m_events     = NULL;
+    m_npred_kernel      = false;
+    m_npred_kernel_emin = 0.0;
+    m_npred_kernel_emax = 0.0;
+    m_npred_kernel_energies.clear();
+    m_npred_kernel_weights.clear();
+    m_npred_kernel_names.clear();
+    m_npred_kernel_pars.clear();
+    m_npred_kernel_values.clear();
+    m_model_cache   = false;
+    m_cache_counter = 0;
+    model_cache_clear();
 
     // Return
     return;
@@ -442,6 +1029,21 @@ void GObservation::copy_members(const GObservation& obs)
     m_id         = obs.m_id;
     m_statistics = obs.m_statistics;
 
+    // Copy tabulated Npred kernels
+    m_npred_kernel          = obs.m_npred_kernel;
+    m_npred_kernel_emin     = obs.m_npred_kernel_emin;
+    m_npred_kernel_emax     = obs.m_npred_kernel_emax;
+    m_npred_kernel_energies = obs.m_npred_kernel_energies;
+    m_npred_kernel_weights  = obs.m_npred_kernel_weights;
+    m_npred_kernel_names    = obs.m_npred_kernel_names;
+    m_npred_kernel_pars     = obs.m_npred_kernel_pars;
+    m_npred_kernel_values   = obs.m_npred_kernel_values;
+
+    // Copy model cache flag. The cache itself is not copied as it refers
+    // to the events of the observation.
+    m_model_cache = obs.m_model_cache;
+    model_cache_clear();
+
     // Clone members
     m_events = (obs.m_events != NULL) ? obs.m_events->clone() : NULL;
 
@@ -466,6 +1068,119 @@ void GObservation::free_members(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Evaluate model for a batch of events
+ *
+ * @param[in] model Model.
+ * @param[in] batch Event batch.
+ * @param[out] values Model values (batch.size() elements).
+ * @param[out] gradients Parameter gradients (model.size()*batch.size()
+ *                       elements, optional).
+ *
+ * Evaluates a single model for all events of the batch using
+ * GModel::eval_batch(). If @p gradients is not NULL, the gradients of
+ * fixed parameters are set to zero and the gradients of free parameters
+ * that have no analytical gradient are computed numerically event by event
+ * using model_grad().
+ ***************************************************************************/
+void GObservation::model_batch(const GModel&      model,
+                               const GEventBatch& batch,
+                               double*            values,
+                               double*            gradients) const
+{
+    // Get number of events
+    int nevents = batch.size();
+
+    // Evaluate model for all events
+    model.eval_batch(batch, *this, values, gradients);
+
+    // Optionally set gradients of fixed parameters and of parameters
+    // without analytical gradients
+    if (gradients != NULL) {
+        for (int k = 0; k < model.size(); ++k) {
+            const GModelPar& par = model[k];
+            double*          g   = gradients + k * nevents;
+            if (par.isfixed()) {
+                for (int i = 0; i < nevents; ++i) {
+                    g[i] = 0.0;
+                }
+            }
+            else if (!par.hasgrad()) {
+                for (int i = 0; i < nevents; ++i) {
+                    g[i] = model_grad(model, *batch[i], k);
+                }
+            }
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Check whether model cache is up to date with models
+ *
+ * @param[in] models Models.
+ * @return True if the model cache can be used for the models.
+ *
+ * Returns true if the model cache is enabled and if the names and
+ * parameter versions of all models correspond to the ones that were set
+ * by the last call of model_cache_update().
+ ***************************************************************************/
+bool GObservation::model_cache_valid(const GModels& models) const
+{
+    // Check cache status
+    bool valid = (m_model_cache && m_events != NULL &&
+                  m_cache_nevents > 0 &&
+                  m_cache_nevents == m_events->size() &&
+                  models.size() == m_cache_names.size());
+
+    // Check model names and parameter versions
+    for (int m = 0; valid && m < models.size(); ++m) {
+        const GModel* mptr = models[m];
+        if (mptr != NULL) {
+            if (mptr->name() != m_cache_names[m] ||
+                mptr->size() != m_cache_versions[m].size()) {
+                valid = false;
+            }
+            for (int k = 0; valid && k < mptr->size(); ++k) {
+                if ((*mptr)[k].version() != m_cache_versions[m][k]) {
+                    valid = false;
+                }
+            }
+        }
+    }
+
+    // Return
+    return valid;
+}
+
+
+/***********************************************************************//**
+ * @brief Discard model cache
+ ***************************************************************************/
+void GObservation::model_cache_clear(void) const
+{
+    // Discard cache
+    m_cache_nevents = 0;
+    m_cache_names.clear();
+    m_cache_versions.clear();
+    m_cache_states.clear();
+    m_cache_offsets.clear();
+    m_cache_event_states.clear();
+    m_cache_values.clear();
+    m_cache_gradients.clear();
+    m_cache_sum.clear();
+    m_cache_npred_states.clear();
+    m_cache_npred.clear();
+    m_cache_npred_grad.clear();
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                          Model gradient methods                         =
@@ -675,8 +1390,50 @@ double GObservation::npred_grad(const GModel& model, int ipar) const
     // Initialise result
     double grad = 0.0;
 
-    // Compute gradient only if parameter is free
-    if (model[ipar].isfree()) {
+    // Initialise kernel pointer and spectral parameter index
+    const GModelSky*           sky    = NULL;
+    const std::vector<double>* kernel = NULL;
+    int                        ispec  = -1;
+
+    // If tabulated Npred kernels are used, the parameter is a spectral
+    // parameter and the temporal model is constant, then get the kernel
+    // for an analytical gradient computation
+    if (m_npred_kernel && model[ipar].isfree()) {
+        sky = dynamic_cast<const GModelSky*>(&model);
+        if (sky != NULL && sky->spatial() != NULL &&
+            sky->spectral() != NULL && sky->temporal() != NULL &&
+            sky->temporal()->type() == "Constant") {
+            ispec = ipar - sky->spatial()->size();
+            if (ispec >= 0 && ispec < sky->spectral()->size()) {
+                kernel = npred_kernel_values(model, events()->gti().tstart());
+            }
+        }
+    }
+
+    // Case A: Compute gradient from tabulated Npred kernel
+    if (kernel != NULL) {
+
+        // Get spectral model and time
+        GModelSpectral* spectral = sky->spectral();
+        const GTime&    tstart   = events()->gti().tstart();
+
+        // Sum kernel times spectral parameter gradients
+        for (int i = 0; i < kernel->size(); ++i) {
+            GEnergy eng;
+            eng.MeV(m_npred_kernel_energies[i]);
+            spectral->eval_gradients(eng, tstart);
+            grad += (*kernel)[i] * (*spectral)[ispec].factor_gradient();
+        }
+
+        // Multiply by temporal model, scale and ontime
+        grad *= sky->temporal()->eval(tstart) *
+                model.scale(instrument()).value() *
+                events()->gti().ontime();
+
+    } // endif: gradient computed from kernel
+
+    // Case B: Compute gradient numerically if parameter is free
+    else if (model[ipar].isfree()) {
 
         // Get non-const model pointer (circumvent const correctness)
         GModel* ptr = const_cast<GModel*>(&model);
@@ -915,6 +1672,24 @@ double GObservation::npred_spec(const GModel& model,
         throw GException::erange_invalid(G_NPRED_SPEC, emin, emax);
     }
 
+    // If tabulated Npred kernels are used and a kernel exists for the
+    // model then sum the kernel times the spectral model
+    if (m_npred_kernel) {
+        const std::vector<double>* kernel = npred_kernel_values(model, obsTime);
+        if (kernel != NULL) {
+            const GModelSky* sky    = static_cast<const GModelSky*>(&model);
+            double           result = 0.0;
+            for (int i = 0; i < kernel->size(); ++i) {
+                GEnergy eng;
+                eng.MeV(m_npred_kernel_energies[i]);
+                result += (*kernel)[i] * sky->spectral()->eval(eng, obsTime);
+            }
+            result *= sky->temporal()->eval(obsTime) *
+                      model.scale(instrument()).value();
+            return result;
+        }
+    }
+
     // Setup integration function
     GObservation::npred_spec_kern integrand(this, &model, &obsTime);
     GIntegral                     integral(&integrand);
@@ -996,3 +1771,127 @@ double GObservation::npred_spec_kern::eval(double x)
     // Return value
     return value;
 }
+
+
+/***********************************************************************//**
+ * @brief Return tabulated Npred kernel
+ *
+ * @param[in] model Gamma-ray source model.
+ * @param[in] obsTime Measured photon arrival time.
+ * @return Pointer to weighted kernel values (NULL if the model has no
+ *         kernel).
+ *
+ * Returns the spatially integrated response
+ *
+ * \f[K(E_i) = w_i \int_{\rm ROI} \int S_{\rm p}(\vec{p} | E_i, t)
+ *    R(\vec{p'}, E', t' | \vec{p}, E_i, t) \,
+ *    {\rm d}\vec{p} \, {\rm d}\vec{p'}\f]
+ *
+ * of a sky model at the energy nodes \f$E_i\f$, multiplied by the weights
+ * \f$w_i\f$ of a 15-point Gauss-Kronrod rule in \f$\ln E\f$ (one rule per
+ * half decade of the energy range of the events). The spectral integral of
+ * Npred is then the sum of \f$K(E_i)\f$ times the spectral model values at
+ * the nodes.
+ *
+ * Kernels exist only for sky models with fixed spatial parameters. They are
+ * computed when first requested and recomputed if the spatial parameter
+ * values have changed. The kernels are computed at the time @p obsTime of
+ * the first request, assuming that the response does not depend on time.
+ ***************************************************************************/
+const std::vector<double>* GObservation::npred_kernel_values(const GModel& model,
+                                                             const GTime&  obsTime) const
+{
+    // Return NULL if the model is not a sky model with fixed spatial
+    // parameters
+    const GModelSky* sky = dynamic_cast<const GModelSky*>(&model);
+    if (sky == NULL || sky->spatial() == NULL || sky->spectral() == NULL ||
+        sky->temporal() == NULL) {
+        return NULL;
+    }
+    const GModelSpatial* spatial = sky->spatial();
+    for (int i = 0; i < spatial->size(); ++i) {
+        if ((*spatial)[i].isfree()) {
+            return NULL;
+        }
+    }
+
+    // Return NULL if there is no response or no valid energy range
+    GResponse* rsp = response();
+    if (rsp == NULL) {
+        return NULL;
+    }
+    double emin = events()->ebounds().emin().MeV();
+    double emax = events()->ebounds().emax().MeV();
+    if (emax <= emin) {
+        return NULL;
+    }
+
+    // Set energy nodes if they do not exist or if the energy range has
+    // changed. All kernels are discarded in that case.
+    if (m_npred_kernel_energies.empty() || emin != m_npred_kernel_emin ||
+        emax != m_npred_kernel_emax) {
+
+        // Discard kernels
+        m_npred_kernel_names.clear();
+        m_npred_kernel_pars.clear();
+        m_npred_kernel_values.clear();
+
+        // Get Gauss-Kronrod nodes in ln(E)
+        int nsub = int(std::log10(emax/emin) / G_NPRED_KERN_DLOGE) + 1;
+        std::vector<double> x;
+        std::vector<double> w;
+        GIntegral::gk_nodes(std::log(emin), std::log(emax), nsub, &x, &w);
+
+        // Set energies and weights, including the Jacobian of the
+        // variable substitution
+        m_npred_kernel_energies.assign(x.size(), 0.0);
+        m_npred_kernel_weights.assign(x.size(), 0.0);
+        for (int i = 0; i < x.size(); ++i) {
+            m_npred_kernel_energies[i] = std::exp(x[i]);
+            m_npred_kernel_weights[i]  = w[i] * m_npred_kernel_energies[i];
+        }
+        m_npred_kernel_emin = emin;
+        m_npred_kernel_emax = emax;
+
+    } // endif: energy nodes were set
+
+    // Get spatial parameter values
+    std::vector<double> pars;
+    for (int i = 0; i < spatial->size(); ++i) {
+        pars.push_back((*spatial)[i].value());
+    }
+
+    // Search kernel
+    int index = -1;
+    for (int i = 0; i < m_npred_kernel_names.size(); ++i) {
+        if (m_npred_kernel_names[i] == model.name()) {
+            index = i;
+            break;
+        }
+    }
+
+    // Append kernel if it does not exist
+    if (index == -1) {
+        index = m_npred_kernel_names.size();
+        m_npred_kernel_names.push_back(model.name());
+        m_npred_kernel_pars.push_back(std::vector<double>());
+        m_npred_kernel_values.push_back(std::vector<double>());
+    }
+
+    // Compute kernel if it is new or if the spatial parameters changed
+    if (m_npred_kernel_values[index].empty() ||
+        m_npred_kernel_pars[index] != pars) {
+        std::vector<double>& values = m_npred_kernel_values[index];
+        values.assign(m_npred_kernel_energies.size(), 0.0);
+        for (int i = 0; i < values.size(); ++i) {
+            GEnergy srcEng;
+            srcEng.MeV(m_npred_kernel_energies[i]);
+            GSource source(model.name(), sky->spatial(), srcEng, obsTime);
+            values[i] = m_npred_kernel_weights[i] * rsp->npred(source, *this);
+        }
+        m_npred_kernel_pars[index] = pars;
+    }
+
+    // Return pointer to kernel
+    return &(m_npred_kernel_values[index]);
+}
@@ -704,12 +704,34 @@ void GObservations::models(const std::string& filename)
  *
  * Optimizes the free parameters of the models by using the optimizer
  * that has been provided by the @p opt argument.
+ *
+ * The covariance matrix of the parameter value factors that is provided by
+ * the optimizer is converted into parameter units and stored in the model
+ * container.
  ***************************************************************************/
 void GObservations::optimize(GOptimizer& opt)
 {
     // Optimize model parameters
     opt.optimize(m_fct, m_models);
 
+    // Store covariance matrix in parameter units
+    const GMatrixSymmetric& factors = opt.covariance();
+    int                     npars   = m_models.npars();
+    if (npars > 0 && factors.rows() == npars) {
+        GMatrixSymmetric covariance(npars, npars);
+        for (int i = 0; i < npars; ++i) {
+            double scale_i = m_models.par(i).scale();
+            for (int j = i; j < npars; ++j) {
+                covariance(i,j) = factors(i,j) * scale_i *
+                                  m_models.par(j).scale();
+            }
+        }
+        m_models.covariance(covariance);
+    }
+    else {
+        m_models.covariance(GMatrixSymmetric());
+    }
+
     // Return
     return;
 }
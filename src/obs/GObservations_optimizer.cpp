@@ -32,8 +32,10 @@
 #include "GTools.hpp"
 #include "GEvent.hpp"
 #include "GEventList.hpp"
+#include "GEventBatch.hpp"
 #include "GEventCube.hpp"
 #include "GEventBin.hpp"
+#include "GMatrixSymmetric.hpp"
 
 /* __ OpenMP section _____________________________________________________ */
 #ifdef _OPENMP
@@ -42,10 +44,13 @@
 
 /* __ Method name definitions ____________________________________________ */
 #define G_EVAL              "GObservations::optimizer::eval(GOptimizerPars&)"
+#define G_EVAL_VALUE  "GObservations::optimizer::eval_value(GOptimizerPars&)"
 
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
+#define G_EVENT_BATCH_SIZE 1024 //!< Number of events per batch
+#define G_DENSE_COVAR_MAX_PARS 500 //!< Max. parameters for dense curvature
 
 /* __ Debug definitions __________________________________________________ */
 #define G_EVAL_TIMING   0 //!< Perform optimizer timing (0=no, 1=yes)
@@ -184,6 +189,30 @@ GObservations::optimizer& GObservations::optimizer::operator= (const optimizer&
  * Poisson and Gaussian statistics. 
  * Note that different statistics and different analysis methods
  * (binned/unbinned) may be combined.
+ *
+ * The computation is distributed over the threads in work items. A work
+ * item is a range of events or bins of one observation. Observations for
+ * which GObservation::threadsafe() is true are split into up to one range
+ * per thread, hence also a single observation is processed by all threads.
+ * Work items are assigned statically to threads and the results of the
+ * threads are summed in thread order, hence for a given number of threads
+ * the result is reproducible.
+ *
+ * Each thread accumulates the curvature matrix in its own working matrix.
+ * If the number of parameters does not exceed G_DENSE_COVAR_MAX_PARS,
+ * dense symmetric working matrices are used that are updated by adding
+ * the outer product of the gradient for each event or bin. The working
+ * matrices of all threads are then summed using a pairwise tree reduction
+ * before the result is converted into the sparse curvature matrix.
+ * Otherwise, sparse working matrices are used that are summed serially.
+ *
+ * For observations with an enabled model cache (see
+ * GObservation::model_cache()), only the models for which a parameter
+ * changed since the last evaluation are re-evaluated.
+ *
+ * If the curvature matrix computation was switched off using curvature(),
+ * no working matrices are accumulated and covar() returns a matrix of
+ * zeros.
  ***************************************************************************/
 void GObservations::optimizer::eval(const GOptimizerPars& pars) 
 {
@@ -219,52 +248,104 @@ void GObservations::optimizer::eval(const GOptimizerPars& pars)
         m_covar    = new GMatrixSparse(npars,npars);
         m_wrk_grad = new GVector(npars);
 
+        // Decide whether dense curvature working matrices should be used
+        // and whether sparse working matrices need a fill stack. Without
+        // curvature computation, the working matrices remain empty.
+        bool dense = (m_curvature && npars <= G_DENSE_COVAR_MAX_PARS);
+        bool stack = (m_curvature && !dense);
+
         // Set stack size and number of entries
         int stack_size  = (2*npars > 100000) ? 2*npars : 100000;
         int max_entries =  2*npars;
-        m_covar->stack_init(stack_size, max_entries);
+        if (stack) {
+            m_covar->stack_init(stack_size, max_entries);
+        }
+
+        // Determine the maximum number of threads
+        #ifdef _OPENMP
+        int nthreads = omp_get_max_threads();
+        #else
+        int nthreads = 1;
+        #endif
 
-        // Allocate vectors to save working variables of each thread
-        std::vector<GVector*>       vect_cpy_grad;
-        std::vector<GMatrixSparse*> vect_cpy_covar;
-        std::vector<double*>        vect_cpy_value;
-        std::vector<double*>        vect_cpy_npred;
+        // Set up the work items
+        std::vector<int> item_obs;
+        std::vector<int> item_begin;
+        std::vector<int> item_end;
+        work_items(nthreads, item_obs, item_begin, item_end);
+        int nitems = item_obs.size();
+
+        // Update the model caches of all observations and prepare the
+        // observations that are split over threads. This needs to be
+        // done before the parallel region as it assigns new states to the
+        // models for which a parameter changed since the last evaluation.
+        for (int i = 0; i < m_this->size(); ++i) {
+            m_this->m_obs[i]->model_cache_update((GModels&)pars);
+            if (m_this->m_obs[i]->threadsafe()) {
+                m_this->m_obs[i]->thread_setup((GModels&)pars);
+            }
+        }
+
+        // Allocate vectors to save working variables of each thread. The
+        // working variables are stored at the index of the thread so that
+        // the final summation is done in a deterministic order.
+        std::vector<GVector*>     vect_cpy_grad(nthreads, (GVector*)NULL);
+        std::vector<GMatrixBase*> vect_cpy_covar(nthreads, (GMatrixBase*)NULL);
+        std::vector<double*>      vect_cpy_value(nthreads, (double*)NULL);
+        std::vector<double*>      vect_cpy_npred(nthreads, (double*)NULL);
 
         // Here OpenMP will paralellize the execution. The following code will
         // be executed by the differents threads. In order to avoid protecting
         // attributes ( m_value,m_npred, m_gradient and m_covar), each thread
         // works with its own working variables (cpy_*). When a thread starts,
-        // we add working variables in a vector (vect_cpy_*). When computation
-        // is finished we just add all elements contain in the vector to the
-        // attributes value.
+        // we store its working variables in a vector (vect_cpy_*). When
+        // computation is finished we just add all elements contain in the
+        // vector to the attributes value.
         #pragma omp parallel
         {
             // Allocate and initialize variable copies for multi-threading
-            GModels        cpy_model((GModels&)pars);
-            GVector        cpy_wrk_grad(npars);
-            GVector*       cpy_gradient = new GVector(npars);
-            GMatrixSparse* cpy_covar    = new GMatrixSparse(npars,npars);
-            double*        cpy_npred    = new double(0.0);
-            double*        cpy_value    = new double(0.0);
-
-            // Set stack size and number of entries
-            cpy_covar->stack_init(stack_size, max_entries);
-
-            // Push variable copies into vector. This is a critical zone to
-            // avoid multiple thread pushing simultaneously.
-            #pragma omp critical
-            {
-                vect_cpy_grad.push_back(cpy_gradient);
-                vect_cpy_covar.push_back(cpy_covar); 
-                vect_cpy_value.push_back(cpy_value);
-                vect_cpy_npred.push_back(cpy_npred);
+            GModels      cpy_model((GModels&)pars);
+            GVector      cpy_wrk_grad(npars);
+            GVector*     cpy_gradient = new GVector(npars);
+            GMatrixBase* cpy_covar    = NULL;
+            double*      cpy_npred    = new double(0.0);
+            double*      cpy_value    = new double(0.0);
+
+            // Allocate curvature working matrix. A sparse matrix gets a
+            // stack for fast filling.
+            if (dense) {
+                cpy_covar = new GMatrixSymmetric(npars,npars);
+            }
+            else {
+                GMatrixSparse* sparse = new GMatrixSparse(npars,npars);
+                if (stack) {
+                    sparse->stack_init(stack_size, max_entries);
+                }
+                cpy_covar = sparse;
             }
 
-            // The omp for directive will deal the iterations on the differents
-            // threads.
-            #pragma omp for
-            // Loop over all observations
-            for (int i = 0; i < m_this->size(); ++i) {
+            // Store variable copies at the thread index
+            #ifdef _OPENMP
+            int ithread = omp_get_thread_num();
+            #else
+            int ithread = 0;
+            #endif
+            vect_cpy_grad[ithread]  = cpy_gradient;
+            vect_cpy_covar[ithread] = cpy_covar;
+            vect_cpy_value[ithread] = cpy_value;
+            vect_cpy_npred[ithread] = cpy_npred;
+
+            // The omp for directive will deal the work items on the differents
+            // threads. Static scheduling makes the assignment of work items
+            // to threads reproducible.
+            #pragma omp for schedule(static)
+            // Loop over all work items
+            for (int item = 0; item < nitems; ++item) {
+
+                // Get observation index and range for this work item
+                int i     = item_obs[item];
+                int begin = item_begin[item];
+                int end   = item_end[item];
 
                 // Extract statistics for this observation
                 std::string statistics = m_this->m_obs[i]->statistics();
@@ -275,25 +356,32 @@ void GObservations::optimizer::eval(const GOptimizerPars& pars)
                     // Poisson statistics
                     if (gammalib::toupper(statistics) == "POISSON") {
 
-                        // Determine Npred value and gradient for this observation
-                        double npred = m_this->m_obs[i]->npred(cpy_model, &cpy_wrk_grad);
-
-                        // Update the Npred value, gradient.
-                        *cpy_npred    += npred;
-                        *cpy_gradient += cpy_wrk_grad;
-
-                        // Optionally show debug information
-                        #if G_EVAL_DEBUG
-                        #pragma omp critial single
-                        {
-                            std::cout << "Unbinned Poisson (" << i << "):";
-                            std::cout << " Npred=" << npred;
-                            std::cout << " Grad="<< cpy_wrk_grad << std::endl;
-                            std::cout << "Sum:";
-                            std::cout << " Npred=" << *cpy_npred;
-                            std::cout << " Grad=" << *cpy_gradient << std::endl;
-                        }
-                        #endif
+                        // Determine Npred value and gradient for this
+                        // observation (only for the first range of events)
+                        double npred = 0.0;
+                        if (begin == 0) {
+
+                            // Determine Npred value and gradient
+                            npred = m_this->m_obs[i]->npred(cpy_model, &cpy_wrk_grad);
+
+                            // Update the Npred value, gradient.
+                            *cpy_npred    += npred;
+                            *cpy_gradient += cpy_wrk_grad;
+
+                            // Optionally show debug information
+                            #if G_EVAL_DEBUG
+                            #pragma omp critial single
+                            {
+                                std::cout << "Unbinned Poisson (" << i << "):";
+                                std::cout << " Npred=" << npred;
+                                std::cout << " Grad="<< cpy_wrk_grad << std::endl;
+                                std::cout << "Sum:";
+                                std::cout << " Npred=" << *cpy_npred;
+                                std::cout << " Grad=" << *cpy_gradient << std::endl;
+                            }
+                            #endif
+
+                        } // endif: first range of events
 
                         // Update the log-likelihood
                         poisson_unbinned(*(m_this->m_obs[i]), 
@@ -301,7 +389,9 @@ void GObservations::optimizer::eval(const GOptimizerPars& pars)
                                          *cpy_covar,
                                          *cpy_gradient,
                                          *cpy_value,
-                                          cpy_wrk_grad);
+                                          cpy_wrk_grad,
+                                          begin,
+                                          end);
 
                         // Add the Npred value to the log-likelihood
                         *cpy_value += npred;
@@ -330,7 +420,9 @@ void GObservations::optimizer::eval(const GOptimizerPars& pars)
                                        *cpy_gradient,
                                        *cpy_value,
                                        *cpy_npred,
-                                        cpy_wrk_grad);
+                                        cpy_wrk_grad,
+                                        begin,
+                                        end);
                     }
 
                     // ... or Gaussian statistics
@@ -344,7 +436,9 @@ void GObservations::optimizer::eval(const GOptimizerPars& pars)
                                         *cpy_gradient,
                                         *cpy_value,
                                         *cpy_npred,
-                                         cpy_wrk_grad);
+                                         cpy_wrk_grad,
+                                         begin,
+                                         end);
                     }
 
                     // ... or unsupported
@@ -356,25 +450,64 @@ void GObservations::optimizer::eval(const GOptimizerPars& pars)
 
                 } // endelse: binned analysis
 
-            } // endfor: looped over observations
+            } // endfor: looped over work items
 
             // Release stack
-            cpy_covar->stack_destroy();
+            if (stack) {
+                static_cast<GMatrixSparse*>(cpy_covar)->stack_destroy();
+            }
 
         } // end pragma omp parallel
 
-        // Now the computation is finished, update attributes.
-        // For each omp section, a thread will be created.
-        #pragma omp sections
-        {
-            #pragma omp section
-            {
-                for (int i = 0; i < vect_cpy_covar.size() ; ++i) {
-                    *m_covar += *(vect_cpy_covar.at(i));
-                    delete vect_cpy_covar.at(i);
+        // Remove the slots of threads that did not participate in the
+        // computation (this may happen if less than the maximum number of
+        // threads were used), keeping the thread order
+        int nslots = 0;
+        for (int i = 0; i < nthreads; ++i) {
+            if (vect_cpy_grad[i] != NULL) {
+                vect_cpy_grad[nslots]  = vect_cpy_grad[i];
+                vect_cpy_covar[nslots] = vect_cpy_covar[i];
+                vect_cpy_value[nslots] = vect_cpy_value[i];
+                vect_cpy_npred[nslots] = vect_cpy_npred[i];
+                nslots++;
+            }
+        }
+        vect_cpy_grad.resize(nslots);
+        vect_cpy_covar.resize(nslots);
+        vect_cpy_value.resize(nslots);
+        vect_cpy_npred.resize(nslots);
+
+        // Now the computation is finished, update the curvature matrix.
+        // Dense working matrices are summed pairwise in a tree reduction
+        // where all sums of one level are computed in parallel, sparse
+        // working matrices are summed serially.
+        int ncovar = vect_cpy_covar.size();
+        if (dense) {
+            for (int stride = 1; stride < ncovar; stride *= 2) {
+                #pragma omp parallel for
+                for (int i = 0; i < ncovar-stride; i += 2*stride) {
+                    *(static_cast<GMatrixSymmetric*>(vect_cpy_covar[i])) +=
+                    *(static_cast<GMatrixSymmetric*>(vect_cpy_covar[i+stride]));
                 }
             }
+            if (ncovar > 0) {
+                *m_covar =
+                    GMatrixSparse(*(static_cast<GMatrixSymmetric*>(vect_cpy_covar[0])));
+            }
+        }
+        else if (m_curvature) {
+            for (int i = 0; i < ncovar; ++i) {
+                *m_covar += *(static_cast<GMatrixSparse*>(vect_cpy_covar[i]));
+            }
+        }
+        for (int i = 0; i < ncovar; ++i) {
+            delete vect_cpy_covar[i];
+        }
 
+        // Update remaining attributes. For each omp section, a thread will
+        // be created.
+        #pragma omp sections
+        {
             #pragma omp section
             {
                 for (int i = 0; i < vect_cpy_grad.size(); ++i){
@@ -401,7 +534,9 @@ void GObservations::optimizer::eval(const GOptimizerPars& pars)
         } // end of pragma omp sections
 
         // Release stack
-        m_covar->stack_destroy();
+        if (stack) {
+            m_covar->stack_destroy();
+        }
 
     } while(0); // endwhile: main loop
 
@@ -441,6 +576,152 @@ void GObservations::optimizer::eval(const GOptimizerPars& pars)
 }
 
 
+/***********************************************************************//**
+ * @brief Evaluate log-likelihood function value
+ *
+ * @param[in] pars Optimizer parameters.
+ * @return Function value.
+ *
+ * @exception GException::invalid_statistics
+ *            Invalid optimization statistics encountered.
+ *
+ * This method evaluates the -(log-likelihood) function value without
+ * computing the gradient vector and the curvature matrix. The function
+ * value, gradient vector and curvature matrix of the last eval() call are
+ * not modified, and the parameter gradients are not set.
+ *
+ * The work items and their assignment to threads are the same as for
+ * eval(), and the function values are summed in the same order, hence the
+ * method returns the same value as eval() for identical parameters.
+ ***************************************************************************/
+double GObservations::optimizer::eval_value(const GOptimizerPars& pars) 
+{
+    // Initialise function value
+    double value = 0.0;
+
+    // Determine the maximum number of threads
+    #ifdef _OPENMP
+    int nthreads = omp_get_max_threads();
+    #else
+    int nthreads = 1;
+    #endif
+
+    // Set up the work items
+    std::vector<int> item_obs;
+    std::vector<int> item_begin;
+    std::vector<int> item_end;
+    work_items(nthreads, item_obs, item_begin, item_end);
+    int nitems = item_obs.size();
+
+    // Update the model caches of all observations and prepare the
+    // observations that are split over threads
+    for (int i = 0; i < m_this->size(); ++i) {
+        m_this->m_obs[i]->model_cache_update((GModels&)pars);
+        if (m_this->m_obs[i]->threadsafe()) {
+            m_this->m_obs[i]->thread_setup((GModels&)pars);
+        }
+    }
+
+    // Allocate vector to save the function value of each thread
+    std::vector<double> vect_cpy_value(nthreads, 0.0);
+    std::vector<bool>   vect_cpy_used(nthreads, false);
+
+    // Compute function value in parallel
+    #pragma omp parallel
+    {
+        // Allocate and initialize variable copies for multi-threading
+        GModels cpy_model((GModels&)pars);
+        double  cpy_value = 0.0;
+
+        // Get thread index
+        #ifdef _OPENMP
+        int ithread = omp_get_thread_num();
+        #else
+        int ithread = 0;
+        #endif
+
+        // Loop over all work items
+        #pragma omp for schedule(static)
+        for (int item = 0; item < nitems; ++item) {
+
+            // Get observation and range for this work item
+            const GObservation& obs   = *(m_this->m_obs[item_obs[item]]);
+            int                 begin = item_begin[item];
+            int                 end   = item_end[item];
+
+            // Extract statistics for this observation
+            std::string statistics = gammalib::toupper(obs.statistics());
+
+            // Unbinned analysis
+            if (dynamic_cast<const GEventList*>(obs.events()) != NULL) {
+
+                // Poisson statistics
+                if (statistics == "POISSON") {
+
+                    // Determine Npred (only for the first range of events)
+                    double npred = (begin == 0) ? obs.npred(cpy_model) : 0.0;
+
+                    // Update the log-likelihood
+                    poisson_unbinned_value(obs, cpy_model, cpy_value,
+                                           begin, end);
+
+                    // Add the Npred value to the log-likelihood
+                    cpy_value += npred;
+
+                }
+
+                // ... otherwise throw an exception
+                else {
+                    throw GException::invalid_statistics(G_EVAL_VALUE, statistics,
+                        "Unbinned optimization requires Poisson statistics.");
+                }
+
+            } // endif: unbinned analysis
+
+            // ... or binned analysis
+            else {
+
+                // Poisson statistics
+                if (statistics == "POISSON") {
+                    poisson_binned_value(obs, cpy_model, cpy_value,
+                                         begin, end);
+                }
+
+                // ... or Gaussian statistics
+                else if (statistics == "GAUSSIAN") {
+                    gaussian_binned_value(obs, cpy_model, cpy_value,
+                                          begin, end);
+                }
+
+                // ... or unsupported
+                else {
+                    throw GException::invalid_statistics(G_EVAL_VALUE, statistics,
+                          "Binned optimization requires Poisson or Gaussian"
+                          " statistics.");
+                }
+
+            } // endelse: binned analysis
+
+        } // endfor: looped over work items
+
+        // Store function value at the thread index
+        vect_cpy_value[ithread] = cpy_value;
+        vect_cpy_used[ithread]  = true;
+
+    } // end pragma omp parallel
+
+    // Sum the function values in thread order
+    for (int i = 0; i < nthreads; ++i) {
+        if (vect_cpy_used[i]) {
+            value += vect_cpy_value[i];
+        }
+    }
+
+    // Return function value
+    return value;
+}
+
+
 /***********************************************************************//**
  * @brief Evaluate log-likelihood function for Poisson statistics and
  *        unbinned analysis
@@ -462,7 +743,8 @@ void GObservations::optimizer::poisson_unbinned(const GObservation& obs,
                                                 const GOptimizerPars& pars)
 {
     // Perform computations using the global members
-    poisson_unbinned(obs, pars, *m_covar, *m_gradient, m_value, *m_wrk_grad);
+    poisson_unbinned(obs, pars, *m_covar, *m_gradient, m_value, *m_wrk_grad,
+                     0, obs.events()->size());
 
     // Return
     return;
@@ -479,13 +761,26 @@ void GObservations::optimizer::poisson_unbinned(const GObservation& obs,
  * @param[in,out] gradient Gradient.
  * @param[in,out] value Likelihood value.
  * @param[in,out] wrk_grad Gradient working array.
+ * @param[in] begin Index of first event.
+ * @param[in] end Index after last event.
+ *
+ * The events are processed in batches of G_EVENT_BATCH_SIZE events. The
+ * model values and gradients of all events in a batch are computed in a
+ * single call of GObservation::model(), which avoids the per-event
+ * overhead of the model evaluation.
+ *
+ * Only the events [begin,end[ of the event list are considered, so that
+ * the events of a single observation can be distributed over several
+ * threads.
  ***************************************************************************/
 void GObservations::optimizer::poisson_unbinned(const GObservation&   obs,
                                                 const GOptimizerPars& pars,
-                                                GMatrixSparse&        covar,
+                                                GMatrixBase&          covar,
                                                 GVector&              gradient,
                                                 double&               value,
-                                                GVector&              wrk_grad)
+                                                GVector&              wrk_grad,
+                                                const int&            begin,
+                                                const int&            end)
 {
     // Timing measurement
     #if G_EVAL_TIMING
@@ -499,70 +794,78 @@ void GObservations::optimizer::poisson_unbinned(const GObservation&   obs,
     // Get number of parameters
     int npars = pars.npars();
 
-    // Allocate some working arrays
-    int*    inx    = new int[npars];
-    double* values = new double[npars];
+    // Get event list
+    const GEventList* events = static_cast<const GEventList*>(obs.events());
 
-    // Iterate over all events
-    for (int i = 0; i < obs.events()->size(); ++i) {
-
-        // Get event pointer
-        const GEvent* event = (*obs.events())[i];
-
-        // Get model and derivative
-        double model = obs.model((GModels&)pars, *event, &wrk_grad);
-
-        // Skip bin if model is too small (avoids -Inf or NaN gradients)
-        if (model <= m_minmod) {
-            continue;
+    // Allocate some working arrays
+    int*                inx    = new int[npars];
+    double*             values = new double[npars];
+    std::vector<double> models(G_EVENT_BATCH_SIZE);
+    std::vector<double> grads(G_EVENT_BATCH_SIZE * npars);
+    GEventBatch         batch;
+
+    // Iterate over all events of the range in batches
+    for (int ibegin = begin; ibegin < end; ibegin += G_EVENT_BATCH_SIZE) {
+
+        // Set batch of events
+        int iend = ibegin + G_EVENT_BATCH_SIZE;
+        if (iend > end) {
+            iend = end;
         }
+        batch.set(*events, ibegin, iend);
+        int nevents = batch.size();
 
-        // Create index array of non-zero derivatives and initialise working
-        // array
-        int ndev = 0;
-        for (int i = 0; i < npars; ++i) {
-            values[i] = 0.0;
-            if (wrk_grad[i] != 0.0 && !gammalib::isinfinite(wrk_grad[i])) {
-                inx[ndev] = i;
-                ndev++;
-            }
-        }
+        // Get model values and derivatives for all events of the batch
+        obs.model((GModels&)pars, batch, &(models[0]), &(grads[0]));
 
-        // Update Poissonian statistics (excluding factorial term for faster
-        // computation)
-        value -= log(model);
+        // Iterate over all events in batch
+        for (int i = 0; i < nevents; ++i) {
 
-        // Skip bin now if there are no non-zero derivatives
-        if (ndev < 1) {
-            continue;
-        }
+            // Get model and derivative
+            double model = models[i];
+            for (int k = 0, igrad = i; k < npars; ++k, igrad += nevents) {
+                wrk_grad[k] = grads[igrad];
+            }
 
-        // Update gradient vector and curvature matrix.
-        double fb = 1.0 / model;
-        double fa = fb / model;
-        for (int jdev = 0; jdev < ndev; ++jdev) {
+            // Skip bin if model is too small (avoids -Inf or NaN gradients)
+            if (model <= m_minmod) {
+                continue;
+            }
 
-            // Initialise computation
-            register int jpar    = inx[jdev];
-            double       g       = wrk_grad[jpar];
-            double       fa_i    = fa * g;
+            // Create index array of non-zero derivatives and initialise
+            // working array
+            int ndev = 0;
+            for (int k = 0; k < npars; ++k) {
+                values[k] = 0.0;
+                if (wrk_grad[k] != 0.0 && !gammalib::isinfinite(wrk_grad[k])) {
+                    inx[ndev] = k;
+                    ndev++;
+                }
+            }
 
-            // Update gradient.
-            gradient[jpar] -= fb * g;
+            // Update Poissonian statistics (excluding factorial term for faster
+            // computation)
+            value -= log(model);
 
-            // Loop over rows
-            register int* ipar = inx;
+            // Skip bin now if there are no non-zero derivatives
+            if (ndev < 1) {
+                continue;
+            }
 
-            for (register int idev = 0; idev < ndev; ++idev, ++ipar) {
-                values[idev] = fa_i * wrk_grad[*ipar];
+            // Update gradient vector
+            double fb = 1.0 / model;
+            double fa = fb / model;
+            for (int jdev = 0; jdev < ndev; ++jdev) {
+                register int jpar = inx[jdev];
+                gradient[jpar]   -= fb * wrk_grad[jpar];
             }
 
-            // Add column to matrix
-            covar.add_to_column(jpar, values, inx, ndev);
+            // Update curvature matrix
+            update_curvature(covar, fa, wrk_grad, inx, ndev, values);
 
-        } // endfor: looped over columns
+        } // endfor: iterated over all events in batch
 
-    } // endfor: iterated over all events
+    } // endfor: iterated over all batches
 
     // Free temporary memory
     if (values != NULL) delete [] values;
@@ -613,7 +916,8 @@ void GObservations::optimizer::poisson_binned(const GObservation& obs,
                                               const GOptimizerPars& pars) 
 {
     // Perform computations using the global members
-    poisson_binned(obs, pars, *m_covar, *m_gradient, m_value, m_npred, *m_wrk_grad); 
+    poisson_binned(obs, pars, *m_covar, *m_gradient, m_value, m_npred,
+                   *m_wrk_grad, 0, obs.events()->size());
 
     // Return
     return;
@@ -631,14 +935,18 @@ void GObservations::optimizer::poisson_binned(const GObservation& obs,
  * @param[in,out] value Likelihood value.
  * @param[in,out] npred Number of predicted events.
  * @param[in,out] wrk_grad Gradient working array.
+ * @param[in] begin Index of first bin.
+ * @param[in] end Index after last bin.
  ***************************************************************************/
 void GObservations::optimizer::poisson_binned(const GObservation&   obs,
                                               const GOptimizerPars& pars,
-                                              GMatrixSparse&        covar,
+                                              GMatrixBase&          covar,
                                               GVector&              gradient,
                                               double&               value,
                                               double&               npred,
-                                              GVector&              wrk_grad)
+                                              GVector&              wrk_grad,
+                                              const int&            begin,
+                                              const int&            end)
 {
     // Timing measurement
     #if G_EVAL_TIMING
@@ -667,8 +975,8 @@ void GObservations::optimizer::poisson_binned(const GObservation&   obs,
     int*    inx    = new int[npars];
     double* values = new double[npars];
 
-    // Iterate over all bins
-    for (int i = 0; i < obs.events()->size(); ++i) {
+    // Iterate over all bins of the range
+    for (int i = begin; i < end; ++i) {
 
         // Update number of bins
         #if G_OPT_DEBUG
@@ -683,7 +991,7 @@ void GObservations::optimizer::poisson_binned(const GObservation&   obs,
         double data = bin->counts();
 
         // Get model and derivative
-        double model = obs.model((GModels&)pars, *bin, &wrk_grad);
+        double model = obs.model((GModels&)pars, *bin, i, &wrk_grad);
 
         // Multiply model by bin size
         model *= bin->size();
@@ -741,27 +1049,14 @@ void GObservations::optimizer::poisson_binned(const GObservation&   obs,
             double fc = (1.0 - fb);
             double fa = fb / model;
 
-            // Loop over columns
+            // Update gradient vector
             for (int jdev = 0; jdev < ndev; ++jdev) {
+                register int jpar = inx[jdev];
+                gradient[jpar]   += fc * wrk_grad[jpar];
+            }
 
-                // Initialise computation
-                register int jpar    = inx[jdev];
-                double       g       = wrk_grad[jpar];
-                double       fa_i    = fa * g;
-
-                // Update gradient
-                gradient[jpar] += fc * g;
-
-                // Loop over rows
-                register int* ipar = inx;
-                for (register int idev = 0; idev < ndev; ++idev, ++ipar) {
-                    values[idev] = fa_i * wrk_grad[*ipar];
-                }
-
-                // Add column to matrix
-                covar.add_to_column(jpar, values, inx, ndev);
-
-            } // endfor: looped over columns
+            // Update curvature matrix
+            update_curvature(covar, fa, wrk_grad, inx, ndev, values);
 
         } // endif: data was > 0
 
@@ -854,7 +1149,8 @@ void GObservations::optimizer::gaussian_binned(const GObservation& obs,
                                                const GOptimizerPars& pars) 
 {
     // Perform computations using the global members
-    gaussian_binned(obs, pars, *m_covar, *m_gradient, m_value, m_npred, *m_wrk_grad); 
+    gaussian_binned(obs, pars, *m_covar, *m_gradient, m_value, m_npred,
+                    *m_wrk_grad, 0, obs.events()->size());
 
     // Return
     return;
@@ -872,14 +1168,18 @@ void GObservations::optimizer::gaussian_binned(const GObservation& obs,
  * @param[in,out] npred Number of predicted events.
  * @param[in,out] value Likelihood value.
  * @param[in,out] wrk_grad Gradient working array.
+ * @param[in] begin Index of first bin.
+ * @param[in] end Index after last bin.
  ***************************************************************************/
 void GObservations::optimizer::gaussian_binned(const GObservation&   obs,
                                                const GOptimizerPars& pars,
-                                               GMatrixSparse&        covar,
+                                               GMatrixBase&          covar,
                                                GVector&              gradient,
                                                double&               value,
                                                double&               npred,
-                                               GVector&              wrk_grad)
+                                               GVector&              wrk_grad,
+                                               const int&            begin,
+                                               const int&            end)
 {
     // Timing measurement
     #if G_EVAL_TIMING
@@ -897,8 +1197,8 @@ void GObservations::optimizer::gaussian_binned(const GObservation&   obs,
     int*    inx    = new int[npars];
     double* values = new double[npars];
 
-    // Iterate over all bins
-    for (int i = 0; i < obs.events()->size(); ++i) {
+    // Iterate over all bins of the range
+    for (int i = begin; i < end; ++i) {
 
         // Get event pointer
         const GEventBin* bin =
@@ -916,7 +1216,7 @@ void GObservations::optimizer::gaussian_binned(const GObservation&   obs,
         }
 
         // Get model and derivative
-        double model = obs.model((GModels&)pars, *bin, &wrk_grad);
+        double model = obs.model((GModels&)pars, *bin, i, &wrk_grad);
 
         // Multiply model by bin size
         model *= bin->size();
@@ -955,26 +1255,14 @@ void GObservations::optimizer::gaussian_binned(const GObservation&   obs,
             continue;
         }
 
-        // Loop over columns
+        // Update gradient vector
         for (int jdev = 0; jdev < ndev; ++jdev) {
-
-            // Initialise computation
             register int jpar = inx[jdev];
-            double       fa_i = wrk_grad[jpar] * weight;
-
-            // Update gradient
-            gradient[jpar] -= fa * fa_i;
-
-            // Loop over rows
-            register int* ipar = inx;
-            for (register int idev = 0; idev < ndev; ++idev, ++ipar) {
-                values[idev] = fa_i * wrk_grad[*ipar];
-            }
-
-            // Add column to matrix
-            covar.add_to_column(jpar, values, inx, ndev);
+            gradient[jpar]   -= fa * wrk_grad[jpar] * weight;
+        }
 
-        } // endfor: looped over columns
+        // Update curvature matrix
+        update_curvature(covar, weight, wrk_grad, inx, ndev, values);
 
     } // endfor: iterated over all events
 
@@ -1076,3 +1364,294 @@ void GObservations::optimizer::free_members(void)
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Set up work items for likelihood evaluation
+ *
+ * @param[in] nthreads Maximum number of threads.
+ * @param[out] item_obs Observation indices of work items.
+ * @param[out] item_begin Indices of first event or bin of work items.
+ * @param[out] item_end Indices after last event or bin of work items.
+ *
+ * Each work item is a range [begin,end[ of events or bins of an
+ * observation. If the model evaluation of an observation is thread safe,
+ * its events or bins are split into up to one range per thread so that a
+ * single observation can make use of all threads. A range spans at least
+ * G_EVENT_BATCH_SIZE events or bins.
+ ***************************************************************************/
+void GObservations::optimizer::work_items(const int&        nthreads,
+                                          std::vector<int>& item_obs,
+                                          std::vector<int>& item_begin,
+                                          std::vector<int>& item_end) const
+{
+    // Clear work items
+    item_obs.clear();
+    item_begin.clear();
+    item_end.clear();
+
+    // Loop over observations
+    for (int i = 0; i < m_this->size(); ++i) {
+        int num     = m_this->m_obs[i]->events()->size();
+        int nchunks = 1;
+        if (m_this->m_obs[i]->threadsafe()) {
+            nchunks = (num + G_EVENT_BATCH_SIZE - 1) / G_EVENT_BATCH_SIZE;
+            if (nchunks > nthreads) {
+                nchunks = nthreads;
+            }
+            if (nchunks < 1) {
+                nchunks = 1;
+            }
+        }
+        for (int k = 0; k < nchunks; ++k) {
+            item_obs.push_back(i);
+            item_begin.push_back(int((double(num) * k) / nchunks));
+            item_end.push_back(int((double(num) * (k+1)) / nchunks));
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Add -(log-likelihood) value for Poisson statistics and unbinned
+ *        analysis
+ *
+ * @param[in] obs Observation.
+ * @param[in] pars Optimizer parameters.
+ * @param[in,out] value Function value.
+ * @param[in] begin Index of first event.
+ * @param[in] end Index after last event.
+ *
+ * Adds \f$-\sum_i \log e_i\f$ for the events [begin,end[ to the function
+ * value, using the same batches and the same event selection as
+ * poisson_unbinned(), but without computing the model gradients.
+ ***************************************************************************/
+void GObservations::optimizer::poisson_unbinned_value(const GObservation&   obs,
+                                                      const GOptimizerPars& pars,
+                                                      double&               value,
+                                                      const int&            begin,
+                                                      const int&            end) const
+{
+    // Get event list
+    const GEventList* events = static_cast<const GEventList*>(obs.events());
+
+    // Allocate working array
+    std::vector<double> models(G_EVENT_BATCH_SIZE);
+    GEventBatch         batch;
+
+    // Iterate over all events of the range in batches
+    for (int ibegin = begin; ibegin < end; ibegin += G_EVENT_BATCH_SIZE) {
+
+        // Set batch of events
+        int iend = ibegin + G_EVENT_BATCH_SIZE;
+        if (iend > end) {
+            iend = end;
+        }
+        batch.set(*events, ibegin, iend);
+        int nevents = batch.size();
+
+        // Get model values for all events of the batch
+        obs.model((GModels&)pars, batch, &(models[0]));
+
+        // Update Poissonian statistics, skipping events with too small
+        // model values
+        for (int i = 0; i < nevents; ++i) {
+            if (models[i] > m_minmod) {
+                value -= log(models[i]);
+            }
+        }
+
+    } // endfor: iterated over batches
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Add -(log-likelihood) value for Poisson statistics and binned
+ *        analysis
+ *
+ * @param[in] obs Observation.
+ * @param[in] pars Optimizer parameters.
+ * @param[in,out] value Function value.
+ * @param[in] begin Index of first bin.
+ * @param[in] end Index after last bin.
+ *
+ * Adds the -(log-likelihood) value for the bins [begin,end[ to the
+ * function value, using the same bin selection as poisson_binned(), but
+ * without computing the model gradients.
+ ***************************************************************************/
+void GObservations::optimizer::poisson_binned_value(const GObservation&   obs,
+                                                    const GOptimizerPars& pars,
+                                                    double&               value,
+                                                    const int&            begin,
+                                                    const int&            end) const
+{
+    // Iterate over all bins of the range
+    for (int i = begin; i < end; ++i) {
+
+        // Get event pointer
+        const GEventBin* bin =
+            (*(static_cast<GEventCube*>(const_cast<GEvents*>(obs.events()))))[i];
+
+        // Get number of counts in bin
+        double data = bin->counts();
+
+        // Get model value and multiply it by bin size
+        double model = obs.model((GModels&)pars, *bin, i, NULL) * bin->size();
+
+        // Skip bin if model is too small
+        if (model <= m_minmod) {
+            continue;
+        }
+
+        // Update Poissonian statistics (excluding factorial term for
+        // faster computation)
+        if (data > 0.0) {
+            value -= data * log(model) - model;
+        }
+        else {
+            value += model;
+        }
+
+    } // endfor: iterated over all bins
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Add -(log-likelihood) value for Gaussian statistics and binned
+ *        analysis
+ *
+ * @param[in] obs Observation.
+ * @param[in] pars Optimizer parameters.
+ * @param[in,out] value Function value.
+ * @param[in] begin Index of first bin.
+ * @param[in] end Index after last bin.
+ *
+ * Adds the -(log-likelihood) value for the bins [begin,end[ to the
+ * function value, using the same bin selection as gaussian_binned(), but
+ * without computing the model gradients.
+ ***************************************************************************/
+void GObservations::optimizer::gaussian_binned_value(const GObservation&   obs,
+                                                     const GOptimizerPars& pars,
+                                                     double&               value,
+                                                     const int&            begin,
+                                                     const int&            end) const
+{
+    // Iterate over all bins of the range
+    for (int i = begin; i < end; ++i) {
+
+        // Get event pointer
+        const GEventBin* bin =
+            (*(static_cast<GEventCube*>(const_cast<GEvents*>(obs.events()))))[i];
+
+        // Get number of counts in bin and statistical uncertainty
+        double data  = bin->counts();
+        double sigma = bin->error();
+
+        // Skip bin if statistical uncertainty is too small
+        if (sigma <= m_minerr) {
+            continue;
+        }
+
+        // Get model value and multiply it by bin size
+        double model = obs.model((GModels&)pars, *bin, i, NULL) * bin->size();
+
+        // Skip bin if model is too small
+        if (model <= m_minmod) {
+            continue;
+        }
+
+        // Update Gaussian statistics
+        double weight = 1.0 / (sigma * sigma);
+        double fa     = data - model;
+        value        += 0.5 * (fa * fa * weight);
+
+    } // endfor: iterated over all bins
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Add weighted outer product of gradient to curvature matrix
+ *
+ * @param[in,out] covar Curvature matrix.
+ * @param[in] weight Weight of outer product.
+ * @param[in] wrk_grad Gradient working array.
+ * @param[in] inx Indices of non-zero gradients (in ascending order).
+ * @param[in] ndev Number of non-zero gradients.
+ * @param[in] values Working array (at least @p ndev elements).
+ *
+ * Adds the weighted outer product \f$w \, g_i \, g_j\f$ of the non-zero
+ * gradient elements to the curvature matrix. If the curvature matrix is
+ * a dense symmetric matrix, only the lower triangle is updated using
+ * GMatrixSymmetric::add_outer_product(). Otherwise the matrix is assumed
+ * to be a sparse matrix that is filled column by column.
+ *
+ * Nothing is done if the curvature matrix computation was switched off.
+ ***************************************************************************/
+void GObservations::optimizer::update_curvature(GMatrixBase&   covar,
+                                                const double&  weight,
+                                                const GVector& wrk_grad,
+                                                const int*     inx,
+                                                const int&     ndev,
+                                                double*        values) const
+{
+    // Return if the curvature matrix is not needed
+    if (!m_curvature) {
+        return;
+    }
+
+    // Get pointer to dense symmetric curvature matrix
+    GMatrixSymmetric* dense = dynamic_cast<GMatrixSymmetric*>(&covar);
+
+    // Case A: dense symmetric curvature matrix
+    if (dense != NULL) {
+
+        // Gather non-zero gradients
+        for (int idev = 0; idev < ndev; ++idev) {
+            values[idev] = wrk_grad[inx[idev]];
+        }
+
+        // Add outer product to lower triangle
+        dense->add_outer_product(weight, values, inx, ndev);
+
+    } // endif: curvature matrix was dense
+
+    // Case B: sparse curvature matrix
+    else {
+
+        // Get sparse curvature matrix
+        GMatrixSparse& sparse = static_cast<GMatrixSparse&>(covar);
+
+        // Loop over columns
+        for (int jdev = 0; jdev < ndev; ++jdev) {
+
+            // Initialise computation
+            double fa_i = weight * wrk_grad[inx[jdev]];
+
+            // Loop over rows
+            register const int* ipar = inx;
+            for (register int idev = 0; idev < ndev; ++idev, ++ipar) {
+                values[idev] = fa_i * wrk_grad[*ipar];
+            }
+
+            // Add column to matrix
+            sparse.add_to_column(inx[jdev], values, inx, ndev);
+
+        } // endfor: looped over columns
+
+    } // endelse: curvature matrix was sparse
+
+    // Return
+    return;
+}
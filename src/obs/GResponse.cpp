@@ -33,6 +33,7 @@
 #include "GResponse.hpp"
 #include "GObservation.hpp"
 #include "GIntegral.hpp"
+#include "GDerivative.hpp"
 #include "GVector.hpp"
 #include "GSkyDir.hpp"
 #include "GException.hpp"
@@ -307,6 +308,75 @@ double GResponse::irf_diffuse(const GEvent&       event,
 }
 
 
+/***********************************************************************//**
+ * @brief Return instrument response function and its spatial gradients
+ *
+ * @param[in] event Observed event.
+ * @param[in] source Source.
+ * @param[in] obs Observation.
+ * @return Instrument response function.
+ *
+ * Returns the instrument response function for a given event and source
+ * and sets the gradients of all parameters of the spatial model of the
+ * source to the partial derivatives of the instrument response function
+ * with respect to these parameters. Gradients of fixed parameters are set
+ * to zero.
+ *
+ * Diffuse models are linear in their normalization parameter, hence their
+ * gradient is directly obtained from the instrument response function.
+ * For all other models, the gradients are computed numerically by the
+ * irf_gradient() method. Instrument specific classes may overload this
+ * method to provide analytical gradients.
+ *
+ * As the irf() method, this method applies the deadtime correction.
+ ***************************************************************************/
+double GResponse::irf_gradients(const GEvent&       event,
+                                const GSource&      source,
+                                const GObservation& obs) const
+{
+    // Get IRF value
+    double irf = this->irf(event, source, obs);
+
+    // Get non-const pointer on spatial model (circumvent const correctness)
+    GModelSpatial* model = const_cast<GModelSpatial*>(source.model());
+
+    // Continue only if model is valid
+    if (model != NULL) {
+
+        // Signal if model is a diffuse model
+        bool diffuse = (dynamic_cast<GModelSpatialDiffuse*>(model) != NULL);
+
+        // Loop over all model parameters
+        for (int i = 0; i < model->size(); ++i) {
+
+            // Get reference on model parameter
+            GModelPar& par = (*model)[i];
+
+            // Initialise gradient
+            double grad = 0.0;
+
+            // Compute gradient only if parameter is free
+            if (par.isfree()) {
+                if (diffuse && par.factor_value() != 0.0) {
+                    grad = irf / par.factor_value();
+                }
+                else {
+                    grad = irf_gradient(event, source, obs, i);
+                }
+            }
+
+            // Set gradient
+            par.factor_gradient(grad);
+
+        } // endfor: looped over model parameters
+
+    } // endif: model was valid
+
+    // Return IRF value
+    return irf;
+}
+
+
 /***********************************************************************//**
  * @brief Return data space integral of instrument response function
  *
@@ -604,6 +674,102 @@ void GResponse::free_members(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Return numerical gradient of IRF with respect to spatial parameter
+ *
+ * @param[in] event Observed event.
+ * @param[in] source Source.
+ * @param[in] obs Observation.
+ * @param[in] ipar Spatial model parameter index.
+ * @return Partial derivative of IRF with respect to parameter factor.
+ *
+ * Computes the partial derivative of the instrument response function with
+ * respect to the factor value of the spatial model parameter @p ipar using
+ * a numerical central difference. The step size and boundary handling are
+ * identical to those used by GObservation::model_grad(), but only the
+ * instrument response function needs to be evaluated, and not the full
+ * source model.
+ ***************************************************************************/
+double GResponse::irf_gradient(const GEvent&       event,
+                               const GSource&      source,
+                               const GObservation& obs,
+                               const int&          ipar) const
+{
+    // Get non-const reference on model parameter (circumvent const
+    // correctness)
+    GModelSpatial* model = const_cast<GModelSpatial*>(source.model());
+    GModelPar&     par   = (*model)[ipar];
+
+    // Save current model parameter
+    GModelPar current = par;
+
+    // Get actual parameter value
+    double x = par.factor_value();
+
+    // Set fixed step size for computation of derivative. If this would
+    // violate a boundary, dx is reduced accordingly. In case that x is
+    // right on the boundary, x is displaced slightly from the boundary to
+    // allow evaluation of the derivative.
+    const double step_size = 0.0002;
+    double       dx        = step_size;
+    if (par.hasmin()) {
+        double dx_min = x - par.factor_min();
+        if (dx_min == 0.0) {
+            dx = step_size * x;
+            if (dx == 0.0) {
+                dx = step_size;
+            }
+            x += dx;
+        }
+        else if (dx_min < dx) {
+            dx = dx_min;
+        }
+    }
+    if (par.hasmax()) {
+        double dx_max = par.factor_max() - x;
+        if (dx_max == 0.0) {
+            dx = step_size * x;
+            if (dx == 0.0) {
+                dx = step_size;
+            }
+            x -= dx;
+        }
+        else if (dx_max < dx) {
+            dx = dx_max;
+        }
+    }
+
+    // Remove any boundaries to avoid limitations
+    par.remove_range();
+
+    // Get derivative
+    irf_func    function(*this, event, source, obs, par);
+    GDerivative derivative(&function);
+    double      grad = derivative.difference(x, dx);
+
+    // Restore current model parameter
+    par = current;
+
+    // Return gradient
+    return grad;
+}
+
+
+/***********************************************************************//**
+ * @brief IRF function for numerical spatial parameter derivatives
+ *
+ * @param[in] x Factor value of spatial model parameter.
+ ***************************************************************************/
+double GResponse::irf_func::eval(double x)
+{
+    // Set parameter value
+    m_par.factor_value(x);
+
+    // Return IRF value
+    return (m_rsp.irf(m_event, m_source, m_obs));
+}
+
+
 /***********************************************************************//**
  * @brief Kernel for offset angle Npred integration of radial model
  *
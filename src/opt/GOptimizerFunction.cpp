@@ -125,6 +125,28 @@ GOptimizerFunction& GOptimizerFunction::operator=(const GOptimizerFunction& fct)
  =                                                                         =
  ==========================================================================*/
 
+/***********************************************************************//**
+ * @brief Evaluate function value
+ *
+ * @param[in] pars Function parameters.
+ * @return Function value.
+ *
+ * Returns the function value for the parameters @p pars. The base class
+ * implementation performs a full function evaluation using eval(), hence
+ * gradient() and covar() are updated too. Derived classes may overload
+ * the method to compute only the function value, in which case value(),
+ * gradient() and covar() keep the results of the last eval() call.
+ ***************************************************************************/
+double GOptimizerFunction::eval_value(const GOptimizerPars& pars)
+{
+    // Evaluate function
+    eval(pars);
+
+    // Return function value
+    return (value());
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                             Private methods                             =
@@ -136,6 +158,9 @@ GOptimizerFunction& GOptimizerFunction::operator=(const GOptimizerFunction& fct)
  ***************************************************************************/
 void GOptimizerFunction::init_members(void)
 {
+    // Initialise members
+    m_curvature = true;
+
     // Return
     return;
 }
@@ -148,6 +173,9 @@ void GOptimizerFunction::init_members(void)
  ***************************************************************************/
 void GOptimizerFunction::copy_members(const GOptimizerFunction& fct)
 {
+    // Copy members
+    m_curvature = fct.m_curvature;
+
     // Return
     return;
 }
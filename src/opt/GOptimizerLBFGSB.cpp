@@ -0,0 +1,814 @@
+/***************************************************************************
+ *        GOptimizerLBFGSB.cpp - Bound constrained L-BFGS optimizer        *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GOptimizerLBFGSB.cpp
+ * @brief Bound constrained L-BFGS optimizer class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <cmath>
+#include "GOptimizerLBFGSB.hpp"
+#include "GTools.hpp"
+#include "GException.hpp"
+#include "GMatrix.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+#define G_LBFGSB_ARMIJO  1.0e-4    //!< Sufficient decrease parameter
+#define G_LBFGSB_CURV    2.2e-16   //!< Minimum relative curvature y*s/(y*y)
+
+/* __ Debug definitions __________________________________________________ */
+//#define G_DEBUG_OPT              //!< Define to debug optimize() method
+
+
+/*==========================================================================
+ =                                                                         =
+ =                        Constructors/destructors                         =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GOptimizerLBFGSB::GOptimizerLBFGSB(void) : GOptimizer()
+{
+    // Initialise private members for clean destruction
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Constructor with logger
+ *
+ * @param[in] log Logger to use in optimizer.
+ ***************************************************************************/
+GOptimizerLBFGSB::GOptimizerLBFGSB(GLog& log) : GOptimizer()
+{
+    // Initialise private members for clean destruction
+    init_members();
+
+    // Set pointer to logger
+    m_logger = &log;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] opt Optimizer from which the instance should be built.
+ ***************************************************************************/
+GOptimizerLBFGSB::GOptimizerLBFGSB(const GOptimizerLBFGSB& opt) :
+                  GOptimizer(opt)
+{
+    // Initialise private members for clean destruction
+    init_members();
+
+    // Copy members
+    copy_members(opt);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GOptimizerLBFGSB::~GOptimizerLBFGSB(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                               Operators                                 =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] opt Optimizer to be assigned.
+ ***************************************************************************/
+GOptimizerLBFGSB& GOptimizerLBFGSB::operator= (const GOptimizerLBFGSB& opt)
+{
+    // Execute only if object is not identical
+    if (this != &opt) {
+
+        // Copy base class members
+        this->GOptimizer::operator=(opt);
+
+        // Free members
+        free_members();
+
+        // Initialise private members for clean destruction
+        init_members();
+
+        // Copy members
+        copy_members(opt);
+
+    } // endif: object was not identical
+
+    // Return
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear object
+ *
+ * This method properly resets the object to an initial state.
+ ***************************************************************************/
+void GOptimizerLBFGSB::clear(void)
+{
+    // Free class members (base and derived classes, derived class first)
+    free_members();
+    this->GOptimizer::free_members();
+
+    // Initialise members
+    this->GOptimizer::init_members();
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone object
+***************************************************************************/
+GOptimizerLBFGSB* GOptimizerLBFGSB::clone(void) const
+{
+    return new GOptimizerLBFGSB(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Optimize function parameters
+ *
+ * @param[in] fct Optimization function.
+ * @param[in] pars Function parameters.
+ *
+ * Minimises the function by iterating bound constrained L-BFGS steps. The
+ * curvature matrix computation of the function is switched off during the
+ * iterations and is restored to its initial setting afterwards.
+ *
+ * The iterations stop if the function decrease of a step is smaller than
+ * eps(), if no descent direction exists within the parameter boundaries,
+ * if the line search fails to decrease the function along the steepest
+ * descent direction, or if the maximum number of iterations is reached.
+ ***************************************************************************/
+void GOptimizerLBFGSB::optimize(GOptimizerFunction& fct, GOptimizerPars& pars)
+{
+    // Reset covariance matrix and corrections
+    m_covariance = GMatrixSymmetric();
+    m_s.clear();
+    m_y.clear();
+    m_rho.clear();
+
+    // Get number of parameters. Continue only if there are free parameters
+    m_npars = pars.npars();
+    m_nfree = pars.nfree();
+    m_iter  = 0;
+    if (m_nfree > 0) {
+
+        // Initialise optimization status
+        m_status = G_LBFGSB_CONVERGED;
+
+        // Switch off the curvature matrix computation
+        bool curvature = fct.curvature();
+        fct.curvature(false);
+
+        // Initial function evaluation. The function value is taken from
+        // eval_value() since the trial steps of the line search are judged
+        // using eval_value(), hence function values are only compared if
+        // they were computed in the same way
+        fct.eval(pars);
+        m_value = fct.eval_value(pars);
+
+        // Get gradient of free parameters
+        GVector grad(m_npars);
+        for (int ipar = 0; ipar < m_npars; ++ipar) {
+            if (pars.par(ipar).isfree()) {
+                grad[ipar] = (*fct.gradient())[ipar];
+            }
+        }
+
+        // Optionally write initial iteration into logger
+        if (m_logger != NULL) {
+            *m_logger << "Initial iteration: ";
+            *m_logger << "func=" << m_value << std::endl;
+        }
+        #if defined(G_DEBUG_OPT)
+        std::cout << "Initial iteration: func=" << m_value << std::endl;
+        #endif
+
+        // Iterative fitting
+        bool converged = false;
+        for (m_iter = 1; m_iter <= m_max_iter; ++m_iter) {
+
+            // Determine active parameters. These are fixed parameters
+            // and free parameters that sit on a boundary with a gradient
+            // that points outside the valid range
+            std::vector<bool> active(m_npars, false);
+            int               nactive = 0;
+            for (int ipar = 0; ipar < m_npars; ++ipar) {
+                const GModelPar& par = pars.par(ipar);
+                if (!par.isfree()) {
+                    active[ipar] = true;
+                }
+                else if (par.hasmin() && par.factor_value() <= par.factor_min() &&
+                         grad[ipar] > 0.0) {
+                    active[ipar] = true;
+                    nactive++;
+                }
+                else if (par.hasmax() && par.factor_value() >= par.factor_max() &&
+                         grad[ipar] < 0.0) {
+                    active[ipar] = true;
+                    nactive++;
+                }
+            }
+
+            // Compute search direction. If this is not a descent direction
+            // then drop the stored corrections and use the steepest descent
+            // direction. If even the steepest descent direction is not a
+            // descent direction then the projected gradient vanishes and
+            // we have converged.
+            GVector dir   = direction(grad, active);
+            double  slope = dir * grad;
+            if (!(slope < 0.0) && !m_s.empty()) {
+                m_s.clear();
+                m_y.clear();
+                m_rho.clear();
+                dir   = direction(grad, active);
+                slope = dir * grad;
+            }
+            if (!(slope < 0.0)) {
+                converged = true;
+                break;
+            }
+
+            // Save parameters, function value and gradient
+            GVector save_pars(m_npars);
+            for (int ipar = 0; ipar < m_npars; ++ipar) {
+                save_pars[ipar] = pars.par(ipar).factor_value();
+            }
+            double  value_old = m_value;
+            GVector grad_old  = grad;
+
+            // Perform line search. If the line search fails, retry with
+            // the steepest descent direction, otherwise stop
+            if (!line_search(fct, pars, dir, grad)) {
+                if (!m_s.empty()) {
+                    m_s.clear();
+                    m_y.clear();
+                    m_rho.clear();
+                    continue;
+                }
+                m_status = G_LBFGSB_STALLED;
+                break;
+            }
+
+            // Get new gradient of free parameters
+            for (int ipar = 0; ipar < m_npars; ++ipar) {
+                if (pars.par(ipar).isfree()) {
+                    grad[ipar] = (*fct.gradient())[ipar];
+                }
+            }
+
+            // Store correction if the curvature condition is satisfied
+            GVector s(m_npars);
+            for (int ipar = 0; ipar < m_npars; ++ipar) {
+                s[ipar] = pars.par(ipar).factor_value() - save_pars[ipar];
+            }
+            GVector y  = grad - grad_old;
+            double  sy = s * y;
+            double  yy = y * y;
+            if (sy > G_LBFGSB_CURV * yy) {
+                m_s.push_back(s);
+                m_y.push_back(y);
+                m_rho.push_back(1.0 / sy);
+                if (m_s.size() > (unsigned int)m_memory) {
+                    m_s.erase(m_s.begin());
+                    m_y.erase(m_y.begin());
+                    m_rho.erase(m_rho.begin());
+                }
+            }
+
+            // Compute function improvement (>0 means decrease)
+            double delta = value_old - m_value;
+
+            // Optionally write iteration results into logger
+            if (m_logger != NULL) {
+                *m_logger << "Iteration " << m_iter << ": ";
+                *m_logger << "func=" << m_value << ", ";
+                *m_logger << "delta=" << delta << ", ";
+                *m_logger << "bounded=" << nactive << ", ";
+                *m_logger << "memory=" << (int)m_s.size() << std::endl;
+            }
+            #if defined(G_DEBUG_OPT)
+            std::cout << "Iteration " << m_iter << ": func="
+                      << m_value << ", delta=" << delta << std::endl;
+            #endif
+
+            // Stop if convergence was reached
+            if (delta < m_eps) {
+                converged = true;
+                break;
+            }
+
+        } // endfor: iterations
+
+        // Signal if the maximum number of iterations was reached
+        if (m_iter > m_max_iter) {
+            m_iter = m_max_iter;
+            if (!converged) {
+                m_status = G_LBFGSB_MAX_ITER;
+            }
+        }
+
+        // Compute parameter uncertainties
+        fct.curvature(true);
+        errors(fct, pars);
+
+        // Restore the curvature matrix computation setting
+        fct.curvature(curvature);
+
+    } // endif: there were free parameters to fit
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Print optimizer information
+ *
+ * @param[in] chatter Chattiness (defaults to NORMAL).
+ * @return String containing optimizer information.
+ ***************************************************************************/
+std::string GOptimizerLBFGSB::print(const GChatter& chatter) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Continue only if chatter is not silent
+    if (chatter != SILENT) {
+
+        // Append header
+        result.append("=== GOptimizerLBFGSB ===");
+
+        // Append information
+        result.append("\n"+gammalib::parformat("Optimized function value"));
+        result.append(gammalib::str(m_value));
+        result.append("\n"+gammalib::parformat("Absolute precision"));
+        result.append(gammalib::str(m_eps));
+
+        // Append status
+        result.append("\n"+gammalib::parformat("Optimization status"));
+        switch (m_status) {
+        case G_LBFGSB_CONVERGED:
+            result.append("converged");
+            break;
+        case G_LBFGSB_STALLED:
+            result.append("stalled");
+            break;
+        case G_LBFGSB_MAX_ITER:
+            result.append("maximum number of iterations reached");
+            break;
+        case G_LBFGSB_BAD_ERRORS:
+            result.append("errors are inaccurate");
+            break;
+        default:
+            result.append("unknown");
+            break;
+        }
+
+        // Append further information
+        result.append("\n"+gammalib::parformat("Number of parameters"));
+        result.append(gammalib::str(m_npars));
+        result.append("\n"+gammalib::parformat("Number of free parameters"));
+        result.append(gammalib::str(m_nfree));
+        result.append("\n"+gammalib::parformat("Number of iterations"));
+        result.append(gammalib::str(m_iter));
+        result.append("\n"+gammalib::parformat("Number of corrections"));
+        result.append(gammalib::str(m_memory));
+
+    } // endif: chatter was not silent
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Private methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GOptimizerLBFGSB::init_members(void)
+{
+    // Initialise optimizer parameters
+    m_npars          = 0;
+    m_nfree          = 0;
+    m_eps            = 1.0e-6;
+    m_max_iter       = 1000;
+    m_max_linesearch = 20;
+    m_memory         = 10;
+
+    // Initialise corrections
+    m_s.clear();
+    m_y.clear();
+    m_rho.clear();
+
+    // Initialise optimizer values
+    m_value  = 0.0;
+    m_status = 0;
+    m_iter   = 0;
+
+    // Initialise pointer to logger
+    m_logger = NULL;
+
+    // Initialise covariance matrix
+    m_covariance = GMatrixSymmetric();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] opt GOptimizerLBFGSB members to be copied.
+ ***************************************************************************/
+void GOptimizerLBFGSB::copy_members(const GOptimizerLBFGSB& opt)
+{
+    // Copy attributes
+    m_npars          = opt.m_npars;
+    m_nfree          = opt.m_nfree;
+    m_eps            = opt.m_eps;
+    m_max_iter       = opt.m_max_iter;
+    m_max_linesearch = opt.m_max_linesearch;
+    m_memory         = opt.m_memory;
+    m_s              = opt.m_s;
+    m_y              = opt.m_y;
+    m_rho            = opt.m_rho;
+    m_value          = opt.m_value;
+    m_status         = opt.m_status;
+    m_iter           = opt.m_iter;
+    m_logger         = opt.m_logger;
+    m_covariance     = opt.m_covariance;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GOptimizerLBFGSB::free_members(void)
+{
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Compute search direction
+ *
+ * @param[in] grad Function gradient.
+ * @param[in] active Active parameter flags.
+ * @return Search direction.
+ *
+ * Computes the search direction \f$-H g\f$ using the two-loop recursion
+ * over the stored corrections, where \f$H\f$ is the L-BFGS approximation
+ * of the inverse curvature matrix and \f$g\f$ the gradient. Active
+ * parameters are excluded from the recursion and have a zero component
+ * in the search direction.
+ *
+ * Without stored corrections the steepest descent direction, normalised
+ * to unit length, is returned.
+ ***************************************************************************/
+GVector GOptimizerLBFGSB::direction(const GVector&           grad,
+                                    const std::vector<bool>& active) const
+{
+    // Initialise working vector with gradient of inactive parameters
+    GVector q(m_npars);
+    for (int ipar = 0; ipar < m_npars; ++ipar) {
+        if (!active[ipar]) {
+            q[ipar] = grad[ipar];
+        }
+    }
+
+    // First loop: from newest to oldest correction
+    int                 m = m_s.size();
+    std::vector<double> alpha(m, 0.0);
+    for (int k = m-1; k >= 0; --k) {
+        double sq = 0.0;
+        for (int ipar = 0; ipar < m_npars; ++ipar) {
+            if (!active[ipar]) {
+                sq += m_s[k][ipar] * q[ipar];
+            }
+        }
+        alpha[k] = m_rho[k] * sq;
+        for (int ipar = 0; ipar < m_npars; ++ipar) {
+            if (!active[ipar]) {
+                q[ipar] -= alpha[k] * m_y[k][ipar];
+            }
+        }
+    }
+
+    // Scale by initial inverse curvature estimate
+    double gamma = 0.0;
+    if (m > 0) {
+        gamma = 1.0 / (m_rho[m-1] * (m_y[m-1] * m_y[m-1]));
+    }
+    else {
+        double length = norm(q);
+        gamma         = (length > 0.0) ? 1.0 / length : 0.0;
+    }
+    q *= gamma;
+
+    // Second loop: from oldest to newest correction
+    for (int k = 0; k < m; ++k) {
+        double yq = 0.0;
+        for (int ipar = 0; ipar < m_npars; ++ipar) {
+            if (!active[ipar]) {
+                yq += m_y[k][ipar] * q[ipar];
+            }
+        }
+        double beta = m_rho[k] * yq;
+        for (int ipar = 0; ipar < m_npars; ++ipar) {
+            if (!active[ipar]) {
+                q[ipar] += (alpha[k] - beta) * m_s[k][ipar];
+            }
+        }
+    }
+
+    // Return search direction
+    return (-q);
+}
+
+
+/***********************************************************************//**
+ * @brief Perform projected backtracking line search
+ *
+ * @param[in] fct Optimizer function.
+ * @param[in] pars Function parameters.
+ * @param[in] dir Search direction.
+ * @param[in] grad Function gradient.
+ * @return True if a step with sufficient decrease was found.
+ *
+ * Searches a step along the search direction @p dir, projected onto the
+ * parameter boundaries, that decreases the function sufficiently (Armijo
+ * condition). The search starts with a unit step that is halved until
+ * the condition is satisfied or until max_linesearch() steps have been
+ * tried. Each trial step is evaluated using eval_value(), and eval() is
+ * only called once a step has been accepted, so that the gradient is
+ * available for the next iteration.
+ *
+ * If no step was accepted, the parameters are restored to their initial
+ * values.
+ ***************************************************************************/
+bool GOptimizerLBFGSB::line_search(GOptimizerFunction& fct,
+                                   GOptimizerPars&     pars,
+                                   const GVector&      dir,
+                                   const GVector&      grad)
+{
+    // Save parameter values
+    GVector save_pars(m_npars);
+    for (int ipar = 0; ipar < m_npars; ++ipar) {
+        save_pars[ipar] = pars.par(ipar).factor_value();
+    }
+
+    // Loop over trial steps
+    bool   success = false;
+    double step    = 1.0;
+    for (int i = 0; i < m_max_linesearch; ++i, step *= 0.5) {
+
+        // Set projected trial parameters and compute the expected
+        // function change from the gradient
+        double decrease = 0.0;
+        for (int ipar = 0; ipar < m_npars; ++ipar) {
+            if (dir[ipar] != 0.0) {
+                GModelPar& par = pars.par(ipar);
+                double     p   = save_pars[ipar] + step * dir[ipar];
+                if (par.hasmin() && p < par.factor_min()) {
+                    p = par.factor_min();
+                }
+                if (par.hasmax() && p > par.factor_max()) {
+                    p = par.factor_max();
+                }
+                par.factor_value(p);
+                decrease += grad[ipar] * (p - save_pars[ipar]);
+            }
+        }
+
+        // Stop if the projected step does not decrease the function
+        if (!(decrease < 0.0)) {
+            break;
+        }
+
+        // Evaluate function value and accept step if the decrease is
+        // sufficient. Compute the gradient for the accepted step.
+        double value = fct.eval_value(pars);
+        if (value <= m_value + G_LBFGSB_ARMIJO * decrease) {
+            fct.eval(pars);
+            m_value = value;
+            success = true;
+            break;
+        }
+
+    } // endfor: looped over trial steps
+
+    // Restore parameters if no step was accepted
+    if (!success) {
+        for (int ipar = 0; ipar < m_npars; ++ipar) {
+            if (dir[ipar] != 0.0) {
+                pars.par(ipar).factor_value(save_pars[ipar]);
+            }
+        }
+    }
+
+    // Return success flag
+    return success;
+}
+
+
+/***********************************************************************//**
+ * @brief Compute parameter uncertainties
+ *
+ * @param[in] fct Optimizer function.
+ * @param[in] pars Function parameters.
+ *
+ * Computes the curvature matrix at the optimum and inverts it in a single
+ * multiple right-hand side Cholesky solve. The parameter uncertainties are
+ * derived from the diagonal elements and the covariance matrix is stored
+ * for retrieval by the covariance() method. If the curvature matrix is not
+ * positive definite, the diagonal elements of the free parameters are
+ * loaded with 1e-10 and the errors are flagged as inaccurate.
+ *
+ * Free parameters that sit on a boundary with a gradient that points
+ * outside the valid range are kept fixed for the error computation, as
+ * done by GOptimizerLM. Their errors are set to zero.
+ ***************************************************************************/
+void GOptimizerLBFGSB::errors(GOptimizerFunction& fct, GOptimizerPars& pars)
+{
+    // Get number of parameters
+    int npars = pars.npars();
+
+    // Perform final parameter evaluation
+    fct.eval(pars);
+    m_value = fct.value();
+
+    // Fix bounded parameters and re-evaluate the function if there are any
+    std::vector<bool> bounded(npars, false);
+    int               nbounded = 0;
+    for (int ipar = 0; ipar < npars; ++ipar) {
+        GModelPar& par  = pars.par(ipar);
+        double     grad = (*fct.gradient())[ipar];
+        if (par.isfree() &&
+            ((par.hasmin() && par.factor_value() <= par.factor_min() && grad > 0.0) ||
+             (par.hasmax() && par.factor_value() >= par.factor_max() && grad < 0.0))) {
+            bounded[ipar] = true;
+            nbounded++;
+            par.fix();
+            par.factor_error(0.0);
+        }
+    }
+    if (nbounded > 0) {
+        fct.eval(pars);
+    }
+
+    // Fetch sparse matrix pointer (after eval() which allocates it)
+    GMatrixSparse* covar = fct.covar();
+
+    // Initialise covariance matrix
+    m_covariance = GMatrixSymmetric(npars, npars);
+
+    // Loop over error computation (maximum 2 turns)
+    for (int i = 0; i < 2; ++i) {
+
+        // Solve: covar * X = unit
+        try {
+            GMatrixSparse decomposition = covar->cholesky_decompose(true);
+            GMatrix unit(npars, npars);
+            for (int ipar = 0; ipar < npars; ++ipar) {
+                unit(ipar,ipar) = 1.0;
+            }
+            GMatrix x = decomposition.cholesky_solver(unit, true);
+
+            // Set parameter errors from the diagonal elements
+            for (int ipar = 0; ipar < npars; ++ipar) {
+                if (x(ipar,ipar) >= 0.0) {
+                    pars.par(ipar).factor_error(std::sqrt(x(ipar,ipar)));
+                }
+                else {
+                    pars.par(ipar).factor_error(0.0);
+                    m_status = G_LBFGSB_BAD_ERRORS;
+                }
+            }
+
+            // Store symmetrised covariance matrix
+            for (int row = 0; row < npars; ++row) {
+                for (int col = row; col < npars; ++col) {
+                    m_covariance(row,col) = 0.5 * (x(row,col) + x(col,row));
+                }
+            }
+        }
+        catch (GException::matrix_zero &e) {
+            m_status = G_LBFGSB_BAD_ERRORS;
+            if (m_logger != NULL) {
+                *m_logger << "GOptimizerLBFGSB::errors: "
+                          << "All curvature matrix elements are zero."
+                          << std::endl;
+            }
+            break;
+        }
+        catch (GException::matrix_not_pos_definite &e) {
+            m_status = G_LBFGSB_BAD_ERRORS;
+            if (i == 0) {
+                if (m_logger != NULL) {
+                    *m_logger << "Non-Positive definite curvature matrix encountered."
+                              << std::endl;
+                    *m_logger << "Load diagonal elements with 1e-10."
+                              << " Fit errors may be inaccurate."
+                              << std::endl;
+                }
+                for (int ipar = 0; ipar < npars; ++ipar) {
+                    if (pars.par(ipar).isfree()) {
+                        (*covar)(ipar,ipar) += 1.0e-10;
+                    }
+                }
+                continue;
+            }
+            if (m_logger != NULL) {
+                *m_logger << "Non-Positive definite curvature matrix encountered,"
+                          << " even after diagonal loading." << std::endl;
+            }
+            break;
+        }
+
+        // If no error occured then break now
+        break;
+
+    } // endfor: looped over error computation
+
+    // Free bounded parameters again
+    for (int ipar = 0; ipar < npars; ++ipar) {
+        if (bounded[ipar]) {
+            pars.par(ipar).free();
+        }
+    }
+
+    // Return
+    return;
+}
@@ -31,6 +31,7 @@
 #include "GOptimizerLM.hpp"
 #include "GTools.hpp"
 #include "GException.hpp"
+#include "GMatrix.hpp"
 
 /* __ Method name definitions ____________________________________________ */
 
@@ -189,6 +190,9 @@ GOptimizerLM* GOptimizerLM::clone(void) const
  ***************************************************************************/
 void GOptimizerLM::optimize(GOptimizerFunction& fct, GOptimizerPars& pars)
 {
+    // Reset covariance matrix
+    m_covariance = GMatrixSymmetric();
+
     // Get number of parameters. Continue only if there are free parameters
     m_npars = pars.npars();
     m_nfree = pars.nfree();
@@ -242,8 +246,11 @@ void GOptimizerLM::optimize(GOptimizerFunction& fct, GOptimizerPars& pars)
             }
         }
 
-        // Save function value
-        m_value = fct.value();
+        // Save function value. The function value is taken from
+        // eval_value() since the trial steps are judged using eval_value(),
+        // hence function values are only compared if they were computed
+        // in the same way
+        m_value = fct.eval_value(pars);
 
         // Save initial statistics and lambda values
         double value_old  = m_value;
@@ -527,6 +534,9 @@ void GOptimizerLM::init_members(void)
     // Initialise pointer to logger
     m_logger = NULL;
 
+    // Initialise covariance matrix
+    m_covariance = GMatrixSymmetric();
+
     // Return
     return;
 }
@@ -558,6 +568,7 @@ void GOptimizerLM::copy_members(const GOptimizerLM& opt)
     m_status       = opt.m_status;
     m_iter         = opt.m_iter;
     m_logger       = opt.m_logger;
+    m_covariance   = opt.m_covariance;
 
     // Return
     return;
@@ -585,6 +596,13 @@ void GOptimizerLM::free_members(void)
  * parameter. It calls the eval() method of the optimizer function which
  * is assumed to return the gradient and curvature matrix with respect to the
  * parameter values (and not the scaled true values).
+ *
+ * The trial step is judged using the eval_value() method of the optimizer
+ * function, and eval() is only called once the step has been accepted.
+ * If the step is rejected, the parameters, the gradient and the curvature
+ * matrix of the last accepted step are restored. The function value m_value
+ * is always the value returned by eval_value(), so that the trial value is
+ * never compared to a value that was computed by eval().
  ***************************************************************************/
 void GOptimizerLM::iteration(GOptimizerFunction& fct, GOptimizerPars& pars)
 {
@@ -737,37 +755,9 @@ void GOptimizerLM::iteration(GOptimizerFunction& fct, GOptimizerPars& pars)
 
         } // endfor: computed new parameter vector
 
-        // Evaluate function at new parameters
-        fct.eval(pars);
-
-        // If a free parameter has a zero diagonal element in the curvature
-        // matrix then remove this parameter definitely from the fit as it
-        // otherwise will block the fit. The problem appears in the unbinned
-        // fitting where parameter gradients may be zero (due to the truncation
-        // of the PSF), but the Npred gradient is not zero. In principle we
-        // could use the Npred gradient for fitting (I guess), but I still
-        // have to figure out how ... (the diagonal loading was not so
-        // successful as it faked early convergence)
-        for (int ipar = 0; ipar < m_npars; ++ipar) {
-            if (pars.par(ipar).isfree()) {
-                if ((*fct.covar())(ipar,ipar) == 0.0) {
-                    if (m_logger != NULL) {
-                        *m_logger << "  Parameter \"" << pars.par(ipar).name();
-                        *m_logger << "\" has zero covariance.";
-                        *m_logger << " Fix parameter." << std::endl;
-                    }
-                    m_par_remove[ipar] = true;
-                    pars.par(ipar).fix();
-                }
-            }
-        }
-
-        // Fetch new pointers since eval will allocate new memory
-        grad  = fct.gradient();
-        covar = fct.covar();
-
-        // Retrieve new function value
-        m_value = fct.value();
+        // Evaluate function value at new parameters. The gradient and
+        // curvature matrix are only computed once the step is accepted.
+        m_value = fct.eval_value(pars);
 
         // Debug option: dump new function value
         #if defined(G_DEBUG_ITER)
@@ -784,7 +774,8 @@ void GOptimizerLM::iteration(GOptimizerFunction& fct, GOptimizerPars& pars)
 
         // If the function has decreased then accept the new solution and decrease
         // lambda ...
-        double delta = save_value - m_value;
+        bool   accept = true;
+        double delta  = save_value - m_value;
         if (delta > 0.0) {
             m_lambda *= m_lambda_dec;
         }
@@ -810,15 +801,51 @@ void GOptimizerLM::iteration(GOptimizerFunction& fct, GOptimizerPars& pars)
         // and increase lamdba. Restore also the best statistics value that was
         // reached so far, the gradient vector and the curve matrix.
         else {
+            accept    = false;
             m_lambda *= m_lambda_inc;
             m_value   = save_value;
-            *grad     = save_grad;
-            *covar    = save_covar;
             for (int ipar = 0; ipar < m_npars; ++ipar) {
                 pars.par(ipar).factor_value(save_pars[ipar]);
             }
+
+            // Restore gradient and curvature matrix. We fetch new pointers
+            // since eval_value() may allocate new memory.
+            *(fct.gradient()) = save_grad;
+            *(fct.covar())    = save_covar;
         }
 
+        // If the new solution was accepted then evaluate the function
+        // gradient and curvature matrix at the new parameters
+        if (accept) {
+
+            // Evaluate function at new parameters
+            fct.eval(pars);
+
+            // If a free parameter has a zero diagonal element in the
+            // curvature matrix then remove this parameter definitely from
+            // the fit as it otherwise will block the fit. The problem
+            // appears in the unbinned fitting where parameter gradients
+            // may be zero (due to the truncation of the PSF), but the Npred
+            // gradient is not zero. In principle we could use the Npred
+            // gradient for fitting (I guess), but I still have to figure
+            // out how ... (the diagonal loading was not so successful as it
+            // faked early convergence)
+            for (int ipar = 0; ipar < m_npars; ++ipar) {
+                if (pars.par(ipar).isfree()) {
+                    if ((*fct.covar())(ipar,ipar) == 0.0) {
+                        if (m_logger != NULL) {
+                            *m_logger << "  Parameter \"" << pars.par(ipar).name();
+                            *m_logger << "\" has zero covariance.";
+                            *m_logger << " Fix parameter." << std::endl;
+                        }
+                        m_par_remove[ipar] = true;
+                        pars.par(ipar).fix();
+                    }
+                }
+            }
+
+        } // endif: new solution was accepted
+
     } while (0); // endwhile: main loop
 
     // Return
@@ -834,7 +861,9 @@ void GOptimizerLM::iteration(GOptimizerFunction& fct, GOptimizerPars& pars)
  * @param[in] pars Function parameters.
  *
  * Compute parameter uncertainties from the diagonal elements of the
- * covariance matrix.
+ * covariance matrix. The covariance matrix is obtained by inverting the
+ * curvature matrix, and is stored for later retrieval by the covariance()
+ * method. If the inversion fails, the covariance matrix is set to zero.
  ***************************************************************************/
 void GOptimizerLM::errors(GOptimizerFunction& fct, GOptimizerPars& pars)
 {
@@ -855,27 +884,44 @@ void GOptimizerLM::errors(GOptimizerFunction& fct, GOptimizerPars& pars)
     // Save covariance matrix
     GMatrixSparse save_covar = GMatrixSparse(*covar);
 
+    // Initialise covariance matrix
+    m_covariance = GMatrixSymmetric(npars, npars);
+
     // Signal no diagonal element loading
     bool diag_loaded = false;
 
     // Loop over error computation (maximum 2 turns)
     for (int i = 0; i < 2; ++i) {
 
-        // Solve: covar * X = unit
+        // Solve: covar * X = unit. All unit vectors are solved at once
+        // using the multiple right-hand side solver, so that the
+        // factorisation is traversed once per block of columns
         try {
             GMatrixSparse decomposition = covar->cholesky_decompose(true);
-            GVector unit(npars);
+            GMatrix unit(npars, npars);
             for (int ipar = 0; ipar < npars; ++ipar) {
-                unit[ipar] = 1.0;
-                GVector x  = decomposition.cholesky_solver(unit, true);
-                if (x[ipar] >= 0.0) {
-                    pars.par(ipar).factor_error(sqrt(x[ipar]));
+                unit(ipar,ipar) = 1.0;
+            }
+            GMatrix x = decomposition.cholesky_solver(unit, true);
+
+            // Set parameter errors from the diagonal elements
+            for (int ipar = 0; ipar < npars; ++ipar) {
+                if (x(ipar,ipar) >= 0.0) {
+                    pars.par(ipar).factor_error(sqrt(x(ipar,ipar)));
                 }
                 else {
                     pars.par(ipar).factor_error(0.0);
                     m_status = G_LM_BAD_ERRORS;
                 }
-                unit[ipar] = 0.0;
+            }
+
+            // Store covariance matrix (symmetrised to remove rounding
+            // differences between the upper and lower triangle)
+            m_covariance = GMatrixSymmetric(npars, npars);
+            for (int row = 0; row < npars; ++row) {
+                for (int col = row; col < npars; ++col) {
+                    m_covariance(row,col) = 0.5 * (x(row,col) + x(col,row));
+                }
             }
         }
         catch (GException::matrix_zero &e) {
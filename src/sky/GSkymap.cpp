@@ -28,6 +28,7 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <vector>
 #include "GException.hpp"
 #include "GTools.hpp"
 #include "GSkymap.hpp"
@@ -49,6 +50,8 @@
 #define G_READ                               "GSkymap::read(const GFitsHDU*)"
 #define G_PIX2DIR                                     "GSkymap::pix2dir(int)"
 #define G_DIR2PIX                                 "GSkymap::dir2pix(GSkyDir)"
+#define G_PIX2DIR_ARRAY         "GSkymap::pix2dir(int*,int&,double*,double*)"
+#define G_DIR2PIX_ARRAY         "GSkymap::dir2pix(double*,double*,int&,int*)"
 #define G_XY2DIR                                 "GSkymap::xy2dir(GSkyPixel)"
 #define G_DIR2XY                                   "GSkymap::dir2xy(GSkyDir)"
 #define G_OMEGA1                                        "GSkymap::omega(int)"
@@ -798,6 +801,161 @@ int GSkymap::dir2pix(const GSkyDir& dir) const
 }
 
 
+/***********************************************************************//**
+ * @brief Returns sky directions of pixels
+ *
+ * @param[in] pix Array [n] of pixel numbers (0,1,...,m_num_pixels).
+ * @param[in] n Number of pixels.
+ * @param[out] ra Array [n] of Right Ascensions (deg).
+ * @param[out] dec Array [n] of Declinations (deg).
+ *
+ * @exception GException::wcs
+ *            No valid WCS found.
+ *
+ * Returns the celestial coordinates for an array of sky map pixels. For
+ * sky maps with a 2D pixel indexation scheme, all pixels are transformed
+ * at once using GWcs::xy2world(), which avoids the overhead of
+ * transforming each pixel individually.
+ ***************************************************************************/
+void GSkymap::pix2dir(const int* pix, const int& n, double* ra,
+                      double* dec) const
+{
+    // Throw error if WCS is not valid
+    if (m_wcs == NULL) {
+        throw GException::wcs(G_PIX2DIR_ARRAY, "No valid WCS found.");
+    }
+
+    // Continue only if there are pixels
+    if (n > 0) {
+
+        // 1D pixel indexation: transform pixels individually
+        if (m_num_x == 0) {
+            for (int i = 0; i < n; ++i) {
+                GSkyDir dir = m_wcs->pix2dir(pix[i]);
+                ra[i]       = dir.ra_deg();
+                dec[i]      = dir.dec_deg();
+            }
+        }
+
+        // 2D pixel indexation: transform all pixels at once
+        else {
+
+            // Set pixel coordinates
+            std::vector<double> x(n);
+            std::vector<double> y(n);
+            for (int i = 0; i < n; ++i) {
+                x[i] = double(pix[i] % m_num_x);
+                y[i] = double(pix[i] / m_num_x);
+            }
+
+            // Transform pixels into world coordinates
+            m_wcs->xy2world(n, &(x[0]), &(y[0]), ra, dec);
+
+            // Convert world coordinates into celestial coordinates if
+            // the WCS is not celestial
+            if (m_wcs->coordsys() != "EQU") {
+                for (int i = 0; i < n; ++i) {
+                    GSkyDir dir;
+                    dir.lb_deg(ra[i], dec[i]);
+                    ra[i]  = dir.ra_deg();
+                    dec[i] = dir.dec_deg();
+                }
+            }
+
+        } // endelse: 2D pixel indexation
+
+    } // endif: there were pixels
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns pixel indices for sky directions
+ *
+ * @param[in] ra Array [n] of Right Ascensions (deg).
+ * @param[in] dec Array [n] of Declinations (deg).
+ * @param[in] n Number of sky directions.
+ * @param[out] pix Array [n] of pixel indices.
+ *
+ * @exception GException::wcs
+ *            No valid WCS found.
+ *
+ * Returns the sky map pixels for an array of celestial coordinates. For
+ * sky maps with a 2D pixel indexation scheme, all sky directions are
+ * transformed at once using GWcs::world2xy(), which avoids the overhead
+ * of transforming each direction individually. Sky directions that fall
+ * outside a 2D sky map are signalled by a pixel index of -1.
+ ***************************************************************************/
+void GSkymap::dir2pix(const double* ra, const double* dec, const int& n,
+                      int* pix) const
+{
+    // Throw error if WCS is not valid
+    if (m_wcs == NULL) {
+        throw GException::wcs(G_DIR2PIX_ARRAY, "No valid WCS found.");
+    }
+
+    // Continue only if there are sky directions
+    if (n > 0) {
+
+        // 1D pixel indexation: transform sky directions individually
+        if (m_num_x == 0) {
+            for (int i = 0; i < n; ++i) {
+                GSkyDir dir;
+                dir.radec_deg(ra[i], dec[i]);
+                pix[i] = m_wcs->dir2pix(dir);
+            }
+        }
+
+        // 2D pixel indexation: transform all sky directions at once
+        else {
+
+            // Allocate pixel coordinates
+            std::vector<double> x(n);
+            std::vector<double> y(n);
+
+            // Transform celestial coordinates into pixel coordinates. If
+            // the WCS is not celestial then convert the coordinates first.
+            if (m_wcs->coordsys() == "EQU") {
+                m_wcs->world2xy(n, ra, dec, &(x[0]), &(y[0]));
+            }
+            else {
+                std::vector<double> lng(n);
+                std::vector<double> lat(n);
+                for (int i = 0; i < n; ++i) {
+                    GSkyDir dir;
+                    dir.radec_deg(ra[i], dec[i]);
+                    lng[i] = dir.l_deg();
+                    lat[i] = dir.b_deg();
+                }
+                m_wcs->world2xy(n, &(lng[0]), &(lat[0]), &(x[0]), &(y[0]));
+            }
+
+            // Set pixel indices by rounding the pixel coordinates. Pixels
+            // outside the map are set to -1.
+            double xmax = double(m_num_x) - 0.5;
+            double ymax = double(m_num_y) - 0.5;
+            for (int i = 0; i < n; ++i) {
+                if (x[i] >= -0.5 && x[i] < xmax && y[i] >= -0.5 && y[i] < ymax) {
+                    int ix = int(x[i]+0.5);
+                    int iy = int(y[i]+0.5);
+                    pix[i] = ix + iy * m_num_x;
+                }
+                else {
+                    pix[i] = -1;
+                }
+            }
+
+        } // endelse: 2D pixel indexation
+
+    } // endif: there were sky directions
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns sky direction of pixel
  *
@@ -214,6 +214,85 @@ void GWcs::coordsys(const std::string& coordsys)
 }
 
 
+/***********************************************************************//**
+ * @brief Transform world coordinates into pixel coordinates
+ *
+ * @param[in] n Number of coordinates.
+ * @param[in] lng Array [n] of longitudes in WCS coordinate system (deg).
+ * @param[in] lat Array [n] of latitudes in WCS coordinate system (deg).
+ * @param[out] x Array [n] of x pixel coordinates (starting from 0).
+ * @param[out] y Array [n] of y pixel coordinates (starting from 0).
+ *
+ * Transforms an array of world coordinates into pixel coordinates. This
+ * generic implementation calls dir2xy() for each coordinate. Derived
+ * classes may overload the method by a vectorised transformation.
+ ***************************************************************************/
+void GWcs::world2xy(const int& n, const double* lng, const double* lat,
+                    double* x, double* y) const
+{
+    // Loop over coordinates
+    for (int i = 0; i < n; ++i) {
+
+        // Set sky direction
+        GSkyDir dir;
+        if (m_coordsys == 0) {
+            dir.radec_deg(lng[i], lat[i]);
+        }
+        else {
+            dir.lb_deg(lng[i], lat[i]);
+        }
+
+        // Transform sky direction into pixel
+        GSkyPixel pixel = dir2xy(dir);
+        x[i] = pixel.x();
+        y[i] = pixel.y();
+
+    } // endfor: looped over coordinates
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Transform pixel coordinates into world coordinates
+ *
+ * @param[in] n Number of coordinates.
+ * @param[in] x Array [n] of x pixel coordinates (starting from 0).
+ * @param[in] y Array [n] of y pixel coordinates (starting from 0).
+ * @param[out] lng Array [n] of longitudes in WCS coordinate system (deg).
+ * @param[out] lat Array [n] of latitudes in WCS coordinate system (deg).
+ *
+ * Transforms an array of pixel coordinates into world coordinates. This
+ * generic implementation calls xy2dir() for each coordinate. Derived
+ * classes may overload the method by a vectorised transformation.
+ ***************************************************************************/
+void GWcs::xy2world(const int& n, const double* x, const double* y,
+                    double* lng, double* lat) const
+{
+    // Loop over coordinates
+    for (int i = 0; i < n; ++i) {
+
+        // Transform pixel into sky direction
+        GSkyDir dir = xy2dir(GSkyPixel(x[i], y[i]));
+
+        // Set world coordinates
+        if (m_coordsys == 0) {
+            lng[i] = dir.ra_deg();
+            lat[i] = dir.dec_deg();
+        }
+        else {
+            lng[i] = dir.l_deg();
+            lat[i] = dir.b_deg();
+        }
+
+    } // endfor: looped over coordinates
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                            Protected methods                            =
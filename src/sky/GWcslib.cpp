@@ -30,6 +30,7 @@
 #endif
 #include <cstdlib>
 #include <cmath>
+#include <limits>
 #include "GException.hpp"
 #include "GTools.hpp"
 #include "GMath.hpp"
@@ -57,6 +58,7 @@
 
 /* __ Coding definitions _________________________________________________ */
 //#define G_LIN_MATINV_FORCE_PC                             // Force PC usage
+#define G_WCS_BLOCK_SIZE 1024   //!< Number of coordinates transformed at once
 
 /* __ Debug definitions __________________________________________________ */
 //#define G_DIR2XY_DEBUG                                      // Debug dir2xy
@@ -643,6 +645,125 @@ GSkyPixel GWcslib::dir2xy(const GSkyDir& dir) const
 }
 
 
+/***********************************************************************//**
+ * @brief Transform world coordinates into pixel coordinates
+ *
+ * @param[in] n Number of coordinates.
+ * @param[in] lng Array [n] of longitudes in WCS coordinate system (deg).
+ * @param[in] lat Array [n] of latitudes in WCS coordinate system (deg).
+ * @param[out] x Array [n] of x pixel coordinates (starting from 0).
+ * @param[out] y Array [n] of y pixel coordinates (starting from 0).
+ *
+ * Transforms an array of world coordinates into pixel coordinates. The
+ * coordinates are passed in blocks of G_WCS_BLOCK_SIZE through the
+ * vectorised celestial, projection and linear transformations, which
+ * avoids the overhead of transforming each coordinate individually. Pixel
+ * coordinates of world coordinates that can not be projected are set to
+ * NaN.
+ ***************************************************************************/
+void GWcslib::world2xy(const int& n, const double* lng, const double* lat,
+                       double* x, double* y) const
+{
+    // Allocate memory for transformation
+    std::vector<double> world(2*G_WCS_BLOCK_SIZE);
+    std::vector<double> imgcrd(2*G_WCS_BLOCK_SIZE);
+    std::vector<double> pixcrd(2*G_WCS_BLOCK_SIZE);
+    std::vector<double> phi(G_WCS_BLOCK_SIZE);
+    std::vector<double> theta(G_WCS_BLOCK_SIZE);
+    std::vector<int>    stat(G_WCS_BLOCK_SIZE);
+
+    // Loop over blocks of coordinates
+    for (int start = 0; start < n; start += G_WCS_BLOCK_SIZE) {
+
+        // Determine number of coordinates in block
+        int num = (n-start < G_WCS_BLOCK_SIZE) ? n-start : G_WCS_BLOCK_SIZE;
+
+        // Set world coordinates
+        for (int i = 0, k = 0; i < num; ++i, k += 2) {
+            world[k]   = lng[start+i];
+            world[k+1] = lat[start+i];
+        }
+
+        // Transform world-to-pixel coordinates
+        wcs_s2p(num, 2, &(world[0]), &(phi[0]), &(theta[0]), &(imgcrd[0]),
+                &(pixcrd[0]), &(stat[0]));
+
+        // Set pixel coordinates. We have to subtract 1 here as pixels
+        // start from zero while the WCS reference (CRPIX) starts from one.
+        // Coordinates that could not be projected are set to NaN.
+        for (int i = 0, k = 0; i < num; ++i, k += 2) {
+            if (stat[i] == 0) {
+                x[start+i] = pixcrd[k]   - 1.0;
+                y[start+i] = pixcrd[k+1] - 1.0;
+            }
+            else {
+                x[start+i] = std::numeric_limits<double>::quiet_NaN();
+                y[start+i] = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+
+    } // endfor: looped over blocks
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Transform pixel coordinates into world coordinates
+ *
+ * @param[in] n Number of coordinates.
+ * @param[in] x Array [n] of x pixel coordinates (starting from 0).
+ * @param[in] y Array [n] of y pixel coordinates (starting from 0).
+ * @param[out] lng Array [n] of longitudes in WCS coordinate system (deg).
+ * @param[out] lat Array [n] of latitudes in WCS coordinate system (deg).
+ *
+ * Transforms an array of pixel coordinates into world coordinates. The
+ * coordinates are passed in blocks of G_WCS_BLOCK_SIZE through the
+ * vectorised linear, projection and celestial transformations, which
+ * avoids the overhead of transforming each coordinate individually.
+ ***************************************************************************/
+void GWcslib::xy2world(const int& n, const double* x, const double* y,
+                       double* lng, double* lat) const
+{
+    // Allocate memory for transformation
+    std::vector<double> pixcrd(2*G_WCS_BLOCK_SIZE);
+    std::vector<double> imgcrd(2*G_WCS_BLOCK_SIZE);
+    std::vector<double> world(2*G_WCS_BLOCK_SIZE);
+    std::vector<double> phi(G_WCS_BLOCK_SIZE);
+    std::vector<double> theta(G_WCS_BLOCK_SIZE);
+    std::vector<int>    stat(G_WCS_BLOCK_SIZE);
+
+    // Loop over blocks of coordinates
+    for (int start = 0; start < n; start += G_WCS_BLOCK_SIZE) {
+
+        // Determine number of coordinates in block
+        int num = (n-start < G_WCS_BLOCK_SIZE) ? n-start : G_WCS_BLOCK_SIZE;
+
+        // Set pixel coordinates. We have to add 1 here as the WCS pixel
+        // reference (CRPIX) starts from one while pixels start from 0.
+        for (int i = 0, k = 0; i < num; ++i, k += 2) {
+            pixcrd[k]   = x[start+i] + 1.0;
+            pixcrd[k+1] = y[start+i] + 1.0;
+        }
+
+        // Transform pixel-to-world coordinates
+        wcs_p2s(num, 2, &(pixcrd[0]), &(imgcrd[0]), &(phi[0]), &(theta[0]),
+                &(world[0]), &(stat[0]));
+
+        // Set world coordinates
+        for (int i = 0, k = 0; i < num; ++i, k += 2) {
+            lng[start+i] = world[k];
+            lat[start+i] = world[k+1];
+        }
+
+    } // endfor: looped over blocks
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Set World Coordinate System parameters
  *
@@ -0,0 +1,375 @@
+/***************************************************************************
+ *              GAliasTable.cpp - Alias table sampling class               *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GAliasTable.cpp
+ * @brief Alias table sampling class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include "GException.hpp"
+#include "GAliasTable.hpp"
+#include "GTools.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+#define G_SET                              "GAliasTable::set(double*, int&)"
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+/* __ Constants __________________________________________________________ */
+
+
+/*==========================================================================
+ =                                                                         =
+ =                        Constructors/destructors                         =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GAliasTable::GAliasTable(void)
+{
+    // Initialise members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Weights constructor
+ *
+ * @param[in] weights Weights.
+ ***************************************************************************/
+GAliasTable::GAliasTable(const std::vector<double>& weights)
+{
+    // Initialise members
+    init_members();
+
+    // Set table
+    set(weights);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] table Alias table.
+ ***************************************************************************/
+GAliasTable::GAliasTable(const GAliasTable& table)
+{
+    // Initialise members
+    init_members();
+
+    // Copy members
+    copy_members(table);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GAliasTable::~GAliasTable(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                               Operators                                 =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] table Alias table.
+ * @return Alias table.
+ ***************************************************************************/
+GAliasTable& GAliasTable::operator=(const GAliasTable& table)
+{
+    // Execute only if object is not identical
+    if (this != &table) {
+
+        // Free members
+        free_members();
+
+        // Initialise private members for clean destruction
+        init_members();
+
+        // Copy members
+        copy_members(table);
+
+    } // endif: object was not identical
+
+    // Return this object
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear alias table
+ ***************************************************************************/
+void GAliasTable::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise private members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone alias table
+ *
+ * @return Pointer to deep copy of alias table.
+ ***************************************************************************/
+GAliasTable* GAliasTable::clone(void) const
+{
+    return new GAliasTable(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Set alias table from weights
+ *
+ * @param[in] weights Weights.
+ *
+ * @see set(const double*, const int&)
+ ***************************************************************************/
+void GAliasTable::set(const std::vector<double>& weights)
+{
+    // Set table
+    int number = weights.size();
+    set((number > 0) ? &(weights[0]) : NULL, number);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set alias table from weights
+ *
+ * @param[in] weights Array of weights.
+ * @param[in] number Number of weights.
+ *
+ * @exception GException::invalid_argument
+ *            Negative number of weights or negative weight encountered.
+ *
+ * Sets the alias table for the discrete probability distribution that is
+ * proportional to the weights. The weights do not need to be normalised.
+ * If the sum of the weights is zero the table is left empty.
+ *
+ * The table is built using the method of Vose (1991). The weights are
+ * scaled so that their mean is one, and are split into columns with a
+ * scaled weight below one ("small") and columns with a scaled weight of
+ * at least one ("large"). Each small column is then filled up with the
+ * excess of a large column, which becomes the alias of the small column.
+ * Columns that remain at the end (due to rounding) get a probability of
+ * one.
+ ***************************************************************************/
+void GAliasTable::set(const double* weights, const int& number)
+{
+    // Clear table
+    m_prob.clear();
+    m_alias.clear();
+
+    // Throw an exception if the number of weights is negative
+    if (number < 0) {
+        std::string msg = "Negative number of weights "+
+                          gammalib::str(number)+" specified.";
+        throw GException::invalid_argument(G_SET, msg);
+    }
+
+    // Compute sum of weights and check that weights are not negative
+    double sum = 0.0;
+    for (int i = 0; i < number; ++i) {
+        if (weights[i] < 0.0) {
+            std::string msg = "Negative weight "+gammalib::str(weights[i])+
+                              " encountered for index "+gammalib::str(i)+".";
+            throw GException::invalid_argument(G_SET, msg);
+        }
+        sum += weights[i];
+    }
+
+    // Continue only if sum is positive
+    if (sum > 0.0) {
+
+        // Allocate table
+        m_prob.assign(number, 1.0);
+        m_alias.resize(number);
+
+        // Compute scaled weights and split them into small and large
+        // columns
+        std::vector<double> scaled(number);
+        std::vector<int>    small;
+        std::vector<int>    large;
+        small.reserve(number);
+        large.reserve(number);
+        double scale = double(number) / sum;
+        for (int i = 0; i < number; ++i) {
+            scaled[i]  = weights[i] * scale;
+            m_alias[i] = i;
+            if (scaled[i] < 1.0) {
+                small.push_back(i);
+            }
+            else {
+                large.push_back(i);
+            }
+        }
+
+        // Fill up small columns with excess of large columns
+        while (!small.empty() && !large.empty()) {
+            int s = small.back();
+            int l = large.back();
+            small.pop_back();
+            m_prob[s]  = scaled[s];
+            m_alias[s] = l;
+            scaled[l]  = (scaled[l] + scaled[s]) - 1.0;
+            if (scaled[l] < 1.0) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+
+        // Remaining columns have a probability of one (they were already
+        // initialised). Columns can only remain due to rounding errors.
+
+    } // endif: sum was positive
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Print alias table information
+ *
+ * @param[in] chatter Chattiness (defaults to NORMAL).
+ * @return String containing alias table information.
+ ***************************************************************************/
+std::string GAliasTable::print(const GChatter& chatter) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Continue only if chatter is not silent
+    if (chatter != SILENT) {
+
+        // Append header
+        result.append("=== GAliasTable ===");
+
+        // Append information
+        result.append("\n"+gammalib::parformat("Number of columns"));
+        result.append(gammalib::str(size()));
+
+        // EXPLICIT: Append columns
+        if (chatter >= EXPLICIT) {
+            for (int i = 0; i < size(); ++i) {
+                result.append("\n"+gammalib::parformat("Column "+
+                              gammalib::str(i)));
+                result.append("p="+gammalib::str(m_prob[i]));
+                result.append(" alias="+gammalib::str(m_alias[i]));
+            }
+        }
+
+    } // endif: chatter was not silent
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Private methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GAliasTable::init_members(void)
+{
+    // Initialise members
+    m_prob.clear();
+    m_alias.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] table Alias table.
+ ***************************************************************************/
+void GAliasTable::copy_members(const GAliasTable& table)
+{
+    // Copy members
+    m_prob  = table.m_prob;
+    m_alias = table.m_alias;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GAliasTable::free_members(void)
+{
+    // Return
+    return;
+}
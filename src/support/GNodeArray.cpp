@@ -37,6 +37,7 @@
 #define G_ACCESS                                "GNodeArray::operator[](int)"
 #define G_INTERPOLATE "GNodeArray::interpolate(double&,std::vector<double>&)"
 #define G_SET_VALUE                          "GNodeArray::set_value(double&)"
+#define G_LOCATE                                "GNodeArray::locate(double&)"
 #define G_SETUP                                         "GNodeArray::setup()"
 
 /* __ Macros _____________________________________________________________ */
@@ -236,9 +237,6 @@ const double& GNodeArray::operator[](const int& index) const
     }
     #endif
 
-    // Signal that setup needs to be called
-    m_need_setup = false;
-
     // Return node
     return m_node[index];
 }
@@ -390,7 +388,9 @@ void GNodeArray::append(const double& node)
  *            Size of node vector does not match the size of vector argument.
  *
  * This method performs a linear interpolation of values \f$y_i\f$. The
- * corresponding values \f$x_i\f$ are stored in the node array.
+ * corresponding values \f$x_i\f$ are stored in the node array. The method
+ * does not modify the node array and may therefore be called concurrently
+ * by several threads.
  ***************************************************************************/
 double GNodeArray::interpolate(const double& value,
                                const std::vector<double>& vector) const
@@ -406,12 +406,12 @@ double GNodeArray::interpolate(const double& value,
                                           vector.size());
     }
     
-    // Set interpolation value (circumvent const correctness)
-    set_value(value);
+    // Get interpolation handle
+    handle h = locate(value);
 
     // Interpolate
-    double y = vector[inx_left()]  * wgt_left() +
-               vector[inx_right()] * wgt_right();
+    double y = vector[h.m_inx_left]  * h.m_wgt_left +
+               vector[h.m_inx_right] * h.m_wgt_right;
 
     // Return
     return y;
@@ -434,20 +434,15 @@ double GNodeArray::interpolate(const double& value,
  ***************************************************************************/
 void GNodeArray::set_value(const double& value) const
 {
-    // Get number of nodes
-    int nodes = m_node.size();
-
     // Throw an exception if less than 2 nodes are available
-    if (nodes < 2) {
-        throw GException::not_enough_nodes(G_SET_VALUE, nodes);
+    if (m_node.size() < 2) {
+        throw GException::not_enough_nodes(G_SET_VALUE, m_node.size());
     }
 
-    // Initialize computation flag
-    bool compute = true;
-
     // Update cache if required. If cache was updated, computation is
     // enforced. Otherwise we check if the value has changed. The value
     // check is only done when a last value has been recorded.
+    bool compute = true;
     if (m_need_setup) {
         setup();
     }
@@ -460,67 +455,114 @@ void GNodeArray::set_value(const double& value) const
     // Continue only if computation is required
     if (compute) {
 
-        // If array is linear then get left index from analytic formula
-        if (m_is_linear) {
+        // Get interpolation handle
+        handle h = locate(value);
 
-            // Set left index
-            m_inx_left = int(m_linear_slope * value + m_linear_offset);
-        
-            // Keep index in valid range
-            if (m_inx_left < 0) {
-                m_inx_left = 0;
-            }
-            else if (m_inx_left >= nodes-1) {
-                m_inx_left = nodes - 2;
-            }
+        // Store indices and weighting factors
+        m_inx_left  = h.m_inx_left;
+        m_inx_right = h.m_inx_right;
+        m_wgt_left  = h.m_wgt_left;
+        m_wgt_right = h.m_wgt_right;
 
-        } // endif: array is linear
+    } // endif: computation was required
 
-        // ... otherwise search the relevant indices by bisection
-        else {
-    
-            // Set left index if value is before first node
-            if (value < m_node[0]) {
-                m_inx_left = 0;
-            }
+    // Store last value and signal availability
+    m_last_value     = value;
+    m_has_last_value = true;
 
-            // Set left index if value is after last node
-            else if (value >  m_node[nodes-1]) {
-                m_inx_left = nodes - 2;
-            }
+    // Return
+    return;
+}
 
-            // Set left index by bisection
-            else {
-                int low  = 0;
-                int high = nodes - 1;
-                while ((high - low) > 1) {
-                    int mid = (low+high) / 2;
-                    if (m_node[mid] > value) {
-                        high = mid;
-                    }
-                    else {
-                        low = mid;
-                    }
-                }
-                m_inx_left = low;
-            } // endelse: did bisection
+
+/***********************************************************************//**
+ * @brief Return interpolation handle for a value
+ *
+ * @param[in] value Value for which the interpolation should be done.
+ * @return Interpolation handle.
+ *
+ * @exception GException::not_enough_nodes
+ *            At least two nodes are required for setting up the factors
+ *
+ * Returns the indices that bound the specified value and the corresponding
+ * weighting factors for linear interpolation in an interpolation handle.
+ * If the array has a linear form (i.e. the nodes are equidistant), an
+ * analytic formula is used to determine the boundary indices. If the nodes
+ * are not equidistant the boundary indices are searched by bisection.
+ *
+ * Contrary to set_value(), the method does not modify the node array and
+ * may therefore be called concurrently by several threads.
+ ***************************************************************************/
+GNodeArray::handle GNodeArray::locate(const double& value) const
+{
+    // Get number of nodes
+    int nodes = m_node.size();
+
+    // Throw an exception if less than 2 nodes are available
+    if (nodes < 2) {
+        throw GException::not_enough_nodes(G_LOCATE, nodes);
+    }
+
+    // Initialise interpolation handle
+    handle h;
+
+    // If array is linear then get left index from analytic formula. The
+    // analytic formula is only used if the precomputed values are valid.
+    if (m_is_linear && !m_need_setup) {
+
+        // Set left index
+        h.m_inx_left = int(m_linear_slope * value + m_linear_offset);
+
+        // Keep index in valid range
+        if (h.m_inx_left < 0) {
+            h.m_inx_left = 0;
+        }
+        else if (h.m_inx_left >= nodes-1) {
+            h.m_inx_left = nodes - 2;
+        }
+
+    } // endif: array is linear
+
+    // ... otherwise search the relevant indices by bisection
+    else {
+
+        // Set left index if value is before first node
+        if (value < m_node[0]) {
+            h.m_inx_left = 0;
         }
 
-        // Set right index
-        m_inx_right = m_inx_left + 1;
+        // Set left index if value is after last node
+        else if (value >  m_node[nodes-1]) {
+            h.m_inx_left = nodes - 2;
+        }
 
-        // Set weighting factors
-        m_wgt_right = (value - m_node[m_inx_left]) / m_step[m_inx_left];
-        m_wgt_left  = 1.0 - m_wgt_right;
+        // Set left index by bisection
+        else {
+            int low  = 0;
+            int high = nodes - 1;
+            while ((high - low) > 1) {
+                int mid = (low+high) / 2;
+                if (m_node[mid] > value) {
+                    high = mid;
+                }
+                else {
+                    low = mid;
+                }
+            }
+            h.m_inx_left = low;
+        } // endelse: did bisection
+    }
 
-    } // endif: computation was required
+    // Set right index
+    h.m_inx_right = h.m_inx_left + 1;
 
-    // Store last value and signal availability
-    m_last_value     = value;
-    m_has_last_value = true;
+    // Set weighting factors
+    h.m_wgt_right = (value - m_node[h.m_inx_left]) /
+                    (m_node[h.m_inx_right] - m_node[h.m_inx_left]);
+    h.m_wgt_left  = 1.0 - h.m_wgt_right;
 
-    // Return
-    return;
+    // Return interpolation handle
+    return h;
 }
 
 
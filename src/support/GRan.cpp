@@ -35,6 +35,8 @@
 #include "GException.hpp"
 
 /* __ Method name definitions ____________________________________________ */
+#define G_UNIFORM_ARRAY                         "GRan::uniform(double*, int&)"
+#define G_POISSON_ARRAY               "GRan::poisson(double*, double*, int&)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -44,6 +46,9 @@
 
 /* __ Constants __________________________________________________________ */
 
+/* __ Prototypes _________________________________________________________ */
+static unsigned long long int splitmix64(unsigned long long int x);
+
 
 /*==========================================================================
  =                                                                         =
@@ -197,6 +202,34 @@ void GRan::seed(unsigned long long int seed)
 }
 
 
+/***********************************************************************//**
+ * @brief Return random number stream
+ *
+ * @param[in] id Stream identifier.
+ * @return Random number generator for stream.
+ *
+ * Returns a random number generator for the stream with the specified
+ * identifier. The seed of the stream is derived by hashing the seed of
+ * the generator together with the stream identifier using the SplitMix64
+ * finaliser, so that streams with neighbouring identifiers are
+ * uncorrelated.
+ *
+ * The stream only depends on the generator seed and the identifier, but
+ * not on the random numbers that have already been drawn from the
+ * generator. Streams may hence be created in any order and from any
+ * thread, and a given stream always delivers the same sequence of random
+ * numbers. Streams can again be split into sub-streams.
+ ***************************************************************************/
+GRan GRan::stream(const unsigned long long int& id) const
+{
+    // Derive stream seed from generator seed and stream identifier
+    unsigned long long int seed = splitmix64(m_seed ^ splitmix64(id));
+
+    // Return random number generator for stream
+    return (GRan(seed));
+}
+
+
 /***********************************************************************//**
  * @brief Return 32-bit random unsigned integer
  *
@@ -249,6 +282,38 @@ double GRan::uniform(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Fill array with uniform random values in range 0 to 1
+ *
+ * @param[out] values Array of random values.
+ * @param[in] number Number of random values.
+ *
+ * @exception GException::invalid_argument
+ *            Negative number of values specified.
+ *
+ * Fills an array with @p number random values in the range 0 to 1. The
+ * values are identical to those obtained by calling uniform() @p number
+ * times.
+ ***************************************************************************/
+void GRan::uniform(double* values, const int& number)
+{
+    // Throw an exception if the number of values is negative
+    if (number < 0) {
+        std::string msg = "Negative number of values "+gammalib::str(number)+
+                          " specified.";
+        throw GException::invalid_argument(G_UNIFORM_ARRAY, msg);
+    }
+
+    // Fill array
+    for (int i = 0; i < number; ++i) {
+        values[i] = 5.42101086242752217e-20 * int64();
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns exponential deviates
  *
@@ -338,6 +403,42 @@ double GRan::poisson(const double& lambda)
 }
 
 
+/***********************************************************************//**
+ * @brief Fill array with Poisson deviates
+ *
+ * @param[in] lambda Array of expectation values.
+ * @param[out] values Array of Poisson deviates.
+ * @param[in] number Number of values.
+ *
+ * @exception GException::invalid_argument
+ *            Negative number of values specified.
+ *
+ * Fills an array with Poisson deviates for an array of expectation values,
+ * such as the model values of all bins of a counts cube. The deviates are
+ * identical to those obtained by calling poisson() for each expectation
+ * value in turn, except for expectation values that are not positive.
+ * These result in a deviate of zero without drawing any random number, so
+ * that empty bins do not consume random numbers.
+ ***************************************************************************/
+void GRan::poisson(const double* lambda, double* values, const int& number)
+{
+    // Throw an exception if the number of values is negative
+    if (number < 0) {
+        std::string msg = "Negative number of values "+gammalib::str(number)+
+                          " specified.";
+        throw GException::invalid_argument(G_POISSON_ARRAY, msg);
+    }
+
+    // Fill array
+    for (int i = 0; i < number; ++i) {
+        values[i] = (lambda[i] > 0.0) ? poisson(lambda[i]) : 0.0;
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns Chi2 deviates for 2 degrees of freedom
  *
@@ -455,3 +556,30 @@ void GRan::free_members(void)
     // Return
     return;
 }
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Static functions                            =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief SplitMix64 hash function
+ *
+ * @param[in] x Value to be hashed.
+ * @return Hashed value.
+ *
+ * Implements the SplitMix64 finaliser of Steele, Lea & Flood (2014), which
+ * maps a 64-bit value on a well mixed 64-bit value.
+ ***************************************************************************/
+static unsigned long long int splitmix64(unsigned long long int x)
+{
+    // Mix bits
+    x += 0x9e3779b97f4a7c15ULL;
+    x  = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x  = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+
+    // Return hashed value
+    return (x ^ (x >> 31));
+}
@@ -26,6 +26,8 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <cmath>
+#include <algorithm>
+#include <vector>
 #include <cstdlib>        // for system
 #include "GTools.hpp"
 #include "test_GFits.hpp"
@@ -298,6 +300,7 @@ void TestGFits::set(void)
     append(static_cast<pfunction>(&TestGFits::test_bintable_ulong), "Test bintable ulong");
     append(static_cast<pfunction>(&TestGFits::test_bintable_long), "Test bintable long");
     append(static_cast<pfunction>(&TestGFits::test_bintable_longlong), "Test bintable longlong");
+    append(static_cast<pfunction>(&TestGFits::test_mmap), "Test memory mapped reading");
 
     // Return
     return;
@@ -1384,6 +1387,200 @@ void TestGFits::test_bintable_bit(void)
 }
 
 
+/***************************************************************************
+ * @brief Test memory mapped reading of FITS data
+ *
+ * Writes floating point images and a binary table into a FITS file and
+ * into a gzip compressed copy of that file. Unscaled floating point data
+ * of the uncompressed file are read through memory mapping, while all data
+ * of the compressed file, scaled data and integer data are read through
+ * cfitsio. The test verifies that both files provide the same values, for
+ * full images and columns as well as for blocks of rows read using
+ * GFitsTableCol::read_rows().
+ ***************************************************************************/
+void TestGFits::test_mmap(void)
+{
+    // Set filenames
+    std::string filename   = "test_mmap.fits";
+    std::string compressed = "test_mmap.fits.gz";
+
+    // Remove FITS files
+    std::string cmd = "rm -rf "+ filename + " " + compressed;
+    system(cmd.c_str());
+
+    // Set image and table dimensions
+    const int nx    = 10;
+    const int ny    = 8;
+    const int nz    = 3;
+    const int npix  = nx * ny * nz;
+    const int nrows = 1000;
+    const int nvec  = 4;
+
+    // Write FITS file and gzip compressed copy
+    test_try("Write FITS files");
+    try {
+        // Set images. The third image is scaled by BSCALE
+        GFitsImageFloat  image_float(nx, ny, nz);
+        GFitsImageDouble image_double(nx, ny, nz);
+        GFitsImageDouble image_scaled(nx, ny, nz);
+        for (int i = 0; i < npix; ++i) {
+            image_float(i % nx, (i / nx) % ny, i / (nx*ny))  = float(i) * 0.37 - 11.0;
+            image_double(i % nx, (i / nx) % ny, i / (nx*ny)) = double(i) * 1.37e-3 + 1.0e5;
+            image_scaled(i % nx, (i / nx) % ny, i / (nx*ny)) = double(i) * 2.0;
+        }
+        image_scaled.card("BSCALE", 2.0, "Pixel scaling");
+
+        // Set table columns. The last column is scaled by TSCAL5
+        GFitsTableFloatCol  col_float("FLOAT", nrows);
+        GFitsTableDoubleCol col_double("DOUBLE", nrows);
+        GFitsTableDoubleCol col_vector("VECTOR", nrows, nvec);
+        GFitsTableShortCol  col_short("SHORT", nrows);
+        GFitsTableDoubleCol col_scaled("SCALED", nrows);
+        for (int i = 0; i < nrows; ++i) {
+            col_float(i)  = float(i) * 3.57 + 1.29;
+            col_double(i) = double(i) * 1.0e-7 + 5.0e8;
+            for (int k = 0; k < nvec; ++k) {
+                col_vector(i,k) = double(i*nvec+k) * 0.25 - 99.0;
+            }
+            col_short(i)  = short(i % 300);
+            col_scaled(i) = double(i) * 2.0;
+        }
+        GFitsBinTable table(nrows);
+        table.append_column(col_float);
+        table.append_column(col_double);
+        table.append_column(col_vector);
+        table.append_column(col_short);
+        table.append_column(col_scaled);
+        table.card("TSCAL5", 2.0, "Column scaling");
+
+        // Save FITS file
+        GFits fits;
+        fits.open(filename, true);
+        fits.append(image_float);
+        fits.append(image_double);
+        fits.append(image_scaled);
+        fits.append(table);
+        fits.save();
+        fits.close();
+
+        // Create gzip compressed copy
+        cmd = "gzip -c "+ filename + " > " + compressed;
+        system(cmd.c_str());
+
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Compare images and columns of both files
+    test_try("Compare memory mapped and cfitsio reading");
+    try {
+        GFits mapped(filename);
+        GFits cfitsio(compressed);
+
+        // Check that unscaled images have the expected values, and that
+        // all images agree with cfitsio
+        double diff_float  = 0.0;
+        double diff_double = 0.0;
+        double diff_images = 0.0;
+        for (int i = 0; i < npix; ++i) {
+            int    ix         = i % nx;
+            int    iy         = (i / nx) % ny;
+            int    iz         = i / (nx*ny);
+            float  pix_float  = float(i) * 0.37 - 11.0;
+            double pix_double = double(i) * 1.37e-3 + 1.0e5;
+            diff_float  = std::max(diff_float,
+                          std::abs(mapped.image(0)->pixel(ix,iy,iz) - pix_float));
+            diff_double = std::max(diff_double,
+                          std::abs(mapped.image(1)->pixel(ix,iy,iz) - pix_double));
+            for (int hdu = 0; hdu < 3; ++hdu) {
+                diff_images = std::max(diff_images,
+                              std::abs(mapped.image(hdu)->pixel(ix,iy,iz) -
+                                       cfitsio.image(hdu)->pixel(ix,iy,iz)));
+            }
+        }
+        test_value(diff_float, 0.0, 0.0, "Check float image pixels");
+        test_value(diff_double, 0.0, 0.0, "Check double image pixels");
+        test_value(diff_images, 0.0, 0.0, "Compare image pixels with cfitsio");
+
+        // Check that unscaled columns have the expected values
+        GFitsTable* table    = mapped.table(3);
+        double      diff_col = 0.0;
+        for (int i = 0; i < nrows; ++i) {
+            float val_float = float(i) * 3.57 + 1.29;
+            diff_col = std::max(diff_col,
+                       std::abs((*table)["FLOAT"].real(i) - val_float));
+            diff_col = std::max(diff_col,
+                       std::abs((*table)["DOUBLE"].real(i) -
+                                (double(i) * 1.0e-7 + 5.0e8)));
+            for (int k = 0; k < nvec; ++k) {
+                diff_col = std::max(diff_col,
+                           std::abs((*table)["VECTOR"].real(i,k) -
+                                    (double(i*nvec+k) * 0.25 - 99.0)));
+            }
+        }
+        test_value(diff_col, 0.0, 0.0, "Check column values");
+
+        // Check that all columns agree with cfitsio
+        GFitsTable* ref = cfitsio.table(3);
+        for (int col = 0; col < table->ncols(); ++col) {
+            const GFitsTableCol& column     = (*table)[col];
+            const GFitsTableCol& ref_column = (*ref)[col];
+            double               diff       = 0.0;
+            for (int i = 0; i < nrows; ++i) {
+                for (int k = 0; k < column.number(); ++k) {
+                    diff = std::max(diff, std::abs(column.real(i,k) -
+                                                   ref_column.real(i,k)));
+                }
+            }
+            test_value(diff, 0.0, 0.0, "Compare column "+column.name()+
+                                       " with cfitsio");
+        }
+
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Compare blocks of rows read from both files
+    test_try("Compare memory mapped and cfitsio reading of rows");
+    try {
+        GFits mapped(filename);
+        GFits cfitsio(compressed);
+        GFitsTable* table = mapped.table(3);
+        GFitsTable* ref   = cfitsio.table(3);
+        for (int col = 0; col < table->ncols(); ++col) {
+            const GFitsTableCol& column     = (*table)[col];
+            const GFitsTableCol& ref_column = (*ref)[col];
+            int                  number     = column.number();
+            double               diff       = 0.0;
+            for (int row = 0; row < nrows; row += 300) {
+                int                 n = (row+300 > nrows) ? nrows-row : 300;
+                std::vector<double> values(n*number);
+                std::vector<double> ref_values(n*number);
+                column.read_rows(row, n, &(values[0]));
+                ref_column.read_rows(row, n, &(ref_values[0]));
+                for (int i = 0; i < n*number; ++i) {
+                    diff = std::max(diff, std::abs(values[i] - ref_values[i]));
+                }
+            }
+            test_value(diff, 0.0, 0.0, "Compare rows of column "+
+                                       column.name()+" with cfitsio");
+        }
+
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Return
+    return;
+}
+
+
 /***************************************************************************
  * @brief Main entry point for test executable
  ***************************************************************************/
@@ -64,6 +64,7 @@ public:
     void         test_bintable_ulong(void);
     void         test_bintable_long(void);
     void         test_bintable_longlong(void);
+    void         test_mmap(void);
 };
 
 #endif /* TEST_GFITS_HPP */
@@ -1201,6 +1201,43 @@ void TestGMatrixSparse::matrix_cholesky(void)
     test_value(res, 0.0, 1.0e-15, 
                "Test unsymmetric compressed cholesky_solver() method - 5");
 
+    // Test Cholesky solver for multiple right-hand sides. Each column of
+    // the solution needs to be identical to the solution for the column
+    // of the right-hand side.
+    GMatrix rhs(6, 40);
+    for (int col = 0; col < rhs.columns(); ++col) {
+        for (int row = 0; row < rhs.rows(); ++row) {
+            rhs(row,col) = 0.1 * (row + 1) + 0.01 * col;
+        }
+    }
+    GMatrix sm = cd_zero.cholesky_solver(rhs);
+    res = 0.0;
+    for (int col = 0; col < rhs.columns(); ++col) {
+        GVector sv = cd_zero.cholesky_solver(rhs.column(col));
+        for (int row = 0; row < sv.size(); ++row) {
+            double diff = std::abs(sm(row,col) - sv[row]);
+            if (diff > res) {
+                res = diff;
+            }
+        }
+    }
+    test_value(res, 0.0, 0.0,
+               "Test compressed cholesky_solver() method for matrix");
+    GMatrix sm2 = cd_zero2.cholesky_solver(rhs);
+    res = 0.0;
+    for (int col = 0; col < rhs.columns(); ++col) {
+        GVector sv = cd_zero2.cholesky_solver(rhs.column(col));
+        for (int row = 0; row < sv.size(); ++row) {
+            double diff = std::abs(sm2(row,col) - sv[row]);
+            if (diff > res) {
+                res = diff;
+            }
+        }
+    }
+    test_value(res, 0.0, 0.0,
+               "Test unsymmetric compressed cholesky_solver() method for"
+               " matrix");
+
 	// Test Cholesky inverter (inplace)
 	GMatrixSparse unit(5,5);
 	unit(0,0) = 1.0;
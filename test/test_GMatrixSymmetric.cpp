@@ -539,6 +539,39 @@ void TestGMatrixSymmetric::matrix_arithmetics(void)
         test_try_failure(e);
     }
 
+    // Add outer product of sparse vector
+    double values[] = {2.0, -3.0};
+    int    inx[]    = {0, 2};
+    test = m_test;
+    test.add_outer_product(0.5, values, inx, 2);
+    bool result = true;
+    for (int row = 0; row < g_rows; ++row) {
+        for (int col = 0; col < g_cols; ++col) {
+            double vrow = (row == 0) ? 2.0 : ((row == 2) ? -3.0 : 0.0);
+            double vcol = (col == 0) ? 2.0 : ((col == 2) ? -3.0 : 0.0);
+            double ref  = m_test(row,col) + 0.5 * vrow * vcol;
+            if (std::abs(test(row,col) - ref) > 1.0e-10) {
+                result = false;
+            }
+        }
+    }
+    test_assert(result, "Test GMatrixSymmetric::add_outer_product()",
+                test.print());
+
+    // Test invalid outer product index
+    test_try("Test invalid outer product index");
+    try {
+        int bad[] = {0, g_rows};
+        test.add_outer_product(1.0, values, bad, 2);
+        test_try_failure("Expected GException::out_of_range exception.");
+    }
+    catch (GException::out_of_range &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Return
     return;
 }
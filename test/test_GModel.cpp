@@ -28,6 +28,7 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <cmath>
 #include <iostream>
 #include <ostream>
 #include <stdexcept>
@@ -76,6 +77,7 @@ void TestGModel::set(void)
     add_test(static_cast<pfunction>(&TestGModel::test_diffuse_cube), "Test GModelSpatialDiffuseCube");
     add_test(static_cast<pfunction>(&TestGModel::test_diffuse_map), "Test GModelSpatialDiffuseMap");
     add_test(static_cast<pfunction>(&TestGModel::test_spatial_model), "Test spatial model XML I/O");
+    add_test(static_cast<pfunction>(&TestGModel::test_spatial_gradients), "Test spatial model gradients");
 
     // Add spatial model tests
     add_test(static_cast<pfunction>(&TestGModel::test_const), "Test GModelSpectralConst");
@@ -286,6 +288,40 @@ void TestGModel::test_model_par(void)
         test_try_failure(e);
     }
 
+    // Test version numbers
+    test_try("Test version numbers");
+    try {
+        GModelPar par("Test parameter", 3.0);
+        GModelPar par2 = par;
+        test_assert(par2.version() == par.version(),
+                    "Copied parameter shall have the same version number.");
+        unsigned long version = par.version();
+        par.error(2.0);
+        par.gradient(2.0);
+        test_assert(par.version() == version,
+                    "Version number shall not change when error or"
+                    " gradient are modified.");
+        par.value(4.0);
+        test_assert(par.version() != version,
+                    "Version number shall change when value is modified.");
+        version = par.version();
+        par.fix();
+        test_assert(par.version() != version,
+                    "Version number shall change when parameter is fixed.");
+        version = par.version();
+        par.fix();
+        test_assert(par.version() == version,
+                    "Version number shall not change when a fixed"
+                    " parameter is fixed.");
+        par = par2;
+        test_assert(par.version() == par2.version(),
+                    "Assigned parameter shall have the same version number.");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Exit test
     return;
 }
@@ -1728,6 +1764,58 @@ void TestGModel::test_temp_const(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test analytical gradients of a spatial model
+ *
+ * @param[in] model Spatial model.
+ * @param[in] photon Photon.
+ * @param[in] name Test name.
+ *
+ * Frees all model parameters and compares for each of them the gradient
+ * set by eval_gradients() to a numerical derivative of eval().
+ ***************************************************************************/
+void TestGModel::test_spatial_gradient(GModelSpatial&     model,
+                                       const GPhoton&     photon,
+                                       const std::string& name)
+{
+    // Set step size
+    const double h = 1.0e-5;
+
+    // Free all model parameters
+    for (int i = 0; i < model.size(); ++i) {
+        model[i].free();
+    }
+
+    // Compute analytical gradients
+    double value = model.eval_gradients(photon);
+    test_value(value, model.eval(photon), 1.0e-10, name+" value");
+
+    // Loop over parameters
+    for (int i = 0; i < model.size(); ++i) {
+
+        // Get analytical gradient
+        double grad = model[i].factor_gradient();
+
+        // Compute numerical derivative
+        double x = model[i].factor_value();
+        model[i].factor_value(x + h);
+        double f_plus = model.eval(photon);
+        model[i].factor_value(x - h);
+        double f_minus = model.eval(photon);
+        model[i].factor_value(x);
+        double num = (f_plus - f_minus) / (2.0 * h);
+
+        // Test gradient
+        double eps = 1.0e-4 * (std::abs(num) + std::abs(value));
+        test_value(grad, num, eps, name+" gradient of "+model[i].name());
+
+    } // endfor: looped over parameters
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test XML model.
  *
@@ -1789,6 +1877,43 @@ void TestGModel::test_spatial_model(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test spatial model gradients
+ *
+ * Compares the analytical parameter gradients of the spatial models to
+ * numerical derivatives of the model values.
+ ***************************************************************************/
+void TestGModel::test_spatial_gradients(void)
+{
+    // Set model centre and photon directions
+    GSkyDir centre;
+    GSkyDir inside;
+    GSkyDir shell;
+    centre.radec_deg(83.6331, +22.0145);
+    inside.radec_deg(83.7331, +22.0645);
+    shell.radec_deg(83.6331, +22.3145);
+
+    // Set photons
+    GPhoton photon_inside(inside, GEnergy(1.0, "TeV"), GTime());
+    GPhoton photon_shell(shell, GEnergy(1.0, "TeV"), GTime());
+
+    // Test models
+    GModelSpatialPointSource    point(centre);
+    GModelSpatialRadialGauss    gauss(centre, 0.2);
+    GModelSpatialRadialDisk     disk(centre, 0.5);
+    GModelSpatialRadialShell    shell_model(centre, 0.25, 0.1);
+    GModelSpatialEllipticalDisk ellipse(centre, 0.5, 0.3, 30.0);
+    test_spatial_gradient(point,       photon_inside, "GModelSpatialPointSource");
+    test_spatial_gradient(gauss,       photon_inside, "GModelSpatialRadialGauss");
+    test_spatial_gradient(disk,        photon_inside, "GModelSpatialRadialDisk");
+    test_spatial_gradient(shell_model, photon_shell,  "GModelSpatialRadialShell");
+    test_spatial_gradient(ellipse,     photon_inside, "GModelSpatialEllipticalDisk");
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test spectral model XML reading and writing
  ***************************************************************************/
@@ -1849,6 +1974,77 @@ void TestGModel::test_models(void)
         test_try_failure(e);
     }
 
+    // Test saving and loading of parameter correlations
+    test_try("Test saving and loading of parameter correlations");
+    try {
+        GModels models(m_xml_file);
+        int     npars = models.npars();
+
+        // Free all spatial and spectral parameters and set covariance
+        // matrix with 30% correlation among every other pair of free
+        // parameters
+        GModelSky* sky = dynamic_cast<GModelSky*>(models[0]);
+        test_assert(sky != NULL, "Expected a sky model.");
+        for (int i = 0; i < sky->spatial()->size(); ++i) {
+            (*sky->spatial())[i].free();
+        }
+        for (int i = 0; i < sky->spectral()->size(); ++i) {
+            (*sky->spectral())[i].free();
+        }
+        GMatrixSymmetric covariance(npars, npars);
+        for (int i = 0; i < npars; ++i) {
+            if (models.par(i).isfree()) {
+                models.par(i).factor_error(0.1 * (i+1));
+                covariance(i,i) = models.par(i).error() * models.par(i).error();
+            }
+        }
+        int npairs        = 0;
+        int ncorrelations = 0;
+        for (int i = 0; i < npars; ++i) {
+            for (int j = i+1; j < npars; ++j) {
+                if (models.par(i).isfree() && models.par(j).isfree()) {
+                    if (npairs % 2 == 0) {
+                        covariance(i,j) = 0.3 * models.par(i).error() *
+                                                models.par(j).error();
+                        ncorrelations++;
+                    }
+                    npairs++;
+                }
+            }
+        }
+        test_assert(ncorrelations > 0 && ncorrelations < npairs,
+                    "Expected correlated and uncorrelated parameter pairs.");
+        models.covariance(covariance);
+        models.save("test.xml");
+
+        // Check that only correlated pairs were written
+        GXml xml("test.xml");
+        test_value(xml.element("source_library", 0)->elements("correlation"),
+                   ncorrelations);
+
+        // Load models and check covariance matrix
+        GModels loaded("test.xml");
+        test_value(loaded.covariance().rows(), npars);
+        int nrows = loaded.covariance().rows();
+        for (int i = 0; i < nrows; ++i) {
+            for (int j = i; j < nrows; ++j) {
+                double ref = covariance(i,j);
+                test_value(loaded.covariance()(i,j), ref,
+                           1.0e-5 * std::abs(ref) + 1.0e-30);
+            }
+        }
+
+        // Check that covariance matrix is dropped if models change
+        loaded.remove(0);
+        test_value(loaded.covariance().rows(), 0);
+
+        // Success if we reached this point
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Test model manipulation
     test_try("Test model access");
     try {
@@ -56,6 +56,7 @@ public:
     void    test_radial_shell(void);
     void    test_elliptical_disk(void);
     void    test_spatial_model(void);
+    void    test_spatial_gradients(void);
     void    test_const(void);
     void    test_plaw(void);
     void    test_plaw2(void);
@@ -71,6 +72,9 @@ public:
 private:        
     // Private methods
     void test_xml_model(const std::string& name, const std::string& filename);
+    void test_spatial_gradient(GModelSpatial&     model,
+                               const GPhoton&     photon,
+                               const std::string& name);
     
     // Private attributes
     std::string m_map_file;
@@ -46,6 +46,9 @@ void TestGNumerics::set(void)
     //Unbinned
     add_test(static_cast<pfunction>(&TestGNumerics::test_integral),"Test GIntegral");
     add_test(static_cast<pfunction>(&TestGNumerics::test_romberg_integration),"Test Romberg integration");
+    add_test(static_cast<pfunction>(&TestGNumerics::test_gauss_kronrod_integration),"Test Gauss-Kronrod integration");
+    add_test(static_cast<pfunction>(&TestGNumerics::test_tanh_sinh_integration),"Test tanh-sinh integration");
+    add_test(static_cast<pfunction>(&TestGNumerics::test_fft),"Test fast Fourier transform");
     return;
 }
 
@@ -81,6 +84,110 @@ void TestGNumerics::test_romberg_integration(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test adaptive Gauss-Kronrod integration.
+ ***************************************************************************/
+void TestGNumerics::test_gauss_kronrod_integration(void)
+{
+    Gauss     integrand(m_sigma);
+    GIntegral integral(&integrand);
+    double    result = integral.gkq(-10.0*m_sigma, 10.0*m_sigma);
+    test_value(result,1.0,1.0e-6,"","Gaussian integral is not 1.0 (integral="+gammalib::str(result)+")");
+
+    result = integral.gkq(-m_sigma, m_sigma);
+    test_value(result,0.68268948130801355,1.0e-6,"","Gaussian integral is not 0.682689 (difference="+gammalib::str((result-0.68268948130801355))+")");
+
+    result = integral.gkq(0.0, m_sigma);
+    test_value(result,0.3413447460687748,1.0e-6,"","Gaussian integral is not 0.341345 (difference="+gammalib::str((result-0.3413447460687748))+")");
+
+    // Check that a smooth integrand needs a single rule evaluation
+    test_value(integral.iter(),1,"","Expected a single G7K15 evaluation (iter="+gammalib::str(integral.iter())+")");
+
+    result = integral.gkq(1.0, 1.0);
+    test_value(result,0.0,1.0e-10,"","Empty integration range gives non-zero integral");
+}
+
+
+/***********************************************************************//**
+ * @brief Test tanh-sinh integration.
+ ***************************************************************************/
+void TestGNumerics::test_tanh_sinh_integration(void)
+{
+    Gauss     integrand(m_sigma);
+    GIntegral integral(&integrand);
+    double    result = integral.tanhsinh(-10.0*m_sigma, 10.0*m_sigma);
+    test_value(result,1.0,1.0e-6,"","Gaussian integral is not 1.0 (integral="+gammalib::str(result)+")");
+
+    result = integral.tanhsinh(-m_sigma, m_sigma);
+    test_value(result,0.68268948130801355,1.0e-6,"","Gaussian integral is not 0.682689 (difference="+gammalib::str((result-0.68268948130801355))+")");
+
+    // Integrate function with singularity at boundary
+    InvSqrt   singular;
+    GIntegral integral_singular(&singular);
+    integral_singular.silent(true);
+    result = integral_singular.tanhsinh(0.0, 1.0);
+    test_value(result,2.0,1.0e-5,"","Integral of 1/sqrt(x) over [0,1] is not 2.0 (integral="+gammalib::str(result)+")");
+}
+
+
+/***********************************************************************//**
+ * @brief Test fast Fourier transform.
+ ***************************************************************************/
+void TestGNumerics::test_fft(void)
+{
+    // Test power of two sizes
+    test_value(GFft::size2(1),1,"Size of 1 is not 1");
+    test_value(GFft::size2(5),8,"Size of 5 is not 8");
+    test_value(GFft::size2(16),16,"Size of 16 is not 16");
+
+    // Test invalid dimension
+    test_try("Test invalid dimension");
+    try {
+        GFft fft(6, 4);
+        test_try_failure("Expected GException::invalid_argument exception.");
+    }
+    catch (GException::invalid_argument &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Test forward transform of a constant and backward transform
+    GFft fft(8, 4);
+    for (int iy = 0; iy < 4; ++iy) {
+        for (int ix = 0; ix < 8; ++ix) {
+            fft(ix, iy) = std::complex<double>(double(ix+3*iy), 0.0);
+        }
+    }
+    GFft orig = fft;
+    fft.forward();
+    test_value(fft(0,0).real(),double(4*28+8*18),1.0e-10,"","Zero frequency element is not the sum of all elements");
+    fft.backward();
+    double diff = 0.0;
+    for (int iy = 0; iy < 4; ++iy) {
+        for (int ix = 0; ix < 8; ++ix) {
+            diff += std::abs(fft(ix,iy) - orig(ix,iy));
+        }
+    }
+    test_value(diff,0.0,1.0e-10,"","Backward transform does not recover array");
+
+    // Test cyclic convolution with a shifted delta function
+    GFft signal(16, 16);
+    GFft kernel(16, 16);
+    signal(3, 5) = 2.0;
+    kernel(1, 0) = 0.5;
+    kernel(0, 15) = 0.25;
+    signal.forward();
+    kernel.forward();
+    signal *= kernel;
+    signal.backward();
+    test_value(signal(4,5).real(),1.0,1.0e-10,"","Convolution gives wrong value");
+    test_value(signal(3,4).real(),0.5,1.0e-10,"","Convolution gives wrong value");
+    test_value(signal(3,5).real(),0.0,1.0e-10,"","Convolution gives wrong value");
+}
+
+
 /***********************************************************************//**
  * @brief Main test function.
  ***************************************************************************/
@@ -51,6 +51,21 @@ protected:
     double m_sigma;
 };
 
+
+/***********************************************************************//**
+ * @class InvSqrt
+ *
+ * @brief Inverse square root function (singular at x=0).
+ ***************************************************************************/
+class InvSqrt : public GFunction {
+public:
+    InvSqrt(void) { return; }
+    virtual ~InvSqrt(void) { return; }
+    double eval(double x) {
+        return 1.0/std::sqrt(x);
+    }
+};
+
 class TestGNumerics : public GTestSuite
 {
     public:
@@ -62,6 +77,9 @@ class TestGNumerics : public GTestSuite
         virtual void set(void);
         void test_integral(void);
         void test_romberg_integration(void);
+        void test_gauss_kronrod_integration(void);
+        void test_tanh_sinh_integration(void);
+        void test_fft(void);
 
     // Private attributes
     private:
@@ -28,6 +28,10 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <cmath>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "test_GOptimizer.hpp"
 #include "testinst/GTestLib.hpp"
 
@@ -37,6 +41,103 @@
 #define BINNED    1
 
 
+/***********************************************************************//**
+ * @class TestSpectrumFit
+ *
+ * @brief Poisson likelihood of a binned spectrum
+ *
+ * Optimizer function for testing fits with several parameters. The
+ * function computes the Poisson likelihood of the counts in logarithmic
+ * energy bins for the spectral model of the first sky model in the model
+ * container, and the curvature matrix in the same way as GObservation.
+ ***************************************************************************/
+class TestSpectrumFit : public GOptimizerFunction {
+public:
+    TestSpectrumFit(const GModels& models, const double& exposure,
+                    const int& nbins, GRan& ran) : GOptimizerFunction() {
+        m_exposure = exposure;
+        m_neval    = 0;
+        for (int i = 0; i < nbins; ++i) {
+            GEnergy emin;
+            GEnergy emax;
+            emin.TeV(std::pow(10.0, -1.0 + 3.0 * i / nbins));
+            emax.TeV(std::pow(10.0, -1.0 + 3.0 * (i+1) / nbins));
+            m_emin.push_back(emin);
+            m_emax.push_back(emax);
+        }
+        for (int i = 0; i < nbins; ++i) {
+            m_counts.push_back(ran.poisson(counts(models, i)));
+        }
+    }
+    virtual void eval(const GOptimizerPars& pars) {
+        int              npars = pars.npars();
+        GMatrixSymmetric covar(npars, npars);
+        GVector          grad(npars);
+        m_value    = 0.0;
+        m_gradient = GVector(npars);
+        m_neval++;
+        for (int i = 0; i < m_counts.size(); ++i) {
+            double model = counts(static_cast<const GModels&>(pars), i);
+            for (int k = 0; k < npars; ++k) {
+                grad[k] = pars.par(k).factor_gradient() * exposure(i);
+            }
+            m_value += model - m_counts[i] * std::log(model);
+            for (int k = 0; k < npars; ++k) {
+                m_gradient[k] += (1.0 - m_counts[i] / model) * grad[k];
+                if (curvature()) {
+                    for (int l = k; l < npars; ++l) {
+                        covar(k,l) += m_counts[i] / (model * model) *
+                                      grad[k] * grad[l];
+                    }
+                }
+            }
+        }
+        m_covar = GMatrixSparse(covar);
+        for (int k = 0; k < npars; ++k) {
+            const_cast<GModelPar&>(pars.par(k)).factor_gradient(m_gradient[k]);
+        }
+        return;
+    }
+    virtual double eval_value(const GOptimizerPars& pars) {
+        double value = 0.0;
+        for (int i = 0; i < m_counts.size(); ++i) {
+            double model = spectrum(static_cast<const GModels&>(pars))->
+                           eval(energy(i), GTime()) * exposure(i);
+            value += model - m_counts[i] * std::log(model);
+        }
+        return value;
+    }
+    virtual double         value(void) { return m_value; }
+    virtual GVector*       gradient(void) { return &m_gradient; }
+    virtual GMatrixSparse* covar(void) { return &m_covar; }
+    int                    neval(void) const { return m_neval; }
+private:
+    GModelSpectral* spectrum(const GModels& models) const {
+        return static_cast<const GModelSky*>(models[0])->spectral();
+    }
+    GEnergy energy(const int& i) const {
+        GEnergy eng;
+        eng.MeV(std::sqrt(m_emin[i].MeV() * m_emax[i].MeV()));
+        return eng;
+    }
+    double exposure(const int& i) const {
+        return ((m_emax[i].MeV() - m_emin[i].MeV()) * m_exposure);
+    }
+    double counts(const GModels& models, const int& i) const {
+        return (spectrum(models)->eval_gradients(energy(i), GTime()) *
+                exposure(i));
+    }
+    double               m_exposure;
+    std::vector<GEnergy> m_emin;
+    std::vector<GEnergy> m_emax;
+    std::vector<double>  m_counts;
+    double               m_value;
+    GVector              m_gradient;
+    GMatrixSparse        m_covar;
+    int                  m_neval;
+};
+
+
 /***********************************************************************//**
  * @brief Set parameters and tests
  **************************************************************************/
@@ -48,6 +149,8 @@ void TestGOptimizer::set(void){
     // Append tests
     append(static_cast<pfunction>(&TestGOptimizer::test_unbinned_optimizer), "Test unbinned optimization");
     append(static_cast<pfunction>(&TestGOptimizer::test_binned_optimizer), "Test binned optimization");
+    append(static_cast<pfunction>(&TestGOptimizer::test_event_parallel), "Test event-level parallel likelihood");
+    append(static_cast<pfunction>(&TestGOptimizer::test_lbfgsb_optimizer), "Test L-BFGS-B optimization");
 
     // Return
     return;
@@ -132,6 +235,15 @@ void TestGOptimizer::test_optimizer(const int& mode)
     // Check if value is correct
     test_value(result.factor_value(), RATE, result.factor_error()*3); 
 
+    // Check that the covariance matrix is consistent with the errors
+    const GMatrixSymmetric& covariance = opt.covariance();
+    test_value(covariance.rows(), obs.models().npars());
+    test_value(covariance(0,0), result.factor_error()*result.factor_error(),
+               1.0e-10*covariance(0,0));
+    test_value(obs.models().covariance()(0,0),
+               result.error()*result.error(),
+               1.0e-10*obs.models().covariance()(0,0));
+
     // Return
     return;
 }
@@ -163,6 +275,217 @@ void TestGOptimizer::test_binned_optimizer(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test event-level parallel likelihood
+ *
+ * Evaluates the likelihood of a single unbinned observation using four
+ * threads, so that the events of the observation are distributed over the
+ * threads, and compares the result to the likelihood computed event by
+ * event. The evaluation is then repeated to check that the result is
+ * reproducible. Finally, a fit with additional fixed model components is
+ * done without and with model cache, and the results are compared.
+ ***************************************************************************/
+void TestGOptimizer::test_event_parallel(void)
+{
+    // Use four threads
+    #ifdef _OPENMP
+    int nthreads = omp_get_max_threads();
+    omp_set_num_threads(4);
+    #endif
+
+    // Create Test Model
+    GTestModelData model;
+    GModels        models;
+    models.append(model);
+
+    // Create a single observation
+    GRan ran;
+    ran.seed(0);
+    GTestObservation ob;
+    ob.events(model.generateList(RATE, GTime(0.0), GTime(1800.0), ran));
+    ob.ontime(1800.0);
+    GObservations obs;
+    obs.append(ob);
+    obs.models(models);
+
+    // Evaluate likelihood
+    GObservations::optimizer fct(&obs);
+    fct.eval(obs.models());
+    double value = fct.value();
+
+    // Compute likelihood event by event
+    const GEventList* events = static_cast<const GEventList*>(obs[0]->events());
+    double            ref    = obs[0]->npred(obs.models());
+    for (int i = 0; i < events->size(); ++i) {
+        ref -= std::log(obs[0]->model(obs.models(), *(*events)[i]));
+    }
+
+    // Check likelihood
+    test_value(value, ref, 1.0e-8*std::abs(ref), "Check likelihood value");
+
+    // Check that likelihood is reproducible
+    fct.eval(obs.models());
+    test_assert(fct.value() == value, "Check reproducibility of likelihood",
+                "Likelihood values "+gammalib::str(value)+" and "+
+                gammalib::str(fct.value())+" differ.");
+
+    // Fit a model with additional fixed components without and with model
+    // cache and check that the fit results are identical
+    GModels fixed = models;
+    for (int i = 0; i < 3; ++i) {
+        GTestModelData component(model);
+        component.name("Fixed "+gammalib::str(i));
+        component[0].value(0.37 * (i+1));
+        component[0].fix();
+        fixed.append(component);
+    }
+    double results[2];
+    for (int i = 0; i < 2; ++i) {
+        GObservations    fit;
+        GTestObservation run = ob;
+        run.model_cache(i == 1);
+        fit.append(run);
+        fit.models(fixed);
+        GOptimizerLM opt;
+        fit.optimize(opt);
+        results[i] = (*(fit.models()[0]))[0].value();
+    }
+    test_assert(results[1] == results[0], "Check fit with model cache",
+                "Fitted values "+gammalib::str(results[0])+" and "+
+                gammalib::str(results[1])+" differ.");
+
+    // Restore number of threads
+    #ifdef _OPENMP
+    omp_set_num_threads(nthreads);
+    #endif
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test L-BFGS-B optimizer
+ *
+ * Fits an unbinned observation with the L-BFGS-B optimizer and compares
+ * the result to the Levenberg Marquardt optimizer. The fit is then
+ * repeated with a maximum boundary below the true rate to check that the
+ * boundary is respected. Finally, a binned spectrum is fitted with three
+ * free spectral parameters, one of which is pinned at a boundary, and the
+ * fitted values and errors are compared to those of the Levenberg
+ * Marquardt optimizer.
+ ***************************************************************************/
+void TestGOptimizer::test_lbfgsb_optimizer(void)
+{
+    // Create Test Model
+    GTestModelData model;
+    GModels        models;
+    models.append(model);
+
+    // Create a single observation
+    GRan ran;
+    ran.seed(0);
+    GTestObservation ob;
+    ob.events(model.generateList(RATE, GTime(0.0), GTime(1800.0), ran));
+    ob.ontime(1800.0);
+    GObservations obs;
+    obs.append(ob);
+
+    // Fit with Levenberg Marquardt optimizer
+    obs.models(models);
+    GOptimizerLM lm;
+    obs.optimize(lm);
+    GModelPar ref = (*(obs.models()[0]))[0];
+
+    // Fit with L-BFGS-B optimizer
+    obs.models(models);
+    GOptimizerLBFGSB opt;
+    obs.optimize(opt);
+    GModelPar result = (*(obs.models()[0]))[0];
+
+    // Check result
+    test_assert(opt.status() == G_LBFGSB_CONVERGED, "Check if converged",
+                "Optimizer did not converge");
+    test_value(result.factor_value(), ref.factor_value(),
+               0.01*ref.factor_error(), "Check fitted value");
+    test_value(result.factor_error(), ref.factor_error(),
+               1.0e-3*ref.factor_error(), "Check fitted error");
+    test_value(opt.covariance()(0,0),
+               result.factor_error()*result.factor_error(),
+               1.0e-10*opt.covariance()(0,0), "Check covariance matrix");
+
+    // Fit with a maximum boundary below the true rate
+    GModels bounded = models;
+    bounded.par(0).factor_max(0.5*RATE);
+    obs.models(bounded);
+    obs.optimize(opt);
+    result = (*(obs.models()[0]))[0];
+
+    // Check that boundary is respected
+    test_value(result.factor_value(), 0.5*RATE, 1.0e-10,
+               "Check that value is at boundary");
+
+    // Set up spectrum with three free parameters, and set a maximum
+    // cutoff energy below the true cutoff energy so that the cutoff
+    // energy is pinned at the boundary
+    GModelSpectralExpPlaw plaw(1.0e-16, -2.0, GEnergy(1.0, "TeV"),
+                               GEnergy(10.0, "TeV"));
+    GSkyDir                  dir;
+    GModelSpatialPointSource point(dir);
+    point["RA"].fix();
+    point["DEC"].fix();
+    GModelSky sky(point, plaw);
+    sky.name("Source");
+    GModels spectrum;
+    spectrum.append(sky);
+    TestSpectrumFit fit(spectrum, 3.0e13, 20, ran);
+    GModelSpectral* spectral = static_cast<GModelSky*>(spectrum[0])->spectral();
+    (*spectral)["Cutoff"].value(4.0e6);
+    (*spectral)["Cutoff"].max(5.0e6);
+    (*spectral)["Prefactor"].value(1.2e-16);
+    (*spectral)["Index"].value(-2.1);
+
+    // Fit spectrum with Levenberg Marquardt optimizer
+    GModels spectrum_lm = spectrum;
+    lm.optimize(fit, spectrum_lm);
+
+    // Fit spectrum with L-BFGS-B optimizer
+    GModels spectrum_lbfgsb = spectrum;
+    int     neval           = fit.neval();
+    opt.optimize(fit, spectrum_lbfgsb);
+    neval = fit.neval() - neval;
+
+    // Check results. Besides the initial evaluation and the evaluations
+    // for the uncertainties, the full function is only evaluated once per
+    // iteration for the accepted step
+    test_assert(opt.status() == G_LBFGSB_CONVERGED,
+                "Check if bounded spectral fit converged",
+                "Optimizer did not converge");
+    test_assert(neval <= opt.iter() + 3,
+                "Check number of full function evaluations",
+                "Found "+gammalib::str(neval)+" full function evaluations"
+                " for "+gammalib::str(opt.iter())+" iterations");
+    spectral = static_cast<GModelSky*>(spectrum_lbfgsb[0])->spectral();
+    test_value((*spectral)["Cutoff"].value(), 5.0e6, 1.0e-4,
+               "Check that cutoff energy is at boundary");
+    for (int i = 0; i < spectrum.npars(); ++i) {
+        const GModelPar& par = spectrum_lbfgsb.par(i);
+        const GModelPar& ref = spectrum_lm.par(i);
+        if (par.isfree()) {
+            test_value(par.factor_value(), ref.factor_value(),
+                       0.01*ref.factor_error(),
+                       "Check fitted value of "+par.name());
+            test_value(par.factor_error(), ref.factor_error(),
+                       1.0e-3*ref.factor_error(),
+                       "Check fitted error of "+par.name());
+        }
+    }
+
+    // Return
+    return;
+}
+
+
 /***************************************************************************
  * @brief Main entry point for test executable
  ***************************************************************************/
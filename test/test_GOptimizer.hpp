@@ -47,6 +47,8 @@ public:
     virtual void set(void);
     void         test_unbinned_optimizer(void);
     void         test_binned_optimizer(void);
+    void         test_event_parallel(void);
+    void         test_lbfgsb_optimizer(void);
     void         test_optimizer(const int& mode);
 };
 
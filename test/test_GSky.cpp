@@ -619,6 +619,56 @@ void TestGSky::test_GSkymap_wcs_construct(void)
         test_try_failure(e);
     }
 
+    // Test array transformations
+    test_try("Test array transformations");
+    try {
+        const char* prjs[]   = {"CAR", "TAN", "STG", "AZP", "MER"};
+        const char* coords[] = {"EQU", "GAL"};
+        for (int iprj = 0; iprj < 5; ++iprj) {
+            for (int icoord = 0; icoord < 2; ++icoord) {
+                GSkymap map1(prjs[iprj], coords[icoord], 83.63, 22.01,
+                             0.1, 0.1, 50, 40);
+                int                 npix = map1.npix();
+                std::vector<int>    pixels(npix+1);
+                std::vector<int>    pixels_back(npix+1);
+                std::vector<double> ra(npix+1);
+                std::vector<double> dec(npix+1);
+                for (int i = 0; i < npix; ++i) {
+                    pixels[i] = i;
+                }
+                map1.pix2dir(&(pixels[0]), npix, &(ra[0]), &(dec[0]));
+                ra[npix]  = 83.63;
+                dec[npix] = 62.01;
+                map1.dir2pix(&(ra[0]), &(dec[0]), npix+1, &(pixels_back[0]));
+                for (int i = 0; i < npix; ++i) {
+                    GSkyDir dir;
+                    dir.radec_deg(ra[i], dec[i]);
+                    double dist = dir.dist_deg(map1.pix2dir(i));
+                    if (dist > eps) {
+                        throw exception_failure(std::string(prjs[iprj])+
+                              " sky direction differs for pixel "+
+                              gammalib::str(i)+": dist="+
+                              gammalib::str(dist)+" deg");
+                    }
+                    if (pixels_back[i] != i) {
+                        throw exception_failure(std::string(prjs[iprj])+
+                              " pixel "+gammalib::str(i)+" differs: "+
+                              gammalib::str(pixels_back[i]));
+                    }
+                }
+                if (pixels_back[npix] != -1) {
+                    throw exception_failure(std::string(prjs[iprj])+
+                          " direction outside map not flagged.");
+                }
+            }
+        }
+
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Exit test
     return;
 
@@ -29,6 +29,7 @@
 #include <config.h>
 #endif
 #include <cstdlib>   // getenv
+#include <cmath>     // std::sqrt
 #include <vector>
 #include "GTools.hpp"
 #include "test_GSupport.hpp"
@@ -50,6 +51,8 @@ void TestGSupport::set(void){
     // Add tests
     add_test(static_cast<pfunction>(&TestGSupport::test_expand_env), "Test Environment variable");
     add_test(static_cast<pfunction>(&TestGSupport::test_node_array), "Test GNodeArray");
+    add_test(static_cast<pfunction>(&TestGSupport::test_random),     "Test GRan");
+    add_test(static_cast<pfunction>(&TestGSupport::test_alias_table), "Test GAliasTable");
     add_test(static_cast<pfunction>(&TestGSupport::test_url_file),   "Test GUrlFile");
     add_test(static_cast<pfunction>(&TestGSupport::test_url_string), "Test GUrlString");
 
@@ -291,6 +294,195 @@ void TestGSupport::test_node_array_interpolation(const int&    num,
         test_value(result, expected);
     }
 
+    // Test that interpolation handles agree with interpolation state
+    for (double value = -2.0; value <= +2.0; value += 0.2) {
+        GNodeArray::handle h = array.locate(value);
+        array.set_value(value);
+        test_assert(h.inx_left() == array.inx_left(),
+                    "Left index of handle for value "+gammalib::str(value));
+        test_assert(h.inx_right() == array.inx_right(),
+                    "Right index of handle for value "+gammalib::str(value));
+        test_value(h.wgt_left(), array.wgt_left());
+        test_value(h.wgt_right(), array.wgt_right());
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test GRan class
+ *
+ * Tests the random number streams and the array methods of the random
+ * number generator.
+ ***************************************************************************/
+void TestGSupport::test_random(void)
+{
+    // Check that streams are reproducible and do not depend on the random
+    // numbers that were already drawn from the generator
+    GRan ran1(12345);
+    GRan ran2(12345);
+    for (int i = 0; i < 10; ++i) {
+        ran2.uniform();
+    }
+    GRan stream1 = ran1.stream(7);
+    GRan stream2 = ran2.stream(7);
+    bool identical = true;
+    for (int i = 0; i < 100; ++i) {
+        if (stream1.int64() != stream2.int64()) {
+            identical = false;
+        }
+    }
+    test_assert(identical, "Expected identical random number streams.");
+
+    // Check that streams with different identifiers and sub-streams differ
+    // from each other
+    GRan stream3 = ran1.stream(8);
+    GRan stream4 = ran1.stream(7).stream(0);
+    GRan stream5 = ran1.stream(7);
+    unsigned long long int value3 = stream3.int64();
+    unsigned long long int value4 = stream4.int64();
+    unsigned long long int value5 = stream5.int64();
+    test_assert(value3 != value5, "Expected different streams for different"
+                                  " identifiers.");
+    test_assert(value4 != value5, "Expected different values for sub-stream.");
+
+    // Check that streams of generators with different seeds differ
+    GRan ran3(54321);
+    test_assert(ran3.stream(7).int64() != ran1.stream(7).int64(),
+                "Expected different streams for different seeds.");
+
+    // Check that uniform array is identical to sequential values
+    GRan                ran4(41);
+    GRan                ran5(41);
+    std::vector<double> values(1000);
+    ran4.uniform(&(values[0]), 1000);
+    bool inside = true;
+    identical   = true;
+    for (int i = 0; i < 1000; ++i) {
+        if (values[i] != ran5.uniform()) {
+            identical = false;
+        }
+        if (values[i] < 0.0 || values[i] >= 1.0) {
+            inside = false;
+        }
+    }
+    test_assert(identical, "Expected identical uniform values.");
+    test_assert(inside, "Expected uniform values in range [0,1[.");
+
+    // Check that Poisson array is identical to sequential values
+    std::vector<double> lambda(1000);
+    for (int i = 0; i < 1000; ++i) {
+        lambda[i] = 0.05 * double(i);
+    }
+    ran4.poisson(&(lambda[0]), &(values[0]), 1000);
+    identical  = true;
+    double sum = 0.0;
+    for (int i = 0; i < 1000; ++i) {
+        double value = (lambda[i] > 0.0) ? ran5.poisson(lambda[i]) : 0.0;
+        if (values[i] != value) {
+            identical = false;
+        }
+        sum += values[i];
+    }
+    test_assert(identical, "Expected identical Poisson values.");
+    test_value(sum, 24975.0, 500.0, "Check sum of Poisson values.");
+
+    // Check that a negative number of values throws an exception
+    test_try("Negative number of values");
+    try {
+        ran4.uniform(&(values[0]), -1);
+        test_try_failure("Exception expected for negative number of values.");
+    }
+    catch (GException::invalid_argument &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test GAliasTable class
+ *
+ * Tests that indices drawn from an alias table follow the distribution
+ * given by the weights.
+ ***************************************************************************/
+void TestGSupport::test_alias_table(void)
+{
+    // Check that an empty table returns -1
+    GAliasTable empty;
+    GRan        ran(41);
+    test_value(empty.size(), 0, "Check size of empty table.");
+    test_value(empty.draw(ran), -1, "Check draw from empty table.");
+
+    // Check that a table with zero weights is empty
+    std::vector<double> zeros(5, 0.0);
+    GAliasTable         zero(zeros);
+    test_assert(zero.isempty(), "Expected empty table for zero weights.");
+
+    // Set weights, including zero weights
+    std::vector<double> weights;
+    weights.push_back(1.0);
+    weights.push_back(0.0);
+    weights.push_back(3.0);
+    weights.push_back(0.5);
+    weights.push_back(0.0);
+    weights.push_back(5.5);
+    GAliasTable table(weights);
+    test_value(table.size(), 6, "Check size of table.");
+
+    // Draw indices and check that their frequencies follow the weights
+    int              ndraws = 100000;
+    std::vector<int> counts(weights.size(), 0);
+    bool             inside = true;
+    for (int i = 0; i < ndraws; ++i) {
+        int index = table.draw(ran);
+        if (index < 0 || index >= weights.size()) {
+            inside = false;
+        }
+        else {
+            counts[index]++;
+        }
+    }
+    test_assert(inside, "Expected indices within table.");
+    for (int i = 0; i < weights.size(); ++i) {
+        double expected = double(ndraws) * weights[i] / 10.0;
+        test_value(double(counts[i]), expected, 5.0*std::sqrt(expected)+1.0e-6,
+                   "Check frequency of index "+gammalib::str(i)+".");
+    }
+
+    // Check that a copy gives identical draws
+    GAliasTable copy = table;
+    GRan        ran1(7);
+    GRan        ran2(7);
+    bool        identical = true;
+    for (int i = 0; i < 100; ++i) {
+        if (table.draw(ran1) != copy.draw(ran2)) {
+            identical = false;
+        }
+    }
+    test_assert(identical, "Expected identical draws from copied table.");
+
+    // Check that a negative weight throws an exception
+    test_try("Negative weight");
+    try {
+        weights[2] = -1.0;
+        table.set(weights);
+        test_try_failure("Exception expected for negative weight.");
+    }
+    catch (GException::invalid_argument &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Return
     return;
 }
@@ -47,6 +47,8 @@ public:
     virtual void set(void);
     void         test_expand_env(void);
     void         test_node_array(void);
+    void         test_random(void);
+    void         test_alias_table(void);
     void         test_url_file(void);
     void         test_url_string(void);
 
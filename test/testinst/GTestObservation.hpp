@@ -114,6 +114,7 @@ public:
     virtual double           deadc(const GTime& time) const { return 1.0; }
     virtual void             read(const GXmlElement& xml){ return; }
     virtual void             write(GXmlElement& xml) const{ return; }
+    virtual bool             threadsafe(void) const { return true; }
     void ontime(const double& ontime) { m_ontime=ontime; }
     virtual std::string      print(const GChatter& chatter = NORMAL) const{
        // Initialise result string